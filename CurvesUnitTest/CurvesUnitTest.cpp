@@ -0,0 +1,208 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "../MathLib/Curves/CubicSpline.h"
+#include "../MathLib/Util/Random.h"
+
+#include <intrin.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace Curves
+{
+	TEST_CLASS(CubicSplines)
+	{
+		static Vec3f BezierReference(const Vec3f* aPoints, float aT)
+		{
+			const float s = 1.0f - aT;
+			return aPoints[0] * (s * s * s) + aPoints[1] * (3.0f * s * s * aT) + aPoints[2] * (3.0f * s * aT * aT) + aPoints[3] * (aT * aT * aT);
+		}
+
+		static bool Near(const Vec3f& aOne, const Vec3f& aTwo, float aTolerance)
+		{
+			Vec3f difference = aOne - aTwo;
+			return difference.Length() <= aTolerance;
+		}
+
+		static std::vector<Vec3f> RandomPoints(size_t aCount)
+		{
+			std::vector<Vec3f> points(aCount);
+			for (size_t i = 0; i < aCount; i++)
+			{
+				points[i] = Vec3f(float(i) * 2.0f + BB::Random(-1.0f, 1.0f), BB::Random(-3.0f, 3.0f), BB::Random(-3.0f, 3.0f));
+			}
+			return points;
+		}
+
+	public:
+		TEST_METHOD(Bases_And_Batches)
+		{
+			const std::vector<Vec3f> control = RandomPoints(10);
+			const BB::CubicSpline bezier = BB::CubicSpline::FromBezier(control.data(), 3);
+			Assert::AreEqual(size_t(3), bezier.GetSegmentCount());
+
+			// Unsorted parameters outside the range as well, mixing segments within a batch
+			std::vector<float> parameters = { -1.0f, 0.0f, 0.25f, 1.0f, 2.999f, 3.0f, 7.0f };
+			for (int i = 0; i < 100; i++)
+			{
+				parameters.push_back(i < 50 ? BB::Random(0.0f, 3.0f) : 1.0f + float(i) / 200.0f);
+			}
+			std::vector<Vec3f> positions(parameters.size());
+			std::vector<Vec3f> tangents(parameters.size());
+			bezier.EvaluatePositions(parameters.data(), positions.data(), parameters.size());
+			bezier.EvaluateTangents(parameters.data(), tangents.data(), parameters.size());
+			for (size_t i = 0; i < parameters.size(); i++)
+			{
+				const float u = std::clamp(parameters[i], 0.0f, 3.0f);
+				const size_t segment = std::min<size_t>(size_t(u), 2);
+				const float t = u - float(segment);
+				Assert::IsTrue(Near(BezierReference(control.data() + 3 * segment, t), positions[i], 1e-4f), L"Batched position does not match the Bernstein form");
+				Assert::IsTrue(Near(bezier.EvaluatePosition(parameters[i]), positions[i], 1e-5f), L"Batched and single position differ");
+				Assert::IsTrue(Near(bezier.EvaluateTangent(parameters[i]), tangents[i], 1e-5f), L"Batched and single tangent differ");
+
+				// Derivative of the Bernstein form, 3 times the quadratic Bezier of the control point differences
+				const Vec3f* points = control.data() + 3 * segment;
+				const float s = 1.0f - t;
+				const Vec3f derivative = ((points[1] - points[0]) * (s * s) + (points[2] - points[1]) * (2.0f * s * t) + (points[3] - points[2]) * (t * t)) * 3.0f;
+				Assert::IsTrue(Near(derivative, tangents[i], 1e-3f), L"Tangent does not match the Bernstein derivative");
+			}
+
+			const Vec3f points[3] = { Vec3f(0.0f, 0.0f, 0.0f), Vec3f(1.0f, 2.0f, 0.0f), Vec3f(3.0f, 0.0f, 1.0f) };
+			const BB::CubicSpline catmullRom = BB::CubicSpline::FromCatmullRom(points, 3);
+			const Vec3f catmullRomTangent = catmullRom.EvaluateTangent(1.0f);
+			Assert::IsTrue(Near(catmullRom.EvaluatePosition(1.0f), points[1], 1e-6f), L"Catmull-Rom should pass through its points");
+			Assert::IsTrue(Near(catmullRomTangent, (points[2] - points[0]) * 0.5f, 1e-5f), L"Catmull-Rom tangent should be half the neighbor difference");
+
+			const Vec3f hermiteTangents[3] = { Vec3f(1.0f, 0.0f, 0.0f), Vec3f(0.0f, -4.0f, 0.0f), Vec3f(0.0f, 0.0f, 2.0f) };
+			const BB::CubicSpline hermite = BB::CubicSpline::FromHermite(points, hermiteTangents, 3);
+			for (int i = 0; i < 3; i++)
+			{
+				Assert::IsTrue(Near(hermite.EvaluatePosition(float(i)), points[i], 1e-6f) && Near(hermite.EvaluateTangent(float(i)), hermiteTangents[i], 1e-5f),
+					L"Hermite should match its points and tangents");
+			}
+		}
+
+		TEST_METHOD(Flatten_Within_Tolerance)
+		{
+			const std::vector<Vec3f> waypoints = RandomPoints(12);
+			const BB::CubicSpline spline = BB::CubicSpline::FromCatmullRom(waypoints.data(), waypoints.size());
+			const float tolerances[] = { 0.1f, 0.01f, 0.001f };
+			size_t previousCount = 0;
+			for (float tolerance : tolerances)
+			{
+				std::vector<Vec3f> polyline;
+				std::vector<float> parameters;
+				spline.Flatten(tolerance, polyline, &parameters);
+				Assert::IsTrue(polyline.size() > previousCount, L"A tighter tolerance should give more points");
+				Assert::AreEqual(polyline.size(), parameters.size());
+				Assert::AreEqual(0.0f, parameters.front());
+				Assert::AreEqual(float(spline.GetSegmentCount()), parameters.back());
+				previousCount = polyline.size();
+
+				for (size_t i = 0; i + 1 < polyline.size(); i++)
+				{
+					Assert::IsTrue(parameters[i] < parameters[i + 1]);
+					Assert::IsTrue(Near(spline.EvaluatePosition(parameters[i]), polyline[i], 1e-4f));
+					for (int sample = 1; sample < 8; sample++)
+					{
+						const float u = parameters[i] + (parameters[i + 1] - parameters[i]) * float(sample) / 8.0f;
+						const Vec3f point = spline.EvaluatePosition(u);
+						const Vec3f chord = polyline[i + 1] - polyline[i];
+						const float t = std::clamp((point - polyline[i]).Dot(chord) / chord.Dot(chord), 0.0f, 1.0f);
+						Assert::IsTrue(Near(point, polyline[i] + chord * t, tolerance * 1.01f + 1e-5f), L"Curve is further than the tolerance from the polyline");
+					}
+				}
+			}
+		}
+
+		TEST_METHOD(Arc_Length_Constant_Speed)
+		{
+			// A quarter circle of radius 10 as one Bezier, then a straight segment of length 5
+			const float k = 0.5522847f * 10.0f;
+			const Vec3f control[7] = { Vec3f(10.0f, 0.0f, 0.0f), Vec3f(10.0f, k, 0.0f), Vec3f(k, 10.0f, 0.0f), Vec3f(0.0f, 10.0f, 0.0f),
+				Vec3f(-5.0f / 3.0f, 10.0f, 0.0f), Vec3f(-10.0f / 3.0f, 10.0f, 0.0f), Vec3f(-5.0f, 10.0f, 0.0f) };
+			const BB::CubicSpline spline = BB::CubicSpline::FromBezier(control, 2);
+			BB::ArcLengthTable table;
+			table.Build(spline, 32);
+			const float expectedLength = 10.0f * 1.5707963f + 5.0f;
+			Assert::AreEqual(expectedLength, table.GetLength(), 0.01f, L"Length should match the quarter circle plus the line");
+
+			const size_t count = 1001;
+			std::vector<float> distances(count);
+			for (size_t i = 0; i < count; i++)
+			{
+				distances[i] = table.GetLength() * float(i) / float(count - 1);
+			}
+			distances.push_back(-1.0f);
+			distances.push_back(1e9f);
+			std::vector<float> parameters(distances.size());
+			table.GetParameters(distances.data(), parameters.data(), distances.size());
+			Assert::AreEqual(0.0f, parameters[count]);
+			Assert::AreEqual(2.0f, parameters[count + 1], 1e-5f);
+			Assert::AreEqual(parameters[17], table.GetParameter(distances[17]));
+
+			std::vector<Vec3f> positions(count);
+			spline.EvaluatePositions(parameters.data(), positions.data(), count);
+			const float step = table.GetLength() / float(count - 1);
+			for (size_t i = 0; i + 1 < count; i++)
+			{
+				Vec3f chord = positions[i + 1] - positions[i];
+				Assert::AreEqual(step, chord.Length(), step * 0.01f, L"Equal distance steps should move equal lengths along the curve");
+			}
+			Assert::IsTrue(Near(positions.back(), control[6], 1e-4f));
+		}
+
+		TEST_METHOD(Arc_Length_Empty_Table)
+		{
+			const float distances[3] = { -1.0f, 0.0f, 5.0f };
+			float parameters[3] = { -1.0f, -1.0f, -1.0f };
+			BB::ArcLengthTable table;
+			Assert::AreEqual(0.0f, table.GetLength());
+			table.GetParameters(distances, parameters, 3);
+			Assert::IsTrue(parameters[0] == 0.0f && parameters[1] == 0.0f && parameters[2] == 0.0f, L"A table that was not built maps every distance to 0");
+
+			table.Build(BB::CubicSpline());
+			Assert::AreEqual(0.0f, table.GetParameter(5.0f), L"A spline without segments maps every distance to 0");
+		}
+
+		TEST_METHOD(Evaluate_And_Lookup_Cycles)
+		{
+			const std::vector<Vec3f> waypoints = RandomPoints(64);
+			const BB::CubicSpline spline = BB::CubicSpline::FromCatmullRom(waypoints.data(), waypoints.size());
+			BB::ArcLengthTable table;
+			table.Build(spline);
+
+			const size_t count = 1 << 16;
+			std::vector<float> parameters(count);
+			std::vector<float> distances(count);
+			for (size_t i = 0; i < count; i++)
+			{
+				parameters[i] = float(spline.GetSegmentCount()) * float(i) / float(count);
+				distances[i] = BB::Random(0.0f, table.GetLength());
+			}
+			std::vector<Vec3f> positions(count);
+			std::vector<float> lookedUp(count);
+
+			unsigned long long start = __rdtsc();
+			spline.EvaluatePositions(parameters.data(), positions.data(), count);
+			const unsigned long long batched = __rdtsc() - start;
+			start = __rdtsc();
+			for (size_t i = 0; i < count; i++)
+			{
+				positions[i] = spline.EvaluatePosition(parameters[i]);
+			}
+			const unsigned long long single = __rdtsc() - start;
+			start = __rdtsc();
+			table.GetParameters(distances.data(), lookedUp.data(), count);
+			const unsigned long long lookup = __rdtsc() - start;
+
+			char message[256];
+			snprintf(message, sizeof(message), "CubicSpline %zu parameters, cycles per value: batched positions %.1f, single %.1f, arc length lookup %.1f\n",
+				count, double(batched) / count, double(single) / count, double(lookup) / count);
+			Logger::WriteMessage(message);
+		}
+	};
+}
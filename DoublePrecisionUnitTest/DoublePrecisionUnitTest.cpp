@@ -0,0 +1,210 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "../MathLib/Vector/Vector3d/Vector3d.h"
+#include "../MathLib/Vector/Vector4d/Vector4d.h"
+#include "../MathLib/Matrix/Matrix4x4d/Matrix4x4d.h"
+#include "../MathLib/Matrix/Matrix4x4f/Matrix4x4f.h"
+#include "../MathLib/Bulk/CameraRelative.h"
+#include "../MathLib/Util/Random.h"
+#include "../MathLib/Util/CommonMath.h"
+
+#include <vector>
+#include <cmath>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace DoublePrecision
+{
+	TEST_CLASS(Vector3d)
+	{
+	public:
+
+		TEST_METHOD(Construction)
+		{
+			Vec3d zero;
+			Assert::IsTrue(zero.x == 0.0 && zero.y == 0.0 && zero.z == 0.0 && zero.lanes.value[3] == 0.0, L"Default Vec3d is not zero");
+
+			const Vec3d vector(1.0, 2.0, 3.0);
+			Assert::IsTrue(vector.x == 1.0 && vector.y == 2.0 && vector.z == 3.0, L"Components are not assigned correctly");
+			Assert::IsTrue(Vec3d(0.1f) != Vec3d(0.1), L"Vec3d should not be initialized through float");
+
+			const Vec3d widened(Vec3f(0.1f, 2.0f, -3.0f));
+			Assert::IsTrue(widened == Vec3d(double(0.1f), 2.0, -3.0), L"Widening from Vec3f is not exact");
+			Assert::IsTrue(widened.ToVec3f() == Vec3f(0.1f, 2.0f, -3.0f), L"ToVec3f does not round back");
+		}
+
+		TEST_METHOD(Arithmetic)
+		{
+			const Vec3d a(1.5, -2.0, 4.0);
+			const Vec3d b(0.5, 3.0, -1.0);
+			Assert::IsTrue(a + b == Vec3d(2.0, 1.0, 3.0), L"Add failed");
+			Assert::IsTrue(a - b == Vec3d(1.0, -5.0, 5.0), L"Subtract failed");
+			Assert::IsTrue(a * b == Vec3d(0.75, -6.0, -4.0), L"Multiply failed");
+			Assert::IsTrue(a * 2.0 == Vec3d(3.0, -4.0, 8.0) && 2.0 * a == a * 2.0, L"Scalar multiply failed");
+			Assert::IsTrue(a / b == Vec3d(3.0, -2.0 / 3.0, -4.0), L"Divide failed");
+			Assert::AreEqual(0.0, (a / b).lanes.value[3], L"Divide should keep w at zero");
+			Assert::IsTrue(-a == Vec3d(-1.5, 2.0, -4.0), L"Negate failed");
+
+			Vec3d c = a;
+			c += b;
+			c -= b;
+			c *= 4.0;
+			c /= 4.0;
+			Assert::IsTrue(c == a, L"Compound operators failed");
+
+			Assert::AreEqual(-9.25, a.Dot(b), L"Dot failed");
+			Assert::IsTrue(a.Cross(b) == Vec3d(-10.0, 3.5, 5.5), L"Cross failed");
+			Assert::AreEqual(std::sqrt(22.25), a.Length(), 1e-15, L"Length failed");
+			Assert::AreEqual(1.0, a.GetNormalized().Length(), 1e-15, L"GetNormalized failed");
+			Assert::IsTrue(MulAdd(a, b, a) == a * b + a, L"MulAdd failed");
+			Assert::IsTrue(Lerp(a, b, 0.5) == Vec3d(1.0, 0.5, 1.5), L"Lerp failed");
+		}
+
+		TEST_METHOD(Precision)
+		{
+			// A millimeter step at 10^7 meters is lost in float but not in double
+			const Vec3d far(1.0e7, 0.0, -1.0e7);
+			const Vec3d step = far + Vec3d(0.001, 0.001, 0.001);
+			Assert::AreEqual(0.001, (step - far).x, 1e-9, L"Vec3d lost precision");
+			Assert::IsTrue((step.ToVec3f() - far.ToVec3f()).x == 0.0f, L"The test values should not be representable in float");
+		}
+
+		TEST_METHOD(Rotation)
+		{
+			const Vec3d vector(1.0, 2.0, 3.0);
+			Assert::IsTrue((vector.GetRotatedZ(BB::PI_HALF_D) - Vec3d(-2.0, 1.0, 3.0)).Length() < 1e-14, L"GetRotatedZ failed");
+			Assert::IsTrue((vector.GetRotatedX(BB::PI_HALF_D) - Vec3d(1.0, -3.0, 2.0)).Length() < 1e-14, L"GetRotatedX failed");
+			Assert::IsTrue((vector.GetRotatedY(BB::PI_HALF_D) - Vec3d(3.0, 2.0, -1.0)).Length() < 1e-14, L"GetRotatedY failed");
+			Assert::IsTrue((vector.GetRotatedAroundAxis(Vec3d(0.0, 0.0, 5.0), BB::PI_HALF_D) - vector.GetRotatedZ(BB::PI_HALF_D)).Length() < 1e-14, L"GetRotatedAroundAxis failed");
+		}
+
+		TEST_METHOD(LoadStore)
+		{
+			alignas(32) double values[5] = { 1.0, 2.0, 3.0, 4.0, 5.0 };
+			Assert::IsTrue(Vec3d::LoadUnaligned(values + 1) == Vec3d(2.0, 3.0, 4.0), L"LoadUnaligned failed");
+			Assert::IsTrue(Vec3d::LoadAligned(values) == Vec3d(1.0, 2.0, 3.0), L"LoadAligned should clear w");
+			Assert::AreEqual(size_t(32), alignof(Vec3d), L"Vec3d should be 32-byte aligned on every path");
+			Assert::AreEqual(size_t(32), sizeof(Vec3d), L"Vec3d should be 32 bytes on every path");
+
+			Vec3d(7.0, 8.0, 9.0).StoreUnaligned(values + 1);
+			Assert::IsTrue(values[0] == 1.0 && values[1] == 7.0 && values[3] == 9.0 && values[4] == 5.0, L"StoreUnaligned should write three doubles");
+		}
+
+		TEST_METHOD(ConstantEvaluation)
+		{
+			constexpr Vec3d a(1.0, 2.0, 3.0);
+			constexpr Vec3d b = a * 2.0 - BB::VEC3D_ONE;
+			static_assert(b.Dot(BB::VEC3D_UNIT_Z) == 5.0, "Vec3d should work in constant expressions");
+			static_assert(BB::VEC3D_UNIT_X.Cross(BB::VEC3D_UNIT_Y) == BB::VEC3D_UNIT_Z, "Vec3d::Cross should work in constant expressions");
+			Assert::IsTrue(b == Vec3d(1.0, 3.0, 5.0), L"Constant and runtime results differ");
+		}
+	};
+
+	TEST_CLASS(Vector4d)
+	{
+	public:
+
+		TEST_METHOD(Arithmetic)
+		{
+			const Vec4d a(1.0, 2.0, 3.0, 4.0);
+			const Vec4d b(-1.0, 0.5, 2.0, 0.25);
+			Assert::IsTrue(a + b == Vec4d(0.0, 2.5, 5.0, 4.25), L"Add failed");
+			Assert::IsTrue(a / b == Vec4d(-1.0, 4.0, 1.5, 16.0), L"Divide failed");
+			Assert::AreEqual(30.0, a.LengthSqr(), L"LengthSqr failed");
+			Assert::AreEqual(7.0, a.Dot(b), L"Dot failed");
+			Assert::IsTrue(Vec4d(Vec4f(1.0f, 2.0f, 3.0f, 4.0f)) == a, L"Widening from Vec4f failed");
+			Assert::IsTrue(a.ToVec4f() == Vec4f(1.0f, 2.0f, 3.0f, 4.0f), L"ToVec4f failed");
+
+			double values[4];
+			a.StoreUnaligned(values);
+			Assert::IsTrue(Vec4d::LoadUnaligned(values) == a, L"Load and store failed");
+
+			static_assert(Vec4d(1.0, 2.0, 3.0, 4.0).Dot(BB::VEC4D_UNIT_W) == 4.0, "Vec4d should work in constant expressions");
+		}
+	};
+
+	TEST_CLASS(Matrix4x4d)
+	{
+	public:
+
+		TEST_METHOD(Multiply_MatchesFloat)
+		{
+			Mat4x4f floatOne, floatTwo;
+			for (int i = 0; i < 16; i++)
+			{
+				floatOne.data[i] = float(int(BB::Random(-8.0f, 8.0f)));
+				floatTwo.data[i] = float(int(BB::Random(-8.0f, 8.0f)));
+			}
+
+			// Small integers are exact in both precisions
+			const Mat4x4d one(floatOne), two(floatTwo);
+			Assert::IsTrue((one * two).ToMat4x4f() == floatOne * floatTwo, L"Multiply differs from Mat4x4f");
+			Assert::IsTrue((one + two).ToMat4x4f() == floatOne + floatTwo, L"Add differs from Mat4x4f");
+			Assert::IsTrue(one.GetTransposed().ToMat4x4f() == floatOne.GetTransposed(), L"Transpose differs from Mat4x4f");
+			Assert::IsTrue(MulAdd(one, two, one).ToMat4x4f() == MulAdd(floatOne, floatTwo, floatOne), L"MulAdd differs from Mat4x4f");
+
+			Mat4x4d inPlace = one;
+			inPlace *= two;
+			Assert::IsTrue(inPlace == one * two, L"operator*= failed");
+		}
+
+		TEST_METHOD(Transform)
+		{
+			Mat4x4d transform(Vec3d(1.0e7, 2.0, -3.0));
+			transform.p00 = 2.0;
+			Assert::IsTrue(transform.TransformPoint(Vec3d(1.0, 1.0, 1.0)) == Vec3d(1.0e7 + 2.0, 3.0, -2.0), L"TransformPoint failed");
+			Assert::IsTrue(transform.TransformVector(Vec3d(1.0, 1.0, 1.0)) == Vec3d(2.0, 1.0, 1.0), L"TransformVector failed");
+			Assert::IsTrue(transform.Transform(Vec4d(1.0, 1.0, 1.0, 0.5)) == Vec4d(5.0e6 + 2.0, 2.0, -0.5, 0.5), L"Transform failed");
+
+			constexpr Mat4x4d translation(Vec3d(1.0, 2.0, 3.0));
+			static_assert((translation * translation).lanes.value[14] == 6.0, "Mat4x4d should work in constant expressions");
+			static_assert(BB::MAT4X4D_IDENTITY.GetTransposed() == BB::MAT4X4D_IDENTITY, "Mat4x4d should work in constant expressions");
+		}
+	};
+
+	TEST_CLASS(CameraRelative)
+	{
+	public:
+
+		TEST_METHOD(Positions)
+		{
+			const Vec3d camera(6.0e6, -4.0e6, 1.0e6);
+			for (size_t count = 0; count < 11; count++)
+			{
+				std::vector<Vec3d> positions(count);
+				for (size_t i = 0; i < count; i++)
+				{
+					positions[i] = camera + Vec3d(BB::Random(-100.0, 100.0), BB::Random(-100.0, 100.0), BB::Random(-100.0, 100.0));
+				}
+
+				std::vector<Vec3f> relative(count);
+				std::vector<float> packed(count * 3 + 1, -1.0f);
+				BB::Bulk::ToCameraRelative(positions.data(), camera, relative.data(), count);
+				BB::Bulk::ToCameraRelative(positions.data(), camera, packed.data(), count);
+
+				for (size_t i = 0; i < count; i++)
+				{
+					const Vec3f expected = (positions[i] - camera).ToVec3f();
+					Assert::IsTrue(relative[i] == expected, L"ToCameraRelative gives the wrong position");
+					Assert::IsTrue(Vec3f::LoadUnaligned(packed.data() + i * 3) == expected, L"Packed ToCameraRelative gives the wrong position");
+				}
+				Assert::AreEqual(-1.0f, packed.back(), L"Packed ToCameraRelative wrote past the end");
+			}
+		}
+
+		TEST_METHOD(Transforms)
+		{
+			const Vec3d camera(6.0e6, -4.0e6, 1.0e6);
+			Mat4x4d transform(camera + Vec3d(0.25, 0.001, -2.0));
+			transform.p01 = 0.5;
+
+			Mat4x4f relative;
+			BB::Bulk::ToCameraRelative(&transform, camera, &relative, 1);
+			Assert::AreEqual(0.5f, relative.p01, L"The rotation part should be kept");
+			Assert::AreEqual(1.0f, relative.p33, L"p33 should stay 1");
+			Assert::AreEqual(0.25f, relative.p30, L"ToCameraRelative gives the wrong translation");
+			Assert::AreEqual(0.001f, relative.p31, 1e-9f, L"ToCameraRelative lost precision");
+			Assert::AreEqual(-2.0f, relative.p32, L"ToCameraRelative gives the wrong translation");
+		}
+	};
+}
@@ -0,0 +1,119 @@
+#pragma once
+#include <cstddef>
+#include "../Util/Intrinsics.h"
+#include "../Memory/AlignedAllocator.h"
+#include "../Vector/Vector3f/Vector3f.h"
+#include "../Vector/Vector4f/Vector4f.h"
+#include "../Matrix/Matrix4x4f/Matrix4x4f.h"
+#include "StreamView.h"
+
+/**
+ * @file Bulk.h
+ * @brief Array kernels for transforming, normalizing and bounding many vectors at once.
+ *
+ * @details There are two layouts:
+ * - Packed xyz floats (12 bytes per element), as read from mesh files and vertex buffers.
+ *   The pointers only need float alignment. The kernels handle single elements until the output
+ *   reaches a 16-byte boundary, then process four elements (three aligned __m128) per step in
+ *   structure-of-arrays form, and finish the remaining elements one by one.
+ * - Vec3f / Vec4f arrays (16 bytes per element), which are always aligned.
+ * - StreamView, any stride over external memory. Packed (12 byte) Vec3f views take the packed
+ *   path above, 16 byte strides load whole elements with one unaligned load, and other strides
+ *   gather four elements into registers before running the same structure-of-arrays code.
+ *
+ * Packed outputs larger than BB_STREAM_THRESHOLD_BYTES are written with non-temporal stores, so a
+ * pass over a buffer larger than the last level cache does not evict everything else. Define
+ * the macro before including this file to match the target cache size.
+ *
+ * Input and output may be the same array, partially overlapping arrays are not supported.
+ */
+
+#ifndef BB_STREAM_THRESHOLD_BYTES
+#define BB_STREAM_THRESHOLD_BYTES (8u * 1024u * 1024u)
+#endif
+
+namespace BitBloom
+{
+namespace Bulk
+{
+/**
+* @name Packed xyz arrays
+* @{
+*/
+/// @brief aOutPoints[i] = aPoints[i] * aMatrix with w = 1, the translation is applied.
+	inline void TransformPoints(const Mat4x4f& aMatrix, const float* aPoints, float* aOutPoints, size_t aCount);
+/// @brief aOutVectors[i] = aVectors[i] * aMatrix with w = 0, the translation is ignored.
+	inline void TransformVectors(const Mat4x4f& aMatrix, const float* aVectors, float* aOutVectors, size_t aCount);
+/// @brief Normalizes aCount vectors, zero vectors become NaN like Vec3f::Normalize.
+	inline void Normalize(const float* aVectors, float* aOutVectors, size_t aCount);
+/// @brief Computes the axis aligned bounds of aCount points. For aCount = 0 min is +FLT_MAX and max is -FLT_MAX.
+	inline void Bounds(const float* aPoints, size_t aCount, Vec3f& aOutMin, Vec3f& aOutMax);
+/**
+* @brief Replaces infinite and NaN floats of aCount xyz elements with aReplacement.
+*
+* @details Branch-free, four floats per step. Use it after loading external data or once per
+* frame on simulation state, so a single NaN can not spread. Returns the number of floats replaced.
+*/
+	inline size_t Sanitize(const float* aValues, float aReplacement, float* aOutValues, size_t aCount);
+/** @} */
+
+/**
+* @name Vec3f / Vec4f arrays
+* @{
+*/
+	inline void TransformPoints(const Mat4x4f& aMatrix, const Vec3f* aPoints, Vec3f* aOutPoints, size_t aCount);
+	inline void TransformVectors(const Mat4x4f& aMatrix, const Vec3f* aVectors, Vec3f* aOutVectors, size_t aCount);
+	inline void Transform(const Mat4x4f& aMatrix, const Vec4f* aVectors, Vec4f* aOutVectors, size_t aCount);
+	inline void Normalize(const Vec3f* aVectors, Vec3f* aOutVectors, size_t aCount);
+	inline void Bounds(const Vec3f* aPoints, size_t aCount, Vec3f& aOutMin, Vec3f& aOutMax);
+/// @brief Replaces infinite and NaN components with the matching component of aReplacement, returns the number replaced.
+	inline size_t Sanitize(const Vec3f* aVectors, const Vec3f& aReplacement, Vec3f* aOutVectors, size_t aCount);
+	inline size_t Sanitize(const Vec4f* aVectors, const Vec4f& aReplacement, Vec4f* aOutVectors, size_t aCount);
+/** @} */
+
+/**
+* @name Component-wise arrays
+* @brief The component-wise Vec3f / Vec4f functions over arrays, aOut[i] = Function(aOne[i], aTwo[i]).
+*
+* @details Same rules as the other Vec3f / Vec4f kernels: the output may be one of the inputs and
+* large outputs are streamed.
+* @{
+*/
+	inline void Min(const Vec3f* aOne, const Vec3f* aTwo, Vec3f* aOut, size_t aCount);
+	inline void Min(const Vec4f* aOne, const Vec4f* aTwo, Vec4f* aOut, size_t aCount);
+	inline void Max(const Vec3f* aOne, const Vec3f* aTwo, Vec3f* aOut, size_t aCount);
+	inline void Max(const Vec4f* aOne, const Vec4f* aTwo, Vec4f* aOut, size_t aCount);
+	inline void Abs(const Vec3f* aVectors, Vec3f* aOut, size_t aCount);
+	inline void Abs(const Vec4f* aVectors, Vec4f* aOut, size_t aCount);
+	inline void Clamp(const Vec3f* aVectors, const Vec3f& aMin, const Vec3f& aMax, Vec3f* aOut, size_t aCount);
+	inline void Clamp(const Vec4f* aVectors, const Vec4f& aMin, const Vec4f& aMax, Vec4f* aOut, size_t aCount);
+	inline void Floor(const Vec3f* aVectors, Vec3f* aOut, size_t aCount);
+	inline void Floor(const Vec4f* aVectors, Vec4f* aOut, size_t aCount);
+	inline void Ceil(const Vec3f* aVectors, Vec3f* aOut, size_t aCount);
+	inline void Ceil(const Vec4f* aVectors, Vec4f* aOut, size_t aCount);
+	inline void Sign(const Vec3f* aVectors, Vec3f* aOut, size_t aCount);
+	inline void Sign(const Vec4f* aVectors, Vec4f* aOut, size_t aCount);
+	inline void Lerp(const Vec3f* aFrom, const Vec3f* aTo, float aT, Vec3f* aOut, size_t aCount);
+	inline void Lerp(const Vec4f* aFrom, const Vec4f* aTo, float aT, Vec4f* aOut, size_t aCount);
+/** @} */
+
+/**
+* @name Strided views
+* @brief Same kernels on StreamView, input and output must have the same count.
+*
+* @details A padded (16 byte stride) Vec3f output is written with a read-modify-write of the whole
+* element, the fourth float keeps its value.
+* @{
+*/
+	inline void TransformPoints(const Mat4x4f& aMatrix, StreamView<const Vec3f> aPoints, StreamView<Vec3f> aOutPoints);
+	inline void TransformVectors(const Mat4x4f& aMatrix, StreamView<const Vec3f> aVectors, StreamView<Vec3f> aOutVectors);
+	inline void Transform(const Mat4x4f& aMatrix, StreamView<const Vec4f> aVectors, StreamView<Vec4f> aOutVectors);
+	inline void Normalize(StreamView<const Vec3f> aVectors, StreamView<Vec3f> aOutVectors);
+	inline void Bounds(StreamView<const Vec3f> aPoints, Vec3f& aOutMin, Vec3f& aOutMax);
+/** @} */
+} // namespace Bulk
+} // namespace BitBloom
+
+namespace BB = BitBloom;
+
+#include "Bulk.inl"
@@ -0,0 +1,699 @@
+#pragma once
+#include "Bulk.h"
+#include <bit>
+#include <cassert>
+#include <cfloat>
+
+namespace BitBloom
+{
+namespace Bulk
+{
+namespace Detail
+{
+	enum class StoreMode { Unaligned, Aligned, Stream };
+
+	inline bool ShouldStream(size_t aOutputBytes)
+	{
+		return aOutputBytes > BB_STREAM_THRESHOLD_BYTES;
+	}
+
+	template<bool aAligned>
+	inline __m128 Load(const float* aSource)
+	{
+		if constexpr (aAligned)
+		{
+			return _mm_load_ps(aSource);
+		}
+		return _mm_loadu_ps(aSource);
+	}
+
+	template<StoreMode aMode>
+	inline void Store(float* aDestination, __m128 aValue)
+	{
+		if constexpr (aMode == StoreMode::Stream)
+		{
+			_mm_stream_ps(aDestination, aValue);
+		}
+		else if constexpr (aMode == StoreMode::Aligned)
+		{
+			_mm_store_ps(aDestination, aValue);
+		}
+		else
+		{
+			_mm_storeu_ps(aDestination, aValue);
+		}
+	}
+
+/// @brief Splits four packed xyz elements (x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3) into x, y and z registers.
+	inline void Deinterleave(__m128 aRowZero, __m128 aRowOne, __m128 aRowTwo, __m128& aOutX, __m128& aOutY, __m128& aOutZ)
+	{
+		const __m128 xy23 = _mm_shuffle_ps(aRowOne, aRowTwo, _MM_SHUFFLE(2, 1, 3, 2));	// x2 y2 x3 y3
+		const __m128 yz01 = _mm_shuffle_ps(aRowZero, aRowOne, _MM_SHUFFLE(1, 0, 2, 1));	// y0 z0 y1 z1
+		aOutX = _mm_shuffle_ps(aRowZero, xy23, _MM_SHUFFLE(2, 0, 3, 0));
+		aOutY = _mm_shuffle_ps(yz01, xy23, _MM_SHUFFLE(3, 1, 2, 0));
+		aOutZ = _mm_shuffle_ps(yz01, aRowTwo, _MM_SHUFFLE(3, 0, 3, 1));
+	}
+
+/// @brief Inverse of Deinterleave.
+	inline void Interleave(__m128 aX, __m128 aY, __m128 aZ, __m128& aOutRowZero, __m128& aOutRowOne, __m128& aOutRowTwo)
+	{
+		const __m128 xy01 = _mm_unpacklo_ps(aX, aY);										// x0 y0 x1 y1
+		const __m128 xy23 = _mm_unpackhi_ps(aX, aY);										// x2 y2 x3 y3
+		const __m128 zx = _mm_shuffle_ps(aZ, aX, _MM_SHUFFLE(1, 1, 0, 0));					// z0 z0 x1 x1
+		const __m128 yz = _mm_shuffle_ps(aY, aZ, _MM_SHUFFLE(2, 1, 2, 1));					// y1 y2 z1 z2
+		const __m128 zzxx = _mm_shuffle_ps(aZ, xy23, _MM_SHUFFLE(2, 2, 2, 2));				// z2 z2 x3 x3
+		const __m128 yyzz = _mm_shuffle_ps(xy23, aZ, _MM_SHUFFLE(3, 3, 3, 3));				// y3 y3 z3 z3
+		aOutRowZero = _mm_shuffle_ps(xy01, zx, _MM_SHUFFLE(2, 0, 1, 0));
+		aOutRowOne = _mm_shuffle_ps(yz, xy23, _MM_SHUFFLE(1, 0, 2, 0));
+		aOutRowTwo = _mm_shuffle_ps(zzxx, yyzz, _MM_SHUFFLE(2, 0, 2, 0));
+	}
+
+/// @brief Runs aKernel on a single packed element, only lane 0 of the registers is used.
+	template<class TKernel>
+	inline void RunSingle(const float* aSource, float* aDestination, const TKernel& aKernel)
+	{
+		__m128 x = _mm_load_ss(aSource);
+		__m128 y = _mm_load_ss(aSource + 1);
+		__m128 z = _mm_load_ss(aSource + 2);
+		aKernel(x, y, z);
+		_mm_store_ss(aDestination, x);
+		_mm_store_ss(aDestination + 1, y);
+		_mm_store_ss(aDestination + 2, z);
+	}
+
+	template<bool aAlignedLoad, StoreMode aMode, class TKernel>
+	inline void RunBlocks(const float* aSource, float* aDestination, size_t aBlockCount, const TKernel& aKernel)
+	{
+		for (size_t block = 0; block < aBlockCount; ++block)
+		{
+			const float* source = aSource + block * 12;
+			float* destination = aDestination + block * 12;
+
+			__m128 x, y, z;
+			Deinterleave(Load<aAlignedLoad>(source), Load<aAlignedLoad>(source + 4), Load<aAlignedLoad>(source + 8), x, y, z);
+			aKernel(x, y, z);
+
+			__m128 rowZero, rowOne, rowTwo;
+			Interleave(x, y, z, rowZero, rowOne, rowTwo);
+			Store<aMode>(destination, rowZero);
+			Store<aMode>(destination + 4, rowOne);
+			Store<aMode>(destination + 8, rowTwo);
+		}
+	}
+
+/**
+* @brief Applies aKernel to aCount packed xyz elements.
+*
+* @details aKernel(x, y, z) works in place on structure-of-arrays registers. Elements are peeled
+* one at a time until the output is 16-byte aligned, then blocks of four run with aligned stores
+* (and aligned loads if the input lines up too).
+*/
+	template<class TKernel>
+	inline void ForEachPacked(const float* aSource, float* aDestination, size_t aCount, const TKernel& aKernel)
+	{
+		size_t index = 0;
+		// Stepping 12 bytes reaches every 4-byte offset within 16 bytes, so at most three elements are peeled
+		if (BB::IsAligned(aDestination, sizeof(float)))
+		{
+			while (index < aCount && !BB::IsAligned(aDestination + index * 3, 16))
+			{
+				RunSingle(aSource + index * 3, aDestination + index * 3, aKernel);
+				++index;
+			}
+		}
+
+		const size_t blockCount = (aCount - index) / 4;
+		const float* source = aSource + index * 3;
+		float* destination = aDestination + index * 3;
+		const bool alignedLoad = BB::IsAligned(source, 16);
+
+		if (!BB::IsAligned(destination, 16))
+		{
+			RunBlocks<false, StoreMode::Unaligned>(source, destination, blockCount, aKernel);
+		}
+		else if (ShouldStream(aCount * 3 * sizeof(float)))
+		{
+			alignedLoad ? RunBlocks<true, StoreMode::Stream>(source, destination, blockCount, aKernel)
+						: RunBlocks<false, StoreMode::Stream>(source, destination, blockCount, aKernel);
+			_mm_sfence();
+		}
+		else
+		{
+			alignedLoad ? RunBlocks<true, StoreMode::Aligned>(source, destination, blockCount, aKernel)
+						: RunBlocks<false, StoreMode::Aligned>(source, destination, blockCount, aKernel);
+		}
+
+		for (index += blockCount * 4; index < aCount; ++index)
+		{
+			RunSingle(aSource + index * 3, aDestination + index * 3, aKernel);
+		}
+	}
+
+/// @brief Applies aKernel(__m128) to every Vec3f/Vec4f sized element, streaming large outputs.
+	template<class TVector, class TKernel>
+	inline void ForEachVector(const TVector* aSource, TVector* aDestination, size_t aCount, const TKernel& aKernel)
+	{
+		if (ShouldStream(aCount * sizeof(TVector)))
+		{
+			for (size_t i = 0; i < aCount; ++i)
+			{
+				_mm_stream_ps(reinterpret_cast<float*>(aDestination + i), aKernel(aSource[i].data));
+			}
+			_mm_sfence();
+			return;
+		}
+		for (size_t i = 0; i < aCount; ++i)
+		{
+			aDestination[i].data = aKernel(aSource[i].data);
+		}
+	}
+
+/// @brief Applies aKernel(__m128, __m128) to every pair of Vec3f/Vec4f sized elements, streaming large outputs.
+	template<class TVector, class TKernel>
+	inline void ForEachVectorPair(const TVector* aOne, const TVector* aTwo, TVector* aDestination, size_t aCount, const TKernel& aKernel)
+	{
+		if (ShouldStream(aCount * sizeof(TVector)))
+		{
+			for (size_t i = 0; i < aCount; ++i)
+			{
+				_mm_stream_ps(reinterpret_cast<float*>(aDestination + i), aKernel(aOne[i].data, aTwo[i].data));
+			}
+			_mm_sfence();
+			return;
+		}
+		for (size_t i = 0; i < aCount; ++i)
+		{
+			aDestination[i].data = aKernel(aOne[i].data, aTwo[i].data);
+		}
+	}
+
+/// @brief Kernel for row vector times matrix on structure-of-arrays registers, aTranslate adds row 3.
+	template<bool aTranslate>
+	struct TransformKernel
+	{
+		explicit TransformKernel(const Mat4x4f& aMatrix)
+		{
+			for (int i = 0; i < 12; ++i)
+			{
+				myElements[i] = _mm_set1_ps(aMatrix.data[(i / 3) * 4 + i % 3]);
+			}
+		}
+
+		void operator()(__m128& aX, __m128& aY, __m128& aZ) const
+		{
+			__m128 result[3];
+			for (int column = 0; column < 3; ++column)
+			{
+				__m128 sum = aTranslate ? BB::Simd::MulAdd(aZ, myElements[6 + column], myElements[9 + column])
+										: _mm_mul_ps(aZ, myElements[6 + column]);
+				sum = BB::Simd::MulAdd(aY, myElements[3 + column], sum);
+				result[column] = BB::Simd::MulAdd(aX, myElements[column], sum);
+			}
+			aX = result[0];
+			aY = result[1];
+			aZ = result[2];
+		}
+
+		// Element (row, column) of the upper 4x3 part at [row * 3 + column], broadcast to all lanes
+		__m128 myElements[12];
+	};
+
+	struct NormalizeKernel
+	{
+		void operator()(__m128& aX, __m128& aY, __m128& aZ) const
+		{
+			const __m128 length = _mm_sqrt_ps(BB::Simd::MulAdd(aZ, aZ, BB::Simd::MulAdd(aY, aY, _mm_mul_ps(aX, aX))));
+			aX = _mm_div_ps(aX, length);
+			aY = _mm_div_ps(aY, length);
+			aZ = _mm_div_ps(aZ, length);
+		}
+	};
+
+/// @brief Kernel for a single Vec3f/Vec4f register, aMask clears w for Vec3f results.
+	struct RowTransformKernel
+	{
+		RowTransformKernel(const Mat4x4f& aMatrix, __m128 aTranslation, __m128 aMask)
+			: myRows{ aMatrix.row[0], aMatrix.row[1], aMatrix.row[2], aMatrix.row[3] }
+			, myTranslation(aTranslation)
+			, myMask(aMask)
+		{
+		}
+
+		__m128 operator()(__m128 aVector) const
+		{
+			__m128 result = BB::Simd::MulAdd(BB::Simd::Splat<3>(aVector), myRows[3], myTranslation);
+			result = BB::Simd::MulAdd(BB::Simd::Splat<2>(aVector), myRows[2], result);
+			result = BB::Simd::MulAdd(BB::Simd::Splat<1>(aVector), myRows[1], result);
+			result = BB::Simd::MulAdd(BB::Simd::Splat<0>(aVector), myRows[0], result);
+			return _mm_and_ps(result, myMask);
+		}
+
+		__m128 myRows[4];
+		__m128 myTranslation;
+		__m128 myMask;
+	};
+
+	inline __m128 Vec3fMask()
+	{
+		return _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+	}
+
+	enum class ViewLayout { Packed, Padded, Strided };
+
+	template<class TVector>
+	inline ViewLayout GetLayout(const StreamView<TVector>& aView)
+	{
+		if (aView.GetStride() == 3 * sizeof(float))
+		{
+			return ViewLayout::Packed;
+		}
+		return aView.GetStride() == 4 * sizeof(float) ? ViewLayout::Padded : ViewLayout::Strided;
+	}
+
+/// @brief Loads elements aIndex to aIndex + 3 of a Vec3f view into x, y and z registers.
+	template<ViewLayout aLayout>
+	inline void LoadBlock(const StreamView<const Vec3f>& aView, size_t aIndex, __m128& aOutX, __m128& aOutY, __m128& aOutZ)
+	{
+		if constexpr (aLayout == ViewLayout::Packed)
+		{
+			const float* element = aView.GetElement(aIndex);
+			Deinterleave(_mm_loadu_ps(element), _mm_loadu_ps(element + 4), _mm_loadu_ps(element + 8), aOutX, aOutY, aOutZ);
+		}
+		else
+		{
+			__m128 rows[4];
+			for (int i = 0; i < 4; ++i)
+			{
+				const float* element = aView.GetElement(aIndex + i);
+				rows[i] = aLayout == ViewLayout::Padded ? _mm_loadu_ps(element) : Vec3f::LoadUnaligned(element).data;
+			}
+			_MM_TRANSPOSE4_PS(rows[0], rows[1], rows[2], rows[3]);
+			aOutX = rows[0];
+			aOutY = rows[1];
+			aOutZ = rows[2];
+		}
+	}
+
+/// @brief Writes x, y and z registers to elements aIndex to aIndex + 3 of a Vec3f view.
+	template<ViewLayout aLayout>
+	inline void StoreBlock(const StreamView<Vec3f>& aView, size_t aIndex, __m128 aX, __m128 aY, __m128 aZ)
+	{
+		if constexpr (aLayout == ViewLayout::Packed)
+		{
+			float* element = aView.GetElement(aIndex);
+			__m128 rowZero, rowOne, rowTwo;
+			Interleave(aX, aY, aZ, rowZero, rowOne, rowTwo);
+			_mm_storeu_ps(element, rowZero);
+			_mm_storeu_ps(element + 4, rowOne);
+			_mm_storeu_ps(element + 8, rowTwo);
+		}
+		else
+		{
+			__m128 rows[4] = { aX, aY, aZ, _mm_setzero_ps() };
+			_MM_TRANSPOSE4_PS(rows[0], rows[1], rows[2], rows[3]);
+			for (int i = 0; i < 4; ++i)
+			{
+				float* element = aView.GetElement(aIndex + i);
+				if constexpr (aLayout == ViewLayout::Padded)
+				{
+					// Keep whatever the fourth float of the element holds
+					_mm_storeu_ps(element, _mm_blend_ps(_mm_loadu_ps(element), rows[i], 0x7));
+				}
+				else
+				{
+					Vec3f(rows[i]).StoreUnaligned(element);
+				}
+			}
+		}
+	}
+
+	template<ViewLayout aInput, ViewLayout aOutput, class TKernel>
+	inline void RunViewBlocks(const StreamView<const Vec3f>& aSource, const StreamView<Vec3f>& aDestination, size_t aEnd, const TKernel& aKernel)
+	{
+		for (size_t index = 0; index < aEnd; index += 4)
+		{
+			__m128 x, y, z;
+			LoadBlock<aInput>(aSource, index, x, y, z);
+			aKernel(x, y, z);
+			StoreBlock<aOutput>(aDestination, index, x, y, z);
+		}
+	}
+
+	template<ViewLayout aInput, class TKernel>
+	inline void DispatchViewBlocks(const StreamView<const Vec3f>& aSource, const StreamView<Vec3f>& aDestination, size_t aEnd, const TKernel& aKernel)
+	{
+		switch (GetLayout(aDestination))
+		{
+		case ViewLayout::Packed: RunViewBlocks<aInput, ViewLayout::Packed>(aSource, aDestination, aEnd, aKernel); break;
+		case ViewLayout::Padded: RunViewBlocks<aInput, ViewLayout::Padded>(aSource, aDestination, aEnd, aKernel); break;
+		default: RunViewBlocks<aInput, ViewLayout::Strided>(aSource, aDestination, aEnd, aKernel); break;
+		}
+	}
+
+/// @brief Applies aKernel to every element of a Vec3f view, picking the load and store path from each stride.
+	template<class TKernel>
+	inline void ForEachView(const StreamView<const Vec3f>& aSource, const StreamView<Vec3f>& aDestination, const TKernel& aKernel)
+	{
+		assert(aSource.GetCount() == aDestination.GetCount() && "Views must have the same count");
+		const size_t count = aSource.GetCount();
+		const ViewLayout input = GetLayout(aSource);
+		const ViewLayout output = GetLayout(aDestination);
+
+		if (input == ViewLayout::Packed && output == ViewLayout::Packed)
+		{
+			ForEachPacked(aSource.GetData(), aDestination.GetData(), count, aKernel);
+			return;
+		}
+
+		// A padded element is accessed with 16 bytes, for the last element that would be past the
+		// end of the buffer, so it is always left to the single element path
+		size_t blockEnd = count & ~size_t(3);
+		if (blockEnd == count && count > 0 && (input == ViewLayout::Padded || output == ViewLayout::Padded))
+		{
+			blockEnd -= 4;
+		}
+
+		switch (input)
+		{
+		case ViewLayout::Packed: DispatchViewBlocks<ViewLayout::Packed>(aSource, aDestination, blockEnd, aKernel); break;
+		case ViewLayout::Padded: DispatchViewBlocks<ViewLayout::Padded>(aSource, aDestination, blockEnd, aKernel); break;
+		default: DispatchViewBlocks<ViewLayout::Strided>(aSource, aDestination, blockEnd, aKernel); break;
+		}
+
+		for (size_t index = blockEnd; index < count; ++index)
+		{
+			RunSingle(aSource.GetElement(index), aDestination.GetElement(index), aKernel);
+		}
+	}
+} // namespace Detail
+
+#pragma region PackedArrays
+
+	inline void TransformPoints(const Mat4x4f& aMatrix, const float* aPoints, float* aOutPoints, size_t aCount)
+	{
+		Detail::ForEachPacked(aPoints, aOutPoints, aCount, Detail::TransformKernel<true>(aMatrix));
+	}
+
+	inline void TransformVectors(const Mat4x4f& aMatrix, const float* aVectors, float* aOutVectors, size_t aCount)
+	{
+		Detail::ForEachPacked(aVectors, aOutVectors, aCount, Detail::TransformKernel<false>(aMatrix));
+	}
+
+	inline void Normalize(const float* aVectors, float* aOutVectors, size_t aCount)
+	{
+		Detail::ForEachPacked(aVectors, aOutVectors, aCount, Detail::NormalizeKernel());
+	}
+
+	inline void Bounds(const float* aPoints, size_t aCount, Vec3f& aOutMin, Vec3f& aOutMax)
+	{
+		__m128 minimum = _mm_set1_ps(FLT_MAX);
+		__m128 maximum = _mm_set1_ps(-FLT_MAX);
+
+		size_t index = 0;
+		if (BB::IsAligned(aPoints, sizeof(float)))
+		{
+			while (index < aCount && !BB::IsAligned(aPoints + index * 3, 16))
+			{
+				const __m128 point = Vec3f::LoadUnaligned(aPoints + index * 3).data;
+				minimum = _mm_min_ps(minimum, point);
+				maximum = _mm_max_ps(maximum, point);
+				++index;
+			}
+		}
+
+		// Four packed points are three registers, each register keeps its own min/max and the
+		// lanes are sorted back into x, y and z once at the end
+		const size_t blockCount = (aCount - index) / 4;
+		if (blockCount > 0)
+		{
+			const float* source = aPoints + index * 3;
+			const bool aligned = BB::IsAligned(source, 16);
+			__m128 minimums[3] = { _mm_set1_ps(FLT_MAX), _mm_set1_ps(FLT_MAX), _mm_set1_ps(FLT_MAX) };
+			__m128 maximums[3] = { _mm_set1_ps(-FLT_MAX), _mm_set1_ps(-FLT_MAX), _mm_set1_ps(-FLT_MAX) };
+			for (size_t block = 0; block < blockCount; ++block, source += 12)
+			{
+				for (int i = 0; i < 3; ++i)
+				{
+					const __m128 row = aligned ? Detail::Load<true>(source + i * 4) : Detail::Load<false>(source + i * 4);
+					minimums[i] = _mm_min_ps(minimums[i], row);
+					maximums[i] = _mm_max_ps(maximums[i], row);
+				}
+			}
+
+			__m128 x, y, z;
+			Detail::Deinterleave(minimums[0], minimums[1], minimums[2], x, y, z);
+			_MM_TRANSPOSE4_PS(x, y, z, minimums[0]);
+			minimum = _mm_min_ps(minimum, _mm_min_ps(_mm_min_ps(x, y), _mm_min_ps(z, minimums[0])));
+
+			Detail::Deinterleave(maximums[0], maximums[1], maximums[2], x, y, z);
+			_MM_TRANSPOSE4_PS(x, y, z, maximums[0]);
+			maximum = _mm_max_ps(maximum, _mm_max_ps(_mm_max_ps(x, y), _mm_max_ps(z, maximums[0])));
+			index += blockCount * 4;
+		}
+
+		for (; index < aCount; ++index)
+		{
+			const __m128 point = Vec3f::LoadUnaligned(aPoints + index * 3).data;
+			minimum = _mm_min_ps(minimum, point);
+			maximum = _mm_max_ps(maximum, point);
+		}
+
+		aOutMin = _mm_and_ps(minimum, Detail::Vec3fMask());
+		aOutMax = _mm_and_ps(maximum, Detail::Vec3fMask());
+	}
+
+	inline size_t Sanitize(const float* aValues, float aReplacement, float* aOutValues, size_t aCount)
+	{
+		const size_t floatCount = aCount * 3;
+		const __m128 replacement = _mm_set1_ps(aReplacement);
+		size_t replaced = 0;
+		size_t i = 0;
+		for (; i + 4 <= floatCount; i += 4)
+		{
+			const __m128 values = _mm_loadu_ps(aValues + i);
+			const __m128 finite = BB::Simd::FiniteMask(values);
+			replaced += std::popcount(unsigned(_mm_movemask_ps(finite)) ^ 0xFu);
+			_mm_storeu_ps(aOutValues + i, BB::Simd::Select(finite, values, replacement));
+		}
+		for (; i < floatCount; ++i)
+		{
+			const __m128 value = _mm_load_ss(aValues + i);
+			const __m128 finite = BB::Simd::FiniteMask(value);
+			replaced += (_mm_movemask_ps(finite) & 1) ^ 1;
+			_mm_store_ss(aOutValues + i, BB::Simd::Select(finite, value, replacement));
+		}
+		return replaced;
+	}
+
+#pragma endregion PackedArrays
+
+#pragma region VectorArrays
+
+	inline void TransformPoints(const Mat4x4f& aMatrix, const Vec3f* aPoints, Vec3f* aOutPoints, size_t aCount)
+	{
+		Detail::ForEachVector(aPoints, aOutPoints, aCount, Detail::RowTransformKernel(aMatrix, aMatrix.row[3], Detail::Vec3fMask()));
+	}
+
+	inline void TransformVectors(const Mat4x4f& aMatrix, const Vec3f* aVectors, Vec3f* aOutVectors, size_t aCount)
+	{
+		Detail::ForEachVector(aVectors, aOutVectors, aCount, Detail::RowTransformKernel(aMatrix, _mm_setzero_ps(), Detail::Vec3fMask()));
+	}
+
+	inline void Transform(const Mat4x4f& aMatrix, const Vec4f* aVectors, Vec4f* aOutVectors, size_t aCount)
+	{
+		const __m128 allLanes = _mm_castsi128_ps(_mm_set1_epi32(-1));
+		Detail::ForEachVector(aVectors, aOutVectors, aCount, Detail::RowTransformKernel(aMatrix, _mm_setzero_ps(), allLanes));
+	}
+
+	inline void Normalize(const Vec3f* aVectors, Vec3f* aOutVectors, size_t aCount)
+	{
+		Detail::ForEachVector(aVectors, aOutVectors, aCount, [](__m128 aVector)
+		{
+			return _mm_div_ps(aVector, _mm_sqrt_ps(_mm_dp_ps(aVector, aVector, 0x7F)));
+		});
+	}
+
+	inline void Bounds(const Vec3f* aPoints, size_t aCount, Vec3f& aOutMin, Vec3f& aOutMax)
+	{
+		__m128 minimum = _mm_set1_ps(FLT_MAX);
+		__m128 maximum = _mm_set1_ps(-FLT_MAX);
+		for (size_t i = 0; i < aCount; ++i)
+		{
+			minimum = _mm_min_ps(minimum, aPoints[i].data);
+			maximum = _mm_max_ps(maximum, aPoints[i].data);
+		}
+		aOutMin = _mm_and_ps(minimum, Detail::Vec3fMask());
+		aOutMax = _mm_and_ps(maximum, Detail::Vec3fMask());
+	}
+
+	inline size_t Sanitize(const Vec3f* aVectors, const Vec3f& aReplacement, Vec3f* aOutVectors, size_t aCount)
+	{
+		size_t replaced = 0;
+		for (size_t i = 0; i < aCount; ++i)
+		{
+			const __m128 finite = BB::Simd::FiniteMask(aVectors[i].data);
+			replaced += std::popcount((unsigned(_mm_movemask_ps(finite)) ^ 0xFu) & 0x7u);
+			aOutVectors[i].data = BB::Simd::Select(finite, aVectors[i].data, aReplacement.data);
+		}
+		return replaced;
+	}
+
+	inline size_t Sanitize(const Vec4f* aVectors, const Vec4f& aReplacement, Vec4f* aOutVectors, size_t aCount)
+	{
+		size_t replaced = 0;
+		for (size_t i = 0; i < aCount; ++i)
+		{
+			const __m128 finite = BB::Simd::FiniteMask(aVectors[i].data);
+			replaced += std::popcount((unsigned(_mm_movemask_ps(finite)) ^ 0xFu) & 0xFu);
+			aOutVectors[i].data = BB::Simd::Select(finite, aVectors[i].data, aReplacement.data);
+		}
+		return replaced;
+	}
+
+#pragma endregion VectorArrays
+
+#pragma region ComponentWiseArrays
+
+	inline void Min(const Vec3f* aOne, const Vec3f* aTwo, Vec3f* aOut, size_t aCount)
+	{
+		Detail::ForEachVectorPair(aOne, aTwo, aOut, aCount, [](__m128 aA, __m128 aB) { return _mm_min_ps(aA, aB); });
+	}
+
+	inline void Max(const Vec3f* aOne, const Vec3f* aTwo, Vec3f* aOut, size_t aCount)
+	{
+		Detail::ForEachVectorPair(aOne, aTwo, aOut, aCount, [](__m128 aA, __m128 aB) { return _mm_max_ps(aA, aB); });
+	}
+
+	inline void Abs(const Vec3f* aVectors, Vec3f* aOut, size_t aCount)
+	{
+		Detail::ForEachVector(aVectors, aOut, aCount, [](__m128 aVector) { return BB::Simd::Abs(aVector); });
+	}
+
+	inline void Clamp(const Vec3f* aVectors, const Vec3f& aMin, const Vec3f& aMax, Vec3f* aOut, size_t aCount)
+	{
+		const __m128 minimum = aMin.data;
+		const __m128 maximum = aMax.data;
+		Detail::ForEachVector(aVectors, aOut, aCount, [minimum, maximum](__m128 aVector) { return BB::Simd::Clamp(aVector, minimum, maximum); });
+	}
+
+	inline void Floor(const Vec3f* aVectors, Vec3f* aOut, size_t aCount)
+	{
+		Detail::ForEachVector(aVectors, aOut, aCount, [](__m128 aVector) { return _mm_floor_ps(aVector); });
+	}
+
+	inline void Ceil(const Vec3f* aVectors, Vec3f* aOut, size_t aCount)
+	{
+		Detail::ForEachVector(aVectors, aOut, aCount, [](__m128 aVector) { return _mm_ceil_ps(aVector); });
+	}
+
+	inline void Sign(const Vec3f* aVectors, Vec3f* aOut, size_t aCount)
+	{
+		Detail::ForEachVector(aVectors, aOut, aCount, [](__m128 aVector) { return BB::Simd::Sign(aVector); });
+	}
+
+	inline void Lerp(const Vec3f* aFrom, const Vec3f* aTo, float aT, Vec3f* aOut, size_t aCount)
+	{
+		const __m128 t = _mm_set1_ps(aT);
+		Detail::ForEachVectorPair(aFrom, aTo, aOut, aCount, [t](__m128 aA, __m128 aB) { return BB::Simd::Lerp(aA, aB, t); });
+	}
+
+	inline void Min(const Vec4f* aOne, const Vec4f* aTwo, Vec4f* aOut, size_t aCount)
+	{
+		Detail::ForEachVectorPair(aOne, aTwo, aOut, aCount, [](__m128 aA, __m128 aB) { return _mm_min_ps(aA, aB); });
+	}
+
+	inline void Max(const Vec4f* aOne, const Vec4f* aTwo, Vec4f* aOut, size_t aCount)
+	{
+		Detail::ForEachVectorPair(aOne, aTwo, aOut, aCount, [](__m128 aA, __m128 aB) { return _mm_max_ps(aA, aB); });
+	}
+
+	inline void Abs(const Vec4f* aVectors, Vec4f* aOut, size_t aCount)
+	{
+		Detail::ForEachVector(aVectors, aOut, aCount, [](__m128 aVector) { return BB::Simd::Abs(aVector); });
+	}
+
+	inline void Clamp(const Vec4f* aVectors, const Vec4f& aMin, const Vec4f& aMax, Vec4f* aOut, size_t aCount)
+	{
+		const __m128 minimum = aMin.data;
+		const __m128 maximum = aMax.data;
+		Detail::ForEachVector(aVectors, aOut, aCount, [minimum, maximum](__m128 aVector) { return BB::Simd::Clamp(aVector, minimum, maximum); });
+	}
+
+	inline void Floor(const Vec4f* aVectors, Vec4f* aOut, size_t aCount)
+	{
+		Detail::ForEachVector(aVectors, aOut, aCount, [](__m128 aVector) { return _mm_floor_ps(aVector); });
+	}
+
+	inline void Ceil(const Vec4f* aVectors, Vec4f* aOut, size_t aCount)
+	{
+		Detail::ForEachVector(aVectors, aOut, aCount, [](__m128 aVector) { return _mm_ceil_ps(aVector); });
+	}
+
+	inline void Sign(const Vec4f* aVectors, Vec4f* aOut, size_t aCount)
+	{
+		Detail::ForEachVector(aVectors, aOut, aCount, [](__m128 aVector) { return BB::Simd::Sign(aVector); });
+	}
+
+	inline void Lerp(const Vec4f* aFrom, const Vec4f* aTo, float aT, Vec4f* aOut, size_t aCount)
+	{
+		const __m128 t = _mm_set1_ps(aT);
+		Detail::ForEachVectorPair(aFrom, aTo, aOut, aCount, [t](__m128 aA, __m128 aB) { return BB::Simd::Lerp(aA, aB, t); });
+	}
+
+#pragma endregion ComponentWiseArrays
+
+#pragma region StreamViews
+
+	inline void TransformPoints(const Mat4x4f& aMatrix, StreamView<const Vec3f> aPoints, StreamView<Vec3f> aOutPoints)
+	{
+		Detail::ForEachView(aPoints, aOutPoints, Detail::TransformKernel<true>(aMatrix));
+	}
+
+	inline void TransformVectors(const Mat4x4f& aMatrix, StreamView<const Vec3f> aVectors, StreamView<Vec3f> aOutVectors)
+	{
+		Detail::ForEachView(aVectors, aOutVectors, Detail::TransformKernel<false>(aMatrix));
+	}
+
+	inline void Transform(const Mat4x4f& aMatrix, StreamView<const Vec4f> aVectors, StreamView<Vec4f> aOutVectors)
+	{
+		assert(aVectors.GetCount() == aOutVectors.GetCount() && "Views must have the same count");
+		// A Vec4f element is exactly one unaligned load and store whatever the stride is
+		const Detail::RowTransformKernel kernel(aMatrix, _mm_setzero_ps(), _mm_castsi128_ps(_mm_set1_epi32(-1)));
+		for (size_t i = 0; i < aVectors.GetCount(); ++i)
+		{
+			_mm_storeu_ps(aOutVectors.GetElement(i), kernel(_mm_loadu_ps(aVectors.GetElement(i))));
+		}
+	}
+
+	inline void Normalize(StreamView<const Vec3f> aVectors, StreamView<Vec3f> aOutVectors)
+	{
+		Detail::ForEachView(aVectors, aOutVectors, Detail::NormalizeKernel());
+	}
+
+	inline void Bounds(StreamView<const Vec3f> aPoints, Vec3f& aOutMin, Vec3f& aOutMax)
+	{
+		if (aPoints.IsPacked())
+		{
+			Bounds(aPoints.GetData(), aPoints.GetCount(), aOutMin, aOutMax);
+			return;
+		}
+
+		__m128 minimum = _mm_set1_ps(FLT_MAX);
+		__m128 maximum = _mm_set1_ps(-FLT_MAX);
+		const size_t count = aPoints.GetCount();
+		// Padded elements are read whole and masked, except the last one (see ForEachView)
+		const size_t paddedEnd = Detail::GetLayout(aPoints) == Detail::ViewLayout::Padded && count > 0 ? count - 1 : 0;
+		for (size_t i = 0; i < count; ++i)
+		{
+			const __m128 point = i < paddedEnd ? _mm_and_ps(_mm_loadu_ps(aPoints.GetElement(i)), Detail::Vec3fMask())
+											   : Vec3f::LoadUnaligned(aPoints.GetElement(i)).data;
+			minimum = _mm_min_ps(minimum, point);
+			maximum = _mm_max_ps(maximum, point);
+		}
+		aOutMin = _mm_and_ps(minimum, Detail::Vec3fMask());
+		aOutMax = _mm_and_ps(maximum, Detail::Vec3fMask());
+	}
+
+#pragma endregion StreamViews
+} // namespace Bulk
+} // namespace BitBloom
@@ -0,0 +1,74 @@
+#pragma once
+#include <mutex>
+#include "Bulk.h"
+#include "../Parallel/ThreadPool.h"
+
+/**
+ * @file BulkParallel.h
+ * @brief Overloads of the Bulk array kernels that split the work over a BB::ThreadPool.
+ *
+ * @details Each overload takes the pool as its first argument and otherwise matches the
+ * single-threaded kernel in Bulk.h. Chunks are BB_PARALLEL_GRAIN_BYTES of elements rounded to
+ * whole cache lines (see ThreadPool::ParallelForArray), arrays smaller than one chunk run on the
+ * calling thread without waking the workers.
+ */
+
+namespace BitBloom
+{
+namespace Bulk
+{
+	inline void TransformPoints(ThreadPool& aPool, const Mat4x4f& aMatrix, const Vec3f* aPoints, Vec3f* aOutPoints, size_t aCount)
+	{
+		aPool.ParallelForArray<Vec3f>(aCount, 0, [&](size_t aBegin, size_t aEnd)
+		{
+			TransformPoints(aMatrix, aPoints + aBegin, aOutPoints + aBegin, aEnd - aBegin);
+		});
+	}
+
+	inline void TransformVectors(ThreadPool& aPool, const Mat4x4f& aMatrix, const Vec3f* aVectors, Vec3f* aOutVectors, size_t aCount)
+	{
+		aPool.ParallelForArray<Vec3f>(aCount, 0, [&](size_t aBegin, size_t aEnd)
+		{
+			TransformVectors(aMatrix, aVectors + aBegin, aOutVectors + aBegin, aEnd - aBegin);
+		});
+	}
+
+	inline void Transform(ThreadPool& aPool, const Mat4x4f& aMatrix, const Vec4f* aVectors, Vec4f* aOutVectors, size_t aCount)
+	{
+		aPool.ParallelForArray<Vec4f>(aCount, 0, [&](size_t aBegin, size_t aEnd)
+		{
+			Transform(aMatrix, aVectors + aBegin, aOutVectors + aBegin, aEnd - aBegin);
+		});
+	}
+
+	inline void Normalize(ThreadPool& aPool, const Vec3f* aVectors, Vec3f* aOutVectors, size_t aCount)
+	{
+		aPool.ParallelForArray<Vec3f>(aCount, 0, [&](size_t aBegin, size_t aEnd)
+		{
+			Normalize(aVectors + aBegin, aOutVectors + aBegin, aEnd - aBegin);
+		});
+	}
+
+/// @brief Each chunk bounds its own points, the results are merged under a lock (one per chunk).
+	inline void Bounds(ThreadPool& aPool, const Vec3f* aPoints, size_t aCount, Vec3f& aOutMin, Vec3f& aOutMax)
+	{
+		std::mutex mergeMutex;
+		Vec3f minimum(FLT_MAX);
+		Vec3f maximum(-FLT_MAX);
+		aPool.ParallelForArray<Vec3f>(aCount, 0, [&](size_t aBegin, size_t aEnd)
+		{
+			Vec3f chunkMin;
+			Vec3f chunkMax;
+			Bounds(aPoints + aBegin, aEnd - aBegin, chunkMin, chunkMax);
+
+			std::lock_guard<std::mutex> lock(mergeMutex);
+			minimum = Min(minimum, chunkMin);
+			maximum = Max(maximum, chunkMax);
+		});
+		aOutMin = minimum;
+		aOutMax = maximum;
+	}
+} // namespace Bulk
+} // namespace BitBloom
+
+namespace BB = BitBloom;
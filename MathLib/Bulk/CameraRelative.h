@@ -0,0 +1,43 @@
+#pragma once
+#include <cstddef>
+#include "Bulk.h"
+#include "../Vector/Vector3d/Vector3d.h"
+#include "../Matrix/Matrix4x4d/Matrix4x4d.h"
+
+/**
+ * @file CameraRelative.h
+ * @brief Batch conversion of double precision world data to float, relative to the camera.
+ *
+ * @details Far from the origin a float cannot hold a position precisely, at 100 km the spacing
+ * between floats is about 8 mm, which shows as jittering vertices. Keeping the world in Vec3d /
+ * Mat4x4d and subtracting the camera position in double before rounding keeps everything near
+ * the camera exact to float precision, so rendering can stay in float. The view matrix is then
+ * built for a camera at the origin.
+ *
+ * @code
+ * BB::Bulk::ToCameraRelative(worldTransforms.data(), cameraPosition, renderTransforms.data(), count);
+ * const Mat4x4f view = Mat4x4f::LookAt(Vec3f(), cameraForward, cameraUp);
+ * @endcode
+ */
+
+namespace BitBloom
+{
+namespace Bulk
+{
+/**
+* @name Camera relative conversion
+* @brief aOut[i] = float(aIn[i] - aCamera), the subtraction is done in double.
+* @{
+*/
+	inline void ToCameraRelative(const Vec3d* aPositions, const Vec3d& aCamera, Vec3f* aOutPositions, size_t aCount);
+/// @brief Writes packed xyz floats (12 bytes per position), e.g. straight into a vertex buffer.
+	inline void ToCameraRelative(const Vec3d* aPositions, const Vec3d& aCamera, float* aOutPositions, size_t aCount);
+/// @brief Only the translation (row 3) is made relative, the other rows are rounded as they are.
+	inline void ToCameraRelative(const Mat4x4d* aTransforms, const Vec3d& aCamera, Mat4x4f* aOutTransforms, size_t aCount);
+/** @} */
+} // namespace Bulk
+} // namespace BitBloom
+
+namespace BB = BitBloom;
+
+#include "CameraRelative.inl"
@@ -0,0 +1,51 @@
+#pragma once
+#include "CameraRelative.h"
+
+namespace BitBloom
+{
+namespace Bulk
+{
+	inline void ToCameraRelative(const Vec3d* aPositions, const Vec3d& aCamera, Vec3f* aOutPositions, size_t aCount)
+	{
+		for (size_t i = 0; i < aCount; ++i)
+		{
+			aOutPositions[i] = Simd::ToFloat4(Simd::Sub(aPositions[i].data, aCamera.data));
+		}
+	}
+
+	inline void ToCameraRelative(const Vec3d* aPositions, const Vec3d& aCamera, float* aOutPositions, size_t aCount)
+	{
+		size_t i = 0;
+		for (; i + 4 <= aCount; i += 4)
+		{
+			__m128 x = Simd::ToFloat4(Simd::Sub(aPositions[i].data, aCamera.data));
+			__m128 y = Simd::ToFloat4(Simd::Sub(aPositions[i + 1].data, aCamera.data));
+			__m128 z = Simd::ToFloat4(Simd::Sub(aPositions[i + 2].data, aCamera.data));
+			__m128 w = Simd::ToFloat4(Simd::Sub(aPositions[i + 3].data, aCamera.data));
+			_MM_TRANSPOSE4_PS(x, y, z, w);
+
+			__m128 rows[3];
+			Detail::Interleave(x, y, z, rows[0], rows[1], rows[2]);
+			float* out = aOutPositions + i * 3;
+			_mm_storeu_ps(out, rows[0]);
+			_mm_storeu_ps(out + 4, rows[1]);
+			_mm_storeu_ps(out + 8, rows[2]);
+		}
+		for (; i < aCount; ++i)
+		{
+			Vec3f(Simd::ToFloat4(Simd::Sub(aPositions[i].data, aCamera.data))).StoreUnaligned(aOutPositions + i * 3);
+		}
+	}
+
+	inline void ToCameraRelative(const Mat4x4d* aTransforms, const Vec3d& aCamera, Mat4x4f* aOutTransforms, size_t aCount)
+	{
+		for (size_t i = 0; i < aCount; ++i)
+		{
+			const Mat4x4d& transform = aTransforms[i];
+			// The w of a Vec3d is zero, so the 1 in row 3 stays untouched
+			aOutTransforms[i] = Mat4x4f(Simd::ToFloat4(transform.row[0]), Simd::ToFloat4(transform.row[1]),
+										Simd::ToFloat4(transform.row[2]), Simd::ToFloat4(Simd::Sub(transform.row[3], aCamera.data)));
+		}
+	}
+} // namespace Bulk
+} // namespace BitBloom
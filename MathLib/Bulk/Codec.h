@@ -0,0 +1,111 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include "Bulk.h"
+
+/**
+ * @file Codec.h
+ * @brief Array kernels that pack Vec3f / Vec4f into compressed vertex formats and back.
+ *
+ * @details Normals, tangents and colors rarely need 32-bit floats. The formats here keep them two
+ * to four times smaller in memory and decode with a handful of SIMD instructions per element:
+ *
+ * | Format            | Bytes (Vec3f / Vec4f) | Range                | Typical use               |
+ * |-------------------|-----------------------|----------------------|---------------------------|
+ * | Half              | 6 / 8                 | IEEE binary16        | positions, uvs            |
+ * | Snorm16           | 6 / 8                 | [-1, 1]              | normals, tangents         |
+ * | Unorm8            | 3 / 4                 | [0, 1]               | colors, weights           |
+ * | Octahedral        | 4 (Vec3f)             | unit vectors         | normals                   |
+ * | Unorm1010102      | 4 (Vec4f)             | [0, 1], w in [0, 1]  | colors with 2 bit alpha   |
+ * | Snorm1010102      | 4 (Vec4f)             | [-1, 1], w in [-1, 1]| tangent with sign in w    |
+ *
+ * Encoding clamps to the range of the format (NaN becomes the lower bound) and rounds to nearest.
+ * Decoding maps the normalized integer k to k / max, the most negative snorm value decodes to -1
+ * like the GPU formats. Decoded Vec3f have w = 0.
+ *
+ * The fp16 conversion uses F16C when the compiler targets it (/arch:AVX2 on MSVC, -mf16c on
+ * GCC/Clang) and an SSE2 fallback otherwise, which gives the same bits except for NaN payloads.
+ * Define `BB_NO_F16C` to always use the fallback. The fallback decodes half subnormals to zero
+ * when denormals-are-zero is enabled.
+ *
+ * The packed 10:10:10:2 layout puts x in the low bits: `x | y << 10 | z << 20 | w << 30`, the
+ * same as DXGI_FORMAT_R10G10B10A2 and GL_UNSIGNED_INT_2_10_10_10_REV. Octahedral normals store x
+ * in the low and y in the high 16 bits as snorm16.
+ *
+ * @code
+ * std::vector<uint32_t> packedNormals(count);
+ * BB::Bulk::EncodeOctahedral(normals.data(), packedNormals.data(), count);
+ * @endcode
+ */
+
+#if !defined(BB_NO_F16C) && (defined(__F16C__) || defined(__AVX2__))
+#define BB_USE_F16C
+#endif
+
+namespace BitBloom
+{
+namespace Bulk
+{
+/**
+* @name fp16
+* @brief Three (Vec3f) or four (Vec4f) halves per element.
+* @{
+*/
+	inline void EncodeHalf(const Vec3f* aVectors, uint16_t* aOutHalves, size_t aCount);
+	inline void EncodeHalf(const Vec4f* aVectors, uint16_t* aOutHalves, size_t aCount);
+	inline void DecodeHalf(const uint16_t* aHalves, Vec3f* aOutVectors, size_t aCount);
+	inline void DecodeHalf(const uint16_t* aHalves, Vec4f* aOutVectors, size_t aCount);
+/** @} */
+
+/**
+* @name snorm16
+* @brief Three (Vec3f) or four (Vec4f) int16_t per element, [-1, 1] maps to [-32767, 32767].
+* @{
+*/
+	inline void EncodeSnorm16(const Vec3f* aVectors, int16_t* aOutValues, size_t aCount);
+	inline void EncodeSnorm16(const Vec4f* aVectors, int16_t* aOutValues, size_t aCount);
+	inline void DecodeSnorm16(const int16_t* aValues, Vec3f* aOutVectors, size_t aCount);
+	inline void DecodeSnorm16(const int16_t* aValues, Vec4f* aOutVectors, size_t aCount);
+/** @} */
+
+/**
+* @name unorm8
+* @brief Three (Vec3f) or four (Vec4f) bytes per element, [0, 1] maps to [0, 255].
+* @{
+*/
+	inline void EncodeUnorm8(const Vec3f* aVectors, uint8_t* aOutValues, size_t aCount);
+	inline void EncodeUnorm8(const Vec4f* aVectors, uint8_t* aOutValues, size_t aCount);
+	inline void DecodeUnorm8(const uint8_t* aValues, Vec3f* aOutVectors, size_t aCount);
+	inline void DecodeUnorm8(const uint8_t* aValues, Vec4f* aOutVectors, size_t aCount);
+/** @} */
+
+/**
+* @name Octahedral normals
+* @brief Unit vectors as two snorm16 in one uint32_t.
+*
+* @details The sphere is projected onto an octahedron and unfolded into a square, which spreads the
+* precision evenly over all directions, the error stays below 0.0001 radians. The input does
+* not have to be normalized, zero vectors encode as +z. Decoded vectors are normalized.
+* @{
+*/
+	inline void EncodeOctahedral(const Vec3f* aNormals, uint32_t* aOutPacked, size_t aCount);
+	inline void DecodeOctahedral(const uint32_t* aPacked, Vec3f* aOutNormals, size_t aCount);
+/** @} */
+
+/**
+* @name 10:10:10:2
+* @brief One uint32_t per Vec4f, 10 bits for x, y and z and 2 bits for w.
+* @{
+*/
+	inline void EncodeUnorm1010102(const Vec4f* aVectors, uint32_t* aOutPacked, size_t aCount);
+	inline void DecodeUnorm1010102(const uint32_t* aPacked, Vec4f* aOutVectors, size_t aCount);
+/// @brief x, y and z map [-1, 1] to [-511, 511], w maps [-1, 1] to [-1, 1], e.g. the handedness of a tangent.
+	inline void EncodeSnorm1010102(const Vec4f* aVectors, uint32_t* aOutPacked, size_t aCount);
+	inline void DecodeSnorm1010102(const uint32_t* aPacked, Vec4f* aOutVectors, size_t aCount);
+/** @} */
+} // namespace Bulk
+} // namespace BitBloom
+
+namespace BB = BitBloom;
+
+#include "Codec.inl"
@@ -0,0 +1,460 @@
+#pragma once
+#include "Codec.h"
+#include <cfloat>
+#include <cstring>
+#include <type_traits>
+
+namespace BitBloom
+{
+namespace Bulk
+{
+namespace Detail
+{
+/// @brief Converts four floats to halves in the low 64 bits, rounding to nearest even.
+	inline __m128i FloatToHalf(__m128 aValues)
+	{
+#ifdef BB_USE_F16C
+		return _mm_cvtps_ph(aValues, _MM_FROUND_TO_NEAREST_INT);
+#else
+		// Same rounding as F16C: normals are rounded with an integer bias that ties to even, subnormals by
+		// adding a magic float that moves the mantissa into place, overflow becomes infinity and NaN stays NaN.
+		const __m128i signMask = _mm_set1_epi32(int(0x80000000u));
+		const __m128i halfOverflow = _mm_set1_epi32((127 + 16) << 23);
+		const __m128i smallestNormal = _mm_set1_epi32((127 - 14) << 23);
+		const __m128i subnormalMagic = _mm_set1_epi32(((127 - 15) + (23 - 10) + 1) << 23);
+		const __m128i normalBias = _mm_set1_epi32(0xfff - ((127 - 15) << 23));
+
+		const __m128 sign = _mm_and_ps(aValues, _mm_castsi128_ps(signMask));
+		const __m128 absolute = _mm_xor_ps(aValues, sign);
+		const __m128i absoluteBits = _mm_castps_si128(absolute);
+
+		const __m128i isNan = _mm_castps_si128(_mm_cmpunord_ps(absolute, absolute));
+		const __m128i special = _mm_or_si128(_mm_and_si128(isNan, _mm_set1_epi32(0x200)), _mm_set1_epi32(0x7c00));
+		const __m128i isRegular = _mm_cmpgt_epi32(halfOverflow, absoluteBits);
+		const __m128i isSubnormal = _mm_cmpgt_epi32(smallestNormal, absoluteBits);
+
+		const __m128 subnormalRounded = _mm_add_ps(absolute, _mm_castsi128_ps(subnormalMagic));
+		const __m128i subnormal = _mm_sub_epi32(_mm_castps_si128(subnormalRounded), subnormalMagic);
+
+		const __m128i mantissaOdd = _mm_srai_epi32(_mm_slli_epi32(absoluteBits, 31 - 13), 31);
+		const __m128i normal = _mm_srli_epi32(_mm_sub_epi32(_mm_add_epi32(absoluteBits, normalBias), mantissaOdd), 13);
+
+		const __m128i finite = _mm_or_si128(_mm_and_si128(isSubnormal, subnormal), _mm_andnot_si128(isSubnormal, normal));
+		const __m128i magnitude = _mm_or_si128(_mm_and_si128(isRegular, finite), _mm_andnot_si128(isRegular, special));
+
+		// The sign is shifted in with sign extension, so every lane fits an int16_t and the saturating pack is exact
+		const __m128i halves = _mm_or_si128(magnitude, _mm_srai_epi32(_mm_castps_si128(sign), 16));
+		return _mm_packs_epi32(halves, halves);
+#endif
+	}
+
+/// @brief Converts the four halves in the low 64 bits to floats, exact for every half.
+	inline __m128 HalfToFloat(__m128i aHalves)
+	{
+#ifdef BB_USE_F16C
+		return _mm_cvtph_ps(aHalves);
+#else
+		// Moves exponent and mantissa into float position and rebiases the exponent with one multiply,
+		// which also normalizes half subnormals. Infinity and NaN get the float exponent patched in.
+		const __m128i halves = _mm_unpacklo_epi16(aHalves, _mm_setzero_si128());
+		const __m128i magnitude = _mm_and_si128(halves, _mm_set1_epi32(0x7fff));
+		const __m128i sign = _mm_slli_epi32(_mm_xor_si128(halves, magnitude), 16);
+		const __m128 scaled = _mm_mul_ps(_mm_castsi128_ps(_mm_slli_epi32(magnitude, 13)), _mm_castsi128_ps(_mm_set1_epi32((254 - 15) << 23)));
+		const __m128i isInfOrNan = _mm_cmpgt_epi32(magnitude, _mm_set1_epi32(0x7bff));
+		const __m128i special = _mm_and_si128(isInfOrNan, _mm_set1_epi32(255 << 23));
+		return _mm_or_ps(scaled, _mm_castsi128_ps(_mm_or_si128(sign, special)));
+#endif
+	}
+
+/// @brief Clamps to [aMin, aMax], NaN becomes aMin.
+	inline __m128 Clamp(__m128 aValues, __m128 aMin, __m128 aMax)
+	{
+		return _mm_min_ps(_mm_max_ps(aValues, aMin), aMax);
+	}
+
+/// @brief Scales clamped values by aScale and rounds them to the nearest integer.
+	inline __m128i Quantize(__m128 aValues, __m128 aMin, __m128 aMax, __m128 aScale)
+	{
+		return _mm_cvtps_epi32(_mm_mul_ps(Clamp(aValues, aMin, aMax), aScale));
+	}
+
+/// @brief Converts integers back to normalized floats, aMin clamps the most negative snorm value to -1.
+	inline __m128 Dequantize(__m128i aValues, __m128 aInverseScale, __m128 aMin)
+	{
+		return _mm_max_ps(_mm_mul_ps(_mm_cvtepi32_ps(aValues), aInverseScale), aMin);
+	}
+
+/// @brief Converts four floats to snorm16 in the low 64 bits.
+	inline __m128i FloatToSnorm16(__m128 aValues)
+	{
+		const __m128i values = Quantize(aValues, _mm_set1_ps(-1.0f), _mm_set1_ps(1.0f), _mm_set1_ps(32767.0f));
+		return _mm_packs_epi32(values, values);
+	}
+
+	inline __m128 Snorm16ToFloat(__m128i aValues)
+	{
+		const __m128i values = _mm_srai_epi32(_mm_unpacklo_epi16(aValues, aValues), 16);
+		return Dequantize(values, _mm_set1_ps(1.0f / 32767.0f), _mm_set1_ps(-1.0f));
+	}
+
+/// @brief Converts four floats to unorm8 in the low 32 bits.
+	inline __m128i FloatToUnorm8(__m128 aValues)
+	{
+		const __m128i values = Quantize(aValues, _mm_setzero_ps(), _mm_set1_ps(1.0f), _mm_set1_ps(255.0f));
+		const __m128i words = _mm_packs_epi32(values, values);
+		return _mm_packus_epi16(words, words);
+	}
+
+	inline __m128 Unorm8ToFloat(__m128i aValues)
+	{
+		const __m128i words = _mm_unpacklo_epi8(aValues, _mm_setzero_si128());
+		const __m128i values = _mm_unpacklo_epi16(words, _mm_setzero_si128());
+		return Dequantize(values, _mm_set1_ps(1.0f / 255.0f), _mm_setzero_ps());
+	}
+
+/// @brief Stores the low 4 or 8 bytes of aValue, whichever covers aBytes.
+	template<size_t aBytes>
+	inline void StoreWide(void* aDestination, __m128i aValue)
+	{
+		if constexpr (aBytes <= 4)
+		{
+			const int value = _mm_cvtsi128_si32(aValue);
+			std::memcpy(aDestination, &value, sizeof(value));
+		}
+		else
+		{
+			_mm_storel_epi64(static_cast<__m128i*>(aDestination), aValue);
+		}
+	}
+
+	template<size_t aBytes>
+	inline __m128i LoadWide(const void* aSource)
+	{
+		if constexpr (aBytes <= 4)
+		{
+			int value;
+			std::memcpy(&value, aSource, sizeof(value));
+			return _mm_cvtsi32_si128(value);
+		}
+		else
+		{
+			return _mm_loadl_epi64(static_cast<const __m128i*>(aSource));
+		}
+	}
+
+/**
+* @brief Encodes one element per step with aKernel, which returns the aBytes of the element in the low bits.
+*
+* @details Elements of 3 and 6 bytes are written with a 4 or 8 byte store, the extra bytes are
+* overwritten by the next element. Only the last element is stored through a buffer so nothing
+* past the end of aOut is touched.
+*/
+	template<size_t aBytes, class TVector, class TKernel>
+	inline void EncodeElements(const TVector* aVectors, void* aOut, size_t aCount, TKernel aKernel)
+	{
+		unsigned char* out = static_cast<unsigned char*>(aOut);
+		constexpr bool isExact = aBytes == 4 || aBytes == 8;
+		const size_t wideCount = isExact || aCount == 0 ? aCount : aCount - 1;
+		for (size_t i = 0; i < wideCount; ++i)
+		{
+			StoreWide<aBytes>(out + i * aBytes, aKernel(aVectors[i].data));
+		}
+		if (wideCount < aCount)
+		{
+			unsigned char last[8];
+			StoreWide<aBytes>(last, aKernel(aVectors[wideCount].data));
+			std::memcpy(out + wideCount * aBytes, last, aBytes);
+		}
+	}
+
+/// @brief Inverse of EncodeElements, the lanes a Vec3f does not use are set to zero.
+	template<size_t aBytes, class TVector, class TKernel>
+	inline void DecodeElements(const void* aValues, TVector* aOutVectors, size_t aCount, TKernel aKernel)
+	{
+		const unsigned char* values = static_cast<const unsigned char*>(aValues);
+		constexpr bool isExact = aBytes == 4 || aBytes == 8;
+		const size_t wideCount = isExact || aCount == 0 ? aCount : aCount - 1;
+		const auto decode = [&aKernel](const unsigned char* aElement)
+		{
+			if constexpr (std::is_same_v<TVector, Vec3f>)
+			{
+				return _mm_and_ps(aKernel(LoadWide<aBytes>(aElement)), Vec3fMask());
+			}
+			return aKernel(LoadWide<aBytes>(aElement));
+		};
+		for (size_t i = 0; i < wideCount; ++i)
+		{
+			aOutVectors[i].data = decode(values + i * aBytes);
+		}
+		if (wideCount < aCount)
+		{
+			unsigned char last[8] = {};
+			std::memcpy(last, values + wideCount * aBytes, aBytes);
+			aOutVectors[wideCount].data = decode(last);
+		}
+	}
+
+/**
+* @brief Encodes four elements per step into four uint32_t with aKernel(x, y, z, w).
+*
+* @details The elements are transposed so the kernel works on one component of four elements per
+* register. The last partial block is padded with zeros.
+*/
+	template<class TVector, class TKernel>
+	inline void EncodeBlocks(const TVector* aVectors, uint32_t* aOut, size_t aCount, TKernel aKernel)
+	{
+		size_t i = 0;
+		for (; i + 4 <= aCount; i += 4)
+		{
+			__m128 x = aVectors[i].data, y = aVectors[i + 1].data, z = aVectors[i + 2].data, w = aVectors[i + 3].data;
+			_MM_TRANSPOSE4_PS(x, y, z, w);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(aOut + i), aKernel(x, y, z, w));
+		}
+		if (i < aCount)
+		{
+			__m128 rows[4] = { _mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps() };
+			for (size_t j = 0; i + j < aCount; ++j)
+			{
+				rows[j] = aVectors[i + j].data;
+			}
+			_MM_TRANSPOSE4_PS(rows[0], rows[1], rows[2], rows[3]);
+			uint32_t last[4];
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(last), aKernel(rows[0], rows[1], rows[2], rows[3]));
+			std::memcpy(aOut + i, last, (aCount - i) * sizeof(uint32_t));
+		}
+	}
+
+/// @brief Inverse of EncodeBlocks, aKernel(packed, x, y, z, w) writes one component of four elements per register.
+	template<class TVector, class TKernel>
+	inline void DecodeBlocks(const uint32_t* aPacked, TVector* aOutVectors, size_t aCount, TKernel aKernel)
+	{
+		__m128 x, y, z, w;
+		size_t i = 0;
+		for (; i + 4 <= aCount; i += 4)
+		{
+			aKernel(_mm_loadu_si128(reinterpret_cast<const __m128i*>(aPacked + i)), x, y, z, w);
+			_MM_TRANSPOSE4_PS(x, y, z, w);
+			aOutVectors[i].data = x;
+			aOutVectors[i + 1].data = y;
+			aOutVectors[i + 2].data = z;
+			aOutVectors[i + 3].data = w;
+		}
+		if (i < aCount)
+		{
+			uint32_t last[4] = {};
+			std::memcpy(last, aPacked + i, (aCount - i) * sizeof(uint32_t));
+			aKernel(_mm_loadu_si128(reinterpret_cast<const __m128i*>(last)), x, y, z, w);
+			_MM_TRANSPOSE4_PS(x, y, z, w);
+			const __m128 rows[4] = { x, y, z, w };
+			for (size_t j = 0; i + j < aCount; ++j)
+			{
+				aOutVectors[i + j].data = rows[j];
+			}
+		}
+	}
+
+/// @brief Returns aMagnitude with the sign of aSign.
+	inline __m128 CopySign(__m128 aMagnitude, __m128 aSign)
+	{
+		const __m128 signMask = _mm_set1_ps(-0.0f);
+		return _mm_or_ps(_mm_andnot_ps(signMask, aMagnitude), _mm_and_ps(signMask, aSign));
+	}
+
+	inline __m128 Abs(__m128 aValues)
+	{
+		return _mm_andnot_ps(_mm_set1_ps(-0.0f), aValues);
+	}
+
+/// @brief Packs two snorm16 per lane, aLow in bits 0-15 and aHigh in bits 16-31.
+	inline __m128i PackSnorm16Pairs(__m128 aLow, __m128 aHigh)
+	{
+		const __m128 minimum = _mm_set1_ps(-1.0f);
+		const __m128 maximum = _mm_set1_ps(1.0f);
+		const __m128 scale = _mm_set1_ps(32767.0f);
+		const __m128i low = _mm_and_si128(Quantize(aLow, minimum, maximum, scale), _mm_set1_epi32(0xffff));
+		const __m128i high = _mm_slli_epi32(Quantize(aHigh, minimum, maximum, scale), 16);
+		return _mm_or_si128(low, high);
+	}
+} // namespace Detail
+
+#pragma region Half
+
+	inline void EncodeHalf(const Vec3f* aVectors, uint16_t* aOutHalves, size_t aCount)
+	{
+		Detail::EncodeElements<6>(aVectors, aOutHalves, aCount, Detail::FloatToHalf);
+	}
+
+	inline void EncodeHalf(const Vec4f* aVectors, uint16_t* aOutHalves, size_t aCount)
+	{
+		Detail::EncodeElements<8>(aVectors, aOutHalves, aCount, Detail::FloatToHalf);
+	}
+
+	inline void DecodeHalf(const uint16_t* aHalves, Vec3f* aOutVectors, size_t aCount)
+	{
+		Detail::DecodeElements<6>(aHalves, aOutVectors, aCount, Detail::HalfToFloat);
+	}
+
+	inline void DecodeHalf(const uint16_t* aHalves, Vec4f* aOutVectors, size_t aCount)
+	{
+		Detail::DecodeElements<8>(aHalves, aOutVectors, aCount, Detail::HalfToFloat);
+	}
+
+#pragma endregion Half
+
+#pragma region Normalized
+
+	inline void EncodeSnorm16(const Vec3f* aVectors, int16_t* aOutValues, size_t aCount)
+	{
+		Detail::EncodeElements<6>(aVectors, aOutValues, aCount, Detail::FloatToSnorm16);
+	}
+
+	inline void EncodeSnorm16(const Vec4f* aVectors, int16_t* aOutValues, size_t aCount)
+	{
+		Detail::EncodeElements<8>(aVectors, aOutValues, aCount, Detail::FloatToSnorm16);
+	}
+
+	inline void DecodeSnorm16(const int16_t* aValues, Vec3f* aOutVectors, size_t aCount)
+	{
+		Detail::DecodeElements<6>(aValues, aOutVectors, aCount, Detail::Snorm16ToFloat);
+	}
+
+	inline void DecodeSnorm16(const int16_t* aValues, Vec4f* aOutVectors, size_t aCount)
+	{
+		Detail::DecodeElements<8>(aValues, aOutVectors, aCount, Detail::Snorm16ToFloat);
+	}
+
+	inline void EncodeUnorm8(const Vec3f* aVectors, uint8_t* aOutValues, size_t aCount)
+	{
+		Detail::EncodeElements<3>(aVectors, aOutValues, aCount, Detail::FloatToUnorm8);
+	}
+
+	inline void EncodeUnorm8(const Vec4f* aVectors, uint8_t* aOutValues, size_t aCount)
+	{
+		Detail::EncodeElements<4>(aVectors, aOutValues, aCount, Detail::FloatToUnorm8);
+	}
+
+	inline void DecodeUnorm8(const uint8_t* aValues, Vec3f* aOutVectors, size_t aCount)
+	{
+		Detail::DecodeElements<3>(aValues, aOutVectors, aCount, Detail::Unorm8ToFloat);
+	}
+
+	inline void DecodeUnorm8(const uint8_t* aValues, Vec4f* aOutVectors, size_t aCount)
+	{
+		Detail::DecodeElements<4>(aValues, aOutVectors, aCount, Detail::Unorm8ToFloat);
+	}
+
+#pragma endregion Normalized
+
+#pragma region Octahedral
+
+	inline void EncodeOctahedral(const Vec3f* aNormals, uint32_t* aOutPacked, size_t aCount)
+	{
+		Detail::EncodeBlocks(aNormals, aOutPacked, aCount, [](__m128 aX, __m128 aY, __m128 aZ, __m128)
+		{
+			using namespace Detail;
+			// Project onto the octahedron |x| + |y| + |z| = 1, zero vectors stay zero and end up as +z
+			const __m128 sum = _mm_add_ps(_mm_add_ps(Abs(aX), Abs(aY)), Abs(aZ));
+			const __m128 inverseSum = _mm_div_ps(_mm_set1_ps(1.0f), _mm_max_ps(sum, _mm_set1_ps(FLT_MIN)));
+			const __m128 x = _mm_mul_ps(aX, inverseSum);
+			const __m128 y = _mm_mul_ps(aY, inverseSum);
+
+			// Fold the lower hemisphere over the diagonals of the square
+			const __m128 one = _mm_set1_ps(1.0f);
+			const __m128 lower = _mm_cmplt_ps(aZ, _mm_setzero_ps());
+			const __m128 foldedX = CopySign(_mm_sub_ps(one, Abs(y)), x);
+			const __m128 foldedY = CopySign(_mm_sub_ps(one, Abs(x)), y);
+			return PackSnorm16Pairs(_mm_blendv_ps(x, foldedX, lower), _mm_blendv_ps(y, foldedY, lower));
+		});
+	}
+
+	inline void DecodeOctahedral(const uint32_t* aPacked, Vec3f* aOutNormals, size_t aCount)
+	{
+		Detail::DecodeBlocks(aPacked, aOutNormals, aCount, [](__m128i aValues, __m128& aOutX, __m128& aOutY, __m128& aOutZ, __m128& aOutW)
+		{
+			using namespace Detail;
+			const __m128 inverseScale = _mm_set1_ps(1.0f / 32767.0f);
+			const __m128 minimum = _mm_set1_ps(-1.0f);
+			__m128 x = Dequantize(_mm_srai_epi32(_mm_slli_epi32(aValues, 16), 16), inverseScale, minimum);
+			__m128 y = Dequantize(_mm_srai_epi32(aValues, 16), inverseScale, minimum);
+			const __m128 z = _mm_sub_ps(_mm_sub_ps(_mm_set1_ps(1.0f), Abs(x)), Abs(y));
+
+			// Unfold the lower hemisphere, t is zero for the upper one
+			const __m128 t = _mm_max_ps(_mm_sub_ps(_mm_setzero_ps(), z), _mm_setzero_ps());
+			x = _mm_sub_ps(x, CopySign(t, x));
+			y = _mm_sub_ps(y, CopySign(t, y));
+
+			const __m128 lengthSqr = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+			const __m128 inverseLength = _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(lengthSqr));
+			aOutX = _mm_mul_ps(x, inverseLength);
+			aOutY = _mm_mul_ps(y, inverseLength);
+			aOutZ = _mm_mul_ps(z, inverseLength);
+			aOutW = _mm_setzero_ps();
+		});
+	}
+
+#pragma endregion Octahedral
+
+#pragma region Packed1010102
+
+	inline void EncodeUnorm1010102(const Vec4f* aVectors, uint32_t* aOutPacked, size_t aCount)
+	{
+		Detail::EncodeBlocks(aVectors, aOutPacked, aCount, [](__m128 aX, __m128 aY, __m128 aZ, __m128 aW)
+		{
+			const __m128 minimum = _mm_setzero_ps();
+			const __m128 maximum = _mm_set1_ps(1.0f);
+			const __m128 scale = _mm_set1_ps(1023.0f);
+			const __m128i x = Detail::Quantize(aX, minimum, maximum, scale);
+			const __m128i y = _mm_slli_epi32(Detail::Quantize(aY, minimum, maximum, scale), 10);
+			const __m128i z = _mm_slli_epi32(Detail::Quantize(aZ, minimum, maximum, scale), 20);
+			const __m128i w = _mm_slli_epi32(Detail::Quantize(aW, minimum, maximum, _mm_set1_ps(3.0f)), 30);
+			return _mm_or_si128(_mm_or_si128(x, y), _mm_or_si128(z, w));
+		});
+	}
+
+	inline void DecodeUnorm1010102(const uint32_t* aPacked, Vec4f* aOutVectors, size_t aCount)
+	{
+		Detail::DecodeBlocks(aPacked, aOutVectors, aCount, [](__m128i aValues, __m128& aOutX, __m128& aOutY, __m128& aOutZ, __m128& aOutW)
+		{
+			const __m128i tenBits = _mm_set1_epi32(0x3ff);
+			const __m128 inverseScale = _mm_set1_ps(1.0f / 1023.0f);
+			const __m128 minimum = _mm_setzero_ps();
+			aOutX = Detail::Dequantize(_mm_and_si128(aValues, tenBits), inverseScale, minimum);
+			aOutY = Detail::Dequantize(_mm_and_si128(_mm_srli_epi32(aValues, 10), tenBits), inverseScale, minimum);
+			aOutZ = Detail::Dequantize(_mm_and_si128(_mm_srli_epi32(aValues, 20), tenBits), inverseScale, minimum);
+			aOutW = Detail::Dequantize(_mm_srli_epi32(aValues, 30), _mm_set1_ps(1.0f / 3.0f), minimum);
+		});
+	}
+
+	inline void EncodeSnorm1010102(const Vec4f* aVectors, uint32_t* aOutPacked, size_t aCount)
+	{
+		Detail::EncodeBlocks(aVectors, aOutPacked, aCount, [](__m128 aX, __m128 aY, __m128 aZ, __m128 aW)
+		{
+			const __m128 minimum = _mm_set1_ps(-1.0f);
+			const __m128 maximum = _mm_set1_ps(1.0f);
+			const __m128 scale = _mm_set1_ps(511.0f);
+			const __m128i tenBits = _mm_set1_epi32(0x3ff);
+			const __m128i x = _mm_and_si128(Detail::Quantize(aX, minimum, maximum, scale), tenBits);
+			const __m128i y = _mm_slli_epi32(_mm_and_si128(Detail::Quantize(aY, minimum, maximum, scale), tenBits), 10);
+			const __m128i z = _mm_slli_epi32(_mm_and_si128(Detail::Quantize(aZ, minimum, maximum, scale), tenBits), 20);
+			const __m128i w = _mm_slli_epi32(Detail::Quantize(aW, minimum, maximum, maximum), 30);
+			return _mm_or_si128(_mm_or_si128(x, y), _mm_or_si128(z, w));
+		});
+	}
+
+	inline void DecodeSnorm1010102(const uint32_t* aPacked, Vec4f* aOutVectors, size_t aCount)
+	{
+		Detail::DecodeBlocks(aPacked, aOutVectors, aCount, [](__m128i aValues, __m128& aOutX, __m128& aOutY, __m128& aOutZ, __m128& aOutW)
+		{
+			// Shift each field to the top and back down to sign extend it
+			const __m128 inverseScale = _mm_set1_ps(1.0f / 511.0f);
+			const __m128 minimum = _mm_set1_ps(-1.0f);
+			aOutX = Detail::Dequantize(_mm_srai_epi32(_mm_slli_epi32(aValues, 22), 22), inverseScale, minimum);
+			aOutY = Detail::Dequantize(_mm_srai_epi32(_mm_slli_epi32(aValues, 12), 22), inverseScale, minimum);
+			aOutZ = Detail::Dequantize(_mm_srai_epi32(_mm_slli_epi32(aValues, 2), 22), inverseScale, minimum);
+			aOutW = Detail::Dequantize(_mm_srai_epi32(aValues, 30), _mm_set1_ps(1.0f), minimum);
+		});
+	}
+
+#pragma endregion Packed1010102
+} // namespace Bulk
+} // namespace BitBloom
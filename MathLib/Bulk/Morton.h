@@ -0,0 +1,52 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include "../Vector/Vector3f/Vector3f.h"
+#include "../Vector/Vector3i/Vector3i.h"
+
+/**
+ * @file Morton.h
+ * @brief Array kernels that interleave grid coordinates into Morton (Z-order) codes and back.
+ *
+ * @details A Morton code interleaves the bits of x, y and z (x in bit 0, y in bit 1, z in bit 2,
+ * then the next bit of each axis), so cells that are close in space are mostly close in the
+ * sorted order of their codes. Sorting by code gives a cache friendly order for spatial hashing,
+ * broadphases and voxel traversal.
+ *
+ * Each axis uses the low MORTON_BITS_PER_AXIS (21) bits, giving 63-bit codes. Negative or larger
+ * coordinates are not rejected, only their low bits are used, so offset the grid to start at zero.
+ * The float overload does that and clamps to the valid range.
+ *
+ * The bit spreading runs on two 64-bit lanes, x and y share one register and z uses a second, so
+ * an element goes from its Vec3i or Vec3f register to its code without scalar extraction.
+ *
+ * @code
+ * std::vector<uint64_t> codes(count);
+ * BB::Bulk::EncodeMorton(positions.data(), worldMin, cellSize, codes.data(), count);
+ * @endcode
+ */
+
+namespace BitBloom
+{
+namespace Bulk
+{
+/// @brief Bits used per axis, the codes fit in 3 * 21 = 63 bits.
+	inline constexpr int MORTON_BITS_PER_AXIS = 21;
+
+/// @brief aOutCodes[i] = interleaved low 21 bits of aCells[i].
+	inline void EncodeMorton(const Vec3i* aCells, uint64_t* aOutCodes, size_t aCount);
+/**
+* @brief Encodes the grid cell of each point, floor((aPoints[i] - aOrigin) / aCellSize).
+*
+* @details The division is done as a multiplication with the reciprocal of aCellSize. Cells are
+* clamped to [0, 2^21 - 1], points below aOrigin end up in cell 0 of that axis.
+*/
+	inline void EncodeMorton(const Vec3f* aPoints, const Vec3f& aOrigin, float aCellSize, uint64_t* aOutCodes, size_t aCount);
+/// @brief Inverse of EncodeMorton(const Vec3i*, ...), bit 63 of the codes is ignored.
+	inline void DecodeMorton(const uint64_t* aCodes, Vec3i* aOutCells, size_t aCount);
+} // namespace Bulk
+} // namespace BitBloom
+
+namespace BB = BitBloom;
+
+#include "Morton.inl"
@@ -0,0 +1,77 @@
+#pragma once
+#include "Morton.h"
+
+namespace BitBloom
+{
+namespace Bulk
+{
+namespace Detail
+{
+/// @brief Moves bit k of the low 21 bits of both 64-bit lanes to bit 3k.
+	inline __m128i SpreadBits21(__m128i aValues)
+	{
+		__m128i v = _mm_and_si128(aValues, _mm_set1_epi64x(0x1fffff));
+		v = _mm_and_si128(_mm_or_si128(v, _mm_slli_epi64(v, 32)), _mm_set1_epi64x(0x1f00000000ffff));
+		v = _mm_and_si128(_mm_or_si128(v, _mm_slli_epi64(v, 16)), _mm_set1_epi64x(0x1f0000ff0000ff));
+		v = _mm_and_si128(_mm_or_si128(v, _mm_slli_epi64(v, 8)), _mm_set1_epi64x(0x100f00f00f00f00f));
+		v = _mm_and_si128(_mm_or_si128(v, _mm_slli_epi64(v, 4)), _mm_set1_epi64x(0x10c30c30c30c30c3));
+		return _mm_and_si128(_mm_or_si128(v, _mm_slli_epi64(v, 2)), _mm_set1_epi64x(0x1249249249249249));
+	}
+
+/// @brief Inverse of SpreadBits21, gathers every third bit of both 64-bit lanes.
+	inline __m128i CompactBits21(__m128i aValues)
+	{
+		__m128i v = _mm_and_si128(aValues, _mm_set1_epi64x(0x1249249249249249));
+		v = _mm_and_si128(_mm_or_si128(v, _mm_srli_epi64(v, 2)), _mm_set1_epi64x(0x10c30c30c30c30c3));
+		v = _mm_and_si128(_mm_or_si128(v, _mm_srli_epi64(v, 4)), _mm_set1_epi64x(0x100f00f00f00f00f));
+		v = _mm_and_si128(_mm_or_si128(v, _mm_srli_epi64(v, 8)), _mm_set1_epi64x(0x1f0000ff0000ff));
+		v = _mm_and_si128(_mm_or_si128(v, _mm_srli_epi64(v, 16)), _mm_set1_epi64x(0x1f00000000ffff));
+		return _mm_and_si128(_mm_or_si128(v, _mm_srli_epi64(v, 32)), _mm_set1_epi64x(0x1fffff));
+	}
+
+/// @brief Morton code of the x, y, z lanes of aCell in the low 64 bits.
+	inline __m128i EncodeMortonCell(__m128i aCell)
+	{
+		// Zero extend to 64-bit lanes: (x, y) and (z, w)
+		const __m128i xy = SpreadBits21(_mm_unpacklo_epi32(aCell, _mm_setzero_si128()));
+		const __m128i z = SpreadBits21(_mm_unpackhi_epi32(aCell, _mm_setzero_si128()));
+		const __m128i y = _mm_unpackhi_epi64(xy, xy);
+		return _mm_or_si128(_mm_or_si128(xy, _mm_slli_epi64(y, 1)), _mm_slli_epi64(z, 2));
+	}
+} // namespace Detail
+
+	inline void EncodeMorton(const Vec3i* aCells, uint64_t* aOutCodes, size_t aCount)
+	{
+		for (size_t i = 0; i < aCount; ++i)
+		{
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(aOutCodes + i), Detail::EncodeMortonCell(aCells[i].data));
+		}
+	}
+
+	inline void EncodeMorton(const Vec3f* aPoints, const Vec3f& aOrigin, float aCellSize, uint64_t* aOutCodes, size_t aCount)
+	{
+		const __m128 inverseCellSize = _mm_set1_ps(1.0f / aCellSize);
+		const __m128 lastCell = _mm_set1_ps(float((1 << MORTON_BITS_PER_AXIS) - 1));
+		for (size_t i = 0; i < aCount; ++i)
+		{
+			const __m128 scaled = _mm_mul_ps(_mm_sub_ps(aPoints[i].data, aOrigin.data), inverseCellSize);
+			// Clamped in float so positions far outside the grid cannot overflow the conversion, NaN becomes 0
+			const __m128 clamped = _mm_min_ps(_mm_max_ps(_mm_floor_ps(scaled), _mm_setzero_ps()), lastCell);
+			const __m128i cell = _mm_cvttps_epi32(clamped);
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(aOutCodes + i), Detail::EncodeMortonCell(cell));
+		}
+	}
+
+	inline void DecodeMorton(const uint64_t* aCodes, Vec3i* aOutCells, size_t aCount)
+	{
+		for (size_t i = 0; i < aCount; ++i)
+		{
+			const __m128i code = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(aCodes + i));
+			const __m128i xy = Detail::CompactBits21(_mm_unpacklo_epi64(code, _mm_srli_epi64(code, 1)));
+			const __m128i z = Detail::CompactBits21(_mm_srli_epi64(code, 2));
+			// Low 32 bits of each 64-bit lane, the upper lane of z is zero and becomes w
+			aOutCells[i] = _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(xy), _mm_castsi128_ps(z), _MM_SHUFFLE(2, 0, 2, 0)));
+		}
+	}
+} // namespace Bulk
+} // namespace BitBloom
@@ -0,0 +1,76 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include "../Util/Intrinsics.h"
+#include "../Parallel/ThreadPool.h"
+
+/**
+ * @file RadixSort.h
+ * @brief LSD radix sort of 32-bit float and uint32_t keys, with an optional uint32_t payload per key.
+ *
+ * @details Four stable passes of 8 bits, least significant byte first. One read of the keys counts
+ * the digits of all four passes: four keys are loaded per step, a byte shuffle transposes them so
+ * each pass gets its four digits in one word, and every lane counts into its own copy of the
+ * histograms, so a run of equal digits (the top byte of similar floats) does not serialize on one
+ * counter. A pass where all keys share the digit is skipped. The result always ends up in aKeys
+ * (and aValues), the scratch arrays must hold aCount elements and their content is overwritten.
+ *
+ * Float keys are ordered through FloatToRadixKey: the sign bit is flipped for positive values and
+ * all bits for negative ones, which is applied on the fly when digits are extracted, the arrays
+ * only ever hold the original floats. -0.0 sorts before +0.0, NaNs with the sign bit set before
+ * -infinity and the others after +infinity. For a descending order sort the negated keys, or
+ * ~key for uint32_t.
+ *
+ * The payload is typically an index into the sorted objects (depth sorting, Morton ordered BVH
+ * builds, sweep-and-prune). The sort is stable, equal keys keep the order of their payloads.
+ *
+ * The ThreadPool overloads split every pass into one block per thread: each block counts its
+ * digits, the block offsets are prefix summed on the calling thread and each block then scatters
+ * its keys to their final position. Arrays below RADIX_PARALLEL_MIN_COUNT use the serial sort.
+ *
+ * @code
+ * std::vector<float> depths(count), scratchDepths(count);
+ * std::vector<uint32_t> order(count), scratchOrder(count);
+ * ...
+ * BB::Bulk::RadixSort(pool, depths.data(), order.data(), scratchDepths.data(), scratchOrder.data(), count);
+ * @endcode
+ */
+
+namespace BitBloom
+{
+namespace Bulk
+{
+/// @brief Smallest array the ThreadPool overloads split over the pool.
+	inline constexpr size_t RADIX_PARALLEL_MIN_COUNT = 64 * 1024;
+
+/// @brief Maps a float to a uint32_t with the same order, see the file description.
+	inline uint32_t FloatToRadixKey(float aValue);
+/// @brief Inverse of FloatToRadixKey.
+	inline float RadixKeyToFloat(uint32_t aKey);
+
+/**
+* @name Serial
+* @{
+*/
+	inline void RadixSort(uint32_t* aKeys, uint32_t* aScratchKeys, size_t aCount);
+	inline void RadixSort(float* aKeys, float* aScratchKeys, size_t aCount);
+/// @brief Sorts aKeys and moves aValues[i] along with aKeys[i].
+	inline void RadixSort(uint32_t* aKeys, uint32_t* aValues, uint32_t* aScratchKeys, uint32_t* aScratchValues, size_t aCount);
+	inline void RadixSort(float* aKeys, uint32_t* aValues, float* aScratchKeys, uint32_t* aScratchValues, size_t aCount);
+/** @} */
+
+/**
+* @name Parallel
+* @{
+*/
+	inline void RadixSort(ThreadPool& aPool, uint32_t* aKeys, uint32_t* aScratchKeys, size_t aCount);
+	inline void RadixSort(ThreadPool& aPool, float* aKeys, float* aScratchKeys, size_t aCount);
+	inline void RadixSort(ThreadPool& aPool, uint32_t* aKeys, uint32_t* aValues, uint32_t* aScratchKeys, uint32_t* aScratchValues, size_t aCount);
+	inline void RadixSort(ThreadPool& aPool, float* aKeys, uint32_t* aValues, float* aScratchKeys, uint32_t* aScratchValues, size_t aCount);
+/** @} */
+} // namespace Bulk
+} // namespace BitBloom
+
+namespace BB = BitBloom;
+
+#include "RadixSort.inl"
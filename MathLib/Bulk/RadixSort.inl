@@ -0,0 +1,310 @@
+#pragma once
+#include "RadixSort.h"
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <type_traits>
+#include <vector>
+
+namespace BitBloom
+{
+namespace Bulk
+{
+namespace Detail
+{
+	inline constexpr int RADIX_DIGIT_BITS = 8;
+	inline constexpr int RADIX_BUCKETS = 1 << RADIX_DIGIT_BITS;
+	inline constexpr int RADIX_PASSES = 32 / RADIX_DIGIT_BITS;
+
+	struct RadixHistograms
+	{
+		uint32_t counts[RADIX_PASSES][RADIX_BUCKETS];
+	};
+
+/// @brief The bits the digits are taken from, FloatToRadixKey for floats.
+	template<class TKey>
+	inline uint32_t RadixKeyBits(TKey aKey)
+	{
+		if constexpr (std::is_same_v<TKey, float>)
+		{
+			return FloatToRadixKey(aKey);
+		}
+		else
+		{
+			return aKey;
+		}
+	}
+
+/// @brief RadixKeyBits of four keys at once.
+	template<class TKey>
+	inline __m128i LoadRadixKeyBits(const TKey* aKeys)
+	{
+		const __m128i bits = _mm_loadu_si128(reinterpret_cast<const __m128i*>(aKeys));
+		if constexpr (std::is_same_v<TKey, float>)
+		{
+			const __m128i flip = _mm_or_si128(_mm_srai_epi32(bits, 31), _mm_set1_epi32(int(0x80000000)));
+			return _mm_xor_si128(bits, flip);
+		}
+		else
+		{
+			return bits;
+		}
+	}
+
+/// @brief Adds the digit counts of every pass over aKeys to aHistograms, in one read of the keys.
+	template<class TKey>
+	inline void CountDigits(const TKey* aKeys, size_t aCount, RadixHistograms& aHistograms)
+	{
+		// One copy per lane, equal digits of neighboring keys land in different counters
+		RadixHistograms lanes[4] = {};
+		// Byte k of the four keys next to each other, one 32-bit word per pass
+		const __m128i transpose = _mm_setr_epi8(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15);
+
+		size_t i = 0;
+		for (; i + 4 <= aCount; i += 4)
+		{
+			const __m128i digits = _mm_shuffle_epi8(LoadRadixKeyBits(aKeys + i), transpose);
+			const uint32_t words[RADIX_PASSES] = { uint32_t(_mm_cvtsi128_si32(digits)), uint32_t(_mm_extract_epi32(digits, 1)),
+				uint32_t(_mm_extract_epi32(digits, 2)), uint32_t(_mm_extract_epi32(digits, 3)) };
+			for (int pass = 0; pass < RADIX_PASSES; ++pass)
+			{
+				++lanes[0].counts[pass][words[pass] & 0xFF];
+				++lanes[1].counts[pass][(words[pass] >> 8) & 0xFF];
+				++lanes[2].counts[pass][(words[pass] >> 16) & 0xFF];
+				++lanes[3].counts[pass][words[pass] >> 24];
+			}
+		}
+		for (; i < aCount; ++i)
+		{
+			const uint32_t bits = RadixKeyBits(aKeys[i]);
+			for (int pass = 0; pass < RADIX_PASSES; ++pass)
+			{
+				++lanes[0].counts[pass][(bits >> (pass * RADIX_DIGIT_BITS)) & 0xFF];
+			}
+		}
+
+		for (int pass = 0; pass < RADIX_PASSES; ++pass)
+		{
+			for (int bucket = 0; bucket < RADIX_BUCKETS; ++bucket)
+			{
+				aHistograms.counts[pass][bucket] += lanes[0].counts[pass][bucket] + lanes[1].counts[pass][bucket] + lanes[2].counts[pass][bucket] + lanes[3].counts[pass][bucket];
+			}
+		}
+	}
+
+/// @brief Counts the digits of one pass, for the blocks of the parallel sort after the keys moved.
+	template<class TKey>
+	inline void CountDigit(const TKey* aKeys, size_t aCount, int aShift, uint32_t aOutCounts[RADIX_BUCKETS])
+	{
+		uint32_t lanes[2][RADIX_BUCKETS] = {};
+		size_t i = 0;
+		for (; i + 2 <= aCount; i += 2)
+		{
+			++lanes[0][(RadixKeyBits(aKeys[i]) >> aShift) & 0xFF];
+			++lanes[1][(RadixKeyBits(aKeys[i + 1]) >> aShift) & 0xFF];
+		}
+		if (i < aCount)
+		{
+			++lanes[0][(RadixKeyBits(aKeys[i]) >> aShift) & 0xFF];
+		}
+		for (int bucket = 0; bucket < RADIX_BUCKETS; ++bucket)
+		{
+			aOutCounts[bucket] = lanes[0][bucket] + lanes[1][bucket];
+		}
+	}
+
+/// @brief Moves keys (and values) [aBegin, aEnd) to the offset of their digit, advancing the offsets.
+	template<bool WithValues, class TKey>
+	inline void ScatterDigit(const TKey* aKeys, const uint32_t* aValues, TKey* aOutKeys, uint32_t* aOutValues, size_t aBegin, size_t aEnd, int aShift, uint32_t aOffsets[RADIX_BUCKETS])
+	{
+		for (size_t i = aBegin; i < aEnd; ++i)
+		{
+			const uint32_t destination = aOffsets[(RadixKeyBits(aKeys[i]) >> aShift) & 0xFF]++;
+			aOutKeys[destination] = aKeys[i];
+			if constexpr (WithValues)
+			{
+				aOutValues[destination] = aValues[i];
+			}
+		}
+	}
+
+/// @brief True if every key has the same digit in this pass, the pass would leave the order as is.
+	inline bool IsUniformDigit(const uint32_t aCounts[RADIX_BUCKETS], size_t aCount)
+	{
+		return std::find(aCounts, aCounts + RADIX_BUCKETS, uint32_t(aCount)) != aCounts + RADIX_BUCKETS;
+	}
+
+/// @brief Copies the result back to the caller's arrays after an odd number of passes.
+	template<bool WithValues, class TKey>
+	inline void FinishRadixSort(const TKey* aResultKeys, const uint32_t* aResultValues, TKey* aKeys, uint32_t* aValues, size_t aCount)
+	{
+		if (aResultKeys != aKeys)
+		{
+			std::copy(aResultKeys, aResultKeys + aCount, aKeys);
+			if constexpr (WithValues)
+			{
+				std::copy(aResultValues, aResultValues + aCount, aValues);
+			}
+		}
+	}
+
+	template<bool WithValues, class TKey>
+	inline void RadixSortSerial(TKey* aKeys, uint32_t* aValues, TKey* aScratchKeys, uint32_t* aScratchValues, size_t aCount)
+	{
+		assert(aCount <= UINT32_MAX);
+		RadixHistograms histograms = {};
+		CountDigits(aKeys, aCount, histograms);
+
+		TKey* keys = aKeys;
+		TKey* otherKeys = aScratchKeys;
+		uint32_t* values = aValues;
+		uint32_t* otherValues = aScratchValues;
+		for (int pass = 0; pass < RADIX_PASSES; ++pass)
+		{
+			uint32_t* offsets = histograms.counts[pass];
+			if (IsUniformDigit(offsets, aCount))
+			{
+				continue;
+			}
+
+			uint32_t offset = 0;
+			for (int bucket = 0; bucket < RADIX_BUCKETS; ++bucket)
+			{
+				const uint32_t count = offsets[bucket];
+				offsets[bucket] = offset;
+				offset += count;
+			}
+			ScatterDigit<WithValues>(keys, values, otherKeys, otherValues, 0, aCount, pass * RADIX_DIGIT_BITS, offsets);
+			std::swap(keys, otherKeys);
+			std::swap(values, otherValues);
+		}
+		FinishRadixSort<WithValues>(keys, values, aKeys, aValues, aCount);
+	}
+
+	template<bool WithValues, class TKey>
+	inline void RadixSortParallel(ThreadPool& aPool, TKey* aKeys, uint32_t* aValues, TKey* aScratchKeys, uint32_t* aScratchValues, size_t aCount)
+	{
+		const size_t blockCount = aPool.GetThreadCount();
+		if (aCount < RADIX_PARALLEL_MIN_COUNT || blockCount == 1)
+		{
+			RadixSortSerial<WithValues>(aKeys, aValues, aScratchKeys, aScratchValues, aCount);
+			return;
+		}
+		assert(aCount <= UINT32_MAX);
+
+		// Whole cache lines per block, so no two blocks scatter from the same line
+		const size_t blockSize = (aCount / blockCount + 16) & ~size_t(15);
+		std::vector<RadixHistograms> blockHistograms(blockCount);
+		aPool.ParallelFor(0, aCount, blockSize, [&](size_t aBegin, size_t aEnd)
+		{
+			RadixHistograms& histograms = blockHistograms[aBegin / blockSize];
+			histograms = {};
+			CountDigits(aKeys + aBegin, aEnd - aBegin, histograms);
+		});
+
+		TKey* keys = aKeys;
+		TKey* otherKeys = aScratchKeys;
+		uint32_t* values = aValues;
+		uint32_t* otherValues = aScratchValues;
+		bool moved = false;
+		for (int pass = 0; pass < RADIX_PASSES; ++pass)
+		{
+			const int shift = pass * RADIX_DIGIT_BITS;
+			// The digit totals do not depend on the order of the keys, the block counts do
+			uint32_t totals[RADIX_BUCKETS] = {};
+			for (const RadixHistograms& histograms : blockHistograms)
+			{
+				for (int bucket = 0; bucket < RADIX_BUCKETS; ++bucket)
+				{
+					totals[bucket] += histograms.counts[pass][bucket];
+				}
+			}
+			if (IsUniformDigit(totals, aCount))
+			{
+				continue;
+			}
+
+			if (moved)
+			{
+				aPool.ParallelFor(0, aCount, blockSize, [&](size_t aBegin, size_t aEnd)
+				{
+					CountDigit(keys + aBegin, aEnd - aBegin, shift, blockHistograms[aBegin / blockSize].counts[pass]);
+				});
+			}
+
+			// Block b writes its keys of a digit after the same digit of the blocks before it
+			uint32_t offset = 0;
+			for (int bucket = 0; bucket < RADIX_BUCKETS; ++bucket)
+			{
+				for (RadixHistograms& histograms : blockHistograms)
+				{
+					const uint32_t count = histograms.counts[pass][bucket];
+					histograms.counts[pass][bucket] = offset;
+					offset += count;
+				}
+			}
+			aPool.ParallelFor(0, aCount, blockSize, [&](size_t aBegin, size_t aEnd)
+			{
+				ScatterDigit<WithValues>(keys, values, otherKeys, otherValues, aBegin, aEnd, shift, blockHistograms[aBegin / blockSize].counts[pass]);
+			});
+			std::swap(keys, otherKeys);
+			std::swap(values, otherValues);
+			moved = true;
+		}
+		FinishRadixSort<WithValues>(keys, values, aKeys, aValues, aCount);
+	}
+} // namespace Detail
+
+	inline uint32_t FloatToRadixKey(float aValue)
+	{
+		const uint32_t bits = std::bit_cast<uint32_t>(aValue);
+		return bits ^ (uint32_t(int32_t(bits) >> 31) | 0x80000000u);
+	}
+
+	inline float RadixKeyToFloat(uint32_t aKey)
+	{
+		// Keys of negative floats have the top bit clear
+		return std::bit_cast<float>(aKey ^ ((aKey & 0x80000000u) ? 0x80000000u : 0xFFFFFFFFu));
+	}
+
+	inline void RadixSort(uint32_t* aKeys, uint32_t* aScratchKeys, size_t aCount)
+	{
+		Detail::RadixSortSerial<false>(aKeys, nullptr, aScratchKeys, nullptr, aCount);
+	}
+
+	inline void RadixSort(float* aKeys, float* aScratchKeys, size_t aCount)
+	{
+		Detail::RadixSortSerial<false>(aKeys, nullptr, aScratchKeys, nullptr, aCount);
+	}
+
+	inline void RadixSort(uint32_t* aKeys, uint32_t* aValues, uint32_t* aScratchKeys, uint32_t* aScratchValues, size_t aCount)
+	{
+		Detail::RadixSortSerial<true>(aKeys, aValues, aScratchKeys, aScratchValues, aCount);
+	}
+
+	inline void RadixSort(float* aKeys, uint32_t* aValues, float* aScratchKeys, uint32_t* aScratchValues, size_t aCount)
+	{
+		Detail::RadixSortSerial<true>(aKeys, aValues, aScratchKeys, aScratchValues, aCount);
+	}
+
+	inline void RadixSort(ThreadPool& aPool, uint32_t* aKeys, uint32_t* aScratchKeys, size_t aCount)
+	{
+		Detail::RadixSortParallel<false>(aPool, aKeys, nullptr, aScratchKeys, nullptr, aCount);
+	}
+
+	inline void RadixSort(ThreadPool& aPool, float* aKeys, float* aScratchKeys, size_t aCount)
+	{
+		Detail::RadixSortParallel<false>(aPool, aKeys, nullptr, aScratchKeys, nullptr, aCount);
+	}
+
+	inline void RadixSort(ThreadPool& aPool, uint32_t* aKeys, uint32_t* aValues, uint32_t* aScratchKeys, uint32_t* aScratchValues, size_t aCount)
+	{
+		Detail::RadixSortParallel<true>(aPool, aKeys, aValues, aScratchKeys, aScratchValues, aCount);
+	}
+
+	inline void RadixSort(ThreadPool& aPool, float* aKeys, uint32_t* aValues, float* aScratchKeys, uint32_t* aScratchValues, size_t aCount)
+	{
+		Detail::RadixSortParallel<true>(aPool, aKeys, aValues, aScratchKeys, aScratchValues, aCount);
+	}
+} // namespace Bulk
+} // namespace BitBloom
@@ -0,0 +1,99 @@
+#pragma once
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include "../Vector/Vector3f/Vector3f.h"
+#include "../Vector/Vector4f/Vector4f.h"
+
+namespace BitBloom
+{
+/**
+* @brief Strided view of Vec3f or Vec4f elements in memory the library does not own.
+*
+* @details A view is a pointer, a stride in bytes and a count. It lets the Bulk kernels read and
+* write mesh data in place, e.g. in an mmap'd file or a GPU staging buffer, instead of copying it
+* into a Vec3f array first. Elements only need float alignment and are read and written as
+* exactly three (Vec3f) or four (Vec4f) floats, so the bytes between elements are never touched.
+*
+* Use `StreamView<const Vec3f>` for read-only data, a `StreamView<Vec3f>` converts to it.
+*
+* @code
+* struct Vertex { float position[3]; float normal[3]; float uv[2]; };
+*
+* BB::StreamView<Vec3f> normals(vertices, offsetof(Vertex, normal), sizeof(Vertex), vertexCount);
+* BB::Bulk::TransformVectors(normalMatrix, normals, normals);
+* @endcode
+*/
+	template<class TVector>
+	class StreamView
+	{
+	public:
+		using Vector = std::remove_const_t<TVector>;
+		using Float = std::conditional_t<std::is_const_v<TVector>, const float, float>;
+		using Byte = std::conditional_t<std::is_const_v<TVector>, const unsigned char, unsigned char>;
+		using Void = std::conditional_t<std::is_const_v<TVector>, const void, void>;
+
+		static_assert(std::is_same_v<Vector, Vec3f> || std::is_same_v<Vector, Vec4f>, "StreamView supports Vec3f and Vec4f");
+
+		/// @brief Number of floats read and written per element.
+		static constexpr size_t ComponentCount = std::is_same_v<Vector, Vec3f> ? 3 : 4;
+		/// @brief Stride of tightly packed floats, 12 bytes for Vec3f and 16 bytes for Vec4f.
+		static constexpr size_t PackedStride = ComponentCount * sizeof(float);
+
+/// @brief View over aCount elements starting at aData, aStride bytes apart.
+		StreamView(Float* aData, size_t aStride, size_t aCount)
+			: myData(reinterpret_cast<Byte*>(aData)), myStride(aStride), myCount(aCount)
+		{
+			assert(aStride >= PackedStride && "Elements can not overlap");
+		}
+
+/// @brief View over one attribute of an interleaved buffer, aOffset bytes into each aStride sized element.
+		StreamView(Void* aBase, size_t aOffset, size_t aStride, size_t aCount)
+			: StreamView(reinterpret_cast<Float*>(static_cast<Byte*>(aBase) + aOffset), aStride, aCount)
+		{
+		}
+
+/// @brief View over a regular Vec3f or Vec4f array.
+		StreamView(TVector* aArray, size_t aCount)
+			: StreamView(reinterpret_cast<Float*>(aArray), sizeof(Vector), aCount)
+		{
+		}
+
+/// @brief Converts a writable view to a read-only view.
+		template<class TOther, class = std::enable_if_t<std::is_const_v<TVector> && std::is_same_v<const TOther, TVector>>>
+		StreamView(const StreamView<TOther>& aView)
+			: StreamView(aView.GetData(), aView.GetStride(), aView.GetCount())
+		{
+		}
+
+		Float* GetData() const { return reinterpret_cast<Float*>(myData); }
+		size_t GetStride() const { return myStride; }
+		size_t GetCount() const { return myCount; }
+/// @brief True if the elements are tightly packed, the Bulk kernels have fast paths for it.
+		bool IsPacked() const { return myStride == PackedStride; }
+
+		Float* GetElement(size_t aIndex) const
+		{
+			assert(aIndex < myCount);
+			return reinterpret_cast<Float*>(myData + aIndex * myStride);
+		}
+
+		Vector Load(size_t aIndex) const
+		{
+			return Vector::LoadUnaligned(GetElement(aIndex));
+		}
+
+		void Store(size_t aIndex, const Vector& aVector) const
+		{
+			static_assert(!std::is_const_v<TVector>, "Can not store through a read-only view");
+			aVector.StoreUnaligned(GetElement(aIndex));
+		}
+
+	private:
+		Byte* myData;
+		size_t myStride;
+		size_t myCount;
+	};
+}
+
+namespace BB = BitBloom;
@@ -0,0 +1,103 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include "../Memory/AlignedAllocator.h"
+#include "../Util/Float8.h"
+#include "../Vector/Vector3f/Vector3f.h"
+
+/**
+ * @file CubicSpline.h
+ * @brief Piecewise cubic curves over Vec3f: batched evaluation, adaptive flattening and arc length tables.
+ *
+ * @details Every segment is stored as its cubic Bezier control points, consecutive segments share
+ * their end point. Catmull-Rom and Hermite input is converted to Bezier form once:
+ * - Hermite p0, m0, p1, m1: p0, p0 + m0 / 3, p1 - m1 / 3, p1.
+ * - Catmull-Rom (uniform) p0, p1, p2, p3 for the segment from p1 to p2: p1, p1 + (p2 - p0) / 6,
+ *   p2 - (p3 - p1) / 6, p2. The first and last points are repeated for the end segments.
+ *
+ * The curve parameter u runs from 0 to GetSegmentCount(), segment i covers [i, i + 1]. Values
+ * outside that range are clamped. Evaluation uses the power basis form ((a t + b) t + c) t + d of
+ * each segment, the batched functions evaluate eight parameters per step with Float8. Their
+ * coefficients are splatted when all eight parameters fall in one segment, the usual case when
+ * sampling along the curve, and gathered lane by lane otherwise.
+ *
+ * ArcLengthTable maps a distance along the curve to the parameter, for constant speed traversal.
+ * The table holds the length at evenly spaced parameters (five point Gauss-Legendre per
+ * interval) and the lookup interpolates linearly between them. GetParameters runs eight binary
+ * searches in lockstep, every step gathers the eight probed table entries and moves each lane
+ * with a compare mask, so the searches neither branch nor wait on each other's cache misses.
+ *
+ * @code
+ * BB::CubicSpline path = BB::CubicSpline::FromCatmullRom(waypoints.data(), waypoints.size());
+ * BB::ArcLengthTable table;
+ * table.Build(path);
+ * table.GetParameters(distances.data(), parameters.data(), count);
+ * path.EvaluatePositions(parameters.data(), positions.data(), count);
+ * @endcode
+ */
+
+namespace BitBloom
+{
+	class CubicSpline
+	{
+	public:
+/// @brief aSegmentCount segments from 3 * aSegmentCount + 1 control points.
+		static inline CubicSpline FromBezier(const Vec3f* aControlPoints, size_t aSegmentCount);
+/// @brief Passes through all aCount points, aCount - 1 segments.
+		static inline CubicSpline FromCatmullRom(const Vec3f* aPoints, size_t aCount);
+/// @brief Passes through all aCount points with the given tangents (derivatives per unit of u).
+		static inline CubicSpline FromHermite(const Vec3f* aPoints, const Vec3f* aTangents, size_t aCount);
+
+		inline size_t GetSegmentCount() const;
+/// @brief The 3 * GetSegmentCount() + 1 Bezier control points.
+		inline const Vec3f* GetControlPoints() const;
+
+		inline Vec3f EvaluatePosition(float aParameter) const;
+/// @brief Derivative with respect to u, not normalized.
+		inline Vec3f EvaluateTangent(float aParameter) const;
+		inline void EvaluatePositions(const float* aParameters, Vec3f* aOutPositions, size_t aCount) const;
+		inline void EvaluateTangents(const float* aParameters, Vec3f* aOutTangents, size_t aCount) const;
+
+/**
+* @brief Replaces the content of aOutPoints with a polyline within aTolerance of the curve.
+*
+* @details Segments are split in halves (de Casteljau) until both inner control points are within
+* aTolerance of the chord, which bounds the distance of the curve to the chord. The split depth
+* is limited to 16 per segment. aOutParameters, when given, receives the parameter of each point.
+*/
+		inline void Flatten(float aTolerance, std::vector<Vec3f>& aOutPoints, std::vector<float>* aOutParameters = nullptr) const;
+
+	private:
+		template<bool Tangents>
+		inline void EvaluateBatch(const float* aParameters, Vec3f* aOutValues, size_t aCount) const;
+		inline size_t GetSegment(float aParameter, float& aOutLocal) const;
+
+		std::vector<Vec3f> myControlPoints;
+		// a, b, c and d of ((a t + b) t + c) t + d per segment
+		std::vector<Vec3f> myCoefficients;
+	};
+
+	class ArcLengthTable
+	{
+	public:
+/// @brief Samples aSpline at aSamplesPerSegment intervals per segment. Keeps no reference to it.
+		inline void Build(const CubicSpline& aSpline, size_t aSamplesPerSegment = 16);
+
+		inline float GetLength() const;
+/// @brief The parameter u at aDistance along the curve, aDistance is clamped to [0, GetLength()]. 0 before Build.
+		inline float GetParameter(float aDistance) const;
+		inline void GetParameters(const float* aDistances, float* aOutParameters, size_t aCount) const;
+
+	private:
+		size_t mySamplesPerSegment = 1;
+		size_t mySampleCount = 0;
+		size_t mySearchSize = 0;
+		float myLength = 0.0f;
+		// Length up to sample i, padded to mySearchSize entries with +infinity
+		AlignedVector<float, CACHE_LINE_SIZE> myDistances;
+	};
+} // namespace BitBloom
+
+namespace BB = BitBloom;
+
+#include "CubicSpline.inl"
@@ -0,0 +1,364 @@
+#pragma once
+#include "CubicSpline.h"
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cfloat>
+#include <limits>
+
+namespace BitBloom
+{
+namespace Detail
+{
+	inline constexpr int FLATTEN_MAX_DEPTH = 16;
+
+/// @brief Writes the x, y and z lanes as aValid Vec3f, lane 0 first.
+	inline void StoreVec3Lanes(Simd::Float8 aX, Simd::Float8 aY, Simd::Float8 aZ, Vec3f* aOut, size_t aValid)
+	{
+		// Named registers rather than arrays, so the transposes stay out of memory
+		__m128 low0 = Simd::GetLowHalf(aX), low1 = Simd::GetLowHalf(aY), low2 = Simd::GetLowHalf(aZ), low3 = _mm_setzero_ps();
+		__m128 high0 = Simd::GetHighHalf(aX), high1 = Simd::GetHighHalf(aY), high2 = Simd::GetHighHalf(aZ), high3 = _mm_setzero_ps();
+		_MM_TRANSPOSE4_PS(low0, low1, low2, low3);
+		_MM_TRANSPOSE4_PS(high0, high1, high2, high3);
+		if (aValid == 8)
+		{
+			aOut[0].data = low0;
+			aOut[1].data = low1;
+			aOut[2].data = low2;
+			aOut[3].data = low3;
+			aOut[4].data = high0;
+			aOut[5].data = high1;
+			aOut[6].data = high2;
+			aOut[7].data = high3;
+			return;
+		}
+		const __m128 rows[8] = { low0, low1, low2, low3, high0, high1, high2, high3 };
+		for (size_t lane = 0; lane < aValid; ++lane)
+		{
+			aOut[lane].data = rows[lane];
+		}
+	}
+
+/// @brief ((a t + b) t + c) t + d, or its derivative (3 a t + 2 b) t + c.
+	template<bool Tangents>
+	inline Simd::Float8 EvaluateCubic(Simd::Float8 aA, Simd::Float8 aB, Simd::Float8 aC, Simd::Float8 aD, Simd::Float8 aT)
+	{
+		using namespace BB::Simd;
+		if constexpr (Tangents)
+		{
+			return MulAdd(MulAdd(Mul(aA, SplatFloat8(3.0f)), aT, Mul(aB, SplatFloat8(2.0f))), aT, aC);
+		}
+		else
+		{
+			return MulAdd(MulAdd(MulAdd(aA, aT, aB), aT, aC), aT, aD);
+		}
+	}
+
+/// @brief aTable[aIndices[lane]] for the eight lanes, the indices are whole numbers stored as floats.
+	inline Simd::Float8 GatherFloat8(const float* aTable, Simd::Float8 aIndices)
+	{
+#if defined(BB_USE_AVX) && defined(__AVX2__)
+		return _mm256_i32gather_ps(aTable, _mm256_cvttps_epi32(aIndices), 4);
+#else
+		alignas(32) float indices[8];
+		Simd::StoreFloat8(indices, aIndices);
+		// Built in registers, a wide load of eight scalar stores would stall on store forwarding
+		const auto value = [&](int aLane) { return aTable[size_t(indices[aLane])]; };
+		return Simd::CombineFloat8(_mm_setr_ps(value(0), value(1), value(2), value(3)), _mm_setr_ps(value(4), value(5), value(6), value(7)));
+#endif
+	}
+
+/// @brief Eight floats from an unaligned pointer, the last of aValid (1 to 8) values fills the lanes past it.
+	inline Simd::Float8 LoadPaddedFloat8(const float* aSource, size_t aValid)
+	{
+		if (aValid == 8)
+		{
+			return Simd::LoadUnalignedFloat8(aSource);
+		}
+		alignas(32) float values[8];
+		for (size_t lane = 0; lane < 8; ++lane)
+		{
+			values[lane] = aSource[std::min(lane, aValid - 1)];
+		}
+		return Simd::LoadFloat8(values);
+	}
+
+	inline float DistanceToSegmentSquared(const Vec3f& aPoint, const Vec3f& aStart, const Vec3f& aEnd)
+	{
+		const Vec3f segment = aEnd - aStart;
+		const Vec3f offset = aPoint - aStart;
+		const float lengthSquared = segment.Dot(segment);
+		const float t = lengthSquared > 0.0f ? std::clamp(offset.Dot(segment) / lengthSquared, 0.0f, 1.0f) : 0.0f;
+		const Vec3f difference = offset - segment * t;
+		return difference.Dot(difference);
+	}
+
+/// @brief Appends the end points of the flattened Bezier [aStart, aEnd], the start point is already in the list.
+	inline void FlattenBezier(const Vec3f aPoints[4], float aStart, float aEnd, float aToleranceSquared, int aDepth, std::vector<Vec3f>& aOutPoints, std::vector<float>* aOutParameters)
+	{
+		const bool flat = DistanceToSegmentSquared(aPoints[1], aPoints[0], aPoints[3]) <= aToleranceSquared
+			&& DistanceToSegmentSquared(aPoints[2], aPoints[0], aPoints[3]) <= aToleranceSquared;
+		if (flat || aDepth == FLATTEN_MAX_DEPTH)
+		{
+			aOutPoints.push_back(aPoints[3]);
+			if (aOutParameters != nullptr)
+			{
+				aOutParameters->push_back(aEnd);
+			}
+			return;
+		}
+
+		// de Casteljau at t = 0.5
+		const Vec3f ab = (aPoints[0] + aPoints[1]) * 0.5f;
+		const Vec3f bc = (aPoints[1] + aPoints[2]) * 0.5f;
+		const Vec3f cd = (aPoints[2] + aPoints[3]) * 0.5f;
+		const Vec3f abc = (ab + bc) * 0.5f;
+		const Vec3f bcd = (bc + cd) * 0.5f;
+		const Vec3f middle = (abc + bcd) * 0.5f;
+		const Vec3f first[4] = { aPoints[0], ab, abc, middle };
+		const Vec3f second[4] = { middle, bcd, cd, aPoints[3] };
+		const float split = (aStart + aEnd) * 0.5f;
+		FlattenBezier(first, aStart, split, aToleranceSquared, aDepth + 1, aOutPoints, aOutParameters);
+		FlattenBezier(second, split, aEnd, aToleranceSquared, aDepth + 1, aOutPoints, aOutParameters);
+	}
+} // namespace Detail
+
+	inline CubicSpline CubicSpline::FromBezier(const Vec3f* aControlPoints, size_t aSegmentCount)
+	{
+		assert(aSegmentCount > 0);
+		CubicSpline spline;
+		spline.myControlPoints.assign(aControlPoints, aControlPoints + 3 * aSegmentCount + 1);
+		spline.myCoefficients.resize(4 * aSegmentCount);
+		for (size_t segment = 0; segment < aSegmentCount; ++segment)
+		{
+			const Vec3f* points = aControlPoints + 3 * segment;
+			Vec3f* coefficients = spline.myCoefficients.data() + 4 * segment;
+			coefficients[0] = points[3] - points[0] + (points[1] - points[2]) * 3.0f;
+			coefficients[1] = (points[2] - points[1] * 2.0f + points[0]) * 3.0f;
+			coefficients[2] = (points[1] - points[0]) * 3.0f;
+			coefficients[3] = points[0];
+		}
+		return spline;
+	}
+
+	inline CubicSpline CubicSpline::FromCatmullRom(const Vec3f* aPoints, size_t aCount)
+	{
+		assert(aCount > 1);
+		std::vector<Vec3f> controlPoints(3 * (aCount - 1) + 1);
+		for (size_t i = 0; i + 1 < aCount; ++i)
+		{
+			const Vec3f& before = aPoints[i > 0 ? i - 1 : 0];
+			const Vec3f& after = aPoints[std::min(i + 2, aCount - 1)];
+			controlPoints[3 * i] = aPoints[i];
+			controlPoints[3 * i + 1] = aPoints[i] + (aPoints[i + 1] - before) * (1.0f / 6.0f);
+			controlPoints[3 * i + 2] = aPoints[i + 1] - (after - aPoints[i]) * (1.0f / 6.0f);
+		}
+		controlPoints.back() = aPoints[aCount - 1];
+		return FromBezier(controlPoints.data(), aCount - 1);
+	}
+
+	inline CubicSpline CubicSpline::FromHermite(const Vec3f* aPoints, const Vec3f* aTangents, size_t aCount)
+	{
+		assert(aCount > 1);
+		std::vector<Vec3f> controlPoints(3 * (aCount - 1) + 1);
+		for (size_t i = 0; i + 1 < aCount; ++i)
+		{
+			controlPoints[3 * i] = aPoints[i];
+			controlPoints[3 * i + 1] = aPoints[i] + aTangents[i] * (1.0f / 3.0f);
+			controlPoints[3 * i + 2] = aPoints[i + 1] - aTangents[i + 1] * (1.0f / 3.0f);
+		}
+		controlPoints.back() = aPoints[aCount - 1];
+		return FromBezier(controlPoints.data(), aCount - 1);
+	}
+
+	inline size_t CubicSpline::GetSegmentCount() const
+	{
+		return myCoefficients.size() / 4;
+	}
+
+	inline const Vec3f* CubicSpline::GetControlPoints() const
+	{
+		return myControlPoints.data();
+	}
+
+	inline size_t CubicSpline::GetSegment(float aParameter, float& aOutLocal) const
+	{
+		const float last = float(GetSegmentCount() - 1);
+		const float clamped = std::clamp(aParameter, 0.0f, last + 1.0f);
+		const float segment = std::min(std::floor(clamped), last);
+		aOutLocal = clamped - segment;
+		return size_t(segment);
+	}
+
+	inline Vec3f CubicSpline::EvaluatePosition(float aParameter) const
+	{
+		float t;
+		const Vec3f* coefficients = myCoefficients.data() + 4 * GetSegment(aParameter, t);
+		return MulAdd(MulAdd(MulAdd(coefficients[0], t, coefficients[1]), t, coefficients[2]), t, coefficients[3]);
+	}
+
+	inline Vec3f CubicSpline::EvaluateTangent(float aParameter) const
+	{
+		float t;
+		const Vec3f* coefficients = myCoefficients.data() + 4 * GetSegment(aParameter, t);
+		return MulAdd(MulAdd(coefficients[0] * 3.0f, t, coefficients[1] * 2.0f), t, coefficients[2]);
+	}
+
+	inline void CubicSpline::EvaluatePositions(const float* aParameters, Vec3f* aOutPositions, size_t aCount) const
+	{
+		EvaluateBatch<false>(aParameters, aOutPositions, aCount);
+	}
+
+	inline void CubicSpline::EvaluateTangents(const float* aParameters, Vec3f* aOutTangents, size_t aCount) const
+	{
+		EvaluateBatch<true>(aParameters, aOutTangents, aCount);
+	}
+
+	template<bool Tangents>
+	inline void CubicSpline::EvaluateBatch(const float* aParameters, Vec3f* aOutValues, size_t aCount) const
+	{
+		using namespace BB::Simd;
+
+		const Float8 zero = SplatFloat8(0.0f);
+		const Float8 end = SplatFloat8(float(GetSegmentCount()));
+		const Float8 lastSegment = SplatFloat8(float(GetSegmentCount() - 1));
+		for (size_t first = 0; first < aCount; first += 8)
+		{
+			const size_t valid = std::min<size_t>(8, aCount - first);
+			const Float8 u = Min(Max(Detail::LoadPaddedFloat8(aParameters + first, valid), zero), end);
+			const Float8 segment = Min(Floor(u), lastSegment);
+			const Float8 t = Sub(u, segment);
+
+			const float firstSegment = _mm_cvtss_f32(GetLowHalf(segment));
+			const Float8 firstSegments = SplatFloat8(firstSegment);
+			const bool sameSegment = MoveMask(Or(GreaterMask(segment, firstSegments), GreaterMask(firstSegments, segment))) == 0;
+
+			Float8 x, y, z;
+			if (sameSegment)
+			{
+				const Vec3f* source = myCoefficients.data() + 4 * size_t(firstSegment);
+				x = Detail::EvaluateCubic<Tangents>(SplatFloat8(source[0].x), SplatFloat8(source[1].x), SplatFloat8(source[2].x), SplatFloat8(source[3].x), t);
+				y = Detail::EvaluateCubic<Tangents>(SplatFloat8(source[0].y), SplatFloat8(source[1].y), SplatFloat8(source[2].y), SplatFloat8(source[3].y), t);
+				z = Detail::EvaluateCubic<Tangents>(SplatFloat8(source[0].z), SplatFloat8(source[1].z), SplatFloat8(source[2].z), SplatFloat8(source[3].z), t);
+			}
+			else
+			{
+				// [axis][power], x to z and a to d
+				alignas(32) float segments[8];
+				alignas(32) float lanes[3][4][8];
+				StoreFloat8(segments, segment);
+				for (int lane = 0; lane < 8; ++lane)
+				{
+					const Vec3f* source = myCoefficients.data() + 4 * size_t(segments[lane]);
+					for (int power = 0; power < 4; ++power)
+					{
+						lanes[0][power][lane] = source[power].x;
+						lanes[1][power][lane] = source[power].y;
+						lanes[2][power][lane] = source[power].z;
+					}
+				}
+				x = Detail::EvaluateCubic<Tangents>(LoadFloat8(lanes[0][0]), LoadFloat8(lanes[0][1]), LoadFloat8(lanes[0][2]), LoadFloat8(lanes[0][3]), t);
+				y = Detail::EvaluateCubic<Tangents>(LoadFloat8(lanes[1][0]), LoadFloat8(lanes[1][1]), LoadFloat8(lanes[1][2]), LoadFloat8(lanes[1][3]), t);
+				z = Detail::EvaluateCubic<Tangents>(LoadFloat8(lanes[2][0]), LoadFloat8(lanes[2][1]), LoadFloat8(lanes[2][2]), LoadFloat8(lanes[2][3]), t);
+			}
+			Detail::StoreVec3Lanes(x, y, z, aOutValues + first, valid);
+		}
+	}
+
+	inline void CubicSpline::Flatten(float aTolerance, std::vector<Vec3f>& aOutPoints, std::vector<float>* aOutParameters) const
+	{
+		aOutPoints.assign(1, myControlPoints[0]);
+		if (aOutParameters != nullptr)
+		{
+			aOutParameters->assign(1, 0.0f);
+		}
+		for (size_t segment = 0; segment < GetSegmentCount(); ++segment)
+		{
+			Detail::FlattenBezier(myControlPoints.data() + 3 * segment, float(segment), float(segment + 1), aTolerance * aTolerance, 0, aOutPoints, aOutParameters);
+		}
+	}
+
+	inline void ArcLengthTable::Build(const CubicSpline& aSpline, size_t aSamplesPerSegment)
+	{
+		assert(aSamplesPerSegment > 0);
+		// Five point Gauss-Legendre nodes and weights on [0, 1]
+		static constexpr float nodes[5] = { 0.0469100770f, 0.2307653449f, 0.5f, 0.7692346551f, 0.9530899230f };
+		static constexpr float weights[5] = { 0.1184634425f, 0.2393143352f, 0.2844444444f, 0.2393143352f, 0.1184634425f };
+
+		mySamplesPerSegment = aSamplesPerSegment;
+		mySampleCount = aSpline.GetSegmentCount() * aSamplesPerSegment + 1;
+		mySearchSize = std::bit_ceil(mySampleCount);
+		myDistances.assign(mySearchSize, std::numeric_limits<float>::infinity());
+
+		const float step = 1.0f / float(aSamplesPerSegment);
+		double length = 0.0;
+		myDistances[0] = 0.0f;
+		for (size_t sample = 1; sample < mySampleCount; ++sample)
+		{
+			const float start = float(sample - 1) * step;
+			float interval = 0.0f;
+			for (int node = 0; node < 5; ++node)
+			{
+				Vec3f tangent = aSpline.EvaluateTangent(start + nodes[node] * step);
+				interval += weights[node] * tangent.Length();
+			}
+			length += double(interval * step);
+			myDistances[sample] = float(length);
+		}
+		myLength = float(length);
+	}
+
+	inline float ArcLengthTable::GetLength() const
+	{
+		return myLength;
+	}
+
+	inline float ArcLengthTable::GetParameter(float aDistance) const
+	{
+		float parameter;
+		GetParameters(&aDistance, &parameter, 1);
+		return parameter;
+	}
+
+	inline void ArcLengthTable::GetParameters(const float* aDistances, float* aOutParameters, size_t aCount) const
+	{
+		using namespace BB::Simd;
+
+		// Not built, or built from a spline without segments: there is no interval to search
+		if (mySampleCount < 2)
+		{
+			std::fill(aOutParameters, aOutParameters + aCount, 0.0f);
+			return;
+		}
+
+		const float* distances = myDistances.data();
+		const Float8 zero = SplatFloat8(0.0f);
+		const Float8 length = SplatFloat8(myLength);
+		// The last interval starts at sample count - 2, a distance of exactly the length interpolates to its end
+		const Float8 lastInterval = SplatFloat8(float(mySampleCount - 2));
+		const Float8 one = SplatFloat8(1.0f);
+		const Float8 inverseSamples = SplatFloat8(1.0f / float(mySamplesPerSegment));
+		for (size_t first = 0; first < aCount; first += 8)
+		{
+			const size_t valid = std::min<size_t>(8, aCount - first);
+			const Float8 distance = Min(Max(Detail::LoadPaddedFloat8(aDistances + first, valid), zero), length);
+
+			// Largest sample with a distance <= the query, the probes past the table hit the +infinity padding
+			Float8 base = zero;
+			for (size_t step = mySearchSize / 2; step > 0; step /= 2)
+			{
+				const Float8 probe = Add(base, SplatFloat8(float(step)));
+				base = Select(GreaterEqualMask(distance, Detail::GatherFloat8(distances, probe)), probe, base);
+			}
+			base = Min(base, lastInterval);
+
+			const Float8 start = Detail::GatherFloat8(distances, base);
+			const Float8 end = Detail::GatherFloat8(distances, Add(base, one));
+			const Float8 interval = Max(Sub(end, start), SplatFloat8(FLT_MIN));
+			const Float8 fraction = Min(Div(Sub(distance, start), interval), one);
+			alignas(32) float output[8];
+			StoreFloat8(output, Mul(Add(base, fraction), inverseSamples));
+			std::copy(output, output + valid, aOutParameters + first);
+		}
+	}
+} // namespace BitBloom
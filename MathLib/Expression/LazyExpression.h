@@ -0,0 +1,273 @@
+#pragma once
+#include <cstddef>
+#include "../Util/Intrinsics.h"
+#include "../Vector/Vector3f/Vector3f.h"
+#include "../Vector/Vector4f/Vector4f.h"
+
+/**
+ * @file LazyExpression.h
+ * @brief Opt-in expression templates for chained Vec3f and Vec4f arithmetic.
+ *
+ * @details The regular operators return a new vector for every step, so `a + b * c - d` builds
+ * two temporaries. Wrapping an operand with BB::Lazy() makes the operators build a small tree
+ * of nodes instead, and the whole tree is evaluated in registers once it is assigned to a vector.
+ * A product that is directly added or subtracted is contracted to MulAdd, MulSub or NegMulAdd,
+ * which are single FMA3 instructions when BB_USE_FMA is defined.
+ *
+ * @code
+ * Vec3f result = BB::Lazy(a) + BB::Lazy(b) * c - d;   // one MulAdd and one sub
+ *
+ * // Arrays are leaves too, the whole expression makes one pass over memory
+ * BB::Evaluate(output, count, BB::Lazy(positions) + BB::Lazy(velocities) * deltaTime);
+ * @endcode
+ *
+ * @note Only operands that are part of the tree are fused. In `BB::Lazy(a) + b * c` the product
+ * uses the regular Vec3f operator and is added as a finished vector, write `BB::Lazy(b) * c` to fuse it.
+ *
+ * @warning Nodes keep pointers to arrays wrapped with Lazy(), the arrays have to outlive the expression.
+ */
+
+namespace BitBloom
+{
+namespace Expression
+{
+	template<class TVector, class TLeft, class TRight> struct Sum;
+	template<class TVector, class TLeft, class TRight> struct Difference;
+	template<class TVector, class TLeft, class TRight> struct Product;
+	template<class TVector, class TLeft, class TRight> struct Quotient;
+
+/**
+* @brief Base of all expression nodes.
+*
+* @details Every node provides `__m128 Load(size_t aIndex) const`. Leaves that hold a single vector
+* ignore the index, array leaves use it to pick the element.
+*/
+	template<class TVector, class TDerived>
+	struct Node
+	{
+		const TDerived& Self() const { return static_cast<const TDerived&>(*this); }
+
+		/// @brief Evaluates the expression for a single vector.
+		TVector Evaluate() const { return Self().Load(0); }
+		operator TVector() const { return Self().Load(0); }
+	};
+
+/// @brief Leaf holding a single vector, the data is copied so temporaries can be used.
+	template<class TVector>
+	struct Value : Node<TVector, Value<TVector>>
+	{
+		explicit Value(const TVector& aVector) : myData(aVector.data) {}
+		__m128 Load(size_t) const { return myData; }
+
+		__m128 myData;
+	};
+
+/// @brief Leaf holding a float broadcast to all lanes.
+	template<class TVector>
+	struct Scalar : Node<TVector, Scalar<TVector>>
+	{
+		explicit Scalar(float aScalar) : myData(_mm_set1_ps(aScalar)) {}
+		__m128 Load(size_t) const { return myData; }
+
+		__m128 myData;
+	};
+
+/// @brief Leaf reading element aIndex of an array.
+	template<class TVector>
+	struct Array : Node<TVector, Array<TVector>>
+	{
+		explicit Array(const TVector* aArray) : myArray(aArray) {}
+		__m128 Load(size_t aIndex) const { return myArray[aIndex].data; }
+
+		const TVector* myArray;
+	};
+
+	namespace Detail
+	{
+		// Division has to keep the unused w lane of Vec3f at zero, the same as operator/ does
+		template<class TVector>
+		struct Lanes
+		{
+			static __m128 Divide(__m128 aDividend, __m128 aDivisor) { return _mm_div_ps(aDividend, aDivisor); }
+		};
+
+		template<>
+		struct Lanes<Vec3f>
+		{
+			static __m128 Divide(__m128 aDividend, __m128 aDivisor)
+			{
+				return _mm_and_ps(_mm_div_ps(aDividend, aDivisor), _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1)));
+			}
+		};
+
+		// A product on either side of a sum or difference is contracted to a fused instruction,
+		// the more specialised overloads are picked by partial ordering
+		template<class TLeft, class TRight>
+		inline __m128 LoadSum(const TLeft& aLeft, const TRight& aRight, size_t aIndex)
+		{
+			return _mm_add_ps(aLeft.Load(aIndex), aRight.Load(aIndex));
+		}
+
+		template<class TVector, class TFactorOne, class TFactorTwo, class TRight>
+		inline __m128 LoadSum(const Product<TVector, TFactorOne, TFactorTwo>& aLeft, const TRight& aRight, size_t aIndex)
+		{
+			return Simd::MulAdd(aLeft.myLeft.Load(aIndex), aLeft.myRight.Load(aIndex), aRight.Load(aIndex));
+		}
+
+		template<class TVector, class TLeft, class TFactorOne, class TFactorTwo>
+		inline __m128 LoadSum(const TLeft& aLeft, const Product<TVector, TFactorOne, TFactorTwo>& aRight, size_t aIndex)
+		{
+			return Simd::MulAdd(aRight.myLeft.Load(aIndex), aRight.myRight.Load(aIndex), aLeft.Load(aIndex));
+		}
+
+		template<class TVector, class TFactorOne, class TFactorTwo, class TFactorThree, class TFactorFour>
+		inline __m128 LoadSum(const Product<TVector, TFactorOne, TFactorTwo>& aLeft, const Product<TVector, TFactorThree, TFactorFour>& aRight, size_t aIndex)
+		{
+			return Simd::MulAdd(aLeft.myLeft.Load(aIndex), aLeft.myRight.Load(aIndex), aRight.Load(aIndex));
+		}
+
+		template<class TLeft, class TRight>
+		inline __m128 LoadDifference(const TLeft& aLeft, const TRight& aRight, size_t aIndex)
+		{
+			return _mm_sub_ps(aLeft.Load(aIndex), aRight.Load(aIndex));
+		}
+
+		template<class TVector, class TFactorOne, class TFactorTwo, class TRight>
+		inline __m128 LoadDifference(const Product<TVector, TFactorOne, TFactorTwo>& aLeft, const TRight& aRight, size_t aIndex)
+		{
+			return Simd::MulSub(aLeft.myLeft.Load(aIndex), aLeft.myRight.Load(aIndex), aRight.Load(aIndex));
+		}
+
+		template<class TVector, class TLeft, class TFactorOne, class TFactorTwo>
+		inline __m128 LoadDifference(const TLeft& aLeft, const Product<TVector, TFactorOne, TFactorTwo>& aRight, size_t aIndex)
+		{
+			return Simd::NegMulAdd(aRight.myLeft.Load(aIndex), aRight.myRight.Load(aIndex), aLeft.Load(aIndex));
+		}
+
+		template<class TVector, class TFactorOne, class TFactorTwo, class TFactorThree, class TFactorFour>
+		inline __m128 LoadDifference(const Product<TVector, TFactorOne, TFactorTwo>& aLeft, const Product<TVector, TFactorThree, TFactorFour>& aRight, size_t aIndex)
+		{
+			return Simd::MulSub(aLeft.myLeft.Load(aIndex), aLeft.myRight.Load(aIndex), aRight.Load(aIndex));
+		}
+	} // namespace Detail
+
+	template<class TVector, class TLeft, class TRight>
+	struct Sum : Node<TVector, Sum<TVector, TLeft, TRight>>
+	{
+		Sum(const TLeft& aLeft, const TRight& aRight) : myLeft(aLeft), myRight(aRight) {}
+		__m128 Load(size_t aIndex) const { return Detail::LoadSum(myLeft, myRight, aIndex); }
+
+		TLeft myLeft;
+		TRight myRight;
+	};
+
+	template<class TVector, class TLeft, class TRight>
+	struct Difference : Node<TVector, Difference<TVector, TLeft, TRight>>
+	{
+		Difference(const TLeft& aLeft, const TRight& aRight) : myLeft(aLeft), myRight(aRight) {}
+		__m128 Load(size_t aIndex) const { return Detail::LoadDifference(myLeft, myRight, aIndex); }
+
+		TLeft myLeft;
+		TRight myRight;
+	};
+
+	template<class TVector, class TLeft, class TRight>
+	struct Product : Node<TVector, Product<TVector, TLeft, TRight>>
+	{
+		Product(const TLeft& aLeft, const TRight& aRight) : myLeft(aLeft), myRight(aRight) {}
+		__m128 Load(size_t aIndex) const { return _mm_mul_ps(myLeft.Load(aIndex), myRight.Load(aIndex)); }
+
+		TLeft myLeft;
+		TRight myRight;
+	};
+
+	template<class TVector, class TLeft, class TRight>
+	struct Quotient : Node<TVector, Quotient<TVector, TLeft, TRight>>
+	{
+		Quotient(const TLeft& aLeft, const TRight& aRight) : myLeft(aLeft), myRight(aRight) {}
+		__m128 Load(size_t aIndex) const { return Detail::Lanes<TVector>::Divide(myLeft.Load(aIndex), myRight.Load(aIndex)); }
+
+		TLeft myLeft;
+		TRight myRight;
+	};
+
+	template<class TVector, class TOperand>
+	struct Negation : Node<TVector, Negation<TVector, TOperand>>
+	{
+		explicit Negation(const TOperand& aOperand) : myOperand(aOperand) {}
+		__m128 Load(size_t aIndex) const { return _mm_xor_ps(myOperand.Load(aIndex), _mm_set1_ps(-0.0f)); }
+
+		TOperand myOperand;
+	};
+
+/**
+* @name Expression operators
+* @brief Operators building expression nodes, found through argument-dependent lookup.
+* @{
+*/
+	template<class TVector, class TLeft, class TRight>
+	inline Sum<TVector, TLeft, TRight> operator+(const Node<TVector, TLeft>& aLeft, const Node<TVector, TRight>& aRight) { return { aLeft.Self(), aRight.Self() }; }
+	template<class TVector, class TLeft>
+	inline Sum<TVector, TLeft, Value<TVector>> operator+(const Node<TVector, TLeft>& aLeft, const TVector& aRight) { return { aLeft.Self(), Value<TVector>(aRight) }; }
+	template<class TVector, class TRight>
+	inline Sum<TVector, Value<TVector>, TRight> operator+(const TVector& aLeft, const Node<TVector, TRight>& aRight) { return { Value<TVector>(aLeft), aRight.Self() }; }
+
+	template<class TVector, class TLeft, class TRight>
+	inline Difference<TVector, TLeft, TRight> operator-(const Node<TVector, TLeft>& aLeft, const Node<TVector, TRight>& aRight) { return { aLeft.Self(), aRight.Self() }; }
+	template<class TVector, class TLeft>
+	inline Difference<TVector, TLeft, Value<TVector>> operator-(const Node<TVector, TLeft>& aLeft, const TVector& aRight) { return { aLeft.Self(), Value<TVector>(aRight) }; }
+	template<class TVector, class TRight>
+	inline Difference<TVector, Value<TVector>, TRight> operator-(const TVector& aLeft, const Node<TVector, TRight>& aRight) { return { Value<TVector>(aLeft), aRight.Self() }; }
+
+	template<class TVector, class TLeft, class TRight>
+	inline Product<TVector, TLeft, TRight> operator*(const Node<TVector, TLeft>& aLeft, const Node<TVector, TRight>& aRight) { return { aLeft.Self(), aRight.Self() }; }
+	template<class TVector, class TLeft>
+	inline Product<TVector, TLeft, Value<TVector>> operator*(const Node<TVector, TLeft>& aLeft, const TVector& aRight) { return { aLeft.Self(), Value<TVector>(aRight) }; }
+	template<class TVector, class TRight>
+	inline Product<TVector, Value<TVector>, TRight> operator*(const TVector& aLeft, const Node<TVector, TRight>& aRight) { return { Value<TVector>(aLeft), aRight.Self() }; }
+	template<class TVector, class TLeft>
+	inline Product<TVector, TLeft, Scalar<TVector>> operator*(const Node<TVector, TLeft>& aLeft, float aScalar) { return { aLeft.Self(), Scalar<TVector>(aScalar) }; }
+	template<class TVector, class TRight>
+	inline Product<TVector, Scalar<TVector>, TRight> operator*(float aScalar, const Node<TVector, TRight>& aRight) { return { Scalar<TVector>(aScalar), aRight.Self() }; }
+
+	template<class TVector, class TLeft, class TRight>
+	inline Quotient<TVector, TLeft, TRight> operator/(const Node<TVector, TLeft>& aLeft, const Node<TVector, TRight>& aRight) { return { aLeft.Self(), aRight.Self() }; }
+	template<class TVector, class TLeft>
+	inline Quotient<TVector, TLeft, Value<TVector>> operator/(const Node<TVector, TLeft>& aLeft, const TVector& aRight) { return { aLeft.Self(), Value<TVector>(aRight) }; }
+	template<class TVector, class TLeft>
+	inline Quotient<TVector, TLeft, Scalar<TVector>> operator/(const Node<TVector, TLeft>& aLeft, float aScalar) { return { aLeft.Self(), Scalar<TVector>(aScalar) }; }
+
+	template<class TVector, class TOperand>
+	inline Negation<TVector, TOperand> operator-(const Node<TVector, TOperand>& aOperand) { return Negation<TVector, TOperand>(aOperand.Self()); }
+/** @} */
+} // namespace Expression
+
+/// @brief Starts a lazy expression from a single vector.
+	inline Expression::Value<Vec3f> Lazy(const Vec3f& aVector) { return Expression::Value<Vec3f>(aVector); }
+/// @brief Starts a lazy expression from a single vector.
+	inline Expression::Value<Vec4f> Lazy(const Vec4f& aVector) { return Expression::Value<Vec4f>(aVector); }
+/// @brief Starts a lazy expression over an array, element i is used when evaluating index i.
+	inline Expression::Array<Vec3f> Lazy(const Vec3f* aArray) { return Expression::Array<Vec3f>(aArray); }
+/// @brief Starts a lazy expression over an array, element i is used when evaluating index i.
+	inline Expression::Array<Vec4f> Lazy(const Vec4f* aArray) { return Expression::Array<Vec4f>(aArray); }
+
+/**
+* @brief Evaluates an expression for every index in [0, aCount) and writes the results to aOutResult.
+*
+* @details The whole tree is evaluated per element, so every input array is read once and the
+* output is written once, without intermediate arrays.
+*
+* @note aOutResult may be one of the arrays in the expression, each element only reads its own index.
+*/
+	template<class TVector, class TExpression>
+	inline void Evaluate(TVector* aOutResult, size_t aCount, const Expression::Node<TVector, TExpression>& aExpression)
+	{
+		const TExpression& expression = aExpression.Self();
+		for (size_t i = 0; i < aCount; ++i)
+		{
+			aOutResult[i].data = expression.Load(i);
+		}
+	}
+} // namespace BitBloom
+
+namespace BB = BitBloom;
@@ -23,9 +23,16 @@
  *
  * @section warning_sec Warnings
  *
- * - No automatic checks for division by zero or invalid float values (e.g., NaN).
- * - No checks for positive or negative infinity values.
+ * - No automatic checks for division by zero or invalid float values (e.g., NaN) in release builds.
+ *   Debug builds report them through BB_VALIDATE (Util/Validation.h), which compiles to nothing
+ *   when NDEBUG is defined.
+ * - No checks for positive or negative infinity values. Use GetSafeNormalized where a vector can
+ *   be zero, IsFinite / FiniteMask to test and BB::Bulk::Sanitize to clean whole arrays.
  * - Ensure all memory used in SIMD operations is properly aligned (16-byte alignment required).
+ *   Use BB::AlignedVector (Memory/AlignedAllocator.h) for heap arrays and BB::FrameArena
+ *   (Memory/FrameArena.h) for per-frame scratch arrays, both guarantee the alignment.
+ * - Denormal floats are slow on most x86 cores. Wrap loops that decay towards zero (damping,
+ *   falloff) in BB::ScopedFlushDenormals (Util/Denormals.h), the mode is per thread.
  *
  * @section related_sec Related Files
  *
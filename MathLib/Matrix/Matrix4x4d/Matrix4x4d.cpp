@@ -0,0 +1,2 @@
+#include "pch.h"
+#include "Matrix4x4d.h"
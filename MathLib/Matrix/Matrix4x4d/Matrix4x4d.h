@@ -0,0 +1,130 @@
+#pragma once
+#include "../../Util/Double4.h"
+#include "../../Vector/Vector3d/Vector3d.h"
+#include "../../Vector/Vector4d/Vector4d.h"
+#include "../Matrix4x4f/Matrix4x4f.h"
+
+/**
+ * @brief Mat4x4d is the double precision counterpart of Mat4x4f.
+ *
+ * @details Same layout and conventions as Mat4x4f: row-major, row vectors multiplied from the left
+ * (v * M) and the translation in row 3. Each row is a BB::Simd::Double4 (see Double4.h).
+ *
+ * It covers the transform math of large worlds and simulations. The camera and projection
+ * factories stay on Mat4x4f, convert world transforms relative to the camera first
+ * (see Bulk/CameraRelative.h) and build the view and projection in float.
+ */
+class alignas(32) Mat4x4d
+{
+public:
+	union
+	{
+		BB::Simd::Double4 row[MATRIX4X4_ROW_AMOUNT];
+		double data[16];
+		struct
+		{
+			double p00, p01, p02, p03,
+				   p10, p11, p12, p13,
+				   p20, p21, p22, p23,
+				   p30, p31, p32, p33;
+		};
+		/// @brief Scalar view used by the constexpr code path.
+		BB::ScalarLanes<16, double> lanes;
+	};
+
+/**
+* @name Constructors
+* @brief The default constructor builds the identity, all but the row and Mat4x4f constructors are constexpr.
+* @{
+*/
+	constexpr Mat4x4d();
+	Mat4x4d(const Mat4x4d& aMatrix) = default;
+	constexpr Mat4x4d(const Vec3d& aPosition);
+/// @brief Initializes the matrix from its 16 elements in row-major order.
+	constexpr Mat4x4d(double aP00, double aP01, double aP02, double aP03,
+					  double aP10, double aP11, double aP12, double aP13,
+					  double aP20, double aP21, double aP22, double aP23,
+					  double aP30, double aP31, double aP32, double aP33);
+	Mat4x4d(const BB::Simd::Double4& aRowOne, const BB::Simd::Double4& aRowTwo, const BB::Simd::Double4& aRowThree, const BB::Simd::Double4& aRowFour);
+/// @brief Widens a Mat4x4f, exact.
+	explicit Mat4x4d(const Mat4x4f& aMatrix);
+/** @} */
+
+/// @brief Rounds all elements to float.
+	inline Mat4x4f ToMat4x4f() const;
+
+	constexpr void SetTranslation(double aX, double aY, double aZ);
+	constexpr void SetTranslation(const Vec3d& aPosition);
+
+	constexpr Mat4x4d GetTransposed() const;
+	constexpr void Transpose();
+
+/// @brief Returns aPoint * M with w = 1, the translation is applied.
+	inline Vec3d TransformPoint(const Vec3d& aPoint) const;
+/// @brief Returns aVector * M with w = 0, the translation is ignored.
+	inline Vec3d TransformVector(const Vec3d& aVector) const;
+/// @brief Returns aVector * M.
+	inline Vec4d Transform(const Vec4d& aVector) const;
+
+/**
+* @name Load and store
+* @brief Moving a Mat4x4d between registers and 16 plain doubles in row-major order.
+* @{
+*/
+	static inline Mat4x4d LoadUnaligned(const double* aSource);
+/// @brief Loads 16 doubles from a 32-byte aligned pointer.
+	static inline Mat4x4d LoadAligned(const double* aSource);
+	inline void StoreUnaligned(double* aDestination) const;
+/// @brief Writes the 16 elements to a 32-byte aligned pointer.
+	inline void StoreAligned(double* aDestination) const;
+/// @brief Non-temporal store to a 32-byte aligned pointer, call BB::Simd::StreamFence() before other threads read the data.
+	inline void StoreStream(double* aDestination) const;
+/** @} */
+};
+
+constexpr bool operator==(const Mat4x4d& aMatrixOne, const Mat4x4d& aMatrixTwo);
+constexpr bool operator!=(const Mat4x4d& aMatrixOne, const Mat4x4d& aMatrixTwo);
+
+constexpr Mat4x4d operator+(const Mat4x4d& __restrict aMatrixOne, const Mat4x4d& __restrict aMatrixTwo);
+constexpr Mat4x4d operator-(const Mat4x4d& __restrict aMatrixOne, const Mat4x4d& __restrict aMatrixTwo);
+
+/**
+* @brief Multiplies two matrices, aOutResult = aMatrixOne * aMatrixTwo.
+*
+* @details Works like the Mat4x4f version, aOutResult may alias either operand.
+*/
+constexpr void Multiply(const Mat4x4d& aMatrixOne, const Mat4x4d& aMatrixTwo, Mat4x4d& aOutResult);
+
+constexpr Mat4x4d operator*(const Mat4x4d& aMatrixOne, const Mat4x4d& aMatrixTwo);
+constexpr Mat4x4d operator*(const Mat4x4d& aMatrixOne, double aScalar);
+constexpr Mat4x4d operator*(double aScalar, const Mat4x4d& aMatrixOne);
+
+constexpr Mat4x4d operator/(const Mat4x4d& aMatrixOne, double aScalar);
+
+constexpr void operator+=(Mat4x4d& __restrict aMatrixOne, const Mat4x4d& __restrict aMatrixTwo);
+constexpr void operator-=(Mat4x4d& __restrict aMatrixOne, const Mat4x4d& __restrict aMatrixTwo);
+/// @brief Multiplies aMatrixOne by aMatrixTwo in place, aMatrixOne = aMatrixOne * aMatrixTwo.
+constexpr void operator*=(Mat4x4d& aMatrixOne, const Mat4x4d& aMatrixTwo);
+
+/**
+* @name Fused arithmetic
+* @brief Multiply-add style functions for Mat4x4d, see the Mat4x4f versions.
+* @{
+*/
+/// @brief Computes (aMatrixOne * aMatrixTwo) + aAddend, where * is the matrix product.
+inline Mat4x4d MulAdd(const Mat4x4d& aMatrixOne, const Mat4x4d& aMatrixTwo, const Mat4x4d& aAddend);
+/// @brief Computes (aMatrixOne * aMatrixTwo) - aSubtrahend, where * is the matrix product.
+inline Mat4x4d MulSub(const Mat4x4d& aMatrixOne, const Mat4x4d& aMatrixTwo, const Mat4x4d& aSubtrahend);
+/// @brief Computes aAddend - (aMatrixOne * aMatrixTwo), where * is the matrix product.
+inline Mat4x4d NegMulAdd(const Mat4x4d& aMatrixOne, const Mat4x4d& aMatrixTwo, const Mat4x4d& aAddend);
+/// @brief Element-wise linear interpolation, returns aFrom for aT = 0 and aTo for aT = 1.
+inline Mat4x4d Lerp(const Mat4x4d& aFrom, const Mat4x4d& aTo, double aT);
+/** @} */
+
+#include "Matrix4x4d.inl"
+
+namespace BitBloom
+{
+/// @brief Compile-time identity matrix, built through the constexpr constructor.
+	inline constexpr Mat4x4d MAT4X4D_IDENTITY = Mat4x4d();
+}
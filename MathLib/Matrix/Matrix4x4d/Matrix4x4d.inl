@@ -0,0 +1,392 @@
+#pragma once
+#include "Matrix4x4d.h"
+
+#pragma region Constructors
+constexpr Mat4x4d::Mat4x4d() : Mat4x4d(1, 0, 0, 0,
+									   0, 1, 0, 0,
+									   0, 0, 1, 0,
+									   0, 0, 0, 1)
+{
+}
+
+constexpr Mat4x4d::Mat4x4d(const Vec3d& aPosition) : Mat4x4d()
+{
+	SetTranslation(aPosition);
+}
+
+constexpr Mat4x4d::Mat4x4d(double aP00, double aP01, double aP02, double aP03,
+						   double aP10, double aP11, double aP12, double aP13,
+						   double aP20, double aP21, double aP22, double aP23,
+						   double aP30, double aP31, double aP32, double aP33)
+{
+	if (std::is_constant_evaluated())
+	{
+		lanes = BB::ScalarLanes<16, double>{ { aP00, aP01, aP02, aP03,
+											   aP10, aP11, aP12, aP13,
+											   aP20, aP21, aP22, aP23,
+											   aP30, aP31, aP32, aP33 } };
+	}
+	else
+	{
+		row[0] = BB::Simd::SetDouble4(aP00, aP01, aP02, aP03);
+		row[1] = BB::Simd::SetDouble4(aP10, aP11, aP12, aP13);
+		row[2] = BB::Simd::SetDouble4(aP20, aP21, aP22, aP23);
+		row[3] = BB::Simd::SetDouble4(aP30, aP31, aP32, aP33);
+	}
+}
+
+inline Mat4x4d::Mat4x4d(const BB::Simd::Double4& aRowOne, const BB::Simd::Double4& aRowTwo, const BB::Simd::Double4& aRowThree, const BB::Simd::Double4& aRowFour)
+{
+	row[0] = aRowOne;
+	row[1] = aRowTwo;
+	row[2] = aRowThree;
+	row[3] = aRowFour;
+}
+
+inline Mat4x4d::Mat4x4d(const Mat4x4f& aMatrix)
+{
+	for (int i = 0; i < MATRIX4X4_ROW_AMOUNT; i++)
+	{
+		row[i] = BB::Simd::ToDouble4(aMatrix.row[i]);
+	}
+}
+
+constexpr void Mat4x4d::SetTranslation(double aX, double aY, double aZ)
+{
+	if (std::is_constant_evaluated())
+	{
+		lanes.value[12] = aX;
+		lanes.value[13] = aY;
+		lanes.value[14] = aZ;
+		return;
+	}
+	p30 = aX;
+	p31 = aY;
+	p32 = aZ;
+}
+
+constexpr void Mat4x4d::SetTranslation(const Vec3d& aPosition)
+{
+	if (std::is_constant_evaluated())
+	{
+		SetTranslation(aPosition.lanes.value[0], aPosition.lanes.value[1], aPosition.lanes.value[2]);
+		return;
+	}
+	p30 = aPosition.x;
+	p31 = aPosition.y;
+	p32 = aPosition.z;
+}
+
+#pragma endregion
+
+#pragma region ClassFunctions
+
+inline Mat4x4f Mat4x4d::ToMat4x4f() const
+{
+	return Mat4x4f(BB::Simd::ToFloat4(row[0]), BB::Simd::ToFloat4(row[1]), BB::Simd::ToFloat4(row[2]), BB::Simd::ToFloat4(row[3]));
+}
+
+constexpr Mat4x4d Mat4x4d::GetTransposed() const
+{
+	Mat4x4d result = *this;
+	result.Transpose();
+	return result;
+}
+
+constexpr void Mat4x4d::Transpose()
+{
+	if (std::is_constant_evaluated())
+	{
+		BB::ScalarLanes<16, double> transposed = {};
+		for (int i = 0; i < 16; i++)
+		{
+			transposed.value[i] = lanes.value[(i % 4) * 4 + i / 4];
+		}
+		lanes = transposed;
+		return;
+	}
+	BB::Simd::Transpose(row[0], row[1], row[2], row[3]);
+}
+
+inline Vec3d Mat4x4d::TransformPoint(const Vec3d& aPoint) const
+{
+	BB::Simd::Double4 result = BB::Simd::MulAdd(BB::Simd::SplatDouble4(aPoint.x), row[0], row[3]);
+	result = BB::Simd::MulAdd(BB::Simd::SplatDouble4(aPoint.y), row[1], result);
+	return BB::Simd::ClearW(BB::Simd::MulAdd(BB::Simd::SplatDouble4(aPoint.z), row[2], result));
+}
+
+inline Vec3d Mat4x4d::TransformVector(const Vec3d& aVector) const
+{
+	BB::Simd::Double4 result = BB::Simd::Mul(BB::Simd::SplatDouble4(aVector.x), row[0]);
+	result = BB::Simd::MulAdd(BB::Simd::SplatDouble4(aVector.y), row[1], result);
+	return BB::Simd::ClearW(BB::Simd::MulAdd(BB::Simd::SplatDouble4(aVector.z), row[2], result));
+}
+
+inline Vec4d Mat4x4d::Transform(const Vec4d& aVector) const
+{
+	BB::Simd::Double4 result = BB::Simd::Mul(BB::Simd::SplatDouble4(aVector.x), row[0]);
+	result = BB::Simd::MulAdd(BB::Simd::SplatDouble4(aVector.y), row[1], result);
+	result = BB::Simd::MulAdd(BB::Simd::SplatDouble4(aVector.z), row[2], result);
+	return BB::Simd::MulAdd(BB::Simd::SplatDouble4(aVector.w), row[3], result);
+}
+
+inline Mat4x4d Mat4x4d::LoadUnaligned(const double* aSource)
+{
+	return Mat4x4d(BB::Simd::LoadDouble4(aSource), BB::Simd::LoadDouble4(aSource + 4),
+				   BB::Simd::LoadDouble4(aSource + 8), BB::Simd::LoadDouble4(aSource + 12));
+}
+
+inline Mat4x4d Mat4x4d::LoadAligned(const double* aSource)
+{
+	return Mat4x4d(BB::Simd::LoadAlignedDouble4(aSource), BB::Simd::LoadAlignedDouble4(aSource + 4),
+				   BB::Simd::LoadAlignedDouble4(aSource + 8), BB::Simd::LoadAlignedDouble4(aSource + 12));
+}
+
+inline void Mat4x4d::StoreUnaligned(double* aDestination) const
+{
+	for (int i = 0; i < MATRIX4X4_ROW_AMOUNT; i++)
+	{
+		BB::Simd::StoreDouble4(aDestination + i * 4, row[i]);
+	}
+}
+
+inline void Mat4x4d::StoreAligned(double* aDestination) const
+{
+	for (int i = 0; i < MATRIX4X4_ROW_AMOUNT; i++)
+	{
+		BB::Simd::StoreAlignedDouble4(aDestination + i * 4, row[i]);
+	}
+}
+
+inline void Mat4x4d::StoreStream(double* aDestination) const
+{
+	for (int i = 0; i < MATRIX4X4_ROW_AMOUNT; i++)
+	{
+		BB::Simd::StoreStreamDouble4(aDestination + i * 4, row[i]);
+	}
+}
+
+#pragma endregion
+
+#pragma region OperatorDefinitions
+
+// The operators below take a scalar loop over Mat4x4d::lanes during constant evaluation.
+
+constexpr bool operator==(const Mat4x4d& aMatrixOne, const Mat4x4d& aMatrixTwo)
+{
+	if (std::is_constant_evaluated())
+	{
+		for (int i = 0; i < 16; i++)
+		{
+			if (aMatrixOne.lanes.value[i] != aMatrixTwo.lanes.value[i])
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+	bool result = true;
+	for (int i = 0; i < MATRIX4X4_ROW_AMOUNT; i++)
+	{
+		result &= BB::Simd::AllEqual(aMatrixOne.row[i], aMatrixTwo.row[i]);
+	}
+	return result;
+}
+
+constexpr bool operator!=(const Mat4x4d& aMatrixOne, const Mat4x4d& aMatrixTwo)
+{
+	return !(aMatrixOne == aMatrixTwo);
+}
+
+constexpr Mat4x4d operator+(const Mat4x4d& __restrict aMatrixOne, const Mat4x4d& __restrict aMatrixTwo)
+{
+	if (std::is_constant_evaluated())
+	{
+		Mat4x4d result;
+		for (int i = 0; i < 16; i++)
+		{
+			result.lanes.value[i] = aMatrixOne.lanes.value[i] + aMatrixTwo.lanes.value[i];
+		}
+		return result;
+	}
+	return { BB::Simd::Add(aMatrixOne.row[0], aMatrixTwo.row[0]),
+			 BB::Simd::Add(aMatrixOne.row[1], aMatrixTwo.row[1]),
+			 BB::Simd::Add(aMatrixOne.row[2], aMatrixTwo.row[2]),
+			 BB::Simd::Add(aMatrixOne.row[3], aMatrixTwo.row[3]), };
+}
+
+constexpr Mat4x4d operator-(const Mat4x4d& __restrict aMatrixOne, const Mat4x4d& __restrict aMatrixTwo)
+{
+	if (std::is_constant_evaluated())
+	{
+		Mat4x4d result;
+		for (int i = 0; i < 16; i++)
+		{
+			result.lanes.value[i] = aMatrixOne.lanes.value[i] - aMatrixTwo.lanes.value[i];
+		}
+		return result;
+	}
+	return { BB::Simd::Sub(aMatrixOne.row[0], aMatrixTwo.row[0]),
+			 BB::Simd::Sub(aMatrixOne.row[1], aMatrixTwo.row[1]),
+			 BB::Simd::Sub(aMatrixOne.row[2], aMatrixTwo.row[2]),
+			 BB::Simd::Sub(aMatrixOne.row[3], aMatrixTwo.row[3]), };
+}
+
+constexpr void Multiply(const Mat4x4d& aMatrixOne, const Mat4x4d& aMatrixTwo, Mat4x4d& aOutResult)
+{
+	if (std::is_constant_evaluated())
+	{
+		// Accumulates into a temporary so aOutResult may alias either operand here as well
+		BB::ScalarLanes<16, double> result = {};
+		for (int i = 0; i < 16; i++)
+		{
+			const int rowStart = (i / 4) * 4;
+			const int column = i % 4;
+			for (int k = 0; k < 4; k++)
+			{
+				result.value[i] += aMatrixOne.lanes.value[rowStart + k] * aMatrixTwo.lanes.value[k * 4 + column];
+			}
+		}
+		aOutResult.lanes = result;
+		return;
+	}
+
+	const BB::Simd::Double4 rowZero = aMatrixTwo.row[0];
+	const BB::Simd::Double4 rowOne = aMatrixTwo.row[1];
+	const BB::Simd::Double4 rowTwo = aMatrixTwo.row[2];
+	const BB::Simd::Double4 rowThree = aMatrixTwo.row[3];
+
+	for (int i = 0; i < MATRIX4X4_ROW_AMOUNT; ++i)
+	{
+		// Broadcasting straight from memory is a single instruction, unlike a cross-lane splat on AVX
+		const double* row = aMatrixOne.data + i * 4;
+
+		BB::Simd::Double4 result = BB::Simd::Mul(BB::Simd::SplatDouble4(row[0]), rowZero);
+		result = BB::Simd::MulAdd(BB::Simd::SplatDouble4(row[1]), rowOne, result);
+		result = BB::Simd::MulAdd(BB::Simd::SplatDouble4(row[2]), rowTwo, result);
+		aOutResult.row[i] = BB::Simd::MulAdd(BB::Simd::SplatDouble4(row[3]), rowThree, result);
+	}
+}
+
+constexpr Mat4x4d operator*(const Mat4x4d& aMatrixOne, const Mat4x4d& aMatrixTwo)
+{
+	Mat4x4d result;
+	Multiply(aMatrixOne, aMatrixTwo, result);
+	return result;
+}
+
+constexpr Mat4x4d operator*(const Mat4x4d& aMatrixOne, double aScalar)
+{
+	if (std::is_constant_evaluated())
+	{
+		Mat4x4d result;
+		for (int i = 0; i < 16; i++)
+		{
+			result.lanes.value[i] = aMatrixOne.lanes.value[i] * aScalar;
+		}
+		return result;
+	}
+	const BB::Simd::Double4 scalar = BB::Simd::SplatDouble4(aScalar);
+	return { BB::Simd::Mul(aMatrixOne.row[0], scalar),
+			 BB::Simd::Mul(aMatrixOne.row[1], scalar),
+			 BB::Simd::Mul(aMatrixOne.row[2], scalar),
+			 BB::Simd::Mul(aMatrixOne.row[3], scalar), };
+}
+
+constexpr Mat4x4d operator*(double aScalar, const Mat4x4d& aMatrixOne)
+{
+	return aMatrixOne * aScalar;
+}
+
+constexpr Mat4x4d operator/(const Mat4x4d& aMatrixOne, double aScalar)
+{
+	if (std::is_constant_evaluated())
+	{
+		Mat4x4d result;
+		for (int i = 0; i < 16; i++)
+		{
+			result.lanes.value[i] = aMatrixOne.lanes.value[i] / aScalar;
+		}
+		return result;
+	}
+	const BB::Simd::Double4 scalar = BB::Simd::SplatDouble4(aScalar);
+	return { BB::Simd::Div(aMatrixOne.row[0], scalar),
+			 BB::Simd::Div(aMatrixOne.row[1], scalar),
+			 BB::Simd::Div(aMatrixOne.row[2], scalar),
+			 BB::Simd::Div(aMatrixOne.row[3], scalar), };
+}
+
+constexpr void operator+=(Mat4x4d& __restrict aMatrixOne, const Mat4x4d& __restrict aMatrixTwo)
+{
+	aMatrixOne = aMatrixOne + aMatrixTwo;
+}
+
+constexpr void operator-=(Mat4x4d& __restrict aMatrixOne, const Mat4x4d& __restrict aMatrixTwo)
+{
+	aMatrixOne = aMatrixOne - aMatrixTwo;
+}
+
+constexpr void operator*=(Mat4x4d& aMatrixOne, const Mat4x4d& aMatrixTwo)
+{
+	Multiply(aMatrixOne, aMatrixTwo, aMatrixOne);
+}
+
+#pragma endregion
+
+#pragma region FusedArithmetic
+
+inline Mat4x4d MulAdd(const Mat4x4d& aMatrixOne, const Mat4x4d& aMatrixTwo, const Mat4x4d& aAddend)
+{
+	Mat4x4d result;
+	for (int i = 0; i < MATRIX4X4_ROW_AMOUNT; ++i)
+	{
+		const double* row = aMatrixOne.data + i * 4;
+
+		BB::Simd::Double4 sum = BB::Simd::MulAdd(BB::Simd::SplatDouble4(row[0]), aMatrixTwo.row[0], aAddend.row[i]);
+		sum = BB::Simd::MulAdd(BB::Simd::SplatDouble4(row[1]), aMatrixTwo.row[1], sum);
+		sum = BB::Simd::MulAdd(BB::Simd::SplatDouble4(row[2]), aMatrixTwo.row[2], sum);
+		result.row[i] = BB::Simd::MulAdd(BB::Simd::SplatDouble4(row[3]), aMatrixTwo.row[3], sum);
+	}
+	return result;
+}
+
+inline Mat4x4d MulSub(const Mat4x4d& aMatrixOne, const Mat4x4d& aMatrixTwo, const Mat4x4d& aSubtrahend)
+{
+	Mat4x4d result;
+	for (int i = 0; i < MATRIX4X4_ROW_AMOUNT; ++i)
+	{
+		const double* row = aMatrixOne.data + i * 4;
+
+		BB::Simd::Double4 sum = BB::Simd::MulSub(BB::Simd::SplatDouble4(row[0]), aMatrixTwo.row[0], aSubtrahend.row[i]);
+		sum = BB::Simd::MulAdd(BB::Simd::SplatDouble4(row[1]), aMatrixTwo.row[1], sum);
+		sum = BB::Simd::MulAdd(BB::Simd::SplatDouble4(row[2]), aMatrixTwo.row[2], sum);
+		result.row[i] = BB::Simd::MulAdd(BB::Simd::SplatDouble4(row[3]), aMatrixTwo.row[3], sum);
+	}
+	return result;
+}
+
+inline Mat4x4d NegMulAdd(const Mat4x4d& aMatrixOne, const Mat4x4d& aMatrixTwo, const Mat4x4d& aAddend)
+{
+	Mat4x4d result;
+	for (int i = 0; i < MATRIX4X4_ROW_AMOUNT; ++i)
+	{
+		const double* row = aMatrixOne.data + i * 4;
+
+		BB::Simd::Double4 sum = BB::Simd::NegMulAdd(BB::Simd::SplatDouble4(row[0]), aMatrixTwo.row[0], aAddend.row[i]);
+		sum = BB::Simd::NegMulAdd(BB::Simd::SplatDouble4(row[1]), aMatrixTwo.row[1], sum);
+		sum = BB::Simd::NegMulAdd(BB::Simd::SplatDouble4(row[2]), aMatrixTwo.row[2], sum);
+		result.row[i] = BB::Simd::NegMulAdd(BB::Simd::SplatDouble4(row[3]), aMatrixTwo.row[3], sum);
+	}
+	return result;
+}
+
+inline Mat4x4d Lerp(const Mat4x4d& aFrom, const Mat4x4d& aTo, double aT)
+{
+	const BB::Simd::Double4 t = BB::Simd::SplatDouble4(aT);
+	return { BB::Simd::Lerp(aFrom.row[0], aTo.row[0], t),
+			 BB::Simd::Lerp(aFrom.row[1], aTo.row[1], t),
+			 BB::Simd::Lerp(aFrom.row[2], aTo.row[2], t),
+			 BB::Simd::Lerp(aFrom.row[3], aTo.row[3], t), };
+}
+
+#pragma endregion
@@ -1,6 +1,7 @@
 #pragma once
 #include <emmintrin.h>
 #include "../../Vector/Vector3f/Vector3f.h"
+#include "../../Util/Intrinsics.h"
 
 constexpr int MATRIX4X4_ROW_AMOUNT = 4;
 
@@ -18,17 +19,36 @@ public:
 				  p20, p21, p22, p23,
 				  p30, p31, p32, p33;
 		};
+		/// @brief Scalar view used by the constexpr code path.
+		BB::ScalarLanes<16> lanes;
 	};
 
-	Mat4x4f();
+/**
+* @name Compile-time evaluation
+* @brief The constructors, Transpose, Orthographic and the arithmetic operators are constexpr.
+*
+* @details During constant evaluation they work on {@code lanes} with plain float math, at runtime
+* they take the SSE path as before. This allows constant matrices to be baked into the binary:
+* @code
+* constexpr Mat4x4f projection = Mat4x4f::Orthographic(1920.0f, 1080.0f, 0.0f, 1.0f);
+* @endcode
+* @{
+*/
+	constexpr Mat4x4f();
 	Mat4x4f(const Mat4x4f& aMatrix) = default;
-	Mat4x4f(const Vec3f& aPosition);
+	constexpr Mat4x4f(const Vec3f& aPosition);
+/// @brief Initializes the matrix from its 16 elements in row-major order.
+	constexpr Mat4x4f(float aP00, float aP01, float aP02, float aP03,
+					  float aP10, float aP11, float aP12, float aP13,
+					  float aP20, float aP21, float aP22, float aP23,
+					  float aP30, float aP31, float aP32, float aP33);
+/** @} */
 	Mat4x4f(const __m128& aRowOne, const __m128& aRowTwo, const __m128& aRowThree, const __m128& aRowFour);
 	//Need to implement Quaternion class
 	//Mat4x4f(const Vec3f& aPosition, const Quat& aRotation, const Vec3f& aScale);
 	
-	inline void SetTranslation(float aX, float aY, float aZ);
-	inline void SetTranslation(const Vec3f& aPosition);
+	constexpr void SetTranslation(float aX, float aY, float aZ);
+	constexpr void SetTranslation(const Vec3f& aPosition);
 	//void SetRotation(const Mat3x3f& aRotationMatrix);
 	//void SetRotation(const Quat& aRotation);
 	inline void SetScale(const Vec3f& aScale);
@@ -46,30 +66,168 @@ public:
 	inline Mat4x4f GetRotationMatrix4x4();
 	//Mat3x3f GetRotationMatrix3x3();
 
-	inline Mat4x4f GetTransposed();
-	inline void Transpose();
+	constexpr Mat4x4f GetTransposed() const;
+	constexpr void Transpose();
 
 	inline Mat4x4f GetInverted();
 	inline void Invert();
 
+/**
+* @name Load and store
+* @brief Moving a Mat4x4f between registers and 16 plain floats in row-major order.
+* @{
+*/
+/// @brief Loads 16 floats, no alignment required.
+	static inline Mat4x4f LoadUnaligned(const float* aSource);
+/// @brief Loads 16 floats from a 16-byte aligned pointer.
+	static inline Mat4x4f LoadAligned(const float* aSource);
+/// @brief Writes the 16 elements, no alignment required.
+	inline void StoreUnaligned(float* aDestination) const;
+/// @brief Writes the 16 elements to a 16-byte aligned pointer.
+	inline void StoreAligned(float* aDestination) const;
+/**
+* @brief Writes the 16 elements to a 16-byte aligned pointer, bypassing the cache.
+*
+* @details Non-temporal stores are weakly ordered, call BB::Simd::StreamFence() before other
+* threads read the data.
+*/
+	inline void StoreStream(float* aDestination) const;
+/** @} */
+
+/**
+* @name Camera and projection
+* @brief Factories for view and projection matrices.
+*
+* @details All matrices follow the layout used by the rest of Mat4x4f: row vectors are
+* multiplied from the left (v * M) and the translation lives in row 3. The camera space is
+* left-handed (+Z forward, +Y up) and clip space depth is mapped to [0, 1].
+* @{
+*/
+
+/**
+* @brief Builds a perspective projection with depth 0 at the near plane and 1 at the far plane.
+*
+* @param aFovYRadians Vertical field of view in radians.
+* @param aAspectRatio Width divided by height of the view.
+* @param aNearPlane Distance to the near plane, must be larger than zero.
+* @param aFarPlane Distance to the far plane, must be larger than aNearPlane.
+*/
+	static inline Mat4x4f PerspectiveFov(float aFovYRadians, float aAspectRatio, float aNearPlane, float aFarPlane);
+/**
+* @brief Builds a reversed-Z perspective projection, depth 1 at the near plane and 0 at the far plane.
+*
+* @details Reversed-Z spreads the float precision evenly over the depth range and should be
+* used together with a GREATER depth test and a depth buffer cleared to 0.
+*/
+	static inline Mat4x4f PerspectiveFovReversedZ(float aFovYRadians, float aAspectRatio, float aNearPlane, float aFarPlane);
+/// @brief Builds a perspective projection with the far plane at infinity (depth 0 at the near plane).
+	static inline Mat4x4f PerspectiveFovInfinite(float aFovYRadians, float aAspectRatio, float aNearPlane);
+/// @brief Builds a reversed-Z perspective projection with the far plane at infinity (depth 1 at the near plane).
+	static inline Mat4x4f PerspectiveFovInfiniteReversedZ(float aFovYRadians, float aAspectRatio, float aNearPlane);
+/**
+* @brief Builds a centered orthographic projection.
+*
+* @param aWidth Width of the view volume.
+* @param aHeight Height of the view volume.
+* @param aNearPlane Depth mapped to 0.
+* @param aFarPlane Depth mapped to 1.
+*/
+	static constexpr Mat4x4f Orthographic(float aWidth, float aHeight, float aNearPlane, float aFarPlane);
+
+/**
+* @brief Builds a view matrix for a camera at aEye looking towards aTarget.
+*
+* @note aUp must not be parallel to the view direction.
+*/
+	static inline Mat4x4f LookAt(const Vec3f& aEye, const Vec3f& aTarget, const Vec3f& aUp);
+/**
+* @brief Builds a view matrix from the world transform of a camera.
+*
+* @details The transform is inverted as a rigid transform (transposed rotation and rotated,
+* negated translation), which is much cheaper than a general inverse.
+*
+* @note The rotation part of aTransform must be orthonormal (no scale or shear).
+*/
+	static inline Mat4x4f ViewFromTransform(const Mat4x4f& aTransform);
+/**
+* @brief Combines a view and a projection matrix, the same as aView * aProjection.
+*
+* @details Only the six entries a PerspectiveFov or Orthographic matrix can have set are read, which
+* takes two multiplies and one add per row instead of a full 4x4 multiply.
+*
+* @note aProjection must be a matrix built by one of the PerspectiveFov or Orthographic factories.
+*/
+	static inline Mat4x4f ViewProjection(const Mat4x4f& aView, const Mat4x4f& aProjection);
+
+/**
+* @brief Returns the inverse of a matrix built by one of the PerspectiveFov factories.
+*
+* @details Works for the standard, reversed-Z and infinite variants. The result is undefined for any other matrix.
+*/
+	inline Mat4x4f GetInvertedPerspective() const;
+/**
+* @brief Returns the inverse of a matrix built by Orthographic.
+*
+* @details The result is undefined for any other matrix.
+*/
+	inline Mat4x4f GetInvertedOrthographic() const;
+/** @} */
 
 private:
+	static inline Mat4x4f PerspectiveFromDepth(float aFovYRadians, float aAspectRatio, float aDepthScale, float aDepthOffset);
+	static inline Mat4x4f ViewFromBasis(const Vec3f& aRight, const Vec3f& aUp, const Vec3f& aForward, const Vec3f& aPosition);
 };
 
-inline bool operator==(const Mat4x4f& aMatrixOne, const Mat4x4f& aMatrixTwo);
-inline bool operator!=(const Mat4x4f& aMatrixOne, const Mat4x4f& aMatrixTwo);
-
-inline Mat4x4f operator+(const Mat4x4f& __restrict aMatrixOne, const Mat4x4f& __restrict aMatrixTwo);
-inline Mat4x4f operator-(const Mat4x4f& __restrict aMatrixOne, const Mat4x4f& __restrict aMatrixTwo);
-
-
-inline Mat4x4f operator*(const Mat4x4f& aMatrixOne, Mat4x4f aMatrixTwo);
-inline Mat4x4f operator*(const Mat4x4f& aMatrixOne, float aScalar);  
-inline Mat4x4f operator*(float aScalar, const Mat4x4f& aMatrixOne); 
-
-inline Mat4x4f operator/(const Mat4x4f& aMatrixOne, float aScalar);  
-
-inline void operator+=(Mat4x4f& __restrict aMatrixOne, const Mat4x4f& __restrict aMatrixTwo);
-inline void operator-=(Mat4x4f& __restrict aMatrixOne, const Mat4x4f& __restrict aMatrixTwo);
+constexpr bool operator==(const Mat4x4f& aMatrixOne, const Mat4x4f& aMatrixTwo);
+constexpr bool operator!=(const Mat4x4f& aMatrixOne, const Mat4x4f& aMatrixTwo);
+
+constexpr Mat4x4f operator+(const Mat4x4f& __restrict aMatrixOne, const Mat4x4f& __restrict aMatrixTwo);
+constexpr Mat4x4f operator-(const Mat4x4f& __restrict aMatrixOne, const Mat4x4f& __restrict aMatrixTwo);
+
+
+/**
+* @brief Multiplies two matrices, aOutResult = aMatrixOne * aMatrixTwo.
+*
+* @details Each result row is built by broadcasting the elements of a row of aMatrixOne and
+* multiply-adding them with the rows of aMatrixTwo, so no transpose or temporary matrix is needed.
+* The rows of aMatrixTwo are held in registers, which makes it safe for aOutResult to alias either operand.
+*/
+constexpr void Multiply(const Mat4x4f& aMatrixOne, const Mat4x4f& aMatrixTwo, Mat4x4f& aOutResult);
+
+constexpr Mat4x4f operator*(const Mat4x4f& aMatrixOne, const Mat4x4f& aMatrixTwo);
+constexpr Mat4x4f operator*(const Mat4x4f& aMatrixOne, float aScalar);  
+constexpr Mat4x4f operator*(float aScalar, const Mat4x4f& aMatrixOne); 
+
+constexpr Mat4x4f operator/(const Mat4x4f& aMatrixOne, float aScalar);  
+
+constexpr void operator+=(Mat4x4f& __restrict aMatrixOne, const Mat4x4f& __restrict aMatrixTwo);
+constexpr void operator-=(Mat4x4f& __restrict aMatrixOne, const Mat4x4f& __restrict aMatrixTwo);
+/// @brief Multiplies aMatrixOne by aMatrixTwo in place, aMatrixOne = aMatrixOne * aMatrixTwo.
+constexpr void operator*=(Mat4x4f& aMatrixOne, const Mat4x4f& aMatrixTwo);
+
+/**
+* @name Fused arithmetic
+* @brief Multiply-add style functions for Mat4x4f.
+*
+* @details MulAdd, MulSub and NegMulAdd use the matrix product and start each result row from the
+* row of the third operand, so the add costs nothing extra. With BB_USE_FMA defined every step is a
+* single FMA3 instruction.
+* @{
+*/
+/// @brief Computes (aMatrixOne * aMatrixTwo) + aAddend, where * is the matrix product.
+inline Mat4x4f MulAdd(const Mat4x4f& aMatrixOne, const Mat4x4f& aMatrixTwo, const Mat4x4f& aAddend);
+/// @brief Computes (aMatrixOne * aMatrixTwo) - aSubtrahend, where * is the matrix product.
+inline Mat4x4f MulSub(const Mat4x4f& aMatrixOne, const Mat4x4f& aMatrixTwo, const Mat4x4f& aSubtrahend);
+/// @brief Computes aAddend - (aMatrixOne * aMatrixTwo), where * is the matrix product.
+inline Mat4x4f NegMulAdd(const Mat4x4f& aMatrixOne, const Mat4x4f& aMatrixTwo, const Mat4x4f& aAddend);
+/// @brief Element-wise linear interpolation, returns aFrom for aT = 0 and aTo for aT = 1.
+inline Mat4x4f Lerp(const Mat4x4f& aFrom, const Mat4x4f& aTo, float aT);
+/** @} */
 
 #include "Matrix4x4f.inl"
+
+namespace BitBloom
+{
+/// @brief Compile-time identity matrix, built through the constexpr constructor.
+	inline constexpr Mat4x4f MAT4X4F_IDENTITY = Mat4x4f();
+}
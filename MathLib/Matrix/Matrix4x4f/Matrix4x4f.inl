@@ -1,20 +1,39 @@
 #pragma once
 #include "Matrix4x4f.h"
+#include <cmath>
+
 #pragma region Constructors
-inline Mat4x4f::Mat4x4f()
+constexpr Mat4x4f::Mat4x4f() : Mat4x4f(1, 0, 0, 0,
+									   0, 1, 0, 0,
+									   0, 0, 1, 0,
+									   0, 0, 0, 1)
 {
-	row[0] = _mm_set_ps(0, 0, 0, 1);
-	row[1] = _mm_set_ps(0, 0, 1, 0);
-	row[2] = _mm_set_ps(0, 1, 0, 0);
-	row[3] = _mm_set_ps(1, 0, 0, 0);
 }
 
-inline Mat4x4f::Mat4x4f(const Vec3f& aPosition)
+constexpr Mat4x4f::Mat4x4f(const Vec3f& aPosition) : Mat4x4f()
 {
-	row[0] = _mm_set_ps(0, 0, 0, 1);
-	row[1] = _mm_set_ps(0, 0, 1, 0);
-	row[2] = _mm_set_ps(0, 1, 0, 0);
-	row[3] = _mm_set_ps(1, aPosition.z, aPosition.y, aPosition.x);
+	SetTranslation(aPosition);
+}
+
+constexpr Mat4x4f::Mat4x4f(float aP00, float aP01, float aP02, float aP03,
+						   float aP10, float aP11, float aP12, float aP13,
+						   float aP20, float aP21, float aP22, float aP23,
+						   float aP30, float aP31, float aP32, float aP33)
+{
+	if (std::is_constant_evaluated())
+	{
+		lanes = BB::ScalarLanes<16>{ { aP00, aP01, aP02, aP03,
+									   aP10, aP11, aP12, aP13,
+									   aP20, aP21, aP22, aP23,
+									   aP30, aP31, aP32, aP33 } };
+	}
+	else
+	{
+		row[0] = _mm_set_ps(aP03, aP02, aP01, aP00);
+		row[1] = _mm_set_ps(aP13, aP12, aP11, aP10);
+		row[2] = _mm_set_ps(aP23, aP22, aP21, aP20);
+		row[3] = _mm_set_ps(aP33, aP32, aP31, aP30);
+	}
 }
 
 inline Mat4x4f::Mat4x4f(const __m128& aRowOne, const __m128& aRowTwo, const __m128& aRowThree, const __m128& aRowFour)
@@ -25,15 +44,27 @@ inline Mat4x4f::Mat4x4f(const __m128& aRowOne, const __m128& aRowTwo, const __m1
 	row[3] = aRowFour;
 }
 
-inline void Mat4x4f::SetTranslation(float aX, float aY, float aZ)
+constexpr void Mat4x4f::SetTranslation(float aX, float aY, float aZ)
 {
+	if (std::is_constant_evaluated())
+	{
+		lanes.value[12] = aX;
+		lanes.value[13] = aY;
+		lanes.value[14] = aZ;
+		return;
+	}
 	p30 = aX;
 	p31 = aY;
 	p32 = aZ;
 }
 
-inline void Mat4x4f::SetTranslation(const Vec3f & aPosition)
+constexpr void Mat4x4f::SetTranslation(const Vec3f & aPosition)
 {
+	if (std::is_constant_evaluated())
+	{
+		SetTranslation(aPosition.lanes.value[0], aPosition.lanes.value[1], aPosition.lanes.value[2]);
+		return;
+	}
 	p30 = aPosition.x;
 	p31 = aPosition.y;
 	p32 = aPosition.z;
@@ -43,25 +74,201 @@ inline void Mat4x4f::SetTranslation(const Vec3f & aPosition)
 
 #pragma region ClassFunctions
 
-inline Mat4x4f Mat4x4f::GetTransposed()
+constexpr Mat4x4f Mat4x4f::GetTransposed() const
 {
 	Mat4x4f result = *this;
-	_MM_TRANSPOSE4_PS(result.row[0], result.row[1], result.row[2], result.row[3]);
+	result.Transpose();
 	return result; 
 }
 
-inline void Mat4x4f::Transpose()
+constexpr void Mat4x4f::Transpose()
 {
+	if (std::is_constant_evaluated())
+	{
+		BB::ScalarLanes<16> transposed = {};
+		for (int i = 0; i < 16; i++)
+		{
+			transposed.value[i] = lanes.value[(i % 4) * 4 + i / 4];
+		}
+		lanes = transposed;
+		return;
+	}
 	_MM_TRANSPOSE4_PS(row[0], row[1], row[2], row[3]);
 }
 
+inline Mat4x4f Mat4x4f::LoadUnaligned(const float* aSource)
+{
+	return { _mm_loadu_ps(aSource), _mm_loadu_ps(aSource + 4), _mm_loadu_ps(aSource + 8), _mm_loadu_ps(aSource + 12) };
+}
+
+inline Mat4x4f Mat4x4f::LoadAligned(const float* aSource)
+{
+	return { _mm_load_ps(aSource), _mm_load_ps(aSource + 4), _mm_load_ps(aSource + 8), _mm_load_ps(aSource + 12) };
+}
+
+inline void Mat4x4f::StoreUnaligned(float* aDestination) const
+{
+	for (int i = 0; i < MATRIX4X4_ROW_AMOUNT; i++)
+	{
+		_mm_storeu_ps(aDestination + i * 4, row[i]);
+	}
+}
+
+inline void Mat4x4f::StoreAligned(float* aDestination) const
+{
+	for (int i = 0; i < MATRIX4X4_ROW_AMOUNT; i++)
+	{
+		_mm_store_ps(aDestination + i * 4, row[i]);
+	}
+}
+
+inline void Mat4x4f::StoreStream(float* aDestination) const
+{
+	for (int i = 0; i < MATRIX4X4_ROW_AMOUNT; i++)
+	{
+		_mm_stream_ps(aDestination + i * 4, row[i]);
+	}
+}
+
+#pragma endregion
+
+#pragma region Camera
+
+inline Mat4x4f Mat4x4f::PerspectiveFov(float aFovYRadians, float aAspectRatio, float aNearPlane, float aFarPlane)
+{
+	const float depthScale = aFarPlane / (aFarPlane - aNearPlane);
+	return PerspectiveFromDepth(aFovYRadians, aAspectRatio, depthScale, -aNearPlane * depthScale);
+}
+
+inline Mat4x4f Mat4x4f::PerspectiveFovReversedZ(float aFovYRadians, float aAspectRatio, float aNearPlane, float aFarPlane)
+{
+	const float depthScale = aNearPlane / (aNearPlane - aFarPlane);
+	return PerspectiveFromDepth(aFovYRadians, aAspectRatio, depthScale, -aFarPlane * depthScale);
+}
+
+inline Mat4x4f Mat4x4f::PerspectiveFovInfinite(float aFovYRadians, float aAspectRatio, float aNearPlane)
+{
+	return PerspectiveFromDepth(aFovYRadians, aAspectRatio, 1.0f, -aNearPlane);
+}
+
+inline Mat4x4f Mat4x4f::PerspectiveFovInfiniteReversedZ(float aFovYRadians, float aAspectRatio, float aNearPlane)
+{
+	return PerspectiveFromDepth(aFovYRadians, aAspectRatio, 0.0f, aNearPlane);
+}
+
+constexpr Mat4x4f Mat4x4f::Orthographic(float aWidth, float aHeight, float aNearPlane, float aFarPlane)
+{
+	const float depthScale = 1.0f / (aFarPlane - aNearPlane);
+	return Mat4x4f(2.0f / aWidth, 0, 0, 0,
+				   0, 2.0f / aHeight, 0, 0,
+				   0, 0, depthScale, 0,
+				   0, 0, -aNearPlane * depthScale, 1);
+}
+
+inline Mat4x4f Mat4x4f::LookAt(const Vec3f& aEye, const Vec3f& aTarget, const Vec3f& aUp)
+{
+	Vec3f forward = (aTarget - aEye).GetNormalized();
+	Vec3f right = Vec3f(aUp).Cross(forward).GetNormalized();
+	Vec3f up = forward.Cross(right);
+
+	return ViewFromBasis(right, up, forward, aEye);
+}
+
+inline Mat4x4f Mat4x4f::ViewFromTransform(const Mat4x4f& aTransform)
+{
+	// The w column of an affine transform is (0, 0, 0, 1), mask it away so the basis rows stay directions
+	const __m128 xyzMask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+	return ViewFromBasis(_mm_and_ps(aTransform.row[0], xyzMask),
+						 _mm_and_ps(aTransform.row[1], xyzMask),
+						 _mm_and_ps(aTransform.row[2], xyzMask),
+						 _mm_and_ps(aTransform.row[3], xyzMask));
+}
+
+inline Mat4x4f Mat4x4f::ViewProjection(const Mat4x4f& aView, const Mat4x4f& aProjection)
+{
+	// A projection only has p00, p11, p22, p23, p32 and p33 set, so every row of the product is
+	// (v0 * p00, v1 * p11, v2 * p22 + v3 * p32, v2 * p23 + v3 * p33)
+	const __m128 diagonal = _mm_set_ps(aProjection.p33, aProjection.p22, aProjection.p11, aProjection.p00);
+	const __m128 crossed = _mm_set_ps(aProjection.p23, aProjection.p32, 0, 0);
+
+	Mat4x4f result;
+	for (int i = 0; i < MATRIX4X4_ROW_AMOUNT; i++)
+	{
+		const __m128 swappedZW = _mm_shuffle_ps(aView.row[i], aView.row[i], _MM_SHUFFLE(2, 3, 1, 0));
+		result.row[i] = _mm_add_ps(_mm_mul_ps(aView.row[i], diagonal), _mm_mul_ps(swappedZW, crossed));
+	}
+	return result;
+}
+
+inline Mat4x4f Mat4x4f::GetInvertedPerspective() const
+{
+	// (1 / p00, 1 / p11, 1 / p32, 1 / p32)
+	const __m128 reciprocal = _mm_div_ps(_mm_set1_ps(1.0f), _mm_set_ps(p32, p32, p11, p00));
+	const __m128 zero = _mm_setzero_ps();
+
+	return { _mm_move_ss(zero, reciprocal),
+			 _mm_and_ps(reciprocal, _mm_castsi128_ps(_mm_set_epi32(0, 0, -1, 0))),
+			 _mm_and_ps(reciprocal, _mm_castsi128_ps(_mm_set_epi32(-1, 0, 0, 0))),
+			 _mm_set_ps(-p22 / p32, 1.0f, 0, 0) };
+}
+
+inline Mat4x4f Mat4x4f::GetInvertedOrthographic() const
+{
+	// (1 / p00, 1 / p11, 1 / p22, 1)
+	const __m128 reciprocal = _mm_div_ps(_mm_set1_ps(1.0f), _mm_set_ps(1.0f, p22, p11, p00));
+	const __m128 zero = _mm_setzero_ps();
+
+	return { _mm_move_ss(zero, reciprocal),
+			 _mm_and_ps(reciprocal, _mm_castsi128_ps(_mm_set_epi32(0, 0, -1, 0))),
+			 _mm_and_ps(reciprocal, _mm_castsi128_ps(_mm_set_epi32(0, -1, 0, 0))),
+			 _mm_set_ps(1.0f, -p32 / p22, 0, 0) };
+}
+
+inline Mat4x4f Mat4x4f::PerspectiveFromDepth(float aFovYRadians, float aAspectRatio, float aDepthScale, float aDepthOffset)
+{
+	const float yScale = 1.0f / std::tan(aFovYRadians * 0.5f);
+	const float xScale = yScale / aAspectRatio;
+
+	return { _mm_set_ps(0, 0, 0, xScale),
+			 _mm_set_ps(0, 0, yScale, 0),
+			 _mm_set_ps(1, aDepthScale, 0, 0),
+			 _mm_set_ps(0, aDepthOffset, 0, 0) };
+}
+
+inline Mat4x4f Mat4x4f::ViewFromBasis(const Vec3f& aRight, const Vec3f& aUp, const Vec3f& aForward, const Vec3f& aPosition)
+{
+	Mat4x4f result(aRight.data, aUp.data, aForward.data, _mm_setzero_ps());
+	result.Transpose();
+
+	// Translation is -(position * rotation^T), w is set to 1 afterwards
+	__m128 translation = _mm_mul_ps(_mm_shuffle_ps(aPosition.data, aPosition.data, _MM_SHUFFLE(0, 0, 0, 0)), result.row[0]);
+	translation = _mm_add_ps(translation, _mm_mul_ps(_mm_shuffle_ps(aPosition.data, aPosition.data, _MM_SHUFFLE(1, 1, 1, 1)), result.row[1]));
+	translation = _mm_add_ps(translation, _mm_mul_ps(_mm_shuffle_ps(aPosition.data, aPosition.data, _MM_SHUFFLE(2, 2, 2, 2)), result.row[2]));
+	result.row[3] = _mm_sub_ps(_mm_set_ps(1, 0, 0, 0), translation);
+
+	return result;
+}
+
 #pragma endregion
 
 
 #pragma region OperatorDefinitions
 
-inline bool operator==(const Mat4x4f& aMatrixOne, const Mat4x4f& aMatrixTwo)
+// The operators below take a scalar loop over Mat4x4f::lanes during constant evaluation.
+
+constexpr bool operator==(const Mat4x4f& aMatrixOne, const Mat4x4f& aMatrixTwo)
 {
+	if (std::is_constant_evaluated())
+	{
+		for (int i = 0; i < 16; i++)
+		{
+			if (aMatrixOne.lanes.value[i] != aMatrixTwo.lanes.value[i])
+			{
+				return false;
+			}
+		}
+		return true;
+	}
 	int result = 0xF;
 	for (int i = 0; i < MATRIX4X4_ROW_AMOUNT; i++)
 	{
@@ -70,8 +277,12 @@ inline bool operator==(const Mat4x4f& aMatrixOne, const Mat4x4f& aMatrixTwo)
 	return result == 0xF;
 }
 
-inline bool operator!=(const Mat4x4f& aMatrixOne, const Mat4x4f& aMatrixTwo)
+constexpr bool operator!=(const Mat4x4f& aMatrixOne, const Mat4x4f& aMatrixTwo)
 {
+	if (std::is_constant_evaluated())
+	{
+		return !(aMatrixOne == aMatrixTwo);
+	}
 	int result = 0xF;
 	for (int i = 0; i < MATRIX4X4_ROW_AMOUNT; i++)
 	{
@@ -80,50 +291,93 @@ inline bool operator!=(const Mat4x4f& aMatrixOne, const Mat4x4f& aMatrixTwo)
 	return result != 0xF;
 }
 
-inline Mat4x4f operator+(const Mat4x4f& __restrict aMatrixOne, const Mat4x4f& __restrict aMatrixTwo)
+constexpr Mat4x4f operator+(const Mat4x4f& __restrict aMatrixOne, const Mat4x4f& __restrict aMatrixTwo)
 {
+	if (std::is_constant_evaluated())
+	{
+		Mat4x4f result;
+		for (int i = 0; i < 16; i++)
+		{
+			result.lanes.value[i] = aMatrixOne.lanes.value[i] + aMatrixTwo.lanes.value[i];
+		}
+		return result;
+	}
 	return { _mm_add_ps(aMatrixOne.row[0], aMatrixTwo.row[0]),
 			 _mm_add_ps(aMatrixOne.row[1], aMatrixTwo.row[1]),
 			 _mm_add_ps(aMatrixOne.row[2], aMatrixTwo.row[2]),
 			 _mm_add_ps(aMatrixOne.row[3], aMatrixTwo.row[3]), };
 }
 
-inline Mat4x4f operator-(const Mat4x4f& __restrict aMatrixOne, const Mat4x4f& __restrict aMatrixTwo)
+constexpr Mat4x4f operator-(const Mat4x4f& __restrict aMatrixOne, const Mat4x4f& __restrict aMatrixTwo)
 {
+	if (std::is_constant_evaluated())
+	{
+		Mat4x4f result;
+		for (int i = 0; i < 16; i++)
+		{
+			result.lanes.value[i] = aMatrixOne.lanes.value[i] - aMatrixTwo.lanes.value[i];
+		}
+		return result;
+	}
 	return { _mm_sub_ps(aMatrixOne.row[0], aMatrixTwo.row[0]),
 			 _mm_sub_ps(aMatrixOne.row[1], aMatrixTwo.row[1]),
 			 _mm_sub_ps(aMatrixOne.row[2], aMatrixTwo.row[2]),
 			 _mm_sub_ps(aMatrixOne.row[3], aMatrixTwo.row[3]), };
 }
 
-inline Mat4x4f operator*(const Mat4x4f& aMatrixOne, Mat4x4f aMatrixTwo)
+constexpr void Multiply(const Mat4x4f& aMatrixOne, const Mat4x4f& aMatrixTwo, Mat4x4f& aOutResult)
 {
-	Mat4x4f result; 
+	if (std::is_constant_evaluated())
+	{
+		// Accumulates into a temporary so aOutResult may alias either operand here as well
+		BB::ScalarLanes<16> result = {};
+		for (int i = 0; i < 16; i++)
+		{
+			const int rowStart = (i / 4) * 4;
+			const int column = i % 4;
+			for (int k = 0; k < 4; k++)
+			{
+				result.value[i] += aMatrixOne.lanes.value[rowStart + k] * aMatrixTwo.lanes.value[k * 4 + column];
+			}
+		}
+		aOutResult.lanes = result;
+		return;
+	}
 
-	aMatrixTwo.Transpose();
+	const __m128 rowZero = aMatrixTwo.row[0];
+	const __m128 rowOne = aMatrixTwo.row[1];
+	const __m128 rowTwo = aMatrixTwo.row[2];
+	const __m128 rowThree = aMatrixTwo.row[3];
 
-	for (int i = 0; i < 4; ++i)
+	for (int i = 0; i < MATRIX4X4_ROW_AMOUNT; ++i)
 	{
-		// Broadcast each element of the row
-	/*	__m128 e0 = _mm_shuffle_ps(aMatrixOne.row[i], aMatrixOne.row[i], _MM_SHUFFLE(0, 0, 0, 0));
-		__m128 e1 = _mm_shuffle_ps(aMatrixOne.row[i], aMatrixOne.row[i], _MM_SHUFFLE(1, 1, 1, 1));
-		__m128 e2 = _mm_shuffle_ps(aMatrixOne.row[i], aMatrixOne.row[i], _MM_SHUFFLE(2, 2, 2, 2));
-		__m128 e3 = _mm_shuffle_ps(aMatrixOne.row[i], aMatrixOne.row[i], _MM_SHUFFLE(3, 3, 3, 3));*/
-
-		// Multiply each with corresponding column vector and sum
-		__m128 mul0 = _mm_mul_ps(_mm_shuffle_ps(aMatrixOne.row[i], aMatrixOne.row[i], _MM_SHUFFLE(0, 0, 0, 0)), aMatrixTwo.row[0]);
-		__m128 mul1 = _mm_mul_ps(_mm_shuffle_ps(aMatrixOne.row[i], aMatrixOne.row[i], _MM_SHUFFLE(1, 1, 1, 1)), aMatrixTwo.row[1]);
-		__m128 mul2 = _mm_mul_ps(_mm_shuffle_ps(aMatrixOne.row[i], aMatrixOne.row[i], _MM_SHUFFLE(2, 2, 2, 2)), aMatrixTwo.row[2]);
-		__m128 mul3 = _mm_mul_ps(_mm_shuffle_ps(aMatrixOne.row[i], aMatrixOne.row[i], _MM_SHUFFLE(3, 3, 3, 3)), aMatrixTwo.row[3]);
+		const __m128 row = aMatrixOne.row[i];
 
-		result.row[i] = _mm_add_ps(_mm_add_ps(mul0, mul1), _mm_add_ps(mul2, mul3));
+		__m128 result = _mm_mul_ps(BB::Simd::Splat<0>(row), rowZero);
+		result = BB::Simd::MulAdd(BB::Simd::Splat<1>(row), rowOne, result);
+		result = BB::Simd::MulAdd(BB::Simd::Splat<2>(row), rowTwo, result);
+		aOutResult.row[i] = BB::Simd::MulAdd(BB::Simd::Splat<3>(row), rowThree, result);
 	}
+}
 
+constexpr Mat4x4f operator*(const Mat4x4f& aMatrixOne, const Mat4x4f& aMatrixTwo)
+{
+	Mat4x4f result;
+	Multiply(aMatrixOne, aMatrixTwo, result);
 	return result;
 }
 
-inline Mat4x4f operator*(const Mat4x4f& aMatrixOne, float aScalar)
+constexpr Mat4x4f operator*(const Mat4x4f& aMatrixOne, float aScalar)
 {
+	if (std::is_constant_evaluated())
+	{
+		Mat4x4f result;
+		for (int i = 0; i < 16; i++)
+		{
+			result.lanes.value[i] = aMatrixOne.lanes.value[i] * aScalar;
+		}
+		return result;
+	}
 	__m128 scalar = _mm_set1_ps(aScalar);
 	return { _mm_mul_ps(aMatrixOne.row[0], scalar), 
 			 _mm_mul_ps(aMatrixOne.row[1], scalar), 
@@ -131,17 +385,22 @@ inline Mat4x4f operator*(const Mat4x4f& aMatrixOne, float aScalar)
 			 _mm_mul_ps(aMatrixOne.row[3], scalar), };
 }
 
-inline Mat4x4f operator*(float aScalar, const Mat4x4f& aMatrixOne)
+constexpr Mat4x4f operator*(float aScalar, const Mat4x4f& aMatrixOne)
 {
-	__m128 scalar = _mm_set1_ps(aScalar);
-	return { _mm_mul_ps(aMatrixOne.row[0], scalar),
-			 _mm_mul_ps(aMatrixOne.row[1], scalar),
-			 _mm_mul_ps(aMatrixOne.row[2], scalar),
-			 _mm_mul_ps(aMatrixOne.row[3], scalar), };
+	return aMatrixOne * aScalar;
 }
 
-inline Mat4x4f operator/(const Mat4x4f& aMatrixOne, float aScalar)
+constexpr Mat4x4f operator/(const Mat4x4f& aMatrixOne, float aScalar)
 {
+	if (std::is_constant_evaluated())
+	{
+		Mat4x4f result;
+		for (int i = 0; i < 16; i++)
+		{
+			result.lanes.value[i] = aMatrixOne.lanes.value[i] / aScalar;
+		}
+		return result;
+	}
 	__m128 scalar = _mm_set1_ps(aScalar);
 	return { _mm_div_ps(aMatrixOne.row[0], scalar),
 			 _mm_div_ps(aMatrixOne.row[1], scalar),
@@ -149,22 +408,95 @@ inline Mat4x4f operator/(const Mat4x4f& aMatrixOne, float aScalar)
 			 _mm_div_ps(aMatrixOne.row[3], scalar), };
 }
 
-inline void operator+=(Mat4x4f& __restrict aMatrixOne, const Mat4x4f& __restrict aMatrixTwo)
+constexpr void operator+=(Mat4x4f& __restrict aMatrixOne, const Mat4x4f& __restrict aMatrixTwo)
 {
+	if (std::is_constant_evaluated())
+	{
+		aMatrixOne = aMatrixOne + aMatrixTwo;
+		return;
+	}
 	for (int i = 0; i < MATRIX4X4_ROW_AMOUNT; i++)
 	{
 		aMatrixOne.row[i] = _mm_add_ps(aMatrixOne.row[i], aMatrixTwo.row[i]);
 	}
 }
 
-inline void operator-=(Mat4x4f& __restrict aMatrixOne, const Mat4x4f& __restrict aMatrixTwo)
+constexpr void operator-=(Mat4x4f& __restrict aMatrixOne, const Mat4x4f& __restrict aMatrixTwo)
 {
+	if (std::is_constant_evaluated())
+	{
+		aMatrixOne = aMatrixOne - aMatrixTwo;
+		return;
+	}
 	for (int i = 0; i < MATRIX4X4_ROW_AMOUNT; i++)
 	{
 		aMatrixOne.row[i] = _mm_sub_ps(aMatrixOne.row[i], aMatrixTwo.row[i]);
 	}
 }
 
+constexpr void operator*=(Mat4x4f& aMatrixOne, const Mat4x4f& aMatrixTwo)
+{
+	Multiply(aMatrixOne, aMatrixTwo, aMatrixOne);
+}
+
+#pragma endregion
+
+#pragma region FusedArithmetic
+
+inline Mat4x4f MulAdd(const Mat4x4f& aMatrixOne, const Mat4x4f& aMatrixTwo, const Mat4x4f& aAddend)
+{
+	Mat4x4f result;
+	for (int i = 0; i < MATRIX4X4_ROW_AMOUNT; ++i)
+	{
+		const __m128 row = aMatrixOne.row[i];
+
+		__m128 sum = BB::Simd::MulAdd(BB::Simd::Splat<0>(row), aMatrixTwo.row[0], aAddend.row[i]);
+		sum = BB::Simd::MulAdd(BB::Simd::Splat<1>(row), aMatrixTwo.row[1], sum);
+		sum = BB::Simd::MulAdd(BB::Simd::Splat<2>(row), aMatrixTwo.row[2], sum);
+		result.row[i] = BB::Simd::MulAdd(BB::Simd::Splat<3>(row), aMatrixTwo.row[3], sum);
+	}
+	return result;
+}
+
+inline Mat4x4f MulSub(const Mat4x4f& aMatrixOne, const Mat4x4f& aMatrixTwo, const Mat4x4f& aSubtrahend)
+{
+	Mat4x4f result;
+	for (int i = 0; i < MATRIX4X4_ROW_AMOUNT; ++i)
+	{
+		const __m128 row = aMatrixOne.row[i];
+
+		__m128 sum = BB::Simd::MulSub(BB::Simd::Splat<0>(row), aMatrixTwo.row[0], aSubtrahend.row[i]);
+		sum = BB::Simd::MulAdd(BB::Simd::Splat<1>(row), aMatrixTwo.row[1], sum);
+		sum = BB::Simd::MulAdd(BB::Simd::Splat<2>(row), aMatrixTwo.row[2], sum);
+		result.row[i] = BB::Simd::MulAdd(BB::Simd::Splat<3>(row), aMatrixTwo.row[3], sum);
+	}
+	return result;
+}
+
+inline Mat4x4f NegMulAdd(const Mat4x4f& aMatrixOne, const Mat4x4f& aMatrixTwo, const Mat4x4f& aAddend)
+{
+	Mat4x4f result;
+	for (int i = 0; i < MATRIX4X4_ROW_AMOUNT; ++i)
+	{
+		const __m128 row = aMatrixOne.row[i];
+
+		__m128 sum = BB::Simd::NegMulAdd(BB::Simd::Splat<0>(row), aMatrixTwo.row[0], aAddend.row[i]);
+		sum = BB::Simd::NegMulAdd(BB::Simd::Splat<1>(row), aMatrixTwo.row[1], sum);
+		sum = BB::Simd::NegMulAdd(BB::Simd::Splat<2>(row), aMatrixTwo.row[2], sum);
+		result.row[i] = BB::Simd::NegMulAdd(BB::Simd::Splat<3>(row), aMatrixTwo.row[3], sum);
+	}
+	return result;
+}
+
+inline Mat4x4f Lerp(const Mat4x4f& aFrom, const Mat4x4f& aTo, float aT)
+{
+	const __m128 t = _mm_set1_ps(aT);
+	return { BB::Simd::Lerp(aFrom.row[0], aTo.row[0], t),
+			 BB::Simd::Lerp(aFrom.row[1], aTo.row[1], t),
+			 BB::Simd::Lerp(aFrom.row[2], aTo.row[2], t),
+			 BB::Simd::Lerp(aFrom.row[3], aTo.row[3], t), };
+}
+
 
 #pragma endregion
 
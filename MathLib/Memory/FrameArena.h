@@ -0,0 +1,73 @@
+#pragma once
+#include <cstddef>
+#include <type_traits>
+#include "AlignedAllocator.h"
+
+/**
+* @brief Bump allocator for temporary arrays that only live for one frame.
+*
+* @details The arena owns one cache line aligned block that is allocated once. Allocations move
+* an offset forward and Reset() moves it back to the start, both are O(1) and never call malloc,
+* which makes the arena suited for scratch Vec3f and Mat4x4f arrays inside hot loops.
+*
+* @code
+* BB::FrameArena arena(1 << 20);
+* while (running)
+* {
+*     Vec3f* positions = arena.Allocate<Vec3f>(count);   // 16-byte aligned
+*     Mat4x4f* worlds = arena.Allocate<Mat4x4f>(count);
+*     ...
+*     arena.Reset();
+* }
+* @endcode
+*
+* @warning Destructors are never run, only trivially destructible types can be allocated.
+* The arena is not thread safe, use one arena per thread.
+*/
+namespace BitBloom
+{
+	class FrameArena
+	{
+	public:
+/// @brief Allocates the backing block of aCapacity bytes.
+		inline explicit FrameArena(size_t aCapacity);
+		inline ~FrameArena();
+
+		FrameArena(const FrameArena&) = delete;
+		FrameArena& operator=(const FrameArena&) = delete;
+
+/**
+* @brief Returns aSize bytes aligned to aAlignment.
+*
+* @return nullptr (and an assert in debug) when the arena does not have enough space left.
+*/
+		inline void* AllocateBytes(size_t aSize, size_t aAlignment = SIMD_ALIGNMENT);
+
+/// @brief Allocates and default constructs aCount elements, aligned to at least 16 bytes.
+		template<class T>
+		inline T* Allocate(size_t aCount);
+
+/// @brief Allocates room for aCount elements without constructing them, for arrays that are written before read.
+		template<class T>
+		inline T* AllocateUninitialized(size_t aCount);
+
+/// @brief Releases every allocation at once.
+		inline void Reset();
+
+/// @brief Returns the current position, pass it to Rewind() to release everything allocated after it.
+		inline size_t GetMarker() const;
+		inline void Rewind(size_t aMarker);
+
+		inline size_t GetUsed() const;
+		inline size_t GetCapacity() const;
+
+	private:
+		char* myMemory;
+		size_t myCapacity;
+		size_t myOffset;
+	};
+}
+
+namespace BB = BitBloom;
+
+#include "FrameArena.inl"
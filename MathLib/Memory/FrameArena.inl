@@ -0,0 +1,86 @@
+#pragma once
+#include "FrameArena.h"
+#include <cassert>
+#include <cstdint>
+#include <new>
+
+namespace BitBloom
+{
+	inline FrameArena::FrameArena(size_t aCapacity)
+		: myMemory(static_cast<char*>(AlignedAlloc(aCapacity, CACHE_LINE_SIZE)))
+		, myCapacity(aCapacity)
+		, myOffset(0)
+	{
+	}
+
+	inline FrameArena::~FrameArena()
+	{
+		AlignedFree(myMemory, CACHE_LINE_SIZE);
+	}
+
+	inline void* FrameArena::AllocateBytes(size_t aSize, size_t aAlignment)
+	{
+		assert(aAlignment != 0 && (aAlignment & (aAlignment - 1)) == 0 && "Alignment has to be a power of two");
+
+		const uintptr_t base = reinterpret_cast<uintptr_t>(myMemory);
+		const uintptr_t aligned = (base + myOffset + aAlignment - 1) & ~static_cast<uintptr_t>(aAlignment - 1);
+		const size_t start = static_cast<size_t>(aligned - base);
+
+		if (start > myCapacity || aSize > myCapacity - start)
+		{
+			assert(false && "FrameArena is out of memory");
+			return nullptr;
+		}
+
+		myOffset = start + aSize;
+		return myMemory + start;
+	}
+
+	template<class T>
+	inline T* FrameArena::Allocate(size_t aCount)
+	{
+		T* result = AllocateUninitialized<T>(aCount);
+		if (result != nullptr)
+		{
+			for (size_t i = 0; i < aCount; ++i)
+			{
+				new (result + i) T();
+			}
+		}
+		return result;
+	}
+
+	template<class T>
+	inline T* FrameArena::AllocateUninitialized(size_t aCount)
+	{
+		static_assert(std::is_trivially_destructible<T>::value, "FrameArena never runs destructors");
+		constexpr size_t alignment = alignof(T) > SIMD_ALIGNMENT ? alignof(T) : SIMD_ALIGNMENT;
+		return static_cast<T*>(AllocateBytes(aCount * sizeof(T), alignment));
+	}
+
+	inline void FrameArena::Reset()
+	{
+		myOffset = 0;
+	}
+
+	inline size_t FrameArena::GetMarker() const
+	{
+		return myOffset;
+	}
+
+	inline void FrameArena::Rewind(size_t aMarker)
+	{
+		assert(aMarker <= myOffset && "Marker is ahead of the arena");
+		myOffset = aMarker;
+	}
+
+	inline size_t FrameArena::GetUsed() const
+	{
+		return myOffset;
+	}
+
+	inline size_t FrameArena::GetCapacity() const
+	{
+		return myCapacity;
+	}
+}
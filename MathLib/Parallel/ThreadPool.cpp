@@ -0,0 +1,33 @@
+#include "pch.h"
+#include "ThreadPool.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace BitBloom
+{
+namespace Detail
+{
+	void PinCurrentThreadToCore(size_t aCore)
+	{
+		const size_t coreCount = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+		const size_t core = aCore % coreCount;
+#ifdef _WIN32
+		// Processor groups hold 64 logical cores each
+		GROUP_AFFINITY affinity = {};
+		affinity.Group = static_cast<WORD>(core / 64);
+		affinity.Mask = KAFFINITY(1) << (core % 64);
+		SetThreadGroupAffinity(GetCurrentThread(), &affinity, nullptr);
+#else
+		cpu_set_t set;
+		CPU_ZERO(&set);
+		CPU_SET(core, &set);
+		pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#endif
+	}
+} // namespace Detail
+} // namespace BitBloom
@@ -0,0 +1,146 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "../Memory/AlignedAllocator.h"
+
+/**
+ * @file ThreadPool.h
+ * @brief Work-stealing thread pool with a blocking ParallelFor for the array kernels.
+ *
+ * @details ParallelFor splits a range into chunks of aGrain elements and deals them out evenly,
+ * one contiguous block per thread, the calling thread included. Each thread takes chunks from the
+ * front of its own block and, once that is empty, steals from the back of the other blocks, so
+ * uneven chunks still finish together. Ranges of a single chunk, pools without workers and calls
+ * made from inside a ParallelFor run synchronously on the calling thread.
+ *
+ * The queues live on their own cache lines. ParallelForArray rounds the grain up to whole cache
+ * lines of elements, so with a cache line aligned array (BB::AlignedVector<T, 64>) two threads
+ * never write to the same line.
+ *
+ * @code
+ * BB::ThreadPool pool;
+ * pool.ParallelForArray<Vec3f>(count, 0, [&](size_t aBegin, size_t aEnd)
+ * {
+ *     BB::Bulk::TransformPoints(world, points + aBegin, outPoints + aBegin, aEnd - aBegin);
+ * });
+ * @endcode
+ *
+ * Bulk/BulkParallel.h has ready made overloads of the Bulk kernels that take a pool.
+ *
+ * @warning The function must not throw. One ParallelFor runs at a time per pool, calls from
+ * several outside threads are serialized.
+ */
+
+#ifndef BB_PARALLEL_GRAIN_BYTES
+#define BB_PARALLEL_GRAIN_BYTES (16u * 1024u)
+#endif
+
+namespace BitBloom
+{
+/// @brief hardware_concurrency() - 1, the calling thread is the last one. 0 on single core machines.
+	inline size_t GetDefaultWorkerCount()
+	{
+		const size_t hardware = std::thread::hardware_concurrency();
+		return hardware > 1 ? hardware - 1 : 0;
+	}
+
+	struct ThreadPoolSettings
+	{
+/// @brief Threads created besides the calling thread.
+		size_t workerCount = GetDefaultWorkerCount();
+/// @brief Pins worker i to logical core firstCore + i + 1, the calling thread is expected on firstCore.
+		bool pinThreads = false;
+/**
+* @brief First logical core of the pool when pinThreads is set.
+*
+* @details For NUMA machines create one pool per node with firstCore at the first core of the node
+* and workerCount + 1 equal to its core count, so each pool and its memory stay on one node.
+*/
+		size_t firstCore = 0;
+/// @brief Sets FTZ/DAZ on every worker (see Util/Denormals.h), the calling thread is left as is.
+		bool flushDenormals = false;
+	};
+
+	class ThreadPool
+	{
+	public:
+/// @brief Starts the workers, they sleep until the first ParallelFor.
+		inline explicit ThreadPool(const ThreadPoolSettings& aSettings = ThreadPoolSettings());
+/// @brief Wakes and joins all workers.
+		inline ~ThreadPool();
+
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+/**
+* @brief Calls aFunction(begin, end) for chunks of at most aGrain elements covering [aBegin, aEnd).
+*
+* @details Returns when every chunk is done. A grain of 0 is treated as 1.
+*/
+		template<class Function>
+		inline void ParallelFor(size_t aBegin, size_t aEnd, size_t aGrain, Function&& aFunction);
+
+/**
+* @brief ParallelFor over [0, aCount) of an array of T, with the grain rounded up to whole cache lines.
+*
+* @param aGrain Elements per chunk, 0 uses BB_PARALLEL_GRAIN_BYTES worth of elements.
+*/
+		template<class T, class Function>
+		inline void ParallelForArray(size_t aCount, size_t aGrain, Function&& aFunction);
+
+/// @brief Workers plus the calling thread.
+		inline size_t GetThreadCount() const;
+
+	private:
+		struct Job
+		{
+			void (*invoke)(void* aFunction, size_t aBegin, size_t aEnd);
+			void* function;
+			size_t begin;
+			size_t end;
+			size_t grain;
+		};
+
+/// @brief Chunk indices [front, back) of one thread packed in one word, front in the low 32 bits.
+		struct alignas(CACHE_LINE_SIZE) ChunkQueue
+		{
+			std::atomic<uint64_t> range;
+		};
+
+		inline void WorkerLoop(size_t aSlot, const ThreadPoolSettings& aSettings);
+		inline void RunChunks(size_t aSlot, const Job& aJob);
+		inline bool PopChunk(size_t aSlot, size_t& aOutChunk);
+		inline bool StealChunk(size_t aSlot, size_t& aOutChunk);
+
+		std::vector<std::thread> myWorkers;
+		std::unique_ptr<ChunkQueue[]> myQueues;
+		std::mutex myDispatchMutex;
+		std::mutex myMutex;
+		std::condition_variable myWake;
+		std::condition_variable myDone;
+		const Job* myJob;
+		uint64_t myGeneration;
+		size_t myActiveWorkers;
+		bool myStopping;
+	};
+
+namespace Detail
+{
+/// @brief Pins the calling thread to one logical core, defined in ThreadPool.cpp to keep the OS headers out.
+	void PinCurrentThreadToCore(size_t aCore);
+
+/// @brief Set while a thread runs ParallelFor chunks, nested calls then run synchronously.
+	inline thread_local bool globalInsideParallelFor = false;
+} // namespace Detail
+} // namespace BitBloom
+
+namespace BB = BitBloom;
+
+#include "ThreadPool.inl"
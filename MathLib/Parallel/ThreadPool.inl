@@ -0,0 +1,216 @@
+#pragma once
+#include "ThreadPool.h"
+#include <algorithm>
+#include <utility>
+#include "../Util/Denormals.h"
+
+namespace BitBloom
+{
+	inline ThreadPool::ThreadPool(const ThreadPoolSettings& aSettings)
+		: myQueues(new ChunkQueue[aSettings.workerCount + 1])
+		, myJob(nullptr)
+		, myGeneration(0)
+		, myActiveWorkers(0)
+		, myStopping(false)
+	{
+		for (size_t slot = 0; slot <= aSettings.workerCount; ++slot)
+		{
+			myQueues[slot].range.store(0, std::memory_order_relaxed);
+		}
+
+		myWorkers.reserve(aSettings.workerCount);
+		for (size_t slot = 1; slot <= aSettings.workerCount; ++slot)
+		{
+			myWorkers.emplace_back([this, slot, aSettings] { WorkerLoop(slot, aSettings); });
+		}
+	}
+
+	inline ThreadPool::~ThreadPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(myMutex);
+			myStopping = true;
+		}
+		myWake.notify_all();
+		for (std::thread& worker : myWorkers)
+		{
+			worker.join();
+		}
+	}
+
+	template<class Function>
+	inline void ThreadPool::ParallelFor(size_t aBegin, size_t aEnd, size_t aGrain, Function&& aFunction)
+	{
+		if (aEnd <= aBegin)
+		{
+			return;
+		}
+
+		const size_t count = aEnd - aBegin;
+		size_t grain = aGrain > 0 ? aGrain : 1;
+		// The chunk indices have to fit the 32-bit halves of the queue word
+		grain = std::max(grain, count / size_t(UINT32_MAX) + 1);
+		const size_t chunkCount = (count + grain - 1) / grain;
+
+		if (myWorkers.empty() || chunkCount < 2 || Detail::globalInsideParallelFor)
+		{
+			aFunction(aBegin, aEnd);
+			return;
+		}
+
+		using FunctionType = std::remove_reference_t<Function>;
+		const Job job =
+		{
+			[](void* aFunctionPointer, size_t aChunkBegin, size_t aChunkEnd)
+			{
+				(*static_cast<FunctionType*>(aFunctionPointer))(aChunkBegin, aChunkEnd);
+			},
+			const_cast<void*>(static_cast<const void*>(&aFunction)),
+			aBegin,
+			aEnd,
+			grain
+		};
+
+		std::lock_guard<std::mutex> dispatch(myDispatchMutex);
+
+		const size_t threadCount = GetThreadCount();
+		for (size_t slot = 0; slot < threadCount; ++slot)
+		{
+			const uint64_t front = chunkCount * slot / threadCount;
+			const uint64_t back = chunkCount * (slot + 1) / threadCount;
+			myQueues[slot].range.store(front | (back << 32), std::memory_order_relaxed);
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(myMutex);
+			myJob = &job;
+			myActiveWorkers = myWorkers.size();
+			++myGeneration;
+		}
+		myWake.notify_all();
+
+		Detail::globalInsideParallelFor = true;
+		RunChunks(0, job);
+		Detail::globalInsideParallelFor = false;
+
+		// The job lives on this stack frame, so wait until every worker has let go of it
+		std::unique_lock<std::mutex> lock(myMutex);
+		myDone.wait(lock, [this] { return myActiveWorkers == 0; });
+		myJob = nullptr;
+	}
+
+	template<class T, class Function>
+	inline void ThreadPool::ParallelForArray(size_t aCount, size_t aGrain, Function&& aFunction)
+	{
+		constexpr size_t elementsPerLine = sizeof(T) < CACHE_LINE_SIZE ? CACHE_LINE_SIZE / sizeof(T) : 1;
+		constexpr size_t defaultGrain = BB_PARALLEL_GRAIN_BYTES / sizeof(T) > 0 ? BB_PARALLEL_GRAIN_BYTES / sizeof(T) : 1;
+
+		const size_t grain = aGrain > 0 ? aGrain : defaultGrain;
+		ParallelFor(0, aCount, (grain + elementsPerLine - 1) / elementsPerLine * elementsPerLine, std::forward<Function>(aFunction));
+	}
+
+	inline size_t ThreadPool::GetThreadCount() const
+	{
+		return myWorkers.size() + 1;
+	}
+
+	inline void ThreadPool::WorkerLoop(size_t aSlot, const ThreadPoolSettings& aSettings)
+	{
+		if (aSettings.pinThreads)
+		{
+			Detail::PinCurrentThreadToCore(aSettings.firstCore + aSlot);
+		}
+		SetFlushDenormals(aSettings.flushDenormals);
+		Detail::globalInsideParallelFor = true;
+
+		uint64_t seenGeneration = 0;
+		for (;;)
+		{
+			const Job* job = nullptr;
+			{
+				std::unique_lock<std::mutex> lock(myMutex);
+				myWake.wait(lock, [this, seenGeneration] { return myStopping || myGeneration != seenGeneration; });
+				if (myStopping)
+				{
+					return;
+				}
+				seenGeneration = myGeneration;
+				job = myJob;
+			}
+
+			RunChunks(aSlot, *job);
+
+			std::lock_guard<std::mutex> lock(myMutex);
+			if (--myActiveWorkers == 0)
+			{
+				myDone.notify_one();
+			}
+		}
+	}
+
+	inline void ThreadPool::RunChunks(size_t aSlot, const Job& aJob)
+	{
+		const auto run = [&aJob](size_t aChunk)
+		{
+			const size_t begin = aJob.begin + aChunk * aJob.grain;
+			aJob.invoke(aJob.function, begin, std::min(begin + aJob.grain, aJob.end));
+		};
+
+		size_t chunk = 0;
+		while (PopChunk(aSlot, chunk))
+		{
+			run(chunk);
+		}
+
+		// No chunks are added while a job runs, so one pass over the other queues empties them all
+		const size_t threadCount = GetThreadCount();
+		for (size_t offset = 1; offset < threadCount; ++offset)
+		{
+			const size_t victim = (aSlot + offset) % threadCount;
+			while (StealChunk(victim, chunk))
+			{
+				run(chunk);
+			}
+		}
+	}
+
+	inline bool ThreadPool::PopChunk(size_t aSlot, size_t& aOutChunk)
+	{
+		std::atomic<uint64_t>& range = myQueues[aSlot].range;
+		uint64_t current = range.load(std::memory_order_acquire);
+		for (;;)
+		{
+			const uint64_t front = current & 0xFFFFFFFFu;
+			const uint64_t back = current >> 32;
+			if (front >= back)
+			{
+				return false;
+			}
+			if (range.compare_exchange_weak(current, (front + 1) | (back << 32), std::memory_order_acq_rel))
+			{
+				aOutChunk = size_t(front);
+				return true;
+			}
+		}
+	}
+
+	inline bool ThreadPool::StealChunk(size_t aSlot, size_t& aOutChunk)
+	{
+		std::atomic<uint64_t>& range = myQueues[aSlot].range;
+		uint64_t current = range.load(std::memory_order_acquire);
+		for (;;)
+		{
+			const uint64_t front = current & 0xFFFFFFFFu;
+			const uint64_t back = current >> 32;
+			if (front >= back)
+			{
+				return false;
+			}
+			if (range.compare_exchange_weak(current, front | ((back - 1) << 32), std::memory_order_acq_rel))
+			{
+				aOutChunk = size_t(back - 1);
+				return true;
+			}
+		}
+	}
+} // namespace BitBloom
@@ -0,0 +1,126 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include "../Memory/AlignedAllocator.h"
+#include "../Util/Float8.h"
+#include "../Util/RandomStream.h"
+#include "../Vector/Vector3f/Vector3f.h"
+#include "../Parallel/ThreadPool.h"
+
+/**
+ * @file ParticleSystem.h
+ * @brief Particle storage and update in structure-of-arrays form, eight particles per step.
+ *
+ * @details Positions, velocities and remaining lifetimes are kept in seven separate float arrays
+ * (x, y and z of each vector plus the lifetime), so the update loads eight particles into one
+ * Float8 per component and integrates gravity, drag and the force fields without any shuffles.
+ *
+ * In the same pass each particle loses aDeltaTime of its lifetime, the dead ones (lifetime <= 0)
+ * are found with one compare and MoveMask per eight particles and the survivors are moved down
+ * over them. Within a block the per-particle copy always happens and only the write index
+ * depends on the mask, so the lanes do not branch on whether a particle died. There is one branch
+ * per block: when all eight survive and nothing has died before them the block is already in
+ * place and the copy is skipped. It is well predicted while particles rarely die, the first death
+ * in a range makes the rest of the range take the copy path.
+ *
+ * Emit fills the new particles with RandomStream::Fill, one array at a time.
+ *
+ * Update(ThreadPool&) integrates and compacts chunks of the arrays in parallel, then moves the
+ * survivors of every chunk next to each other.
+ */
+
+namespace BitBloom
+{
+/**
+* @brief Point attractor (positive strength) or repulsor (negative strength).
+*
+* @details The acceleration is strength / distance^2 towards the center. softening is added to
+* distance^2 so particles passing through the center are not thrown away.
+*/
+	struct ParticleForceField
+	{
+		Vec3f center;
+		float strength = 0.0f;
+		float softening = 0.01f;
+	};
+
+	enum class ParticleIntegrator
+	{
+/// @brief v += a * dt, then x += v * dt.
+		SemiImplicitEuler,
+/// @brief Position Verlet, x' = x + (x - x_previous) * damping + a * dt^2, with x_previous kept as x - v * dt.
+		Verlet
+	};
+
+	struct ParticleSimulationSettings
+	{
+		Vec3f gravity = Vec3f(0.0f, -9.81f, 0.0f);
+/// @brief Part of the velocity removed per second, velocities are scaled by max(0, 1 - drag * dt).
+		float drag = 0.0f;
+		ParticleIntegrator integrator = ParticleIntegrator::SemiImplicitEuler;
+		const ParticleForceField* forceFields = nullptr;
+		size_t forceFieldCount = 0;
+	};
+
+/// @brief New particles are spread uniformly over a box and get a uniform random velocity and lifetime.
+	struct ParticleEmitterSettings
+	{
+		Vec3f position;
+		Vec3f extent;
+		Vec3f velocityMin;
+		Vec3f velocityMax;
+		float lifetimeMin = 1.0f;
+		float lifetimeMax = 1.0f;
+	};
+
+	class ParticleSystem
+	{
+	public:
+/// @brief Allocates room for aCapacity particles, the random stream used by Emit is seeded with aSeed.
+		inline explicit ParticleSystem(size_t aCapacity, uint32_t aSeed = 1);
+
+/// @brief Adds up to aCount particles, fewer when the capacity runs out. Returns the number added.
+		inline size_t Emit(const ParticleEmitterSettings& aEmitter, size_t aCount);
+/// @brief Integrates all particles by aDeltaTime and removes the ones whose lifetime ran out.
+		inline void Update(const ParticleSimulationSettings& aSettings, float aDeltaTime);
+/// @brief Same as Update(), in chunks spread over aPool.
+		inline void Update(ThreadPool& aPool, const ParticleSimulationSettings& aSettings, float aDeltaTime);
+/// @brief Removes every particle.
+		inline void Clear();
+
+		inline size_t GetCount() const;
+		inline size_t GetCapacity() const;
+		inline Vec3f GetPosition(size_t aIndex) const;
+		inline Vec3f GetVelocity(size_t aIndex) const;
+		inline float GetLifetime(size_t aIndex) const;
+
+/**
+* @name Arrays
+* @brief The component arrays, GetCount() valid values each, 32-byte aligned.
+* @{
+*/
+		inline const float* GetPositionsX() const;
+		inline const float* GetPositionsY() const;
+		inline const float* GetPositionsZ() const;
+		inline const float* GetVelocitiesX() const;
+		inline const float* GetVelocitiesY() const;
+		inline const float* GetVelocitiesZ() const;
+		inline const float* GetLifetimes() const;
+/** @} */
+
+	private:
+		enum Stream { POSITION_X, POSITION_Y, POSITION_Z, VELOCITY_X, VELOCITY_Y, VELOCITY_Z, LIFETIME, STREAM_COUNT };
+
+		inline size_t UpdateRange(const ParticleSimulationSettings& aSettings, float aDeltaTime, size_t aBegin, size_t aEnd);
+		inline void MoveRange(size_t aFrom, size_t aTo, size_t aCount);
+
+		AlignedVector<float, CACHE_LINE_SIZE> myStreams[STREAM_COUNT];
+		RandomStream myRandom;
+		size_t myCapacity;
+		size_t myCount;
+	};
+} // namespace BitBloom
+
+namespace BB = BitBloom;
+
+#include "ParticleSystem.inl"
@@ -0,0 +1,254 @@
+#pragma once
+#include "ParticleSystem.h"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace BitBloom
+{
+	inline ParticleSystem::ParticleSystem(size_t aCapacity, uint32_t aSeed)
+		: myRandom(aSeed)
+		, myCapacity(aCapacity)
+		, myCount(0)
+	{
+		// Padded to whole Float8 blocks so the last block can be loaded and stored in one go
+		const size_t paddedCapacity = (aCapacity + 7) & ~size_t(7);
+		for (AlignedVector<float, CACHE_LINE_SIZE>& stream : myStreams)
+		{
+			stream.assign(paddedCapacity, 0.0f);
+		}
+	}
+
+	inline size_t ParticleSystem::Emit(const ParticleEmitterSettings& aEmitter, size_t aCount)
+	{
+		const size_t count = std::min(aCount, myCapacity - myCount);
+		const float position[3] = { aEmitter.position.x, aEmitter.position.y, aEmitter.position.z };
+		const float extent[3] = { aEmitter.extent.x, aEmitter.extent.y, aEmitter.extent.z };
+		const float velocityMin[3] = { aEmitter.velocityMin.x, aEmitter.velocityMin.y, aEmitter.velocityMin.z };
+		const float velocityMax[3] = { aEmitter.velocityMax.x, aEmitter.velocityMax.y, aEmitter.velocityMax.z };
+
+		for (int axis = 0; axis < 3; ++axis)
+		{
+			myRandom.Fill(myStreams[POSITION_X + axis].data() + myCount, count, position[axis] - extent[axis], position[axis] + extent[axis]);
+			myRandom.Fill(myStreams[VELOCITY_X + axis].data() + myCount, count, velocityMin[axis], velocityMax[axis]);
+		}
+		myRandom.Fill(myStreams[LIFETIME].data() + myCount, count, aEmitter.lifetimeMin, aEmitter.lifetimeMax);
+
+		myCount += count;
+		return count;
+	}
+
+	inline void ParticleSystem::Update(const ParticleSimulationSettings& aSettings, float aDeltaTime)
+	{
+		if (aDeltaTime <= 0.0f)
+		{
+			return;
+		}
+		myCount = UpdateRange(aSettings, aDeltaTime, 0, myCount);
+	}
+
+	inline void ParticleSystem::Update(ThreadPool& aPool, const ParticleSimulationSettings& aSettings, float aDeltaTime)
+	{
+		if (aDeltaTime <= 0.0f || myCount == 0)
+		{
+			return;
+		}
+
+		// About BB_PARALLEL_GRAIN_BYTES over all seven arrays, in whole cache lines so chunks start on Float8 blocks
+		constexpr size_t floatsPerLine = CACHE_LINE_SIZE / sizeof(float);
+		constexpr size_t grain = std::max<size_t>(BB_PARALLEL_GRAIN_BYTES / (sizeof(float) * STREAM_COUNT) / floatsPerLine, 1) * floatsPerLine;
+
+		std::vector<size_t> survivors((myCount + grain - 1) / grain, 0);
+		aPool.ParallelFor(0, myCount, grain, [&](size_t aBegin, size_t aEnd)
+		{
+			survivors[aBegin / grain] = UpdateRange(aSettings, aDeltaTime, aBegin, aEnd);
+		});
+
+		// Each chunk compacted itself to its start, close the gaps between the chunks
+		size_t write = 0;
+		for (size_t chunk = 0; chunk < survivors.size(); ++chunk)
+		{
+			MoveRange(chunk * grain, write, survivors[chunk]);
+			write += survivors[chunk];
+		}
+		myCount = write;
+	}
+
+	inline void ParticleSystem::Clear()
+	{
+		myCount = 0;
+	}
+
+	inline size_t ParticleSystem::GetCount() const
+	{
+		return myCount;
+	}
+
+	inline size_t ParticleSystem::GetCapacity() const
+	{
+		return myCapacity;
+	}
+
+	inline Vec3f ParticleSystem::GetPosition(size_t aIndex) const
+	{
+		return Vec3f(myStreams[POSITION_X][aIndex], myStreams[POSITION_Y][aIndex], myStreams[POSITION_Z][aIndex]);
+	}
+
+	inline Vec3f ParticleSystem::GetVelocity(size_t aIndex) const
+	{
+		return Vec3f(myStreams[VELOCITY_X][aIndex], myStreams[VELOCITY_Y][aIndex], myStreams[VELOCITY_Z][aIndex]);
+	}
+
+	inline float ParticleSystem::GetLifetime(size_t aIndex) const
+	{
+		return myStreams[LIFETIME][aIndex];
+	}
+
+	inline const float* ParticleSystem::GetPositionsX() const
+	{
+		return myStreams[POSITION_X].data();
+	}
+
+	inline const float* ParticleSystem::GetPositionsY() const
+	{
+		return myStreams[POSITION_Y].data();
+	}
+
+	inline const float* ParticleSystem::GetPositionsZ() const
+	{
+		return myStreams[POSITION_Z].data();
+	}
+
+	inline const float* ParticleSystem::GetVelocitiesX() const
+	{
+		return myStreams[VELOCITY_X].data();
+	}
+
+	inline const float* ParticleSystem::GetVelocitiesY() const
+	{
+		return myStreams[VELOCITY_Y].data();
+	}
+
+	inline const float* ParticleSystem::GetVelocitiesZ() const
+	{
+		return myStreams[VELOCITY_Z].data();
+	}
+
+	inline const float* ParticleSystem::GetLifetimes() const
+	{
+		return myStreams[LIFETIME].data();
+	}
+
+	inline size_t ParticleSystem::UpdateRange(const ParticleSimulationSettings& aSettings, float aDeltaTime, size_t aBegin, size_t aEnd)
+	{
+		using namespace BB::Simd;
+
+		float* streams[STREAM_COUNT];
+		for (int stream = 0; stream < STREAM_COUNT; ++stream)
+		{
+			streams[stream] = myStreams[stream].data();
+		}
+
+		const float damping = std::max(0.0f, 1.0f - aSettings.drag * aDeltaTime);
+		const Float8 deltaTime = SplatFloat8(aDeltaTime);
+		const Float8 dampingSplat = SplatFloat8(damping);
+		const Float8 verletStep = SplatFloat8(aDeltaTime * damping);
+		const Float8 deltaTimeSquared = SplatFloat8(aDeltaTime * aDeltaTime);
+		const Float8 inverseDeltaTime = SplatFloat8(1.0f / aDeltaTime);
+		const Float8 gravityX = SplatFloat8(aSettings.gravity.x);
+		const Float8 gravityY = SplatFloat8(aSettings.gravity.y);
+		const Float8 gravityZ = SplatFloat8(aSettings.gravity.z);
+		const Float8 zero = SplatFloat8(0.0f);
+		const bool verlet = aSettings.integrator == ParticleIntegrator::Verlet;
+
+		size_t write = aBegin;
+		for (size_t block = aBegin; block < aEnd; block += 8)
+		{
+			Float8 positionX = LoadFloat8(streams[POSITION_X] + block);
+			Float8 positionY = LoadFloat8(streams[POSITION_Y] + block);
+			Float8 positionZ = LoadFloat8(streams[POSITION_Z] + block);
+			Float8 velocityX = LoadFloat8(streams[VELOCITY_X] + block);
+			Float8 velocityY = LoadFloat8(streams[VELOCITY_Y] + block);
+			Float8 velocityZ = LoadFloat8(streams[VELOCITY_Z] + block);
+
+			Float8 accelerationX = gravityX;
+			Float8 accelerationY = gravityY;
+			Float8 accelerationZ = gravityZ;
+			for (size_t field = 0; field < aSettings.forceFieldCount; ++field)
+			{
+				const ParticleForceField& forceField = aSettings.forceFields[field];
+				const Float8 deltaX = Sub(SplatFloat8(forceField.center.x), positionX);
+				const Float8 deltaY = Sub(SplatFloat8(forceField.center.y), positionY);
+				const Float8 deltaZ = Sub(SplatFloat8(forceField.center.z), positionZ);
+				const Float8 distanceSquared = MulAdd(deltaX, deltaX, MulAdd(deltaY, deltaY, MulAdd(deltaZ, deltaZ, SplatFloat8(forceField.softening))));
+				// strength / d^2 along delta / d
+				const Float8 scale = Div(SplatFloat8(forceField.strength), Mul(distanceSquared, Sqrt(distanceSquared)));
+				accelerationX = MulAdd(deltaX, scale, accelerationX);
+				accelerationY = MulAdd(deltaY, scale, accelerationY);
+				accelerationZ = MulAdd(deltaZ, scale, accelerationZ);
+			}
+
+			if (verlet)
+			{
+				const Float8 nextX = Add(positionX, MulAdd(accelerationX, deltaTimeSquared, Mul(velocityX, verletStep)));
+				const Float8 nextY = Add(positionY, MulAdd(accelerationY, deltaTimeSquared, Mul(velocityY, verletStep)));
+				const Float8 nextZ = Add(positionZ, MulAdd(accelerationZ, deltaTimeSquared, Mul(velocityZ, verletStep)));
+				velocityX = Mul(Sub(nextX, positionX), inverseDeltaTime);
+				velocityY = Mul(Sub(nextY, positionY), inverseDeltaTime);
+				velocityZ = Mul(Sub(nextZ, positionZ), inverseDeltaTime);
+				positionX = nextX;
+				positionY = nextY;
+				positionZ = nextZ;
+			}
+			else
+			{
+				velocityX = Mul(MulAdd(accelerationX, deltaTime, velocityX), dampingSplat);
+				velocityY = Mul(MulAdd(accelerationY, deltaTime, velocityY), dampingSplat);
+				velocityZ = Mul(MulAdd(accelerationZ, deltaTime, velocityZ), dampingSplat);
+				positionX = MulAdd(velocityX, deltaTime, positionX);
+				positionY = MulAdd(velocityY, deltaTime, positionY);
+				positionZ = MulAdd(velocityZ, deltaTime, positionZ);
+			}
+			const Float8 lifetime = Sub(LoadFloat8(streams[LIFETIME] + block), deltaTime);
+
+			StoreFloat8(streams[POSITION_X] + block, positionX);
+			StoreFloat8(streams[POSITION_Y] + block, positionY);
+			StoreFloat8(streams[POSITION_Z] + block, positionZ);
+			StoreFloat8(streams[VELOCITY_X] + block, velocityX);
+			StoreFloat8(streams[VELOCITY_Y] + block, velocityY);
+			StoreFloat8(streams[VELOCITY_Z] + block, velocityZ);
+			StoreFloat8(streams[LIFETIME] + block, lifetime);
+
+			// Lanes past aEnd are padding and count as dead
+			const size_t valid = std::min<size_t>(8, aEnd - block);
+			const int alive = MoveMask(GreaterMask(lifetime, zero)) & ((1 << valid) - 1);
+			if (alive == 0xFF && write == block)
+			{
+				write += 8;
+				continue;
+			}
+
+			for (size_t lane = 0; lane < valid; ++lane)
+			{
+				for (int stream = 0; stream < STREAM_COUNT; ++stream)
+				{
+					streams[stream][write] = streams[stream][block + lane];
+				}
+				write += (alive >> lane) & 1;
+			}
+		}
+		return write - aBegin;
+	}
+
+	inline void ParticleSystem::MoveRange(size_t aFrom, size_t aTo, size_t aCount)
+	{
+		if (aFrom == aTo || aCount == 0)
+		{
+			return;
+		}
+		for (AlignedVector<float, CACHE_LINE_SIZE>& stream : myStreams)
+		{
+			std::memmove(stream.data() + aTo, stream.data() + aFrom, aCount * sizeof(float));
+		}
+	}
+} // namespace BitBloom
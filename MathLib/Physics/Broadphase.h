@@ -0,0 +1,176 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "../Memory/AlignedAllocator.h"
+#include "../Util/Float8.h"
+#include "../Bulk/RadixSort.h"
+#include "../Vector/Vector3f/Vector3f.h"
+#include "../Parallel/ThreadPool.h"
+
+/**
+ * @file Broadphase.h
+ * @brief Pair generation for many moving AABBs, sweep-and-prune and a hashed uniform grid.
+ *
+ * @details Both broadphases hand out a BroadphaseId per object. Insert, Remove and Update are O(1)
+ * (the grid moves an object between cells when its center changes cell), all of the sorting and
+ * pair work happens in FindPairs, which reports every pair of overlapping boxes once, with
+ * one < two. Touching boxes count as overlapping. FindPairs(ThreadPool&) spreads the pair search
+ * over the pool, every chunk fills its own list and the lists are joined in chunk order, so the
+ * result is the same as the serial one.
+ *
+ * SweepAndPrune fits any mix of object sizes. FindPairs radix sorts the live boxes by min x into
+ * structure-of-arrays bounds, then every box tests the boxes after it eight at a time: one Float8
+ * compare of min x against its max x ends the sweep, the same mask ANDed with the y and z
+ * compares gives the overlapping pairs. Infinite bounds are fine, a world bounds box or ground
+ * plane spanning x sweeps to the end of the array.
+ *
+ * HashGrid is for objects of about the same size. Every object lives in the cell of its center,
+ * cells are found through an open addressing hash table of their coordinates, and a cell is only
+ * compared with itself and 13 of its 26 neighbors so no pair is seen twice. Objects larger than the cell size would
+ * miss pairs and assert in debug builds. Cell coordinates are hashed with 21 bits per axis, so
+ * the occupied region must span less than 2^21 cells along each axis.
+ *
+ * @code
+ * BB::SweepAndPrune broadphase;
+ * BB::BroadphaseId id = broadphase.Insert(boundsMin, boundsMax);
+ * ...
+ * broadphase.Update(id, newMin, newMax);
+ * broadphase.FindPairs(pool, pairs);
+ * @endcode
+ */
+
+namespace BitBloom
+{
+	using BroadphaseId = uint32_t;
+	inline constexpr BroadphaseId INVALID_BROADPHASE_ID = ~BroadphaseId(0);
+
+	struct BroadphasePair
+	{
+		BroadphaseId one;
+		BroadphaseId two;
+	};
+
+	class SweepAndPrune
+	{
+	public:
+		inline BroadphaseId Insert(const Vec3f& aMin, const Vec3f& aMax);
+/// @brief Frees aId, it can be handed out again by a later Insert.
+		inline void Remove(BroadphaseId aId);
+		inline void Update(BroadphaseId aId, const Vec3f& aMin, const Vec3f& aMax);
+		inline size_t GetCount() const;
+
+/// @brief Replaces the content of aOutPairs with the overlapping pairs.
+		inline void FindPairs(std::vector<BroadphasePair>& aOutPairs);
+		inline void FindPairs(ThreadPool& aPool, std::vector<BroadphasePair>& aOutPairs);
+
+	private:
+		enum Bound { MIN_X, MIN_Y, MIN_Z, MAX_X, MAX_Y, MAX_Z, BOUND_COUNT };
+
+		inline void SortByMinX();
+		inline void SweepRange(size_t aBegin, size_t aEnd, std::vector<BroadphasePair>& aOutPairs) const;
+
+		// Indexed by id
+		std::vector<float> myBounds[BOUND_COUNT];
+		std::vector<uint8_t> myAlive;
+		std::vector<BroadphaseId> myFreeIds;
+		size_t myCount = 0;
+
+		// Rebuilt by FindPairs, kept to reuse the allocations
+		AlignedVector<float, CACHE_LINE_SIZE> mySorted[BOUND_COUNT];
+		std::vector<BroadphaseId> mySortedIds;
+		std::vector<float> myKeys;
+		std::vector<float> myScratchKeys;
+		std::vector<BroadphaseId> myScratchIds;
+		std::vector<std::vector<BroadphasePair>> myChunkPairs;
+	};
+
+namespace Detail
+{
+/**
+* @brief Open addressing map from a grid cell key to a cell index, for HashGrid.
+*
+* @details Linear probing in a power of two table kept at most half full, erase shifts the
+* following entries back instead of leaving tombstones. Finding a missing neighbor cell, the
+* common case in a sparse grid, stops at the first empty slot.
+*/
+	class GridCellTable
+	{
+	public:
+		static constexpr uint32_t NOT_FOUND = ~uint32_t(0);
+
+		inline uint32_t Find(uint64_t aKey) const;
+/// @brief Adds aKey, which must not be in the table yet.
+		inline void Insert(uint64_t aKey, uint32_t aValue);
+		inline void Erase(uint64_t aKey);
+		inline size_t GetCount() const;
+
+	private:
+		struct Slot
+		{
+			uint64_t key;
+			uint32_t value;
+		};
+
+		static constexpr uint64_t EMPTY_KEY = ~uint64_t(0);
+
+		inline size_t Home(uint64_t aKey) const;
+		inline void Grow();
+
+		std::vector<Slot> mySlots;
+		size_t myCount = 0;
+		int myShift = 64;
+	};
+} // namespace Detail
+
+	class HashGrid
+	{
+	public:
+/// @brief aCellSize has to be at least the largest extent of any object.
+		inline explicit HashGrid(float aCellSize);
+
+		inline BroadphaseId Insert(const Vec3f& aMin, const Vec3f& aMax);
+		inline void Remove(BroadphaseId aId);
+		inline void Update(BroadphaseId aId, const Vec3f& aMin, const Vec3f& aMax);
+		inline size_t GetCount() const;
+		inline size_t GetCellCount() const;
+
+		inline void FindPairs(std::vector<BroadphasePair>& aOutPairs);
+		inline void FindPairs(ThreadPool& aPool, std::vector<BroadphasePair>& aOutPairs);
+
+	private:
+		struct Object
+		{
+			Vec3f min;
+			Vec3f max;
+			uint32_t cell;
+			uint32_t slot;
+		};
+
+		struct Cell
+		{
+			int coordinates[3];
+			std::vector<BroadphaseId> objects;
+		};
+
+		inline void CellCoordinates(const Vec3f& aMin, const Vec3f& aMax, int aOutCoordinates[3]) const;
+		inline uint32_t FindCell(int aX, int aY, int aZ) const;
+		inline void AddToCell(BroadphaseId aId, const int aCoordinates[3]);
+		inline void RemoveFromCell(BroadphaseId aId);
+		inline void FindCellPairs(size_t aBegin, size_t aEnd, std::vector<BroadphasePair>& aOutPairs) const;
+
+		float myCellSize;
+		float myInverseCellSize;
+		std::vector<Object> myObjects;
+		std::vector<BroadphaseId> myFreeIds;
+		size_t myCount = 0;
+		std::vector<Cell> myCells;
+		std::vector<uint32_t> myFreeCells;
+		Detail::GridCellTable myCellLookup;
+		std::vector<std::vector<BroadphasePair>> myChunkPairs;
+	};
+} // namespace BitBloom
+
+namespace BB = BitBloom;
+
+#include "Broadphase.inl"
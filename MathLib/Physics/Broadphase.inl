@@ -0,0 +1,478 @@
+#pragma once
+#include "Broadphase.h"
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+namespace BitBloom
+{
+namespace Detail
+{
+	inline BroadphasePair MakeBroadphasePair(BroadphaseId aOne, BroadphaseId aTwo)
+	{
+		return aOne < aTwo ? BroadphasePair{ aOne, aTwo } : BroadphasePair{ aTwo, aOne };
+	}
+
+/// @brief True if the boxes overlap or touch, all three axes in one compare.
+	inline bool BoxesOverlap(const Vec3f& aMinOne, const Vec3f& aMaxOne, const Vec3f& aMinTwo, const Vec3f& aMaxTwo)
+	{
+		const __m128 overlap = _mm_and_ps(_mm_cmple_ps(aMinTwo.data, aMaxOne.data), _mm_cmple_ps(aMinOne.data, aMaxTwo.data));
+		return (_mm_movemask_ps(overlap) & 0x7) == 0x7;
+	}
+
+/// @brief Joins the per-chunk pair lists in chunk order.
+	inline void JoinPairs(const std::vector<std::vector<BroadphasePair>>& aChunkPairs, std::vector<BroadphasePair>& aOutPairs)
+	{
+		size_t total = 0;
+		for (const std::vector<BroadphasePair>& pairs : aChunkPairs)
+		{
+			total += pairs.size();
+		}
+		aOutPairs.clear();
+		aOutPairs.reserve(total);
+		for (const std::vector<BroadphasePair>& pairs : aChunkPairs)
+		{
+			aOutPairs.insert(aOutPairs.end(), pairs.begin(), pairs.end());
+		}
+	}
+
+/// @brief Packs the low 21 bits of each cell coordinate into one key.
+	inline uint64_t GridCellKey(int aX, int aY, int aZ)
+	{
+		const uint64_t mask = (uint64_t(1) << 21) - 1;
+		return (uint64_t(uint32_t(aX)) & mask) | ((uint64_t(uint32_t(aY)) & mask) << 21) | ((uint64_t(uint32_t(aZ)) & mask) << 42);
+	}
+
+	inline constexpr size_t BROADPHASE_GRAIN = 1024;
+
+	inline uint32_t GridCellTable::Find(uint64_t aKey) const
+	{
+		if (mySlots.empty())
+		{
+			return NOT_FOUND;
+		}
+		const size_t mask = mySlots.size() - 1;
+		for (size_t slot = Home(aKey); mySlots[slot].key != EMPTY_KEY; slot = (slot + 1) & mask)
+		{
+			if (mySlots[slot].key == aKey)
+			{
+				return mySlots[slot].value;
+			}
+		}
+		return NOT_FOUND;
+	}
+
+	inline void GridCellTable::Insert(uint64_t aKey, uint32_t aValue)
+	{
+		assert(aKey != EMPTY_KEY && Find(aKey) == NOT_FOUND);
+		if ((myCount + 1) * 2 > mySlots.size())
+		{
+			Grow();
+		}
+		const size_t mask = mySlots.size() - 1;
+		size_t slot = Home(aKey);
+		while (mySlots[slot].key != EMPTY_KEY)
+		{
+			slot = (slot + 1) & mask;
+		}
+		mySlots[slot] = { aKey, aValue };
+		++myCount;
+	}
+
+	inline void GridCellTable::Erase(uint64_t aKey)
+	{
+		const size_t mask = mySlots.size() - 1;
+		size_t hole = Home(aKey);
+		while (mySlots[hole].key != aKey)
+		{
+			assert(mySlots[hole].key != EMPTY_KEY && "Key not in the table");
+			hole = (hole + 1) & mask;
+		}
+
+		// Move back every following entry whose home slot is not between the hole and itself
+		for (size_t slot = (hole + 1) & mask; mySlots[slot].key != EMPTY_KEY; slot = (slot + 1) & mask)
+		{
+			const size_t home = Home(mySlots[slot].key);
+			const bool reachable = hole <= slot ? (home > hole && home <= slot) : (home > hole || home <= slot);
+			if (!reachable)
+			{
+				mySlots[hole] = mySlots[slot];
+				hole = slot;
+			}
+		}
+		mySlots[hole].key = EMPTY_KEY;
+		--myCount;
+	}
+
+	inline size_t GridCellTable::GetCount() const
+	{
+		return myCount;
+	}
+
+	inline size_t GridCellTable::Home(uint64_t aKey) const
+	{
+		// Fibonacci hashing, the top bits of the product mix every bit of the key
+		return size_t((aKey * 0x9E3779B97F4A7C15ull) >> myShift);
+	}
+
+	inline void GridCellTable::Grow()
+	{
+		std::vector<Slot> old;
+		old.swap(mySlots);
+		const size_t capacity = std::max<size_t>(64, old.size() * 2);
+		mySlots.assign(capacity, Slot{ EMPTY_KEY, 0 });
+		myShift = 64 - std::countr_zero(capacity);
+		myCount = 0;
+		for (const Slot& slot : old)
+		{
+			if (slot.key != EMPTY_KEY)
+			{
+				Insert(slot.key, slot.value);
+			}
+		}
+	}
+} // namespace Detail
+
+	inline BroadphaseId SweepAndPrune::Insert(const Vec3f& aMin, const Vec3f& aMax)
+	{
+		BroadphaseId id;
+		if (myFreeIds.empty())
+		{
+			id = BroadphaseId(myAlive.size());
+			for (std::vector<float>& bound : myBounds)
+			{
+				bound.push_back(0.0f);
+			}
+			myAlive.push_back(1);
+		}
+		else
+		{
+			id = myFreeIds.back();
+			myFreeIds.pop_back();
+			myAlive[id] = 1;
+		}
+		++myCount;
+		Update(id, aMin, aMax);
+		return id;
+	}
+
+	inline void SweepAndPrune::Remove(BroadphaseId aId)
+	{
+		assert(aId < myAlive.size() && myAlive[aId]);
+		myAlive[aId] = 0;
+		myFreeIds.push_back(aId);
+		--myCount;
+	}
+
+	inline void SweepAndPrune::Update(BroadphaseId aId, const Vec3f& aMin, const Vec3f& aMax)
+	{
+		assert(aId < myAlive.size() && myAlive[aId]);
+		myBounds[MIN_X][aId] = aMin.x;
+		myBounds[MIN_Y][aId] = aMin.y;
+		myBounds[MIN_Z][aId] = aMin.z;
+		myBounds[MAX_X][aId] = aMax.x;
+		myBounds[MAX_Y][aId] = aMax.y;
+		myBounds[MAX_Z][aId] = aMax.z;
+	}
+
+	inline size_t SweepAndPrune::GetCount() const
+	{
+		return myCount;
+	}
+
+	inline void SweepAndPrune::FindPairs(std::vector<BroadphasePair>& aOutPairs)
+	{
+		SortByMinX();
+		aOutPairs.clear();
+		SweepRange(0, myCount, aOutPairs);
+	}
+
+	inline void SweepAndPrune::FindPairs(ThreadPool& aPool, std::vector<BroadphasePair>& aOutPairs)
+	{
+		SortByMinX();
+		myChunkPairs.resize((myCount + Detail::BROADPHASE_GRAIN - 1) / Detail::BROADPHASE_GRAIN);
+		aPool.ParallelFor(0, myCount, Detail::BROADPHASE_GRAIN, [&](size_t aBegin, size_t aEnd)
+		{
+			std::vector<BroadphasePair>& pairs = myChunkPairs[aBegin / Detail::BROADPHASE_GRAIN];
+			pairs.clear();
+			SweepRange(aBegin, aEnd, pairs);
+		});
+		Detail::JoinPairs(myChunkPairs, aOutPairs);
+	}
+
+	inline void SweepAndPrune::SortByMinX()
+	{
+		myKeys.clear();
+		mySortedIds.clear();
+		for (BroadphaseId id = 0; id < BroadphaseId(myAlive.size()); ++id)
+		{
+			if (myAlive[id])
+			{
+				myKeys.push_back(myBounds[MIN_X][id]);
+				mySortedIds.push_back(id);
+			}
+		}
+		myScratchKeys.resize(myCount);
+		myScratchIds.resize(myCount);
+		Bulk::RadixSort(myKeys.data(), mySortedIds.data(), myScratchKeys.data(), myScratchIds.data(), myCount);
+
+		// One Float8 of padding past the end so the sweep can always load eight boxes
+		for (int bound = 0; bound < BOUND_COUNT; ++bound)
+		{
+			AlignedVector<float, CACHE_LINE_SIZE>& sorted = mySorted[bound];
+			sorted.resize(myCount + 8);
+			const float* source = myBounds[bound].data();
+			for (size_t i = 0; i < myCount; ++i)
+			{
+				sorted[i] = source[mySortedIds[i]];
+			}
+			std::fill(sorted.begin() + myCount, sorted.end(), bound == MIN_X ? std::numeric_limits<float>::infinity() : 0.0f);
+		}
+	}
+
+	inline void SweepAndPrune::SweepRange(size_t aBegin, size_t aEnd, std::vector<BroadphasePair>& aOutPairs) const
+	{
+		using namespace BB::Simd;
+
+		const float* minX = mySorted[MIN_X].data();
+		const float* minY = mySorted[MIN_Y].data();
+		const float* minZ = mySorted[MIN_Z].data();
+		const float* maxY = mySorted[MAX_Y].data();
+		const float* maxZ = mySorted[MAX_Z].data();
+
+		for (size_t i = aBegin; i < aEnd; ++i)
+		{
+			const Float8 boxMaxX = SplatFloat8(mySorted[MAX_X][i]);
+			const Float8 boxMinY = SplatFloat8(minY[i]);
+			const Float8 boxMaxY = SplatFloat8(maxY[i]);
+			const Float8 boxMinZ = SplatFloat8(minZ[i]);
+			const Float8 boxMaxZ = SplatFloat8(maxZ[i]);
+
+			for (size_t j = i + 1; j < myCount; j += 8)
+			{
+				// Sorted by min x, the first box starting after max x ends the sweep. The lanes past
+				// myCount are masked off, a box with an infinite max x reaches the end of the array.
+				const int live = myCount - j >= 8 ? 0xFF : (1 << int(myCount - j)) - 1;
+				const Float8 overlapX = GreaterEqualMask(boxMaxX, LoadUnalignedFloat8(minX + j));
+				const int inRange = MoveMask(overlapX) & live;
+				if (inRange == 0)
+				{
+					break;
+				}
+
+				const Float8 overlapY = And(GreaterEqualMask(boxMaxY, LoadUnalignedFloat8(minY + j)), GreaterEqualMask(LoadUnalignedFloat8(maxY + j), boxMinY));
+				const Float8 overlapZ = And(GreaterEqualMask(boxMaxZ, LoadUnalignedFloat8(minZ + j)), GreaterEqualMask(LoadUnalignedFloat8(maxZ + j), boxMinZ));
+				for (int hits = MoveMask(And(overlapX, And(overlapY, overlapZ))) & live; hits != 0; hits &= hits - 1)
+				{
+					aOutPairs.push_back(Detail::MakeBroadphasePair(mySortedIds[i], mySortedIds[j + std::countr_zero(unsigned(hits))]));
+				}
+
+				if (inRange != 0xFF)
+				{
+					break;
+				}
+			}
+		}
+	}
+
+	inline HashGrid::HashGrid(float aCellSize)
+		: myCellSize(aCellSize)
+		, myInverseCellSize(1.0f / aCellSize)
+	{
+		assert(aCellSize > 0.0f);
+	}
+
+	inline BroadphaseId HashGrid::Insert(const Vec3f& aMin, const Vec3f& aMax)
+	{
+		BroadphaseId id;
+		if (myFreeIds.empty())
+		{
+			id = BroadphaseId(myObjects.size());
+			myObjects.emplace_back();
+		}
+		else
+		{
+			id = myFreeIds.back();
+			myFreeIds.pop_back();
+		}
+		++myCount;
+
+		Object& object = myObjects[id];
+		object.min = aMin;
+		object.max = aMax;
+		int coordinates[3];
+		CellCoordinates(aMin, aMax, coordinates);
+		AddToCell(id, coordinates);
+		return id;
+	}
+
+	inline void HashGrid::Remove(BroadphaseId aId)
+	{
+		assert(aId < myObjects.size() && myObjects[aId].cell != ~uint32_t(0));
+		RemoveFromCell(aId);
+		myObjects[aId].cell = ~uint32_t(0);
+		myFreeIds.push_back(aId);
+		--myCount;
+	}
+
+	inline void HashGrid::Update(BroadphaseId aId, const Vec3f& aMin, const Vec3f& aMax)
+	{
+		assert(aId < myObjects.size() && myObjects[aId].cell != ~uint32_t(0));
+		Object& object = myObjects[aId];
+		object.min = aMin;
+		object.max = aMax;
+
+		int coordinates[3];
+		CellCoordinates(aMin, aMax, coordinates);
+		const int* current = myCells[object.cell].coordinates;
+		if (coordinates[0] != current[0] || coordinates[1] != current[1] || coordinates[2] != current[2])
+		{
+			RemoveFromCell(aId);
+			AddToCell(aId, coordinates);
+		}
+	}
+
+	inline size_t HashGrid::GetCount() const
+	{
+		return myCount;
+	}
+
+	inline size_t HashGrid::GetCellCount() const
+	{
+		return myCellLookup.GetCount();
+	}
+
+	inline void HashGrid::FindPairs(std::vector<BroadphasePair>& aOutPairs)
+	{
+		aOutPairs.clear();
+		FindCellPairs(0, myCells.size(), aOutPairs);
+	}
+
+	inline void HashGrid::FindPairs(ThreadPool& aPool, std::vector<BroadphasePair>& aOutPairs)
+	{
+		// Cells hold a few objects each, so chunks are smaller than for sweep-and-prune
+		const size_t grain = Detail::BROADPHASE_GRAIN / 8;
+		myChunkPairs.resize((myCells.size() + grain - 1) / grain);
+		aPool.ParallelFor(0, myCells.size(), grain, [&](size_t aBegin, size_t aEnd)
+		{
+			std::vector<BroadphasePair>& pairs = myChunkPairs[aBegin / grain];
+			pairs.clear();
+			FindCellPairs(aBegin, aEnd, pairs);
+		});
+		Detail::JoinPairs(myChunkPairs, aOutPairs);
+	}
+
+	inline void HashGrid::CellCoordinates(const Vec3f& aMin, const Vec3f& aMax, int aOutCoordinates[3]) const
+	{
+		assert(aMax.x - aMin.x <= myCellSize && aMax.y - aMin.y <= myCellSize && aMax.z - aMin.z <= myCellSize && "Objects can not be larger than the cell size");
+		const float scale = 0.5f * myInverseCellSize;
+		aOutCoordinates[0] = int(floorf((aMin.x + aMax.x) * scale));
+		aOutCoordinates[1] = int(floorf((aMin.y + aMax.y) * scale));
+		aOutCoordinates[2] = int(floorf((aMin.z + aMax.z) * scale));
+	}
+
+	inline uint32_t HashGrid::FindCell(int aX, int aY, int aZ) const
+	{
+		return myCellLookup.Find(Detail::GridCellKey(aX, aY, aZ));
+	}
+
+	inline void HashGrid::AddToCell(BroadphaseId aId, const int aCoordinates[3])
+	{
+		const uint64_t key = Detail::GridCellKey(aCoordinates[0], aCoordinates[1], aCoordinates[2]);
+		uint32_t cellIndex = myCellLookup.Find(key);
+		if (cellIndex == Detail::GridCellTable::NOT_FOUND)
+		{
+			if (myFreeCells.empty())
+			{
+				cellIndex = uint32_t(myCells.size());
+				myCells.emplace_back();
+			}
+			else
+			{
+				cellIndex = myFreeCells.back();
+				myFreeCells.pop_back();
+			}
+			std::copy(aCoordinates, aCoordinates + 3, myCells[cellIndex].coordinates);
+			myCellLookup.Insert(key, cellIndex);
+		}
+
+		Cell& cell = myCells[cellIndex];
+		myObjects[aId].cell = cellIndex;
+		myObjects[aId].slot = uint32_t(cell.objects.size());
+		cell.objects.push_back(aId);
+	}
+
+	inline void HashGrid::RemoveFromCell(BroadphaseId aId)
+	{
+		const Object& object = myObjects[aId];
+		Cell& cell = myCells[object.cell];
+		const BroadphaseId moved = cell.objects.back();
+		cell.objects[object.slot] = moved;
+		myObjects[moved].slot = object.slot;
+		cell.objects.pop_back();
+
+		if (cell.objects.empty())
+		{
+			myCellLookup.Erase(Detail::GridCellKey(cell.coordinates[0], cell.coordinates[1], cell.coordinates[2]));
+			myFreeCells.push_back(object.cell);
+		}
+	}
+
+	inline void HashGrid::FindCellPairs(size_t aBegin, size_t aEnd, std::vector<BroadphasePair>& aOutPairs) const
+	{
+		// The neighbors after this cell in z, y, x order, the other 13 see this cell as their forward neighbor
+		static constexpr int forward[13][3] =
+		{
+			{ 1, 0, 0 },
+			{ -1, 1, 0 }, { 0, 1, 0 }, { 1, 1, 0 },
+			{ -1, -1, 1 }, { 0, -1, 1 }, { 1, -1, 1 },
+			{ -1, 0, 1 }, { 0, 0, 1 }, { 1, 0, 1 },
+			{ -1, 1, 1 }, { 0, 1, 1 }, { 1, 1, 1 }
+		};
+
+		for (size_t cellIndex = aBegin; cellIndex < aEnd; ++cellIndex)
+		{
+			const Cell& cell = myCells[cellIndex];
+			const size_t count = cell.objects.size();
+			for (size_t one = 0; one < count; ++one)
+			{
+				const Object& objectOne = myObjects[cell.objects[one]];
+				for (size_t two = one + 1; two < count; ++two)
+				{
+					const Object& objectTwo = myObjects[cell.objects[two]];
+					if (Detail::BoxesOverlap(objectOne.min, objectOne.max, objectTwo.min, objectTwo.max))
+					{
+						aOutPairs.push_back(Detail::MakeBroadphasePair(cell.objects[one], cell.objects[two]));
+					}
+				}
+			}
+			if (count == 0)
+			{
+				continue;
+			}
+
+			for (const int* offset : forward)
+			{
+				const uint32_t neighbor = FindCell(cell.coordinates[0] + offset[0], cell.coordinates[1] + offset[1], cell.coordinates[2] + offset[2]);
+				if (neighbor == Detail::GridCellTable::NOT_FOUND)
+				{
+					continue;
+				}
+				for (BroadphaseId idOne : cell.objects)
+				{
+					const Object& objectOne = myObjects[idOne];
+					for (BroadphaseId idTwo : myCells[neighbor].objects)
+					{
+						const Object& objectTwo = myObjects[idTwo];
+						if (Detail::BoxesOverlap(objectOne.min, objectOne.max, objectTwo.min, objectTwo.max))
+						{
+							aOutPairs.push_back(Detail::MakeBroadphasePair(idOne, idTwo));
+						}
+					}
+				}
+			}
+		}
+	}
+} // namespace BitBloom
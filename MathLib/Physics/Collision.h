@@ -0,0 +1,159 @@
+#pragma once
+#include <cstddef>
+#include "../Memory/AlignedAllocator.h"
+#include "../Util/Float8.h"
+#include "../Vector/Vector3f/Vector3f.h"
+#include "../Quaternion/Quatf/Quatf.h"
+
+/**
+ * @file Collision.h
+ * @brief Narrow-phase queries for packets of eight shape pairs.
+ *
+ * @details Every query has two layers:
+ * - Packet functions on Vec3Packet / Float8, one lane per pair. They are branch-free, every
+ *   special case (segment end, triangle region, parallel axes) is computed for all lanes and
+ *   chosen with Simd::Select. Without AVX a Float8 is two SSE registers, so the same code runs
+ *   as two packets of four.
+ * - Array functions that take plain shape arrays, gather eight pairs at a time into packets with
+ *   4x4 transposes, run the packet function and write the results. A tail shorter than eight
+ *   repeats its last pair, the extra lanes are never written out.
+ *
+ * Contacts follow one convention for every shape pair:
+ * - normal is a unit vector pointing from shape one towards shape two
+ * - depth is the penetration along normal, positive when the shapes overlap and the negative
+ *   separation distance when they do not (a lower bound of it for OBB pairs)
+ * - point is the point of shape two that lies deepest inside shape one
+ *
+ * Shapes whose centers (or closest segment points) coincide get the normal +y.
+ */
+
+namespace BitBloom
+{
+namespace Collision
+{
+	struct Sphere
+	{
+		Vec3f center;
+		float radius = 0.0f;
+	};
+
+/// @brief Segment from start to end, swept by radius.
+	struct Capsule
+	{
+		Vec3f start;
+		Vec3f end;
+		float radius = 0.0f;
+	};
+
+/// @brief Box with the given half extents along the local axes, rotated by orientation.
+	struct Obb
+	{
+		Vec3f center;
+		Vec3f halfExtents;
+		Quatf orientation;
+	};
+
+/// @brief Eight Vec3f in structure-of-arrays form.
+	struct Vec3Packet
+	{
+		Simd::Float8 x;
+		Simd::Float8 y;
+		Simd::Float8 z;
+	};
+
+	struct ContactPacket
+	{
+		Vec3Packet normal;
+		Vec3Packet point;
+		Simd::Float8 depth;
+	};
+
+/**
+* @brief Contact results in structure-of-arrays form, one entry per queried pair.
+*
+* @details The arrays are padded to whole packets and 32-byte aligned, so packet kernels can
+* store straight into them with StorePacket. Entries with a depth <= 0 are not touching.
+*/
+	class ContactArray
+	{
+	public:
+		inline ContactArray() = default;
+		inline explicit ContactArray(size_t aCount);
+
+/// @brief Sets the number of entries, the content of new entries is undefined.
+		inline void Resize(size_t aCount);
+		inline size_t GetCount() const;
+/// @brief Counts the entries with a positive depth.
+		inline size_t CountTouching() const;
+
+		inline Vec3f GetNormal(size_t aIndex) const;
+		inline Vec3f GetPoint(size_t aIndex) const;
+		inline float GetDepth(size_t aIndex) const;
+		inline bool IsTouching(size_t aIndex) const;
+
+/// @brief Writes eight entries starting at aIndex, which has to be a multiple of 8.
+		inline void StorePacket(size_t aIndex, const ContactPacket& aContacts);
+
+/**
+* @name Arrays
+* @brief The component arrays, GetCount() valid values each.
+* @{
+*/
+		inline const float* GetNormalsX() const;
+		inline const float* GetNormalsY() const;
+		inline const float* GetNormalsZ() const;
+		inline const float* GetPointsX() const;
+		inline const float* GetPointsY() const;
+		inline const float* GetPointsZ() const;
+		inline const float* GetDepths() const;
+/** @} */
+
+	private:
+		enum Stream { NORMAL_X, NORMAL_Y, NORMAL_Z, POINT_X, POINT_Y, POINT_Z, DEPTH, STREAM_COUNT };
+
+		AlignedVector<float, CACHE_LINE_SIZE> myStreams[STREAM_COUNT];
+		size_t myCount = 0;
+	};
+
+/**
+* @name Packets
+* @{
+*/
+	inline Vec3Packet ClosestPointOnSegment(const Vec3Packet& aPoint, const Vec3Packet& aStart, const Vec3Packet& aEnd);
+/// @brief Closest point of the triangle (aA, aB, aC) to aPoint, picked by Voronoi region.
+	inline Vec3Packet ClosestPointOnTriangle(const Vec3Packet& aPoint, const Vec3Packet& aA, const Vec3Packet& aB, const Vec3Packet& aC);
+/// @brief Closest points between the segments (aStartOne, aEndOne) and (aStartTwo, aEndTwo).
+	inline void ClosestPointsBetweenSegments(const Vec3Packet& aStartOne, const Vec3Packet& aEndOne, const Vec3Packet& aStartTwo, const Vec3Packet& aEndTwo, Vec3Packet& aOutOne, Vec3Packet& aOutTwo);
+
+	inline ContactPacket SphereSphere(const Vec3Packet& aCenterOne, Simd::Float8 aRadiusOne, const Vec3Packet& aCenterTwo, Simd::Float8 aRadiusTwo);
+	inline ContactPacket SphereCapsule(const Vec3Packet& aCenter, Simd::Float8 aRadius, const Vec3Packet& aStart, const Vec3Packet& aEnd, Simd::Float8 aCapsuleRadius);
+	inline ContactPacket CapsuleCapsule(const Vec3Packet& aStartOne, const Vec3Packet& aEndOne, Simd::Float8 aRadiusOne, const Vec3Packet& aStartTwo, const Vec3Packet& aEndTwo, Simd::Float8 aRadiusTwo);
+/**
+* @brief Separating axis test over the 3 + 3 face axes and the 9 edge cross products.
+*
+* @details aAxesOne and aAxesTwo are the unit local x, y and z axes in world space. The contact
+* normal is the axis of least penetration, the point is the vertex of box two furthest along
+* -normal. Edge axes of nearly parallel edges are skipped, the face axes cover that case.
+*/
+	inline ContactPacket ObbObb(const Vec3Packet& aCenterOne, const Vec3Packet aAxesOne[3], const Vec3Packet& aHalfExtentsOne, const Vec3Packet& aCenterTwo, const Vec3Packet aAxesTwo[3], const Vec3Packet& aHalfExtentsTwo);
+/** @} */
+
+/**
+* @name Arrays
+* @brief aCount pairs, pair i is (aOne[i], aTwo[i]). The contact arrays are resized to aCount.
+* @{
+*/
+	inline void ClosestPointsOnSegments(const Vec3f* aPoints, const Vec3f* aStarts, const Vec3f* aEnds, Vec3f* aOutPoints, size_t aCount);
+	inline void ClosestPointsOnTriangles(const Vec3f* aPoints, const Vec3f* aA, const Vec3f* aB, const Vec3f* aC, Vec3f* aOutPoints, size_t aCount);
+
+	inline void SphereSphere(const Sphere* aOne, const Sphere* aTwo, size_t aCount, ContactArray& aOutContacts);
+	inline void SphereCapsule(const Sphere* aOne, const Capsule* aTwo, size_t aCount, ContactArray& aOutContacts);
+	inline void CapsuleCapsule(const Capsule* aOne, const Capsule* aTwo, size_t aCount, ContactArray& aOutContacts);
+	inline void ObbObb(const Obb* aOne, const Obb* aTwo, size_t aCount, ContactArray& aOutContacts);
+/** @} */
+} // namespace Collision
+} // namespace BitBloom
+
+namespace BB = BitBloom;
+
+#include "Collision.inl"
@@ -0,0 +1,570 @@
+#pragma once
+#include "Collision.h"
+#include <algorithm>
+#include <cassert>
+#include <cfloat>
+
+namespace BitBloom
+{
+namespace Detail
+{
+/**
+* @name Vec3Packet arithmetic
+* @brief The Vec3f operations the collision kernels need, on eight lanes at once.
+* @{
+*/
+	inline Collision::Vec3Packet Add3(const Collision::Vec3Packet& aOne, const Collision::Vec3Packet& aTwo)
+	{
+		return { Simd::Add(aOne.x, aTwo.x), Simd::Add(aOne.y, aTwo.y), Simd::Add(aOne.z, aTwo.z) };
+	}
+
+	inline Collision::Vec3Packet Sub3(const Collision::Vec3Packet& aOne, const Collision::Vec3Packet& aTwo)
+	{
+		return { Simd::Sub(aOne.x, aTwo.x), Simd::Sub(aOne.y, aTwo.y), Simd::Sub(aOne.z, aTwo.z) };
+	}
+
+	inline Collision::Vec3Packet Scale3(const Collision::Vec3Packet& aVector, Simd::Float8 aScale)
+	{
+		return { Simd::Mul(aVector.x, aScale), Simd::Mul(aVector.y, aScale), Simd::Mul(aVector.z, aScale) };
+	}
+
+/// @brief aVector * aScale + aAddend.
+	inline Collision::Vec3Packet MulAdd3(const Collision::Vec3Packet& aVector, Simd::Float8 aScale, const Collision::Vec3Packet& aAddend)
+	{
+		return { Simd::MulAdd(aVector.x, aScale, aAddend.x), Simd::MulAdd(aVector.y, aScale, aAddend.y), Simd::MulAdd(aVector.z, aScale, aAddend.z) };
+	}
+
+	inline Simd::Float8 Dot3(const Collision::Vec3Packet& aOne, const Collision::Vec3Packet& aTwo)
+	{
+		return Simd::MulAdd(aOne.x, aTwo.x, Simd::MulAdd(aOne.y, aTwo.y, Simd::Mul(aOne.z, aTwo.z)));
+	}
+
+	inline Collision::Vec3Packet Cross3(const Collision::Vec3Packet& aOne, const Collision::Vec3Packet& aTwo)
+	{
+		return
+		{
+			Simd::Sub(Simd::Mul(aOne.y, aTwo.z), Simd::Mul(aOne.z, aTwo.y)),
+			Simd::Sub(Simd::Mul(aOne.z, aTwo.x), Simd::Mul(aOne.x, aTwo.z)),
+			Simd::Sub(Simd::Mul(aOne.x, aTwo.y), Simd::Mul(aOne.y, aTwo.x))
+		};
+	}
+
+	inline Collision::Vec3Packet Select3(Simd::Float8 aMask, const Collision::Vec3Packet& aIfTrue, const Collision::Vec3Packet& aIfFalse)
+	{
+		return { Simd::Select(aMask, aIfTrue.x, aIfFalse.x), Simd::Select(aMask, aIfTrue.y, aIfFalse.y), Simd::Select(aMask, aIfTrue.z, aIfFalse.z) };
+	}
+
+/// @brief aVector with its sign flipped in the lanes where aSign is negative.
+	inline Collision::Vec3Packet CopySign3(const Collision::Vec3Packet& aVector, Simd::Float8 aSign)
+	{
+		const Simd::Float8 signBits = Simd::And(aSign, Simd::SplatFloat8(-0.0f));
+		return { Simd::Xor(aVector.x, signBits), Simd::Xor(aVector.y, signBits), Simd::Xor(aVector.z, signBits) };
+	}
+/** @} */
+
+	inline Simd::Float8 Clamp01(Simd::Float8 aValue)
+	{
+		return Simd::Min(Simd::Max(aValue, Simd::SplatFloat8(0.0f)), Simd::SplatFloat8(1.0f));
+	}
+
+/**
+* @brief Contact of two round shapes reduced to their closest core points, the sphere centers or
+* the closest segment points, and their radii.
+*/
+	inline Collision::ContactPacket RoundContact(const Collision::Vec3Packet& aCoreOne, Simd::Float8 aRadiusOne, const Collision::Vec3Packet& aCoreTwo, Simd::Float8 aRadiusTwo)
+	{
+		using namespace BB::Simd;
+
+		const Collision::Vec3Packet delta = Sub3(aCoreTwo, aCoreOne);
+		const Float8 distance = Sqrt(Dot3(delta, delta));
+		// Coinciding cores keep the +y fallback instead of dividing by zero
+		const Float8 separated = GreaterMask(distance, SplatFloat8(FLT_EPSILON));
+		const Float8 inverseDistance = Div(SplatFloat8(1.0f), Max(distance, SplatFloat8(FLT_EPSILON)));
+		const Float8 zero = SplatFloat8(0.0f);
+		const Collision::Vec3Packet up = { zero, SplatFloat8(1.0f), zero };
+
+		Collision::ContactPacket contact;
+		contact.normal = Select3(separated, Scale3(delta, inverseDistance), up);
+		contact.depth = Sub(Simd::Add(aRadiusOne, aRadiusTwo), distance);
+		contact.point = MulAdd3(contact.normal, Sub(zero, aRadiusTwo), aCoreTwo);
+		return contact;
+	}
+
+/**
+* @brief Transposes the __m128 returned by aGetter for eight consecutive shapes into four Float8.
+*
+* @details Lanes past aCount repeat the last shape, so a partial packet never reads past the array.
+*/
+	template<class TShape, class TGetter>
+	inline void GatherPacket(const TShape* aShapes, size_t aFirst, size_t aCount, TGetter aGetter, Simd::Float8 aOutLanes[4])
+	{
+		__m128 rows[8];
+		for (size_t lane = 0; lane < 8; ++lane)
+		{
+			rows[lane] = aGetter(aShapes[std::min(aFirst + lane, aCount - 1)]);
+		}
+		_MM_TRANSPOSE4_PS(rows[0], rows[1], rows[2], rows[3]);
+		_MM_TRANSPOSE4_PS(rows[4], rows[5], rows[6], rows[7]);
+		for (int component = 0; component < 4; ++component)
+		{
+			aOutLanes[component] = Simd::CombineFloat8(rows[component], rows[component + 4]);
+		}
+	}
+
+	template<class TShape, class TGetter>
+	inline Collision::Vec3Packet GatherVec3(const TShape* aShapes, size_t aFirst, size_t aCount, TGetter aGetter)
+	{
+		Simd::Float8 lanes[4];
+		GatherPacket(aShapes, aFirst, aCount, aGetter, lanes);
+		return { lanes[0], lanes[1], lanes[2] };
+	}
+
+/// @brief Gathers a Vec3f and a float stored in its w lane, e.g. a sphere center and radius.
+	inline __m128 WithW(const Vec3f& aVector, float aW)
+	{
+		return _mm_blend_ps(aVector.data, _mm_set1_ps(aW), 0x8);
+	}
+
+/// @brief Writes the valid lanes of aPacket to aOut[aFirst] onwards as Vec3f with w = 0.
+	inline void ScatterVec3(const Collision::Vec3Packet& aPacket, Vec3f* aOut, size_t aFirst, size_t aCount)
+	{
+		const Simd::Float8 components[3] = { aPacket.x, aPacket.y, aPacket.z };
+		__m128 low[4], high[4];
+		for (int component = 0; component < 3; ++component)
+		{
+			low[component] = Simd::GetLowHalf(components[component]);
+			high[component] = Simd::GetHighHalf(components[component]);
+		}
+		low[3] = _mm_setzero_ps();
+		high[3] = _mm_setzero_ps();
+		_MM_TRANSPOSE4_PS(low[0], low[1], low[2], low[3]);
+		_MM_TRANSPOSE4_PS(high[0], high[1], high[2], high[3]);
+
+		const size_t valid = std::min<size_t>(8, aCount - aFirst);
+		for (size_t lane = 0; lane < valid; ++lane)
+		{
+			aOut[aFirst + lane].data = lane < 4 ? low[lane] : high[lane - 4];
+		}
+	}
+
+/// @brief The world space x, y and z axes of eight unit quaternions.
+	inline void QuaternionAxes(Simd::Float8 aX, Simd::Float8 aY, Simd::Float8 aZ, Simd::Float8 aW, Collision::Vec3Packet aOutAxes[3])
+	{
+		using namespace BB::Simd;
+
+		const Float8 one = SplatFloat8(1.0f);
+		const Float8 two = SplatFloat8(2.0f);
+		const Float8 xx = Mul(aX, aX), yy = Mul(aY, aY), zz = Mul(aZ, aZ);
+		const Float8 xy = Mul(aX, aY), xz = Mul(aX, aZ), yz = Mul(aY, aZ);
+		const Float8 wx = Mul(aW, aX), wy = Mul(aW, aY), wz = Mul(aW, aZ);
+
+		aOutAxes[0] = { Sub(one, Mul(two, Simd::Add(yy, zz))), Mul(two, Simd::Add(xy, wz)), Mul(two, Sub(xz, wy)) };
+		aOutAxes[1] = { Mul(two, Sub(xy, wz)), Sub(one, Mul(two, Simd::Add(xx, zz))), Mul(two, Simd::Add(yz, wx)) };
+		aOutAxes[2] = { Mul(two, Simd::Add(xz, wy)), Mul(two, Sub(yz, wx)), Sub(one, Mul(two, Simd::Add(xx, yy))) };
+	}
+} // namespace Detail
+
+namespace Collision
+{
+	inline ContactArray::ContactArray(size_t aCount)
+	{
+		Resize(aCount);
+	}
+
+	inline void ContactArray::Resize(size_t aCount)
+	{
+		// Padded to whole packets so StorePacket can always write eight lanes
+		const size_t paddedCount = (aCount + 7) & ~size_t(7);
+		for (AlignedVector<float, CACHE_LINE_SIZE>& stream : myStreams)
+		{
+			stream.resize(paddedCount);
+		}
+		myCount = aCount;
+	}
+
+	inline size_t ContactArray::GetCount() const
+	{
+		return myCount;
+	}
+
+	inline size_t ContactArray::CountTouching() const
+	{
+		return size_t(std::count_if(myStreams[DEPTH].begin(), myStreams[DEPTH].begin() + myCount, [](float aDepth) { return aDepth > 0.0f; }));
+	}
+
+	inline Vec3f ContactArray::GetNormal(size_t aIndex) const
+	{
+		assert(aIndex < myCount);
+		return Vec3f(myStreams[NORMAL_X][aIndex], myStreams[NORMAL_Y][aIndex], myStreams[NORMAL_Z][aIndex]);
+	}
+
+	inline Vec3f ContactArray::GetPoint(size_t aIndex) const
+	{
+		assert(aIndex < myCount);
+		return Vec3f(myStreams[POINT_X][aIndex], myStreams[POINT_Y][aIndex], myStreams[POINT_Z][aIndex]);
+	}
+
+	inline float ContactArray::GetDepth(size_t aIndex) const
+	{
+		assert(aIndex < myCount);
+		return myStreams[DEPTH][aIndex];
+	}
+
+	inline bool ContactArray::IsTouching(size_t aIndex) const
+	{
+		return GetDepth(aIndex) > 0.0f;
+	}
+
+	inline void ContactArray::StorePacket(size_t aIndex, const ContactPacket& aContacts)
+	{
+		assert(aIndex % 8 == 0 && aIndex < myStreams[DEPTH].size());
+		Simd::StoreFloat8(myStreams[NORMAL_X].data() + aIndex, aContacts.normal.x);
+		Simd::StoreFloat8(myStreams[NORMAL_Y].data() + aIndex, aContacts.normal.y);
+		Simd::StoreFloat8(myStreams[NORMAL_Z].data() + aIndex, aContacts.normal.z);
+		Simd::StoreFloat8(myStreams[POINT_X].data() + aIndex, aContacts.point.x);
+		Simd::StoreFloat8(myStreams[POINT_Y].data() + aIndex, aContacts.point.y);
+		Simd::StoreFloat8(myStreams[POINT_Z].data() + aIndex, aContacts.point.z);
+		Simd::StoreFloat8(myStreams[DEPTH].data() + aIndex, aContacts.depth);
+	}
+
+	inline const float* ContactArray::GetNormalsX() const
+	{
+		return myStreams[NORMAL_X].data();
+	}
+
+	inline const float* ContactArray::GetNormalsY() const
+	{
+		return myStreams[NORMAL_Y].data();
+	}
+
+	inline const float* ContactArray::GetNormalsZ() const
+	{
+		return myStreams[NORMAL_Z].data();
+	}
+
+	inline const float* ContactArray::GetPointsX() const
+	{
+		return myStreams[POINT_X].data();
+	}
+
+	inline const float* ContactArray::GetPointsY() const
+	{
+		return myStreams[POINT_Y].data();
+	}
+
+	inline const float* ContactArray::GetPointsZ() const
+	{
+		return myStreams[POINT_Z].data();
+	}
+
+	inline const float* ContactArray::GetDepths() const
+	{
+		return myStreams[DEPTH].data();
+	}
+
+	inline Vec3Packet ClosestPointOnSegment(const Vec3Packet& aPoint, const Vec3Packet& aStart, const Vec3Packet& aEnd)
+	{
+		using namespace BB::Simd;
+
+		const Vec3Packet segment = Detail::Sub3(aEnd, aStart);
+		// A zero length segment divides 0 by FLT_MIN and returns the start
+		const Float8 lengthSquared = Max(Detail::Dot3(segment, segment), SplatFloat8(FLT_MIN));
+		const Float8 t = Detail::Clamp01(Div(Detail::Dot3(Detail::Sub3(aPoint, aStart), segment), lengthSquared));
+		return Detail::MulAdd3(segment, t, aStart);
+	}
+
+	inline Vec3Packet ClosestPointOnTriangle(const Vec3Packet& aPoint, const Vec3Packet& aA, const Vec3Packet& aB, const Vec3Packet& aC)
+	{
+		using namespace BB::Simd;
+
+		// The Voronoi region tests of Real-Time Collision Detection 5.1.5. Every region is
+		// evaluated as barycentric weights (v, w) of B and C, then the first matching region wins.
+		const Vec3Packet ab = Detail::Sub3(aB, aA);
+		const Vec3Packet ac = Detail::Sub3(aC, aA);
+		const Vec3Packet ap = Detail::Sub3(aPoint, aA);
+		const Vec3Packet bp = Detail::Sub3(aPoint, aB);
+		const Vec3Packet cp = Detail::Sub3(aPoint, aC);
+		const Float8 d1 = Detail::Dot3(ab, ap);
+		const Float8 d2 = Detail::Dot3(ac, ap);
+		const Float8 d3 = Detail::Dot3(ab, bp);
+		const Float8 d4 = Detail::Dot3(ac, bp);
+		const Float8 d5 = Detail::Dot3(ab, cp);
+		const Float8 d6 = Detail::Dot3(ac, cp);
+		const Float8 va = Sub(Mul(d3, d6), Mul(d5, d4));
+		const Float8 vb = Sub(Mul(d5, d2), Mul(d1, d6));
+		const Float8 vc = Sub(Mul(d1, d4), Mul(d3, d2));
+
+		const Float8 zero = SplatFloat8(0.0f);
+		const Float8 one = SplatFloat8(1.0f);
+		const Float8 tiny = SplatFloat8(FLT_MIN);
+
+		// Interior
+		const Float8 inverseArea = Div(one, Max(Simd::Add(va, Simd::Add(vb, vc)), tiny));
+		Float8 v = Mul(vb, inverseArea);
+		Float8 w = Mul(vc, inverseArea);
+
+		// Edge BC
+		const Float8 edgeBC = And(GreaterEqualMask(zero, va), And(GreaterEqualMask(d4, d3), GreaterEqualMask(d5, d6)));
+		const Float8 weightBC = Div(Sub(d4, d3), Max(Simd::Add(Sub(d4, d3), Sub(d5, d6)), tiny));
+		v = Select(edgeBC, Sub(one, weightBC), v);
+		w = Select(edgeBC, weightBC, w);
+
+		// Edge AC
+		const Float8 edgeAC = And(GreaterEqualMask(zero, vb), And(GreaterEqualMask(d2, zero), GreaterEqualMask(zero, d6)));
+		v = Select(edgeAC, zero, v);
+		w = Select(edgeAC, Div(d2, Max(Sub(d2, d6), tiny)), w);
+
+		// Vertex C
+		const Float8 vertexC = And(GreaterEqualMask(d6, zero), GreaterEqualMask(d6, d5));
+		v = Select(vertexC, zero, v);
+		w = Select(vertexC, one, w);
+
+		// Edge AB
+		const Float8 edgeAB = And(GreaterEqualMask(zero, vc), And(GreaterEqualMask(d1, zero), GreaterEqualMask(zero, d3)));
+		v = Select(edgeAB, Div(d1, Max(Sub(d1, d3), tiny)), v);
+		w = Select(edgeAB, zero, w);
+
+		// Vertex B
+		const Float8 vertexB = And(GreaterEqualMask(d3, zero), GreaterEqualMask(d3, d4));
+		v = Select(vertexB, one, v);
+		w = Select(vertexB, zero, w);
+
+		// Vertex A
+		const Float8 vertexA = And(GreaterEqualMask(zero, d1), GreaterEqualMask(zero, d2));
+		v = Select(vertexA, zero, v);
+		w = Select(vertexA, zero, w);
+
+		return Detail::MulAdd3(ac, w, Detail::MulAdd3(ab, v, aA));
+	}
+
+	inline void ClosestPointsBetweenSegments(const Vec3Packet& aStartOne, const Vec3Packet& aEndOne, const Vec3Packet& aStartTwo, const Vec3Packet& aEndTwo, Vec3Packet& aOutOne, Vec3Packet& aOutTwo)
+	{
+		using namespace BB::Simd;
+
+		// Real-Time Collision Detection 5.1.9 with the degenerate and clamping branches as selects
+		const Vec3Packet directionOne = Detail::Sub3(aEndOne, aStartOne);
+		const Vec3Packet directionTwo = Detail::Sub3(aEndTwo, aStartTwo);
+		const Vec3Packet startDelta = Detail::Sub3(aStartOne, aStartTwo);
+		const Float8 a = Detail::Dot3(directionOne, directionOne);
+		const Float8 b = Detail::Dot3(directionOne, directionTwo);
+		const Float8 c = Detail::Dot3(directionOne, startDelta);
+		const Float8 e = Detail::Dot3(directionTwo, directionTwo);
+		const Float8 f = Detail::Dot3(directionTwo, startDelta);
+
+		const Float8 zero = SplatFloat8(0.0f);
+		const Float8 one = SplatFloat8(1.0f);
+		const Float8 epsilon = SplatFloat8(FLT_EPSILON);
+		const Float8 safeA = Max(a, epsilon);
+		const Float8 safeE = Max(e, epsilon);
+
+		// Parallel segments (denominator 0) start from s = 0
+		const Float8 denominator = Sub(Mul(a, e), Mul(b, b));
+		const Float8 notParallel = GreaterMask(denominator, Mul(epsilon, Mul(a, e)));
+		Float8 s = Select(notParallel, Detail::Clamp01(Div(Sub(Mul(b, f), Mul(c, e)), Max(denominator, SplatFloat8(FLT_MIN)))), zero);
+		const Float8 t = Div(MulAdd(b, s, f), safeE);
+
+		// t outside [0, 1] is clamped and s recomputed for it, a point-like second segment always has t = 0
+		const Float8 clampHigh = GreaterMask(t, one);
+		const Float8 clampLow = Or(GreaterMask(zero, t), GreaterEqualMask(epsilon, e));
+		s = Select(clampHigh, Detail::Clamp01(Div(Sub(b, c), safeA)), s);
+		s = Select(clampLow, Detail::Clamp01(Div(Sub(zero, c), safeA)), s);
+		const Float8 clampedT = Select(clampLow, zero, Select(clampHigh, one, t));
+
+		aOutOne = Detail::MulAdd3(directionOne, s, aStartOne);
+		aOutTwo = Detail::MulAdd3(directionTwo, clampedT, aStartTwo);
+	}
+
+	inline ContactPacket SphereSphere(const Vec3Packet& aCenterOne, Simd::Float8 aRadiusOne, const Vec3Packet& aCenterTwo, Simd::Float8 aRadiusTwo)
+	{
+		return Detail::RoundContact(aCenterOne, aRadiusOne, aCenterTwo, aRadiusTwo);
+	}
+
+	inline ContactPacket SphereCapsule(const Vec3Packet& aCenter, Simd::Float8 aRadius, const Vec3Packet& aStart, const Vec3Packet& aEnd, Simd::Float8 aCapsuleRadius)
+	{
+		return Detail::RoundContact(aCenter, aRadius, ClosestPointOnSegment(aCenter, aStart, aEnd), aCapsuleRadius);
+	}
+
+	inline ContactPacket CapsuleCapsule(const Vec3Packet& aStartOne, const Vec3Packet& aEndOne, Simd::Float8 aRadiusOne, const Vec3Packet& aStartTwo, const Vec3Packet& aEndTwo, Simd::Float8 aRadiusTwo)
+	{
+		Vec3Packet closestOne;
+		Vec3Packet closestTwo;
+		ClosestPointsBetweenSegments(aStartOne, aEndOne, aStartTwo, aEndTwo, closestOne, closestTwo);
+		return Detail::RoundContact(closestOne, aRadiusOne, closestTwo, aRadiusTwo);
+	}
+
+	inline ContactPacket ObbObb(const Vec3Packet& aCenterOne, const Vec3Packet aAxesOne[3], const Vec3Packet& aHalfExtentsOne, const Vec3Packet& aCenterTwo, const Vec3Packet aAxesTwo[3], const Vec3Packet& aHalfExtentsTwo)
+	{
+		using namespace BB::Simd;
+
+		const Float8 extentsOne[3] = { aHalfExtentsOne.x, aHalfExtentsOne.y, aHalfExtentsOne.z };
+		const Float8 extentsTwo[3] = { aHalfExtentsTwo.x, aHalfExtentsTwo.y, aHalfExtentsTwo.z };
+		const Vec3Packet delta = Detail::Sub3(aCenterTwo, aCenterOne);
+
+		// rotation[i][j] = axisOne_i . axisTwo_j, the epsilon keeps near parallel edges from
+		// producing a false separating axis
+		Float8 rotation[3][3];
+		Float8 absRotation[3][3];
+		const Float8 epsilon = SplatFloat8(1e-6f);
+		for (int i = 0; i < 3; ++i)
+		{
+			for (int j = 0; j < 3; ++j)
+			{
+				rotation[i][j] = Detail::Dot3(aAxesOne[i], aAxesTwo[j]);
+				absRotation[i][j] = Simd::Add(Abs(rotation[i][j]), epsilon);
+			}
+		}
+
+		ContactPacket contact;
+		contact.depth = SplatFloat8(FLT_MAX);
+		contact.normal = { SplatFloat8(0.0f), SplatFloat8(1.0f), SplatFloat8(0.0f) };
+		// Keeps the axis with the least overlap, the normal points along delta
+		const auto consider = [&](Float8 aOverlap, const Vec3Packet& aAxis, Float8 aProjectedDelta)
+		{
+			const Float8 better = GreaterMask(contact.depth, aOverlap);
+			contact.depth = Select(better, aOverlap, contact.depth);
+			contact.normal = Detail::Select3(better, Detail::CopySign3(aAxis, aProjectedDelta), contact.normal);
+		};
+
+		Float8 deltaOne[3];
+		for (int i = 0; i < 3; ++i)
+		{
+			deltaOne[i] = Detail::Dot3(delta, aAxesOne[i]);
+			const Float8 radiusTwo = MulAdd(extentsTwo[0], absRotation[i][0], MulAdd(extentsTwo[1], absRotation[i][1], Mul(extentsTwo[2], absRotation[i][2])));
+			consider(Sub(Simd::Add(extentsOne[i], radiusTwo), Abs(deltaOne[i])), aAxesOne[i], deltaOne[i]);
+		}
+
+		for (int j = 0; j < 3; ++j)
+		{
+			const Float8 deltaTwo = Detail::Dot3(delta, aAxesTwo[j]);
+			const Float8 radiusOne = MulAdd(extentsOne[0], absRotation[0][j], MulAdd(extentsOne[1], absRotation[1][j], Mul(extentsOne[2], absRotation[2][j])));
+			consider(Sub(Simd::Add(radiusOne, extentsTwo[j]), Abs(deltaTwo)), aAxesTwo[j], deltaTwo);
+		}
+
+		// Edge axes axisOne_i x axisTwo_j, with the projections written in the frame of box one.
+		// The overlap is divided by the axis length so it is comparable to the face axes.
+		const Float8 minimumLength = SplatFloat8(1e-3f);
+		for (int i = 0; i < 3; ++i)
+		{
+			const int i1 = (i + 1) % 3;
+			const int i2 = (i + 2) % 3;
+			for (int j = 0; j < 3; ++j)
+			{
+				const int j1 = (j + 1) % 3;
+				const int j2 = (j + 2) % 3;
+				const Vec3Packet axis = Detail::Cross3(aAxesOne[i], aAxesTwo[j]);
+				const Float8 length = Sqrt(Detail::Dot3(axis, axis));
+
+				const Float8 radiusOne = MulAdd(extentsOne[i1], absRotation[i2][j], Mul(extentsOne[i2], absRotation[i1][j]));
+				const Float8 radiusTwo = MulAdd(extentsTwo[j1], absRotation[i][j2], Mul(extentsTwo[j2], absRotation[i][j1]));
+				const Float8 projectedDelta = Sub(Mul(deltaOne[i2], rotation[i1][j]), Mul(deltaOne[i1], rotation[i2][j]));
+				const Float8 inverseLength = Div(SplatFloat8(1.0f), Max(length, minimumLength));
+				const Float8 overlap = Mul(Sub(Simd::Add(radiusOne, radiusTwo), Abs(projectedDelta)), inverseLength);
+
+				// Near parallel edges have no meaningful cross product, the face axes decide there
+				const Float8 valid = GreaterMask(length, minimumLength);
+				consider(Select(valid, overlap, SplatFloat8(FLT_MAX)), Detail::Scale3(axis, inverseLength), projectedDelta);
+			}
+		}
+
+		// Deepest vertex of box two, walking every half extent against the normal
+		contact.point = aCenterTwo;
+		for (int j = 0; j < 3; ++j)
+		{
+			const Float8 towardsOne = Sub(SplatFloat8(0.0f), Detail::Dot3(contact.normal, aAxesTwo[j]));
+			contact.point = Detail::MulAdd3(Detail::CopySign3(aAxesTwo[j], towardsOne), extentsTwo[j], contact.point);
+		}
+		return contact;
+	}
+
+	inline void ClosestPointsOnSegments(const Vec3f* aPoints, const Vec3f* aStarts, const Vec3f* aEnds, Vec3f* aOutPoints, size_t aCount)
+	{
+		const auto vector = [](const Vec3f& aVector) { return aVector.data; };
+		for (size_t first = 0; first < aCount; first += 8)
+		{
+			const Vec3Packet closest = ClosestPointOnSegment(Detail::GatherVec3(aPoints, first, aCount, vector), Detail::GatherVec3(aStarts, first, aCount, vector), Detail::GatherVec3(aEnds, first, aCount, vector));
+			Detail::ScatterVec3(closest, aOutPoints, first, aCount);
+		}
+	}
+
+	inline void ClosestPointsOnTriangles(const Vec3f* aPoints, const Vec3f* aA, const Vec3f* aB, const Vec3f* aC, Vec3f* aOutPoints, size_t aCount)
+	{
+		const auto vector = [](const Vec3f& aVector) { return aVector.data; };
+		for (size_t first = 0; first < aCount; first += 8)
+		{
+			const Vec3Packet closest = ClosestPointOnTriangle(Detail::GatherVec3(aPoints, first, aCount, vector), Detail::GatherVec3(aA, first, aCount, vector),
+				Detail::GatherVec3(aB, first, aCount, vector), Detail::GatherVec3(aC, first, aCount, vector));
+			Detail::ScatterVec3(closest, aOutPoints, first, aCount);
+		}
+	}
+
+	inline void SphereSphere(const Sphere* aOne, const Sphere* aTwo, size_t aCount, ContactArray& aOutContacts)
+	{
+		aOutContacts.Resize(aCount);
+		const auto sphere = [](const Sphere& aSphere) { return Detail::WithW(aSphere.center, aSphere.radius); };
+		for (size_t first = 0; first < aCount; first += 8)
+		{
+			Simd::Float8 one[4];
+			Simd::Float8 two[4];
+			Detail::GatherPacket(aOne, first, aCount, sphere, one);
+			Detail::GatherPacket(aTwo, first, aCount, sphere, two);
+			aOutContacts.StorePacket(first, SphereSphere({ one[0], one[1], one[2] }, one[3], { two[0], two[1], two[2] }, two[3]));
+		}
+	}
+
+	inline void SphereCapsule(const Sphere* aOne, const Capsule* aTwo, size_t aCount, ContactArray& aOutContacts)
+	{
+		aOutContacts.Resize(aCount);
+		const auto sphere = [](const Sphere& aSphere) { return Detail::WithW(aSphere.center, aSphere.radius); };
+		const auto capsuleStart = [](const Capsule& aCapsule) { return Detail::WithW(aCapsule.start, aCapsule.radius); };
+		const auto capsuleEnd = [](const Capsule& aCapsule) { return aCapsule.end.data; };
+		for (size_t first = 0; first < aCount; first += 8)
+		{
+			Simd::Float8 one[4];
+			Simd::Float8 start[4];
+			Detail::GatherPacket(aOne, first, aCount, sphere, one);
+			Detail::GatherPacket(aTwo, first, aCount, capsuleStart, start);
+			const Vec3Packet end = Detail::GatherVec3(aTwo, first, aCount, capsuleEnd);
+			aOutContacts.StorePacket(first, SphereCapsule({ one[0], one[1], one[2] }, one[3], { start[0], start[1], start[2] }, end, start[3]));
+		}
+	}
+
+	inline void CapsuleCapsule(const Capsule* aOne, const Capsule* aTwo, size_t aCount, ContactArray& aOutContacts)
+	{
+		aOutContacts.Resize(aCount);
+		const auto capsuleStart = [](const Capsule& aCapsule) { return Detail::WithW(aCapsule.start, aCapsule.radius); };
+		const auto capsuleEnd = [](const Capsule& aCapsule) { return aCapsule.end.data; };
+		for (size_t first = 0; first < aCount; first += 8)
+		{
+			Simd::Float8 startOne[4];
+			Simd::Float8 startTwo[4];
+			Detail::GatherPacket(aOne, first, aCount, capsuleStart, startOne);
+			Detail::GatherPacket(aTwo, first, aCount, capsuleStart, startTwo);
+			const Vec3Packet endOne = Detail::GatherVec3(aOne, first, aCount, capsuleEnd);
+			const Vec3Packet endTwo = Detail::GatherVec3(aTwo, first, aCount, capsuleEnd);
+			aOutContacts.StorePacket(first, CapsuleCapsule({ startOne[0], startOne[1], startOne[2] }, endOne, startOne[3], { startTwo[0], startTwo[1], startTwo[2] }, endTwo, startTwo[3]));
+		}
+	}
+
+	inline void ObbObb(const Obb* aOne, const Obb* aTwo, size_t aCount, ContactArray& aOutContacts)
+	{
+		aOutContacts.Resize(aCount);
+		const auto center = [](const Obb& aBox) { return aBox.center.data; };
+		const auto halfExtents = [](const Obb& aBox) { return aBox.halfExtents.data; };
+		const auto orientation = [](const Obb& aBox) { return aBox.orientation.data; };
+		for (size_t first = 0; first < aCount; first += 8)
+		{
+			Simd::Float8 rotationOne[4];
+			Simd::Float8 rotationTwo[4];
+			Detail::GatherPacket(aOne, first, aCount, orientation, rotationOne);
+			Detail::GatherPacket(aTwo, first, aCount, orientation, rotationTwo);
+			Vec3Packet axesOne[3];
+			Vec3Packet axesTwo[3];
+			Detail::QuaternionAxes(rotationOne[0], rotationOne[1], rotationOne[2], rotationOne[3], axesOne);
+			Detail::QuaternionAxes(rotationTwo[0], rotationTwo[1], rotationTwo[2], rotationTwo[3], axesTwo);
+
+			aOutContacts.StorePacket(first, ObbObb(Detail::GatherVec3(aOne, first, aCount, center), axesOne, Detail::GatherVec3(aOne, first, aCount, halfExtents),
+				Detail::GatherVec3(aTwo, first, aCount, center), axesTwo, Detail::GatherVec3(aTwo, first, aCount, halfExtents)));
+		}
+	}
+} // namespace Collision
+} // namespace BitBloom
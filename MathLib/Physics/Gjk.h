@@ -0,0 +1,111 @@
+#pragma once
+#include <cstddef>
+#include "../Util/Float8.h"
+#include "../Vector/Vector3f/Vector3f.h"
+#include "../Quaternion/Quatf/Quatf.h"
+#include "Collision.h"
+
+/**
+ * @file Gjk.h
+ * @brief GJK distance and intersection queries and EPA penetration depth for any convex shapes.
+ *
+ * @details The queries only see the shapes through support mappings, the point of the shape
+ * furthest along a direction. They call `Support(aShape, aDirection)` unqualified, so a custom
+ * shape plugs in by declaring that function in its own namespace (found by argument dependent
+ * lookup) or in BB::Collision. Mappings for Sphere, Capsule, Obb and ConvexHull are provided.
+ * The direction passed in is not normalized and may be zero.
+ *
+ * Spheres and capsules run GJK on their center point or segment and the radii are applied to
+ * the result, curved surfaces give a new support point on every iteration and converge slowly.
+ * Other curved custom shapes may still stop at GJK_MAX_ITERATIONS, GjkResult::converged tells.
+ * Touching is judged relative to the size of the support points, not an absolute distance, and
+ * GJK stops as soon as an iteration no longer brings the simplex closer to the origin.
+ *
+ * Nothing is allocated, the GJK simplex and the EPA polytope live in fixed size arrays on the
+ * stack. EPA stops at EPA_MAX_VERTICES and returns the best face found so far.
+ *
+ * A GjkCache passed to the queries is filled with the directions that produced the final simplex.
+ * The next query on the same pair starts from the support points along those directions, so for
+ * shapes that moved a little since the last frame GJK usually converges in one or two iterations.
+ *
+ * Results follow the Collision.h contact convention: the normal points from shape one towards
+ * shape two and the contact point is the point of shape two deepest inside shape one.
+ */
+
+namespace BitBloom
+{
+namespace Collision
+{
+	constexpr int GJK_MAX_ITERATIONS = 32;
+	constexpr int EPA_MAX_VERTICES = 64;
+	constexpr int EPA_MAX_FACES = 2 * EPA_MAX_VERTICES;
+
+/**
+* @brief Convex hull given by its vertices in local space, placed by position and orientation.
+*
+* @details The vertices are not owned. Support scans them eight at a time with SIMD dot products,
+* so any point cloud works, interior points only cost scanning time.
+*/
+	struct ConvexHull
+	{
+		const Vec3f* vertices = nullptr;
+		size_t count = 0;
+		Vec3f position;
+		Quatf orientation;
+	};
+
+/// @brief The directions of the last simplex of a shape pair, see the file description.
+	struct GjkCache
+	{
+		Vec3f directions[4];
+		int count = 0;
+	};
+
+	struct GjkResult
+	{
+		bool intersecting = false;
+/// @brief Distance between the shapes, 0 when they intersect.
+		float distance = 0.0f;
+/// @brief Closest point on shape one, only set for separated shapes.
+		Vec3f pointOne;
+/// @brief Closest point on shape two, only set for separated shapes.
+		Vec3f pointTwo;
+		int iterations = 0;
+/// @brief False when GJK stopped at GJK_MAX_ITERATIONS, the distance and points are then the closest found so far.
+		bool converged = true;
+	};
+
+	struct PenetrationResult
+	{
+		Vec3f normal;
+		Vec3f point;
+		float depth = 0.0f;
+	};
+
+/**
+* @name Support mappings
+* @{
+*/
+	inline Vec3f Support(const Sphere& aSphere, const Vec3f& aDirection);
+	inline Vec3f Support(const Capsule& aCapsule, const Vec3f& aDirection);
+	inline Vec3f Support(const Obb& aBox, const Vec3f& aDirection);
+	inline Vec3f Support(const ConvexHull& aHull, const Vec3f& aDirection);
+/// @brief Index of the vertex with the largest dot product with aDirection, the first one on ties.
+	inline size_t SupportIndex(const Vec3f* aVertices, size_t aCount, const Vec3f& aDirection);
+/** @} */
+
+/// @brief Distance and closest points of two convex shapes.
+	template<class TShapeOne, class TShapeTwo>
+	inline GjkResult GjkDistance(const TShapeOne& aOne, const TShapeTwo& aTwo, GjkCache* aCache = nullptr);
+/// @brief Intersection only, stops as soon as a separating direction is found.
+	template<class TShapeOne, class TShapeTwo>
+	inline bool GjkIntersect(const TShapeOne& aOne, const TShapeTwo& aTwo, GjkCache* aCache = nullptr);
+/// @brief Runs GJK and, when the shapes intersect, EPA. Returns false for separated shapes.
+	template<class TShapeOne, class TShapeTwo>
+	inline bool Penetration(const TShapeOne& aOne, const TShapeTwo& aTwo, PenetrationResult& aOutResult, GjkCache* aCache = nullptr);
+} // namespace Collision
+} // namespace BitBloom
+
+namespace BB = BitBloom;
+
+#include "Gjk.inl"
@@ -0,0 +1,789 @@
+#pragma once
+#include "Gjk.h"
+#include <algorithm>
+#include <cassert>
+#include <cfloat>
+#include <cmath>
+
+namespace BitBloom
+{
+namespace Detail
+{
+/// @brief A point of the Minkowski difference one - two with the support points and direction it came from.
+	struct GjkVertex
+	{
+		Vec3f one;
+		Vec3f two;
+		Vec3f point;
+		Vec3f direction;
+	};
+
+/// @brief Up to four vertices and the barycentric weights of the point closest to the origin.
+	struct GjkSimplex
+	{
+		GjkVertex vertices[4];
+		float weights[4] = {};
+		int count = 0;
+	};
+
+	constexpr float GJK_RELATIVE_TOLERANCE = 1e-6f;
+	// Squared distance, relative to the squared magnitude of the support points, below which shapes touch
+	constexpr float GJK_TOUCHING_RELATIVE_SQUARED = 1e-10f;
+	// Six times the volume relative to the cube of the longest edge below which a tetrahedron is flat
+	constexpr float GJK_FLAT_TETRAHEDRON = 1e-5f;
+	constexpr float EPA_TOLERANCE = 1e-4f;
+	constexpr float EPA_DEGENERATE_DISTANCE = 1e-5f;
+
+	template<class TShapeOne, class TShapeTwo>
+	inline GjkVertex MinkowskiSupport(const TShapeOne& aOne, const TShapeTwo& aTwo, const Vec3f& aDirection)
+	{
+		using Collision::Support;
+
+		GjkVertex vertex;
+		vertex.one = Support(aOne, aDirection);
+		vertex.two = Support(aTwo, -aDirection);
+		vertex.point = vertex.one - vertex.two;
+		vertex.direction = aDirection;
+		return vertex;
+	}
+
+/**
+* @brief The shape GJK runs on and the radius swept around it.
+*
+* @details Spheres and capsules run as their center point or segment and the radii are added
+* afterwards. Their curved surfaces would otherwise feed GJK a new support point every iteration
+* and it converges slowly, if at all within float precision.
+*/
+	template<class TShape>
+	struct GjkCore
+	{
+		static constexpr bool ROUNDED = false;
+		static const TShape& GetShape(const TShape& aShape) { return aShape; }
+		static float GetRadius(const TShape&) { return 0.0f; }
+	};
+
+	template<>
+	struct GjkCore<Collision::Sphere>
+	{
+		static constexpr bool ROUNDED = true;
+		static Collision::Sphere GetShape(const Collision::Sphere& aSphere) { return { aSphere.center, 0.0f }; }
+		static float GetRadius(const Collision::Sphere& aSphere) { return aSphere.radius; }
+	};
+
+	template<>
+	struct GjkCore<Collision::Capsule>
+	{
+		static constexpr bool ROUNDED = true;
+		static Collision::Capsule GetShape(const Collision::Capsule& aCapsule) { return { aCapsule.start, aCapsule.end, 0.0f }; }
+		static float GetRadius(const Collision::Capsule& aCapsule) { return aCapsule.radius; }
+	};
+
+/// @brief How the GJK loop ended.
+	enum class GjkExit
+	{
+		// The origin is inside the simplex or within the touching tolerance of it
+		Intersecting,
+		// The simplex holds the feature closest to the origin
+		Closest,
+		// Early out only, a direction separates the shapes by more than the margin
+		Separating,
+		// GJK_MAX_ITERATIONS reached, the simplex holds the closest feature found so far
+		IterationLimit
+	};
+
+/// @brief Replaces the simplex with aCount of its vertices, given by index, and their weights.
+	inline void KeepVertices(GjkSimplex& aSimplex, int aCount, const int aIndices[], const float aWeights[])
+	{
+		GjkVertex kept[4];
+		for (int vertex = 0; vertex < aCount; ++vertex)
+		{
+			kept[vertex] = aSimplex.vertices[aIndices[vertex]];
+		}
+		for (int vertex = 0; vertex < aCount; ++vertex)
+		{
+			aSimplex.vertices[vertex] = kept[vertex];
+			aSimplex.weights[vertex] = aWeights[vertex];
+		}
+		aSimplex.count = aCount;
+	}
+
+	inline Vec3f SimplexPoint(const GjkSimplex& aSimplex)
+	{
+		Vec3f point(0.0f);
+		for (int vertex = 0; vertex < aSimplex.count; ++vertex)
+		{
+			point += aSimplex.vertices[vertex].point * aSimplex.weights[vertex];
+		}
+		return point;
+	}
+
+/// @brief Parameter of the point of segment (aA, aB) closest to the origin.
+	inline float SegmentParameter(const Vec3f& aA, const Vec3f& aB)
+	{
+		const Vec3f segment = aB - aA;
+		const float lengthSquared = segment.Dot(segment);
+		if (lengthSquared <= 0.0f)
+		{
+			return 0.0f;
+		}
+		return std::fmin(std::fmax(-aA.Dot(segment) / lengthSquared, 0.0f), 1.0f);
+	}
+
+	inline void SolveSegment(GjkSimplex& aSimplex, int aFirst, int aSecond)
+	{
+		const float t = SegmentParameter(aSimplex.vertices[aFirst].point, aSimplex.vertices[aSecond].point);
+		const int indices[2] = { aFirst, aSecond };
+		if (t <= 0.0f || t >= 1.0f)
+		{
+			const float one[1] = { 1.0f };
+			KeepVertices(aSimplex, 1, t <= 0.0f ? indices : indices + 1, one);
+			return;
+		}
+		const float weights[2] = { 1.0f - t, t };
+		KeepVertices(aSimplex, 2, indices, weights);
+	}
+
+/// @brief Closest point of the triangle (aA, aB, aC) to the origin by Voronoi region, Real-Time Collision Detection 5.1.5.
+	inline void SolveTriangle(GjkSimplex& aSimplex, int aA, int aB, int aC)
+	{
+		const Vec3f a = aSimplex.vertices[aA].point;
+		const Vec3f b = aSimplex.vertices[aB].point;
+		const Vec3f c = aSimplex.vertices[aC].point;
+		const Vec3f ab = b - a;
+		const Vec3f ac = c - a;
+		const float one[1] = { 1.0f };
+
+		const float d1 = -ab.Dot(a);
+		const float d2 = -ac.Dot(a);
+		if (d1 <= 0.0f && d2 <= 0.0f)
+		{
+			KeepVertices(aSimplex, 1, &aA, one);
+			return;
+		}
+
+		const float d3 = -ab.Dot(b);
+		const float d4 = -ac.Dot(b);
+		if (d3 >= 0.0f && d4 <= d3)
+		{
+			KeepVertices(aSimplex, 1, &aB, one);
+			return;
+		}
+
+		const float vc = d1 * d4 - d3 * d2;
+		if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f)
+		{
+			SolveSegment(aSimplex, aA, aB);
+			return;
+		}
+
+		const float d5 = -ab.Dot(c);
+		const float d6 = -ac.Dot(c);
+		if (d6 >= 0.0f && d5 <= d6)
+		{
+			KeepVertices(aSimplex, 1, &aC, one);
+			return;
+		}
+
+		const float vb = d5 * d2 - d1 * d6;
+		if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f)
+		{
+			SolveSegment(aSimplex, aA, aC);
+			return;
+		}
+
+		const float va = d3 * d6 - d5 * d4;
+		if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f)
+		{
+			SolveSegment(aSimplex, aB, aC);
+			return;
+		}
+
+		const float area = va + vb + vc;
+		if (area <= FLT_MIN)
+		{
+			// Collinear vertices that passed every region test, the longest edge covers the others
+			const float lengths[3] = { ab.Dot(ab), ac.Dot(ac), (c - b).Dot(c - b) };
+			if (lengths[0] >= lengths[1] && lengths[0] >= lengths[2])
+			{
+				SolveSegment(aSimplex, aA, aB);
+			}
+			else if (lengths[1] >= lengths[2])
+			{
+				SolveSegment(aSimplex, aA, aC);
+			}
+			else
+			{
+				SolveSegment(aSimplex, aB, aC);
+			}
+			return;
+		}
+
+		const int indices[3] = { aA, aB, aC };
+		const float weights[3] = { va / area, vb / area, vc / area };
+		KeepVertices(aSimplex, 3, indices, weights);
+	}
+
+/// @brief Returns true when the origin is inside the tetrahedron, otherwise reduces to the closest face.
+	inline bool SolveTetrahedron(GjkSimplex& aSimplex)
+	{
+		const Vec3f a = aSimplex.vertices[0].point;
+		const Vec3f ab = aSimplex.vertices[1].point - a;
+		const Vec3f ac = aSimplex.vertices[2].point - a;
+		const Vec3f ad = aSimplex.vertices[3].point - a;
+
+		// Barycentric coordinates of the origin from the signed volumes with the origin in place of each vertex
+		const float volume = ab.Dot(ac.Cross(ad));
+		const float longestEdge = std::fmax(std::fmax(ab.Dot(ab), ac.Dot(ac)), std::fmax(ad.Dot(ad), std::fmax((ac - ab).Dot(ac - ab), std::fmax((ad - ab).Dot(ad - ab), (ad - ac).Dot(ad - ac)))));
+		// The signs of a flat tetrahedron are rounding noise, it contains nothing and all of its faces count
+		const bool flat = volume * volume <= GJK_FLAT_TETRAHEDRON * GJK_FLAT_TETRAHEDRON * longestEdge * longestEdge * longestEdge;
+		float weights[4] = { -1.0f, -1.0f, -1.0f, -1.0f };
+		if (!flat)
+		{
+			weights[1] = -a.Dot(ac.Cross(ad)) / volume;
+			weights[2] = -ab.Dot(a.Cross(ad)) / volume;
+			weights[3] = -ab.Dot(ac.Cross(a)) / volume;
+			weights[0] = 1.0f - weights[1] - weights[2] - weights[3];
+			if (weights[0] >= 0.0f && weights[1] >= 0.0f && weights[2] >= 0.0f && weights[3] >= 0.0f)
+			{
+				std::copy(weights, weights + 4, aSimplex.weights);
+				return true;
+			}
+		}
+
+		// Each face with the vertex opposite to it, the origin is outside the faces whose opposite weight is negative
+		const int faces[4][4] = { { 0, 1, 2, 3 }, { 0, 1, 3, 2 }, { 0, 2, 3, 1 }, { 1, 2, 3, 0 } };
+		float bestDistanceSquared = FLT_MAX;
+		GjkSimplex best;
+		for (const int* face : faces)
+		{
+			if (weights[face[3]] >= 0.0f)
+			{
+				continue;
+			}
+			GjkSimplex candidate = aSimplex;
+			SolveTriangle(candidate, face[0], face[1], face[2]);
+			const Vec3f closest = SimplexPoint(candidate);
+			if (closest.Dot(closest) < bestDistanceSquared)
+			{
+				bestDistanceSquared = closest.Dot(closest);
+				best = candidate;
+			}
+		}
+		aSimplex = best;
+		return false;
+	}
+
+/// @brief Reduces the simplex to the smallest one holding the point closest to the origin, true if the origin is inside.
+	inline bool SolveSimplex(GjkSimplex& aSimplex)
+	{
+		switch (aSimplex.count)
+		{
+		case 1:
+			aSimplex.weights[0] = 1.0f;
+			return false;
+		case 2:
+			SolveSegment(aSimplex, 0, 1);
+			return false;
+		case 3:
+			SolveTriangle(aSimplex, 0, 1, 2);
+			return false;
+		default:
+			return SolveTetrahedron(aSimplex);
+		}
+	}
+
+	inline bool ContainsPoint(const GjkSimplex& aSimplex, const Vec3f& aPoint, float aToleranceSquared)
+	{
+		for (int vertex = 0; vertex < aSimplex.count; ++vertex)
+		{
+			const Vec3f delta = aSimplex.vertices[vertex].point - aPoint;
+			if (delta.Dot(delta) <= aToleranceSquared)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+/// @brief Squared magnitude of the support points of aVertex, the scale the touching tolerance is relative to.
+	inline float SupportScaleSquared(const GjkVertex& aVertex)
+	{
+		return std::fmax(aVertex.one.Dot(aVertex.one), aVertex.two.Dot(aVertex.two));
+	}
+
+/**
+* @brief The GJK loop.
+*
+* @details On return aSimplex holds the final simplex, unless the shapes intersect reduced to the
+* feature closest to the origin with its weights. With aEarlyOut the loop stops at the first
+* direction separating the shapes by more than aMargin.
+*
+* The distance to the origin shrinks every iteration in exact arithmetic. In float it can stall
+* on nearly flat simplices, so an iteration that gets no closer ends the loop with the previous
+* simplex, as does a support point already in the simplex.
+*/
+	template<class TShapeOne, class TShapeTwo>
+	inline GjkExit RunGjk(const TShapeOne& aOne, const TShapeTwo& aTwo, Collision::GjkCache* aCache, bool aEarlyOut, float aMargin, GjkSimplex& aSimplex, int& aOutIterations)
+	{
+		float scaleSquared = 0.0f;
+		aSimplex.count = 0;
+		if (aCache)
+		{
+			for (int cached = 0; cached < aCache->count; ++cached)
+			{
+				const GjkVertex vertex = MinkowskiSupport(aOne, aTwo, aCache->directions[cached]);
+				scaleSquared = std::fmax(scaleSquared, SupportScaleSquared(vertex));
+				if (!ContainsPoint(aSimplex, vertex.point, GJK_TOUCHING_RELATIVE_SQUARED * scaleSquared))
+				{
+					aSimplex.vertices[aSimplex.count++] = vertex;
+				}
+			}
+		}
+		if (aSimplex.count == 0)
+		{
+			aSimplex.vertices[aSimplex.count++] = MinkowskiSupport(aOne, aTwo, Vec3f(1.0f, 0.0f, 0.0f));
+			scaleSquared = SupportScaleSquared(aSimplex.vertices[0]);
+		}
+
+		GjkExit exit = SolveSimplex(aSimplex) ? GjkExit::Intersecting : GjkExit::IterationLimit;
+		aOutIterations = 0;
+		while (exit == GjkExit::IterationLimit && aOutIterations < Collision::GJK_MAX_ITERATIONS)
+		{
+			++aOutIterations;
+			const Vec3f closest = SimplexPoint(aSimplex);
+			const float distanceSquared = closest.Dot(closest);
+			if (distanceSquared <= GJK_TOUCHING_RELATIVE_SQUARED * scaleSquared)
+			{
+				exit = GjkExit::Intersecting;
+				break;
+			}
+
+			const GjkVertex vertex = MinkowskiSupport(aOne, aTwo, -closest);
+			scaleSquared = std::fmax(scaleSquared, SupportScaleSquared(vertex));
+			const float progress = closest.Dot(vertex.point);
+			// progress / |closest| is a lower bound of the distance
+			if (aEarlyOut && progress > 0.0f && progress * progress > aMargin * aMargin * distanceSquared)
+			{
+				exit = GjkExit::Separating;
+				break;
+			}
+			// The support point gets no closer than the current one, closest is the answer
+			if (distanceSquared - progress <= GJK_RELATIVE_TOLERANCE * distanceSquared || ContainsPoint(aSimplex, vertex.point, GJK_TOUCHING_RELATIVE_SQUARED * scaleSquared))
+			{
+				exit = GjkExit::Closest;
+				break;
+			}
+
+			const GjkSimplex previous = aSimplex;
+			aSimplex.vertices[aSimplex.count++] = vertex;
+			if (SolveSimplex(aSimplex))
+			{
+				exit = GjkExit::Intersecting;
+				break;
+			}
+			const Vec3f next = SimplexPoint(aSimplex);
+			if (next.Dot(next) >= distanceSquared)
+			{
+				aSimplex = previous;
+				exit = GjkExit::Closest;
+			}
+		}
+
+		if (aCache)
+		{
+			aCache->count = aSimplex.count;
+			for (int vertex = 0; vertex < aSimplex.count; ++vertex)
+			{
+				aCache->directions[vertex] = aSimplex.vertices[vertex].direction;
+			}
+		}
+		return exit;
+	}
+
+/// @brief Adds vertices to a touching simplex until it is a tetrahedron, false for flat shapes.
+	template<class TShapeOne, class TShapeTwo>
+	inline bool CompleteTetrahedron(const TShapeOne& aOne, const TShapeTwo& aTwo, GjkVertex aVertices[], int& aCount)
+	{
+		if (aCount == 1)
+		{
+			const Vec3f axes[6] = { Vec3f(1.0f, 0.0f, 0.0f), Vec3f(-1.0f, 0.0f, 0.0f), Vec3f(0.0f, 1.0f, 0.0f), Vec3f(0.0f, -1.0f, 0.0f), Vec3f(0.0f, 0.0f, 1.0f), Vec3f(0.0f, 0.0f, -1.0f) };
+			for (const Vec3f& axis : axes)
+			{
+				const GjkVertex vertex = MinkowskiSupport(aOne, aTwo, axis);
+				const Vec3f delta = vertex.point - aVertices[0].point;
+				if (delta.Dot(delta) > EPA_DEGENERATE_DISTANCE * EPA_DEGENERATE_DISTANCE)
+				{
+					aVertices[aCount++] = vertex;
+					break;
+				}
+			}
+		}
+
+		if (aCount == 2)
+		{
+			const Vec3f edge = aVertices[1].point - aVertices[0].point;
+			const Vec3f absolute(fabsf(edge.x), fabsf(edge.y), fabsf(edge.z));
+			const Vec3f axis = absolute.x <= absolute.y && absolute.x <= absolute.z ? Vec3f(1.0f, 0.0f, 0.0f) : (absolute.y <= absolute.z ? Vec3f(0.0f, 1.0f, 0.0f) : Vec3f(0.0f, 0.0f, 1.0f));
+			const Vec3f perpendicular = edge.Cross(axis);
+			const Vec3f candidates[4] = { perpendicular, -perpendicular, edge.Cross(perpendicular), -edge.Cross(perpendicular) };
+			for (const Vec3f& candidate : candidates)
+			{
+				const GjkVertex vertex = MinkowskiSupport(aOne, aTwo, candidate);
+				const Vec3f offLine = edge.Cross(vertex.point - aVertices[0].point);
+				if (offLine.Dot(offLine) > EPA_DEGENERATE_DISTANCE * EPA_DEGENERATE_DISTANCE * edge.Dot(edge))
+				{
+					aVertices[aCount++] = vertex;
+					break;
+				}
+			}
+		}
+
+		if (aCount == 3)
+		{
+			const Vec3f normal = (aVertices[1].point - aVertices[0].point).Cross(aVertices[2].point - aVertices[0].point);
+			const Vec3f candidates[2] = { normal, -normal };
+			for (const Vec3f& candidate : candidates)
+			{
+				const GjkVertex vertex = MinkowskiSupport(aOne, aTwo, candidate);
+				const float offPlane = normal.Dot(vertex.point - aVertices[0].point);
+				if (offPlane * offPlane > EPA_DEGENERATE_DISTANCE * EPA_DEGENERATE_DISTANCE * normal.Dot(normal))
+				{
+					aVertices[aCount++] = vertex;
+					break;
+				}
+			}
+		}
+		return aCount == 4;
+	}
+
+	struct EpaFace
+	{
+		int vertices[3];
+		Vec3f normal;
+		float distance;
+	};
+
+	inline EpaFace MakeEpaFace(const GjkVertex aVertices[], int aA, int aB, int aC)
+	{
+		EpaFace face = { { aA, aB, aC }, Vec3f(0.0f), FLT_MAX };
+		const Vec3f normal = (aVertices[aB].point - aVertices[aA].point).Cross(aVertices[aC].point - aVertices[aA].point);
+		const float length = sqrtf(normal.Dot(normal));
+		// A zero area face is kept for the topology but never chosen or removed
+		if (length > FLT_MIN)
+		{
+			face.normal = normal * (1.0f / length);
+			face.distance = face.normal.Dot(aVertices[aA].point);
+		}
+		return face;
+	}
+
+/// @brief Expands the polytope of aVertices (a tetrahedron around the origin) to the face of the Minkowski difference closest to the origin.
+	template<class TShapeOne, class TShapeTwo>
+	inline void RunEpa(const TShapeOne& aOne, const TShapeTwo& aTwo, GjkVertex aVertices[], int aVertexCount, Collision::PenetrationResult& aOutResult)
+	{
+		EpaFace faces[Collision::EPA_MAX_FACES];
+		int faceCount = 0;
+		const int tetrahedron[4][4] = { { 0, 1, 2, 3 }, { 0, 3, 1, 2 }, { 0, 2, 3, 1 }, { 1, 3, 2, 0 } };
+		for (const int* face : tetrahedron)
+		{
+			faces[faceCount] = MakeEpaFace(aVertices, face[0], face[1], face[2]);
+			// Wind every face so its normal points away from the opposite vertex
+			if (faces[faceCount].normal.Dot(aVertices[face[3]].point - aVertices[face[0]].point) > 0.0f)
+			{
+				faces[faceCount] = MakeEpaFace(aVertices, face[0], face[2], face[1]);
+			}
+			++faceCount;
+		}
+
+		int best = 0;
+		while (true)
+		{
+			best = 0;
+			for (int face = 1; face < faceCount; ++face)
+			{
+				if (faces[face].distance < faces[best].distance)
+				{
+					best = face;
+				}
+			}
+			if (aVertexCount == Collision::EPA_MAX_VERTICES)
+			{
+				break;
+			}
+
+			const GjkVertex vertex = MinkowskiSupport(aOne, aTwo, faces[best].normal);
+			if (faces[best].normal.Dot(vertex.point) - faces[best].distance <= EPA_TOLERANCE * std::fmax(1.0f, faces[best].distance))
+			{
+				break;
+			}
+
+			// The faces the new vertex sees are removed, the edges around them form the horizon
+			bool visible[Collision::EPA_MAX_FACES];
+			int horizon[Collision::EPA_MAX_FACES][2];
+			int horizonCount = 0;
+			int visibleCount = 0;
+			for (int face = 0; face < faceCount; ++face)
+			{
+				visible[face] = faces[face].normal.Dot(vertex.point - aVertices[faces[face].vertices[0]].point) > 0.0f;
+				if (!visible[face])
+				{
+					continue;
+				}
+				++visibleCount;
+				for (int edge = 0; edge < 3; ++edge)
+				{
+					const int from = faces[face].vertices[edge];
+					const int to = faces[face].vertices[(edge + 1) % 3];
+					int shared = 0;
+					while (shared < horizonCount && !(horizon[shared][0] == to && horizon[shared][1] == from))
+					{
+						++shared;
+					}
+					if (shared < horizonCount)
+					{
+						horizon[shared][0] = horizon[horizonCount - 1][0];
+						horizon[shared][1] = horizon[horizonCount - 1][1];
+						--horizonCount;
+					}
+					else if (horizonCount < Collision::EPA_MAX_FACES)
+					{
+						horizon[horizonCount][0] = from;
+						horizon[horizonCount][1] = to;
+						++horizonCount;
+					}
+				}
+			}
+			if (visibleCount == 0 || faceCount - visibleCount + horizonCount > Collision::EPA_MAX_FACES)
+			{
+				break;
+			}
+
+			const int newVertex = aVertexCount++;
+			aVertices[newVertex] = vertex;
+			int kept = 0;
+			for (int face = 0; face < faceCount; ++face)
+			{
+				if (!visible[face])
+				{
+					faces[kept++] = faces[face];
+				}
+			}
+			faceCount = kept;
+			for (int edge = 0; edge < horizonCount; ++edge)
+			{
+				faces[faceCount++] = MakeEpaFace(aVertices, horizon[edge][0], horizon[edge][1], newVertex);
+			}
+		}
+
+		// The origin projected on the closest face, in barycentric coordinates of that face
+		const EpaFace& face = faces[best];
+		const Vec3f a = aVertices[face.vertices[0]].point;
+		const Vec3f edgeOne = aVertices[face.vertices[1]].point - a;
+		const Vec3f edgeTwo = aVertices[face.vertices[2]].point - a;
+		const Vec3f projected = face.normal * face.distance - a;
+		const float d00 = edgeOne.Dot(edgeOne), d01 = edgeOne.Dot(edgeTwo), d11 = edgeTwo.Dot(edgeTwo);
+		const float d20 = projected.Dot(edgeOne), d21 = projected.Dot(edgeTwo);
+		const float denominator = d00 * d11 - d01 * d01;
+		float v = 1.0f / 3.0f;
+		float w = 1.0f / 3.0f;
+		if (denominator > FLT_MIN)
+		{
+			v = (d11 * d20 - d01 * d21) / denominator;
+			w = (d00 * d21 - d01 * d20) / denominator;
+		}
+
+		aOutResult.normal = face.normal;
+		aOutResult.depth = std::fmax(face.distance, 0.0f);
+		aOutResult.point = aVertices[face.vertices[0]].two * (1.0f - v - w) + aVertices[face.vertices[1]].two * v + aVertices[face.vertices[2]].two * w;
+	}
+} // namespace Detail
+
+namespace Collision
+{
+	inline Vec3f Support(const Sphere& aSphere, const Vec3f& aDirection)
+	{
+		const float lengthSquared = aDirection.Dot(aDirection);
+		if (lengthSquared <= 0.0f)
+		{
+			return aSphere.center;
+		}
+		return aSphere.center + aDirection * (aSphere.radius / sqrtf(lengthSquared));
+	}
+
+	inline Vec3f Support(const Capsule& aCapsule, const Vec3f& aDirection)
+	{
+		const Vec3f end = aDirection.Dot(aCapsule.end - aCapsule.start) > 0.0f ? aCapsule.end : aCapsule.start;
+		return Support(Sphere{ end, aCapsule.radius }, aDirection);
+	}
+
+	inline Vec3f Support(const Obb& aBox, const Vec3f& aDirection)
+	{
+		const Vec3f local = aBox.orientation.GetConjugate().Rotate(aDirection);
+		const Vec3f corner(local.x >= 0.0f ? aBox.halfExtents.x : -aBox.halfExtents.x, local.y >= 0.0f ? aBox.halfExtents.y : -aBox.halfExtents.y, local.z >= 0.0f ? aBox.halfExtents.z : -aBox.halfExtents.z);
+		return aBox.center + aBox.orientation.Rotate(corner);
+	}
+
+	inline Vec3f Support(const ConvexHull& aHull, const Vec3f& aDirection)
+	{
+		const Vec3f local = aHull.orientation.GetConjugate().Rotate(aDirection);
+		return aHull.position + aHull.orientation.Rotate(aHull.vertices[SupportIndex(aHull.vertices, aHull.count, local)]);
+	}
+
+	inline size_t SupportIndex(const Vec3f* aVertices, size_t aCount, const Vec3f& aDirection)
+	{
+		using namespace BB::Simd;
+		// Indices are tracked as floats, exact up to 2^24
+		assert(aCount > 0 && aCount <= (size_t(1) << 24));
+
+		const Float8 directionX = SplatFloat8(aDirection.x);
+		const Float8 directionY = SplatFloat8(aDirection.y);
+		const Float8 directionZ = SplatFloat8(aDirection.z);
+		Float8 bestDots = SplatFloat8(-FLT_MAX);
+		Float8 bestIndices = SplatFloat8(0.0f);
+		Float8 indices = CombineFloat8(_mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f), _mm_setr_ps(4.0f, 5.0f, 6.0f, 7.0f));
+		const Float8 step = SplatFloat8(8.0f);
+		const auto vector = [](const Vec3f& aVector) { return aVector.data; };
+
+		// The last packet repeats the last vertex, its lanes tie with it and lose to its lower index
+		for (size_t first = 0; first < aCount; first += 8)
+		{
+			Float8 lanes[4];
+			Detail::GatherPacket(aVertices, first, aCount, vector, lanes);
+			const Float8 dots = MulAdd(lanes[0], directionX, MulAdd(lanes[1], directionY, Mul(lanes[2], directionZ)));
+			const Float8 better = GreaterMask(dots, bestDots);
+			bestDots = Select(better, dots, bestDots);
+			bestIndices = Select(better, indices, bestIndices);
+			indices = Simd::Add(indices, step);
+		}
+
+		alignas(32) float dots[8];
+		alignas(32) float candidates[8];
+		StoreFloat8(dots, bestDots);
+		StoreFloat8(candidates, bestIndices);
+		int best = 0;
+		for (int lane = 1; lane < 8; ++lane)
+		{
+			if (dots[lane] > dots[best] || (dots[lane] == dots[best] && candidates[lane] < candidates[best]))
+			{
+				best = lane;
+			}
+		}
+		return std::min(size_t(candidates[best]), aCount - 1);
+	}
+
+	template<class TShapeOne, class TShapeTwo>
+	inline GjkResult GjkDistance(const TShapeOne& aOne, const TShapeTwo& aTwo, GjkCache* aCache)
+	{
+		using CoreOne = Detail::GjkCore<TShapeOne>;
+		using CoreTwo = Detail::GjkCore<TShapeTwo>;
+		const float radiusOne = CoreOne::GetRadius(aOne);
+		const float radiusTwo = CoreTwo::GetRadius(aTwo);
+
+		GjkResult result;
+		Detail::GjkSimplex simplex;
+		const Detail::GjkExit exit = Detail::RunGjk(CoreOne::GetShape(aOne), CoreTwo::GetShape(aTwo), aCache, false, 0.0f, simplex, result.iterations);
+		result.converged = exit != Detail::GjkExit::IterationLimit;
+		if (exit == Detail::GjkExit::Intersecting)
+		{
+			result.intersecting = true;
+			return result;
+		}
+
+		const Vec3f closest = Detail::SimplexPoint(simplex);
+		const float coreDistance = sqrtf(closest.Dot(closest));
+		if (coreDistance <= radiusOne + radiusTwo)
+		{
+			result.intersecting = true;
+			return result;
+		}
+		result.distance = coreDistance - radiusOne - radiusTwo;
+		result.pointOne = Vec3f(0.0f);
+		result.pointTwo = Vec3f(0.0f);
+		for (int vertex = 0; vertex < simplex.count; ++vertex)
+		{
+			result.pointOne += simplex.vertices[vertex].one * simplex.weights[vertex];
+			result.pointTwo += simplex.vertices[vertex].two * simplex.weights[vertex];
+		}
+		// closest is one - two, the radii move the points towards each other
+		const Vec3f oneToTwo = closest * (-1.0f / coreDistance);
+		result.pointOne += oneToTwo * radiusOne;
+		result.pointTwo -= oneToTwo * radiusTwo;
+		return result;
+	}
+
+	template<class TShapeOne, class TShapeTwo>
+	inline bool GjkIntersect(const TShapeOne& aOne, const TShapeTwo& aTwo, GjkCache* aCache)
+	{
+		using CoreOne = Detail::GjkCore<TShapeOne>;
+		using CoreTwo = Detail::GjkCore<TShapeTwo>;
+		const float radius = CoreOne::GetRadius(aOne) + CoreTwo::GetRadius(aTwo);
+
+		Detail::GjkSimplex simplex;
+		int iterations;
+		const Detail::GjkExit exit = Detail::RunGjk(CoreOne::GetShape(aOne), CoreTwo::GetShape(aTwo), aCache, true, radius, simplex, iterations);
+		if (exit == Detail::GjkExit::Intersecting || exit == Detail::GjkExit::Separating)
+		{
+			return exit == Detail::GjkExit::Intersecting;
+		}
+		const Vec3f closest = Detail::SimplexPoint(simplex);
+		return closest.Dot(closest) <= radius * radius;
+	}
+
+	template<class TShapeOne, class TShapeTwo>
+	inline bool Penetration(const TShapeOne& aOne, const TShapeTwo& aTwo, PenetrationResult& aOutResult, GjkCache* aCache)
+	{
+		using CoreOne = Detail::GjkCore<TShapeOne>;
+		using CoreTwo = Detail::GjkCore<TShapeTwo>;
+		const float radiusTwo = CoreTwo::GetRadius(aTwo);
+		const float radius = CoreOne::GetRadius(aOne) + radiusTwo;
+
+		Detail::GjkSimplex simplex;
+		int iterations;
+		if (Detail::RunGjk(CoreOne::GetShape(aOne), CoreTwo::GetShape(aTwo), aCache, false, 0.0f, simplex, iterations) != Detail::GjkExit::Intersecting)
+		{
+			// Separated cores, the shapes overlap where the radii reach across the gap
+			const Vec3f closest = Detail::SimplexPoint(simplex);
+			const float coreDistance = sqrtf(closest.Dot(closest));
+			if (coreDistance > radius)
+			{
+				return false;
+			}
+			Vec3f pointTwo(0.0f);
+			for (int vertex = 0; vertex < simplex.count; ++vertex)
+			{
+				pointTwo += simplex.vertices[vertex].two * simplex.weights[vertex];
+			}
+			aOutResult.normal = closest * (-1.0f / coreDistance);
+			aOutResult.depth = radius - coreDistance;
+			aOutResult.point = pointTwo - aOutResult.normal * radiusTwo;
+			return true;
+		}
+
+		// The cores overlap, EPA needs a simplex around the origin of the full shapes
+		if constexpr (CoreOne::ROUNDED || CoreTwo::ROUNDED)
+		{
+			if (Detail::RunGjk(aOne, aTwo, nullptr, false, 0.0f, simplex, iterations) != Detail::GjkExit::Intersecting)
+			{
+				simplex.count = 1;
+			}
+		}
+
+		Detail::GjkVertex vertices[EPA_MAX_VERTICES];
+		int vertexCount = simplex.count;
+		for (int vertex = 0; vertex < simplex.count; ++vertex)
+		{
+			vertices[vertex] = simplex.vertices[vertex];
+		}
+		if (!Detail::CompleteTetrahedron(aOne, aTwo, vertices, vertexCount))
+		{
+			// Flat shapes touching, there is no depth to measure
+			aOutResult.normal = Vec3f(0.0f, 1.0f, 0.0f);
+			aOutResult.depth = 0.0f;
+			aOutResult.point = vertices[0].two;
+			return true;
+		}
+		Detail::RunEpa(aOne, aTwo, vertices, vertexCount, aOutResult);
+		return true;
+	}
+} // namespace Collision
+} // namespace BitBloom
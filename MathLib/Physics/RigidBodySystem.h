@@ -0,0 +1,125 @@
+#pragma once
+#include <cstddef>
+#include "../Memory/AlignedAllocator.h"
+#include "../Util/Float8.h"
+#include "../Vector/Vector3f/Vector3f.h"
+#include "../Matrix/Matrix4x4f/Matrix4x4f.h"
+#include "../Quaternion/Quatf/Quatf.h"
+#include "../Parallel/ThreadPool.h"
+
+/**
+ * @file RigidBodySystem.h
+ * @brief Rigid body state in structure-of-arrays form, integrated eight bodies per step.
+ *
+ * @details Every scalar of the body state (position, orientation quaternion, linear and angular
+ * velocity, accumulated force and torque, inverse mass and inertia) is its own float array, so
+ * Integrate loads eight bodies into one Float8 per component (two SSE registers without AVX).
+ *
+ * One Integrate step is semi-implicit Euler:
+ * - v += (F * inverseMass + gravity) * dt for dynamic bodies, w += I_world^-1 * torque * dt
+ * - both velocities are damped, x += v * dt
+ * - q += 0.5 * (w, 0) * q * dt and q is renormalized
+ * - I_world^-1 = R * I_local^-1 * R^T is recomputed from the new orientation and the force and
+ *   torque accumulators are cleared
+ *
+ * The local inertia is diagonal (principal axes), the world inverse inertia is symmetric and is
+ * stored as its six unique components. GetWorldInverseInertia returns it as the upper 3x3 of a
+ * Mat4x4f. A mass of 0 makes a static body, it is never moved by forces or gravity.
+ */
+
+namespace BitBloom
+{
+	struct RigidBodyDesc
+	{
+		Vec3f position;
+		Quatf orientation;
+		Vec3f linearVelocity;
+		Vec3f angularVelocity;
+/// @brief 0 for static bodies.
+		float mass = 1.0f;
+/// @brief Principal moments of inertia in the body's local axes, e.g. mass * (y^2 + z^2) / 12 for the x axis of a box.
+		Vec3f inertia = Vec3f(1.0f);
+	};
+
+	struct RigidBodySettings
+	{
+		Vec3f gravity = Vec3f(0.0f, -9.81f, 0.0f);
+/// @brief Part of the linear velocity removed per second.
+		float linearDamping = 0.0f;
+/// @brief Part of the angular velocity removed per second.
+		float angularDamping = 0.0f;
+	};
+
+	class RigidBodySystem
+	{
+	public:
+		inline explicit RigidBodySystem(size_t aCapacity);
+
+/// @brief Adds a body and returns its index, asserts when the capacity is reached.
+		inline size_t Add(const RigidBodyDesc& aBody);
+		inline size_t GetCount() const;
+
+/**
+* @name Forces
+* @brief Accumulated until the next Integrate, which clears them.
+* @{
+*/
+		inline void ApplyForce(size_t aBody, const Vec3f& aForce);
+/// @brief Force at a world space point, adds the torque (aPoint - position) x aForce.
+		inline void ApplyForceAtPoint(size_t aBody, const Vec3f& aForce, const Vec3f& aPoint);
+		inline void ApplyTorque(size_t aBody, const Vec3f& aTorque);
+/// @brief Instant change of velocity, aImpulse * inverse mass.
+		inline void ApplyImpulse(size_t aBody, const Vec3f& aImpulse);
+/** @} */
+
+/// @brief Advances every body by aDeltaTime.
+		inline void Integrate(const RigidBodySettings& aSettings, float aDeltaTime);
+/// @brief Same as Integrate(), in chunks spread over aPool.
+		inline void Integrate(ThreadPool& aPool, const RigidBodySettings& aSettings, float aDeltaTime);
+
+		inline Vec3f GetPosition(size_t aBody) const;
+		inline Quatf GetOrientation(size_t aBody) const;
+		inline Vec3f GetLinearVelocity(size_t aBody) const;
+		inline Vec3f GetAngularVelocity(size_t aBody) const;
+/// @brief Rotation and translation of the body as a row-vector Mat4x4f.
+		inline Mat4x4f GetTransform(size_t aBody) const;
+/// @brief R * I_local^-1 * R^T in the upper 3x3, the rest is zero.
+		inline Mat4x4f GetWorldInverseInertia(size_t aBody) const;
+
+		inline void SetPosition(size_t aBody, const Vec3f& aPosition);
+/// @brief Sets the orientation and updates the world inverse inertia to match.
+		inline void SetOrientation(size_t aBody, const Quatf& aOrientation);
+		inline void SetLinearVelocity(size_t aBody, const Vec3f& aVelocity);
+		inline void SetAngularVelocity(size_t aBody, const Vec3f& aVelocity);
+
+	private:
+		enum Stream
+		{
+			POSITION_X, POSITION_Y, POSITION_Z,
+			ORIENTATION_X, ORIENTATION_Y, ORIENTATION_Z, ORIENTATION_W,
+			LINEAR_VELOCITY_X, LINEAR_VELOCITY_Y, LINEAR_VELOCITY_Z,
+			ANGULAR_VELOCITY_X, ANGULAR_VELOCITY_Y, ANGULAR_VELOCITY_Z,
+			FORCE_X, FORCE_Y, FORCE_Z,
+			TORQUE_X, TORQUE_Y, TORQUE_Z,
+			INVERSE_MASS,
+			LOCAL_INVERSE_INERTIA_X, LOCAL_INVERSE_INERTIA_Y, LOCAL_INVERSE_INERTIA_Z,
+			// Upper triangle of the symmetric world inverse inertia
+			WORLD_INVERSE_INERTIA_XX, WORLD_INVERSE_INERTIA_XY, WORLD_INVERSE_INERTIA_XZ,
+			WORLD_INVERSE_INERTIA_YY, WORLD_INVERSE_INERTIA_YZ, WORLD_INVERSE_INERTIA_ZZ,
+			STREAM_COUNT
+		};
+
+		inline void IntegrateRange(const RigidBodySettings& aSettings, float aDeltaTime, size_t aBegin, size_t aEnd);
+		inline void UpdateWorldInertia(size_t aBody);
+		inline Vec3f GetVector(Stream aFirst, size_t aBody) const;
+		inline void SetVector(Stream aFirst, size_t aBody, const Vec3f& aVector);
+
+		AlignedVector<float, CACHE_LINE_SIZE> myStreams[STREAM_COUNT];
+		size_t myCapacity;
+		size_t myCount;
+	};
+} // namespace BitBloom
+
+namespace BB = BitBloom;
+
+#include "RigidBodySystem.inl"
@@ -0,0 +1,312 @@
+#pragma once
+#include "RigidBodySystem.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace BitBloom
+{
+namespace Detail
+{
+/**
+* @brief R * diag(aInverseInertia) * R^T for the rotation of the unit quaternion (aX, aY, aZ, aW).
+*
+* @details R is the column-vector rotation matrix. The result is written as xx, xy, xz, yy, yz, zz.
+* Integrate does the same math eight bodies at a time.
+*/
+	inline void WorldInverseInertia(float aX, float aY, float aZ, float aW, const float aInverseInertia[3], float aOutTensor[6])
+	{
+		const float rotation[3][3] =
+		{
+			{ 1.0f - 2.0f * (aY * aY + aZ * aZ), 2.0f * (aX * aY - aW * aZ), 2.0f * (aX * aZ + aW * aY) },
+			{ 2.0f * (aX * aY + aW * aZ), 1.0f - 2.0f * (aX * aX + aZ * aZ), 2.0f * (aY * aZ - aW * aX) },
+			{ 2.0f * (aX * aZ - aW * aY), 2.0f * (aY * aZ + aW * aX), 1.0f - 2.0f * (aX * aX + aY * aY) }
+		};
+
+		const int pairs[6][2] = { { 0, 0 }, { 0, 1 }, { 0, 2 }, { 1, 1 }, { 1, 2 }, { 2, 2 } };
+		for (int element = 0; element < 6; ++element)
+		{
+			const float* rowOne = rotation[pairs[element][0]];
+			const float* rowTwo = rotation[pairs[element][1]];
+			aOutTensor[element] = rowOne[0] * aInverseInertia[0] * rowTwo[0] + rowOne[1] * aInverseInertia[1] * rowTwo[1] + rowOne[2] * aInverseInertia[2] * rowTwo[2];
+		}
+	}
+} // namespace Detail
+
+	inline RigidBodySystem::RigidBodySystem(size_t aCapacity)
+		: myCapacity(aCapacity)
+		, myCount(0)
+	{
+		// Padded to whole Float8 blocks, the padding holds identity orientations so it stays finite
+		const size_t paddedCapacity = (aCapacity + 7) & ~size_t(7);
+		for (AlignedVector<float, CACHE_LINE_SIZE>& stream : myStreams)
+		{
+			stream.assign(paddedCapacity, 0.0f);
+		}
+		myStreams[ORIENTATION_W].assign(paddedCapacity, 1.0f);
+	}
+
+	inline size_t RigidBodySystem::Add(const RigidBodyDesc& aBody)
+	{
+		assert(myCount < myCapacity && "RigidBodySystem is full");
+
+		const size_t body = myCount++;
+		SetVector(POSITION_X, body, aBody.position);
+		SetVector(LINEAR_VELOCITY_X, body, aBody.linearVelocity);
+		SetVector(ANGULAR_VELOCITY_X, body, aBody.angularVelocity);
+		SetVector(FORCE_X, body, Vec3f(0.0f));
+		SetVector(TORQUE_X, body, Vec3f(0.0f));
+
+		const bool dynamic = aBody.mass > 0.0f;
+		myStreams[INVERSE_MASS][body] = dynamic ? 1.0f / aBody.mass : 0.0f;
+		myStreams[LOCAL_INVERSE_INERTIA_X][body] = dynamic && aBody.inertia.x > 0.0f ? 1.0f / aBody.inertia.x : 0.0f;
+		myStreams[LOCAL_INVERSE_INERTIA_Y][body] = dynamic && aBody.inertia.y > 0.0f ? 1.0f / aBody.inertia.y : 0.0f;
+		myStreams[LOCAL_INVERSE_INERTIA_Z][body] = dynamic && aBody.inertia.z > 0.0f ? 1.0f / aBody.inertia.z : 0.0f;
+		SetOrientation(body, aBody.orientation);
+		return body;
+	}
+
+	inline size_t RigidBodySystem::GetCount() const
+	{
+		return myCount;
+	}
+
+	inline void RigidBodySystem::ApplyForce(size_t aBody, const Vec3f& aForce)
+	{
+		SetVector(FORCE_X, aBody, GetVector(FORCE_X, aBody) + aForce);
+	}
+
+	inline void RigidBodySystem::ApplyForceAtPoint(size_t aBody, const Vec3f& aForce, const Vec3f& aPoint)
+	{
+		ApplyForce(aBody, aForce);
+		ApplyTorque(aBody, (aPoint - GetPosition(aBody)).Cross(aForce));
+	}
+
+	inline void RigidBodySystem::ApplyTorque(size_t aBody, const Vec3f& aTorque)
+	{
+		SetVector(TORQUE_X, aBody, GetVector(TORQUE_X, aBody) + aTorque);
+	}
+
+	inline void RigidBodySystem::ApplyImpulse(size_t aBody, const Vec3f& aImpulse)
+	{
+		SetVector(LINEAR_VELOCITY_X, aBody, GetVector(LINEAR_VELOCITY_X, aBody) + aImpulse * myStreams[INVERSE_MASS][aBody]);
+	}
+
+	inline void RigidBodySystem::Integrate(const RigidBodySettings& aSettings, float aDeltaTime)
+	{
+		IntegrateRange(aSettings, aDeltaTime, 0, myCount);
+	}
+
+	inline void RigidBodySystem::Integrate(ThreadPool& aPool, const RigidBodySettings& aSettings, float aDeltaTime)
+	{
+		// About BB_PARALLEL_GRAIN_BYTES over all the arrays, in whole cache lines so chunks start on Float8 blocks
+		constexpr size_t floatsPerLine = CACHE_LINE_SIZE / sizeof(float);
+		constexpr size_t grain = std::max<size_t>(BB_PARALLEL_GRAIN_BYTES / (sizeof(float) * STREAM_COUNT) / floatsPerLine, 1) * floatsPerLine;
+
+		aPool.ParallelFor(0, myCount, grain, [&](size_t aBegin, size_t aEnd)
+		{
+			IntegrateRange(aSettings, aDeltaTime, aBegin, aEnd);
+		});
+	}
+
+	inline Vec3f RigidBodySystem::GetPosition(size_t aBody) const
+	{
+		return GetVector(POSITION_X, aBody);
+	}
+
+	inline Quatf RigidBodySystem::GetOrientation(size_t aBody) const
+	{
+		return Quatf(myStreams[ORIENTATION_X][aBody], myStreams[ORIENTATION_Y][aBody], myStreams[ORIENTATION_Z][aBody], myStreams[ORIENTATION_W][aBody]);
+	}
+
+	inline Vec3f RigidBodySystem::GetLinearVelocity(size_t aBody) const
+	{
+		return GetVector(LINEAR_VELOCITY_X, aBody);
+	}
+
+	inline Vec3f RigidBodySystem::GetAngularVelocity(size_t aBody) const
+	{
+		return GetVector(ANGULAR_VELOCITY_X, aBody);
+	}
+
+	inline Mat4x4f RigidBodySystem::GetTransform(size_t aBody) const
+	{
+		Mat4x4f transform = GetOrientation(aBody).ToMat4x4f();
+		transform.SetTranslation(GetPosition(aBody));
+		return transform;
+	}
+
+	inline Mat4x4f RigidBodySystem::GetWorldInverseInertia(size_t aBody) const
+	{
+		const float xx = myStreams[WORLD_INVERSE_INERTIA_XX][aBody];
+		const float xy = myStreams[WORLD_INVERSE_INERTIA_XY][aBody];
+		const float xz = myStreams[WORLD_INVERSE_INERTIA_XZ][aBody];
+		const float yy = myStreams[WORLD_INVERSE_INERTIA_YY][aBody];
+		const float yz = myStreams[WORLD_INVERSE_INERTIA_YZ][aBody];
+		const float zz = myStreams[WORLD_INVERSE_INERTIA_ZZ][aBody];
+		return Mat4x4f(
+			xx, xy, xz, 0.0f,
+			xy, yy, yz, 0.0f,
+			xz, yz, zz, 0.0f,
+			0.0f, 0.0f, 0.0f, 0.0f);
+	}
+
+	inline void RigidBodySystem::SetPosition(size_t aBody, const Vec3f& aPosition)
+	{
+		SetVector(POSITION_X, aBody, aPosition);
+	}
+
+	inline void RigidBodySystem::SetOrientation(size_t aBody, const Quatf& aOrientation)
+	{
+		myStreams[ORIENTATION_X][aBody] = aOrientation.x;
+		myStreams[ORIENTATION_Y][aBody] = aOrientation.y;
+		myStreams[ORIENTATION_Z][aBody] = aOrientation.z;
+		myStreams[ORIENTATION_W][aBody] = aOrientation.w;
+		UpdateWorldInertia(aBody);
+	}
+
+	inline void RigidBodySystem::SetLinearVelocity(size_t aBody, const Vec3f& aVelocity)
+	{
+		SetVector(LINEAR_VELOCITY_X, aBody, aVelocity);
+	}
+
+	inline void RigidBodySystem::SetAngularVelocity(size_t aBody, const Vec3f& aVelocity)
+	{
+		SetVector(ANGULAR_VELOCITY_X, aBody, aVelocity);
+	}
+
+	inline void RigidBodySystem::IntegrateRange(const RigidBodySettings& aSettings, float aDeltaTime, size_t aBegin, size_t aEnd)
+	{
+		using namespace BB::Simd;
+
+		float* streams[STREAM_COUNT];
+		for (int stream = 0; stream < STREAM_COUNT; ++stream)
+		{
+			streams[stream] = myStreams[stream].data();
+		}
+		const auto load = [&streams](int aStream, size_t aBlock) { return LoadFloat8(streams[aStream] + aBlock); };
+		const auto store = [&streams](int aStream, size_t aBlock, Float8 aValue) { StoreFloat8(streams[aStream] + aBlock, aValue); };
+
+		const Float8 deltaTime = SplatFloat8(aDeltaTime);
+		const Float8 halfDeltaTime = SplatFloat8(0.5f * aDeltaTime);
+		const Float8 linearDamping = SplatFloat8(std::max(0.0f, 1.0f - aSettings.linearDamping * aDeltaTime));
+		const Float8 angularDamping = SplatFloat8(std::max(0.0f, 1.0f - aSettings.angularDamping * aDeltaTime));
+		const Float8 gravity[3] = { SplatFloat8(aSettings.gravity.x), SplatFloat8(aSettings.gravity.y), SplatFloat8(aSettings.gravity.z) };
+		const Float8 zero = SplatFloat8(0.0f);
+		const Float8 one = SplatFloat8(1.0f);
+		const Float8 two = SplatFloat8(2.0f);
+
+		for (size_t block = aBegin; block < aEnd; block += 8)
+		{
+			// Linear part, gravity only for bodies with an inverse mass
+			const Float8 inverseMass = load(INVERSE_MASS, block);
+			const Float8 dynamic = GreaterMask(inverseMass, zero);
+			for (int axis = 0; axis < 3; ++axis)
+			{
+				const Float8 acceleration = MulAdd(load(FORCE_X + axis, block), inverseMass, And(dynamic, gravity[axis]));
+				const Float8 velocity = Mul(MulAdd(acceleration, deltaTime, load(LINEAR_VELOCITY_X + axis, block)), linearDamping);
+				store(LINEAR_VELOCITY_X + axis, block, velocity);
+				store(POSITION_X + axis, block, MulAdd(velocity, deltaTime, load(POSITION_X + axis, block)));
+				store(FORCE_X + axis, block, zero);
+			}
+
+			// Angular velocity, w += I_world^-1 * torque * dt
+			const Float8 torqueX = load(TORQUE_X, block);
+			const Float8 torqueY = load(TORQUE_Y, block);
+			const Float8 torqueZ = load(TORQUE_Z, block);
+			const Float8 inertiaXX = load(WORLD_INVERSE_INERTIA_XX, block);
+			const Float8 inertiaXY = load(WORLD_INVERSE_INERTIA_XY, block);
+			const Float8 inertiaXZ = load(WORLD_INVERSE_INERTIA_XZ, block);
+			const Float8 inertiaYY = load(WORLD_INVERSE_INERTIA_YY, block);
+			const Float8 inertiaYZ = load(WORLD_INVERSE_INERTIA_YZ, block);
+			const Float8 inertiaZZ = load(WORLD_INVERSE_INERTIA_ZZ, block);
+			const Float8 angularAccelerationX = MulAdd(inertiaXX, torqueX, MulAdd(inertiaXY, torqueY, Mul(inertiaXZ, torqueZ)));
+			const Float8 angularAccelerationY = MulAdd(inertiaXY, torqueX, MulAdd(inertiaYY, torqueY, Mul(inertiaYZ, torqueZ)));
+			const Float8 angularAccelerationZ = MulAdd(inertiaXZ, torqueX, MulAdd(inertiaYZ, torqueY, Mul(inertiaZZ, torqueZ)));
+			const Float8 omegaX = Mul(MulAdd(angularAccelerationX, deltaTime, load(ANGULAR_VELOCITY_X, block)), angularDamping);
+			const Float8 omegaY = Mul(MulAdd(angularAccelerationY, deltaTime, load(ANGULAR_VELOCITY_Y, block)), angularDamping);
+			const Float8 omegaZ = Mul(MulAdd(angularAccelerationZ, deltaTime, load(ANGULAR_VELOCITY_Z, block)), angularDamping);
+			store(ANGULAR_VELOCITY_X, block, omegaX);
+			store(ANGULAR_VELOCITY_Y, block, omegaY);
+			store(ANGULAR_VELOCITY_Z, block, omegaZ);
+			store(TORQUE_X, block, zero);
+			store(TORQUE_Y, block, zero);
+			store(TORQUE_Z, block, zero);
+
+			// Quaternion derivative, q += 0.5 * dt * (w, 0) * q
+			Float8 qx = load(ORIENTATION_X, block);
+			Float8 qy = load(ORIENTATION_Y, block);
+			Float8 qz = load(ORIENTATION_Z, block);
+			Float8 qw = load(ORIENTATION_W, block);
+			const Float8 derivativeX = Sub(MulAdd(omegaX, qw, Mul(omegaY, qz)), Mul(omegaZ, qy));
+			const Float8 derivativeY = Sub(MulAdd(omegaY, qw, Mul(omegaZ, qx)), Mul(omegaX, qz));
+			const Float8 derivativeZ = Sub(MulAdd(omegaZ, qw, Mul(omegaX, qy)), Mul(omegaY, qx));
+			const Float8 derivativeW = MulAdd(omegaX, qx, MulAdd(omegaY, qy, Mul(omegaZ, qz)));
+			qx = MulAdd(derivativeX, halfDeltaTime, qx);
+			qy = MulAdd(derivativeY, halfDeltaTime, qy);
+			qz = MulAdd(derivativeZ, halfDeltaTime, qz);
+			qw = Sub(qw, Mul(derivativeW, halfDeltaTime));
+
+			const Float8 inverseLength = Div(one, Sqrt(MulAdd(qx, qx, MulAdd(qy, qy, MulAdd(qz, qz, Mul(qw, qw))))));
+			qx = Mul(qx, inverseLength);
+			qy = Mul(qy, inverseLength);
+			qz = Mul(qz, inverseLength);
+			qw = Mul(qw, inverseLength);
+			store(ORIENTATION_X, block, qx);
+			store(ORIENTATION_Y, block, qy);
+			store(ORIENTATION_Z, block, qz);
+			store(ORIENTATION_W, block, qw);
+
+			// Rotation matrix of the new orientation, then I_world^-1 = R * I_local^-1 * R^T
+			const Float8 xx = Mul(qx, qx), yy = Mul(qy, qy), zz = Mul(qz, qz);
+			const Float8 xy = Mul(qx, qy), xz = Mul(qx, qz), yz = Mul(qy, qz);
+			const Float8 wx = Mul(qw, qx), wy = Mul(qw, qy), wz = Mul(qw, qz);
+			const Float8 rotation[3][3] =
+			{
+				{ Sub(one, Mul(two, Simd::Add(yy, zz))), Mul(two, Sub(xy, wz)), Mul(two, Simd::Add(xz, wy)) },
+				{ Mul(two, Simd::Add(xy, wz)), Sub(one, Mul(two, Simd::Add(xx, zz))), Mul(two, Sub(yz, wx)) },
+				{ Mul(two, Sub(xz, wy)), Mul(two, Simd::Add(yz, wx)), Sub(one, Mul(two, Simd::Add(xx, yy))) }
+			};
+			const Float8 local[3] = { load(LOCAL_INVERSE_INERTIA_X, block), load(LOCAL_INVERSE_INERTIA_Y, block), load(LOCAL_INVERSE_INERTIA_Z, block) };
+			const Float8 scaled[3][3] =
+			{
+				{ Mul(rotation[0][0], local[0]), Mul(rotation[0][1], local[1]), Mul(rotation[0][2], local[2]) },
+				{ Mul(rotation[1][0], local[0]), Mul(rotation[1][1], local[1]), Mul(rotation[1][2], local[2]) },
+				{ Mul(rotation[2][0], local[0]), Mul(rotation[2][1], local[1]), Mul(rotation[2][2], local[2]) }
+			};
+			const auto element = [&](int aRow, int aColumn)
+			{
+				return MulAdd(scaled[aRow][0], rotation[aColumn][0], MulAdd(scaled[aRow][1], rotation[aColumn][1], Mul(scaled[aRow][2], rotation[aColumn][2])));
+			};
+			store(WORLD_INVERSE_INERTIA_XX, block, element(0, 0));
+			store(WORLD_INVERSE_INERTIA_XY, block, element(0, 1));
+			store(WORLD_INVERSE_INERTIA_XZ, block, element(0, 2));
+			store(WORLD_INVERSE_INERTIA_YY, block, element(1, 1));
+			store(WORLD_INVERSE_INERTIA_YZ, block, element(1, 2));
+			store(WORLD_INVERSE_INERTIA_ZZ, block, element(2, 2));
+		}
+	}
+
+	inline void RigidBodySystem::UpdateWorldInertia(size_t aBody)
+	{
+		const float local[3] = { myStreams[LOCAL_INVERSE_INERTIA_X][aBody], myStreams[LOCAL_INVERSE_INERTIA_Y][aBody], myStreams[LOCAL_INVERSE_INERTIA_Z][aBody] };
+		float tensor[6];
+		Detail::WorldInverseInertia(myStreams[ORIENTATION_X][aBody], myStreams[ORIENTATION_Y][aBody], myStreams[ORIENTATION_Z][aBody], myStreams[ORIENTATION_W][aBody], local, tensor);
+		for (int element = 0; element < 6; ++element)
+		{
+			myStreams[WORLD_INVERSE_INERTIA_XX + element][aBody] = tensor[element];
+		}
+	}
+
+	inline Vec3f RigidBodySystem::GetVector(Stream aFirst, size_t aBody) const
+	{
+		return Vec3f(myStreams[aFirst][aBody], myStreams[aFirst + 1][aBody], myStreams[aFirst + 2][aBody]);
+	}
+
+	inline void RigidBodySystem::SetVector(Stream aFirst, size_t aBody, const Vec3f& aVector)
+	{
+		myStreams[aFirst][aBody] = aVector.x;
+		myStreams[aFirst + 1][aBody] = aVector.y;
+		myStreams[aFirst + 2][aBody] = aVector.z;
+	}
+} // namespace BitBloom
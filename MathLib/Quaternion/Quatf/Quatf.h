@@ -0,0 +1,86 @@
+#pragma once
+#include <emmintrin.h>
+#include "../../Util/Intrinsics.h"
+#include "../../Vector/Vector3f/Vector3f.h"
+#include "../../Matrix/Matrix4x4f/Matrix4x4f.h"
+
+/**
+* @brief Quatf is a rotation quaternion stored in a 128-bit SSE register, aligned to 16 bytes.
+*
+* @details Components are {@code x}, {@code y}, {@code z} (the vector part) and {@code w}
+* (the scalar part). Only unit quaternions represent rotations, functions that build or combine
+* rotations keep the length at 1 up to rounding, call Normalize() after integrating many steps.
+*
+* The product {@code aOne * aTwo} applies aTwo first and then aOne, ToMat4x4f() returns the
+* matching row-vector matrix so {@code aQuat.Rotate(v)} equals v transformed by {@code aQuat.ToMat4x4f()}.
+*
+* @warning Values are not checked for infinity or NaN.
+*/
+class Quatf
+{
+public:
+	union
+	{
+		__m128 data;
+		struct { float x, y, z, w; };
+		/// @brief Scalar view used by the constexpr code path.
+		BB::ScalarLanes<4> lanes;
+	};
+
+/**
+* @name Constructors
+* @brief Ways to initialize an instance of Quatf.
+* @{
+*/
+/// @brief Default constructor. The identity rotation (0, 0, 0, 1).
+	constexpr Quatf() : Quatf(0.0f, 0.0f, 0.0f, 1.0f) {};
+/// @brief Copy constructor. Can use Quatf or a __m128 to copy the data.
+	Quatf(const __m128& aSSEData) : data(aSSEData) {};
+/// @brief Initializes the components directly, usable in constant expressions.
+	constexpr Quatf(float aX, float aY, float aZ, float aW)
+	{
+		if (std::is_constant_evaluated())
+		{
+			lanes = BB::ScalarLanes<4>{ { aX, aY, aZ, aW } };
+		}
+		else
+		{
+			data = _mm_set_ps(aW, aZ, aY, aX);
+		}
+	};
+/// @brief Rotation of aAngle radians around aAxis (right-hand rule), aAxis has to be unit length.
+	static inline Quatf FromAxisAngle(const Vec3f& aAxis, float aAngle);
+/** @} */
+
+	inline float Length() const;
+	inline float Dot(const Quatf& aQuat) const;
+	inline Quatf GetNormalized() const;
+	inline void Normalize();
+/// @brief The inverse rotation for unit quaternions, (-x, -y, -z, w).
+	inline Quatf GetConjugate() const;
+
+/// @brief Rotates aVector, the same as transforming it with ToMat4x4f().
+	inline Vec3f Rotate(const Vec3f& aVector) const;
+/// @brief Rotation matrix with no translation, in the row-vector convention of Mat4x4f.
+	inline Mat4x4f ToMat4x4f() const;
+};
+
+/**
+* @name Operators
+* @brief Hamilton product and exact comparison.
+* @{
+*/
+/// @brief Combined rotation, aTwo is applied first.
+inline Quatf operator*(const Quatf& aOne, const Quatf& aTwo);
+inline void operator*=(Quatf& aOne, const Quatf& aTwo);
+inline bool operator==(const Quatf& aOne, const Quatf& aTwo);
+inline bool operator!=(const Quatf& aOne, const Quatf& aTwo);
+/** @} */
+
+#include "Quatf.inl"
+
+namespace BitBloom
+{
+/// @brief Compile-time identity rotation.
+	inline constexpr Quatf QUATF_IDENTITY(0.0f, 0.0f, 0.0f, 1.0f);
+}
@@ -0,0 +1,91 @@
+#pragma once
+#include "Quatf.h"
+#include <cmath>
+
+#pragma region ClassFunctions
+
+inline Quatf Quatf::FromAxisAngle(const Vec3f& aAxis, float aAngle)
+{
+	const float halfAngle = aAngle * 0.5f;
+	const float sine = std::sin(halfAngle);
+	return Quatf(aAxis.x * sine, aAxis.y * sine, aAxis.z * sine, std::cos(halfAngle));
+}
+
+inline float Quatf::Length() const
+{
+	return _mm_cvtss_f32(_mm_sqrt_ss(_mm_dp_ps(data, data, 0xF1)));
+}
+
+inline float Quatf::Dot(const Quatf& aQuat) const
+{
+	return _mm_cvtss_f32(_mm_dp_ps(data, aQuat.data, 0xF1));
+}
+
+inline Quatf Quatf::GetNormalized() const
+{
+	return _mm_div_ps(data, _mm_sqrt_ps(_mm_dp_ps(data, data, 0xFF)));
+}
+
+inline void Quatf::Normalize()
+{
+	*this = GetNormalized();
+}
+
+inline Quatf Quatf::GetConjugate() const
+{
+	return _mm_xor_ps(data, _mm_set_ps(0.0f, -0.0f, -0.0f, -0.0f));
+}
+
+inline Vec3f Quatf::Rotate(const Vec3f& aVector) const
+{
+	// v + w * t + u x t with t = 2 * (u x v), u being the vector part
+	const Vec3f vectorPart(_mm_blend_ps(data, _mm_setzero_ps(), 0x8));
+	const Vec3f twice = vectorPart.Cross(aVector) * 2.0f;
+	return aVector + twice * w + vectorPart.Cross(twice);
+}
+
+inline Mat4x4f Quatf::ToMat4x4f() const
+{
+	const float xx = x * x, yy = y * y, zz = z * z;
+	const float xy = x * y, xz = x * z, yz = y * z;
+	const float wx = w * x, wy = w * y, wz = w * z;
+
+	// Transposed compared to the column-vector matrix, Mat4x4f multiplies row vectors from the left
+	return Mat4x4f(
+		1.0f - 2.0f * (yy + zz), 2.0f * (xy + wz), 2.0f * (xz - wy), 0.0f,
+		2.0f * (xy - wz), 1.0f - 2.0f * (xx + zz), 2.0f * (yz + wx), 0.0f,
+		2.0f * (xz + wy), 2.0f * (yz - wx), 1.0f - 2.0f * (xx + yy), 0.0f,
+		0.0f, 0.0f, 0.0f, 1.0f);
+}
+
+#pragma endregion ClassFunctions
+
+#pragma region OperatorDefinitions
+
+inline Quatf operator*(const Quatf& aOne, const Quatf& aTwo)
+{
+	// Each lane of aOne times a permutation of aTwo, with the signs of the Hamilton product
+	const __m128 q = aTwo.data;
+	const __m128 wTerms = _mm_mul_ps(BB::Simd::Splat<3>(aOne.data), q);
+	const __m128 xTerms = _mm_mul_ps(BB::Simd::Splat<0>(aOne.data), _mm_xor_ps(_mm_shuffle_ps(q, q, _MM_SHUFFLE(0, 1, 2, 3)), _mm_set_ps(-0.0f, 0.0f, -0.0f, 0.0f)));
+	const __m128 yTerms = _mm_mul_ps(BB::Simd::Splat<1>(aOne.data), _mm_xor_ps(_mm_shuffle_ps(q, q, _MM_SHUFFLE(1, 0, 3, 2)), _mm_set_ps(-0.0f, -0.0f, 0.0f, 0.0f)));
+	const __m128 zTerms = _mm_mul_ps(BB::Simd::Splat<2>(aOne.data), _mm_xor_ps(_mm_shuffle_ps(q, q, _MM_SHUFFLE(2, 3, 0, 1)), _mm_set_ps(-0.0f, 0.0f, 0.0f, -0.0f)));
+	return _mm_add_ps(_mm_add_ps(wTerms, xTerms), _mm_add_ps(yTerms, zTerms));
+}
+
+inline void operator*=(Quatf& aOne, const Quatf& aTwo)
+{
+	aOne = aOne * aTwo;
+}
+
+inline bool operator==(const Quatf& aOne, const Quatf& aTwo)
+{
+	return _mm_movemask_ps(_mm_cmpeq_ps(aOne.data, aTwo.data)) == 0xF;
+}
+
+inline bool operator!=(const Quatf& aOne, const Quatf& aTwo)
+{
+	return !(aOne == aTwo);
+}
+
+#pragma endregion OperatorDefinitions
@@ -0,0 +1,120 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "../Memory/AlignedAllocator.h"
+#include "../Vector/Vector3f/Vector3f.h"
+#include "../Matrix/Matrix4x4f/Matrix4x4f.h"
+#include "../Parallel/ThreadPool.h"
+
+/**
+ * @file TransformHierarchy.h
+ * @brief Scene graph transforms that only recompute the subtrees whose local transform changed.
+ *
+ * @details Nodes are stored breadth-first in structure-of-arrays form: every level is a contiguous
+ * range and parents always come before their children, so one forward pass over the arrays sees
+ * each parent world matrix before its children need it. SetLocal marks a node dirty, Update walks
+ * the levels, passes the dirty bit from parent to child and for dirty nodes computes
+ * {@code world = local * parentWorld} (row vectors, as everywhere in the library) and refits the
+ * world space AABB of the node in the same loop. Levels without dirty nodes under a clean parent
+ * level are skipped without touching their matrices.
+ *
+ * Update(ThreadPool&) splits each level over the pool. Levels are still processed in order, a
+ * level only depends on the one above it.
+ *
+ * @code
+ * BB::TransformHierarchy scene;
+ * BB::TransformNodeId root = scene.AddNode(BB::INVALID_TRANSFORM_NODE, Mat4x4f());
+ * BB::TransformNodeId wheel = scene.AddNode(root, Mat4x4f(Vec3f(1.0f, 0.0f, 0.0f)), meshMin, meshMax);
+ * ...
+ * scene.SetLocal(root, carTransform);
+ * scene.Update(pool);
+ * Draw(scene.GetWorld(wheel));
+ * @endcode
+ *
+ * @warning World matrices and bounds are only valid after Update. Adding nodes changes the
+ * breadth-first order, the next Update rebuilds it once. Nodes cannot be removed.
+ */
+
+namespace BitBloom
+{
+/// @brief Stable handle of a node, unaffected by the breadth-first reordering.
+	using TransformNodeId = uint32_t;
+	constexpr TransformNodeId INVALID_TRANSFORM_NODE = UINT32_MAX;
+
+	class TransformHierarchy
+	{
+	public:
+		inline TransformHierarchy();
+
+		inline void Reserve(size_t aCount);
+
+/**
+* @brief Adds a node below aParent, or a root when aParent is INVALID_TRANSFORM_NODE.
+*
+* @param aBoundsMin, aBoundsMax Local space AABB of whatever the node carries, zero size for empty nodes.
+*/
+		inline TransformNodeId AddNode(TransformNodeId aParent, const Mat4x4f& aLocal, const Vec3f& aBoundsMin = Vec3f(0.0f), const Vec3f& aBoundsMax = Vec3f(0.0f));
+
+/// @brief Sets the transform relative to the parent and marks the node and its subtree dirty.
+		inline void SetLocal(TransformNodeId aNode, const Mat4x4f& aLocal);
+		inline void SetLocalBounds(TransformNodeId aNode, const Vec3f& aBoundsMin, const Vec3f& aBoundsMax);
+
+		inline const Mat4x4f& GetLocal(TransformNodeId aNode) const;
+		inline const Mat4x4f& GetWorld(TransformNodeId aNode) const;
+		inline void GetWorldBounds(TransformNodeId aNode, Vec3f& aOutMin, Vec3f& aOutMax) const;
+		inline TransformNodeId GetParent(TransformNodeId aNode) const;
+
+/**
+* @brief Recomputes the world matrices and bounds of all dirty subtrees.
+*
+* @return The number of nodes that were recomputed.
+*/
+		inline size_t Update();
+/// @brief Same as Update(), each level is split over aPool.
+		inline size_t Update(ThreadPool& aPool);
+
+/**
+* @name Breadth-first arrays
+* @brief Direct access to the world data for renderers and culling, valid until the next AddNode.
+* @{
+*/
+		inline size_t GetNodeCount() const;
+		inline size_t GetLevelCount() const;
+/// @brief Position of aNode in the breadth-first arrays.
+		inline size_t GetIndex(TransformNodeId aNode) const;
+		inline const Mat4x4f* GetWorldMatrices() const;
+		inline const Vec3f* GetWorldBoundsMin() const;
+		inline const Vec3f* GetWorldBoundsMax() const;
+/** @} */
+
+	private:
+		template<class LevelFunction>
+		inline size_t UpdateLevels(LevelFunction&& aUpdateLevel);
+		inline size_t UpdateRange(size_t aBegin, size_t aEnd);
+		inline void RebuildLayout();
+		inline size_t GetLevelOfIndex(size_t aIndex) const;
+
+		// Breadth-first order. Mat4x4f is one cache line, so threads writing neighbouring nodes never share a line
+		AlignedVector<Mat4x4f, CACHE_LINE_SIZE> myLocal;
+		AlignedVector<Mat4x4f, CACHE_LINE_SIZE> myWorld;
+		AlignedVector<Vec3f> myLocalMin;
+		AlignedVector<Vec3f> myLocalMax;
+		AlignedVector<Vec3f> myWorldMin;
+		AlignedVector<Vec3f> myWorldMax;
+		std::vector<uint32_t> myParentIndex;
+		std::vector<uint8_t> myDirty;
+
+		// myLevelStart[level] is the first index of the level, with one extra entry for the end
+		std::vector<uint32_t> myLevelStart;
+		std::vector<uint8_t> myLevelDirty;
+
+		std::vector<uint32_t> myIndexOfNode;
+		std::vector<TransformNodeId> myNodeOfIndex;
+		bool myLayoutDirty;
+	};
+} // namespace BitBloom
+
+namespace BB = BitBloom;
+
+#include "TransformHierarchy.inl"
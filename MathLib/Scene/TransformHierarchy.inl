@@ -0,0 +1,317 @@
+#pragma once
+#include "TransformHierarchy.h"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstring>
+
+namespace BitBloom
+{
+namespace Detail
+{
+/**
+* @brief World space AABB of a local AABB, using the center and the absolute rotation part.
+*
+* @details The result encloses the eight transformed corners exactly without transforming them.
+*/
+	inline void TransformBounds(const Mat4x4f& aMatrix, const Vec3f& aMin, const Vec3f& aMax, Vec3f& aOutMin, Vec3f& aOutMax)
+	{
+		const __m128 half = _mm_set1_ps(0.5f);
+		const __m128 center = _mm_mul_ps(_mm_add_ps(aMin.data, aMax.data), half);
+		const __m128 extent = _mm_mul_ps(_mm_sub_ps(aMax.data, aMin.data), half);
+
+		__m128 worldCenter = BB::Simd::MulAdd(BB::Simd::Splat<0>(center), aMatrix.row[0], aMatrix.row[3]);
+		worldCenter = BB::Simd::MulAdd(BB::Simd::Splat<1>(center), aMatrix.row[1], worldCenter);
+		worldCenter = BB::Simd::MulAdd(BB::Simd::Splat<2>(center), aMatrix.row[2], worldCenter);
+
+		__m128 worldExtent = _mm_mul_ps(BB::Simd::Splat<0>(extent), BB::Simd::Abs(aMatrix.row[0]));
+		worldExtent = BB::Simd::MulAdd(BB::Simd::Splat<1>(extent), BB::Simd::Abs(aMatrix.row[1]), worldExtent);
+		worldExtent = BB::Simd::MulAdd(BB::Simd::Splat<2>(extent), BB::Simd::Abs(aMatrix.row[2]), worldExtent);
+
+		// w is cleared to keep the Vec3f invariant
+		const __m128 zero = _mm_setzero_ps();
+		aOutMin = _mm_blend_ps(_mm_sub_ps(worldCenter, worldExtent), zero, 0x8);
+		aOutMax = _mm_blend_ps(_mm_add_ps(worldCenter, worldExtent), zero, 0x8);
+	}
+} // namespace Detail
+
+	inline TransformHierarchy::TransformHierarchy()
+		: myLayoutDirty(false)
+	{
+		myLevelStart.push_back(0);
+	}
+
+	inline void TransformHierarchy::Reserve(size_t aCount)
+	{
+		myLocal.reserve(aCount);
+		myWorld.reserve(aCount);
+		myLocalMin.reserve(aCount);
+		myLocalMax.reserve(aCount);
+		myWorldMin.reserve(aCount);
+		myWorldMax.reserve(aCount);
+		myParentIndex.reserve(aCount);
+		myDirty.reserve(aCount);
+		myIndexOfNode.reserve(aCount);
+		myNodeOfIndex.reserve(aCount);
+	}
+
+	inline TransformNodeId TransformHierarchy::AddNode(TransformNodeId aParent, const Mat4x4f& aLocal, const Vec3f& aBoundsMin, const Vec3f& aBoundsMax)
+	{
+		assert((aParent == INVALID_TRANSFORM_NODE || aParent < myIndexOfNode.size()) && "The parent has to be added before its children");
+
+		const TransformNodeId node = TransformNodeId(myIndexOfNode.size());
+		const uint32_t index = uint32_t(myLocal.size());
+
+		// Appended at the end for now, the next Update moves it to its level
+		myLocal.push_back(aLocal);
+		myWorld.push_back(aLocal);
+		myLocalMin.push_back(aBoundsMin);
+		myLocalMax.push_back(aBoundsMax);
+		myWorldMin.push_back(aBoundsMin);
+		myWorldMax.push_back(aBoundsMax);
+		myParentIndex.push_back(aParent == INVALID_TRANSFORM_NODE ? UINT32_MAX : myIndexOfNode[aParent]);
+		myDirty.push_back(1);
+		myIndexOfNode.push_back(index);
+		myNodeOfIndex.push_back(node);
+		myLayoutDirty = true;
+		return node;
+	}
+
+	inline void TransformHierarchy::SetLocal(TransformNodeId aNode, const Mat4x4f& aLocal)
+	{
+		const size_t index = myIndexOfNode[aNode];
+		myLocal[index] = aLocal;
+		myDirty[index] = 1;
+		if (!myLayoutDirty)
+		{
+			myLevelDirty[GetLevelOfIndex(index)] = 1;
+		}
+	}
+
+	inline void TransformHierarchy::SetLocalBounds(TransformNodeId aNode, const Vec3f& aBoundsMin, const Vec3f& aBoundsMax)
+	{
+		const size_t index = myIndexOfNode[aNode];
+		myLocalMin[index] = aBoundsMin;
+		myLocalMax[index] = aBoundsMax;
+		myDirty[index] = 1;
+		if (!myLayoutDirty)
+		{
+			myLevelDirty[GetLevelOfIndex(index)] = 1;
+		}
+	}
+
+	inline const Mat4x4f& TransformHierarchy::GetLocal(TransformNodeId aNode) const
+	{
+		return myLocal[myIndexOfNode[aNode]];
+	}
+
+	inline const Mat4x4f& TransformHierarchy::GetWorld(TransformNodeId aNode) const
+	{
+		return myWorld[myIndexOfNode[aNode]];
+	}
+
+	inline void TransformHierarchy::GetWorldBounds(TransformNodeId aNode, Vec3f& aOutMin, Vec3f& aOutMax) const
+	{
+		const size_t index = myIndexOfNode[aNode];
+		aOutMin = myWorldMin[index];
+		aOutMax = myWorldMax[index];
+	}
+
+	inline TransformNodeId TransformHierarchy::GetParent(TransformNodeId aNode) const
+	{
+		const uint32_t parent = myParentIndex[myIndexOfNode[aNode]];
+		return parent == UINT32_MAX ? INVALID_TRANSFORM_NODE : myNodeOfIndex[parent];
+	}
+
+	inline size_t TransformHierarchy::Update()
+	{
+		return UpdateLevels([this](size_t aBegin, size_t aEnd)
+		{
+			return UpdateRange(aBegin, aEnd);
+		});
+	}
+
+	inline size_t TransformHierarchy::Update(ThreadPool& aPool)
+	{
+		return UpdateLevels([this, &aPool](size_t aBegin, size_t aEnd)
+		{
+			std::atomic<size_t> updated = 0;
+			aPool.ParallelForArray<Mat4x4f>(aEnd - aBegin, 0, [this, aBegin, &updated](size_t aChunkBegin, size_t aChunkEnd)
+			{
+				updated.fetch_add(UpdateRange(aBegin + aChunkBegin, aBegin + aChunkEnd), std::memory_order_relaxed);
+			});
+			return updated.load(std::memory_order_relaxed);
+		});
+	}
+
+	inline size_t TransformHierarchy::GetNodeCount() const
+	{
+		return myLocal.size();
+	}
+
+	inline size_t TransformHierarchy::GetLevelCount() const
+	{
+		return myLevelStart.size() - 1;
+	}
+
+	inline size_t TransformHierarchy::GetIndex(TransformNodeId aNode) const
+	{
+		return myIndexOfNode[aNode];
+	}
+
+	inline const Mat4x4f* TransformHierarchy::GetWorldMatrices() const
+	{
+		return myWorld.data();
+	}
+
+	inline const Vec3f* TransformHierarchy::GetWorldBoundsMin() const
+	{
+		return myWorldMin.data();
+	}
+
+	inline const Vec3f* TransformHierarchy::GetWorldBoundsMax() const
+	{
+		return myWorldMax.data();
+	}
+
+	template<class LevelFunction>
+	inline size_t TransformHierarchy::UpdateLevels(LevelFunction&& aUpdateLevel)
+	{
+		if (myLayoutDirty)
+		{
+			RebuildLayout();
+		}
+
+		size_t updated = 0;
+		size_t previousUpdated = 0;
+		for (size_t level = 0; level < GetLevelCount(); ++level)
+		{
+			const size_t begin = myLevelStart[level];
+			const size_t end = myLevelStart[level + 1];
+			size_t levelUpdated = 0;
+			if (myLevelDirty[level] || previousUpdated > 0)
+			{
+				levelUpdated = aUpdateLevel(begin, end);
+				myLevelDirty[level] = 0;
+			}
+
+			// The children have read the dirty bits of the level above, so they can be cleared
+			if (previousUpdated > 0)
+			{
+				std::memset(myDirty.data() + myLevelStart[level - 1], 0, begin - myLevelStart[level - 1]);
+			}
+			previousUpdated = levelUpdated;
+			updated += levelUpdated;
+		}
+
+		if (previousUpdated > 0)
+		{
+			const size_t lastLevel = GetLevelCount() - 1;
+			std::memset(myDirty.data() + myLevelStart[lastLevel], 0, myLevelStart[lastLevel + 1] - myLevelStart[lastLevel]);
+		}
+		return updated;
+	}
+
+	inline size_t TransformHierarchy::UpdateRange(size_t aBegin, size_t aEnd)
+	{
+		size_t updated = 0;
+		for (size_t index = aBegin; index < aEnd; ++index)
+		{
+			const uint32_t parent = myParentIndex[index];
+			if (parent != UINT32_MAX)
+			{
+				myDirty[index] |= myDirty[parent];
+			}
+			if (!myDirty[index])
+			{
+				continue;
+			}
+
+			if (parent == UINT32_MAX)
+			{
+				myWorld[index] = myLocal[index];
+			}
+			else
+			{
+				Multiply(myLocal[index], myWorld[parent], myWorld[index]);
+			}
+			Detail::TransformBounds(myWorld[index], myLocalMin[index], myLocalMax[index], myWorldMin[index], myWorldMax[index]);
+			++updated;
+		}
+		return updated;
+	}
+
+	inline void TransformHierarchy::RebuildLayout()
+	{
+		const size_t count = myLocal.size();
+
+		// Parents always come before their children, so one pass finds every depth
+		std::vector<uint32_t> depth(count);
+		size_t levelCount = 0;
+		for (size_t index = 0; index < count; ++index)
+		{
+			depth[index] = myParentIndex[index] == UINT32_MAX ? 0 : depth[myParentIndex[index]] + 1;
+			levelCount = std::max<size_t>(levelCount, depth[index] + 1);
+		}
+
+		// Stable counting sort by depth keeps siblings next to each other
+		myLevelStart.assign(levelCount + 1, 0);
+		for (size_t index = 0; index < count; ++index)
+		{
+			myLevelStart[depth[index] + 1]++;
+		}
+		for (size_t level = 0; level < levelCount; ++level)
+		{
+			myLevelStart[level + 1] += myLevelStart[level];
+		}
+
+		std::vector<uint32_t> newIndex(count);
+		std::vector<uint32_t> cursor(myLevelStart.begin(), myLevelStart.end() - 1);
+		for (size_t index = 0; index < count; ++index)
+		{
+			newIndex[index] = cursor[depth[index]]++;
+		}
+
+		const auto permute = [&newIndex, count](auto& aArray)
+		{
+			std::remove_reference_t<decltype(aArray)> sorted(count);
+			for (size_t index = 0; index < count; ++index)
+			{
+				sorted[newIndex[index]] = aArray[index];
+			}
+			aArray.swap(sorted);
+		};
+		permute(myLocal);
+		permute(myWorld);
+		permute(myLocalMin);
+		permute(myLocalMax);
+		permute(myWorldMin);
+		permute(myWorldMax);
+		permute(myDirty);
+		permute(myNodeOfIndex);
+		permute(myParentIndex);
+		for (uint32_t& parent : myParentIndex)
+		{
+			parent = parent == UINT32_MAX ? UINT32_MAX : newIndex[parent];
+		}
+		for (uint32_t& index : myIndexOfNode)
+		{
+			index = newIndex[index];
+		}
+
+		myLevelDirty.assign(levelCount, 0);
+		for (size_t level = 0; level < levelCount; ++level)
+		{
+			for (size_t index = myLevelStart[level]; index < myLevelStart[level + 1] && !myLevelDirty[level]; ++index)
+			{
+				myLevelDirty[level] = myDirty[index];
+			}
+		}
+		myLayoutDirty = false;
+	}
+
+	inline size_t TransformHierarchy::GetLevelOfIndex(size_t aIndex) const
+	{
+		return size_t(std::upper_bound(myLevelStart.begin(), myLevelStart.end(), uint32_t(aIndex)) - myLevelStart.begin()) - 1;
+	}
+} // namespace BitBloom
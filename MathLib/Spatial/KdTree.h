@@ -0,0 +1,122 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "../Memory/AlignedAllocator.h"
+#include "../Util/Float8.h"
+#include "../Vector/Vector3f/Vector3f.h"
+#include "../Parallel/ThreadPool.h"
+
+/**
+ * @file KdTree.h
+ * @brief Static k-d tree over a Vec3f point cloud for k nearest neighbor and radius queries.
+ *
+ * @details The tree is balanced and stored implicitly: the children of internal node i are
+ * 2i + 1 and 2i + 2 and the nodes hold nothing but a split value and axis, so the top levels
+ * touched by every query share a few cache lines. The 2^depth leaves split the points evenly,
+ * leaf j owns the points [j * count / leafCount, (j + 1) * count / leafCount) of the reordered
+ * cloud, between KD_LEAF_SIZE / 2 and KD_LEAF_SIZE of them. Leaf points are kept in
+ * structure-of-arrays form and queries test eight of them per step with Float8.
+ *
+ * Build splits each node at the median of its points along the axis where their bounds are
+ * widest. Build(ThreadPool&) spreads the nodes of each level over the pool until there are enough
+ * subtrees for every thread, which are then built independently. Both produce the same tree.
+ *
+ * Query results use the index of the point in the array passed to Build. Distances are squared.
+ * The batched queries take one query per point of aQueries and run chunks of them on the pool.
+ * Queries sorted along a space filling curve (Bulk::EncodeMorton, Bulk::RadixSort) walk similar
+ * paths one after the other and run noticeably faster on large clouds.
+ *
+ * @code
+ * BB::KdTree tree;
+ * tree.Build(pool, points.data(), points.size());
+ * uint32_t neighbors[8];
+ * float distancesSquared[8];
+ * size_t found = tree.FindNearest(query, 8, neighbors, distancesSquared);
+ * @endcode
+ */
+
+namespace BitBloom
+{
+/// @brief Most points in a leaf, leaves hold at least half as many.
+	inline constexpr size_t KD_LEAF_SIZE = 16;
+/// @brief Marks the unused entries of batched nearest neighbor results.
+	inline constexpr uint32_t KD_INVALID_INDEX = ~uint32_t(0);
+
+	class KdTree
+	{
+	public:
+/// @brief Builds over a copy of aPoints, which can be released afterwards. Replaces the previous tree.
+		inline void Build(const Vec3f* aPoints, size_t aCount);
+		inline void Build(ThreadPool& aPool, const Vec3f* aPoints, size_t aCount);
+
+		inline size_t GetCount() const;
+		inline int GetDepth() const;
+
+/**
+* @brief Finds the aK points closest to aPoint, nearest first.
+*
+* @details Returns the number found, min(aK, GetCount()). Equal distances come out in no
+* particular order. The result list is kept sorted by insertion, aK is meant to be small (tens).
+*/
+		inline size_t FindNearest(const Vec3f& aPoint, size_t aK, uint32_t* aOutIndices, float* aOutDistancesSquared) const;
+/// @brief Replaces the content of aOutIndices with every point within aRadius (inclusive), in tree order.
+		inline void FindInRadius(const Vec3f& aPoint, float aRadius, std::vector<uint32_t>& aOutIndices) const;
+
+/**
+* @brief FindNearest for aQueryCount points, query q writes aK entries starting at q * aK.
+*
+* @details Entries past the number found are KD_INVALID_INDEX with a distance of +infinity.
+*/
+		inline void FindNearest(ThreadPool& aPool, const Vec3f* aQueries, size_t aQueryCount, size_t aK, uint32_t* aOutIndices, float* aOutDistancesSquared) const;
+/**
+* @brief FindInRadius for aQueryCount points.
+*
+* @details The result of query q is aOutIndices[aOutOffsets[q]] to aOutIndices[aOutOffsets[q + 1]],
+* aOutOffsets gets aQueryCount + 1 entries. Chunks collect their own results which are joined in
+* query order.
+*/
+		inline void FindInRadius(ThreadPool& aPool, const Vec3f* aQueries, size_t aQueryCount, float aRadius, std::vector<uint32_t>& aOutOffsets, std::vector<uint32_t>& aOutIndices) const;
+
+	private:
+		struct BuildPoint
+		{
+			float position[3];
+			uint32_t index;
+		};
+
+		inline void BuildTree(ThreadPool* aPool, const Vec3f* aPoints, size_t aCount);
+		inline void SplitNode(size_t aNode);
+		inline void BuildSubtree(size_t aNode);
+		inline size_t GetLeafBegin(size_t aLeaf) const;
+
+/**
+* @brief Calls aOnPoint(index, distanceSquared) for the points within aLimitSquared (inclusive) of aPoint.
+*
+* @details aOnPoint may lower aLimitSquared, later nodes and points are tested against the new value.
+*/
+		template<class Function>
+		inline void Visit(const Vec3f& aPoint, float& aLimitSquared, Function&& aOnPoint) const;
+
+		int myDepth = 0;
+		size_t myCount = 0;
+		size_t myInternalCount = 0;
+
+		// Internal nodes in implicit breadth-first order
+		std::vector<float> mySplits;
+		std::vector<uint8_t> myAxes;
+
+		// Points in leaf order, padded with one Float8 so leaves can always load eight
+		AlignedVector<float, CACHE_LINE_SIZE> myX;
+		AlignedVector<float, CACHE_LINE_SIZE> myY;
+		AlignedVector<float, CACHE_LINE_SIZE> myZ;
+		std::vector<uint32_t> myIndices;
+
+		// Only used during Build
+		std::vector<BuildPoint> myBuildPoints;
+	};
+} // namespace BitBloom
+
+namespace BB = BitBloom;
+
+#include "KdTree.inl"
@@ -0,0 +1,328 @@
+#pragma once
+#include "KdTree.h"
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <limits>
+
+namespace BitBloom
+{
+namespace Detail
+{
+/// @brief Queries per chunk of the batched KdTree queries.
+	inline constexpr size_t KD_QUERY_GRAIN = 256;
+
+	struct KdStackEntry
+	{
+		size_t node;
+		float distanceSquared;
+	};
+} // namespace Detail
+
+	inline void KdTree::Build(const Vec3f* aPoints, size_t aCount)
+	{
+		BuildTree(nullptr, aPoints, aCount);
+	}
+
+	inline void KdTree::Build(ThreadPool& aPool, const Vec3f* aPoints, size_t aCount)
+	{
+		BuildTree(&aPool, aPoints, aCount);
+	}
+
+	inline size_t KdTree::GetCount() const
+	{
+		return myCount;
+	}
+
+	inline int KdTree::GetDepth() const
+	{
+		return myDepth;
+	}
+
+	inline void KdTree::BuildTree(ThreadPool* aPool, const Vec3f* aPoints, size_t aCount)
+	{
+		assert(aCount < KD_INVALID_INDEX);
+		myCount = aCount;
+		myDepth = 0;
+		while (aCount > (KD_LEAF_SIZE << myDepth))
+		{
+			++myDepth;
+		}
+		myInternalCount = (size_t(1) << myDepth) - 1;
+		mySplits.resize(myInternalCount);
+		myAxes.resize(myInternalCount);
+
+		myBuildPoints.resize(aCount);
+		for (size_t i = 0; i < aCount; ++i)
+		{
+			myBuildPoints[i] = { { aPoints[i].x, aPoints[i].y, aPoints[i].z }, uint32_t(i) };
+		}
+
+		if (aPool == nullptr)
+		{
+			BuildSubtree(0);
+		}
+		else
+		{
+			// Levels are split node by node until there are enough independent subtrees to keep every thread busy
+			const size_t subtreeCount = aPool->GetThreadCount() * 4;
+			for (size_t first = 0; first < myInternalCount; first = first * 2 + 1)
+			{
+				const size_t levelEnd = first * 2 + 1;
+				if (levelEnd - first >= subtreeCount)
+				{
+					aPool->ParallelFor(first, levelEnd, 1, [&](size_t aBegin, size_t aEnd)
+					{
+						for (size_t node = aBegin; node < aEnd; ++node)
+						{
+							BuildSubtree(node);
+						}
+					});
+					break;
+				}
+				aPool->ParallelFor(first, levelEnd, 1, [&](size_t aBegin, size_t aEnd)
+				{
+					for (size_t node = aBegin; node < aEnd; ++node)
+					{
+						SplitNode(node);
+					}
+				});
+			}
+		}
+
+		myX.assign(aCount + 8, 0.0f);
+		myY.assign(aCount + 8, 0.0f);
+		myZ.assign(aCount + 8, 0.0f);
+		myIndices.resize(aCount);
+		for (size_t i = 0; i < aCount; ++i)
+		{
+			const BuildPoint& point = myBuildPoints[i];
+			myX[i] = point.position[0];
+			myY[i] = point.position[1];
+			myZ[i] = point.position[2];
+			myIndices[i] = point.index;
+		}
+		std::vector<BuildPoint>().swap(myBuildPoints);
+	}
+
+	inline void KdTree::SplitNode(size_t aNode)
+	{
+		// The node is number position of its level and covers leafSpan leaves
+		const int level = int(std::bit_width(aNode + 1)) - 1;
+		const size_t position = aNode + 1 - (size_t(1) << level);
+		const size_t leafSpan = size_t(1) << (myDepth - level);
+		BuildPoint* begin = myBuildPoints.data() + GetLeafBegin(position * leafSpan);
+		BuildPoint* middle = myBuildPoints.data() + GetLeafBegin(position * leafSpan + leafSpan / 2);
+		BuildPoint* end = myBuildPoints.data() + GetLeafBegin((position + 1) * leafSpan);
+
+		// The w lane holds the index bits and is ignored
+		__m128 minimum = _mm_set1_ps(std::numeric_limits<float>::max());
+		__m128 maximum = _mm_set1_ps(-std::numeric_limits<float>::max());
+		for (const BuildPoint* point = begin; point != end; ++point)
+		{
+			const __m128 position = _mm_loadu_ps(point->position);
+			minimum = _mm_min_ps(minimum, position);
+			maximum = _mm_max_ps(maximum, position);
+		}
+		alignas(16) float extent[4];
+		_mm_store_ps(extent, _mm_sub_ps(maximum, minimum));
+		const int axis = extent[0] >= extent[1] && extent[0] >= extent[2] ? 0 : (extent[1] >= extent[2] ? 1 : 2);
+
+		std::nth_element(begin, middle, end, [axis](const BuildPoint& aOne, const BuildPoint& aTwo)
+		{
+			return aOne.position[axis] < aTwo.position[axis];
+		});
+		mySplits[aNode] = middle->position[axis];
+		myAxes[aNode] = uint8_t(axis);
+	}
+
+	inline void KdTree::BuildSubtree(size_t aNode)
+	{
+		if (aNode >= myInternalCount)
+		{
+			return;
+		}
+		SplitNode(aNode);
+		BuildSubtree(aNode * 2 + 1);
+		BuildSubtree(aNode * 2 + 2);
+	}
+
+	inline size_t KdTree::GetLeafBegin(size_t aLeaf) const
+	{
+		return size_t((uint64_t(aLeaf) * myCount) >> myDepth);
+	}
+
+	template<class Function>
+	inline void KdTree::Visit(const Vec3f& aPoint, float& aLimitSquared, Function&& aOnPoint) const
+	{
+		using namespace BB::Simd;
+
+		if (myCount == 0)
+		{
+			return;
+		}
+
+		alignas(32) static constexpr float laneIndices[8] = { 0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f };
+		const Float8 lanes = LoadFloat8(laneIndices);
+		const Float8 queryX = SplatFloat8(aPoint.x);
+		const Float8 queryY = SplatFloat8(aPoint.y);
+		const Float8 queryZ = SplatFloat8(aPoint.z);
+		const float query[3] = { aPoint.x, aPoint.y, aPoint.z };
+
+		// Every descent pushes one far child per level, the stack never holds more than the depth plus one
+		Detail::KdStackEntry stack[64];
+		int top = 0;
+		stack[top++] = { 0, 0.0f };
+		while (top > 0)
+		{
+			const Detail::KdStackEntry entry = stack[--top];
+			if (entry.distanceSquared > aLimitSquared)
+			{
+				continue;
+			}
+
+			size_t node = entry.node;
+			while (node < myInternalCount)
+			{
+				const float difference = query[myAxes[node]] - mySplits[node];
+				const size_t nearChild = node * 2 + (difference < 0.0f ? 1 : 2);
+				const size_t farChild = node * 4 + 3 - nearChild;
+				// Far children further than the limit are not worth a stack slot
+				if (difference * difference <= aLimitSquared)
+				{
+					stack[top++] = { farChild, difference * difference };
+				}
+				node = nearChild;
+			}
+
+			const size_t leaf = node - myInternalCount;
+			const size_t begin = GetLeafBegin(leaf);
+			const size_t end = GetLeafBegin(leaf + 1);
+			for (size_t i = begin; i < end; i += 8)
+			{
+				const Float8 dx = Sub(LoadUnalignedFloat8(myX.data() + i), queryX);
+				const Float8 dy = Sub(LoadUnalignedFloat8(myY.data() + i), queryY);
+				const Float8 dz = Sub(LoadUnalignedFloat8(myZ.data() + i), queryZ);
+				const Float8 distanceSquared = MulAdd(dz, dz, MulAdd(dy, dy, Mul(dx, dx)));
+				const Float8 inLeaf = GreaterMask(SplatFloat8(float(end - i)), lanes);
+				int mask = MoveMask(And(inLeaf, GreaterEqualMask(SplatFloat8(aLimitSquared), distanceSquared)));
+				if (mask == 0)
+				{
+					continue;
+				}
+
+				alignas(32) float distances[8];
+				StoreFloat8(distances, distanceSquared);
+				while (mask != 0)
+				{
+					const int lane = std::countr_zero(unsigned(mask));
+					mask &= mask - 1;
+					// The limit may have dropped since the compare
+					if (distances[lane] <= aLimitSquared)
+					{
+						aOnPoint(myIndices[i + lane], distances[lane]);
+					}
+				}
+			}
+		}
+	}
+
+	inline size_t KdTree::FindNearest(const Vec3f& aPoint, size_t aK, uint32_t* aOutIndices, float* aOutDistancesSquared) const
+	{
+		if (aK == 0)
+		{
+			return 0;
+		}
+
+		size_t found = 0;
+		float limit = std::numeric_limits<float>::infinity();
+		Visit(aPoint, limit, [&](uint32_t aIndex, float aDistanceSquared)
+		{
+			size_t slot;
+			if (found < aK)
+			{
+				slot = found++;
+			}
+			else if (aDistanceSquared < aOutDistancesSquared[aK - 1])
+			{
+				slot = aK - 1;
+			}
+			else
+			{
+				return;
+			}
+
+			// Insertion into the sorted list
+			while (slot > 0 && aOutDistancesSquared[slot - 1] > aDistanceSquared)
+			{
+				aOutDistancesSquared[slot] = aOutDistancesSquared[slot - 1];
+				aOutIndices[slot] = aOutIndices[slot - 1];
+				--slot;
+			}
+			aOutDistancesSquared[slot] = aDistanceSquared;
+			aOutIndices[slot] = aIndex;
+			if (found == aK)
+			{
+				limit = aOutDistancesSquared[aK - 1];
+			}
+		});
+		return found;
+	}
+
+	inline void KdTree::FindInRadius(const Vec3f& aPoint, float aRadius, std::vector<uint32_t>& aOutIndices) const
+	{
+		aOutIndices.clear();
+		float limit = aRadius * aRadius;
+		Visit(aPoint, limit, [&](uint32_t aIndex, float)
+		{
+			aOutIndices.push_back(aIndex);
+		});
+	}
+
+	inline void KdTree::FindNearest(ThreadPool& aPool, const Vec3f* aQueries, size_t aQueryCount, size_t aK, uint32_t* aOutIndices, float* aOutDistancesSquared) const
+	{
+		aPool.ParallelFor(0, aQueryCount, Detail::KD_QUERY_GRAIN, [&](size_t aBegin, size_t aEnd)
+		{
+			for (size_t query = aBegin; query < aEnd; ++query)
+			{
+				uint32_t* indices = aOutIndices + query * aK;
+				float* distances = aOutDistancesSquared + query * aK;
+				const size_t found = FindNearest(aQueries[query], aK, indices, distances);
+				std::fill(indices + found, indices + aK, KD_INVALID_INDEX);
+				std::fill(distances + found, distances + aK, std::numeric_limits<float>::infinity());
+			}
+		});
+	}
+
+	inline void KdTree::FindInRadius(ThreadPool& aPool, const Vec3f* aQueries, size_t aQueryCount, float aRadius, std::vector<uint32_t>& aOutOffsets, std::vector<uint32_t>& aOutIndices) const
+	{
+		std::vector<std::vector<uint32_t>> chunkIndices((aQueryCount + Detail::KD_QUERY_GRAIN - 1) / Detail::KD_QUERY_GRAIN);
+		aOutOffsets.assign(aQueryCount + 1, 0);
+		aPool.ParallelFor(0, aQueryCount, Detail::KD_QUERY_GRAIN, [&](size_t aBegin, size_t aEnd)
+		{
+			std::vector<uint32_t>& indices = chunkIndices[aBegin / Detail::KD_QUERY_GRAIN];
+			for (size_t query = aBegin; query < aEnd; ++query)
+			{
+				const size_t before = indices.size();
+				float limit = aRadius * aRadius;
+				Visit(aQueries[query], limit, [&](uint32_t aIndex, float)
+				{
+					indices.push_back(aIndex);
+				});
+				// Counts for now, turned into offsets once every chunk is done
+				aOutOffsets[query + 1] = uint32_t(indices.size() - before);
+			}
+		});
+
+		for (size_t query = 0; query < aQueryCount; ++query)
+		{
+			aOutOffsets[query + 1] += aOutOffsets[query];
+		}
+		aOutIndices.clear();
+		aOutIndices.reserve(aOutOffsets[aQueryCount]);
+		for (const std::vector<uint32_t>& indices : chunkIndices)
+		{
+			aOutIndices.insert(aOutIndices.end(), indices.begin(), indices.end());
+		}
+	}
+} // namespace BitBloom
@@ -0,0 +1,99 @@
+#pragma once
+#include <immintrin.h>
+#include <utility>
+
+/**
+ * @file Denormals.h
+ * @brief Control of the SSE flush-to-zero (FTZ) and denormals-are-zero (DAZ) modes.
+ *
+ * @details Values below FLT_MIN (about 1.2e-38) are denormal. Most x86 cores handle an SSE
+ * instruction with a denormal input or result through a microcode assist that costs around 100
+ * cycles instead of 4, so a damping loop like {@code velocity *= 0.99f} that decays towards zero
+ * can become many times slower once the values get small enough.
+ *
+ * FTZ writes 0 instead of a denormal result and DAZ reads denormal inputs as 0. Both are bits of
+ * the MXCSR register, which is per thread: setting them on one thread does not change any other
+ * thread, and new threads start with them cleared.
+ *
+ * @code
+ * {
+ *     BB::ScopedFlushDenormals flush;
+ *     for (Vec3f& velocity : velocities)
+ *     {
+ *         velocity *= damping;
+ *     }
+ * } // the previous mode is restored here
+ * @endcode
+ *
+ * @warning Results change: anything below FLT_MIN becomes 0. Code that relies on gradual underflow
+ * (e.g. dividing by a tiny difference) has to keep the default mode.
+ */
+
+namespace BitBloom
+{
+/// @brief MXCSR bits for flush-to-zero (bit 15) and denormals-are-zero (bit 6).
+	constexpr unsigned int MXCSR_FLUSH_DENORMALS = 0x8040;
+
+/// @brief Sets or clears FTZ and DAZ on the calling thread, the other MXCSR bits are kept.
+	inline void SetFlushDenormals(bool aEnable)
+	{
+		const unsigned int csr = _mm_getcsr();
+		_mm_setcsr(aEnable ? (csr | MXCSR_FLUSH_DENORMALS) : (csr & ~MXCSR_FLUSH_DENORMALS));
+	}
+
+/// @brief Returns true when both FTZ and DAZ are set on the calling thread.
+	inline bool AreDenormalsFlushed()
+	{
+		return (_mm_getcsr() & MXCSR_FLUSH_DENORMALS) == MXCSR_FLUSH_DENORMALS;
+	}
+
+/**
+* @brief RAII guard that sets FTZ and DAZ on the calling thread and restores the previous MXCSR.
+*
+* @details Only the two bits are restored, so a rounding mode or exception mask changed inside the
+* scope is kept. Guards nest, the inner one restores what the outer one set.
+*/
+	class ScopedFlushDenormals
+	{
+	public:
+/// @brief Sets FTZ and DAZ, or clears them when aEnable is false (e.g. for a block that needs gradual underflow).
+		explicit ScopedFlushDenormals(bool aEnable = true) : myPreviousBits(_mm_getcsr() & MXCSR_FLUSH_DENORMALS)
+		{
+			SetFlushDenormals(aEnable);
+		}
+
+		~ScopedFlushDenormals()
+		{
+			_mm_setcsr((_mm_getcsr() & ~MXCSR_FLUSH_DENORMALS) | myPreviousBits);
+		}
+
+		ScopedFlushDenormals(const ScopedFlushDenormals&) = delete;
+		ScopedFlushDenormals& operator=(const ScopedFlushDenormals&) = delete;
+
+	private:
+		unsigned int myPreviousBits;
+	};
+
+/**
+* @brief Wraps aFunction so it runs with FTZ and DAZ set, for thread entry points and worker jobs.
+*
+* @details MXCSR does not carry over to new threads, so the mode has to be set on each worker.
+* The returned callable installs a ScopedFlushDenormals, forwards its arguments and restores the
+* mode when aFunction returns.
+*
+* @code
+* std::thread worker(BB::WithFlushedDenormals([&] { Simulate(bodies); }));
+* @endcode
+*/
+	template<class Function>
+	auto WithFlushedDenormals(Function&& aFunction)
+	{
+		return [function = std::forward<Function>(aFunction)](auto&&... aArguments) mutable -> decltype(auto)
+		{
+			ScopedFlushDenormals flush;
+			return function(std::forward<decltype(aArguments)>(aArguments)...);
+		};
+	}
+} // namespace BitBloom
+
+namespace BB = BitBloom;
@@ -0,0 +1,321 @@
+#pragma once
+#include <immintrin.h>
+#include "Intrinsics.h"
+
+/**
+ * @file Double4.h
+ * @brief Four-double register used by Vec3d, Vec4d and Mat4x4d.
+ *
+ * @details With AVX (/arch:AVX or /arch:AVX2 on MSVC, -mavx on GCC/Clang) Double4 is a single
+ * __m256d. Without it Double4 is a pair of __m128d (xy and zw) and every function does the same
+ * work in two SSE2 halves, so the double types behave identically on both paths. Define
+ * `BB_NO_AVX` to force the SSE2 path.
+ *
+ * Only the few operations the double types need are wrapped, anything cross-lane is left to
+ * scalar code since AVX (without AVX2) cannot permute across the two 128-bit halves cheaply.
+ */
+
+#if !defined(BB_NO_AVX) && defined(__AVX__)
+#define BB_USE_AVX
+#endif
+
+namespace BitBloom
+{
+namespace Simd
+{
+#ifdef BB_USE_AVX
+	using Double4 = __m256d;
+#else
+/**
+* @brief Two SSE2 registers standing in for a __m256d, low holds lanes 0 and 1, high lanes 2 and 3.
+*
+* @details Only 16-byte aligned so it can be passed by value, the double types add alignas(32)
+* themselves so their layout is the same on both paths.
+*/
+	struct Double4
+	{
+		__m128d low;
+		__m128d high;
+	};
+#endif
+
+/// @brief Sets the four lanes, aX ends up in lane 0.
+	inline Double4 SetDouble4(double aX, double aY, double aZ, double aW)
+	{
+#ifdef BB_USE_AVX
+		return _mm256_set_pd(aW, aZ, aY, aX);
+#else
+		return { _mm_set_pd(aY, aX), _mm_set_pd(aW, aZ) };
+#endif
+	}
+
+	inline Double4 SplatDouble4(double aValue)
+	{
+#ifdef BB_USE_AVX
+		return _mm256_set1_pd(aValue);
+#else
+		return { _mm_set1_pd(aValue), _mm_set1_pd(aValue) };
+#endif
+	}
+
+	inline Double4 Add(Double4 aOne, Double4 aTwo)
+	{
+#ifdef BB_USE_AVX
+		return _mm256_add_pd(aOne, aTwo);
+#else
+		return { _mm_add_pd(aOne.low, aTwo.low), _mm_add_pd(aOne.high, aTwo.high) };
+#endif
+	}
+
+	inline Double4 Sub(Double4 aOne, Double4 aTwo)
+	{
+#ifdef BB_USE_AVX
+		return _mm256_sub_pd(aOne, aTwo);
+#else
+		return { _mm_sub_pd(aOne.low, aTwo.low), _mm_sub_pd(aOne.high, aTwo.high) };
+#endif
+	}
+
+	inline Double4 Mul(Double4 aOne, Double4 aTwo)
+	{
+#ifdef BB_USE_AVX
+		return _mm256_mul_pd(aOne, aTwo);
+#else
+		return { _mm_mul_pd(aOne.low, aTwo.low), _mm_mul_pd(aOne.high, aTwo.high) };
+#endif
+	}
+
+	inline Double4 Div(Double4 aOne, Double4 aTwo)
+	{
+#ifdef BB_USE_AVX
+		return _mm256_div_pd(aOne, aTwo);
+#else
+		return { _mm_div_pd(aOne.low, aTwo.low), _mm_div_pd(aOne.high, aTwo.high) };
+#endif
+	}
+
+	inline Double4 Sqrt(Double4 aValue)
+	{
+#ifdef BB_USE_AVX
+		return _mm256_sqrt_pd(aValue);
+#else
+		return { _mm_sqrt_pd(aValue.low), _mm_sqrt_pd(aValue.high) };
+#endif
+	}
+
+/// @brief Flips the sign of all four lanes.
+	inline Double4 Negate(Double4 aValue)
+	{
+#ifdef BB_USE_AVX
+		return _mm256_xor_pd(aValue, _mm256_set1_pd(-0.0));
+#else
+		return { _mm_xor_pd(aValue.low, _mm_set1_pd(-0.0)), _mm_xor_pd(aValue.high, _mm_set1_pd(-0.0)) };
+#endif
+	}
+
+/// @brief Sets lane 3 to zero, used to keep the unused w of Vec3d at zero.
+	inline Double4 ClearW(Double4 aValue)
+	{
+#ifdef BB_USE_AVX
+		return _mm256_blend_pd(aValue, _mm256_setzero_pd(), 0x8);
+#else
+		return { aValue.low, _mm_move_sd(_mm_setzero_pd(), aValue.high) };
+#endif
+	}
+
+/// @brief Returns true if all four lanes compare equal.
+	inline bool AllEqual(Double4 aOne, Double4 aTwo)
+	{
+#ifdef BB_USE_AVX
+		return _mm256_movemask_pd(_mm256_cmp_pd(aOne, aTwo, _CMP_EQ_OQ)) == 0xF;
+#else
+		const int low = _mm_movemask_pd(_mm_cmpeq_pd(aOne.low, aTwo.low));
+		const int high = _mm_movemask_pd(_mm_cmpeq_pd(aOne.high, aTwo.high));
+		return (low & high) == 0x3;
+#endif
+	}
+
+/// @brief Computes (aFactorOne * aFactorTwo) + aAddend, fused when BB_USE_FMA is defined.
+	inline Double4 MulAdd(Double4 aFactorOne, Double4 aFactorTwo, Double4 aAddend)
+	{
+#if defined(BB_USE_AVX) && defined(BB_USE_FMA)
+		return _mm256_fmadd_pd(aFactorOne, aFactorTwo, aAddend);
+#elif defined(BB_USE_FMA)
+		return { _mm_fmadd_pd(aFactorOne.low, aFactorTwo.low, aAddend.low), _mm_fmadd_pd(aFactorOne.high, aFactorTwo.high, aAddend.high) };
+#else
+		return Add(Mul(aFactorOne, aFactorTwo), aAddend);
+#endif
+	}
+
+/// @brief Computes (aFactorOne * aFactorTwo) - aSubtrahend, fused when BB_USE_FMA is defined.
+	inline Double4 MulSub(Double4 aFactorOne, Double4 aFactorTwo, Double4 aSubtrahend)
+	{
+#if defined(BB_USE_AVX) && defined(BB_USE_FMA)
+		return _mm256_fmsub_pd(aFactorOne, aFactorTwo, aSubtrahend);
+#elif defined(BB_USE_FMA)
+		return { _mm_fmsub_pd(aFactorOne.low, aFactorTwo.low, aSubtrahend.low), _mm_fmsub_pd(aFactorOne.high, aFactorTwo.high, aSubtrahend.high) };
+#else
+		return Sub(Mul(aFactorOne, aFactorTwo), aSubtrahend);
+#endif
+	}
+
+/// @brief Computes aAddend - (aFactorOne * aFactorTwo), fused when BB_USE_FMA is defined.
+	inline Double4 NegMulAdd(Double4 aFactorOne, Double4 aFactorTwo, Double4 aAddend)
+	{
+#if defined(BB_USE_AVX) && defined(BB_USE_FMA)
+		return _mm256_fnmadd_pd(aFactorOne, aFactorTwo, aAddend);
+#elif defined(BB_USE_FMA)
+		return { _mm_fnmadd_pd(aFactorOne.low, aFactorTwo.low, aAddend.low), _mm_fnmadd_pd(aFactorOne.high, aFactorTwo.high, aAddend.high) };
+#else
+		return Sub(aAddend, Mul(aFactorOne, aFactorTwo));
+#endif
+	}
+
+/// @brief Linear interpolation aFrom + (aTo - aFrom) * aT for all four lanes.
+	inline Double4 Lerp(Double4 aFrom, Double4 aTo, Double4 aT)
+	{
+		return MulAdd(Sub(aTo, aFrom), aT, aFrom);
+	}
+
+/// @brief Sum of the products of lanes 0 to 2, lane 3 is ignored.
+	inline double Dot3(Double4 aOne, Double4 aTwo)
+	{
+		const Double4 product = Mul(aOne, aTwo);
+#ifdef BB_USE_AVX
+		const __m128d xy = _mm256_castpd256_pd128(product);
+		const __m128d zw = _mm256_extractf128_pd(product, 1);
+#else
+		const __m128d xy = product.low;
+		const __m128d zw = product.high;
+#endif
+		return _mm_cvtsd_f64(_mm_add_sd(_mm_add_sd(xy, _mm_unpackhi_pd(xy, xy)), zw));
+	}
+
+/// @brief Sum of the products of all four lanes.
+	inline double Dot4(Double4 aOne, Double4 aTwo)
+	{
+		const Double4 product = Mul(aOne, aTwo);
+#ifdef BB_USE_AVX
+		const __m128d sum = _mm_add_pd(_mm256_castpd256_pd128(product), _mm256_extractf128_pd(product, 1));
+#else
+		const __m128d sum = _mm_add_pd(product.low, product.high);
+#endif
+		return _mm_cvtsd_f64(_mm_add_sd(sum, _mm_unpackhi_pd(sum, sum)));
+	}
+
+/// @brief Rounds the four lanes to float.
+	inline __m128 ToFloat4(Double4 aValue)
+	{
+#ifdef BB_USE_AVX
+		return _mm256_cvtpd_ps(aValue);
+#else
+		return _mm_movelh_ps(_mm_cvtpd_ps(aValue.low), _mm_cvtpd_ps(aValue.high));
+#endif
+	}
+
+/// @brief Widens four floats to double, exact.
+	inline Double4 ToDouble4(__m128 aValue)
+	{
+#ifdef BB_USE_AVX
+		return _mm256_cvtps_pd(aValue);
+#else
+		return { _mm_cvtps_pd(aValue), _mm_cvtps_pd(_mm_movehl_ps(aValue, aValue)) };
+#endif
+	}
+
+	inline Double4 LoadDouble4(const double* aSource)
+	{
+#ifdef BB_USE_AVX
+		return _mm256_loadu_pd(aSource);
+#else
+		return { _mm_loadu_pd(aSource), _mm_loadu_pd(aSource + 2) };
+#endif
+	}
+
+/// @brief Loads from a 32-byte aligned pointer.
+	inline Double4 LoadAlignedDouble4(const double* aSource)
+	{
+#ifdef BB_USE_AVX
+		return _mm256_load_pd(aSource);
+#else
+		return { _mm_load_pd(aSource), _mm_load_pd(aSource + 2) };
+#endif
+	}
+
+/// @brief Loads three doubles, lane 3 is zero and nothing past aSource[2] is read.
+	inline Double4 LoadDouble3(const double* aSource)
+	{
+#ifdef BB_USE_AVX
+		return _mm256_maskload_pd(aSource, _mm256_set_epi64x(0, -1, -1, -1));
+#else
+		return { _mm_loadu_pd(aSource), _mm_load_sd(aSource + 2) };
+#endif
+	}
+
+	inline void StoreDouble4(double* aDestination, Double4 aValue)
+	{
+#ifdef BB_USE_AVX
+		_mm256_storeu_pd(aDestination, aValue);
+#else
+		_mm_storeu_pd(aDestination, aValue.low);
+		_mm_storeu_pd(aDestination + 2, aValue.high);
+#endif
+	}
+
+/// @brief Stores to a 32-byte aligned pointer.
+	inline void StoreAlignedDouble4(double* aDestination, Double4 aValue)
+	{
+#ifdef BB_USE_AVX
+		_mm256_store_pd(aDestination, aValue);
+#else
+		_mm_store_pd(aDestination, aValue.low);
+		_mm_store_pd(aDestination + 2, aValue.high);
+#endif
+	}
+
+/// @brief Stores to a 32-byte aligned pointer with non-temporal stores, see StreamFence.
+	inline void StoreStreamDouble4(double* aDestination, Double4 aValue)
+	{
+#ifdef BB_USE_AVX
+		_mm256_stream_pd(aDestination, aValue);
+#else
+		_mm_stream_pd(aDestination, aValue.low);
+		_mm_stream_pd(aDestination + 2, aValue.high);
+#endif
+	}
+
+/// @brief Stores lanes 0 to 2, nothing past aDestination[2] is written.
+	inline void StoreDouble3(double* aDestination, Double4 aValue)
+	{
+#ifdef BB_USE_AVX
+		_mm256_maskstore_pd(aDestination, _mm256_set_epi64x(0, -1, -1, -1), aValue);
+#else
+		_mm_storeu_pd(aDestination, aValue.low);
+		_mm_store_sd(aDestination + 2, aValue.high);
+#endif
+	}
+
+/// @brief Transposes four rows in place, like _MM_TRANSPOSE4_PS.
+	inline void Transpose(Double4& aRowZero, Double4& aRowOne, Double4& aRowTwo, Double4& aRowThree)
+	{
+#ifdef BB_USE_AVX
+		const __m256d even01 = _mm256_unpacklo_pd(aRowZero, aRowOne);		// r00 r10 r02 r12
+		const __m256d odd01 = _mm256_unpackhi_pd(aRowZero, aRowOne);		// r01 r11 r03 r13
+		const __m256d even23 = _mm256_unpacklo_pd(aRowTwo, aRowThree);		// r20 r30 r22 r32
+		const __m256d odd23 = _mm256_unpackhi_pd(aRowTwo, aRowThree);		// r21 r31 r23 r33
+		aRowZero = _mm256_permute2f128_pd(even01, even23, 0x20);
+		aRowOne = _mm256_permute2f128_pd(odd01, odd23, 0x20);
+		aRowTwo = _mm256_permute2f128_pd(even01, even23, 0x31);
+		aRowThree = _mm256_permute2f128_pd(odd01, odd23, 0x31);
+#else
+		const Double4 rowZero = aRowZero, rowOne = aRowOne, rowTwo = aRowTwo, rowThree = aRowThree;
+		aRowZero = { _mm_unpacklo_pd(rowZero.low, rowOne.low), _mm_unpacklo_pd(rowTwo.low, rowThree.low) };
+		aRowOne = { _mm_unpackhi_pd(rowZero.low, rowOne.low), _mm_unpackhi_pd(rowTwo.low, rowThree.low) };
+		aRowTwo = { _mm_unpacklo_pd(rowZero.high, rowOne.high), _mm_unpacklo_pd(rowTwo.high, rowThree.high) };
+		aRowThree = { _mm_unpackhi_pd(rowZero.high, rowOne.high), _mm_unpackhi_pd(rowTwo.high, rowThree.high) };
+#endif
+	}
+} // namespace Simd
+} // namespace BitBloom
+
+namespace BB = BitBloom;
@@ -0,0 +1,270 @@
+#pragma once
+#include <immintrin.h>
+#include "Intrinsics.h"
+
+/**
+ * @file Float8.h
+ * @brief Eight-float register for the structure-of-arrays kernels (particles and other streams).
+ *
+ * @details With AVX Float8 is a single __m256, without it a pair of __m128 (lanes 0-3 and 4-7)
+ * and every function does the same work in two SSE halves, like Double4. `BB_NO_AVX` forces the
+ * SSE path here as well.
+ *
+ * Loads and stores are aligned, the pointers have to be 32-byte aligned
+ * (BB::AlignedVector<float, BB::AVX_ALIGNMENT> or stricter). LoadUnalignedFloat8 is the
+ * exception, for sliding windows over an array.
+ */
+
+#if !defined(BB_NO_AVX) && defined(__AVX__)
+#define BB_USE_AVX
+#endif
+
+namespace BitBloom
+{
+namespace Simd
+{
+#ifdef BB_USE_AVX
+	using Float8 = __m256;
+#else
+/// @brief Two SSE registers standing in for a __m256, low holds lanes 0 to 3, high lanes 4 to 7.
+	struct Float8
+	{
+		__m128 low;
+		__m128 high;
+	};
+#endif
+
+	inline Float8 SplatFloat8(float aValue)
+	{
+#ifdef BB_USE_AVX
+		return _mm256_set1_ps(aValue);
+#else
+		return { _mm_set1_ps(aValue), _mm_set1_ps(aValue) };
+#endif
+	}
+
+/// @brief Loads eight floats from a 32-byte aligned pointer.
+	inline Float8 LoadFloat8(const float* aSource)
+	{
+#ifdef BB_USE_AVX
+		return _mm256_load_ps(aSource);
+#else
+		return { _mm_load_ps(aSource), _mm_load_ps(aSource + 4) };
+#endif
+	}
+
+	inline Float8 LoadUnalignedFloat8(const float* aSource)
+	{
+#ifdef BB_USE_AVX
+		return _mm256_loadu_ps(aSource);
+#else
+		return { _mm_loadu_ps(aSource), _mm_loadu_ps(aSource + 4) };
+#endif
+	}
+
+/// @brief Stores eight floats to a 32-byte aligned pointer.
+	inline void StoreFloat8(float* aDestination, Float8 aValue)
+	{
+#ifdef BB_USE_AVX
+		_mm256_store_ps(aDestination, aValue);
+#else
+		_mm_store_ps(aDestination, aValue.low);
+		_mm_store_ps(aDestination + 4, aValue.high);
+#endif
+	}
+
+	inline Float8 Add(Float8 aOne, Float8 aTwo)
+	{
+#ifdef BB_USE_AVX
+		return _mm256_add_ps(aOne, aTwo);
+#else
+		return { _mm_add_ps(aOne.low, aTwo.low), _mm_add_ps(aOne.high, aTwo.high) };
+#endif
+	}
+
+	inline Float8 Sub(Float8 aOne, Float8 aTwo)
+	{
+#ifdef BB_USE_AVX
+		return _mm256_sub_ps(aOne, aTwo);
+#else
+		return { _mm_sub_ps(aOne.low, aTwo.low), _mm_sub_ps(aOne.high, aTwo.high) };
+#endif
+	}
+
+	inline Float8 Mul(Float8 aOne, Float8 aTwo)
+	{
+#ifdef BB_USE_AVX
+		return _mm256_mul_ps(aOne, aTwo);
+#else
+		return { _mm_mul_ps(aOne.low, aTwo.low), _mm_mul_ps(aOne.high, aTwo.high) };
+#endif
+	}
+
+	inline Float8 Div(Float8 aOne, Float8 aTwo)
+	{
+#ifdef BB_USE_AVX
+		return _mm256_div_ps(aOne, aTwo);
+#else
+		return { _mm_div_ps(aOne.low, aTwo.low), _mm_div_ps(aOne.high, aTwo.high) };
+#endif
+	}
+
+	inline Float8 Sqrt(Float8 aValue)
+	{
+#ifdef BB_USE_AVX
+		return _mm256_sqrt_ps(aValue);
+#else
+		return { _mm_sqrt_ps(aValue.low), _mm_sqrt_ps(aValue.high) };
+#endif
+	}
+
+	inline Float8 Max(Float8 aOne, Float8 aTwo)
+	{
+#ifdef BB_USE_AVX
+		return _mm256_max_ps(aOne, aTwo);
+#else
+		return { _mm_max_ps(aOne.low, aTwo.low), _mm_max_ps(aOne.high, aTwo.high) };
+#endif
+	}
+
+	inline Float8 Min(Float8 aOne, Float8 aTwo)
+	{
+#ifdef BB_USE_AVX
+		return _mm256_min_ps(aOne, aTwo);
+#else
+		return { _mm_min_ps(aOne.low, aTwo.low), _mm_min_ps(aOne.high, aTwo.high) };
+#endif
+	}
+
+/// @brief Clears the sign bits.
+	inline Float8 Abs(Float8 aValue)
+	{
+#ifdef BB_USE_AVX
+		return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), aValue);
+#else
+		const __m128 signBits = _mm_set1_ps(-0.0f);
+		return { _mm_andnot_ps(signBits, aValue.low), _mm_andnot_ps(signBits, aValue.high) };
+#endif
+	}
+
+	inline Float8 Floor(Float8 aValue)
+	{
+#ifdef BB_USE_AVX
+		return _mm256_floor_ps(aValue);
+#else
+		return { _mm_floor_ps(aValue.low), _mm_floor_ps(aValue.high) };
+#endif
+	}
+
+/// @brief Bitwise and, used to clear lanes with a compare mask.
+	inline Float8 And(Float8 aOne, Float8 aTwo)
+	{
+#ifdef BB_USE_AVX
+		return _mm256_and_ps(aOne, aTwo);
+#else
+		return { _mm_and_ps(aOne.low, aTwo.low), _mm_and_ps(aOne.high, aTwo.high) };
+#endif
+	}
+
+	inline Float8 Or(Float8 aOne, Float8 aTwo)
+	{
+#ifdef BB_USE_AVX
+		return _mm256_or_ps(aOne, aTwo);
+#else
+		return { _mm_or_ps(aOne.low, aTwo.low), _mm_or_ps(aOne.high, aTwo.high) };
+#endif
+	}
+
+/// @brief Bitwise xor, with And(x, SplatFloat8(-0.0f)) as aTwo it copies the sign of x.
+	inline Float8 Xor(Float8 aOne, Float8 aTwo)
+	{
+#ifdef BB_USE_AVX
+		return _mm256_xor_ps(aOne, aTwo);
+#else
+		return { _mm_xor_ps(aOne.low, aTwo.low), _mm_xor_ps(aOne.high, aTwo.high) };
+#endif
+	}
+
+/// @brief aIfTrue in the lanes where the sign bit of aMask is set (compare masks), aIfFalse elsewhere.
+	inline Float8 Select(Float8 aMask, Float8 aIfTrue, Float8 aIfFalse)
+	{
+#ifdef BB_USE_AVX
+		return _mm256_blendv_ps(aIfFalse, aIfTrue, aMask);
+#else
+		return { _mm_blendv_ps(aIfFalse.low, aIfTrue.low, aMask.low), _mm_blendv_ps(aIfFalse.high, aIfTrue.high, aMask.high) };
+#endif
+	}
+
+/// @brief Computes (aFactorOne * aFactorTwo) + aAddend, fused when BB_USE_FMA is defined.
+	inline Float8 MulAdd(Float8 aFactorOne, Float8 aFactorTwo, Float8 aAddend)
+	{
+#if defined(BB_USE_AVX) && defined(BB_USE_FMA)
+		return _mm256_fmadd_ps(aFactorOne, aFactorTwo, aAddend);
+#elif defined(BB_USE_FMA)
+		return { _mm_fmadd_ps(aFactorOne.low, aFactorTwo.low, aAddend.low), _mm_fmadd_ps(aFactorOne.high, aFactorTwo.high, aAddend.high) };
+#else
+		return Add(Mul(aFactorOne, aFactorTwo), aAddend);
+#endif
+	}
+
+/// @brief All bits set in the lanes where aOne > aTwo, false for NaN.
+	inline Float8 GreaterMask(Float8 aOne, Float8 aTwo)
+	{
+#ifdef BB_USE_AVX
+		return _mm256_cmp_ps(aOne, aTwo, _CMP_GT_OQ);
+#else
+		return { _mm_cmpgt_ps(aOne.low, aTwo.low), _mm_cmpgt_ps(aOne.high, aTwo.high) };
+#endif
+	}
+
+/// @brief All bits set in the lanes where aOne >= aTwo, false for NaN.
+	inline Float8 GreaterEqualMask(Float8 aOne, Float8 aTwo)
+	{
+#ifdef BB_USE_AVX
+		return _mm256_cmp_ps(aOne, aTwo, _CMP_GE_OQ);
+#else
+		return { _mm_cmpge_ps(aOne.low, aTwo.low), _mm_cmpge_ps(aOne.high, aTwo.high) };
+#endif
+	}
+
+/// @brief The sign bits of the eight lanes, bit 0 for lane 0.
+	inline int MoveMask(Float8 aValue)
+	{
+#ifdef BB_USE_AVX
+		return _mm256_movemask_ps(aValue);
+#else
+		return _mm_movemask_ps(aValue.low) | (_mm_movemask_ps(aValue.high) << 4);
+#endif
+	}
+
+/// @brief Builds a Float8 from lanes 0 to 3 (aLow) and 4 to 7 (aHigh).
+	inline Float8 CombineFloat8(__m128 aLow, __m128 aHigh)
+	{
+#ifdef BB_USE_AVX
+		return _mm256_insertf128_ps(_mm256_castps128_ps256(aLow), aHigh, 1);
+#else
+		return { aLow, aHigh };
+#endif
+	}
+
+	inline __m128 GetLowHalf(Float8 aValue)
+	{
+#ifdef BB_USE_AVX
+		return _mm256_castps256_ps128(aValue);
+#else
+		return aValue.low;
+#endif
+	}
+
+	inline __m128 GetHighHalf(Float8 aValue)
+	{
+#ifdef BB_USE_AVX
+		return _mm256_extractf128_ps(aValue, 1);
+#else
+		return aValue.high;
+#endif
+	}
+} // namespace Simd
+} // namespace BitBloom
+
+namespace BB = BitBloom;
@@ -0,0 +1,209 @@
+#pragma once
+#include <immintrin.h>
+#include <bit>
+#include <cmath>
+#include <type_traits>
+
+/**
+ * @file Intrinsics.h
+ * @brief Thin wrappers over SSE/FMA instructions shared by the vector and matrix types.
+ *
+ * @details FMA3 is used when the compiler targets it (/arch:AVX2 on MSVC, -mfma on GCC/Clang).
+ * Define `BB_NO_FMA` to force the separate multiply and add path, e.g. to get results that are
+ * bit-identical to a non-FMA build.
+ *
+ * The fast approximate functions (Reciprocal, ReciprocalSqrt and the *Fast vector functions) start
+ * from the 12-bit rcpps/rsqrtps estimates and take a number of Newton-Raphson steps given as a
+ * template argument. `BB_FAST_MATH_REFINEMENTS` sets the default (1), define it before including
+ * the library to change the precision of every call that does not pass its own count.
+ *
+ * | Steps | Max relative error | Cost compared to the full precision divide / sqrt |
+ * |-------|--------------------|----------------------------------------------------|
+ * | 0     | 3.7e-4             | one instruction, about a quarter of the latency     |
+ * | 1     | 3.0e-7             | 3 to 4 more multiply / FMA instructions             |
+ * | 2     | 1.8e-7             | 3 to 4 more again, rarely better than the divide    |
+ *
+ * Step 0 is the hardware bound of 1.5 * 2^-12. The other rows are the largest error of Reciprocal
+ * and ReciprocalSqrt over the positive normal floats, with and without FMA, below 2^126 for
+ * Reciprocal: from 2^126 up the rcpps estimate falls below the smallest normal float and is
+ * flushed to zero, which no step brings back, so Reciprocal and DivideFast return 0 there. The
+ * vector functions add the rounding of their dot product on top.
+ */
+
+#if !defined(BB_NO_FMA) && (defined(__FMA__) || defined(__AVX2__))
+#define BB_USE_FMA
+#endif
+
+#ifndef BB_FAST_MATH_REFINEMENTS
+#define BB_FAST_MATH_REFINEMENTS 1
+#endif
+
+namespace BitBloom
+{
+/**
+* @brief Plain scalar view of a SIMD register, shared through the union of the vector and matrix types.
+*
+* @details Intrinsics cannot run during constant evaluation, so constexpr code paths
+* (selected with std::is_constant_evaluated()) read and write this member instead of the register.
+* It is assigned as a whole so it becomes the active union member at compile time.
+* T is double for the double precision types.
+*/
+	template<int aCount, class T = float>
+	struct ScalarLanes
+	{
+		T value[aCount];
+	};
+
+namespace Simd
+{
+/**
+* @brief Computes (aFactorOne * aFactorTwo) + aAddend for all four lanes.
+*
+* @details Uses a single fused multiply-add when BB_USE_FMA is defined, the result is then
+* rounded once instead of twice.
+*/
+	inline __m128 MulAdd(__m128 aFactorOne, __m128 aFactorTwo, __m128 aAddend)
+	{
+#ifdef BB_USE_FMA
+		return _mm_fmadd_ps(aFactorOne, aFactorTwo, aAddend);
+#else
+		return _mm_add_ps(_mm_mul_ps(aFactorOne, aFactorTwo), aAddend);
+#endif
+	}
+
+/// @brief Scalar version of MulAdd, used by the scalar vector types.
+	inline float MulAdd(float aFactorOne, float aFactorTwo, float aAddend)
+	{
+#ifdef BB_USE_FMA
+		return std::fma(aFactorOne, aFactorTwo, aAddend);
+#else
+		return (aFactorOne * aFactorTwo) + aAddend;
+#endif
+	}
+
+/// @brief Computes (aFactorOne * aFactorTwo) - aSubtrahend for all four lanes.
+	inline __m128 MulSub(__m128 aFactorOne, __m128 aFactorTwo, __m128 aSubtrahend)
+	{
+#ifdef BB_USE_FMA
+		return _mm_fmsub_ps(aFactorOne, aFactorTwo, aSubtrahend);
+#else
+		return _mm_sub_ps(_mm_mul_ps(aFactorOne, aFactorTwo), aSubtrahend);
+#endif
+	}
+
+/// @brief Computes aAddend - (aFactorOne * aFactorTwo) for all four lanes.
+	inline __m128 NegMulAdd(__m128 aFactorOne, __m128 aFactorTwo, __m128 aAddend)
+	{
+#ifdef BB_USE_FMA
+		return _mm_fnmadd_ps(aFactorOne, aFactorTwo, aAddend);
+#else
+		return _mm_sub_ps(aAddend, _mm_mul_ps(aFactorOne, aFactorTwo));
+#endif
+	}
+
+/**
+* @brief Linear interpolation aFrom + (aTo - aFrom) * aT for all four lanes.
+*
+* @details Returns exactly aFrom for aT = 0, the result for aT = 1 can differ from aTo by rounding.
+*/
+	inline __m128 Lerp(__m128 aFrom, __m128 aTo, __m128 aT)
+	{
+		return MulAdd(_mm_sub_ps(aTo, aFrom), aT, aFrom);
+	}
+
+/**
+* @brief Approximates 1 / aValue for all four lanes.
+*
+* @details rcpps followed by aRefinements Newton-Raphson steps, see the table at the top of this
+* file for the error. Zero gives infinity with sign, infinity gives zero only for aRefinements = 0.
+* Lanes with |aValue| >= 2^126 give zero, the estimate is flushed before any step.
+*/
+	template<int aRefinements = BB_FAST_MATH_REFINEMENTS>
+	inline __m128 Reciprocal(__m128 aValue)
+	{
+		static_assert(aRefinements >= 0 && aRefinements <= 2, "Reciprocal supports 0, 1 or 2 refinements");
+		__m128 estimate = _mm_rcp_ps(aValue);
+		for (int i = 0; i < aRefinements; ++i)
+		{
+			// e = 1 - x * y, y' = y + y * e
+			const __m128 error = NegMulAdd(aValue, estimate, _mm_set1_ps(1.0f));
+			estimate = MulAdd(estimate, error, estimate);
+		}
+		return estimate;
+	}
+
+/**
+* @brief Approximates 1 / sqrt(aValue) for all four lanes.
+*
+* @details rsqrtps followed by aRefinements Newton-Raphson steps, see the table at the top of this
+* file for the error. Zero gives infinity for aRefinements = 0 and NaN otherwise.
+*/
+	template<int aRefinements = BB_FAST_MATH_REFINEMENTS>
+	inline __m128 ReciprocalSqrt(__m128 aValue)
+	{
+		static_assert(aRefinements >= 0 && aRefinements <= 2, "ReciprocalSqrt supports 0, 1 or 2 refinements");
+		__m128 estimate = _mm_rsqrt_ps(aValue);
+		for (int i = 0; i < aRefinements; ++i)
+		{
+			// y' = y * (1.5 - 0.5 * x * y * y)
+			const __m128 halfValueEstimate = _mm_mul_ps(_mm_mul_ps(aValue, _mm_set1_ps(0.5f)), estimate);
+			estimate = _mm_mul_ps(estimate, NegMulAdd(halfValueEstimate, estimate, _mm_set1_ps(1.5f)));
+		}
+		return estimate;
+	}
+
+/// @brief All bits set in lanes that are neither infinite nor NaN, compares the exponent bits so no float exception is raised.
+	inline __m128 FiniteMask(__m128 aValue)
+	{
+		const __m128i magnitude = _mm_and_si128(_mm_castps_si128(aValue), _mm_set1_epi32(0x7fffffff));
+		return _mm_castsi128_ps(_mm_cmplt_epi32(magnitude, _mm_set1_epi32(0x7f800000)));
+	}
+
+/// @brief Clears the sign bit of all four lanes.
+	inline __m128 Abs(__m128 aValue)
+	{
+		return _mm_andnot_ps(_mm_set1_ps(-0.0f), aValue);
+	}
+
+/// @brief -1, 0 or +1 per lane, zero and NaN give 0.
+	inline __m128 Sign(__m128 aValue)
+	{
+		const __m128 positive = _mm_and_ps(_mm_cmpgt_ps(aValue, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+		const __m128 negative = _mm_and_ps(_mm_cmplt_ps(aValue, _mm_setzero_ps()), _mm_set1_ps(-1.0f));
+		return _mm_or_ps(positive, negative);
+	}
+
+/// @brief min(max(aValue, aMin), aMax) per lane, NaN lanes become aMin.
+	inline __m128 Clamp(__m128 aValue, __m128 aMin, __m128 aMax)
+	{
+		return _mm_min_ps(_mm_max_ps(aValue, aMin), aMax);
+	}
+
+/// @brief Takes aIfTrue where the sign bit of aMask is set and aIfFalse elsewhere, one blendv.
+	inline __m128 Select(__m128 aMask, __m128 aIfTrue, __m128 aIfFalse)
+	{
+		return _mm_blendv_ps(aIfFalse, aIfTrue, aMask);
+	}
+
+/// @brief Scalar version of a compare lane, all bits set when aCondition holds, used by the scalar vector types.
+	inline float MaskLane(bool aCondition)
+	{
+		return aCondition ? std::bit_cast<float>(0xFFFFFFFFu) : 0.0f;
+	}
+
+/// @brief Orders all earlier non-temporal (streaming) stores before any later store.
+	inline void StreamFence()
+	{
+		_mm_sfence();
+	}
+
+/// @brief Broadcasts lane aLane of aVector to all four lanes.
+	template<int aLane>
+	inline __m128 Splat(__m128 aVector)
+	{
+		return _mm_shuffle_ps(aVector, aVector, _MM_SHUFFLE(aLane, aLane, aLane, aLane));
+	}
+} // namespace Simd
+} // namespace BitBloom
+
+namespace BB = BitBloom;
@@ -0,0 +1,68 @@
+#pragma once
+#include <cassert>
+#include <cstdio>
+
+/**
+ * @file Validation.h
+ * @brief Debug checks for invalid input, compiled out entirely in release builds.
+ *
+ * @details The library does not check its input in release builds (see MathLibDoc.h). In debug
+ * builds, or when `BB_ENABLE_VALIDATION` is defined, BB_VALIDATE evaluates its condition and
+ * reports failures through the validation handler, e.g. when a zero vector is normalized or a
+ * vector is divided by zero. Define `BB_NO_VALIDATION` to turn the checks off in debug builds.
+ *
+ * When validation is off BB_VALIDATE expands to nothing, the condition is not evaluated.
+ *
+ * The default handler prints the message and asserts. Install your own with
+ * BB::SetValidationHandler to log, count or break into the debugger instead.
+ *
+ * @code
+ * BB::SetValidationHandler([](const char* aMessage, const char* aFile, int aLine)
+ * {
+ *     Log::Error("%s(%d): %s", aFile, aLine, aMessage);
+ * });
+ * @endcode
+ */
+
+#if !defined(BB_NO_VALIDATION) && (defined(BB_ENABLE_VALIDATION) || !defined(NDEBUG))
+#define BB_USE_VALIDATION
+#endif
+
+namespace BitBloom
+{
+/// @brief Called for every failed BB_VALIDATE with the message and where the check is.
+	using ValidationHandler = void(*)(const char* aMessage, const char* aFile, int aLine);
+
+/// @brief Prints the failure to stderr and asserts.
+	inline void DefaultValidationHandler(const char* aMessage, const char* aFile, int aLine)
+	{
+		std::fprintf(stderr, "%s(%d): BitBloom validation failed: %s\n", aFile, aLine, aMessage);
+		assert(false && "BitBloom validation failed, see stderr");
+	}
+
+namespace Detail
+{
+	inline ValidationHandler globalValidationHandler = &DefaultValidationHandler;
+} // namespace Detail
+
+/// @brief Replaces the validation handler and returns the previous one, nullptr restores the default.
+	inline ValidationHandler SetValidationHandler(ValidationHandler aHandler)
+	{
+		const ValidationHandler previous = Detail::globalValidationHandler;
+		Detail::globalValidationHandler = aHandler ? aHandler : &DefaultValidationHandler;
+		return previous;
+	}
+
+	inline void ReportValidationFailure(const char* aMessage, const char* aFile, int aLine)
+	{
+		Detail::globalValidationHandler(aMessage, aFile, aLine);
+	}
+} // namespace BitBloom
+
+namespace BB = BitBloom;
+
+#ifdef BB_USE_VALIDATION
+#define BB_VALIDATE(aCondition, aMessage) do { if (!(aCondition)) { BB::ReportValidationFailure(aMessage, __FILE__, __LINE__); } } while (false)
+#else
+#define BB_VALIDATE(aCondition, aMessage) ((void)0)
+#endif
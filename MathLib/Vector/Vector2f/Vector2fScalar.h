@@ -1,4 +1,5 @@
 #pragma once
+#include "../../Util/Intrinsics.h"
 /**
 * @brief Vec22fScalar is a scalar vector class aligned to 8 bytes.
 *
@@ -20,13 +21,13 @@ public:
 */
 
 /// @brief Default constructor. Initializes all components to zero.
-	Vector2fScalar() : x(0.0f), y(0.0f) {};
+	constexpr Vector2fScalar() : x(0.0f), y(0.0f) {};
 /// @brief Copy constructor. Use another Vector2fScalar to copy data.
-	Vector2fScalar(const Vector2fScalar& aVector) : x(aVector.x), y(aVector.y) {};
+	constexpr Vector2fScalar(const Vector2fScalar& aVector) : x(aVector.x), y(aVector.y) {};
 /// @brief Initializes all components (x, y) to the same float value.
-	Vector2fScalar(float aScalar) : x(aScalar), y(aScalar) {};
+	constexpr Vector2fScalar(float aScalar) : x(aScalar), y(aScalar) {};
 /// @brief Initializes Vector2fScalar with individual x, y values.
-	Vector2fScalar(float aX, float aY) : x(aX), y(aY) {}; 
+	constexpr Vector2fScalar(float aX, float aY) : x(aX), y(aY) {}; 
 /// @}
 // End Constructors Group
 
@@ -39,7 +40,7 @@ public:
 * 
 * @return The squared length as a float.
 */
-	inline float LengthSqr();
+	constexpr float LengthSqr() const;
 /**
  * @brief Computes the length (magnitude) of the vector.
  *
@@ -79,7 +80,7 @@ public:
  * @param aVector The other vector to compute the dot product with.
  * @return The dot product as a float.
  */
-	inline float Dot(const Vector2fScalar& aVector);
+	constexpr float Dot(const Vector2fScalar& aVector) const;
 /**
  * @brief Computes the distance from this vector to another.
  *
@@ -91,7 +92,7 @@ public:
  * @note If you want the scalar distance (i.e., the length of the vector between the two points),
  * consider using {@code (a - b).Length()} instead.
  */
-	inline Vector2fScalar DistanceTo(const Vector2fScalar& aVector);
+	constexpr Vector2fScalar DistanceTo(const Vector2fScalar& aVector) const;
 	/**
 * @brief Returns a copy of this vector rotated around a specified angle.
 *
@@ -110,6 +111,20 @@ public:
  */
 	inline void Rotate(float aAngle);
 
+/**
+* @name Load and store
+* @brief Same API as the SIMD types so templated code can use either.
+*
+* @details The scalar vector has no alignment requirement, the aligned and streaming
+* versions are plain float copies.
+* @{
+*/
+	static inline Vector2fScalar LoadUnaligned(const float* aSource);
+	static inline Vector2fScalar LoadAligned(const float* aSource);
+	inline void StoreUnaligned(float* aDestination) const;
+	inline void StoreAligned(float* aDestination) const;
+	inline void StoreStream(float* aDestination) const;
+/** @} */
 };
 
 /**
@@ -127,7 +142,7 @@ public:
 * @return A bool depending if the two vectors are equal.
 * @relatesalso Vector2fScalar
 */
-inline bool operator==(const Vector2fScalar& aDataOne, const Vector2fScalar& aDataTwo);
+constexpr bool operator==(const Vector2fScalar& aDataOne, const Vector2fScalar& aDataTwo);
 /**
 * @brief Not equal for vector2s.
 *
@@ -138,7 +153,7 @@ inline bool operator==(const Vector2fScalar& aDataOne, const Vector2fScalar& aDa
 * @return A bool depending if the two vectors are equal.
 * @relatesalso Vector2fScalar 
 */
-inline bool operator!=(const Vector2fScalar& aDataOne, const Vector2fScalar& aDataTwo);
+constexpr bool operator!=(const Vector2fScalar& aDataOne, const Vector2fScalar& aDataTwo);
 /**
 * @brief Negates the given 2D vector.
 *
@@ -146,7 +161,7 @@ inline bool operator!=(const Vector2fScalar& aDataOne, const Vector2fScalar& aDa
 * @return A new Vector2fScalar where each component is the negation of the corresponding component in {@code aDataOne}.
 * @relatesalso Vector2fScalar
 */
-inline Vector2fScalar operator-(const Vector2fScalar& aDataOne);  
+constexpr Vector2fScalar operator-(const Vector2fScalar& aDataOne);  
 
 /**
 * @brief Add for vector2s.
@@ -159,7 +174,7 @@ inline Vector2fScalar operator-(const Vector2fScalar& aDataOne);
 * @return A new Vector2fScalar representing the sum of aDataOne and aDataTwo.
 * @relatesalso Vector2fScalar
 */
-inline Vector2fScalar operator+(const Vector2fScalar& aDataOne, const Vector2fScalar& aDataTwo);
+constexpr Vector2fScalar operator+(const Vector2fScalar& aDataOne, const Vector2fScalar& aDataTwo);
 /**
 * @brief Subtract for vector2s.
 *
@@ -171,7 +186,7 @@ inline Vector2fScalar operator+(const Vector2fScalar& aDataOne, const Vector2fSc
 * @return A new Vector2fScalar representing the difference of aDataOne and aDataTwo.
 * @relatesalso Vector2fScalar
 */
-inline Vector2fScalar operator-(const Vector2fScalar& aDataOne, const Vector2fScalar& aDataTwo);
+constexpr Vector2fScalar operator-(const Vector2fScalar& aDataOne, const Vector2fScalar& aDataTwo);
 /**
 * @brief Multiplication for Vector2s.
 *
@@ -183,7 +198,7 @@ inline Vector2fScalar operator-(const Vector2fScalar& aDataOne, const Vector2fSc
 * @return A new Vector2fScalar representing the sum of aDataOne and aDataTwo.
 * @relatesalso Vector2fScalar
 */
-inline Vector2fScalar operator*(const Vector2fScalar& aDataOne, const Vector2fScalar& aDataTwo);
+constexpr Vector2fScalar operator*(const Vector2fScalar& aDataOne, const Vector2fScalar& aDataTwo);
 /**
 * @brief Multiplication for Vector2s.
 *
@@ -195,7 +210,7 @@ inline Vector2fScalar operator*(const Vector2fScalar& aDataOne, const Vector2fSc
 * @return A new Vector2fScalar representing the sum of aDataOne by aScalar;
 * @relatesalso Vector2fScalar
 */
-inline Vector2fScalar operator*(const Vector2fScalar& aDataOne, const float& aScalar);
+constexpr Vector2fScalar operator*(const Vector2fScalar& aDataOne, const float& aScalar);
 /**
 * @brief Multiplication for Vector2s.
 *
@@ -207,7 +222,7 @@ inline Vector2fScalar operator*(const Vector2fScalar& aDataOne, const float& aSc
 * @return A new Vector2fScalar representing the sum of aDataOne by aScalar;
 * @relatesalso Vector2fScalar
 */
-inline Vector2fScalar operator*(const float& aScalar, const Vector2fScalar& aDataOne); 
+constexpr Vector2fScalar operator*(const float& aScalar, const Vector2fScalar& aDataOne); 
 /**
  * @brief Division for Vector2s.
  *
@@ -222,7 +237,7 @@ inline Vector2fScalar operator*(const float& aScalar, const Vector2fScalar& aDat
  * @note No division-by-zero checks are performed; ensure {@code aDataTwo} components are non-zero.
  * @relatesalso Vector2fScalar
  */
-inline Vector2fScalar operator/(const Vector2fScalar& aDataOne, const Vector2fScalar& aDataTwo);
+constexpr Vector2fScalar operator/(const Vector2fScalar& aDataOne, const Vector2fScalar& aDataTwo);
 /**
  * @brief Division for Vector2s.
  *
@@ -235,7 +250,7 @@ inline Vector2fScalar operator/(const Vector2fScalar& aDataOne, const Vector2fSc
  * @note No division-by-zero checks are performed; ensure {@code aScalar} is non-zero.
  * @relatesalso Vector2fScalar
  */
-inline Vector2fScalar operator/(const Vector2fScalar& aDataOne, const float& aScalar);
+constexpr Vector2fScalar operator/(const Vector2fScalar& aDataOne, const float& aScalar);
 
 /**
 * @brief Performs component-wise addition and assignment for Vector2s.
@@ -246,7 +261,7 @@ inline Vector2fScalar operator/(const Vector2fScalar& aDataOne, const float& aSc
 * @param aDataTwo The right-hand Vector2fScalar to add.
 * @relates Vector2fScalar
 */
-inline void operator+=(Vector2fScalar& aDataOne, const Vector2fScalar& aDataTwo);
+constexpr void operator+=(Vector2fScalar& aDataOne, const Vector2fScalar& aDataTwo);
 /**
 * @brief Performs component-wise subtraction and assignment for Vector2s.
 *
@@ -256,7 +271,7 @@ inline void operator+=(Vector2fScalar& aDataOne, const Vector2fScalar& aDataTwo)
 * @param aDataTwo The right-hand Vector2fScalar to subtract (subtrahend).
 * @relates Vector2fScalar
 */
-inline void operator-=(Vector2fScalar& aDataOne, const Vector2fScalar& aDataTwo);
+constexpr void operator-=(Vector2fScalar& aDataOne, const Vector2fScalar& aDataTwo);
 /**
 * @brief Performs component-wise multiplication and assignment for Vector2s.
 *
@@ -267,7 +282,7 @@ inline void operator-=(Vector2fScalar& aDataOne, const Vector2fScalar& aDataTwo)
 * @param aDataTwo The Vector2fScalar to multiply with (right-hand side).
 * @relates Vector2fScalar
 */
-inline void operator*=(Vector2fScalar& aDataOne, const Vector2fScalar& aDataTwo);
+constexpr void operator*=(Vector2fScalar& aDataOne, const Vector2fScalar& aDataTwo);
 /**
  * @brief Performs scalar multiplication and assignment for Vector2s.
  *
@@ -278,7 +293,7 @@ inline void operator*=(Vector2fScalar& aDataOne, const Vector2fScalar& aDataTwo)
  * @param aScalar The scalar float multiplier.
  * @relates Vector2fScalar
  */
-inline void operator*=(Vector2fScalar& aDataOne, const float& aScalar);
+constexpr void operator*=(Vector2fScalar& aDataOne, const float& aScalar);
 /**
  * @brief Performs component-wise division and assignment for Vector2s.
  *
@@ -291,7 +306,7 @@ inline void operator*=(Vector2fScalar& aDataOne, const float& aScalar);
  *
  * @note No division-by-zero checks are performed. Ensure components of @p aDataTwo are non-zero.
  */
-inline void operator/=(Vector2fScalar& aDataOne, const Vector2fScalar& aDataTwo);
+constexpr void operator/=(Vector2fScalar& aDataOne, const Vector2fScalar& aDataTwo);
 /**
  * @brief Performs scalar division and assignment for Vector2s.
  *
@@ -304,7 +319,86 @@ inline void operator/=(Vector2fScalar& aDataOne, const Vector2fScalar& aDataTwo)
  *
  * @warning No division-by-zero checks are performed. Ensure @p aScalar is non-zero.
  */
-inline void operator/=(Vector2fScalar& aDataOne, const float& aScalar); 
+constexpr void operator/=(Vector2fScalar& aDataOne, const float& aScalar); 
+/** @} */
+
+/**
+* @name Fused arithmetic
+* @brief Multiply-add style functions for Vector2fScalar.
+*
+* @details These map to a single FMA3 instruction when BB_USE_FMA is defined (see Intrinsics.h)
+* and to a multiply followed by an add otherwise. Fused results are rounded once, so they can
+* differ from the equivalent operator expression in the last bit.
+* @{
+*/
+/**
+* @brief Computes (aFactorOne * aFactorTwo) + aAddend component-wise.
+* @relatesalso Vector2fScalar
+*/
+inline Vector2fScalar MulAdd(const Vector2fScalar& aFactorOne, const Vector2fScalar& aFactorTwo, const Vector2fScalar& aAddend);
+/**
+* @brief Computes (aFactorOne * aScalar) + aAddend component-wise.
+* @relatesalso Vector2fScalar
+*/
+inline Vector2fScalar MulAdd(const Vector2fScalar& aFactorOne, float aScalar, const Vector2fScalar& aAddend);
+/**
+* @brief Computes (aFactorOne * aFactorTwo) - aSubtrahend component-wise.
+* @relatesalso Vector2fScalar
+*/
+inline Vector2fScalar MulSub(const Vector2fScalar& aFactorOne, const Vector2fScalar& aFactorTwo, const Vector2fScalar& aSubtrahend);
+/**
+* @brief Computes (aFactorOne * aScalar) - aSubtrahend component-wise.
+* @relatesalso Vector2fScalar
+*/
+inline Vector2fScalar MulSub(const Vector2fScalar& aFactorOne, float aScalar, const Vector2fScalar& aSubtrahend);
+/**
+* @brief Computes aAddend - (aFactorOne * aFactorTwo) component-wise.
+* @relatesalso Vector2fScalar
+*/
+inline Vector2fScalar NegMulAdd(const Vector2fScalar& aFactorOne, const Vector2fScalar& aFactorTwo, const Vector2fScalar& aAddend);
+/**
+* @brief Computes aAddend - (aFactorOne * aScalar) component-wise.
+* @relatesalso Vector2fScalar
+*/
+inline Vector2fScalar NegMulAdd(const Vector2fScalar& aFactorOne, float aScalar, const Vector2fScalar& aAddend);
+/**
+* @brief Linear interpolation between two vectors.
+*
+* @param aFrom Result for aT = 0.
+* @param aTo Result for aT = 1.
+* @param aT Interpolation factor, values outside [0, 1] extrapolate.
+* @relatesalso Vector2fScalar
+*/
+inline Vector2fScalar Lerp(const Vector2fScalar& aFrom, const Vector2fScalar& aTo, float aT);
+
+/** @} */
+/**
+* @name Component-wise
+* @brief Min, max, rounding and selection for Vector2fScalar, with the same results as the Vec3f / Vec4f versions.
+*
+* @details Min and Max return the second operand when a component is NaN, like minps/maxps. The
+* mask functions set all bits of a component where the comparison holds and are meant for
+* Select, which takes aIfTrue where the sign bit of the mask component is set.
+* @{
+*/
+inline Vector2fScalar Min(const Vector2fScalar& aDataOne, const Vector2fScalar& aDataTwo);
+inline Vector2fScalar Max(const Vector2fScalar& aDataOne, const Vector2fScalar& aDataTwo);
+inline Vector2fScalar Abs(const Vector2fScalar& aVector);
+/// @brief Clamps each component to [aMin, aMax], NaN components become aMin.
+inline Vector2fScalar Clamp(const Vector2fScalar& aVector, const Vector2fScalar& aMin, const Vector2fScalar& aMax);
+inline Vector2fScalar Clamp(const Vector2fScalar& aVector, float aMin, float aMax);
+inline Vector2fScalar Floor(const Vector2fScalar& aVector);
+inline Vector2fScalar Ceil(const Vector2fScalar& aVector);
+/// @brief -1, 0 or +1 per component, zero and NaN give 0.
+inline Vector2fScalar Sign(const Vector2fScalar& aVector);
+/// @brief Interpolates each component with its own factor.
+inline Vector2fScalar Lerp(const Vector2fScalar& aFrom, const Vector2fScalar& aTo, const Vector2fScalar& aT);
+inline Vector2fScalar Select(const Vector2fScalar& aMask, const Vector2fScalar& aIfTrue, const Vector2fScalar& aIfFalse);
+inline Vector2fScalar LessMask(const Vector2fScalar& aDataOne, const Vector2fScalar& aDataTwo);
+inline Vector2fScalar LessEqualMask(const Vector2fScalar& aDataOne, const Vector2fScalar& aDataTwo);
+inline Vector2fScalar GreaterMask(const Vector2fScalar& aDataOne, const Vector2fScalar& aDataTwo);
+inline Vector2fScalar GreaterEqualMask(const Vector2fScalar& aDataOne, const Vector2fScalar& aDataTwo);
+inline Vector2fScalar EqualMask(const Vector2fScalar& aDataOne, const Vector2fScalar& aDataTwo);
 /** @} */
 #include "Vector2fScalar.inl"
 
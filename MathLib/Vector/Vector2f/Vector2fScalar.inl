@@ -3,7 +3,7 @@
 #include <cmath>
 
 #pragma region ClassFunctions
-inline float Vector2fScalar::LengthSqr()
+constexpr float Vector2fScalar::LengthSqr() const
 {
     return (x * x) + (y * y); 
 }
@@ -25,12 +25,12 @@ inline void Vector2fScalar::Normalize()
     y /= length; 
 }
 
-inline float Vector2fScalar::Dot(const Vector2fScalar& aVector)
+constexpr float Vector2fScalar::Dot(const Vector2fScalar& aVector) const
 {
     return (x * aVector.x) + (y * aVector.y);
 }
 
-inline Vector2fScalar Vector2fScalar::DistanceTo(const Vector2fScalar& aVector)
+constexpr Vector2fScalar Vector2fScalar::DistanceTo(const Vector2fScalar& aVector) const
 {
     return { aVector.x - x, aVector.y - y };
 }
@@ -54,89 +54,233 @@ inline void Vector2fScalar::Rotate(float aAngle)
     x = newX;
 }
 
+inline Vector2fScalar Vector2fScalar::LoadUnaligned(const float* aSource)
+{
+    return { aSource[0], aSource[1] };
+}
+
+inline Vector2fScalar Vector2fScalar::LoadAligned(const float* aSource)
+{
+    return { aSource[0], aSource[1] };
+}
+
+inline void Vector2fScalar::StoreUnaligned(float* aDestination) const
+{
+    aDestination[0] = x;
+    aDestination[1] = y;
+}
+
+inline void Vector2fScalar::StoreAligned(float* aDestination) const
+{
+    StoreUnaligned(aDestination);
+}
+
+inline void Vector2fScalar::StoreStream(float* aDestination) const
+{
+    StoreUnaligned(aDestination);
+}
+
 #pragma endregion
 
 #pragma region OperatorDefinitions
 
 
-inline bool operator==(const Vector2fScalar& aDataOne, const Vector2fScalar& aDataTwo)
+constexpr bool operator==(const Vector2fScalar& aDataOne, const Vector2fScalar& aDataTwo)
 {
     return aDataOne.x == aDataTwo.x && aDataOne.y == aDataTwo.y; 
 }
 
-inline bool operator!=(const Vector2fScalar& aDataOne, const Vector2fScalar& aDataTwo)
+constexpr bool operator!=(const Vector2fScalar& aDataOne, const Vector2fScalar& aDataTwo)
 {
     return aDataOne.x != aDataTwo.x || aDataOne.y != aDataTwo.y; 
 }
 
-inline Vector2fScalar operator-(const Vector2fScalar& aDataOne)
+constexpr Vector2fScalar operator-(const Vector2fScalar& aDataOne)
 {
     return { -aDataOne.x, -aDataOne.y }; 
 }
 
-inline Vector2fScalar operator+(const Vector2fScalar& aDataOne, const Vector2fScalar& aDataTwo)
+constexpr Vector2fScalar operator+(const Vector2fScalar& aDataOne, const Vector2fScalar& aDataTwo)
 {
     return { aDataOne.x + aDataTwo.x, aDataOne.y + aDataTwo.y };
 }
 
-inline Vector2fScalar operator-(const Vector2fScalar& aDataOne, const Vector2fScalar& aDataTwo)
+constexpr Vector2fScalar operator-(const Vector2fScalar& aDataOne, const Vector2fScalar& aDataTwo)
 {
     return { aDataOne.x - aDataTwo.x, aDataOne.y - aDataTwo.y };
 }
 
-inline Vector2fScalar operator*(const Vector2fScalar& aDataOne, const Vector2fScalar& aDataTwo)
+constexpr Vector2fScalar operator*(const Vector2fScalar& aDataOne, const Vector2fScalar& aDataTwo)
 {
     return { aDataOne.x * aDataTwo.x, aDataOne.y * aDataTwo.y };
 }
 
-inline Vector2fScalar operator*(const Vector2fScalar& aDataOne, const float& aScalar)
+constexpr Vector2fScalar operator*(const Vector2fScalar& aDataOne, const float& aScalar)
 {
     return { aDataOne.x * aScalar, aDataOne.y * aScalar };
 }
 
-inline Vector2fScalar operator*(const float& aScalar, const Vector2fScalar& aDataOne)
+constexpr Vector2fScalar operator*(const float& aScalar, const Vector2fScalar& aDataOne)
 {
     return { aDataOne.x * aScalar, aDataOne.y * aScalar };
 }
 
-inline Vector2fScalar operator/(const Vector2fScalar& aDataOne, const Vector2fScalar& aDataTwo)
+constexpr Vector2fScalar operator/(const Vector2fScalar& aDataOne, const Vector2fScalar& aDataTwo)
 {
     return { aDataOne.x / aDataTwo.x, aDataOne.y / aDataTwo.y };
 }
 
-inline Vector2fScalar operator/(const Vector2fScalar& aDataOne, const float& aScalar)
+constexpr Vector2fScalar operator/(const Vector2fScalar& aDataOne, const float& aScalar)
 {
     return { aDataOne.x / aScalar, aDataOne.y / aScalar }; 
 }
 
-inline void operator+=(Vector2fScalar& aDataOne, const Vector2fScalar& aDataTwo)
+constexpr void operator+=(Vector2fScalar& aDataOne, const Vector2fScalar& aDataTwo)
 {
     aDataOne = { aDataOne.x + aDataTwo.x, aDataOne.y + aDataTwo.y };
 }
 
-inline void operator-=(Vector2fScalar& aDataOne, const Vector2fScalar& aDataTwo)
+constexpr void operator-=(Vector2fScalar& aDataOne, const Vector2fScalar& aDataTwo)
 {
     aDataOne = { aDataOne.x - aDataTwo.x, aDataOne.y - aDataTwo.y };
 }
 
-inline void operator*=(Vector2fScalar& aDataOne, const Vector2fScalar& aDataTwo)
+constexpr void operator*=(Vector2fScalar& aDataOne, const Vector2fScalar& aDataTwo)
 {
     aDataOne = { aDataOne.x * aDataTwo.x, aDataOne.y * aDataTwo.y };
 }
 
-inline void operator*=(Vector2fScalar& aDataOne, const float& aScalar)
+constexpr void operator*=(Vector2fScalar& aDataOne, const float& aScalar)
 {
     aDataOne = { aDataOne.x * aScalar, aDataOne.y * aScalar };
 }
 
-inline void operator/=(Vector2fScalar& aDataOne, const Vector2fScalar& aDataTwo)
+constexpr void operator/=(Vector2fScalar& aDataOne, const Vector2fScalar& aDataTwo)
 {
     aDataOne = { aDataOne.x / aDataTwo.x, aDataOne.y / aDataTwo.y };
 }
 
-inline void operator/=(Vector2fScalar& aDataOne, const float& aScalar)
+constexpr void operator/=(Vector2fScalar& aDataOne, const float& aScalar)
 {
     aDataOne = { aDataOne.x / aScalar, aDataOne.y / aScalar };
 }
 
-#pragma endregion
\ No newline at end of file
+#pragma endregion
+
+#pragma region FusedArithmetic
+
+inline Vector2fScalar MulAdd(const Vector2fScalar& aFactorOne, const Vector2fScalar& aFactorTwo, const Vector2fScalar& aAddend)
+{
+    return { BB::Simd::MulAdd(aFactorOne.x, aFactorTwo.x, aAddend.x), BB::Simd::MulAdd(aFactorOne.y, aFactorTwo.y, aAddend.y) };
+}
+
+inline Vector2fScalar MulAdd(const Vector2fScalar& aFactorOne, float aScalar, const Vector2fScalar& aAddend)
+{
+    return { BB::Simd::MulAdd(aFactorOne.x, aScalar, aAddend.x), BB::Simd::MulAdd(aFactorOne.y, aScalar, aAddend.y) };
+}
+
+inline Vector2fScalar MulSub(const Vector2fScalar& aFactorOne, const Vector2fScalar& aFactorTwo, const Vector2fScalar& aSubtrahend)
+{
+    return { BB::Simd::MulAdd(aFactorOne.x, aFactorTwo.x, -aSubtrahend.x), BB::Simd::MulAdd(aFactorOne.y, aFactorTwo.y, -aSubtrahend.y) };
+}
+
+inline Vector2fScalar MulSub(const Vector2fScalar& aFactorOne, float aScalar, const Vector2fScalar& aSubtrahend)
+{
+    return { BB::Simd::MulAdd(aFactorOne.x, aScalar, -aSubtrahend.x), BB::Simd::MulAdd(aFactorOne.y, aScalar, -aSubtrahend.y) };
+}
+
+inline Vector2fScalar NegMulAdd(const Vector2fScalar& aFactorOne, const Vector2fScalar& aFactorTwo, const Vector2fScalar& aAddend)
+{
+    return { BB::Simd::MulAdd(-aFactorOne.x, aFactorTwo.x, aAddend.x), BB::Simd::MulAdd(-aFactorOne.y, aFactorTwo.y, aAddend.y) };
+}
+
+inline Vector2fScalar NegMulAdd(const Vector2fScalar& aFactorOne, float aScalar, const Vector2fScalar& aAddend)
+{
+    return { BB::Simd::MulAdd(-aFactorOne.x, aScalar, aAddend.x), BB::Simd::MulAdd(-aFactorOne.y, aScalar, aAddend.y) };
+}
+
+inline Vector2fScalar Lerp(const Vector2fScalar& aFrom, const Vector2fScalar& aTo, float aT)
+{
+    return { BB::Simd::MulAdd(aTo.x - aFrom.x, aT, aFrom.x), BB::Simd::MulAdd(aTo.y - aFrom.y, aT, aFrom.y) };
+}
+
+#pragma endregion FusedArithmetic
+
+#pragma region ComponentWise
+
+inline Vector2fScalar Min(const Vector2fScalar& aDataOne, const Vector2fScalar& aDataTwo)
+{
+    return { aDataOne.x < aDataTwo.x ? aDataOne.x : aDataTwo.x, aDataOne.y < aDataTwo.y ? aDataOne.y : aDataTwo.y };
+}
+
+inline Vector2fScalar Max(const Vector2fScalar& aDataOne, const Vector2fScalar& aDataTwo)
+{
+    return { aDataOne.x > aDataTwo.x ? aDataOne.x : aDataTwo.x, aDataOne.y > aDataTwo.y ? aDataOne.y : aDataTwo.y };
+}
+
+inline Vector2fScalar Abs(const Vector2fScalar& aVector)
+{
+    return { std::fabs(aVector.x), std::fabs(aVector.y) };
+}
+
+inline Vector2fScalar Clamp(const Vector2fScalar& aVector, const Vector2fScalar& aMin, const Vector2fScalar& aMax)
+{
+    return Min(Max(aVector, aMin), aMax);
+}
+
+inline Vector2fScalar Clamp(const Vector2fScalar& aVector, float aMin, float aMax)
+{
+    return Min(Max(aVector, Vector2fScalar(aMin)), Vector2fScalar(aMax));
+}
+
+inline Vector2fScalar Floor(const Vector2fScalar& aVector)
+{
+    return { std::floor(aVector.x), std::floor(aVector.y) };
+}
+
+inline Vector2fScalar Ceil(const Vector2fScalar& aVector)
+{
+    return { std::ceil(aVector.x), std::ceil(aVector.y) };
+}
+
+inline Vector2fScalar Sign(const Vector2fScalar& aVector)
+{
+    return { float((aVector.x > 0.0f) - (aVector.x < 0.0f)), float((aVector.y > 0.0f) - (aVector.y < 0.0f)) };
+}
+
+inline Vector2fScalar Lerp(const Vector2fScalar& aFrom, const Vector2fScalar& aTo, const Vector2fScalar& aT)
+{
+    return MulAdd(aTo - aFrom, aT, aFrom);
+}
+
+inline Vector2fScalar Select(const Vector2fScalar& aMask, const Vector2fScalar& aIfTrue, const Vector2fScalar& aIfFalse)
+{
+    return { std::signbit(aMask.x) ? aIfTrue.x : aIfFalse.x, std::signbit(aMask.y) ? aIfTrue.y : aIfFalse.y };
+}
+
+inline Vector2fScalar LessMask(const Vector2fScalar& aDataOne, const Vector2fScalar& aDataTwo)
+{
+    return { BB::Simd::MaskLane(aDataOne.x < aDataTwo.x), BB::Simd::MaskLane(aDataOne.y < aDataTwo.y) };
+}
+
+inline Vector2fScalar LessEqualMask(const Vector2fScalar& aDataOne, const Vector2fScalar& aDataTwo)
+{
+    return { BB::Simd::MaskLane(aDataOne.x <= aDataTwo.x), BB::Simd::MaskLane(aDataOne.y <= aDataTwo.y) };
+}
+
+inline Vector2fScalar GreaterMask(const Vector2fScalar& aDataOne, const Vector2fScalar& aDataTwo)
+{
+    return { BB::Simd::MaskLane(aDataOne.x > aDataTwo.x), BB::Simd::MaskLane(aDataOne.y > aDataTwo.y) };
+}
+
+inline Vector2fScalar GreaterEqualMask(const Vector2fScalar& aDataOne, const Vector2fScalar& aDataTwo)
+{
+    return { BB::Simd::MaskLane(aDataOne.x >= aDataTwo.x), BB::Simd::MaskLane(aDataOne.y >= aDataTwo.y) };
+}
+
+inline Vector2fScalar EqualMask(const Vector2fScalar& aDataOne, const Vector2fScalar& aDataTwo)
+{
+    return { BB::Simd::MaskLane(aDataOne.x == aDataTwo.x), BB::Simd::MaskLane(aDataOne.y == aDataTwo.y) };
+}
+
+#pragma endregion ComponentWise
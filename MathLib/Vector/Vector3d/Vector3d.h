@@ -0,0 +1,154 @@
+#pragma once
+#include "../../Util/Double4.h"
+#include "../Vector3f/Vector3f.h"
+
+/**
+ * @brief Vec3d is the double precision counterpart of Vec3f, aligned to 32 bytes.
+ *
+ * @details The vector stores data in a BB::Simd::Double4, a 256-bit AVX register (__m256d) or
+ * two SSE2 registers when AVX is not available (see Double4.h). Components can be accessed via
+ * {@code x}, {@code y} and {@code z}, the fourth (unused) component is kept at 0.0.
+ *
+ * Use it where float runs out of precision, e.g. world positions millions of units from the
+ * origin or orbital simulation, and convert to Vec3f relative to the camera before rendering
+ * (see Bulk/CameraRelative.h).
+ *
+ * @warning Values are not checked for infinity or NaN.
+ */
+class alignas(32) Vec3d
+{
+public:
+	union
+	{
+		BB::Simd::Double4 data;
+		struct { double x, y, z; };
+		/// @brief Scalar view used by the constexpr code path, lane 3 mirrors the unused fourth component.
+		BB::ScalarLanes<4, double> lanes;
+	};
+
+/**
+* @name Constructors
+* @brief Ways to initialize an instance of Vec3d.
+* @{
+*/
+/// @brief Default constructor. Initializes all components to zero.
+	constexpr Vec3d() : Vec3d(0.0, 0.0, 0.0) {};
+/// @brief Copy constructor. Can use Vec3d or a Double4 to copy the data.
+	Vec3d(const BB::Simd::Double4& aData) : data(aData) {};
+/// @brief Initializes all components (x, y, z) to the same double value.
+	constexpr Vec3d(double aScalar) : Vec3d(aScalar, aScalar, aScalar) {};
+/// @brief Initializes Vec3d with individual x, y, z values, usable in constant expressions.
+	constexpr Vec3d(double aX, double aY, double aZ)
+	{
+		if (std::is_constant_evaluated())
+		{
+			lanes = BB::ScalarLanes<4, double>{ { aX, aY, aZ, 0.0 } };
+		}
+		else
+		{
+			data = BB::Simd::SetDouble4(aX, aY, aZ, 0.0);
+		}
+	};
+/// @brief Widens a Vec3f, exact.
+	explicit Vec3d(const Vec3f& aVector) : data(BB::Simd::ToDouble4(aVector.data)) {};
+/** @} */
+
+/// @brief Rounds the components to float.
+	inline Vec3f ToVec3f() const;
+
+/// @brief Squared length, avoids the square root when only comparing lengths.
+	constexpr double LengthSqr() const;
+	inline double Length() const;
+/// @brief Returns a unit length copy, zero vectors give NaN.
+	inline Vec3d GetNormalized() const;
+/// @brief Normalizes in place, zero vectors give NaN.
+	inline void Normalize();
+	constexpr double Dot(const Vec3d& aVector) const;
+/// @brief Cross product following the right-hand rule.
+	constexpr Vec3d Cross(const Vec3d& aVector) const;
+/// @brief Returns aVector - *this, the vector from this point to aVector (not the scalar distance).
+	constexpr Vec3d DistanceTo(const Vec3d& aVector) const;
+
+/**
+* @name Rotation
+* @brief Right-hand rule rotations, angles in radians.
+* @{
+*/
+	inline Vec3d GetRotatedAroundAxis(Vec3d aAxis, double aAngle) const;
+	inline Vec3d GetRotatedX(double aAngle) const;
+	inline Vec3d GetRotatedY(double aAngle) const;
+	inline Vec3d GetRotatedZ(double aAngle) const;
+	inline void RotateAroundAxis(Vec3d aAxis, double aAngle);
+	inline void RotateX(double aAngle);
+	inline void RotateY(double aAngle);
+	inline void RotateZ(double aAngle);
+/** @} */
+
+/**
+* @name Load and store
+* @brief Moving a Vec3d between the register and plain double memory.
+*
+* @details The unaligned functions read and write exactly three doubles. The aligned and streaming
+* functions move all 32 bytes and need a 32-byte aligned pointer.
+* @{
+*/
+	static inline Vec3d LoadUnaligned(const double* aSource);
+/// @brief Loads x, y, z from a 32-byte aligned pointer. Four doubles are read, the fourth is discarded.
+	static inline Vec3d LoadAligned(const double* aSource);
+	inline void StoreUnaligned(double* aDestination) const;
+	inline void StoreAligned(double* aDestination) const;
+/// @brief Non-temporal store of all 32 bytes, call BB::Simd::StreamFence() before other threads read the data.
+	inline void StoreStream(double* aDestination) const;
+/** @} */
+};
+
+/**
+* @name Operators
+* @brief Vec3d operators, component-wise like the Vec3f operators.
+*
+* @note No division-by-zero checks are performed.
+* @{
+*/
+constexpr bool operator==(const Vec3d& aDataOne, const Vec3d& aDataTwo);
+constexpr bool operator!=(const Vec3d& aDataOne, const Vec3d& aDataTwo);
+constexpr Vec3d operator-(const Vec3d& aDataOne);
+constexpr Vec3d operator+(const Vec3d& aDataOne, const Vec3d& aDataTwo);
+constexpr Vec3d operator-(const Vec3d& aDataOne, const Vec3d& aDataTwo);
+constexpr Vec3d operator*(const Vec3d& aDataOne, const Vec3d& aDataTwo);
+constexpr Vec3d operator*(const Vec3d& aDataOne, const double& aScalar);
+constexpr Vec3d operator*(const double& aScalar, const Vec3d& aDataOne);
+constexpr Vec3d operator/(const Vec3d& aDataOne, const Vec3d& aDataTwo);
+constexpr Vec3d operator/(const Vec3d& aDataOne, const double& aScalar);
+constexpr void operator+=(Vec3d& aDataOne, const Vec3d& aDataTwo);
+constexpr void operator-=(Vec3d& aDataOne, const Vec3d& aDataTwo);
+constexpr void operator*=(Vec3d& aDataOne, const Vec3d& aDataTwo);
+constexpr void operator*=(Vec3d& aDataOne, const double& aScalar);
+constexpr void operator/=(Vec3d& aDataOne, const Vec3d& aDataTwo);
+constexpr void operator/=(Vec3d& aDataOne, const double& aScalar);
+/** @} */
+
+/**
+* @name Fused arithmetic
+* @brief Multiply-add style functions for Vec3d, single FMA3 instructions when BB_USE_FMA is defined.
+* @{
+*/
+inline Vec3d MulAdd(const Vec3d& aFactorOne, const Vec3d& aFactorTwo, const Vec3d& aAddend);
+inline Vec3d MulAdd(const Vec3d& aFactorOne, double aScalar, const Vec3d& aAddend);
+inline Vec3d MulSub(const Vec3d& aFactorOne, const Vec3d& aFactorTwo, const Vec3d& aSubtrahend);
+inline Vec3d MulSub(const Vec3d& aFactorOne, double aScalar, const Vec3d& aSubtrahend);
+inline Vec3d NegMulAdd(const Vec3d& aFactorOne, const Vec3d& aFactorTwo, const Vec3d& aAddend);
+inline Vec3d NegMulAdd(const Vec3d& aFactorOne, double aScalar, const Vec3d& aAddend);
+inline Vec3d Lerp(const Vec3d& aFrom, const Vec3d& aTo, double aT);
+/** @} */
+
+#include "Vector3d.inl"
+
+namespace BitBloom
+{
+/// @brief Compile-time constants, built through the constexpr constructors.
+	inline constexpr Vec3d VEC3D_ZERO(0.0, 0.0, 0.0);
+	inline constexpr Vec3d VEC3D_ONE(1.0, 1.0, 1.0);
+	inline constexpr Vec3d VEC3D_UNIT_X(1.0, 0.0, 0.0);
+	inline constexpr Vec3d VEC3D_UNIT_Y(0.0, 1.0, 0.0);
+	inline constexpr Vec3d VEC3D_UNIT_Z(0.0, 0.0, 1.0);
+}
@@ -0,0 +1,305 @@
+#pragma once
+#include "Vector3d.h"
+#include <cmath>
+
+#pragma region ClassFunctions
+
+inline Vec3f Vec3d::ToVec3f() const
+{
+	return BB::Simd::ToFloat4(data);
+}
+
+constexpr double Vec3d::LengthSqr() const
+{
+	return Dot(*this);
+}
+
+inline double Vec3d::Length() const
+{
+	return std::sqrt(BB::Simd::Dot3(data, data));
+}
+
+inline Vec3d Vec3d::GetNormalized() const
+{
+	return BB::Simd::Div(data, BB::Simd::SplatDouble4(Length()));
+}
+
+inline void Vec3d::Normalize()
+{
+	*this = GetNormalized();
+}
+
+constexpr double Vec3d::Dot(const Vec3d& aVector) const
+{
+	if (std::is_constant_evaluated())
+	{
+		return lanes.value[0] * aVector.lanes.value[0] + lanes.value[1] * aVector.lanes.value[1] + lanes.value[2] * aVector.lanes.value[2];
+	}
+	return BB::Simd::Dot3(data, aVector.data);
+}
+
+constexpr Vec3d Vec3d::Cross(const Vec3d& aVector) const
+{
+	// Done on the components, AVX without AVX2 has no cheap cross-lane shuffle
+	if (std::is_constant_evaluated())
+	{
+		const double* a = lanes.value;
+		const double* b = aVector.lanes.value;
+		return Vec3d(a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0]);
+	}
+	return Vec3d(y * aVector.z - z * aVector.y, z * aVector.x - x * aVector.z, x * aVector.y - y * aVector.x);
+}
+
+constexpr Vec3d Vec3d::DistanceTo(const Vec3d& aVector) const
+{
+	return aVector - *this;
+}
+
+inline Vec3d Vec3d::GetRotatedAroundAxis(Vec3d aAxis, double aAngle) const
+{
+	aAxis.Normalize();
+	double cosA = std::cos(aAngle);
+	double sinA = std::sin(aAngle);
+
+	// Rodrigues' rotation: v * cos + (k x v) * sin + k * (k . v) * (1 - cos)
+	Vec3d result = MulAdd(aAxis.Cross(*this), sinA, *this * cosA);
+	return MulAdd(aAxis, aAxis.Dot(*this) * (1.0 - cosA), result);
+}
+
+inline Vec3d Vec3d::GetRotatedX(double aAngle) const
+{
+	double cosA = std::cos(aAngle);
+	double sinA = std::sin(aAngle);
+	return Vec3d(x, y * cosA - z * sinA, y * sinA + z * cosA);
+}
+
+inline Vec3d Vec3d::GetRotatedY(double aAngle) const
+{
+	double cosA = std::cos(aAngle);
+	double sinA = std::sin(aAngle);
+	return Vec3d(z * sinA + x * cosA, y, z * cosA - x * sinA);
+}
+
+inline Vec3d Vec3d::GetRotatedZ(double aAngle) const
+{
+	double cosA = std::cos(aAngle);
+	double sinA = std::sin(aAngle);
+	return Vec3d(x * cosA - y * sinA, x * sinA + y * cosA, z);
+}
+
+inline void Vec3d::RotateAroundAxis(Vec3d aAxis, double aAngle)
+{
+	*this = GetRotatedAroundAxis(aAxis, aAngle);
+}
+
+inline void Vec3d::RotateX(double aAngle)
+{
+	*this = GetRotatedX(aAngle);
+}
+
+inline void Vec3d::RotateY(double aAngle)
+{
+	*this = GetRotatedY(aAngle);
+}
+
+inline void Vec3d::RotateZ(double aAngle)
+{
+	*this = GetRotatedZ(aAngle);
+}
+
+inline Vec3d Vec3d::LoadUnaligned(const double* aSource)
+{
+	return BB::Simd::LoadDouble3(aSource);
+}
+
+inline Vec3d Vec3d::LoadAligned(const double* aSource)
+{
+	return BB::Simd::ClearW(BB::Simd::LoadAlignedDouble4(aSource));
+}
+
+inline void Vec3d::StoreUnaligned(double* aDestination) const
+{
+	BB::Simd::StoreDouble3(aDestination, data);
+}
+
+inline void Vec3d::StoreAligned(double* aDestination) const
+{
+	BB::Simd::StoreAlignedDouble4(aDestination, data);
+}
+
+inline void Vec3d::StoreStream(double* aDestination) const
+{
+	BB::Simd::StoreStreamDouble4(aDestination, data);
+}
+
+#pragma endregion ClassFunctions
+
+#pragma region OperatorDefinitions
+
+// Each operator has a scalar branch over Vec3d::lanes that is only taken during constant evaluation.
+
+constexpr bool operator==(const Vec3d& aDataOne, const Vec3d& aDataTwo)
+{
+	if (std::is_constant_evaluated())
+	{
+		const double* a = aDataOne.lanes.value;
+		const double* b = aDataTwo.lanes.value;
+		return a[0] == b[0] && a[1] == b[1] && a[2] == b[2] && a[3] == b[3];
+	}
+	return BB::Simd::AllEqual(aDataOne.data, aDataTwo.data);
+}
+
+constexpr bool operator!=(const Vec3d& aDataOne, const Vec3d& aDataTwo)
+{
+	return !(aDataOne == aDataTwo);
+}
+
+constexpr Vec3d operator-(const Vec3d& aDataOne)
+{
+	if (std::is_constant_evaluated())
+	{
+		const double* a = aDataOne.lanes.value;
+		return Vec3d(-a[0], -a[1], -a[2]);
+	}
+	return BB::Simd::Negate(aDataOne.data);
+}
+
+constexpr Vec3d operator+(const Vec3d& aDataOne, const Vec3d& aDataTwo)
+{
+	if (std::is_constant_evaluated())
+	{
+		const double* a = aDataOne.lanes.value;
+		const double* b = aDataTwo.lanes.value;
+		return Vec3d(a[0] + b[0], a[1] + b[1], a[2] + b[2]);
+	}
+	return BB::Simd::Add(aDataOne.data, aDataTwo.data);
+}
+
+constexpr Vec3d operator-(const Vec3d& aDataOne, const Vec3d& aDataTwo)
+{
+	if (std::is_constant_evaluated())
+	{
+		const double* a = aDataOne.lanes.value;
+		const double* b = aDataTwo.lanes.value;
+		return Vec3d(a[0] - b[0], a[1] - b[1], a[2] - b[2]);
+	}
+	return BB::Simd::Sub(aDataOne.data, aDataTwo.data);
+}
+
+constexpr Vec3d operator*(const Vec3d& aDataOne, const Vec3d& aDataTwo)
+{
+	if (std::is_constant_evaluated())
+	{
+		const double* a = aDataOne.lanes.value;
+		const double* b = aDataTwo.lanes.value;
+		return Vec3d(a[0] * b[0], a[1] * b[1], a[2] * b[2]);
+	}
+	return BB::Simd::Mul(aDataOne.data, aDataTwo.data);
+}
+
+constexpr Vec3d operator*(const Vec3d& aDataOne, const double& aScalar)
+{
+	if (std::is_constant_evaluated())
+	{
+		return aDataOne * Vec3d(aScalar);
+	}
+	return BB::Simd::Mul(aDataOne.data, BB::Simd::SplatDouble4(aScalar));
+}
+
+constexpr Vec3d operator*(const double& aScalar, const Vec3d& aDataOne)
+{
+	return aDataOne * aScalar;
+}
+
+constexpr Vec3d operator/(const Vec3d& aDataOne, const Vec3d& aDataTwo)
+{
+	if (std::is_constant_evaluated())
+	{
+		const double* a = aDataOne.lanes.value;
+		const double* b = aDataTwo.lanes.value;
+		return Vec3d(a[0] / b[0], a[1] / b[1], a[2] / b[2]);
+	}
+	// 0 / 0 in the unused lane is NaN, clear it like Vec3f does
+	return BB::Simd::ClearW(BB::Simd::Div(aDataOne.data, aDataTwo.data));
+}
+
+constexpr Vec3d operator/(const Vec3d& aDataOne, const double& aScalar)
+{
+	if (std::is_constant_evaluated())
+	{
+		const double* a = aDataOne.lanes.value;
+		return Vec3d(a[0] / aScalar, a[1] / aScalar, a[2] / aScalar);
+	}
+	return BB::Simd::Div(aDataOne.data, BB::Simd::SplatDouble4(aScalar));
+}
+
+constexpr void operator+=(Vec3d& aDataOne, const Vec3d& aDataTwo)
+{
+	aDataOne = aDataOne + aDataTwo;
+}
+
+constexpr void operator-=(Vec3d& aDataOne, const Vec3d& aDataTwo)
+{
+	aDataOne = aDataOne - aDataTwo;
+}
+
+constexpr void operator*=(Vec3d& aDataOne, const Vec3d& aDataTwo)
+{
+	aDataOne = aDataOne * aDataTwo;
+}
+
+constexpr void operator*=(Vec3d& aDataOne, const double& aScalar)
+{
+	aDataOne = aDataOne * aScalar;
+}
+
+constexpr void operator/=(Vec3d& aDataOne, const Vec3d& aDataTwo)
+{
+	aDataOne = aDataOne / aDataTwo;
+}
+
+constexpr void operator/=(Vec3d& aDataOne, const double& aScalar)
+{
+	aDataOne = aDataOne / aScalar;
+}
+
+#pragma endregion OperatorDefinitions
+
+#pragma region FusedArithmetic
+
+inline Vec3d MulAdd(const Vec3d& aFactorOne, const Vec3d& aFactorTwo, const Vec3d& aAddend)
+{
+	return BB::Simd::MulAdd(aFactorOne.data, aFactorTwo.data, aAddend.data);
+}
+
+inline Vec3d MulAdd(const Vec3d& aFactorOne, double aScalar, const Vec3d& aAddend)
+{
+	return BB::Simd::MulAdd(aFactorOne.data, BB::Simd::SplatDouble4(aScalar), aAddend.data);
+}
+
+inline Vec3d MulSub(const Vec3d& aFactorOne, const Vec3d& aFactorTwo, const Vec3d& aSubtrahend)
+{
+	return BB::Simd::MulSub(aFactorOne.data, aFactorTwo.data, aSubtrahend.data);
+}
+
+inline Vec3d MulSub(const Vec3d& aFactorOne, double aScalar, const Vec3d& aSubtrahend)
+{
+	return BB::Simd::MulSub(aFactorOne.data, BB::Simd::SplatDouble4(aScalar), aSubtrahend.data);
+}
+
+inline Vec3d NegMulAdd(const Vec3d& aFactorOne, const Vec3d& aFactorTwo, const Vec3d& aAddend)
+{
+	return BB::Simd::NegMulAdd(aFactorOne.data, aFactorTwo.data, aAddend.data);
+}
+
+inline Vec3d NegMulAdd(const Vec3d& aFactorOne, double aScalar, const Vec3d& aAddend)
+{
+	return BB::Simd::NegMulAdd(aFactorOne.data, BB::Simd::SplatDouble4(aScalar), aAddend.data);
+}
+
+inline Vec3d Lerp(const Vec3d& aFrom, const Vec3d& aTo, double aT)
+{
+	return BB::Simd::Lerp(aFrom.data, aTo.data, BB::Simd::SplatDouble4(aT));
+}
+
+#pragma endregion FusedArithmetic
@@ -1,5 +1,7 @@
 #pragma once
 #include <emmintrin.h>
+#include "../../Util/Intrinsics.h"
+#include "../../Util/Validation.h"
 /**
  * @brief Vec3f is a SIMD-accelerated 3D vector class aligned to 16 bytes.
  *
@@ -17,6 +19,8 @@ public:
 	{
 		__m128 data;
 		struct { float x, y, z; };
+		/// @brief Scalar view used by the constexpr code path, lane 3 mirrors the unused fourth component.
+		BB::ScalarLanes<4> lanes;
 	};
 
 /**
@@ -27,13 +31,28 @@ public:
 */
 
 /// @brief Default constructor. Initializes all components to zero.
-	Vec3f() : data(_mm_setzero_ps()) {};
+	constexpr Vec3f() : Vec3f(0.0f, 0.0f, 0.0f) {};
 /// @brief Copy constructor. Can use Vec3f or a __m128 to copy the data.
 	Vec3f(const __m128& aSSEData) : data(aSSEData) {};
 /// @brief Initialzes all componets (x, y, z) to the same float value.
-	Vec3f(float aScalar) : data(_mm_set_ps(0.0f, aScalar, aScalar, aScalar)) {};
-/// @brief Initializes Vec3f with individual x, y, z values.
-	Vec3f(float aX, float aY, float aZ) : data(_mm_set_ps(0.0f, aZ, aY, aX)) {};
+	constexpr Vec3f(float aScalar) : Vec3f(aScalar, aScalar, aScalar) {};
+/**
+* @brief Initializes Vec3f with individual x, y, z values.
+*
+* @details Usable in constant expressions, where the values are written to {@code lanes}
+* instead of the SSE register. At runtime the register is set directly.
+*/
+	constexpr Vec3f(float aX, float aY, float aZ)
+	{
+		if (std::is_constant_evaluated())
+		{
+			lanes = BB::ScalarLanes<4>{ { aX, aY, aZ, 0.0f } };
+		}
+		else
+		{
+			data = _mm_set_ps(0.0f, aZ, aY, aX);
+		}
+	};
 /** @} */ 
 // End Constructors Group
 
@@ -46,7 +65,7 @@ public:
  *
  * @return The squared length as a float.
  */
-	inline float LengthSqr();
+	constexpr float LengthSqr() const;
 /**
  * @brief Computes the length (magnitude) of the vector.
  *
@@ -77,6 +96,38 @@ public:
  */
 	inline void Normalize(); 
 
+/**
+* @brief Returns a unit length copy, or aFallback when the vector can not be normalized.
+*
+* @details Branch-free: the normalized vector and aFallback are both computed and one is selected
+* per call. Vectors whose squared length is zero, infinite or NaN give aFallback, so no NaN is
+* produced. Vectors shorter than about 1e-19 underflow to a zero squared length.
+*
+* @param aFallback Returned as is, e.g. an up vector or the previous direction.
+*/
+	inline Vec3f GetSafeNormalized(const Vec3f& aFallback) const;
+/// @brief Normalizes in place, or sets the vector to aFallback, see GetSafeNormalized.
+	inline void SafeNormalize(const Vec3f& aFallback);
+
+/**
+* @name Fast approximations
+* @brief Length and normalization through the rsqrtps estimate instead of sqrtps and divps.
+*
+* @details aRefinements is the number of Newton-Raphson steps (0 to 2) and defaults to
+* BB_FAST_MATH_REFINEMENTS. With the default of one step the result is within about 3e-7 relative
+* error of the full precision version, without refinement within 4e-4 (see Intrinsics.h).
+* @{
+*/
+/// @brief Approximate length, a zero vector gives 0.
+	template<int aRefinements = BB_FAST_MATH_REFINEMENTS>
+	inline float LengthFast() const;
+/// @brief Approximate unit length copy, zero vectors give NaN like GetNormalized.
+	template<int aRefinements = BB_FAST_MATH_REFINEMENTS>
+	inline Vec3f GetNormalizedFast() const;
+	template<int aRefinements = BB_FAST_MATH_REFINEMENTS>
+	inline void NormalizeFast();
+/** @} */
+
 /**
  * @brief Computes the dot product between this vector and another.
  *
@@ -86,7 +137,7 @@ public:
  * @param aVector The other vector to compute the dot product with.
  * @return The dot product as a float.
  */
-	inline float Dot(const Vec3f& aVector); 
+	constexpr float Dot(const Vec3f& aVector) const; 
 /**
  * @brief Computes the cross product between this vector and another.
  *
@@ -96,7 +147,7 @@ public:
  * @param aVector The other vector to compute the cross product with.
  * @return A new Vec3f representing the cross product.
  */
-	inline Vec3f Cross(const Vec3f& aVector);
+	constexpr Vec3f Cross(const Vec3f& aVector) const;
 
 /**
  * @brief Computes the distance from this vector to another.
@@ -109,7 +160,7 @@ public:
  * @note If you want the scalar distance (i.e., the length of the vector between the two points),
  * consider using {@code (a - b).Length()} instead.
  */
-	inline Vec3f DistanceTo(const Vec3f& aVector);
+	constexpr Vec3f DistanceTo(const Vec3f& aVector) const;
 
 
 /**
@@ -184,6 +235,32 @@ public:
  * @param aAngle The angle of rotation in radians.
  */
 	inline void RotateZ(float aAngle);
+
+/**
+* @name Load and store
+* @brief Moving a Vec3f between the register and plain float memory.
+*
+* @details The unaligned functions read and write exactly three floats, so they are safe on tightly
+* packed xyz arrays from mesh files or network buffers. The aligned and streaming functions move
+* all 16 bytes and need a 16-byte aligned pointer, use them on Vec3f-sized (padded) elements.
+* @{
+*/
+/// @brief Loads x, y, z from three consecutive floats, no alignment required.
+	static inline Vec3f LoadUnaligned(const float* aSource);
+/// @brief Loads x, y, z from a 16-byte aligned pointer. Four floats are read, the fourth is discarded.
+	static inline Vec3f LoadAligned(const float* aSource);
+/// @brief Writes x, y, z to three consecutive floats, no alignment required.
+	inline void StoreUnaligned(float* aDestination) const;
+/// @brief Writes x, y, z and the zero padding to a 16-byte aligned pointer.
+	inline void StoreAligned(float* aDestination) const;
+/**
+* @brief Writes x, y, z and the zero padding to a 16-byte aligned pointer, bypassing the cache.
+*
+* @details Non-temporal stores are weakly ordered, call BB::Simd::StreamFence() before other
+* threads read the data.
+*/
+	inline void StoreStream(float* aDestination) const;
+/** @} */
 };
 
 /**
@@ -201,7 +278,7 @@ public:
 * @return A bool depending if the two vectors are equal.
 * @relatesalso Vec3f
 */
-inline bool operator==(const Vec3f& aDataOne, const Vec3f& aDataTwo);
+constexpr bool operator==(const Vec3f& aDataOne, const Vec3f& aDataTwo);
 /**
 * @brief Not equal for vector3s.
 *
@@ -212,7 +289,7 @@ inline bool operator==(const Vec3f& aDataOne, const Vec3f& aDataTwo);
 * @return A bool depending if the two vectors are equal.
 * @relatesalso Vec3f
 */
-inline bool operator!=(const Vec3f& aDataOne, const Vec3f& aDataTwo);
+constexpr bool operator!=(const Vec3f& aDataOne, const Vec3f& aDataTwo);
 /**
 * @brief Negates the given 3D vector.
 * 
@@ -220,7 +297,7 @@ inline bool operator!=(const Vec3f& aDataOne, const Vec3f& aDataTwo);
 * @return A new Vec3f where each component is the negation of the corresponding component in {@code aDataOne}.
 * @relatesalso Vec3f
 */
-inline Vec3f operator-(const Vec3f& aDataOne); 
+constexpr Vec3f operator-(const Vec3f& aDataOne); 
 
 /**
 * @brief Add for vector3s.
@@ -233,7 +310,7 @@ inline Vec3f operator-(const Vec3f& aDataOne);
 * @return A new Vec3f representing the sum of aDataOne and aDataTwo.
 * @relatesalso Vec3f
 */
-inline Vec3f operator+(const Vec3f& aDataOne, const Vec3f& aDataTwo);
+constexpr Vec3f operator+(const Vec3f& aDataOne, const Vec3f& aDataTwo);
 /**
  * @brief Subtract for vector3s.
  *
@@ -245,7 +322,7 @@ inline Vec3f operator+(const Vec3f& aDataOne, const Vec3f& aDataTwo);
  * @return A new Vec3f representing the difference of aDataOne and aDataTwo.
  * @relatesalso Vec3f
 */
-inline Vec3f operator-(const Vec3f& aDataOne, const Vec3f& aDataTwo);
+constexpr Vec3f operator-(const Vec3f& aDataOne, const Vec3f& aDataTwo);
 /**
 * @brief Multiplication for Vector3s.
 * 
@@ -257,7 +334,7 @@ inline Vec3f operator-(const Vec3f& aDataOne, const Vec3f& aDataTwo);
 * @return A new Vec3f representing the sum of aDataOne and aDataTwo.
 * @relatesalso Vec3f
 */
-inline Vec3f operator*(const Vec3f& aDataOne, const Vec3f& aDataTwo);
+constexpr Vec3f operator*(const Vec3f& aDataOne, const Vec3f& aDataTwo);
 /**
 * @brief Multiplication for Vector3s.
 * 
@@ -269,7 +346,7 @@ inline Vec3f operator*(const Vec3f& aDataOne, const Vec3f& aDataTwo);
 * @return A new Vec3f representing the sum of aDataOne by aScalar;
 * @relatesalso Vec3f
 */
-inline Vec3f operator*(const Vec3f& aDataOne, const float& aScalar); 
+constexpr Vec3f operator*(const Vec3f& aDataOne, const float& aScalar); 
 /**
 * @brief Multiplication for Vector3s.
 *
@@ -281,7 +358,7 @@ inline Vec3f operator*(const Vec3f& aDataOne, const float& aScalar);
 * @return A new Vec3f representing the sum of aDataOne by aScalar;
 * @relatesalso Vec3f
 */
-inline Vec3f operator*(const float& aScalar, const Vec3f& aDataOne); 
+constexpr Vec3f operator*(const float& aScalar, const Vec3f& aDataOne); 
 /**
  * @brief component-wise division for Vec3f.
  *
@@ -296,7 +373,7 @@ inline Vec3f operator*(const float& aScalar, const Vec3f& aDataOne);
  * @note No division-by-zero checks are performed; ensure {@code aDataTwo} components are non-zero.
  * @relatesalso Vec3f
  */
-inline Vec3f operator/(const Vec3f& aDataOne, const Vec3f& aDataTwo);
+constexpr Vec3f operator/(const Vec3f& aDataOne, const Vec3f& aDataTwo);
 /**
  * @brief SIMD scalar division for Vec3f.
  *
@@ -309,7 +386,7 @@ inline Vec3f operator/(const Vec3f& aDataOne, const Vec3f& aDataTwo);
  * @note No division-by-zero checks are performed; ensure {@code aScalar} is non-zero.
  * @relatesalso Vec3f
  */
-inline Vec3f operator/(const Vec3f& aDataOne, const float& aScalar);
+constexpr Vec3f operator/(const Vec3f& aDataOne, const float& aScalar);
 
 /**
 * @brief Performs component-wise addition and assignment for Vec3f.
@@ -320,7 +397,7 @@ inline Vec3f operator/(const Vec3f& aDataOne, const float& aScalar);
 * @param aDataTwo The right-hand Vec3f to add.
 * @relates Vec3f
 */
-inline void operator+=(Vec3f& aDataOne, const Vec3f& aDataTwo);
+constexpr void operator+=(Vec3f& aDataOne, const Vec3f& aDataTwo);
 /**
 * @brief Performs component-wise subtraction and assignment for Vec3f.
 *
@@ -330,7 +407,7 @@ inline void operator+=(Vec3f& aDataOne, const Vec3f& aDataTwo);
 * @param aDataTwo The right-hand Vec3f to subtract (subtrahend).
 * @relates Vec3f
 */
-inline void operator-=(Vec3f& aDataOne, const Vec3f& aDataTwo);
+constexpr void operator-=(Vec3f& aDataOne, const Vec3f& aDataTwo);
 /**
 * @brief Performs component-wise multiplication and assignment for Vec3f.
 *
@@ -341,7 +418,7 @@ inline void operator-=(Vec3f& aDataOne, const Vec3f& aDataTwo);
 * @param aDataTwo The vector to multiply with (right-hand side).
 * @relates Vec3f
 */
-inline void operator*=(Vec3f& aDataOne, const Vec3f& aDataTwo);  
+constexpr void operator*=(Vec3f& aDataOne, const Vec3f& aDataTwo);  
 
 /**
  * @brief Performs scalar multiplication and assignment for Vec3f.
@@ -353,7 +430,7 @@ inline void operator*=(Vec3f& aDataOne, const Vec3f& aDataTwo);
  * @param aScalar The scalar float multiplier.
  * @relates Vec3f
  */
-inline void operator*=(Vec3f& aDataOne, const float& aScalar);   
+constexpr void operator*=(Vec3f& aDataOne, const float& aScalar);   
 
 /**
  * @brief Performs component-wise division and assignment for Vec3f.
@@ -367,7 +444,7 @@ inline void operator*=(Vec3f& aDataOne, const float& aScalar);
  *
  * @note No division-by-zero checks are performed. Ensure components of @p aDataTwo are non-zero.
  */
-inline void operator/=(Vec3f& aDataOne, const Vec3f& aDataTwo);  
+constexpr void operator/=(Vec3f& aDataOne, const Vec3f& aDataTwo);  
 /**
  * @brief Performs scalar division and assignment for Vec3f.
  *
@@ -380,9 +457,128 @@ inline void operator/=(Vec3f& aDataOne, const Vec3f& aDataTwo);
  *
  * @warning No division-by-zero checks are performed. Ensure @p aScalar is non-zero.
  */
-inline void operator/=(Vec3f& aDataOne, const float& aScalar);  
+constexpr void operator/=(Vec3f& aDataOne, const float& aScalar);  
+
+/** @} */
+
+/**
+* @name Fused arithmetic
+* @brief Multiply-add style functions for Vec3f.
+*
+* @details These map to a single FMA3 instruction when BB_USE_FMA is defined (see Intrinsics.h)
+* and to a multiply followed by an add otherwise. Fused results are rounded once, so they can
+* differ from the equivalent operator expression in the last bit.
+* @{
+*/
+/**
+* @brief Computes (aFactorOne * aFactorTwo) + aAddend component-wise.
+* @relatesalso Vec3f
+*/
+inline Vec3f MulAdd(const Vec3f& aFactorOne, const Vec3f& aFactorTwo, const Vec3f& aAddend);
+/**
+* @brief Computes (aFactorOne * aScalar) + aAddend component-wise.
+* @relatesalso Vec3f
+*/
+inline Vec3f MulAdd(const Vec3f& aFactorOne, float aScalar, const Vec3f& aAddend);
+/**
+* @brief Computes (aFactorOne * aFactorTwo) - aSubtrahend component-wise.
+* @relatesalso Vec3f
+*/
+inline Vec3f MulSub(const Vec3f& aFactorOne, const Vec3f& aFactorTwo, const Vec3f& aSubtrahend);
+/**
+* @brief Computes (aFactorOne * aScalar) - aSubtrahend component-wise.
+* @relatesalso Vec3f
+*/
+inline Vec3f MulSub(const Vec3f& aFactorOne, float aScalar, const Vec3f& aSubtrahend);
+/**
+* @brief Computes aAddend - (aFactorOne * aFactorTwo) component-wise.
+* @relatesalso Vec3f
+*/
+inline Vec3f NegMulAdd(const Vec3f& aFactorOne, const Vec3f& aFactorTwo, const Vec3f& aAddend);
+/**
+* @brief Computes aAddend - (aFactorOne * aScalar) component-wise.
+* @relatesalso Vec3f
+*/
+inline Vec3f NegMulAdd(const Vec3f& aFactorOne, float aScalar, const Vec3f& aAddend);
+/**
+* @brief Linear interpolation between two vectors.
+*
+* @param aFrom Result for aT = 0.
+* @param aTo Result for aT = 1.
+* @param aT Interpolation factor, values outside [0, 1] extrapolate.
+* @relatesalso Vec3f
+*/
+inline Vec3f Lerp(const Vec3f& aFrom, const Vec3f& aTo, float aT);
+
+/** @} */
+
+/**
+* @name Fast division
+* @brief Division through the rcpps estimate, aRefinements as for Vec3f::GetNormalizedFast.
+*
+* @details Meant for lighting and particle code that tolerates about 1e-4 error, where the
+* divider throughput of operator/ is the bottleneck. Divisors of magnitude 2^126 or more give 0.
+* The vector overload clears the unused component, the zero w of the divisor would make it NaN.
+* The scalar overload does not mask it, w stays 0 times the reciprocal, zero like in operator/.
+* @{
+*/
+template<int aRefinements = BB_FAST_MATH_REFINEMENTS>
+inline Vec3f DivideFast(const Vec3f& aDataOne, const Vec3f& aDataTwo);
+template<int aRefinements = BB_FAST_MATH_REFINEMENTS>
+inline Vec3f DivideFast(const Vec3f& aDataOne, float aScalar);
+/** @} */
+
+/**
+* @name Validity
+* @brief Branch-free NaN and infinity queries for Vec3f.
+* @{
+*/
+/// @brief All bits set in components that are neither infinite nor NaN, usable with Select.
+inline Vec3f FiniteMask(const Vec3f& aVector);
+/// @brief True if no component is infinite or NaN.
+inline bool IsFinite(const Vec3f& aVector);
+/// @brief Replaces infinite and NaN components with the matching component of aReplacement.
+inline Vec3f Sanitize(const Vec3f& aVector, const Vec3f& aReplacement);
+/** @} */
 
+/**
+* @name Component-wise
+* @brief Min, max, rounding and selection for Vec3f, each a few instructions that stay in the register.
+*
+* @details Min and Max follow minps/maxps, when a component is NaN the second operand is returned.
+* The mask functions set all bits of a component where the comparison holds and are meant for
+* Select, which takes aIfTrue where the sign bit of the mask component is set.
+* @{
+*/
+inline Vec3f Min(const Vec3f& aDataOne, const Vec3f& aDataTwo);
+inline Vec3f Max(const Vec3f& aDataOne, const Vec3f& aDataTwo);
+inline Vec3f Abs(const Vec3f& aVector);
+/// @brief Clamps each component to [aMin, aMax], NaN components become aMin.
+inline Vec3f Clamp(const Vec3f& aVector, const Vec3f& aMin, const Vec3f& aMax);
+inline Vec3f Clamp(const Vec3f& aVector, float aMin, float aMax);
+inline Vec3f Floor(const Vec3f& aVector);
+inline Vec3f Ceil(const Vec3f& aVector);
+/// @brief -1, 0 or +1 per component, zero and NaN give 0.
+inline Vec3f Sign(const Vec3f& aVector);
+/// @brief Interpolates each component with its own factor.
+inline Vec3f Lerp(const Vec3f& aFrom, const Vec3f& aTo, const Vec3f& aT);
+inline Vec3f Select(const Vec3f& aMask, const Vec3f& aIfTrue, const Vec3f& aIfFalse);
+inline Vec3f LessMask(const Vec3f& aDataOne, const Vec3f& aDataTwo);
+inline Vec3f LessEqualMask(const Vec3f& aDataOne, const Vec3f& aDataTwo);
+inline Vec3f GreaterMask(const Vec3f& aDataOne, const Vec3f& aDataTwo);
+inline Vec3f GreaterEqualMask(const Vec3f& aDataOne, const Vec3f& aDataTwo);
+inline Vec3f EqualMask(const Vec3f& aDataOne, const Vec3f& aDataTwo);
 /** @} */
 
 #include "Vector3f.inl"
 
+namespace BitBloom
+{
+/// @brief Compile-time constants, built through the constexpr constructors.
+	inline constexpr Vec3f VEC3F_ZERO(0.0f, 0.0f, 0.0f);
+	inline constexpr Vec3f VEC3F_ONE(1.0f, 1.0f, 1.0f);
+	inline constexpr Vec3f VEC3F_UNIT_X(1.0f, 0.0f, 0.0f);
+	inline constexpr Vec3f VEC3F_UNIT_Y(0.0f, 1.0f, 0.0f);
+	inline constexpr Vec3f VEC3F_UNIT_Z(0.0f, 0.0f, 1.0f);
+}
+
@@ -6,8 +6,12 @@
 #pragma region ClassFunctions
 
 
-inline float Vec3f::LengthSqr()
+constexpr float Vec3f::LengthSqr() const
 { 
+	if (std::is_constant_evaluated())
+	{
+		return Dot(*this);
+	}
 	__m128 result = _mm_mul_ps(data, data);
 	//Adds each pair togeter
 	result = _mm_hadd_ps(result, result);   
@@ -26,43 +30,70 @@ inline float Vec3f::Length()
 
 inline Vec3f Vec3f::GetNormalized() 
 {
-	return _mm_div_ps(data, _mm_set1_ps(Length())); 
+	// 0x7F sums x, y, z and broadcasts the result, so the length never leaves the register
+	Vec3f result = _mm_div_ps(data, _mm_sqrt_ps(_mm_dp_ps(data, data, 0x7F)));
+	BB_VALIDATE(IsFinite(result), "GetNormalized on a zero, infinite or NaN vector, see GetSafeNormalized");
+	return result;
 }
 
 inline void Vec3f::Normalize()
 {
-	data = _mm_div_ps(data, _mm_set1_ps(Length()));
+	*this = GetNormalized();
 }
 
-inline float Vec3f::Dot(const Vec3f& aVector)
+inline Vec3f Vec3f::GetSafeNormalized(const Vec3f& aFallback) const
 {
+	const __m128 lengthSqr = _mm_dp_ps(data, data, 0x7F);
+	// NaN fails both compares, so zero, infinite and NaN lengths all select the fallback
+	const __m128 valid = _mm_and_ps(_mm_cmpgt_ps(lengthSqr, _mm_setzero_ps()), _mm_cmplt_ps(lengthSqr, _mm_set1_ps(INFINITY)));
+	return BB::Simd::Select(valid, _mm_div_ps(data, _mm_sqrt_ps(lengthSqr)), aFallback.data);
+}
+
+inline void Vec3f::SafeNormalize(const Vec3f& aFallback)
+{
+	data = GetSafeNormalized(aFallback).data;
+}
+
+constexpr float Vec3f::Dot(const Vec3f& aVector) const
+{
+	if (std::is_constant_evaluated())
+	{
+		return lanes.value[0] * aVector.lanes.value[0] + lanes.value[1] * aVector.lanes.value[1] + lanes.value[2] * aVector.lanes.value[2];
+	}
 	return _mm_cvtss_f32(_mm_dp_ps(data, aVector.data, 0x71));
 }
 
-inline Vec3f Vec3f::Cross(const Vec3f& aVector)
+constexpr Vec3f Vec3f::Cross(const Vec3f& aVector) const
 { 
+	if (std::is_constant_evaluated())
+	{
+		const float* a = lanes.value;
+		const float* b = aVector.lanes.value;
+		return Vec3f(a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0]);
+	}
 	__m128 result = _mm_sub_ps( 
 		_mm_mul_ps(data, _mm_shuffle_ps(aVector.data, aVector.data, _MM_SHUFFLE(3, 0, 2, 1))), 
 		_mm_mul_ps(_mm_shuffle_ps(data, data, _MM_SHUFFLE(3, 0, 2, 1)), aVector.data));      
 	return _mm_shuffle_ps(result, result, _MM_SHUFFLE(3, 0, 2, 1)); 
 }
-inline Vec3f Vec3f::DistanceTo(const Vec3f& aVector)
+constexpr Vec3f Vec3f::DistanceTo(const Vec3f& aVector) const
 {
+	if (std::is_constant_evaluated())
+	{
+		return aVector - *this;
+	}
 	return _mm_sub_ps(aVector.data, data);   
 }
 
 inline Vec3f Vec3f::GetRotatedAroundAxis(Vec3f aAxis, float aAngle)
 {
-	aAxis = aAxis.GetNormalized(); 
+	aAxis.Normalize(); 
 	float cosA = std::cos(aAngle);
 	float sinA = std::sin(aAngle);
 
-	float dot = Dot(aAxis);
-
-	float newX = x * cosA + (aAxis.y * z - aAxis.z * y) * sinA + aAxis.x * dot * (1 - cosA);
-	float newY = y * cosA + (aAxis.z * x - aAxis.x * z) * sinA + aAxis.y * dot * (1 - cosA);
-
-	return *this * cosA + aAxis.Cross(*this) * sinA + aAxis * (aAxis.Dot(*this) * (1.0f - cosA));  
+	// Rodrigues' rotation: v * cos + (k x v) * sin + k * (k . v) * (1 - cos)
+	Vec3f result = MulAdd(aAxis.Cross(*this), sinA, *this * cosA);
+	return MulAdd(aAxis, aAxis.Dot(*this) * (1.0f - cosA), result);
 }
 
 inline Vec3f Vec3f::GetRotatedX(float aAngle)
@@ -70,170 +101,396 @@ inline Vec3f Vec3f::GetRotatedX(float aAngle)
 	float cosA = std::cos(aAngle);
 	float sinA = std::sin(aAngle);
 
-	return Vec3f(
-		x,
-		(y * cosA) - (z * sinA),
-		(y * sinA) + (z * cosA));
-
+	// (x, y * cos - z * sin, y * sin + z * cos)
+	__m128 swapped = _mm_shuffle_ps(data, data, _MM_SHUFFLE(3, 1, 2, 0)); 
+	return BB::Simd::MulAdd(swapped, _mm_set_ps(0, sinA, -sinA, 0), _mm_mul_ps(data, _mm_set_ps(0, cosA, cosA, 1)));
 }
 
 inline Vec3f Vec3f::GetRotatedY(float aAngle)
 {
 	float cosA = std::cos(aAngle); 
 	float sinA = std::sin(aAngle); 
-	return Vec3f(
-		(z * sinA) + (x * cosA),
-		y, 
-		(z * cosA) - (x * sinA));
+
+	// (z * sin + x * cos, y, z * cos - x * sin)
+	__m128 swapped = _mm_shuffle_ps(data, data, _MM_SHUFFLE(3, 0, 1, 2)); 
+	return BB::Simd::MulAdd(swapped, _mm_set_ps(0, -sinA, 0, sinA), _mm_mul_ps(data, _mm_set_ps(0, cosA, 1, cosA)));
 }
 
 inline Vec3f Vec3f::GetRotatedZ(float aAngle)
 {
 	float cosA = std::cos(aAngle); 
 	float sinA = std::sin(aAngle); 
-	return Vec3f(
-		(x * cosA) - (y * sinA), 
-		(x * sinA) + (y * cosA), 
-		z); 
+
+	// (x * cos - y * sin, x * sin + y * cos, z)
+	__m128 swapped = _mm_shuffle_ps(data, data, _MM_SHUFFLE(3, 2, 0, 1)); 
+	return BB::Simd::MulAdd(swapped, _mm_set_ps(0, 0, sinA, -sinA), _mm_mul_ps(data, _mm_set_ps(0, 1, cosA, cosA)));
 }
 
 inline void Vec3f::RotateAroundAxis(Vec3f aAxis, float aAngle) 
 {
-	aAxis = aAxis.GetNormalized();
-	float cosA = std::cos(aAngle);
-	float sinA = std::sin(aAngle);
-
-	float dot = Dot(aAxis);
-
-	float newX = x * cosA + (aAxis.y * z - aAxis.z * y) * sinA + aAxis.x * dot * (1 - cosA); 
-	float newY = y * cosA + (aAxis.z * x - aAxis.x * z) * sinA + aAxis.y * dot * (1 - cosA); 
-
-	z = z * cosA + (aAxis.x * y - aAxis.y * x) * sinA + aAxis.z * dot * (1 - cosA); 
-	x = newX;
-	y = newY;
-
+	*this = GetRotatedAroundAxis(aAxis, aAngle);
 }
 
 inline void Vec3f::RotateX(float aAngle)
 {
-	float cosA = std::cos(aAngle); 
-	float sinA = std::sin(aAngle);
-
-	float newY = (y * cosA) - (z * sinA);
-	
-	z = (y * sinA) + (z * sinA);
-	y = newY;
+	*this = GetRotatedX(aAngle);
 }
 
 inline void Vec3f::RotateY(float aAngle)
 {
-	float cosA = std::cos(aAngle);
-	float sinA = std::sin(aAngle);
-
-	float newZ = (z * cosA) - (x * sinA);
-	x = (z * sinA) + (x * cosA);
-	z = newZ;
+	*this = GetRotatedY(aAngle);
 }
 
 inline void Vec3f::RotateZ(float aAngle)
 {
-	float cosA = std::cos(aAngle);
-	float sinA = std::sin(aAngle);
+	*this = GetRotatedZ(aAngle);
+}
+
 
-	float newX = (x * cosA) - (y * sinA);
-	
-	y = (x * sinA) + (y * cosA);
-	x = newX;
+inline Vec3f Vec3f::LoadUnaligned(const float* aSource)
+{
+	// Two 8-byte and 4-byte loads so nothing past z is touched
+	__m128 xy = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double*>(aSource)));
+	return _mm_movelh_ps(xy, _mm_load_ss(aSource + 2));
+}
+
+inline Vec3f Vec3f::LoadAligned(const float* aSource)
+{
+	return _mm_and_ps(_mm_load_ps(aSource), _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1)));
+}
+
+inline void Vec3f::StoreUnaligned(float* aDestination) const
+{
+	_mm_store_sd(reinterpret_cast<double*>(aDestination), _mm_castps_pd(data));
+	_mm_store_ss(aDestination + 2, _mm_movehl_ps(data, data));
+}
 
+inline void Vec3f::StoreAligned(float* aDestination) const
+{
+	_mm_store_ps(aDestination, data);
 }
 
+inline void Vec3f::StoreStream(float* aDestination) const
+{
+	_mm_stream_ps(aDestination, data);
+}
 
 #pragma endregion ClassFunctions
 
 #pragma region OperatorDefinitions
 
+// Each operator has a scalar branch over Vec3f::lanes that is only taken during constant evaluation.
 
-bool operator==(const Vec3f& aDataOne, const Vec3f& aDataTwo)
+constexpr bool operator==(const Vec3f& aDataOne, const Vec3f& aDataTwo)
 {
+	if (std::is_constant_evaluated())
+	{
+		const float* a = aDataOne.lanes.value;
+		const float* b = aDataTwo.lanes.value;
+		return a[0] == b[0] && a[1] == b[1] && a[2] == b[2] && a[3] == b[3];
+	}
 	return _mm_movemask_ps(_mm_cmpeq_ps(aDataOne.data, aDataTwo.data)) == 0xF;
 }
 
-bool operator!=(const Vec3f& aDataOne, const Vec3f& aDataTwo)
+constexpr bool operator!=(const Vec3f& aDataOne, const Vec3f& aDataTwo)
 {
+	if (std::is_constant_evaluated())
+	{
+		return !(aDataOne == aDataTwo);
+	}
 	return _mm_movemask_ps(_mm_cmpeq_ps(aDataOne.data, aDataTwo.data)) != 0xF;
 }
-Vec3f operator-(const Vec3f& aDataOne)
+
+constexpr Vec3f operator-(const Vec3f& aDataOne)
 {
+	if (std::is_constant_evaluated())
+	{
+		const float* a = aDataOne.lanes.value;
+		return Vec3f(-a[0], -a[1], -a[2]);
+	}
 	return _mm_xor_ps(aDataOne.data, _mm_set1_ps(-0.0f)); 
 }
 
-Vec3f operator+(const Vec3f& aDataOne, const Vec3f& aDataTwo)
+constexpr Vec3f operator+(const Vec3f& aDataOne, const Vec3f& aDataTwo)
 {
+	if (std::is_constant_evaluated())
+	{
+		const float* a = aDataOne.lanes.value;
+		const float* b = aDataTwo.lanes.value;
+		return Vec3f(a[0] + b[0], a[1] + b[1], a[2] + b[2]);
+	}
 	return _mm_add_ps(aDataOne.data, aDataTwo.data);
 }
 
-Vec3f operator-(const Vec3f& aDataOne, const Vec3f& aDataTwo)
+constexpr Vec3f operator-(const Vec3f& aDataOne, const Vec3f& aDataTwo)
 {
+	if (std::is_constant_evaluated())
+	{
+		const float* a = aDataOne.lanes.value;
+		const float* b = aDataTwo.lanes.value;
+		return Vec3f(a[0] - b[0], a[1] - b[1], a[2] - b[2]);
+	}
 	return _mm_sub_ps(aDataOne.data, aDataTwo.data);
 }
 
-Vec3f operator*(const Vec3f& aDataOne, const Vec3f& aDataTwo)
+constexpr Vec3f operator*(const Vec3f& aDataOne, const Vec3f& aDataTwo)
 {
+	if (std::is_constant_evaluated())
+	{
+		const float* a = aDataOne.lanes.value;
+		const float* b = aDataTwo.lanes.value;
+		return Vec3f(a[0] * b[0], a[1] * b[1], a[2] * b[2]);
+	}
 	return _mm_mul_ps(aDataOne.data, aDataTwo.data);
 }
 
-Vec3f operator*(const Vec3f& aDataOne, const float& aScalar)
+constexpr Vec3f operator*(const Vec3f& aDataOne, const float& aScalar)
 {
+	if (std::is_constant_evaluated())
+	{
+		return aDataOne * Vec3f(aScalar);
+	}
 	return _mm_mul_ps(aDataOne.data, _mm_set1_ps(aScalar)); 
 }
 
-Vec3f operator*(const float& aScalar, const Vec3f& aDataOne)
+constexpr Vec3f operator*(const float& aScalar, const Vec3f& aDataOne)
 {
+	if (std::is_constant_evaluated())
+	{
+		return Vec3f(aScalar) * aDataOne;
+	}
 	return _mm_mul_ps(_mm_set1_ps(aScalar), aDataOne.data);
 }
 
-inline Vec3f operator/(const Vec3f& aDataOne, const Vec3f& aDataTwo)
+constexpr Vec3f operator/(const Vec3f& aDataOne, const Vec3f& aDataTwo)
 {
+	if (std::is_constant_evaluated())
+	{
+		const float* a = aDataOne.lanes.value;
+		const float* b = aDataTwo.lanes.value;
+		return Vec3f(a[0] / b[0], a[1] / b[1], a[2] / b[2]);
+	}
+	BB_VALIDATE((_mm_movemask_ps(_mm_cmpeq_ps(aDataTwo.data, _mm_setzero_ps())) & 0x7) == 0, "Vec3f divided by a vector with a zero component");
 	__m128 result = _mm_div_ps(aDataOne.data, aDataTwo.data);
 	__m128 mask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
 	return _mm_and_ps(result, mask);
 }
 
-inline Vec3f operator/(const Vec3f& aDataOne, const float& aScalar)
+constexpr Vec3f operator/(const Vec3f& aDataOne, const float& aScalar)
 {
+	if (std::is_constant_evaluated())
+	{
+		const float* a = aDataOne.lanes.value;
+		return Vec3f(a[0] / aScalar, a[1] / aScalar, a[2] / aScalar);
+	}
+	BB_VALIDATE(aScalar != 0.0f, "Vec3f divided by zero");
 	return _mm_div_ps(aDataOne.data, _mm_set1_ps(aScalar));
 }
 
-void operator+=(Vec3f& aDataOne, const Vec3f& aDataTwo)
+constexpr void operator+=(Vec3f& aDataOne, const Vec3f& aDataTwo)
 {
-	aDataOne.data = _mm_add_ps(aDataOne.data, aDataTwo.data);
+	aDataOne = aDataOne + aDataTwo;
 }
 
-void operator-=(Vec3f& aDataOne, const Vec3f& aDataTwo)
+constexpr void operator-=(Vec3f& aDataOne, const Vec3f& aDataTwo)
 {
-	aDataOne.data = _mm_sub_ps(aDataOne.data, aDataTwo.data);
+	aDataOne = aDataOne - aDataTwo;
 }
 
-void operator*=(Vec3f& aDataOne, const Vec3f& aDataTwo)
+constexpr void operator*=(Vec3f& aDataOne, const Vec3f& aDataTwo)
 {
-	aDataOne.data = _mm_mul_ps(aDataOne.data, aDataTwo.data);
+	aDataOne = aDataOne * aDataTwo;
 }
 
-inline void operator*=(Vec3f& aDataOne, const float& aScalar)
+constexpr void operator*=(Vec3f& aDataOne, const float& aScalar)
 {
-	aDataOne.data = _mm_mul_ps(aDataOne.data, _mm_set1_ps(aScalar)); 
+	aDataOne = aDataOne * aScalar;
 }
 
-inline void operator/=(Vec3f& aDataOne, const Vec3f& aDataTwo)
+constexpr void operator/=(Vec3f& aDataOne, const Vec3f& aDataTwo)
 {
-	__m128 result = _mm_div_ps(aDataOne.data, aDataTwo.data);
-	__m128 mask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
-	aDataOne.data = _mm_and_ps(result, mask);
+	aDataOne = aDataOne / aDataTwo;
 }
 
-inline void operator/=(Vec3f& aDataOne, const float& aScalar)
+constexpr void operator/=(Vec3f& aDataOne, const float& aScalar)
 {
-	aDataOne.data = _mm_div_ps(aDataOne.data, _mm_set1_ps(aScalar)); 
+	aDataOne = aDataOne / aScalar;
 }
 
 #pragma endregion OperatorDefinitions
+
+#pragma region FusedArithmetic
+
+inline Vec3f MulAdd(const Vec3f& aFactorOne, const Vec3f& aFactorTwo, const Vec3f& aAddend)
+{
+	return BB::Simd::MulAdd(aFactorOne.data, aFactorTwo.data, aAddend.data);
+}
+
+inline Vec3f MulAdd(const Vec3f& aFactorOne, float aScalar, const Vec3f& aAddend)
+{
+	return BB::Simd::MulAdd(aFactorOne.data, _mm_set1_ps(aScalar), aAddend.data);
+}
+
+inline Vec3f MulSub(const Vec3f& aFactorOne, const Vec3f& aFactorTwo, const Vec3f& aSubtrahend)
+{
+	return BB::Simd::MulSub(aFactorOne.data, aFactorTwo.data, aSubtrahend.data);
+}
+
+inline Vec3f MulSub(const Vec3f& aFactorOne, float aScalar, const Vec3f& aSubtrahend)
+{
+	return BB::Simd::MulSub(aFactorOne.data, _mm_set1_ps(aScalar), aSubtrahend.data);
+}
+
+inline Vec3f NegMulAdd(const Vec3f& aFactorOne, const Vec3f& aFactorTwo, const Vec3f& aAddend)
+{
+	return BB::Simd::NegMulAdd(aFactorOne.data, aFactorTwo.data, aAddend.data);
+}
+
+inline Vec3f NegMulAdd(const Vec3f& aFactorOne, float aScalar, const Vec3f& aAddend)
+{
+	return BB::Simd::NegMulAdd(aFactorOne.data, _mm_set1_ps(aScalar), aAddend.data);
+}
+
+inline Vec3f Lerp(const Vec3f& aFrom, const Vec3f& aTo, float aT)
+{
+	return BB::Simd::Lerp(aFrom.data, aTo.data, _mm_set1_ps(aT));
+}
+
+#pragma endregion FusedArithmetic
+
+#pragma region Validity
+
+inline Vec3f FiniteMask(const Vec3f& aVector)
+{
+	return BB::Simd::FiniteMask(aVector.data);
+}
+
+inline bool IsFinite(const Vec3f& aVector)
+{
+	return _mm_movemask_ps(BB::Simd::FiniteMask(aVector.data)) == 0xF;
+}
+
+inline Vec3f Sanitize(const Vec3f& aVector, const Vec3f& aReplacement)
+{
+	return BB::Simd::Select(BB::Simd::FiniteMask(aVector.data), aVector.data, aReplacement.data);
+}
+
+#pragma endregion Validity
+
+#pragma region FastApproximation
+
+template<int aRefinements>
+inline float Vec3f::LengthFast() const
+{
+	const __m128 lengthSqr = _mm_dp_ps(data, data, 0x7F);
+	// sqrt(x) = x * rsqrt(x), the mask turns 0 * infinity into 0 for zero vectors
+	const __m128 length = _mm_mul_ps(lengthSqr, BB::Simd::ReciprocalSqrt<aRefinements>(lengthSqr));
+	return _mm_cvtss_f32(_mm_and_ps(length, _mm_cmpgt_ps(lengthSqr, _mm_setzero_ps())));
+}
+
+template<int aRefinements>
+inline Vec3f Vec3f::GetNormalizedFast() const
+{
+	return _mm_mul_ps(data, BB::Simd::ReciprocalSqrt<aRefinements>(_mm_dp_ps(data, data, 0x7F)));
+}
+
+template<int aRefinements>
+inline void Vec3f::NormalizeFast()
+{
+	data = GetNormalizedFast<aRefinements>().data;
+}
+
+template<int aRefinements>
+inline Vec3f DivideFast(const Vec3f& aDataOne, const Vec3f& aDataTwo)
+{
+	__m128 result = _mm_mul_ps(aDataOne.data, BB::Simd::Reciprocal<aRefinements>(aDataTwo.data));
+	// 1 / 0 in the unused lane is infinity, and 0 * infinity NaN
+	return _mm_and_ps(result, _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1)));
+}
+
+template<int aRefinements>
+inline Vec3f DivideFast(const Vec3f& aDataOne, float aScalar)
+{
+	return _mm_mul_ps(aDataOne.data, BB::Simd::Reciprocal<aRefinements>(_mm_set1_ps(aScalar)));
+}
+
+#pragma endregion FastApproximation
+
+#pragma region ComponentWise
+
+inline Vec3f Min(const Vec3f& aDataOne, const Vec3f& aDataTwo)
+{
+	return _mm_min_ps(aDataOne.data, aDataTwo.data);
+}
+
+inline Vec3f Max(const Vec3f& aDataOne, const Vec3f& aDataTwo)
+{
+	return _mm_max_ps(aDataOne.data, aDataTwo.data);
+}
+
+inline Vec3f Abs(const Vec3f& aVector)
+{
+	return BB::Simd::Abs(aVector.data);
+}
+
+inline Vec3f Clamp(const Vec3f& aVector, const Vec3f& aMin, const Vec3f& aMax)
+{
+	return BB::Simd::Clamp(aVector.data, aMin.data, aMax.data);
+}
+
+inline Vec3f Clamp(const Vec3f& aVector, float aMin, float aMax)
+{
+	return BB::Simd::Clamp(aVector.data, Vec3f(aMin).data, Vec3f(aMax).data);
+}
+
+inline Vec3f Floor(const Vec3f& aVector)
+{
+	return _mm_floor_ps(aVector.data);
+}
+
+inline Vec3f Ceil(const Vec3f& aVector)
+{
+	return _mm_ceil_ps(aVector.data);
+}
+
+inline Vec3f Sign(const Vec3f& aVector)
+{
+	return BB::Simd::Sign(aVector.data);
+}
+
+inline Vec3f Lerp(const Vec3f& aFrom, const Vec3f& aTo, const Vec3f& aT)
+{
+	return BB::Simd::Lerp(aFrom.data, aTo.data, aT.data);
+}
+
+inline Vec3f Select(const Vec3f& aMask, const Vec3f& aIfTrue, const Vec3f& aIfFalse)
+{
+	return BB::Simd::Select(aMask.data, aIfTrue.data, aIfFalse.data);
+}
+
+inline Vec3f LessMask(const Vec3f& aDataOne, const Vec3f& aDataTwo)
+{
+	return _mm_cmplt_ps(aDataOne.data, aDataTwo.data);
+}
+
+inline Vec3f LessEqualMask(const Vec3f& aDataOne, const Vec3f& aDataTwo)
+{
+	return _mm_cmple_ps(aDataOne.data, aDataTwo.data);
+}
+
+inline Vec3f GreaterMask(const Vec3f& aDataOne, const Vec3f& aDataTwo)
+{
+	return _mm_cmpgt_ps(aDataOne.data, aDataTwo.data);
+}
+
+inline Vec3f GreaterEqualMask(const Vec3f& aDataOne, const Vec3f& aDataTwo)
+{
+	return _mm_cmpge_ps(aDataOne.data, aDataTwo.data);
+}
+
+inline Vec3f EqualMask(const Vec3f& aDataOne, const Vec3f& aDataTwo)
+{
+	return _mm_cmpeq_ps(aDataOne.data, aDataTwo.data);
+}
+
+#pragma endregion ComponentWise
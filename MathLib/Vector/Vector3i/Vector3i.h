@@ -0,0 +1,132 @@
+#pragma once
+#include <cstdint>
+#include <immintrin.h>
+#include "../../Util/Intrinsics.h"
+#include "../Vector3f/Vector3f.h"
+
+/**
+ * @brief Vec3i is a SIMD integer 3D vector aligned to 16 bytes, meant for grid and voxel coordinates.
+ *
+ * @details The vector stores data in a 128-bit SSE register (__m128i) as four int32_t, components
+ * can be accessed via {@code x}, {@code y} and {@code z}. The fourth (unused) component is kept
+ * at 0 like in Vec3f.
+ *
+ * The conversions from Vec3f (Floor, Round, Truncate) stay in the register, so a cell index can be
+ * computed from a position without going through scalar casts.
+ *
+ * @warning Arithmetic wraps on overflow, converting floats outside the int32_t range gives INT32_MIN.
+ */
+class Vec3i
+{
+public:
+	union
+	{
+		__m128i data;
+		struct { int32_t x, y, z; };
+		/// @brief Scalar view used by the constexpr code path, lane 3 mirrors the unused fourth component.
+		BB::ScalarLanes<4, int32_t> lanes;
+	};
+
+/**
+* @name Constructors
+* @brief Ways to initialize an instance of Vec3i.
+* @{
+*/
+/// @brief Default constructor. Initializes all components to zero.
+	constexpr Vec3i() : Vec3i(0, 0, 0) {};
+/// @brief Copy constructor. Can use Vec3i or a __m128i to copy the data.
+	Vec3i(const __m128i& aSSEData) : data(aSSEData) {};
+/// @brief Initializes all components (x, y, z) to the same value.
+	constexpr Vec3i(int32_t aScalar) : Vec3i(aScalar, aScalar, aScalar) {};
+/// @brief Initializes Vec3i with individual x, y, z values, usable in constant expressions.
+	constexpr Vec3i(int32_t aX, int32_t aY, int32_t aZ)
+	{
+		if (std::is_constant_evaluated())
+		{
+			lanes = BB::ScalarLanes<4, int32_t>{ { aX, aY, aZ, 0 } };
+		}
+		else
+		{
+			data = _mm_set_epi32(0, aZ, aY, aX);
+		}
+	};
+/** @} */
+
+/**
+* @name Conversion
+* @brief Float to integer conversions, all of them done in the SSE register.
+* @{
+*/
+/// @brief Rounds each component towards negative infinity, the cell containing a position.
+	static inline Vec3i Floor(const Vec3f& aVector);
+/// @brief Rounds each component to the nearest integer, halfway cases go to the even integer.
+	static inline Vec3i Round(const Vec3f& aVector);
+/// @brief Rounds each component towards zero, the same as a static_cast per component.
+	static inline Vec3i Truncate(const Vec3f& aVector);
+/// @brief Converts the components to float, exact up to 2^24.
+	inline Vec3f ToVec3f() const;
+/** @} */
+
+/**
+* @name Load and store
+* @brief Moving a Vec3i between the register and plain int32_t memory, exactly three values.
+* @{
+*/
+	static inline Vec3i LoadUnaligned(const int32_t* aSource);
+	inline void StoreUnaligned(int32_t* aDestination) const;
+/** @} */
+};
+
+/**
+* @name Operators
+* @brief Vec3i operators, component-wise.
+*
+* @details There is no division, SSE has no integer divide. Shifts use the same count for every
+* component, operator>> is an arithmetic shift so negative coordinates keep flooring.
+* @{
+*/
+constexpr bool operator==(const Vec3i& aDataOne, const Vec3i& aDataTwo);
+constexpr bool operator!=(const Vec3i& aDataOne, const Vec3i& aDataTwo);
+constexpr Vec3i operator-(const Vec3i& aDataOne);
+constexpr Vec3i operator+(const Vec3i& aDataOne, const Vec3i& aDataTwo);
+constexpr Vec3i operator-(const Vec3i& aDataOne, const Vec3i& aDataTwo);
+/// @brief Keeps the low 32 bits of each product.
+constexpr Vec3i operator*(const Vec3i& aDataOne, const Vec3i& aDataTwo);
+constexpr Vec3i operator*(const Vec3i& aDataOne, const int32_t& aScalar);
+constexpr Vec3i operator*(const int32_t& aScalar, const Vec3i& aDataOne);
+constexpr Vec3i operator&(const Vec3i& aDataOne, const Vec3i& aDataTwo);
+constexpr Vec3i operator|(const Vec3i& aDataOne, const Vec3i& aDataTwo);
+constexpr Vec3i operator^(const Vec3i& aDataOne, const Vec3i& aDataTwo);
+constexpr Vec3i operator<<(const Vec3i& aDataOne, int aShift);
+constexpr Vec3i operator>>(const Vec3i& aDataOne, int aShift);
+constexpr void operator+=(Vec3i& aDataOne, const Vec3i& aDataTwo);
+constexpr void operator-=(Vec3i& aDataOne, const Vec3i& aDataTwo);
+constexpr void operator*=(Vec3i& aDataOne, const Vec3i& aDataTwo);
+constexpr void operator*=(Vec3i& aDataOne, const int32_t& aScalar);
+constexpr void operator<<=(Vec3i& aDataOne, int aShift);
+constexpr void operator>>=(Vec3i& aDataOne, int aShift);
+/** @} */
+
+/**
+* @name Min, max and comparisons
+* @brief The comparisons return one bit per component, bit 0 for x, so {@code == 0x7} means all three.
+* @{
+*/
+inline Vec3i Min(const Vec3i& aDataOne, const Vec3i& aDataTwo);
+inline Vec3i Max(const Vec3i& aDataOne, const Vec3i& aDataTwo);
+inline int CompareEqual(const Vec3i& aDataOne, const Vec3i& aDataTwo);
+inline int CompareLess(const Vec3i& aDataOne, const Vec3i& aDataTwo);
+inline int CompareGreater(const Vec3i& aDataOne, const Vec3i& aDataTwo);
+/** @} */
+
+#include "Vector3i.inl"
+
+namespace BitBloom
+{
+/// @brief Compile-time constants, built through the constexpr constructors.
+	inline constexpr Vec3i VEC3I_ZERO(0, 0, 0);
+	inline constexpr Vec3i VEC3I_ONE(1, 1, 1);
+	inline constexpr Vec3i VEC3I_UNIT_X(1, 0, 0);
+	inline constexpr Vec3i VEC3I_UNIT_Y(0, 1, 0);
+	inline constexpr Vec3i VEC3I_UNIT_Z(0, 0, 1);
+}
@@ -0,0 +1,231 @@
+#pragma once
+#include "Vector3i.h"
+
+#pragma region ClassFunctions
+
+inline Vec3i Vec3i::Floor(const Vec3f& aVector)
+{
+	return _mm_cvttps_epi32(_mm_floor_ps(aVector.data));
+}
+
+inline Vec3i Vec3i::Round(const Vec3f& aVector)
+{
+	// Uses the MXCSR rounding mode, round to nearest even unless the application changed it
+	return _mm_cvtps_epi32(aVector.data);
+}
+
+inline Vec3i Vec3i::Truncate(const Vec3f& aVector)
+{
+	return _mm_cvttps_epi32(aVector.data);
+}
+
+inline Vec3f Vec3i::ToVec3f() const
+{
+	return _mm_cvtepi32_ps(data);
+}
+
+inline Vec3i Vec3i::LoadUnaligned(const int32_t* aSource)
+{
+	// An 8-byte and a 4-byte load so nothing past z is touched
+	__m128i xy = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(aSource));
+	return _mm_unpacklo_epi64(xy, _mm_cvtsi32_si128(aSource[2]));
+}
+
+inline void Vec3i::StoreUnaligned(int32_t* aDestination) const
+{
+	_mm_storel_epi64(reinterpret_cast<__m128i*>(aDestination), data);
+	aDestination[2] = _mm_cvtsi128_si32(_mm_unpackhi_epi64(data, data));
+}
+
+#pragma endregion ClassFunctions
+
+#pragma region OperatorDefinitions
+
+// Each operator has a scalar branch over Vec3i::lanes that is only taken during constant evaluation.
+// The scalar branch goes through uint32_t where signed overflow would not be a constant expression.
+
+constexpr bool operator==(const Vec3i& aDataOne, const Vec3i& aDataTwo)
+{
+	if (std::is_constant_evaluated())
+	{
+		const int32_t* a = aDataOne.lanes.value;
+		const int32_t* b = aDataTwo.lanes.value;
+		return a[0] == b[0] && a[1] == b[1] && a[2] == b[2] && a[3] == b[3];
+	}
+	return _mm_movemask_epi8(_mm_cmpeq_epi32(aDataOne.data, aDataTwo.data)) == 0xFFFF;
+}
+
+constexpr bool operator!=(const Vec3i& aDataOne, const Vec3i& aDataTwo)
+{
+	return !(aDataOne == aDataTwo);
+}
+
+constexpr Vec3i operator-(const Vec3i& aDataOne)
+{
+	if (std::is_constant_evaluated())
+	{
+		return Vec3i(0) - aDataOne;
+	}
+	return _mm_sub_epi32(_mm_setzero_si128(), aDataOne.data);
+}
+
+constexpr Vec3i operator+(const Vec3i& aDataOne, const Vec3i& aDataTwo)
+{
+	if (std::is_constant_evaluated())
+	{
+		const int32_t* a = aDataOne.lanes.value;
+		const int32_t* b = aDataTwo.lanes.value;
+		return Vec3i(int32_t(uint32_t(a[0]) + uint32_t(b[0])), int32_t(uint32_t(a[1]) + uint32_t(b[1])), int32_t(uint32_t(a[2]) + uint32_t(b[2])));
+	}
+	return _mm_add_epi32(aDataOne.data, aDataTwo.data);
+}
+
+constexpr Vec3i operator-(const Vec3i& aDataOne, const Vec3i& aDataTwo)
+{
+	if (std::is_constant_evaluated())
+	{
+		const int32_t* a = aDataOne.lanes.value;
+		const int32_t* b = aDataTwo.lanes.value;
+		return Vec3i(int32_t(uint32_t(a[0]) - uint32_t(b[0])), int32_t(uint32_t(a[1]) - uint32_t(b[1])), int32_t(uint32_t(a[2]) - uint32_t(b[2])));
+	}
+	return _mm_sub_epi32(aDataOne.data, aDataTwo.data);
+}
+
+constexpr Vec3i operator*(const Vec3i& aDataOne, const Vec3i& aDataTwo)
+{
+	if (std::is_constant_evaluated())
+	{
+		const int32_t* a = aDataOne.lanes.value;
+		const int32_t* b = aDataTwo.lanes.value;
+		return Vec3i(int32_t(uint32_t(a[0]) * uint32_t(b[0])), int32_t(uint32_t(a[1]) * uint32_t(b[1])), int32_t(uint32_t(a[2]) * uint32_t(b[2])));
+	}
+	return _mm_mullo_epi32(aDataOne.data, aDataTwo.data);
+}
+
+constexpr Vec3i operator*(const Vec3i& aDataOne, const int32_t& aScalar)
+{
+	if (std::is_constant_evaluated())
+	{
+		return aDataOne * Vec3i(aScalar);
+	}
+	return _mm_mullo_epi32(aDataOne.data, _mm_set1_epi32(aScalar));
+}
+
+constexpr Vec3i operator*(const int32_t& aScalar, const Vec3i& aDataOne)
+{
+	return aDataOne * aScalar;
+}
+
+constexpr Vec3i operator&(const Vec3i& aDataOne, const Vec3i& aDataTwo)
+{
+	if (std::is_constant_evaluated())
+	{
+		const int32_t* a = aDataOne.lanes.value;
+		const int32_t* b = aDataTwo.lanes.value;
+		return Vec3i(a[0] & b[0], a[1] & b[1], a[2] & b[2]);
+	}
+	return _mm_and_si128(aDataOne.data, aDataTwo.data);
+}
+
+constexpr Vec3i operator|(const Vec3i& aDataOne, const Vec3i& aDataTwo)
+{
+	if (std::is_constant_evaluated())
+	{
+		const int32_t* a = aDataOne.lanes.value;
+		const int32_t* b = aDataTwo.lanes.value;
+		return Vec3i(a[0] | b[0], a[1] | b[1], a[2] | b[2]);
+	}
+	return _mm_or_si128(aDataOne.data, aDataTwo.data);
+}
+
+constexpr Vec3i operator^(const Vec3i& aDataOne, const Vec3i& aDataTwo)
+{
+	if (std::is_constant_evaluated())
+	{
+		const int32_t* a = aDataOne.lanes.value;
+		const int32_t* b = aDataTwo.lanes.value;
+		return Vec3i(a[0] ^ b[0], a[1] ^ b[1], a[2] ^ b[2]);
+	}
+	return _mm_xor_si128(aDataOne.data, aDataTwo.data);
+}
+
+constexpr Vec3i operator<<(const Vec3i& aDataOne, int aShift)
+{
+	if (std::is_constant_evaluated())
+	{
+		const int32_t* a = aDataOne.lanes.value;
+		return Vec3i(int32_t(uint32_t(a[0]) << aShift), int32_t(uint32_t(a[1]) << aShift), int32_t(uint32_t(a[2]) << aShift));
+	}
+	return _mm_sll_epi32(aDataOne.data, _mm_cvtsi32_si128(aShift));
+}
+
+constexpr Vec3i operator>>(const Vec3i& aDataOne, int aShift)
+{
+	if (std::is_constant_evaluated())
+	{
+		const int32_t* a = aDataOne.lanes.value;
+		return Vec3i(a[0] >> aShift, a[1] >> aShift, a[2] >> aShift);
+	}
+	return _mm_sra_epi32(aDataOne.data, _mm_cvtsi32_si128(aShift));
+}
+
+constexpr void operator+=(Vec3i& aDataOne, const Vec3i& aDataTwo)
+{
+	aDataOne = aDataOne + aDataTwo;
+}
+
+constexpr void operator-=(Vec3i& aDataOne, const Vec3i& aDataTwo)
+{
+	aDataOne = aDataOne - aDataTwo;
+}
+
+constexpr void operator*=(Vec3i& aDataOne, const Vec3i& aDataTwo)
+{
+	aDataOne = aDataOne * aDataTwo;
+}
+
+constexpr void operator*=(Vec3i& aDataOne, const int32_t& aScalar)
+{
+	aDataOne = aDataOne * aScalar;
+}
+
+constexpr void operator<<=(Vec3i& aDataOne, int aShift)
+{
+	aDataOne = aDataOne << aShift;
+}
+
+constexpr void operator>>=(Vec3i& aDataOne, int aShift)
+{
+	aDataOne = aDataOne >> aShift;
+}
+
+#pragma endregion OperatorDefinitions
+
+#pragma region Comparison
+
+inline Vec3i Min(const Vec3i& aDataOne, const Vec3i& aDataTwo)
+{
+	return _mm_min_epi32(aDataOne.data, aDataTwo.data);
+}
+
+inline Vec3i Max(const Vec3i& aDataOne, const Vec3i& aDataTwo)
+{
+	return _mm_max_epi32(aDataOne.data, aDataTwo.data);
+}
+
+inline int CompareEqual(const Vec3i& aDataOne, const Vec3i& aDataTwo)
+{
+	return _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(aDataOne.data, aDataTwo.data))) & 0x7;
+}
+
+inline int CompareLess(const Vec3i& aDataOne, const Vec3i& aDataTwo)
+{
+	return _mm_movemask_ps(_mm_castsi128_ps(_mm_cmplt_epi32(aDataOne.data, aDataTwo.data))) & 0x7;
+}
+
+inline int CompareGreater(const Vec3i& aDataOne, const Vec3i& aDataTwo)
+{
+	return _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(aDataOne.data, aDataTwo.data))) & 0x7;
+}
+
+#pragma endregion Comparison
@@ -0,0 +1,130 @@
+#pragma once
+#include "../../Util/Double4.h"
+#include "../Vector4f/Vector4f.h"
+
+/**
+ * @brief Vec4d is the double precision counterpart of Vec4f, aligned to 32 bytes.
+ *
+ * @details The vector stores data in a BB::Simd::Double4, a 256-bit AVX register (__m256d) or
+ * two SSE2 registers when AVX is not available (see Double4.h). Components can be accessed via
+ * {@code x}, {@code y}, {@code z} and {@code w}.
+ *
+ * @warning Values are not checked for infinity or NaN.
+ */
+class alignas(32) Vec4d
+{
+public:
+	union
+	{
+		BB::Simd::Double4 data;
+		struct { double x, y, z, w; };
+		/// @brief Scalar view used by the constexpr code path.
+		BB::ScalarLanes<4, double> lanes;
+	};
+
+/**
+* @name Constructors
+* @brief Ways to initialize an instance of Vec4d.
+* @{
+*/
+/// @brief Default constructor. Initializes all components to zero.
+	constexpr Vec4d() : Vec4d(0.0, 0.0, 0.0, 0.0) {};
+/// @brief Copy constructor. Can use Vec4d or a Double4 to copy the data.
+	Vec4d(const BB::Simd::Double4& aData) : data(aData) {};
+/// @brief Initializes all components (x, y, z, w) to the same double value.
+	constexpr Vec4d(double aScalar) : Vec4d(aScalar, aScalar, aScalar, aScalar) {};
+/// @brief Initializes Vec4d with individual x, y, z, w values, usable in constant expressions.
+	constexpr Vec4d(double aX, double aY, double aZ, double aW)
+	{
+		if (std::is_constant_evaluated())
+		{
+			lanes = BB::ScalarLanes<4, double>{ { aX, aY, aZ, aW } };
+		}
+		else
+		{
+			data = BB::Simd::SetDouble4(aX, aY, aZ, aW);
+		}
+	};
+/// @brief Widens a Vec4f, exact.
+	explicit Vec4d(const Vec4f& aVector) : data(BB::Simd::ToDouble4(aVector.data)) {};
+/** @} */
+
+/// @brief Rounds the components to float.
+	inline Vec4f ToVec4f() const;
+
+/// @brief Squared length, avoids the square root when only comparing lengths.
+	constexpr double LengthSqr() const;
+	inline double Length() const;
+/// @brief Returns a unit length copy, zero vectors give NaN.
+	inline Vec4d GetNormalized() const;
+/// @brief Normalizes in place, zero vectors give NaN.
+	inline void Normalize();
+	constexpr double Dot(const Vec4d& aVector) const;
+
+/**
+* @name Load and store
+* @brief Moving a Vec4d between the register and plain double memory.
+* @{
+*/
+/// @brief Loads four consecutive doubles, no alignment required.
+	static inline Vec4d LoadUnaligned(const double* aSource);
+/// @brief Loads four doubles from a 32-byte aligned pointer.
+	static inline Vec4d LoadAligned(const double* aSource);
+	inline void StoreUnaligned(double* aDestination) const;
+	inline void StoreAligned(double* aDestination) const;
+/// @brief Non-temporal store to a 32-byte aligned pointer, call BB::Simd::StreamFence() before other threads read the data.
+	inline void StoreStream(double* aDestination) const;
+/** @} */
+};
+
+/**
+* @name Operators
+* @brief Vec4d operators, component-wise like the Vec4f operators.
+*
+* @note No division-by-zero checks are performed.
+* @{
+*/
+constexpr bool operator==(const Vec4d& aDataOne, const Vec4d& aDataTwo);
+constexpr bool operator!=(const Vec4d& aDataOne, const Vec4d& aDataTwo);
+constexpr Vec4d operator-(const Vec4d& aDataOne);
+constexpr Vec4d operator+(const Vec4d& aDataOne, const Vec4d& aDataTwo);
+constexpr Vec4d operator-(const Vec4d& aDataOne, const Vec4d& aDataTwo);
+constexpr Vec4d operator*(const Vec4d& aDataOne, const Vec4d& aDataTwo);
+constexpr Vec4d operator*(const Vec4d& aDataOne, const double& aScalar);
+constexpr Vec4d operator*(const double& aScalar, const Vec4d& aDataOne);
+constexpr Vec4d operator/(const Vec4d& aDataOne, const Vec4d& aDataTwo);
+constexpr Vec4d operator/(const Vec4d& aDataOne, const double& aScalar);
+constexpr void operator+=(Vec4d& aDataOne, const Vec4d& aDataTwo);
+constexpr void operator-=(Vec4d& aDataOne, const Vec4d& aDataTwo);
+constexpr void operator*=(Vec4d& aDataOne, const Vec4d& aDataTwo);
+constexpr void operator*=(Vec4d& aDataOne, const double& aScalar);
+constexpr void operator/=(Vec4d& aDataOne, const Vec4d& aDataTwo);
+constexpr void operator/=(Vec4d& aDataOne, const double& aScalar);
+/** @} */
+
+/**
+* @name Fused arithmetic
+* @brief Multiply-add style functions for Vec4d, single FMA3 instructions when BB_USE_FMA is defined.
+* @{
+*/
+inline Vec4d MulAdd(const Vec4d& aFactorOne, const Vec4d& aFactorTwo, const Vec4d& aAddend);
+inline Vec4d MulAdd(const Vec4d& aFactorOne, double aScalar, const Vec4d& aAddend);
+inline Vec4d MulSub(const Vec4d& aFactorOne, const Vec4d& aFactorTwo, const Vec4d& aSubtrahend);
+inline Vec4d MulSub(const Vec4d& aFactorOne, double aScalar, const Vec4d& aSubtrahend);
+inline Vec4d NegMulAdd(const Vec4d& aFactorOne, const Vec4d& aFactorTwo, const Vec4d& aAddend);
+inline Vec4d NegMulAdd(const Vec4d& aFactorOne, double aScalar, const Vec4d& aAddend);
+inline Vec4d Lerp(const Vec4d& aFrom, const Vec4d& aTo, double aT);
+/** @} */
+
+#include "Vector4d.inl"
+
+namespace BitBloom
+{
+/// @brief Compile-time constants, built through the constexpr constructors.
+	inline constexpr Vec4d VEC4D_ZERO(0.0, 0.0, 0.0, 0.0);
+	inline constexpr Vec4d VEC4D_ONE(1.0, 1.0, 1.0, 1.0);
+	inline constexpr Vec4d VEC4D_UNIT_X(1.0, 0.0, 0.0, 0.0);
+	inline constexpr Vec4d VEC4D_UNIT_Y(0.0, 1.0, 0.0, 0.0);
+	inline constexpr Vec4d VEC4D_UNIT_Z(0.0, 0.0, 1.0, 0.0);
+	inline constexpr Vec4d VEC4D_UNIT_W(0.0, 0.0, 0.0, 1.0);
+}
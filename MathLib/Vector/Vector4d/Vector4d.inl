@@ -0,0 +1,237 @@
+#pragma once
+#include "Vector4d.h"
+#include <cmath>
+
+#pragma region ClassFunctions
+
+inline Vec4f Vec4d::ToVec4f() const
+{
+	return BB::Simd::ToFloat4(data);
+}
+
+constexpr double Vec4d::LengthSqr() const
+{
+	return Dot(*this);
+}
+
+inline double Vec4d::Length() const
+{
+	return std::sqrt(BB::Simd::Dot4(data, data));
+}
+
+inline Vec4d Vec4d::GetNormalized() const
+{
+	return BB::Simd::Div(data, BB::Simd::SplatDouble4(Length()));
+}
+
+inline void Vec4d::Normalize()
+{
+	*this = GetNormalized();
+}
+
+constexpr double Vec4d::Dot(const Vec4d& aVector) const
+{
+	if (std::is_constant_evaluated())
+	{
+		const double* a = lanes.value;
+		const double* b = aVector.lanes.value;
+		return a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3];
+	}
+	return BB::Simd::Dot4(data, aVector.data);
+}
+
+inline Vec4d Vec4d::LoadUnaligned(const double* aSource)
+{
+	return BB::Simd::LoadDouble4(aSource);
+}
+
+inline Vec4d Vec4d::LoadAligned(const double* aSource)
+{
+	return BB::Simd::LoadAlignedDouble4(aSource);
+}
+
+inline void Vec4d::StoreUnaligned(double* aDestination) const
+{
+	BB::Simd::StoreDouble4(aDestination, data);
+}
+
+inline void Vec4d::StoreAligned(double* aDestination) const
+{
+	BB::Simd::StoreAlignedDouble4(aDestination, data);
+}
+
+inline void Vec4d::StoreStream(double* aDestination) const
+{
+	BB::Simd::StoreStreamDouble4(aDestination, data);
+}
+
+#pragma endregion ClassFunctions
+
+#pragma region OperatorDefinitions
+
+// Each operator has a scalar branch over Vec4d::lanes that is only taken during constant evaluation.
+
+constexpr bool operator==(const Vec4d& aDataOne, const Vec4d& aDataTwo)
+{
+	if (std::is_constant_evaluated())
+	{
+		const double* a = aDataOne.lanes.value;
+		const double* b = aDataTwo.lanes.value;
+		return a[0] == b[0] && a[1] == b[1] && a[2] == b[2] && a[3] == b[3];
+	}
+	return BB::Simd::AllEqual(aDataOne.data, aDataTwo.data);
+}
+
+constexpr bool operator!=(const Vec4d& aDataOne, const Vec4d& aDataTwo)
+{
+	return !(aDataOne == aDataTwo);
+}
+
+constexpr Vec4d operator-(const Vec4d& aDataOne)
+{
+	if (std::is_constant_evaluated())
+	{
+		const double* a = aDataOne.lanes.value;
+		return Vec4d(-a[0], -a[1], -a[2], -a[3]);
+	}
+	return BB::Simd::Negate(aDataOne.data);
+}
+
+constexpr Vec4d operator+(const Vec4d& aDataOne, const Vec4d& aDataTwo)
+{
+	if (std::is_constant_evaluated())
+	{
+		const double* a = aDataOne.lanes.value;
+		const double* b = aDataTwo.lanes.value;
+		return Vec4d(a[0] + b[0], a[1] + b[1], a[2] + b[2], a[3] + b[3]);
+	}
+	return BB::Simd::Add(aDataOne.data, aDataTwo.data);
+}
+
+constexpr Vec4d operator-(const Vec4d& aDataOne, const Vec4d& aDataTwo)
+{
+	if (std::is_constant_evaluated())
+	{
+		const double* a = aDataOne.lanes.value;
+		const double* b = aDataTwo.lanes.value;
+		return Vec4d(a[0] - b[0], a[1] - b[1], a[2] - b[2], a[3] - b[3]);
+	}
+	return BB::Simd::Sub(aDataOne.data, aDataTwo.data);
+}
+
+constexpr Vec4d operator*(const Vec4d& aDataOne, const Vec4d& aDataTwo)
+{
+	if (std::is_constant_evaluated())
+	{
+		const double* a = aDataOne.lanes.value;
+		const double* b = aDataTwo.lanes.value;
+		return Vec4d(a[0] * b[0], a[1] * b[1], a[2] * b[2], a[3] * b[3]);
+	}
+	return BB::Simd::Mul(aDataOne.data, aDataTwo.data);
+}
+
+constexpr Vec4d operator*(const Vec4d& aDataOne, const double& aScalar)
+{
+	if (std::is_constant_evaluated())
+	{
+		return aDataOne * Vec4d(aScalar);
+	}
+	return BB::Simd::Mul(aDataOne.data, BB::Simd::SplatDouble4(aScalar));
+}
+
+constexpr Vec4d operator*(const double& aScalar, const Vec4d& aDataOne)
+{
+	return aDataOne * aScalar;
+}
+
+constexpr Vec4d operator/(const Vec4d& aDataOne, const Vec4d& aDataTwo)
+{
+	if (std::is_constant_evaluated())
+	{
+		const double* a = aDataOne.lanes.value;
+		const double* b = aDataTwo.lanes.value;
+		return Vec4d(a[0] / b[0], a[1] / b[1], a[2] / b[2], a[3] / b[3]);
+	}
+	return BB::Simd::Div(aDataOne.data, aDataTwo.data);
+}
+
+constexpr Vec4d operator/(const Vec4d& aDataOne, const double& aScalar)
+{
+	if (std::is_constant_evaluated())
+	{
+		const double* a = aDataOne.lanes.value;
+		return Vec4d(a[0] / aScalar, a[1] / aScalar, a[2] / aScalar, a[3] / aScalar);
+	}
+	return BB::Simd::Div(aDataOne.data, BB::Simd::SplatDouble4(aScalar));
+}
+
+constexpr void operator+=(Vec4d& aDataOne, const Vec4d& aDataTwo)
+{
+	aDataOne = aDataOne + aDataTwo;
+}
+
+constexpr void operator-=(Vec4d& aDataOne, const Vec4d& aDataTwo)
+{
+	aDataOne = aDataOne - aDataTwo;
+}
+
+constexpr void operator*=(Vec4d& aDataOne, const Vec4d& aDataTwo)
+{
+	aDataOne = aDataOne * aDataTwo;
+}
+
+constexpr void operator*=(Vec4d& aDataOne, const double& aScalar)
+{
+	aDataOne = aDataOne * aScalar;
+}
+
+constexpr void operator/=(Vec4d& aDataOne, const Vec4d& aDataTwo)
+{
+	aDataOne = aDataOne / aDataTwo;
+}
+
+constexpr void operator/=(Vec4d& aDataOne, const double& aScalar)
+{
+	aDataOne = aDataOne / aScalar;
+}
+
+#pragma endregion OperatorDefinitions
+
+#pragma region FusedArithmetic
+
+inline Vec4d MulAdd(const Vec4d& aFactorOne, const Vec4d& aFactorTwo, const Vec4d& aAddend)
+{
+	return BB::Simd::MulAdd(aFactorOne.data, aFactorTwo.data, aAddend.data);
+}
+
+inline Vec4d MulAdd(const Vec4d& aFactorOne, double aScalar, const Vec4d& aAddend)
+{
+	return BB::Simd::MulAdd(aFactorOne.data, BB::Simd::SplatDouble4(aScalar), aAddend.data);
+}
+
+inline Vec4d MulSub(const Vec4d& aFactorOne, const Vec4d& aFactorTwo, const Vec4d& aSubtrahend)
+{
+	return BB::Simd::MulSub(aFactorOne.data, aFactorTwo.data, aSubtrahend.data);
+}
+
+inline Vec4d MulSub(const Vec4d& aFactorOne, double aScalar, const Vec4d& aSubtrahend)
+{
+	return BB::Simd::MulSub(aFactorOne.data, BB::Simd::SplatDouble4(aScalar), aSubtrahend.data);
+}
+
+inline Vec4d NegMulAdd(const Vec4d& aFactorOne, const Vec4d& aFactorTwo, const Vec4d& aAddend)
+{
+	return BB::Simd::NegMulAdd(aFactorOne.data, aFactorTwo.data, aAddend.data);
+}
+
+inline Vec4d NegMulAdd(const Vec4d& aFactorOne, double aScalar, const Vec4d& aAddend)
+{
+	return BB::Simd::NegMulAdd(aFactorOne.data, BB::Simd::SplatDouble4(aScalar), aAddend.data);
+}
+
+inline Vec4d Lerp(const Vec4d& aFrom, const Vec4d& aTo, double aT)
+{
+	return BB::Simd::Lerp(aFrom.data, aTo.data, BB::Simd::SplatDouble4(aT));
+}
+
+#pragma endregion FusedArithmetic
@@ -1,5 +1,7 @@
 #pragma once
 #include <emmintrin.h>
+#include "../../Util/Intrinsics.h"
+#include "../../Util/Validation.h"
 
 
 /**
@@ -19,6 +21,8 @@ public:
 	{
 		__m128 data;
 		struct { float x, y, z, w; };
+		/// @brief Scalar view used by the constexpr code path.
+		BB::ScalarLanes<4> lanes;
 	};
 
 /**
@@ -29,13 +33,28 @@ public:
 */
 
 /// @brief Default constructor. Initializes all components to zero.
-	Vec4f() : data(_mm_setzero_ps()) {};
+	constexpr Vec4f() : Vec4f(0.0f, 0.0f, 0.0f, 0.0f) {};
 /// @brief Copy constructor. Can use Vec4f or a __m128 to copy the data.
 	Vec4f(const __m128& aSSEData) : data(aSSEData) {};
 /// @brief Initialzes all components (x, y, z, w) to the same float value.
-	Vec4f(float aScalar) : data(_mm_set1_ps(aScalar)) {};
-/// @brief Initialzes Vec4f with individual x, y, z, w values.
-	Vec4f(float aX, float aY, float aZ, float aW) : data(_mm_set_ps(aW, aZ, aY, aX)) {};
+	constexpr Vec4f(float aScalar) : Vec4f(aScalar, aScalar, aScalar, aScalar) {};
+/**
+* @brief Initialzes Vec4f with individual x, y, z, w values.
+*
+* @details Usable in constant expressions, where the values are written to {@code lanes}
+* instead of the SSE register. At runtime the register is set directly.
+*/
+	constexpr Vec4f(float aX, float aY, float aZ, float aW)
+	{
+		if (std::is_constant_evaluated())
+		{
+			lanes = BB::ScalarLanes<4>{ { aX, aY, aZ, aW } };
+		}
+		else
+		{
+			data = _mm_set_ps(aW, aZ, aY, aX);
+		}
+	};
 /// @} 
 // End Constructors Group
 
@@ -48,7 +67,7 @@ public:
  *
  * @return The squared length as a float.
  */
-	inline float LengthSqr(); 
+	constexpr float LengthSqr() const;
 
 /**
  * @brief Computes the length (magnitude) of the vector.
@@ -80,6 +99,38 @@ public:
  * @note No check is performed for zero-length vectors. Normalizing a zero vector may produce invalid results.
  */
 	inline void Normalize();
+
+/**
+* @brief Returns a unit length copy, or aFallback when the vector can not be normalized.
+*
+* @details Branch-free: the normalized vector and aFallback are both computed and one is selected
+* per call. Vectors whose squared length is zero, infinite or NaN give aFallback, so no NaN is
+* produced. Vectors shorter than about 1e-19 underflow to a zero squared length.
+*
+* @param aFallback Returned as is, e.g. an up vector or the previous direction.
+*/
+	inline Vec4f GetSafeNormalized(const Vec4f& aFallback) const;
+/// @brief Normalizes in place, or sets the vector to aFallback, see GetSafeNormalized.
+	inline void SafeNormalize(const Vec4f& aFallback);
+
+/**
+* @name Fast approximations
+* @brief Length and normalization through the rsqrtps estimate instead of sqrtps and divps.
+*
+* @details aRefinements is the number of Newton-Raphson steps (0 to 2) and defaults to
+* BB_FAST_MATH_REFINEMENTS. With the default of one step the result is within about 3e-7 relative
+* error of the full precision version, without refinement within 4e-4 (see Intrinsics.h).
+* @{
+*/
+/// @brief Approximate length, a zero vector gives 0.
+	template<int aRefinements = BB_FAST_MATH_REFINEMENTS>
+	inline float LengthFast() const;
+/// @brief Approximate unit length copy, zero vectors give NaN like GetNormalized.
+	template<int aRefinements = BB_FAST_MATH_REFINEMENTS>
+	inline Vec4f GetNormalizedFast() const;
+	template<int aRefinements = BB_FAST_MATH_REFINEMENTS>
+	inline void NormalizeFast();
+/** @} */
 /**
  * @brief Computes the dot product between this vector and another.
  *
@@ -89,8 +140,30 @@ public:
  * @param aVector The other vector to compute the dot product with.
  * @return The dot product as a float.
  */
-	inline float Dot(const Vec4f& aVector);
+	constexpr float Dot(const Vec4f& aVector) const;
 
+
+/**
+* @name Load and store
+* @brief Moving a Vec4f between the register and plain float memory.
+* @{
+*/
+/// @brief Loads four consecutive floats, no alignment required.
+	static inline Vec4f LoadUnaligned(const float* aSource);
+/// @brief Loads four floats from a 16-byte aligned pointer.
+	static inline Vec4f LoadAligned(const float* aSource);
+/// @brief Writes the four components, no alignment required.
+	inline void StoreUnaligned(float* aDestination) const;
+/// @brief Writes the four components to a 16-byte aligned pointer.
+	inline void StoreAligned(float* aDestination) const;
+/**
+* @brief Writes the four components to a 16-byte aligned pointer, bypassing the cache.
+*
+* @details Non-temporal stores are weakly ordered, call BB::Simd::StreamFence() before other
+* threads read the data.
+*/
+	inline void StoreStream(float* aDestination) const;
+/** @} */
 };
 
 
@@ -110,7 +183,7 @@ public:
 * @return A bool depending if the two vectors are equal.
 * @relatesalso Vec4f
 */
-inline bool operator==(const Vec4f& aDataOne, const Vec4f& aDataTwo);
+constexpr bool operator==(const Vec4f& aDataOne, const Vec4f& aDataTwo);
 /**
 * @brief Not equal for vector4s.
 *
@@ -121,7 +194,7 @@ inline bool operator==(const Vec4f& aDataOne, const Vec4f& aDataTwo);
 * @return A bool depending if the two vectors are equal.
 * @relatesalso Vec4f
 */
-inline bool operator!=(const Vec4f& aDataOne, const Vec4f& aDataTwo);
+constexpr bool operator!=(const Vec4f& aDataOne, const Vec4f& aDataTwo);
 /**
 * @brief Negates the given 3D vector.
 *
@@ -129,7 +202,7 @@ inline bool operator!=(const Vec4f& aDataOne, const Vec4f& aDataTwo);
 * @return A new Vec3f where each component is the negation of the corresponding component in {@code aDataOne}.
 * @relatesalso Vec3f
 */
-inline Vec4f operator-(const Vec4f& aDataOne);
+constexpr Vec4f operator-(const Vec4f& aDataOne);
 
 /**
 * @brief Add for vector4s.
@@ -142,7 +215,7 @@ inline Vec4f operator-(const Vec4f& aDataOne);
 * @return A new Vec4f representing the sum of aDataOne and aDataTwo.
 * @relatesalso Vec4f
 */
-inline Vec4f operator+(const Vec4f& aDataOne, const Vec4f& aDataTwo);
+constexpr Vec4f operator+(const Vec4f& aDataOne, const Vec4f& aDataTwo);
 /**
  * @brief Subtract for vector4s.
  *
@@ -154,7 +227,7 @@ inline Vec4f operator+(const Vec4f& aDataOne, const Vec4f& aDataTwo);
  * @return A new Vec4f representing the difference of aDataOne and aDataTwo.
  * @relatesalso Vec4f
 */
-inline Vec4f operator-(const Vec4f& aDataOne, const Vec4f& aDataTwo);
+constexpr Vec4f operator-(const Vec4f& aDataOne, const Vec4f& aDataTwo);
 /**
 * @brief Multiplication for Vector4s.
 *
@@ -166,7 +239,7 @@ inline Vec4f operator-(const Vec4f& aDataOne, const Vec4f& aDataTwo);
 * @return A new Vec4f representing the sum of aDataOne and aDataTwo.
 * @relatesalso Vec4f
 */
-inline Vec4f operator*(const Vec4f& aDataOne, const Vec4f& aDataTwo);
+constexpr Vec4f operator*(const Vec4f& aDataOne, const Vec4f& aDataTwo);
 /**
 * @brief Multiplication for Vector4s.
 *
@@ -178,7 +251,7 @@ inline Vec4f operator*(const Vec4f& aDataOne, const Vec4f& aDataTwo);
 * @return A new Vec4f representing the sum of aDataOne by aScalar;
 * @relatesalso Vec4f
 */
-inline Vec4f operator*(const Vec4f& aDataOne, const float& aScalar);
+constexpr Vec4f operator*(const Vec4f& aDataOne, const float& aScalar);
 /**
 * @brief Multiplication for Vector4s.
 *
@@ -190,7 +263,7 @@ inline Vec4f operator*(const Vec4f& aDataOne, const float& aScalar);
 * @return A new Vec4f representing the sum of aDataOne by aScalar;
 * @relatesalso Vec4f
 */
-inline Vec4f operator*(const float& aScalar, const Vec4f& aDataTwo);
+constexpr Vec4f operator*(const float& aScalar, const Vec4f& aDataTwo);
 /**
 * @brief component-wise division for Vec4f.
 *
@@ -205,7 +278,7 @@ inline Vec4f operator*(const float& aScalar, const Vec4f& aDataTwo);
 * @note No division-by-zero checks are performed; ensure {@code aDataTwo} components are non-zero.
 * @relatesalso Vec4f
 */
-inline Vec4f operator/(const Vec4f& aDataOne, const Vec4f& aDataTwo);
+constexpr Vec4f operator/(const Vec4f& aDataOne, const Vec4f& aDataTwo);
 /**
 * @brief SIMD scalar division for Vec4f.
 *
@@ -218,7 +291,7 @@ inline Vec4f operator/(const Vec4f& aDataOne, const Vec4f& aDataTwo);
 * @note No division-by-zero checks are performed; ensure {@code aScalar} is non-zero.
 * @relatesalso Vec4f
 */
-inline Vec4f operator/(const Vec4f& aDataOne, const float& aScalar);
+constexpr Vec4f operator/(const Vec4f& aDataOne, const float& aScalar);
 
 /**
 * @brief Performs component-wise addition and assignment for Vec4f.
@@ -229,7 +302,7 @@ inline Vec4f operator/(const Vec4f& aDataOne, const float& aScalar);
 * @param aDataTwo The right-hand Vec4f to add.
 * @relates Vec4f
 */
-inline void operator+=(Vec4f& aDataOne, const Vec4f& aDataTwo); 
+constexpr void operator+=(Vec4f& aDataOne, const Vec4f& aDataTwo); 
 /**
 * @brief Performs component-wise subtraction and assignment for Vec4f.
 *
@@ -239,7 +312,7 @@ inline void operator+=(Vec4f& aDataOne, const Vec4f& aDataTwo);
 * @param aDataTwo The right-hand Vec4f to subtract (subtrahend).
 * @relates Vec4f
 */
-inline void operator-=(Vec4f& aDataOne, const Vec4f& aDataTwo); 
+constexpr void operator-=(Vec4f& aDataOne, const Vec4f& aDataTwo); 
 /**
 * @brief Performs component-wise multiplication and assignment for Vec4f.
 *
@@ -250,7 +323,7 @@ inline void operator-=(Vec4f& aDataOne, const Vec4f& aDataTwo);
 * @param aDataTwo The vector to multiply with (right-hand side).
 * @relates Vec4f
 */
-inline void operator*=(Vec4f& aDataOne, const Vec4f& aDataTwo); 
+constexpr void operator*=(Vec4f& aDataOne, const Vec4f& aDataTwo); 
 /**
 * @brief Performs scalar multiplication and assignment for Vec3f.
 *
@@ -261,7 +334,7 @@ inline void operator*=(Vec4f& aDataOne, const Vec4f& aDataTwo);
 * @param aScalar The scalar float multiplier.
 * @relates Vec3f
 */
-inline void operator*=(Vec4f& aDataOne, const float& aScalar);
+constexpr void operator*=(Vec4f& aDataOne, const float& aScalar);
 /**
  * @brief Performs component-wise division and assignment for Vec4f.
  *
@@ -274,7 +347,7 @@ inline void operator*=(Vec4f& aDataOne, const float& aScalar);
  *
  * @note No division-by-zero checks are performed. Ensure components of @p aDataTwo are non-zero.
  */
-inline void operator/=(Vec4f& aDataOne, const Vec4f& aDataTwo);   
+constexpr void operator/=(Vec4f& aDataOne, const Vec4f& aDataTwo);   
 /**
 * @brief Performs scalar division and assignment for Vec3f.
 *
@@ -287,7 +360,125 @@ inline void operator/=(Vec4f& aDataOne, const Vec4f& aDataTwo);
 *
 * @warning No division-by-zero checks are performed. Ensure @p aScalar is non-zero.
 */
-inline void operator/=(Vec4f& aDataOne, const float& aScalar);
+constexpr void operator/=(Vec4f& aDataOne, const float& aScalar);
+
+/** @} */
+
+/**
+* @name Fused arithmetic
+* @brief Multiply-add style functions for Vec4f.
+*
+* @details These map to a single FMA3 instruction when BB_USE_FMA is defined (see Intrinsics.h)
+* and to a multiply followed by an add otherwise. Fused results are rounded once, so they can
+* differ from the equivalent operator expression in the last bit.
+* @{
+*/
+/**
+* @brief Computes (aFactorOne * aFactorTwo) + aAddend component-wise.
+* @relatesalso Vec4f
+*/
+inline Vec4f MulAdd(const Vec4f& aFactorOne, const Vec4f& aFactorTwo, const Vec4f& aAddend);
+/**
+* @brief Computes (aFactorOne * aScalar) + aAddend component-wise.
+* @relatesalso Vec4f
+*/
+inline Vec4f MulAdd(const Vec4f& aFactorOne, float aScalar, const Vec4f& aAddend);
+/**
+* @brief Computes (aFactorOne * aFactorTwo) - aSubtrahend component-wise.
+* @relatesalso Vec4f
+*/
+inline Vec4f MulSub(const Vec4f& aFactorOne, const Vec4f& aFactorTwo, const Vec4f& aSubtrahend);
+/**
+* @brief Computes (aFactorOne * aScalar) - aSubtrahend component-wise.
+* @relatesalso Vec4f
+*/
+inline Vec4f MulSub(const Vec4f& aFactorOne, float aScalar, const Vec4f& aSubtrahend);
+/**
+* @brief Computes aAddend - (aFactorOne * aFactorTwo) component-wise.
+* @relatesalso Vec4f
+*/
+inline Vec4f NegMulAdd(const Vec4f& aFactorOne, const Vec4f& aFactorTwo, const Vec4f& aAddend);
+/**
+* @brief Computes aAddend - (aFactorOne * aScalar) component-wise.
+* @relatesalso Vec4f
+*/
+inline Vec4f NegMulAdd(const Vec4f& aFactorOne, float aScalar, const Vec4f& aAddend);
+/**
+* @brief Linear interpolation between two vectors.
+*
+* @param aFrom Result for aT = 0.
+* @param aTo Result for aT = 1.
+* @param aT Interpolation factor, values outside [0, 1] extrapolate.
+* @relatesalso Vec4f
+*/
+inline Vec4f Lerp(const Vec4f& aFrom, const Vec4f& aTo, float aT);
+
+/** @} */
+/**
+* @name Fast division
+* @brief Division through the rcpps estimate, aRefinements as for Vec4f::GetNormalizedFast.
+*
+* @details Meant for lighting and particle code that tolerates about 1e-4 error, where the
+* divider throughput of operator/ is the bottleneck. Divisors of magnitude 2^126 or more give 0.
+* @{
+*/
+template<int aRefinements = BB_FAST_MATH_REFINEMENTS>
+inline Vec4f DivideFast(const Vec4f& aDataOne, const Vec4f& aDataTwo);
+template<int aRefinements = BB_FAST_MATH_REFINEMENTS>
+inline Vec4f DivideFast(const Vec4f& aDataOne, float aScalar);
+/** @} */
+
+/**
+* @name Validity
+* @brief Branch-free NaN and infinity queries for Vec4f.
+* @{
+*/
+/// @brief All bits set in components that are neither infinite nor NaN, usable with Select.
+inline Vec4f FiniteMask(const Vec4f& aVector);
+/// @brief True if no component is infinite or NaN.
+inline bool IsFinite(const Vec4f& aVector);
+/// @brief Replaces infinite and NaN components with the matching component of aReplacement.
+inline Vec4f Sanitize(const Vec4f& aVector, const Vec4f& aReplacement);
+/** @} */
 
+/**
+* @name Component-wise
+* @brief Min, max, rounding and selection for Vec4f, each a few instructions that stay in the register.
+*
+* @details Min and Max follow minps/maxps, when a component is NaN the second operand is returned.
+* The mask functions set all bits of a component where the comparison holds and are meant for
+* Select, which takes aIfTrue where the sign bit of the mask component is set.
+* @{
+*/
+inline Vec4f Min(const Vec4f& aDataOne, const Vec4f& aDataTwo);
+inline Vec4f Max(const Vec4f& aDataOne, const Vec4f& aDataTwo);
+inline Vec4f Abs(const Vec4f& aVector);
+/// @brief Clamps each component to [aMin, aMax], NaN components become aMin.
+inline Vec4f Clamp(const Vec4f& aVector, const Vec4f& aMin, const Vec4f& aMax);
+inline Vec4f Clamp(const Vec4f& aVector, float aMin, float aMax);
+inline Vec4f Floor(const Vec4f& aVector);
+inline Vec4f Ceil(const Vec4f& aVector);
+/// @brief -1, 0 or +1 per component, zero and NaN give 0.
+inline Vec4f Sign(const Vec4f& aVector);
+/// @brief Interpolates each component with its own factor.
+inline Vec4f Lerp(const Vec4f& aFrom, const Vec4f& aTo, const Vec4f& aT);
+inline Vec4f Select(const Vec4f& aMask, const Vec4f& aIfTrue, const Vec4f& aIfFalse);
+inline Vec4f LessMask(const Vec4f& aDataOne, const Vec4f& aDataTwo);
+inline Vec4f LessEqualMask(const Vec4f& aDataOne, const Vec4f& aDataTwo);
+inline Vec4f GreaterMask(const Vec4f& aDataOne, const Vec4f& aDataTwo);
+inline Vec4f GreaterEqualMask(const Vec4f& aDataOne, const Vec4f& aDataTwo);
+inline Vec4f EqualMask(const Vec4f& aDataOne, const Vec4f& aDataTwo);
 /** @} */
-#include "Vector4f.inl" 
\ No newline at end of file
+
+#include "Vector4f.inl"
+
+namespace BitBloom
+{
+/// @brief Compile-time constants, built through the constexpr constructors.
+	inline constexpr Vec4f VEC4F_ZERO(0.0f, 0.0f, 0.0f, 0.0f);
+	inline constexpr Vec4f VEC4F_ONE(1.0f, 1.0f, 1.0f, 1.0f);
+	inline constexpr Vec4f VEC4F_UNIT_X(1.0f, 0.0f, 0.0f, 0.0f);
+	inline constexpr Vec4f VEC4F_UNIT_Y(0.0f, 1.0f, 0.0f, 0.0f);
+	inline constexpr Vec4f VEC4F_UNIT_Z(0.0f, 0.0f, 1.0f, 0.0f);
+	inline constexpr Vec4f VEC4F_UNIT_W(0.0f, 0.0f, 0.0f, 1.0f);
+} 
\ No newline at end of file
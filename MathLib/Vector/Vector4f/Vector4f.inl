@@ -5,8 +5,12 @@
 
 #pragma region ClassFunctions
 
-inline float Vec4f::LengthSqr()
+constexpr float Vec4f::LengthSqr() const
 {
+	if (std::is_constant_evaluated())
+	{
+		return Dot(*this);
+	}
 	__m128 result = _mm_mul_ps(data, data);
 	//Adds each pair togeter
 	result = _mm_hadd_ps(result, result);
@@ -25,95 +29,377 @@ inline float Vec4f::Length()
 
 inline Vec4f Vec4f::GetNormalized() 
 {
-	return _mm_div_ps(data, _mm_set1_ps(Length()));  
+	// 0xFF sums all four lanes and broadcasts the result, so the length never leaves the register
+	Vec4f result = _mm_div_ps(data, _mm_sqrt_ps(_mm_dp_ps(data, data, 0xFF)));
+	BB_VALIDATE(IsFinite(result), "GetNormalized on a zero, infinite or NaN vector, see GetSafeNormalized");
+	return result;
 }
 
 inline void Vec4f::Normalize()
 {
-	data = _mm_div_ps(data, _mm_set1_ps(Length())); 
+	*this = GetNormalized();
 }
 
-inline float Vec4f::Dot(const Vec4f& aVector)
+inline Vec4f Vec4f::GetSafeNormalized(const Vec4f& aFallback) const
 {
+	const __m128 lengthSqr = _mm_dp_ps(data, data, 0xFF);
+	// NaN fails both compares, so zero, infinite and NaN lengths all select the fallback
+	const __m128 valid = _mm_and_ps(_mm_cmpgt_ps(lengthSqr, _mm_setzero_ps()), _mm_cmplt_ps(lengthSqr, _mm_set1_ps(INFINITY)));
+	return BB::Simd::Select(valid, _mm_div_ps(data, _mm_sqrt_ps(lengthSqr)), aFallback.data);
+}
+
+inline void Vec4f::SafeNormalize(const Vec4f& aFallback)
+{
+	data = GetSafeNormalized(aFallback).data;
+}
+
+constexpr float Vec4f::Dot(const Vec4f& aVector) const
+{
+	if (std::is_constant_evaluated())
+	{
+		const float* a = lanes.value;
+		const float* b = aVector.lanes.value;
+		return a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3];
+	}
 	return _mm_cvtss_f32(_mm_dp_ps(data, aVector.data, 0xF1));  
 }
 
+inline Vec4f Vec4f::LoadUnaligned(const float* aSource)
+{
+	return _mm_loadu_ps(aSource);
+}
+
+inline Vec4f Vec4f::LoadAligned(const float* aSource)
+{
+	return _mm_load_ps(aSource);
+}
+
+inline void Vec4f::StoreUnaligned(float* aDestination) const
+{
+	_mm_storeu_ps(aDestination, data);
+}
+
+inline void Vec4f::StoreAligned(float* aDestination) const
+{
+	_mm_store_ps(aDestination, data);
+}
+
+inline void Vec4f::StoreStream(float* aDestination) const
+{
+	_mm_stream_ps(aDestination, data);
+}
+
 #pragma endregion ClassFunctions
 #pragma region OperatorDefinitions
 
-inline bool operator==(const Vec4f& aDataOne, const Vec4f& aDataTwo)
+// Each operator has a scalar branch over Vec4f::lanes that is only taken during constant evaluation.
+
+constexpr bool operator==(const Vec4f& aDataOne, const Vec4f& aDataTwo)
 {
+	if (std::is_constant_evaluated())
+	{
+		const float* a = aDataOne.lanes.value;
+		const float* b = aDataTwo.lanes.value;
+		return a[0] == b[0] && a[1] == b[1] && a[2] == b[2] && a[3] == b[3];
+	}
 	return _mm_movemask_ps(_mm_cmpeq_ps(aDataOne.data, aDataTwo.data)) == 0xF; 
 }
 
-inline bool operator!=(const Vec4f& aDataOne, const Vec4f& aDataTwo)
+constexpr bool operator!=(const Vec4f& aDataOne, const Vec4f& aDataTwo)
 {
+	if (std::is_constant_evaluated())
+	{
+		return !(aDataOne == aDataTwo);
+	}
 	return _mm_movemask_ps(_mm_cmpeq_ps(aDataOne.data, aDataTwo.data)) != 0xF; 
 }
 
-inline Vec4f operator-(const Vec4f& aDataOne)
+constexpr Vec4f operator-(const Vec4f& aDataOne)
 {
+	if (std::is_constant_evaluated())
+	{
+		const float* a = aDataOne.lanes.value;
+		return Vec4f(-a[0], -a[1], -a[2], -a[3]);
+	}
 	return _mm_xor_ps(aDataOne.data, _mm_set1_ps(-0.0f)); 
 }
-inline Vec4f operator+(const Vec4f& aDataOne, const Vec4f& aDataTwo)
+
+constexpr Vec4f operator+(const Vec4f& aDataOne, const Vec4f& aDataTwo)
 {
+	if (std::is_constant_evaluated())
+	{
+		const float* a = aDataOne.lanes.value;
+		const float* b = aDataTwo.lanes.value;
+		return Vec4f(a[0] + b[0], a[1] + b[1], a[2] + b[2], a[3] + b[3]);
+	}
 	return _mm_add_ps(aDataOne.data, aDataTwo.data);
 }
-inline Vec4f operator-(const Vec4f& aDataOne, const Vec4f& aDataTwo)
+
+constexpr Vec4f operator-(const Vec4f& aDataOne, const Vec4f& aDataTwo)
 {
+	if (std::is_constant_evaluated())
+	{
+		const float* a = aDataOne.lanes.value;
+		const float* b = aDataTwo.lanes.value;
+		return Vec4f(a[0] - b[0], a[1] - b[1], a[2] - b[2], a[3] - b[3]);
+	}
 	return _mm_sub_ps(aDataOne.data, aDataTwo.data);
 }
-inline Vec4f operator*(const Vec4f& aDataOne, const Vec4f& aDataTwo)
+
+constexpr Vec4f operator*(const Vec4f& aDataOne, const Vec4f& aDataTwo)
 {
+	if (std::is_constant_evaluated())
+	{
+		const float* a = aDataOne.lanes.value;
+		const float* b = aDataTwo.lanes.value;
+		return Vec4f(a[0] * b[0], a[1] * b[1], a[2] * b[2], a[3] * b[3]);
+	}
 	return _mm_mul_ps(aDataOne.data, aDataTwo.data);
 }
-inline Vec4f operator*(const Vec4f& aDataOne, const float& aScalar)
+
+constexpr Vec4f operator*(const Vec4f& aDataOne, const float& aScalar)
 {
+	if (std::is_constant_evaluated())
+	{
+		return aDataOne * Vec4f(aScalar);
+	}
 	return _mm_mul_ps(aDataOne.data, _mm_set1_ps(aScalar)); 
 }
-inline Vec4f operator*(const float& aScalar, const Vec4f& aDataTwo)
+
+constexpr Vec4f operator*(const float& aScalar, const Vec4f& aDataTwo)
 {
+	if (std::is_constant_evaluated())
+	{
+		return Vec4f(aScalar) * aDataTwo;
+	}
 	return _mm_mul_ps(_mm_set1_ps(aScalar), aDataTwo.data);
 }
 
-inline Vec4f operator/(const Vec4f& aDataOne, const Vec4f& aDataTwo)
+constexpr Vec4f operator/(const Vec4f& aDataOne, const Vec4f& aDataTwo)
 {
+	if (std::is_constant_evaluated())
+	{
+		const float* a = aDataOne.lanes.value;
+		const float* b = aDataTwo.lanes.value;
+		return Vec4f(a[0] / b[0], a[1] / b[1], a[2] / b[2], a[3] / b[3]);
+	}
+	BB_VALIDATE(_mm_movemask_ps(_mm_cmpeq_ps(aDataTwo.data, _mm_setzero_ps())) == 0, "Vec4f divided by a vector with a zero component");
 	return _mm_div_ps(aDataOne.data, aDataTwo.data);
 }
 
-inline Vec4f operator/(const Vec4f& aDataOne, const float& aScalar)
+constexpr Vec4f operator/(const Vec4f& aDataOne, const float& aScalar)
 {
+	if (std::is_constant_evaluated())
+	{
+		return aDataOne / Vec4f(aScalar);
+	}
+	BB_VALIDATE(aScalar != 0.0f, "Vec4f divided by zero");
 	return _mm_div_ps(aDataOne.data, _mm_set1_ps(aScalar));
 }
 
-inline void operator+=(Vec4f& aDataOne, const Vec4f& aDataTwo)
+constexpr void operator+=(Vec4f& aDataOne, const Vec4f& aDataTwo)
+{
+	aDataOne = aDataOne + aDataTwo;
+}
+
+constexpr void operator-=(Vec4f& aDataOne, const Vec4f& aDataTwo)
+{
+	aDataOne = aDataOne - aDataTwo;
+}
+
+constexpr void operator*=(Vec4f& aDataOne, const Vec4f& aDataTwo)
+{
+	aDataOne = aDataOne * aDataTwo;
+}
+
+constexpr void operator*=(Vec4f& aDataOne, const float& aScalar)
+{
+	aDataOne = aDataOne * aScalar;
+}
+
+constexpr void operator/=(Vec4f& aDataOne, const Vec4f& aDataTwo)
+{
+	aDataOne = aDataOne / aDataTwo;
+}
+
+constexpr void operator/=(Vec4f& aDataOne, const float& aScalar)
+{
+	aDataOne = aDataOne / aScalar;
+}
+
+#pragma endregion OperatorDefinitions
+
+#pragma region FusedArithmetic
+
+inline Vec4f MulAdd(const Vec4f& aFactorOne, const Vec4f& aFactorTwo, const Vec4f& aAddend)
+{
+	return BB::Simd::MulAdd(aFactorOne.data, aFactorTwo.data, aAddend.data);
+}
+
+inline Vec4f MulAdd(const Vec4f& aFactorOne, float aScalar, const Vec4f& aAddend)
+{
+	return BB::Simd::MulAdd(aFactorOne.data, _mm_set1_ps(aScalar), aAddend.data);
+}
+
+inline Vec4f MulSub(const Vec4f& aFactorOne, const Vec4f& aFactorTwo, const Vec4f& aSubtrahend)
+{
+	return BB::Simd::MulSub(aFactorOne.data, aFactorTwo.data, aSubtrahend.data);
+}
+
+inline Vec4f MulSub(const Vec4f& aFactorOne, float aScalar, const Vec4f& aSubtrahend)
+{
+	return BB::Simd::MulSub(aFactorOne.data, _mm_set1_ps(aScalar), aSubtrahend.data);
+}
+
+inline Vec4f NegMulAdd(const Vec4f& aFactorOne, const Vec4f& aFactorTwo, const Vec4f& aAddend)
+{
+	return BB::Simd::NegMulAdd(aFactorOne.data, aFactorTwo.data, aAddend.data);
+}
+
+inline Vec4f NegMulAdd(const Vec4f& aFactorOne, float aScalar, const Vec4f& aAddend)
+{
+	return BB::Simd::NegMulAdd(aFactorOne.data, _mm_set1_ps(aScalar), aAddend.data);
+}
+
+inline Vec4f Lerp(const Vec4f& aFrom, const Vec4f& aTo, float aT)
+{
+	return BB::Simd::Lerp(aFrom.data, aTo.data, _mm_set1_ps(aT));
+}
+
+#pragma endregion FusedArithmetic
+
+#pragma region Validity
+
+inline Vec4f FiniteMask(const Vec4f& aVector)
+{
+	return BB::Simd::FiniteMask(aVector.data);
+}
+
+inline bool IsFinite(const Vec4f& aVector)
+{
+	return _mm_movemask_ps(BB::Simd::FiniteMask(aVector.data)) == 0xF;
+}
+
+inline Vec4f Sanitize(const Vec4f& aVector, const Vec4f& aReplacement)
+{
+	return BB::Simd::Select(BB::Simd::FiniteMask(aVector.data), aVector.data, aReplacement.data);
+}
+
+#pragma endregion Validity
+
+#pragma region FastApproximation
+
+template<int aRefinements>
+inline float Vec4f::LengthFast() const
+{
+	const __m128 lengthSqr = _mm_dp_ps(data, data, 0xFF);
+	// sqrt(x) = x * rsqrt(x), the mask turns 0 * infinity into 0 for zero vectors
+	const __m128 length = _mm_mul_ps(lengthSqr, BB::Simd::ReciprocalSqrt<aRefinements>(lengthSqr));
+	return _mm_cvtss_f32(_mm_and_ps(length, _mm_cmpgt_ps(lengthSqr, _mm_setzero_ps())));
+}
+
+template<int aRefinements>
+inline Vec4f Vec4f::GetNormalizedFast() const
+{
+	return _mm_mul_ps(data, BB::Simd::ReciprocalSqrt<aRefinements>(_mm_dp_ps(data, data, 0xFF)));
+}
+
+template<int aRefinements>
+inline void Vec4f::NormalizeFast()
+{
+	data = GetNormalizedFast<aRefinements>().data;
+}
+
+template<int aRefinements>
+inline Vec4f DivideFast(const Vec4f& aDataOne, const Vec4f& aDataTwo)
+{
+	__m128 result = _mm_mul_ps(aDataOne.data, BB::Simd::Reciprocal<aRefinements>(aDataTwo.data));
+	return result;
+}
+
+template<int aRefinements>
+inline Vec4f DivideFast(const Vec4f& aDataOne, float aScalar)
+{
+	return _mm_mul_ps(aDataOne.data, BB::Simd::Reciprocal<aRefinements>(_mm_set1_ps(aScalar)));
+}
+
+#pragma endregion FastApproximation
+
+#pragma region ComponentWise
+
+inline Vec4f Min(const Vec4f& aDataOne, const Vec4f& aDataTwo)
+{
+	return _mm_min_ps(aDataOne.data, aDataTwo.data);
+}
+
+inline Vec4f Max(const Vec4f& aDataOne, const Vec4f& aDataTwo)
+{
+	return _mm_max_ps(aDataOne.data, aDataTwo.data);
+}
+
+inline Vec4f Abs(const Vec4f& aVector)
+{
+	return BB::Simd::Abs(aVector.data);
+}
+
+inline Vec4f Clamp(const Vec4f& aVector, const Vec4f& aMin, const Vec4f& aMax)
+{
+	return BB::Simd::Clamp(aVector.data, aMin.data, aMax.data);
+}
+
+inline Vec4f Clamp(const Vec4f& aVector, float aMin, float aMax)
+{
+	return BB::Simd::Clamp(aVector.data, Vec4f(aMin).data, Vec4f(aMax).data);
+}
+
+inline Vec4f Floor(const Vec4f& aVector)
+{
+	return _mm_floor_ps(aVector.data);
+}
+
+inline Vec4f Ceil(const Vec4f& aVector)
+{
+	return _mm_ceil_ps(aVector.data);
+}
+
+inline Vec4f Sign(const Vec4f& aVector)
+{
+	return BB::Simd::Sign(aVector.data);
+}
+
+inline Vec4f Lerp(const Vec4f& aFrom, const Vec4f& aTo, const Vec4f& aT)
+{
+	return BB::Simd::Lerp(aFrom.data, aTo.data, aT.data);
+}
+
+inline Vec4f Select(const Vec4f& aMask, const Vec4f& aIfTrue, const Vec4f& aIfFalse)
 {
-	aDataOne.data = _mm_add_ps(aDataOne.data, aDataTwo.data);
+	return BB::Simd::Select(aMask.data, aIfTrue.data, aIfFalse.data);
 }
 
-inline void operator-=(Vec4f& aDataOne, const Vec4f& aDataTwo)
+inline Vec4f LessMask(const Vec4f& aDataOne, const Vec4f& aDataTwo)
 {
-	aDataOne.data = _mm_sub_ps(aDataOne.data, aDataTwo.data);
+	return _mm_cmplt_ps(aDataOne.data, aDataTwo.data);
 }
 
-inline void operator*=(Vec4f& aDataOne, const Vec4f& aDataTwo)
+inline Vec4f LessEqualMask(const Vec4f& aDataOne, const Vec4f& aDataTwo)
 {
-	aDataOne.data = _mm_mul_ps(aDataOne.data, aDataTwo.data);
+	return _mm_cmple_ps(aDataOne.data, aDataTwo.data);
 }
 
-inline void operator*=(Vec4f& aDataOne, const float& aScalar)
+inline Vec4f GreaterMask(const Vec4f& aDataOne, const Vec4f& aDataTwo)
 {
-	aDataOne.data = _mm_mul_ps(aDataOne.data, _mm_set1_ps(aScalar));
+	return _mm_cmpgt_ps(aDataOne.data, aDataTwo.data);
 }
 
-inline void operator/=(Vec4f& aDataOne, const Vec4f& aDataTwo)
+inline Vec4f GreaterEqualMask(const Vec4f& aDataOne, const Vec4f& aDataTwo)
 {
-	aDataOne.data = _mm_div_ps(aDataOne.data, aDataTwo.data);
+	return _mm_cmpge_ps(aDataOne.data, aDataTwo.data);
 }
 
-inline void operator/=(Vec4f& aDataOne, const float& aScalar)
+inline Vec4f EqualMask(const Vec4f& aDataOne, const Vec4f& aDataTwo)
 {
-	aDataOne.data = _mm_div_ps(aDataOne.data, _mm_set1_ps(aScalar));
+	return _mm_cmpeq_ps(aDataOne.data, aDataTwo.data);
 }
 
-#pragma endregion OperatorDefinitions
\ No newline at end of file
+#pragma endregion ComponentWise
@@ -0,0 +1,127 @@
+#pragma once
+#include <cstdint>
+#include <immintrin.h>
+#include "../../Util/Intrinsics.h"
+#include "../Vector4f/Vector4f.h"
+
+/**
+ * @brief Vec4i is a SIMD integer vector aligned to 16 bytes, the four component counterpart of Vec3i.
+ *
+ * @details The vector stores data in a 128-bit SSE register (__m128i) as four int32_t, components
+ * can be accessed via {@code x}, {@code y}, {@code z} and {@code w}.
+ *
+ * @warning Arithmetic wraps on overflow, converting floats outside the int32_t range gives INT32_MIN.
+ */
+class Vec4i
+{
+public:
+	union
+	{
+		__m128i data;
+		struct { int32_t x, y, z, w; };
+		/// @brief Scalar view used by the constexpr code path.
+		BB::ScalarLanes<4, int32_t> lanes;
+	};
+
+/**
+* @name Constructors
+* @brief Ways to initialize an instance of Vec4i.
+* @{
+*/
+/// @brief Default constructor. Initializes all components to zero.
+	constexpr Vec4i() : Vec4i(0, 0, 0, 0) {};
+/// @brief Copy constructor. Can use Vec4i or a __m128i to copy the data.
+	Vec4i(const __m128i& aSSEData) : data(aSSEData) {};
+/// @brief Initializes all components (x, y, z, w) to the same value.
+	constexpr Vec4i(int32_t aScalar) : Vec4i(aScalar, aScalar, aScalar, aScalar) {};
+/// @brief Initializes Vec4i with individual x, y, z, w values, usable in constant expressions.
+	constexpr Vec4i(int32_t aX, int32_t aY, int32_t aZ, int32_t aW)
+	{
+		if (std::is_constant_evaluated())
+		{
+			lanes = BB::ScalarLanes<4, int32_t>{ { aX, aY, aZ, aW } };
+		}
+		else
+		{
+			data = _mm_set_epi32(aW, aZ, aY, aX);
+		}
+	};
+/** @} */
+
+/**
+* @name Conversion
+* @brief Float to integer conversions, all of them done in the SSE register.
+* @{
+*/
+/// @brief Rounds each component towards negative infinity.
+	static inline Vec4i Floor(const Vec4f& aVector);
+/// @brief Rounds each component to the nearest integer, halfway cases go to the even integer.
+	static inline Vec4i Round(const Vec4f& aVector);
+/// @brief Rounds each component towards zero, the same as a static_cast per component.
+	static inline Vec4i Truncate(const Vec4f& aVector);
+/// @brief Converts the components to float, exact up to 2^24.
+	inline Vec4f ToVec4f() const;
+/** @} */
+
+/**
+* @name Load and store
+* @brief Moving a Vec4i between the register and plain int32_t memory.
+* @{
+*/
+	static inline Vec4i LoadUnaligned(const int32_t* aSource);
+/// @brief Loads four values from a 16-byte aligned pointer.
+	static inline Vec4i LoadAligned(const int32_t* aSource);
+	inline void StoreUnaligned(int32_t* aDestination) const;
+/// @brief Writes the four components to a 16-byte aligned pointer.
+	inline void StoreAligned(int32_t* aDestination) const;
+/** @} */
+};
+
+/**
+* @name Operators
+* @brief Vec4i operators, component-wise like the Vec3i operators.
+* @{
+*/
+constexpr bool operator==(const Vec4i& aDataOne, const Vec4i& aDataTwo);
+constexpr bool operator!=(const Vec4i& aDataOne, const Vec4i& aDataTwo);
+constexpr Vec4i operator-(const Vec4i& aDataOne);
+constexpr Vec4i operator+(const Vec4i& aDataOne, const Vec4i& aDataTwo);
+constexpr Vec4i operator-(const Vec4i& aDataOne, const Vec4i& aDataTwo);
+/// @brief Keeps the low 32 bits of each product.
+constexpr Vec4i operator*(const Vec4i& aDataOne, const Vec4i& aDataTwo);
+constexpr Vec4i operator*(const Vec4i& aDataOne, const int32_t& aScalar);
+constexpr Vec4i operator*(const int32_t& aScalar, const Vec4i& aDataOne);
+constexpr Vec4i operator&(const Vec4i& aDataOne, const Vec4i& aDataTwo);
+constexpr Vec4i operator|(const Vec4i& aDataOne, const Vec4i& aDataTwo);
+constexpr Vec4i operator^(const Vec4i& aDataOne, const Vec4i& aDataTwo);
+constexpr Vec4i operator<<(const Vec4i& aDataOne, int aShift);
+/// @brief Arithmetic shift, the sign is kept.
+constexpr Vec4i operator>>(const Vec4i& aDataOne, int aShift);
+constexpr void operator+=(Vec4i& aDataOne, const Vec4i& aDataTwo);
+constexpr void operator-=(Vec4i& aDataOne, const Vec4i& aDataTwo);
+constexpr void operator*=(Vec4i& aDataOne, const Vec4i& aDataTwo);
+constexpr void operator*=(Vec4i& aDataOne, const int32_t& aScalar);
+constexpr void operator<<=(Vec4i& aDataOne, int aShift);
+constexpr void operator>>=(Vec4i& aDataOne, int aShift);
+/** @} */
+
+/**
+* @name Min, max and comparisons
+* @brief The comparisons return one bit per component, bit 0 for x, so {@code == 0xF} means all four.
+* @{
+*/
+inline Vec4i Min(const Vec4i& aDataOne, const Vec4i& aDataTwo);
+inline Vec4i Max(const Vec4i& aDataOne, const Vec4i& aDataTwo);
+inline int CompareEqual(const Vec4i& aDataOne, const Vec4i& aDataTwo);
+inline int CompareLess(const Vec4i& aDataOne, const Vec4i& aDataTwo);
+inline int CompareGreater(const Vec4i& aDataOne, const Vec4i& aDataTwo);
+/** @} */
+
+#include "Vector4i.inl"
+
+namespace BitBloom
+{
+/// @brief Compile-time constants, built through the constexpr constructors.
+	inline constexpr Vec4i VEC4I_ZERO(0, 0, 0, 0);
+	inline constexpr Vec4i VEC4I_ONE(1, 1, 1, 1);
+}
@@ -0,0 +1,238 @@
+#pragma once
+#include "Vector4i.h"
+
+#pragma region ClassFunctions
+
+inline Vec4i Vec4i::Floor(const Vec4f& aVector)
+{
+	return _mm_cvttps_epi32(_mm_floor_ps(aVector.data));
+}
+
+inline Vec4i Vec4i::Round(const Vec4f& aVector)
+{
+	// Uses the MXCSR rounding mode, round to nearest even unless the application changed it
+	return _mm_cvtps_epi32(aVector.data);
+}
+
+inline Vec4i Vec4i::Truncate(const Vec4f& aVector)
+{
+	return _mm_cvttps_epi32(aVector.data);
+}
+
+inline Vec4f Vec4i::ToVec4f() const
+{
+	return _mm_cvtepi32_ps(data);
+}
+
+inline Vec4i Vec4i::LoadUnaligned(const int32_t* aSource)
+{
+	return _mm_loadu_si128(reinterpret_cast<const __m128i*>(aSource));
+}
+
+inline Vec4i Vec4i::LoadAligned(const int32_t* aSource)
+{
+	return _mm_load_si128(reinterpret_cast<const __m128i*>(aSource));
+}
+
+inline void Vec4i::StoreUnaligned(int32_t* aDestination) const
+{
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(aDestination), data);
+}
+
+inline void Vec4i::StoreAligned(int32_t* aDestination) const
+{
+	_mm_store_si128(reinterpret_cast<__m128i*>(aDestination), data);
+}
+
+#pragma endregion ClassFunctions
+
+#pragma region OperatorDefinitions
+
+// Each operator has a scalar branch over Vec4i::lanes that is only taken during constant evaluation.
+// The scalar branch goes through uint32_t where signed overflow would not be a constant expression.
+
+constexpr bool operator==(const Vec4i& aDataOne, const Vec4i& aDataTwo)
+{
+	if (std::is_constant_evaluated())
+	{
+		const int32_t* a = aDataOne.lanes.value;
+		const int32_t* b = aDataTwo.lanes.value;
+		return a[0] == b[0] && a[1] == b[1] && a[2] == b[2] && a[3] == b[3];
+	}
+	return _mm_movemask_epi8(_mm_cmpeq_epi32(aDataOne.data, aDataTwo.data)) == 0xFFFF;
+}
+
+constexpr bool operator!=(const Vec4i& aDataOne, const Vec4i& aDataTwo)
+{
+	return !(aDataOne == aDataTwo);
+}
+
+constexpr Vec4i operator-(const Vec4i& aDataOne)
+{
+	if (std::is_constant_evaluated())
+	{
+		return Vec4i(0) - aDataOne;
+	}
+	return _mm_sub_epi32(_mm_setzero_si128(), aDataOne.data);
+}
+
+constexpr Vec4i operator+(const Vec4i& aDataOne, const Vec4i& aDataTwo)
+{
+	if (std::is_constant_evaluated())
+	{
+		const int32_t* a = aDataOne.lanes.value;
+		const int32_t* b = aDataTwo.lanes.value;
+		return Vec4i(int32_t(uint32_t(a[0]) + uint32_t(b[0])), int32_t(uint32_t(a[1]) + uint32_t(b[1])), int32_t(uint32_t(a[2]) + uint32_t(b[2])), int32_t(uint32_t(a[3]) + uint32_t(b[3])));
+	}
+	return _mm_add_epi32(aDataOne.data, aDataTwo.data);
+}
+
+constexpr Vec4i operator-(const Vec4i& aDataOne, const Vec4i& aDataTwo)
+{
+	if (std::is_constant_evaluated())
+	{
+		const int32_t* a = aDataOne.lanes.value;
+		const int32_t* b = aDataTwo.lanes.value;
+		return Vec4i(int32_t(uint32_t(a[0]) - uint32_t(b[0])), int32_t(uint32_t(a[1]) - uint32_t(b[1])), int32_t(uint32_t(a[2]) - uint32_t(b[2])), int32_t(uint32_t(a[3]) - uint32_t(b[3])));
+	}
+	return _mm_sub_epi32(aDataOne.data, aDataTwo.data);
+}
+
+constexpr Vec4i operator*(const Vec4i& aDataOne, const Vec4i& aDataTwo)
+{
+	if (std::is_constant_evaluated())
+	{
+		const int32_t* a = aDataOne.lanes.value;
+		const int32_t* b = aDataTwo.lanes.value;
+		return Vec4i(int32_t(uint32_t(a[0]) * uint32_t(b[0])), int32_t(uint32_t(a[1]) * uint32_t(b[1])), int32_t(uint32_t(a[2]) * uint32_t(b[2])), int32_t(uint32_t(a[3]) * uint32_t(b[3])));
+	}
+	return _mm_mullo_epi32(aDataOne.data, aDataTwo.data);
+}
+
+constexpr Vec4i operator*(const Vec4i& aDataOne, const int32_t& aScalar)
+{
+	if (std::is_constant_evaluated())
+	{
+		return aDataOne * Vec4i(aScalar);
+	}
+	return _mm_mullo_epi32(aDataOne.data, _mm_set1_epi32(aScalar));
+}
+
+constexpr Vec4i operator*(const int32_t& aScalar, const Vec4i& aDataOne)
+{
+	return aDataOne * aScalar;
+}
+
+constexpr Vec4i operator&(const Vec4i& aDataOne, const Vec4i& aDataTwo)
+{
+	if (std::is_constant_evaluated())
+	{
+		const int32_t* a = aDataOne.lanes.value;
+		const int32_t* b = aDataTwo.lanes.value;
+		return Vec4i(a[0] & b[0], a[1] & b[1], a[2] & b[2], a[3] & b[3]);
+	}
+	return _mm_and_si128(aDataOne.data, aDataTwo.data);
+}
+
+constexpr Vec4i operator|(const Vec4i& aDataOne, const Vec4i& aDataTwo)
+{
+	if (std::is_constant_evaluated())
+	{
+		const int32_t* a = aDataOne.lanes.value;
+		const int32_t* b = aDataTwo.lanes.value;
+		return Vec4i(a[0] | b[0], a[1] | b[1], a[2] | b[2], a[3] | b[3]);
+	}
+	return _mm_or_si128(aDataOne.data, aDataTwo.data);
+}
+
+constexpr Vec4i operator^(const Vec4i& aDataOne, const Vec4i& aDataTwo)
+{
+	if (std::is_constant_evaluated())
+	{
+		const int32_t* a = aDataOne.lanes.value;
+		const int32_t* b = aDataTwo.lanes.value;
+		return Vec4i(a[0] ^ b[0], a[1] ^ b[1], a[2] ^ b[2], a[3] ^ b[3]);
+	}
+	return _mm_xor_si128(aDataOne.data, aDataTwo.data);
+}
+
+constexpr Vec4i operator<<(const Vec4i& aDataOne, int aShift)
+{
+	if (std::is_constant_evaluated())
+	{
+		const int32_t* a = aDataOne.lanes.value;
+		return Vec4i(int32_t(uint32_t(a[0]) << aShift), int32_t(uint32_t(a[1]) << aShift), int32_t(uint32_t(a[2]) << aShift), int32_t(uint32_t(a[3]) << aShift));
+	}
+	return _mm_sll_epi32(aDataOne.data, _mm_cvtsi32_si128(aShift));
+}
+
+constexpr Vec4i operator>>(const Vec4i& aDataOne, int aShift)
+{
+	if (std::is_constant_evaluated())
+	{
+		const int32_t* a = aDataOne.lanes.value;
+		return Vec4i(a[0] >> aShift, a[1] >> aShift, a[2] >> aShift, a[3] >> aShift);
+	}
+	return _mm_sra_epi32(aDataOne.data, _mm_cvtsi32_si128(aShift));
+}
+
+constexpr void operator+=(Vec4i& aDataOne, const Vec4i& aDataTwo)
+{
+	aDataOne = aDataOne + aDataTwo;
+}
+
+constexpr void operator-=(Vec4i& aDataOne, const Vec4i& aDataTwo)
+{
+	aDataOne = aDataOne - aDataTwo;
+}
+
+constexpr void operator*=(Vec4i& aDataOne, const Vec4i& aDataTwo)
+{
+	aDataOne = aDataOne * aDataTwo;
+}
+
+constexpr void operator*=(Vec4i& aDataOne, const int32_t& aScalar)
+{
+	aDataOne = aDataOne * aScalar;
+}
+
+constexpr void operator<<=(Vec4i& aDataOne, int aShift)
+{
+	aDataOne = aDataOne << aShift;
+}
+
+constexpr void operator>>=(Vec4i& aDataOne, int aShift)
+{
+	aDataOne = aDataOne >> aShift;
+}
+
+#pragma endregion OperatorDefinitions
+
+#pragma region Comparison
+
+inline Vec4i Min(const Vec4i& aDataOne, const Vec4i& aDataTwo)
+{
+	return _mm_min_epi32(aDataOne.data, aDataTwo.data);
+}
+
+inline Vec4i Max(const Vec4i& aDataOne, const Vec4i& aDataTwo)
+{
+	return _mm_max_epi32(aDataOne.data, aDataTwo.data);
+}
+
+inline int CompareEqual(const Vec4i& aDataOne, const Vec4i& aDataTwo)
+{
+	return _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(aDataOne.data, aDataTwo.data))) & 0xF;
+}
+
+inline int CompareLess(const Vec4i& aDataOne, const Vec4i& aDataTwo)
+{
+	return _mm_movemask_ps(_mm_castsi128_ps(_mm_cmplt_epi32(aDataOne.data, aDataTwo.data))) & 0xF;
+}
+
+inline int CompareGreater(const Vec4i& aDataOne, const Vec4i& aDataTwo)
+{
+	return _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(aDataOne.data, aDataTwo.data))) & 0xF;
+}
+
+#pragma endregion Comparison
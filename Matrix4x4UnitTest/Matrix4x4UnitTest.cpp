@@ -2,11 +2,54 @@
 #include "CppUnitTest.h"
 #include "../MathLib/Matrix/Matrix4x4f/Matrix4x4f.h"
 #include "../MathLib/Util/Random.h"
+#include "../MathLib/Util/CommonMath.h"
+#include "../MathLib/Bulk/Bulk.h"
+#include "../MathLib/Bulk/BulkParallel.h"
+
+#include <intrin.h>
+#include <vector>
+#include <cstdio>
+#include <cfloat>
+#include <algorithm>
+#include <cstddef>
+#include <chrono>
+#include <thread>
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 
+struct Vec4Ref { float v[4]; };
+
 namespace Matrix4x4f
 {
+	// Row vector times matrix, written out in scalar so it can be used as a reference
+	static Vec4Ref TransformReference(const Mat4x4f& aMatrix, float aX, float aY, float aZ, float aW)
+	{
+		Vec4Ref result;
+		for (int column = 0; column < 4; column++)
+		{
+			result.v[column] = aX * aMatrix.data[column] + aY * aMatrix.data[4 + column] + aZ * aMatrix.data[8 + column] + aW * aMatrix.data[12 + column];
+		}
+		return result;
+	}
+
+	static Mat4x4f MultiplyReference(const Mat4x4f& aMatrixOne, const Mat4x4f& aMatrixTwo)
+	{
+		Mat4x4f result;
+		for (int i = 0; i < 4; i++)
+		{
+			for (int j = 0; j < 4; j++)
+			{
+				float sum = 0.0f;
+				for (int k = 0; k < 4; k++)
+				{
+					sum += aMatrixOne.data[i * 4 + k] * aMatrixTwo.data[k * 4 + j];
+				}
+				result.data[i * 4 + j] = sum;
+			}
+		}
+		return result;
+	}
+
 	TEST_CLASS(Construction)
 	{
 	public:
@@ -201,7 +244,6 @@ namespace Matrix4x4f
 				Mat4x4f mat1;
 				Mat4x4f mat2;
 
-
 				float size = 1000.0f;
 				int runs = 1000;
 				for (int i = 0; i < runs; i++)
@@ -307,5 +349,855 @@ namespace Matrix4x4f
 				}
 			}
 		}
+
+		TEST_METHOD(MUL)
+		{
+			Mat4x4f mat1;
+			Mat4x4f mat2;
+
+			float size = 100.0f;
+			int runs = 1000;
+			for (int i = 0; i < runs; i++)
+			{
+				for (int j = 0; j < 16; j++)
+				{
+					mat1.data[j] = BB::Random(-size, size);
+					mat2.data[j] = BB::Random(-size, size);
+				}
+
+				Mat4x4f expected = MultiplyReference(mat1, mat2);
+
+				Mat4x4f resultMatrix = mat1 * mat2;
+				for (int j = 0; j < 16; j++)
+				{
+					Assert::AreEqual(expected.data[j], resultMatrix.data[j], 0.05f, L"Matrix multiplication is not done correctly");
+				}
+
+				Mat4x4f outMatrix;
+				Multiply(mat1, mat2, outMatrix);
+				Assert::IsTrue(outMatrix == resultMatrix, L"Multiply does not match operator*");
+
+				// Writing the result into the right operand must still read the original rows
+				Mat4x4f aliased = mat2;
+				Multiply(mat1, aliased, aliased);
+				Assert::IsTrue(aliased == resultMatrix, L"Multiply into the right operand is not done correctly");
+
+				mat1 *= mat2;
+				Assert::IsTrue(mat1 == resultMatrix, L"Matrix multiplication and assignment is not done correctly");
+			}
+
+			Mat4x4f translation({ 1.0f, 2.0f, 3.0f });
+			Mat4x4f identity;
+			Assert::IsTrue(translation * identity == translation, L"Multiplying with identity should not change the matrix");
+			Assert::IsTrue(identity * translation == translation, L"Multiplying with identity should not change the matrix");
+		}
+	};
+
+	TEST_CLASS(Camera)
+	{
+		TEST_METHOD(PerspectiveFov)
+		{
+			const float nearPlane = 0.1f;
+			const float farPlane = 1000.0f;
+			Mat4x4f projection = Mat4x4f::PerspectiveFov(90.0f * BB::DegToRad, 2.0f, nearPlane, farPlane);
+
+			Vec4Ref nearPoint = TransformReference(projection, 0.0f, 0.0f, nearPlane, 1.0f);
+			Vec4Ref farPoint = TransformReference(projection, 0.0f, 0.0f, farPlane, 1.0f);
+			Assert::AreEqual(0.0f, nearPoint.v[2] / nearPoint.v[3], 1e-5f, L"Near plane is not mapped to depth 0");
+			Assert::AreEqual(1.0f, farPoint.v[2] / farPoint.v[3], 1e-5f, L"Far plane is not mapped to depth 1");
+
+			// 90 degrees vertical fov puts y = z on the top edge, aspect 2 puts x = 2z on the right edge
+			Vec4Ref corner = TransformReference(projection, 20.0f, 10.0f, 10.0f, 1.0f);
+			Assert::AreEqual(1.0f, corner.v[0] / corner.v[3], 1e-5f, L"Aspect ratio is not applied correctly");
+			Assert::AreEqual(1.0f, corner.v[1] / corner.v[3], 1e-5f, L"Field of view is not applied correctly");
+		}
+
+		TEST_METHOD(PerspectiveFovReversedZ)
+		{
+			const float nearPlane = 0.5f;
+			const float farPlane = 500.0f;
+			Mat4x4f projection = Mat4x4f::PerspectiveFovReversedZ(60.0f * BB::DegToRad, 1.5f, nearPlane, farPlane);
+
+			Vec4Ref nearPoint = TransformReference(projection, 0.0f, 0.0f, nearPlane, 1.0f);
+			Vec4Ref farPoint = TransformReference(projection, 0.0f, 0.0f, farPlane, 1.0f);
+			Assert::AreEqual(1.0f, nearPoint.v[2] / nearPoint.v[3], 1e-5f, L"Near plane is not mapped to depth 1");
+			Assert::AreEqual(0.0f, farPoint.v[2] / farPoint.v[3], 1e-5f, L"Far plane is not mapped to depth 0");
+		}
+
+		TEST_METHOD(PerspectiveFovInfinite)
+		{
+			const float nearPlane = 0.1f;
+			Mat4x4f projection = Mat4x4f::PerspectiveFovInfinite(60.0f * BB::DegToRad, 1.0f, nearPlane);
+			Mat4x4f reversed = Mat4x4f::PerspectiveFovInfiniteReversedZ(60.0f * BB::DegToRad, 1.0f, nearPlane);
+
+			Vec4Ref nearPoint = TransformReference(projection, 0.0f, 0.0f, nearPlane, 1.0f);
+			Vec4Ref farPoint = TransformReference(projection, 0.0f, 0.0f, 1e7f, 1.0f);
+			Assert::AreEqual(0.0f, nearPoint.v[2] / nearPoint.v[3], 1e-5f, L"Near plane is not mapped to depth 0");
+			Assert::AreEqual(1.0f, farPoint.v[2] / farPoint.v[3], 1e-5f, L"Far away points are not mapped close to depth 1");
+
+			nearPoint = TransformReference(reversed, 0.0f, 0.0f, nearPlane, 1.0f);
+			farPoint = TransformReference(reversed, 0.0f, 0.0f, 1e7f, 1.0f);
+			Assert::AreEqual(1.0f, nearPoint.v[2] / nearPoint.v[3], 1e-5f, L"Near plane is not mapped to depth 1");
+			Assert::AreEqual(0.0f, farPoint.v[2] / farPoint.v[3], 1e-5f, L"Far away points are not mapped close to depth 0");
+		}
+
+		TEST_METHOD(Orthographic)
+		{
+			Mat4x4f projection = Mat4x4f::Orthographic(20.0f, 10.0f, 1.0f, 101.0f);
+
+			Vec4Ref corner = TransformReference(projection, 10.0f, -5.0f, 1.0f, 1.0f);
+			Assert::AreEqual(1.0f, corner.v[0], 1e-5f, L"Orthographic width is not applied correctly");
+			Assert::AreEqual(-1.0f, corner.v[1], 1e-5f, L"Orthographic height is not applied correctly");
+			Assert::AreEqual(0.0f, corner.v[2], 1e-5f, L"Near plane is not mapped to depth 0");
+			Assert::AreEqual(1.0f, corner.v[3], 1e-5f, L"Orthographic projection should keep w at 1");
+
+			Vec4Ref farPoint = TransformReference(projection, 0.0f, 0.0f, 101.0f, 1.0f);
+			Assert::AreEqual(1.0f, farPoint.v[2], 1e-5f, L"Far plane is not mapped to depth 1");
+		}
+
+		TEST_METHOD(LookAt)
+		{
+			Vec3f eye(5.0f, 2.0f, -3.0f);
+			Vec3f target(5.0f, 2.0f, 7.0f);
+			Mat4x4f view = Mat4x4f::LookAt(eye, target, { 0.0f, 1.0f, 0.0f });
+
+			Vec4Ref eyeInView = TransformReference(view, eye.x, eye.y, eye.z, 1.0f);
+			Assert::AreEqual(0.0f, eyeInView.v[0], 1e-5f, L"Eye is not placed at the origin of view space");
+			Assert::AreEqual(0.0f, eyeInView.v[1], 1e-5f, L"Eye is not placed at the origin of view space");
+			Assert::AreEqual(0.0f, eyeInView.v[2], 1e-5f, L"Eye is not placed at the origin of view space");
+
+			Vec4Ref targetInView = TransformReference(view, target.x, target.y, target.z, 1.0f);
+			Assert::AreEqual(0.0f, targetInView.v[0], 1e-5f, L"Target should be straight ahead");
+			Assert::AreEqual(0.0f, targetInView.v[1], 1e-5f, L"Target should be straight ahead");
+			Assert::AreEqual(10.0f, targetInView.v[2], 1e-4f, L"Target should be in front of the camera");
+
+			Vec4Ref right = TransformReference(view, 6.0f, 2.0f, -3.0f, 1.0f);
+			Assert::AreEqual(1.0f, right.v[0], 1e-5f, L"World +X should be to the right when looking down +Z");
+		}
+
+		TEST_METHOD(ViewFromTransform)
+		{
+			float size = 100.0f;
+			int runs = 100;
+			for (int i = 0; i < runs; i++)
+			{
+				Vec3f eye(BB::Random(-size, size), BB::Random(-size, size), BB::Random(-size, size));
+				Vec3f target(BB::Random(-size, size), BB::Random(-size, size), BB::Random(-size, size));
+				Mat4x4f view = Mat4x4f::LookAt(eye, target, { 0.0f, 1.0f, 0.0f });
+
+				// The camera transform has the camera basis as rows, which is the transposed rotation of the view
+				Mat4x4f cameraTransform = view;
+				cameraTransform.row[3] = _mm_set_ps(1, 0, 0, 0);
+				cameraTransform.Transpose();
+				cameraTransform.row[3] = _mm_set_ps(1, eye.z, eye.y, eye.x);
+
+				Mat4x4f result = Mat4x4f::ViewFromTransform(cameraTransform);
+				for (int j = 0; j < 16; j++)
+				{
+					Assert::AreEqual(view.data[j], result.data[j], 1e-3f, L"ViewFromTransform does not match LookAt");
+				}
+			}
+		}
+
+		TEST_METHOD(ViewProjection)
+		{
+			Mat4x4f view = Mat4x4f::LookAt({ 1.0f, 5.0f, -10.0f }, { 0.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f });
+			Mat4x4f projections[] = {
+				Mat4x4f::PerspectiveFov(70.0f * BB::DegToRad, 1.7f, 0.1f, 100.0f),
+				Mat4x4f::PerspectiveFovReversedZ(70.0f * BB::DegToRad, 1.7f, 0.1f, 100.0f),
+				Mat4x4f::PerspectiveFovInfinite(70.0f * BB::DegToRad, 1.7f, 0.1f),
+				Mat4x4f::Orthographic(30.0f, 20.0f, 0.1f, 100.0f) };
+
+			for (const Mat4x4f& projection : projections)
+			{
+				Mat4x4f expected = MultiplyReference(view, projection);
+				Mat4x4f result = Mat4x4f::ViewProjection(view, projection);
+				for (int j = 0; j < 16; j++)
+				{
+					Assert::AreEqual(expected.data[j], result.data[j], 1e-4f, L"ViewProjection does not match a full multiply");
+				}
+			}
+		}
+
+		TEST_METHOD(InvertedProjection)
+		{
+			Mat4x4f perspectives[] = {
+				Mat4x4f::PerspectiveFov(70.0f * BB::DegToRad, 1.7f, 0.1f, 100.0f),
+				Mat4x4f::PerspectiveFovReversedZ(70.0f * BB::DegToRad, 1.7f, 0.1f, 100.0f),
+				Mat4x4f::PerspectiveFovInfinite(70.0f * BB::DegToRad, 1.7f, 0.1f),
+				Mat4x4f::PerspectiveFovInfiniteReversedZ(70.0f * BB::DegToRad, 1.7f, 0.1f) };
+
+			for (const Mat4x4f& projection : perspectives)
+			{
+				Mat4x4f identity = MultiplyReference(projection, projection.GetInvertedPerspective());
+				for (int j = 0; j < 16; j++)
+				{
+					Assert::AreEqual(Mat4x4f().data[j], identity.data[j], 1e-5f, L"Perspective inverse does not give back the identity");
+				}
+			}
+
+			Mat4x4f orthographic = Mat4x4f::Orthographic(30.0f, 20.0f, 0.1f, 100.0f);
+			Mat4x4f identity = MultiplyReference(orthographic, orthographic.GetInvertedOrthographic());
+			for (int j = 0; j < 16; j++)
+			{
+				Assert::AreEqual(Mat4x4f().data[j], identity.data[j], 1e-5f, L"Orthographic inverse does not give back the identity");
+			}
+		}
+	};
+
+	TEST_CLASS(Benchmark)
+	{
+		// The previous operator* formulation: copy of the right operand, transpose, then row broadcasts
+		static Mat4x4f MultiplyCopyTranspose(const Mat4x4f& aMatrixOne, Mat4x4f aMatrixTwo)
+		{
+			Mat4x4f result;
+			aMatrixTwo.Transpose();
+			for (int i = 0; i < 4; ++i)
+			{
+				__m128 mul0 = _mm_mul_ps(_mm_shuffle_ps(aMatrixOne.row[i], aMatrixOne.row[i], _MM_SHUFFLE(0, 0, 0, 0)), aMatrixTwo.row[0]);
+				__m128 mul1 = _mm_mul_ps(_mm_shuffle_ps(aMatrixOne.row[i], aMatrixOne.row[i], _MM_SHUFFLE(1, 1, 1, 1)), aMatrixTwo.row[1]);
+				__m128 mul2 = _mm_mul_ps(_mm_shuffle_ps(aMatrixOne.row[i], aMatrixOne.row[i], _MM_SHUFFLE(2, 2, 2, 2)), aMatrixTwo.row[2]);
+				__m128 mul3 = _mm_mul_ps(_mm_shuffle_ps(aMatrixOne.row[i], aMatrixOne.row[i], _MM_SHUFFLE(3, 3, 3, 3)), aMatrixTwo.row[3]);
+				result.row[i] = _mm_add_ps(_mm_add_ps(mul0, mul1), _mm_add_ps(mul2, mul3));
+			}
+			return result;
+		}
+
+		TEST_METHOD(Multiply_Cycles)
+		{
+			const int matrixAmount = 1024;
+			const int runs = 200;
+
+			std::vector<Mat4x4f> left(matrixAmount);
+			std::vector<Mat4x4f> right(matrixAmount);
+			std::vector<Mat4x4f> output(matrixAmount);
+			for (int i = 0; i < matrixAmount; i++)
+			{
+				for (int j = 0; j < 16; j++)
+				{
+					left[i].data[j] = BB::Random(-1.0f, 1.0f);
+					right[i].data[j] = BB::Random(-1.0f, 1.0f);
+				}
+			}
+
+			unsigned long long start = __rdtsc();
+			for (int run = 0; run < runs; run++)
+			{
+				for (int i = 0; i < matrixAmount; i++)
+				{
+					output[i] = MultiplyCopyTranspose(left[i], right[i]);
+				}
+			}
+			const double transposeCycles = double(__rdtsc() - start) / (double(runs) * matrixAmount);
+
+			start = __rdtsc();
+			for (int run = 0; run < runs; run++)
+			{
+				for (int i = 0; i < matrixAmount; i++)
+				{
+					Multiply(left[i], right[i], output[i]);
+				}
+			}
+			const double multiplyCycles = double(__rdtsc() - start) / (double(runs) * matrixAmount);
+
+			start = __rdtsc();
+			for (int run = 0; run < runs; run++)
+			{
+				for (int i = 0; i < matrixAmount; i++)
+				{
+					output[i] *= right[i];
+				}
+			}
+			const double inPlaceCycles = double(__rdtsc() - start) / (double(runs) * matrixAmount);
+
+			char message[256];
+			snprintf(message, sizeof(message), "Mat4x4f multiply, cycles per matrix: copy + transpose %.1f, Multiply %.1f, operator*= %.1f\n",
+				transposeCycles, multiplyCycles, inPlaceCycles);
+			Logger::WriteMessage(message);
+
+			Assert::IsTrue(multiplyCycles > 0.0 && inPlaceCycles > 0.0, L"Benchmark did not run");
+		}
+	};
+
+	TEST_CLASS(FusedArithmetic)
+	{
+		TEST_METHOD(MulAdd_MulSub_NegMulAdd)
+		{
+			Mat4x4f mat1;
+			Mat4x4f mat2;
+			Mat4x4f mat3;
+
+			float size = 100.0f;
+			int runs = 100;
+			for (int i = 0; i < runs; i++)
+			{
+				for (int j = 0; j < 16; j++)
+				{
+					mat1.data[j] = BB::Random(-size, size);
+					mat2.data[j] = BB::Random(-size, size);
+					mat3.data[j] = BB::Random(-size, size);
+				}
+
+				Mat4x4f product = MultiplyReference(mat1, mat2);
+				Mat4x4f mulAdd = MulAdd(mat1, mat2, mat3);
+				Mat4x4f mulSub = MulSub(mat1, mat2, mat3);
+				Mat4x4f negMulAdd = NegMulAdd(mat1, mat2, mat3);
+
+				for (int j = 0; j < 16; j++)
+				{
+					Assert::AreEqual(product.data[j] + mat3.data[j], mulAdd.data[j], 0.05f, L"Matrix MulAdd is not done correctly");
+					Assert::AreEqual(product.data[j] - mat3.data[j], mulSub.data[j], 0.05f, L"Matrix MulSub is not done correctly");
+					Assert::AreEqual(mat3.data[j] - product.data[j], negMulAdd.data[j], 0.05f, L"Matrix NegMulAdd is not done correctly");
+				}
+			}
+		}
+
+		TEST_METHOD(Lerp_Endpoints)
+		{
+			Mat4x4f from;
+			Mat4x4f to({ 10.0f, 20.0f, 30.0f });
+			Mat4x4f half = Lerp(from, to, 0.5f);
+
+			Assert::IsTrue(Lerp(from, to, 0.0f) == from, L"Lerp with t = 0 should return the start");
+			Assert::IsTrue(Lerp(from, to, 1.0f) == to, L"Lerp with t = 1 should return the end");
+			Assert::IsTrue(half == Mat4x4f({ 5.0f, 10.0f, 15.0f }), L"Lerp with t = 0.5 should return the middle");
+		}
+	};
+
+	TEST_CLASS(ConstantEvaluation)
+	{
+		TEST_METHOD(Static_Asserts)
+		{
+			constexpr Mat4x4f translation(Vec3f(1.0f, 2.0f, 3.0f));
+			constexpr Mat4x4f scale(2.0f, 0.0f, 0.0f, 0.0f,
+									0.0f, 2.0f, 0.0f, 0.0f,
+									0.0f, 0.0f, 2.0f, 0.0f,
+									0.0f, 0.0f, 0.0f, 1.0f);
+
+			static_assert(Mat4x4f() == BB::MAT4X4F_IDENTITY, "Constexpr identity is not set correctly");
+			static_assert(translation.lanes.value[12] == 1.0f && translation.lanes.value[14] == 3.0f, "Constexpr translation is not set correctly");
+			static_assert(translation * BB::MAT4X4F_IDENTITY == translation, "Constexpr multiply by identity should not change the matrix");
+			static_assert((translation * scale).lanes.value[13] == 4.0f, "Constexpr multiply is not done correctly");
+			static_assert(translation.GetTransposed().lanes.value[3] == 1.0f, "Constexpr transpose is not done correctly");
+			static_assert(translation.GetTransposed().GetTransposed() == translation, "Transposing twice should give the original");
+			static_assert(scale + scale == scale * 2.0f && (scale * 2.0f) / 2.0f == scale, "Constexpr element-wise operators are not done correctly");
+			static_assert(scale - scale != BB::MAT4X4F_IDENTITY, "Constexpr subtract is not done correctly");
+		}
+
+		TEST_METHOD(Matches_Runtime)
+		{
+			// Baked into the binary, nothing is computed when the test runs
+			constexpr Mat4x4f bakedProjection = Mat4x4f::Orthographic(1920.0f, 1080.0f, 0.5f, 100.0f);
+			constexpr Mat4x4f bakedProduct = Mat4x4f(Vec3f(10.0f, -4.0f, 2.0f)) * bakedProjection;
+
+			float width = 1920.0f;
+			Mat4x4f projection = Mat4x4f::Orthographic(width, 1080.0f, 0.5f, 100.0f);
+			Mat4x4f product = Mat4x4f(Vec3f(10.0f, -4.0f, 2.0f)) * projection;
+
+			Assert::IsTrue(bakedProjection == projection, L"Constexpr Orthographic differs from the runtime result");
+			for (int i = 0; i < 16; i++)
+			{
+				Assert::AreEqual(product.data[i], bakedProduct.data[i], 0.00001f, L"Constexpr multiply differs from the runtime result");
+			}
+		}
+	};
+
+	TEST_CLASS(LoadStore)
+	{
+		TEST_METHOD(Load_Store)
+		{
+			alignas(16) float buffer[40];
+			for (int i = 0; i < 40; i++)
+			{
+				buffer[i] = float(i);
+			}
+
+			Mat4x4f unaligned = Mat4x4f::LoadUnaligned(buffer + 1);
+			Mat4x4f aligned = Mat4x4f::LoadAligned(buffer + 4);
+			Assert::AreEqual(1.0f, unaligned.p00); Assert::AreEqual(16.0f, unaligned.p33);
+			Assert::AreEqual(4.0f, aligned.p00); Assert::AreEqual(19.0f, aligned.p33);
+
+			Mat4x4f value(Vec3f(-1.0f, -2.0f, -3.0f));
+			value.StoreUnaligned(buffer + 1);
+			Assert::IsTrue(Mat4x4f::LoadUnaligned(buffer + 1) == value && buffer[0] == 0.0f && buffer[17] == 17.0f, L"StoreUnaligned did not write exactly 16 floats");
+
+			value.StoreAligned(buffer + 20);
+			Assert::IsTrue(Mat4x4f::LoadAligned(buffer + 20) == value, L"StoreAligned did not write the matrix");
+
+			aligned.StoreStream(buffer + 20);
+			BB::Simd::StreamFence();
+			Assert::IsTrue(Mat4x4f::LoadAligned(buffer + 20) == aligned, L"StoreStream did not write the matrix");
+		}
+	};
+
+	TEST_CLASS(Bulk)
+	{
+		static Mat4x4f RandomAffine()
+		{
+			Mat4x4f matrix;
+			for (int i = 0; i < 12; i++)
+			{
+				matrix.data[(i / 3) * 4 + i % 3] = BB::Random(-2.0f, 2.0f);
+			}
+			return matrix;
+		}
+
+		static void FillRandom(float* aValues, size_t aCount)
+		{
+			for (size_t i = 0; i < aCount; i++)
+			{
+				aValues[i] = BB::Random(-10.0f, 10.0f);
+			}
+		}
+
+		TEST_METHOD(TransformPoints_AnyAlignment)
+		{
+			const Mat4x4f matrix = RandomAffine();
+			BB::AlignedVector<float> input(64 * 3 + 8);
+			BB::AlignedVector<float> output(64 * 3 + 8);
+			FillRandom(input.data(), input.size());
+
+			// Every combination of input/output misalignment and counts that leave a tail
+			for (int inOffset = 0; inOffset < 4; inOffset++)
+			{
+				for (int outOffset = 0; outOffset < 4; outOffset++)
+				{
+					for (size_t count = 0; count < 24; count++)
+					{
+						const float* points = input.data() + inOffset;
+						float* result = output.data() + outOffset;
+						std::fill(output.begin(), output.end(), -123.0f);
+
+						BB::Bulk::TransformPoints(matrix, points, result, count);
+						for (size_t i = 0; i < count; i++)
+						{
+							Vec4Ref expected = TransformReference(matrix, points[i * 3], points[i * 3 + 1], points[i * 3 + 2], 1.0f);
+							for (int c = 0; c < 3; c++)
+							{
+								Assert::AreEqual(expected.v[c], result[i * 3 + c], 0.0001f, L"TransformPoints gives the wrong result");
+							}
+						}
+						Assert::AreEqual(-123.0f, result[count * 3], L"TransformPoints wrote past the last point");
+					}
+				}
+			}
+		}
+
+		TEST_METHOD(TransformVectors_InPlace)
+		{
+			const Mat4x4f matrix = RandomAffine();
+			std::vector<float> values(37 * 3);
+			FillRandom(values.data(), values.size());
+			const std::vector<float> original = values;
+
+			BB::Bulk::TransformVectors(matrix, values.data(), values.data(), 37);
+			for (size_t i = 0; i < 37; i++)
+			{
+				Vec4Ref expected = TransformReference(matrix, original[i * 3], original[i * 3 + 1], original[i * 3 + 2], 0.0f);
+				for (int c = 0; c < 3; c++)
+				{
+					Assert::AreEqual(expected.v[c], values[i * 3 + c], 0.0001f, L"TransformVectors should ignore the translation");
+				}
+			}
+		}
+
+		TEST_METHOD(Normalize_Bounds)
+		{
+			std::vector<float> values(45 * 3 + 1);
+			FillRandom(values.data(), values.size());
+			float* points = values.data() + 1;
+
+			Vec3f minimum, maximum;
+			BB::Bulk::Bounds(points, 45, minimum, maximum);
+			Vec3f expectedMin(FLT_MAX), expectedMax(-FLT_MAX);
+			for (size_t i = 0; i < 45; i++)
+			{
+				expectedMin = _mm_min_ps(expectedMin.data, Vec3f::LoadUnaligned(points + i * 3).data);
+				expectedMax = _mm_max_ps(expectedMax.data, Vec3f::LoadUnaligned(points + i * 3).data);
+			}
+			Assert::IsTrue(minimum == expectedMin && maximum == expectedMax, L"Bounds of packed points are wrong");
+
+			BB::Bulk::Normalize(points, points, 45);
+			for (size_t i = 0; i < 45; i++)
+			{
+				Assert::AreEqual(1.0f, Vec3f::LoadUnaligned(points + i * 3).Length(), 0.0001f, L"Normalize did not give unit length");
+			}
+
+			BB::Bulk::Bounds(points, 0, minimum, maximum);
+			Assert::IsTrue(minimum == Vec3f(FLT_MAX) && maximum == Vec3f(-FLT_MAX), L"Bounds of no points should be empty");
+		}
+
+		TEST_METHOD(VectorArrays)
+		{
+			const Mat4x4f matrix = RandomAffine();
+			BB::AlignedVector<Vec3f> points(19);
+			for (Vec3f& point : points)
+			{
+				point = Vec3f(BB::Random(-10.0f, 10.0f), BB::Random(-10.0f, 10.0f), BB::Random(-10.0f, 10.0f));
+			}
+			BB::AlignedVector<Vec3f> result(19);
+
+			BB::Bulk::TransformPoints(matrix, points.data(), result.data(), points.size());
+			for (size_t i = 0; i < points.size(); i++)
+			{
+				Vec4Ref expected = TransformReference(matrix, points[i].x, points[i].y, points[i].z, 1.0f);
+				Assert::AreEqual(expected.v[0], result[i].x, 0.0001f, L"TransformPoints on Vec3f gives the wrong result");
+				Assert::AreEqual(expected.v[2], result[i].z, 0.0001f, L"TransformPoints on Vec3f gives the wrong result");
+				Assert::AreEqual(0.0f, _mm_cvtss_f32(_mm_shuffle_ps(result[i].data, result[i].data, _MM_SHUFFLE(3, 3, 3, 3))), L"TransformPoints should keep the unused component at zero");
+			}
+
+			BB::AlignedVector<Vec4f> vectors(7, Vec4f(1.0f, 2.0f, 3.0f, 1.0f));
+			BB::Bulk::Transform(matrix, vectors.data(), vectors.data(), vectors.size());
+			Vec4Ref expected = TransformReference(matrix, 1.0f, 2.0f, 3.0f, 1.0f);
+			Assert::AreEqual(expected.v[1], vectors[6].y, 0.0001f, L"Transform on Vec4f gives the wrong result");
+			Assert::AreEqual(1.0f, vectors[6].w, 0.0001f, L"Transform on Vec4f gives the wrong w");
+
+			BB::Bulk::Normalize(points.data(), points.data(), points.size());
+			Vec3f minimum, maximum;
+			BB::Bulk::Bounds(points.data(), points.size(), minimum, maximum);
+			Assert::IsTrue(minimum.x >= -1.0f && maximum.x <= 1.0f && minimum.x < maximum.x, L"Bounds of normalized Vec3f are wrong");
+		}
+
+		TEST_METHOD(Streaming_Output)
+		{
+			// Larger than BB_STREAM_THRESHOLD_BYTES so the non-temporal path is taken
+			const size_t count = BB_STREAM_THRESHOLD_BYTES / (3 * sizeof(float)) + 101;
+			const Mat4x4f matrix(Vec3f(1.0f, -2.0f, 0.5f));
+			BB::AlignedVector<float> input(count * 3, 1.0f);
+			BB::AlignedVector<float> output(count * 3 + 1, 0.0f);
+
+			BB::Bulk::TransformPoints(matrix, input.data(), output.data() + 1, count);
+			Assert::AreEqual(2.0f, output[1], L"Streaming output is wrong at the start");
+			Assert::AreEqual(-1.0f, output[(count / 2) * 3 + 2], L"Streaming output is wrong in the middle");
+			Assert::AreEqual(1.5f, output[count * 3], L"Streaming output is wrong at the end");
+		}
+
+		TEST_METHOD(TransformPoints_Cycles)
+		{
+			const size_t count = 4096;
+			const int runs = 200;
+			const Mat4x4f matrix = RandomAffine();
+			BB::AlignedVector<float> input(count * 3 + 4);
+			BB::AlignedVector<float> output(count * 3 + 4);
+			FillRandom(input.data(), input.size());
+
+			double cycles[2];
+			for (int offset = 0; offset < 2; offset++)
+			{
+				unsigned long long start = __rdtsc();
+				for (int run = 0; run < runs; run++)
+				{
+					BB::Bulk::TransformPoints(matrix, input.data() + offset, output.data() + offset, count);
+				}
+				cycles[offset] = double(__rdtsc() - start) / (double(runs) * count);
+			}
+
+			unsigned long long start = __rdtsc();
+			for (int run = 0; run < runs; run++)
+			{
+				for (size_t i = 0; i < count; i++)
+				{
+					Vec3f point = Vec3f::LoadUnaligned(input.data() + i * 3);
+					Vec4f transformed = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(point.x), matrix.row[0]), _mm_mul_ps(_mm_set1_ps(point.y), matrix.row[1])),
+												   _mm_add_ps(_mm_mul_ps(_mm_set1_ps(point.z), matrix.row[2]), matrix.row[3]));
+					Vec3f(transformed.data).StoreUnaligned(output.data() + i * 3);
+				}
+			}
+			const double perPointCycles = double(__rdtsc() - start) / (double(runs) * count);
+
+			char message[256];
+			snprintf(message, sizeof(message), "Packed TransformPoints, cycles per point: aligned %.2f, misaligned %.2f, one point at a time %.2f\n",
+				cycles[0], cycles[1], perPointCycles);
+			Logger::WriteMessage(message);
+			Assert::IsTrue(cycles[0] > 0.0 && cycles[1] > 0.0, L"Benchmark did not run");
+		}
+	};
+
+	TEST_CLASS(StreamViews)
+	{
+		struct Vertex
+		{
+			float position[3];
+			float normal[3];
+			float uv[2];
+		};
+
+		TEST_METHOD(TransformPoints_AnyStride)
+		{
+			Mat4x4f matrix;
+			for (int i = 0; i < 12; i++)
+			{
+				matrix.data[(i / 3) * 4 + i % 3] = BB::Random(-2.0f, 2.0f);
+			}
+
+			// Packed, padded and two gather strides, for both input and output
+			const size_t strides[] = { 12, 16, 20, 32 };
+			for (size_t inStride : strides)
+			{
+				for (size_t outStride : strides)
+				{
+					for (size_t count = 0; count < 14; count++)
+					{
+						std::vector<float> input(count * inStride / 4 + 1);
+						std::vector<float> output(count * outStride / 4 + 1, -123.0f);
+						for (float& value : input)
+						{
+							value = BB::Random(-10.0f, 10.0f);
+						}
+
+						// Start one float in so nothing is 16-byte aligned
+						BB::StreamView<const Vec3f> points(input.data() + 1, inStride, count);
+						BB::StreamView<Vec3f> result(output.data() + 1, outStride, count);
+						BB::Bulk::TransformPoints(matrix, points, result);
+
+						for (size_t i = 0; i < count; i++)
+						{
+							const float* point = points.GetElement(i);
+							Vec4Ref expected = TransformReference(matrix, point[0], point[1], point[2], 1.0f);
+							const float* written = result.GetElement(i);
+							for (int c = 0; c < 3; c++)
+							{
+								Assert::AreEqual(expected.v[c], written[c], 0.0001f, L"TransformPoints on a view gives the wrong result");
+							}
+							for (size_t gap = 3; gap < outStride / 4 && i * outStride / 4 + gap + 1 < output.size(); gap++)
+							{
+								Assert::AreEqual(-123.0f, written[gap], L"TransformPoints wrote between the elements of a view");
+							}
+						}
+						Assert::AreEqual(-123.0f, output[0], L"TransformPoints wrote before the view");
+					}
+				}
+			}
+		}
+
+		TEST_METHOD(Interleaved_Vertices)
+		{
+			std::vector<Vertex> vertices(23);
+			for (size_t i = 0; i < vertices.size(); i++)
+			{
+				for (int c = 0; c < 3; c++)
+				{
+					vertices[i].position[c] = BB::Random(-10.0f, 10.0f);
+					vertices[i].normal[c] = BB::Random(-1.0f, 1.0f);
+				}
+				vertices[i].uv[0] = float(i);
+				vertices[i].uv[1] = -float(i);
+			}
+
+			BB::StreamView<Vec3f> positions(vertices.data(), offsetof(Vertex, position), sizeof(Vertex), vertices.size());
+			BB::StreamView<Vec3f> normals(vertices.data(), offsetof(Vertex, normal), sizeof(Vertex), vertices.size());
+
+			Vec3f minimum, maximum;
+			BB::Bulk::Bounds(positions, minimum, maximum);
+			Vec3f expectedMin(FLT_MAX), expectedMax(-FLT_MAX);
+			for (size_t i = 0; i < positions.GetCount(); i++)
+			{
+				expectedMin = _mm_min_ps(expectedMin.data, positions.Load(i).data);
+				expectedMax = _mm_max_ps(expectedMax.data, positions.Load(i).data);
+			}
+			Assert::IsTrue(minimum == expectedMin && maximum == expectedMax, L"Bounds on an interleaved view are wrong");
+
+			const Vec3f firstPosition = positions.Load(0);
+			BB::Bulk::Normalize(normals, normals);
+			for (size_t i = 0; i < vertices.size(); i++)
+			{
+				Assert::AreEqual(1.0f, normals.Load(i).Length(), 0.0001f, L"Normalize on an interleaved view did not give unit length");
+				Assert::AreEqual(float(i), vertices[i].uv[0], L"Normalize changed another attribute");
+				Assert::AreEqual(-float(i), vertices[i].uv[1], L"Normalize changed another attribute");
+			}
+			Assert::IsTrue(positions.Load(0) == firstPosition, L"Normalize changed another attribute");
+		}
+
+		TEST_METHOD(Padded_KeepsFourthFloat)
+		{
+			const size_t count = 16;
+			std::vector<float> values(count * 4);
+			for (size_t i = 0; i < count; i++)
+			{
+				values[i * 4] = 1.0f;
+				values[i * 4 + 1] = 2.0f;
+				values[i * 4 + 2] = 3.0f;
+				values[i * 4 + 3] = float(i);
+			}
+
+			BB::StreamView<Vec3f> view(values.data(), 16, count);
+			BB::Bulk::TransformPoints(Mat4x4f(Vec3f(1.0f, 1.0f, 1.0f)), view, view);
+
+			Vec3f minimum, maximum;
+			BB::Bulk::Bounds(view, minimum, maximum);
+			Assert::IsTrue(minimum == Vec3f(2.0f, 3.0f, 4.0f) && maximum == minimum, L"TransformPoints on a padded view gives the wrong result");
+			for (size_t i = 0; i < count; i++)
+			{
+				Assert::AreEqual(float(i), values[i * 4 + 3], L"A padded view should keep the fourth float");
+			}
+		}
+
+		TEST_METHOD(Vec4f_View)
+		{
+			const Mat4x4f matrix(Vec3f(1.0f, 2.0f, 3.0f));
+			std::vector<float> values(9 * 5);
+			for (size_t i = 0; i < 9; i++)
+			{
+				values[i * 5 + 3] = 1.0f;
+				values[i * 5 + 4] = 42.0f;
+			}
+
+			BB::StreamView<Vec4f> view(values.data(), 20, 9);
+			BB::Bulk::Transform(matrix, view, view);
+			for (size_t i = 0; i < 9; i++)
+			{
+				Assert::IsTrue(view.Load(i) == Vec4f(1.0f, 2.0f, 3.0f, 1.0f), L"Transform on a Vec4f view gives the wrong result");
+				Assert::AreEqual(42.0f, values[i * 5 + 4], L"Transform wrote between the elements of a view");
+			}
+		}
+	};
+
+	TEST_CLASS(ComponentWiseArrays)
+	{
+	public:
+		TEST_METHOD(MatchesPerElement)
+		{
+			std::vector<Vec3f> one, two;
+			std::vector<Vec4f> oneW, twoW;
+			for (int i = 0; i < 37; i++)
+			{
+				one.push_back(Vec3f(i * 0.75f - 10.0f, 5.0f - i * 0.5f, (i % 5) - 2.5f));
+				two.push_back(Vec3f(i * 0.25f, -i * 0.1f, 1.0f));
+				oneW.push_back(Vec4f(one.back().x, one.back().y, one.back().z, -i * 0.3f));
+				twoW.push_back(Vec4f(two.back().x, two.back().y, two.back().z, 2.0f));
+			}
+
+			std::vector<Vec3f> out(one.size());
+			std::vector<Vec4f> outW(oneW.size());
+			BB::Bulk::Min(one.data(), two.data(), out.data(), one.size());
+			for (size_t i = 0; i < one.size(); i++) Assert::IsTrue(out[i] == Min(one[i], two[i]), L"Bulk Min differs");
+			BB::Bulk::Max(oneW.data(), twoW.data(), outW.data(), oneW.size());
+			for (size_t i = 0; i < oneW.size(); i++) Assert::IsTrue(outW[i] == Max(oneW[i], twoW[i]), L"Bulk Max differs");
+			BB::Bulk::Clamp(one.data(), Vec3f(-1.0f), Vec3f(1.0f), out.data(), one.size());
+			for (size_t i = 0; i < one.size(); i++) Assert::IsTrue(out[i] == Clamp(one[i], -1.0f, 1.0f), L"Bulk Clamp differs");
+			BB::Bulk::Floor(oneW.data(), outW.data(), oneW.size());
+			for (size_t i = 0; i < oneW.size(); i++) Assert::IsTrue(outW[i] == Floor(oneW[i]), L"Bulk Floor differs");
+			BB::Bulk::Ceil(one.data(), out.data(), one.size());
+			for (size_t i = 0; i < one.size(); i++) Assert::IsTrue(out[i] == Ceil(one[i]), L"Bulk Ceil differs");
+			BB::Bulk::Sign(oneW.data(), outW.data(), oneW.size());
+			for (size_t i = 0; i < oneW.size(); i++) Assert::IsTrue(outW[i] == Sign(oneW[i]), L"Bulk Sign differs");
+			BB::Bulk::Lerp(one.data(), two.data(), 0.25f, out.data(), one.size());
+			for (size_t i = 0; i < one.size(); i++) Assert::IsTrue(out[i] == Lerp(one[i], two[i], 0.25f), L"Bulk Lerp differs");
+
+			// In place
+			BB::Bulk::Abs(one.data(), one.data(), one.size());
+			for (size_t i = 0; i < one.size(); i++) Assert::IsTrue(one[i] == Abs(Vec3f(i * 0.75f - 10.0f, 5.0f - i * 0.5f, (i % 5) - 2.5f)), L"In place Bulk Abs differs");
+		}
+	};
+
+	TEST_CLASS(Sanitize)
+	{
+	public:
+		TEST_METHOD(PackedAndVectors)
+		{
+			// 5 packed points = 15 floats, covers the four float steps and the tail
+			std::vector<float> packed(15, 1.0f);
+			packed[0] = NAN; packed[5] = INFINITY; packed[13] = -INFINITY; packed[14] = NAN;
+			std::vector<float> cleaned(15, -1.0f);
+
+			Assert::AreEqual(size_t(4), BB::Bulk::Sanitize(packed.data(), 0.0f, cleaned.data(), 5), L"Four floats should be replaced");
+			for (size_t i = 0; i < packed.size(); i++)
+			{
+				const bool replaced = i == 0 || i == 5 || i == 13 || i == 14;
+				Assert::AreEqual(replaced ? 0.0f : 1.0f, cleaned[i], L"Packed Sanitize wrote the wrong value");
+			}
+
+			std::vector<Vec3f> vectors = { Vec3f(1.0f), Vec3f(NAN, 2.0f, INFINITY), Vec3f(3.0f) };
+			Assert::AreEqual(size_t(2), BB::Bulk::Sanitize(vectors.data(), Vec3f(0.0f), vectors.data(), vectors.size()), L"Two components should be replaced");
+			Assert::IsTrue(vectors[1] == Vec3f(0.0f, 2.0f, 0.0f) && vectors[2] == Vec3f(3.0f), L"In place Vec3f Sanitize failed");
+
+			std::vector<Vec4f> wide = { Vec4f(1.0f, 2.0f, 3.0f, NAN) };
+			std::vector<Vec4f> wideOut(1);
+			Assert::AreEqual(size_t(1), BB::Bulk::Sanitize(wide.data(), Vec4f(9.0f), wideOut.data(), 1));
+			Assert::IsTrue(wideOut[0] == Vec4f(1.0f, 2.0f, 3.0f, 9.0f), L"Vec4f Sanitize failed");
+		}
+	};
+
+	TEST_CLASS(BulkParallel)
+	{
+		static Mat4x4f RandomAffine()
+		{
+			Mat4x4f matrix;
+			for (int i = 0; i < 12; i++)
+			{
+				matrix.data[(i / 3) * 4 + i % 3] = BB::Random(-2.0f, 2.0f);
+			}
+			return matrix;
+		}
+
+	public:
+		TEST_METHOD(Matches_Serial)
+		{
+			BB::ThreadPoolSettings settings;
+			settings.workerCount = 3;
+			BB::ThreadPool pool(settings);
+
+			const size_t count = 20011;
+			const Mat4x4f matrix = RandomAffine();
+			BB::AlignedVector<Vec3f, BB::CACHE_LINE_SIZE> points(count);
+			for (Vec3f& point : points)
+			{
+				point = Vec3f(BB::Random(-10.0f, 10.0f), BB::Random(-10.0f, 10.0f), BB::Random(-10.0f, 10.0f));
+			}
+			BB::AlignedVector<Vec3f, BB::CACHE_LINE_SIZE> serial(count);
+			BB::AlignedVector<Vec3f, BB::CACHE_LINE_SIZE> parallel(count);
+
+			BB::Bulk::TransformPoints(matrix, points.data(), serial.data(), count);
+			BB::Bulk::TransformPoints(pool, matrix, points.data(), parallel.data(), count);
+			Assert::IsTrue(serial == parallel, L"Parallel TransformPoints should match the serial kernel");
+
+			BB::Bulk::Normalize(points.data(), serial.data(), count);
+			BB::Bulk::Normalize(pool, points.data(), parallel.data(), count);
+			Assert::IsTrue(serial == parallel, L"Parallel Normalize should match the serial kernel");
+
+			Vec3f serialMin, serialMax, parallelMin, parallelMax;
+			BB::Bulk::Bounds(points.data(), count, serialMin, serialMax);
+			BB::Bulk::Bounds(pool, points.data(), count, parallelMin, parallelMax);
+			Assert::IsTrue(serialMin == parallelMin && serialMax == parallelMax, L"Parallel Bounds should match the serial kernel");
+		}
+
+		TEST_METHOD(Scaling_1_To_N)
+		{
+			const size_t count = 1 << 21;
+			const int repeats = 8;
+			const Mat4x4f matrix = RandomAffine();
+			BB::AlignedVector<Vec3f, BB::CACHE_LINE_SIZE> points(count, Vec3f(1.0f, 2.0f, 3.0f));
+			BB::AlignedVector<Vec3f, BB::CACHE_LINE_SIZE> output(count);
+
+			// 1, 2, 4, ... and the core count
+			const size_t hardware = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+			std::vector<size_t> threadCounts;
+			for (size_t threads = 1; threads < hardware; threads *= 2)
+			{
+				threadCounts.push_back(threads);
+			}
+			threadCounts.push_back(hardware);
+
+			double singleThread = 0.0;
+			for (size_t threads : threadCounts)
+			{
+				BB::ThreadPoolSettings settings;
+				settings.workerCount = threads - 1;
+				BB::ThreadPool pool(settings);
+
+				BB::Bulk::TransformPoints(pool, matrix, points.data(), output.data(), count);
+				const auto start = std::chrono::steady_clock::now();
+				for (int i = 0; i < repeats; i++)
+				{
+					BB::Bulk::TransformPoints(pool, matrix, points.data(), output.data(), count);
+				}
+				const double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / repeats;
+				singleThread = threads == 1 ? milliseconds : singleThread;
+
+				char message[256];
+				snprintf(message, sizeof(message), "TransformPoints %zu Vec3f, %zu threads: %.3f ms, speedup %.2f\n", count, threads, milliseconds, singleThread / milliseconds);
+				Logger::WriteMessage(message);
+			}
+		}
 	};
 }
@@ -0,0 +1,202 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "../MathLib/Particles/ParticleSystem.h"
+#include "../MathLib/Parallel/ThreadPool.h"
+#include "../MathLib/Util/Random.h"
+
+#include <intrin.h>
+#include <vector>
+#include <cstdio>
+#include <cmath>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace Particles
+{
+	TEST_CLASS(ParticleSystem)
+	{
+		static BB::ParticleEmitterSettings Emitter()
+		{
+			BB::ParticleEmitterSettings emitter;
+			emitter.position = Vec3f(0.0f, 10.0f, 0.0f);
+			emitter.extent = Vec3f(5.0f, 1.0f, 5.0f);
+			emitter.velocityMin = Vec3f(-1.0f, 0.0f, -1.0f);
+			emitter.velocityMax = Vec3f(1.0f, 5.0f, 1.0f);
+			emitter.lifetimeMin = 0.5f;
+			emitter.lifetimeMax = 2.0f;
+			return emitter;
+		}
+
+	public:
+		TEST_METHOD(Euler_Matches_Vec3f)
+		{
+			const BB::ParticleForceField field = { Vec3f(1.0f, 2.0f, 3.0f), 4.0f, 0.1f };
+			BB::ParticleSimulationSettings settings;
+			settings.drag = 0.5f;
+			settings.forceFields = &field;
+			settings.forceFieldCount = 1;
+
+			BB::ParticleSystem particles(37);
+			BB::ParticleEmitterSettings emitter = Emitter();
+			emitter.lifetimeMin = 100.0f;
+			emitter.lifetimeMax = 100.0f;
+			Assert::AreEqual(size_t(37), particles.Emit(emitter, 50), L"Emit should stop at the capacity");
+
+			std::vector<Vec3f> positions(37);
+			std::vector<Vec3f> velocities(37);
+			for (size_t i = 0; i < 37; i++)
+			{
+				positions[i] = particles.GetPosition(i);
+				velocities[i] = particles.GetVelocity(i);
+				Assert::IsTrue(positions[i].x >= -5.0f && positions[i].x <= 5.0f && positions[i].y >= 9.0f && positions[i].y <= 11.0f, L"Emitted outside the box");
+			}
+
+			const float deltaTime = 1.0f / 60.0f;
+			for (int step = 0; step < 10; step++)
+			{
+				particles.Update(settings, deltaTime);
+				for (size_t i = 0; i < 37; i++)
+				{
+					// The same step written with the Vec3f operators, one particle at a time
+					const Vec3f delta = field.center - positions[i];
+					const float distanceSquared = delta.Dot(delta) + field.softening;
+					const Vec3f acceleration = settings.gravity + delta * (field.strength / (distanceSquared * std::sqrt(distanceSquared)));
+					velocities[i] = (velocities[i] + acceleration * deltaTime) * (1.0f - settings.drag * deltaTime);
+					positions[i] += velocities[i] * deltaTime;
+				}
+			}
+
+			Assert::AreEqual(size_t(37), particles.GetCount());
+			for (size_t i = 0; i < 37; i++)
+			{
+				Assert::IsTrue((particles.GetPosition(i) - positions[i]).Length() < 1e-4f, L"Euler position differs from the Vec3f reference");
+				Assert::IsTrue((particles.GetVelocity(i) - velocities[i]).Length() < 1e-4f, L"Euler velocity differs from the Vec3f reference");
+			}
+		}
+
+		TEST_METHOD(Verlet_Constant_Acceleration)
+		{
+			BB::ParticleSimulationSettings settings;
+			settings.integrator = BB::ParticleIntegrator::Verlet;
+			settings.gravity = Vec3f(0.0f, -2.0f, 0.0f);
+
+			BB::ParticleSystem particles(8);
+			BB::ParticleEmitterSettings emitter;
+			emitter.velocityMin = Vec3f(1.0f, 0.0f, 0.0f);
+			emitter.velocityMax = Vec3f(1.0f, 0.0f, 0.0f);
+			emitter.lifetimeMin = emitter.lifetimeMax = 10.0f;
+			particles.Emit(emitter, 1);
+
+			// Position Verlet with constant acceleration: x_n = v0 * n * dt + a * dt^2 * n * (n + 1) / 2
+			const float deltaTime = 0.1f;
+			for (int step = 0; step < 10; step++)
+			{
+				particles.Update(settings, deltaTime);
+			}
+			const Vec3f position = particles.GetPosition(0);
+			Assert::AreEqual(1.0f, position.x, 1e-4f, L"Verlet should keep a constant velocity without forces");
+			Assert::AreEqual(-2.0f * 0.01f * 55.0f, position.y, 1e-4f, L"Verlet gives the wrong position under gravity");
+		}
+
+		TEST_METHOD(Death_Compaction)
+		{
+			BB::ParticleSystem particles(1000, 5);
+			particles.Emit(Emitter(), 1000);
+
+			std::vector<float> survivors;
+			for (size_t i = 0; i < particles.GetCount(); i++)
+			{
+				if (particles.GetLifetime(i) > 1.0f)
+				{
+					survivors.push_back(particles.GetLifetime(i) - 1.0f);
+				}
+			}
+
+			BB::ParticleSimulationSettings settings;
+			particles.Update(settings, 1.0f);
+			Assert::AreEqual(survivors.size(), particles.GetCount(), L"Only the particles with lifetime left should survive");
+			for (size_t i = 0; i < survivors.size(); i++)
+			{
+				Assert::AreEqual(survivors[i], particles.GetLifetime(i), L"Compaction should keep the order of the survivors");
+			}
+
+			particles.Update(settings, 5.0f);
+			Assert::AreEqual(size_t(0), particles.GetCount(), L"Every particle should be dead");
+			Assert::AreEqual(size_t(10), particles.Emit(Emitter(), 10), L"Dead particles should free their slots");
+		}
+
+		TEST_METHOD(Parallel_Matches_Serial)
+		{
+			BB::ThreadPoolSettings poolSettings;
+			poolSettings.workerCount = 3;
+			BB::ThreadPool pool(poolSettings);
+
+			BB::ParticleSystem serial(50000, 9);
+			BB::ParticleSystem parallel(50000, 9);
+			BB::ParticleSimulationSettings settings;
+			settings.drag = 0.1f;
+
+			for (int frame = 0; frame < 20; frame++)
+			{
+				serial.Emit(Emitter(), 3000);
+				parallel.Emit(Emitter(), 3000);
+				serial.Update(settings, 0.05f);
+				parallel.Update(pool, settings, 0.05f);
+			}
+
+			Assert::AreEqual(serial.GetCount(), parallel.GetCount(), L"Parallel Update should kill the same particles");
+			for (size_t i = 0; i < serial.GetCount(); i++)
+			{
+				Assert::IsTrue(serial.GetPosition(i) == parallel.GetPosition(i) && serial.GetLifetime(i) == parallel.GetLifetime(i), L"Parallel Update should match the serial one");
+			}
+		}
+
+		TEST_METHOD(Update_Cycles)
+		{
+			const size_t count = 1 << 18;
+			BB::ParticleSimulationSettings settings;
+			settings.drag = 0.1f;
+
+			BB::ParticleSystem particles(count);
+			unsigned long long start = __rdtsc();
+			particles.Emit(Emitter(), count);
+			unsigned long long emit = __rdtsc() - start;
+			start = __rdtsc();
+			particles.Update(settings, 0.001f);
+			unsigned long long update = __rdtsc() - start;
+
+			// The loops this replaces: one BB::Random call per component and Vec3f operators per particle
+			struct Particle { Vec3f position; Vec3f velocity; float lifetime; };
+			std::vector<Particle> aos(count);
+			start = __rdtsc();
+			for (Particle& particle : aos)
+			{
+				particle.position = Vec3f(BB::Random(-5.0f, 5.0f), BB::Random(9.0f, 11.0f), BB::Random(-5.0f, 5.0f));
+				particle.velocity = Vec3f(BB::Random(-1.0f, 1.0f), BB::Random(0.0f, 5.0f), BB::Random(-1.0f, 1.0f));
+				particle.lifetime = BB::Random(0.5f, 2.0f);
+			}
+			unsigned long long emitAos = __rdtsc() - start;
+			start = __rdtsc();
+			size_t alive = 0;
+			for (size_t i = 0; i < count; i++)
+			{
+				Particle particle = aos[i];
+				particle.velocity += settings.gravity * 0.001f;
+				particle.velocity *= 1.0f - settings.drag * 0.001f;
+				particle.position += particle.velocity * 0.001f;
+				particle.lifetime -= 0.001f;
+				if (particle.lifetime > 0.0f)
+				{
+					aos[alive++] = particle;
+				}
+			}
+			unsigned long long updateAos = __rdtsc() - start;
+			Assert::AreEqual(alive, particles.GetCount());
+
+			char message[256];
+			snprintf(message, sizeof(message), "Particles, cycles per particle: emit %.2f (BB::Random %.2f), update %.2f (Vec3f loop %.2f)\n",
+				double(emit) / count, double(emitAos) / count, double(update) / count, double(updateAos) / count);
+			Logger::WriteMessage(message);
+		}
+	};
+}
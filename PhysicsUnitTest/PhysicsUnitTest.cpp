@@ -0,0 +1,932 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "../MathLib/Physics/RigidBodySystem.h"
+#include "../MathLib/Physics/Collision.h"
+#include "../MathLib/Physics/Gjk.h"
+#include "../MathLib/Physics/Broadphase.h"
+#include "../MathLib/Matrix/Matrix4x4f/Matrix4x4f.h"
+#include "../MathLib/Parallel/ThreadPool.h"
+#include "../MathLib/Util/Random.h"
+#include "../MathLib/Util/CommonMath.h"
+#include "../MathLib/Quaternion/Quatf/Quatf.h"
+
+#include <intrin.h>
+#include <vector>
+#include <cstdio>
+#include <cmath>
+#include <cfloat>
+#include <algorithm>
+#include <limits>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+static Vec3f RandomPoint(float aRange)
+{
+	return Vec3f(BB::Random(-aRange, aRange), BB::Random(-aRange, aRange), BB::Random(-aRange, aRange));
+}
+
+static Quatf RandomRotation()
+{
+	return Quatf::FromAxisAngle(Vec3f(BB::Random(-1.0f, 1.0f), BB::Random(-1.0f, 1.0f), BB::Random(0.1f, 1.0f)).GetNormalized(), BB::Random(-3.0f, 3.0f));
+}
+
+namespace Physics
+{
+	TEST_CLASS(RigidBodies)
+	{
+		static BB::RigidBodyDesc RandomBody()
+		{
+			BB::RigidBodyDesc body;
+			body.position = Vec3f(BB::Random(-10.0f, 10.0f), BB::Random(-10.0f, 10.0f), BB::Random(-10.0f, 10.0f));
+			body.orientation = RandomRotation();
+			body.linearVelocity = Vec3f(BB::Random(-1.0f, 1.0f), BB::Random(-1.0f, 1.0f), BB::Random(-1.0f, 1.0f));
+			body.angularVelocity = Vec3f(BB::Random(-2.0f, 2.0f), BB::Random(-2.0f, 2.0f), BB::Random(-2.0f, 2.0f));
+			body.mass = BB::Random(0.5f, 5.0f);
+			body.inertia = Vec3f(BB::Random(0.5f, 2.0f), BB::Random(0.5f, 2.0f), BB::Random(0.5f, 2.0f));
+			return body;
+		}
+
+		// R * D * R^T with R^T = ToMat4x4f(), the row-vector matrix
+		static Mat4x4f InertiaReference(const Quatf& aOrientation, const Vec3f& aInverseInertia)
+		{
+			const Mat4x4f rotationTransposed = aOrientation.ToMat4x4f();
+			const Mat4x4f diagonal(aInverseInertia.x, 0.0f, 0.0f, 0.0f, 0.0f, aInverseInertia.y, 0.0f, 0.0f, 0.0f, 0.0f, aInverseInertia.z, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+			return rotationTransposed.GetTransposed() * diagonal * rotationTransposed;
+		}
+
+	public:
+		TEST_METHOD(Gravity_And_Static)
+		{
+			BB::RigidBodySystem bodies(4);
+			BB::RigidBodyDesc falling;
+			const size_t dynamicBody = bodies.Add(falling);
+			BB::RigidBodyDesc fixed;
+			fixed.mass = 0.0f;
+			const size_t staticBody = bodies.Add(fixed);
+
+			BB::RigidBodySettings settings;
+			const float deltaTime = 0.01f;
+			for (int step = 0; step < 100; step++)
+			{
+				bodies.ApplyForce(staticBody, Vec3f(100.0f, 0.0f, 0.0f));
+				bodies.Integrate(settings, deltaTime);
+			}
+
+			// Semi-implicit Euler: y_n = g * dt^2 * n * (n + 1) / 2
+			Assert::AreEqual(-9.81f * deltaTime * deltaTime * 5050.0f, bodies.GetPosition(dynamicBody).y, 1e-3f, L"Free fall gives the wrong height");
+			Assert::AreEqual(-9.81f, bodies.GetLinearVelocity(dynamicBody).y, 1e-3f, L"Free fall gives the wrong velocity");
+			Assert::IsTrue(bodies.GetPosition(staticBody) == Vec3f(0.0f), L"Static bodies should not move");
+		}
+
+		TEST_METHOD(Spin_Matches_AxisAngle)
+		{
+			BB::RigidBodySystem bodies(1);
+			BB::RigidBodyDesc spinning;
+			spinning.angularVelocity = Vec3f(0.0f, 0.0f, 2.0f);
+			bodies.Add(spinning);
+
+			BB::RigidBodySettings settings;
+			settings.gravity = Vec3f(0.0f);
+			for (int step = 0; step < 1000; step++)
+			{
+				bodies.Integrate(settings, 0.001f);
+			}
+
+			const Quatf expected = Quatf::FromAxisAngle(Vec3f(0.0f, 0.0f, 1.0f), 2.0f);
+			const Quatf orientation = bodies.GetOrientation(0);
+			Assert::AreEqual(1.0f, orientation.Length(), 1e-5f, L"The orientation should stay normalized");
+			Assert::AreEqual(1.0f, std::abs(orientation.Dot(expected)), 1e-5f, L"Constant spin should match the axis-angle rotation");
+		}
+
+		TEST_METHOD(Torque_And_World_Inertia)
+		{
+			BB::RigidBodySystem bodies(16);
+			std::vector<BB::RigidBodyDesc> descs;
+			for (int i = 0; i < 13; i++)
+			{
+				descs.push_back(RandomBody());
+				bodies.Add(descs.back());
+			}
+
+			for (size_t i = 0; i < descs.size(); i++)
+			{
+				const Vec3f inverseInertia(1.0f / descs[i].inertia.x, 1.0f / descs[i].inertia.y, 1.0f / descs[i].inertia.z);
+				const Mat4x4f expected = InertiaReference(descs[i].orientation, inverseInertia);
+				const Mat4x4f tensor = bodies.GetWorldInverseInertia(i);
+				for (int element = 0; element < 16; element++)
+				{
+					Assert::AreEqual(expected.data[element], tensor.data[element], 1e-4f, L"World inverse inertia differs from R * I^-1 * R^T");
+				}
+			}
+
+			// One step with a torque, w += I_world^-1 * torque * dt
+			const Vec3f torque(1.0f, -2.0f, 0.5f);
+			const Vec3f force(0.0f, 3.0f, 0.0f);
+			const Vec3f arm(1.0f, 0.0f, 0.0f);
+			const Mat4x4f tensor = bodies.GetWorldInverseInertia(0);
+			const Vec3f totalTorque = torque + arm.Cross(force);
+			const Vec3f expectedOmega = descs[0].angularVelocity + Vec3f(
+				tensor.p00 * totalTorque.x + tensor.p01 * totalTorque.y + tensor.p02 * totalTorque.z,
+				tensor.p10 * totalTorque.x + tensor.p11 * totalTorque.y + tensor.p12 * totalTorque.z,
+				tensor.p20 * totalTorque.x + tensor.p21 * totalTorque.y + tensor.p22 * totalTorque.z) * 0.01f;
+
+			bodies.ApplyTorque(0, torque);
+			bodies.ApplyForceAtPoint(0, force, descs[0].position + arm);
+			BB::RigidBodySettings settings;
+			settings.gravity = Vec3f(0.0f);
+			bodies.Integrate(settings, 0.01f);
+			Assert::IsTrue((bodies.GetAngularVelocity(0) - expectedOmega).Length() < 1e-5f, L"Torque gives the wrong angular velocity");
+
+			for (size_t i = 0; i < descs.size(); i++)
+			{
+				const Vec3f inverseInertia(1.0f / descs[i].inertia.x, 1.0f / descs[i].inertia.y, 1.0f / descs[i].inertia.z);
+				const Mat4x4f expected = InertiaReference(bodies.GetOrientation(i), inverseInertia);
+				const Mat4x4f updated = bodies.GetWorldInverseInertia(i);
+				for (int element = 0; element < 16; element++)
+				{
+					Assert::AreEqual(expected.data[element], updated.data[element], 1e-4f, L"Integrate should refresh the world inverse inertia");
+				}
+			}
+		}
+
+		TEST_METHOD(Parallel_And_Cycles)
+		{
+			BB::ThreadPoolSettings poolSettings;
+			poolSettings.workerCount = 3;
+			BB::ThreadPool pool(poolSettings);
+
+			const size_t count = 100000;
+			BB::RigidBodySystem serial(count);
+			BB::RigidBodySystem parallel(count);
+			std::vector<BB::RigidBodyDesc> descs(count);
+			for (BB::RigidBodyDesc& desc : descs)
+			{
+				desc = RandomBody();
+				serial.Add(desc);
+				parallel.Add(desc);
+			}
+
+			BB::RigidBodySettings settings;
+			settings.linearDamping = 0.1f;
+			settings.angularDamping = 0.1f;
+			const float deltaTime = 1.0f / 60.0f;
+
+			unsigned long long start = __rdtsc();
+			serial.Integrate(settings, deltaTime);
+			unsigned long long soa = __rdtsc() - start;
+			start = __rdtsc();
+			parallel.Integrate(pool, settings, deltaTime);
+			unsigned long long soaParallel = __rdtsc() - start;
+
+			for (size_t i = 0; i < count; i += 101)
+			{
+				Assert::IsTrue(serial.GetPosition(i) == parallel.GetPosition(i) && serial.GetOrientation(i) == parallel.GetOrientation(i), L"Parallel Integrate should match the serial one");
+			}
+
+			// The same step one body at a time with Vec3f, Quatf and Mat4x4f, the code this replaces
+			std::vector<Mat4x4f> inertias(count);
+			start = __rdtsc();
+			for (BB::RigidBodyDesc& desc : descs)
+			{
+				desc.linearVelocity = (desc.linearVelocity + settings.gravity * deltaTime) * (1.0f - settings.linearDamping * deltaTime);
+				desc.position += desc.linearVelocity * deltaTime;
+				desc.angularVelocity *= 1.0f - settings.angularDamping * deltaTime;
+				const Quatf spin(desc.angularVelocity.x * 0.5f * deltaTime, desc.angularVelocity.y * 0.5f * deltaTime, desc.angularVelocity.z * 0.5f * deltaTime, 0.0f);
+				const Quatf derivative = spin * desc.orientation;
+				desc.orientation = Quatf(_mm_add_ps(desc.orientation.data, derivative.data)).GetNormalized();
+				const Mat4x4f rotation = desc.orientation.ToMat4x4f();
+				const Mat4x4f diagonal(1.0f / desc.inertia.x, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f / desc.inertia.y, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f / desc.inertia.z, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+				inertias[&desc - descs.data()] = rotation.GetTransposed() * diagonal * rotation;
+			}
+			unsigned long long aos = __rdtsc() - start;
+
+			for (size_t i = 0; i < count; i += 101)
+			{
+				Assert::IsTrue((serial.GetPosition(i) - descs[i].position).Length() < 1e-4f, L"The per-body reference should agree");
+				Assert::AreEqual(1.0f, std::abs(serial.GetOrientation(i).Dot(descs[i].orientation)), 1e-5f, L"The per-body reference should agree");
+			}
+
+			char message[256];
+			snprintf(message, sizeof(message), "RigidBodySystem %zu bodies, cycles per body: SoA %.2f, SoA on 4 threads %.2f, per-body Vec3f/Quatf/Mat4x4f %.2f\n",
+				count, double(soa) / count, double(soaParallel) / count, double(aos) / count);
+			Logger::WriteMessage(message);
+		}
+	};
+
+	TEST_CLASS(CollisionPackets)
+	{
+		static Vec3f ClosestOnSegment(const Vec3f& aPoint, const Vec3f& aStart, const Vec3f& aEnd)
+		{
+			const Vec3f segment = aEnd - aStart;
+			const float lengthSquared = segment.Dot(segment);
+			const float t = lengthSquared > 0.0f ? std::clamp((aPoint - aStart).Dot(segment) / lengthSquared, 0.0f, 1.0f) : 0.0f;
+			return aStart + segment * t;
+		}
+
+		// Plane projection when it falls inside, otherwise the best of the three edges
+		static Vec3f ClosestOnTriangle(const Vec3f& aPoint, const Vec3f& aA, const Vec3f& aB, const Vec3f& aC)
+		{
+			Vec3f normal = (aB - aA).Cross(aC - aA);
+			normal.Normalize();
+			const Vec3f projected = aPoint - normal * (aPoint - aA).Dot(normal);
+			const bool inside = (aB - aA).Cross(projected - aA).Dot(normal) >= 0.0f && (aC - aB).Cross(projected - aB).Dot(normal) >= 0.0f && (aA - aC).Cross(projected - aC).Dot(normal) >= 0.0f;
+			if (inside)
+			{
+				return projected;
+			}
+			const Vec3f candidates[3] = { ClosestOnSegment(aPoint, aA, aB), ClosestOnSegment(aPoint, aB, aC), ClosestOnSegment(aPoint, aC, aA) };
+			Vec3f best = candidates[0];
+			for (const Vec3f& candidate : candidates)
+			{
+				if ((candidate - aPoint).Dot(candidate - aPoint) < (best - aPoint).Dot(best - aPoint))
+				{
+					best = candidate;
+				}
+			}
+			return best;
+		}
+
+		// Distance between two segments by sampling the first one densely
+		static float SegmentDistance(const Vec3f& aStartOne, const Vec3f& aEndOne, const Vec3f& aStartTwo, const Vec3f& aEndTwo)
+		{
+			float best = FLT_MAX;
+			for (int step = 0; step <= 4000; step++)
+			{
+				const Vec3f point = aStartOne + (aEndOne - aStartOne) * (step / 4000.0f);
+				Vec3f delta = ClosestOnSegment(point, aStartTwo, aEndTwo) - point;
+				best = std::min(best, delta.Length());
+			}
+			return best;
+		}
+
+		// Separating axis test by projecting all eight corners of both boxes on the 15 axes
+		static float ObbDepthReference(const BB::Collision::Obb& aOne, const BB::Collision::Obb& aTwo)
+		{
+			Vec3f axesOne[3] = { aOne.orientation.Rotate(Vec3f(1.0f, 0.0f, 0.0f)), aOne.orientation.Rotate(Vec3f(0.0f, 1.0f, 0.0f)), aOne.orientation.Rotate(Vec3f(0.0f, 0.0f, 1.0f)) };
+			Vec3f axesTwo[3] = { aTwo.orientation.Rotate(Vec3f(1.0f, 0.0f, 0.0f)), aTwo.orientation.Rotate(Vec3f(0.0f, 1.0f, 0.0f)), aTwo.orientation.Rotate(Vec3f(0.0f, 0.0f, 1.0f)) };
+			std::vector<Vec3f> axes(axesOne, axesOne + 3);
+			axes.insert(axes.end(), axesTwo, axesTwo + 3);
+			for (const Vec3f& axisOne : axesOne)
+			{
+				for (const Vec3f& axisTwo : axesTwo)
+				{
+					Vec3f axis = axisOne.Cross(axisTwo);
+					if (axis.Length() > 1e-3f)
+					{
+						axes.push_back(axis.GetNormalized());
+					}
+				}
+			}
+
+			const auto project = [](const BB::Collision::Obb& aBox, const Vec3f aBoxAxes[3], const Vec3f& aAxis, float& aOutMin, float& aOutMax)
+			{
+				aOutMin = FLT_MAX;
+				aOutMax = -FLT_MAX;
+				for (int corner = 0; corner < 8; corner++)
+				{
+					Vec3f point = aBox.center;
+					point += aBoxAxes[0] * (corner & 1 ? aBox.halfExtents.x : -aBox.halfExtents.x);
+					point += aBoxAxes[1] * (corner & 2 ? aBox.halfExtents.y : -aBox.halfExtents.y);
+					point += aBoxAxes[2] * (corner & 4 ? aBox.halfExtents.z : -aBox.halfExtents.z);
+					aOutMin = std::min(aOutMin, point.Dot(aAxis));
+					aOutMax = std::max(aOutMax, point.Dot(aAxis));
+				}
+			};
+
+			// Overlap when pushing box two out along the axis pointing from one to two
+			float depth = FLT_MAX;
+			for (Vec3f axis : axes)
+			{
+				if ((aTwo.center - aOne.center).Dot(axis) < 0.0f)
+				{
+					axis = axis * -1.0f;
+				}
+				float minOne, maxOne, minTwo, maxTwo;
+				project(aOne, axesOne, axis, minOne, maxOne);
+				project(aTwo, axesTwo, axis, minTwo, maxTwo);
+				depth = std::min(depth, maxOne - minTwo);
+			}
+			return depth;
+		}
+
+	public:
+		TEST_METHOD(Closest_Points)
+		{
+			// 21 is not a multiple of the packet size, the tail repeats the last pair
+			const size_t count = 21;
+			std::vector<Vec3f> points(count), a(count), b(count), c(count), onSegments(count), onTriangles(count);
+			for (size_t i = 0; i < count; i++)
+			{
+				points[i] = RandomPoint(3.0f);
+				a[i] = RandomPoint(1.0f);
+				b[i] = RandomPoint(1.0f);
+				c[i] = RandomPoint(1.0f);
+			}
+			// A zero length segment returns its start
+			b[3] = a[3];
+
+			BB::Collision::ClosestPointsOnSegments(points.data(), a.data(), b.data(), onSegments.data(), count);
+			BB::Collision::ClosestPointsOnTriangles(points.data(), a.data(), b.data(), c.data(), onTriangles.data(), count);
+			for (size_t i = 0; i < count; i++)
+			{
+				Assert::IsTrue((onSegments[i] - ClosestOnSegment(points[i], a[i], b[i])).Length() < 1e-4f, L"Wrong closest point on segment");
+				if (i != 3)
+				{
+					Assert::IsTrue((onTriangles[i] - ClosestOnTriangle(points[i], a[i], b[i], c[i])).Length() < 1e-4f, L"Wrong closest point on triangle");
+				}
+				Assert::AreEqual(0.0f, _mm_cvtss_f32(_mm_shuffle_ps(onSegments[i].data, onSegments[i].data, _MM_SHUFFLE(3, 3, 3, 3))), L"Vec3f outputs keep w = 0");
+			}
+		}
+
+		TEST_METHOD(Round_Shapes)
+		{
+			const size_t count = 203;
+			std::vector<BB::Collision::Sphere> spheres(count), otherSpheres(count);
+			std::vector<BB::Collision::Capsule> capsules(count), otherCapsules(count);
+			for (size_t i = 0; i < count; i++)
+			{
+				spheres[i] = { RandomPoint(2.0f), BB::Random(0.1f, 1.0f) };
+				otherSpheres[i] = { RandomPoint(2.0f), BB::Random(0.1f, 1.0f) };
+				capsules[i] = { RandomPoint(2.0f), RandomPoint(2.0f), BB::Random(0.1f, 1.0f) };
+				otherCapsules[i] = { RandomPoint(2.0f), RandomPoint(2.0f), BB::Random(0.1f, 1.0f) };
+			}
+			// Coinciding centers and parallel capsules
+			otherSpheres[5].center = spheres[5].center;
+			capsules[6] = { Vec3f(-1.0f, 0.0f, 0.0f), Vec3f(1.0f, 0.0f, 0.0f), 0.3f };
+			otherCapsules[6] = { Vec3f(-0.5f, 0.5f, 0.0f), Vec3f(1.5f, 0.5f, 0.0f), 0.3f };
+
+			BB::Collision::ContactArray sphereSphere, sphereCapsule, capsuleCapsule;
+			BB::Collision::SphereSphere(spheres.data(), otherSpheres.data(), count, sphereSphere);
+			BB::Collision::SphereCapsule(spheres.data(), capsules.data(), count, sphereCapsule);
+			BB::Collision::CapsuleCapsule(capsules.data(), otherCapsules.data(), count, capsuleCapsule);
+			Assert::AreEqual(count, capsuleCapsule.GetCount());
+
+			size_t touching = 0;
+			for (size_t i = 0; i < count; i++)
+			{
+				Vec3f delta = otherSpheres[i].center - spheres[i].center;
+				Assert::AreEqual(spheres[i].radius + otherSpheres[i].radius - delta.Length(), sphereSphere.GetDepth(i), 1e-4f, L"Wrong sphere-sphere depth");
+				Vec3f normal = sphereSphere.GetNormal(i);
+				Assert::AreEqual(1.0f, normal.Length(), 1e-4f, L"Normals are unit length");
+				Assert::IsTrue(i == 5 || (normal - delta.GetNormalized()).Length() < 1e-4f, L"The normal points from shape one to shape two");
+				Assert::IsTrue((sphereSphere.GetPoint(i) - (otherSpheres[i].center - normal * otherSpheres[i].radius)).Length() < 1e-4f, L"Wrong sphere-sphere point");
+
+				Vec3f toCapsule = ClosestOnSegment(spheres[i].center, capsules[i].start, capsules[i].end) - spheres[i].center;
+				Assert::AreEqual(spheres[i].radius + capsules[i].radius - toCapsule.Length(), sphereCapsule.GetDepth(i), 1e-4f, L"Wrong sphere-capsule depth");
+
+				const float distance = SegmentDistance(capsules[i].start, capsules[i].end, otherCapsules[i].start, otherCapsules[i].end);
+				Assert::AreEqual(capsules[i].radius + otherCapsules[i].radius - distance, capsuleCapsule.GetDepth(i), 2e-3f, L"Wrong capsule-capsule depth");
+				touching += capsuleCapsule.IsTouching(i);
+			}
+			Assert::AreEqual(Vec3f(0.0f, 1.0f, 0.0f).y, sphereSphere.GetNormal(5).y, L"Coinciding centers use +y");
+			Assert::AreEqual(0.1f, capsuleCapsule.GetDepth(6), 1e-4f, L"Parallel capsules");
+			Assert::AreEqual(touching, capsuleCapsule.CountTouching());
+		}
+
+		TEST_METHOD(Obb_Separating_Axes)
+		{
+			BB::Collision::Obb boxOne;
+			boxOne.halfExtents = Vec3f(1.0f);
+			BB::Collision::Obb boxTwo;
+			boxTwo.center = Vec3f(1.5f, 0.2f, 0.0f);
+			boxTwo.halfExtents = Vec3f(1.0f);
+			BB::Collision::ContactArray contacts;
+			BB::Collision::ObbObb(&boxOne, &boxTwo, 1, contacts);
+			Assert::AreEqual(0.5f, contacts.GetDepth(0), 1e-5f, L"Aligned boxes overlap by 0.5");
+			Assert::AreEqual(1.0f, contacts.GetNormal(0).x, 1e-5f, L"Aligned boxes separate along +x");
+			Assert::AreEqual(0.5f, contacts.GetPoint(0).x, 1e-5f, L"The contact point is the deepest corner of box two");
+
+			const size_t count = 300;
+			std::vector<BB::Collision::Obb> one(count), two(count);
+			for (size_t i = 0; i < count; i++)
+			{
+				one[i] = { RandomPoint(1.5f), Vec3f(BB::Random(0.2f, 1.0f), BB::Random(0.2f, 1.0f), BB::Random(0.2f, 1.0f)), RandomRotation() };
+				two[i] = { RandomPoint(1.5f), Vec3f(BB::Random(0.2f, 1.0f), BB::Random(0.2f, 1.0f), BB::Random(0.2f, 1.0f)), RandomRotation() };
+			}
+			BB::Collision::ObbObb(one.data(), two.data(), count, contacts);
+
+			size_t touching = 0;
+			for (size_t i = 0; i < count; i++)
+			{
+				Assert::AreEqual(ObbDepthReference(one[i], two[i]), contacts.GetDepth(i), 1e-3f, L"Wrong OBB depth");
+				Assert::IsTrue((two[i].center - one[i].center).Dot(contacts.GetNormal(i)) >= -1e-5f, L"The OBB normal points from box one to box two");
+				touching += contacts.IsTouching(i);
+			}
+			Assert::IsTrue(touching > 0 && touching < count, L"The random boxes should include hits and misses");
+		}
+
+		TEST_METHOD(Packet_Cycles)
+		{
+			const size_t count = 100000;
+			std::vector<BB::Collision::Capsule> one(count), two(count);
+			std::vector<BB::Collision::Obb> boxesOne(count), boxesTwo(count);
+			for (size_t i = 0; i < count; i++)
+			{
+				one[i] = { RandomPoint(2.0f), RandomPoint(2.0f), BB::Random(0.1f, 1.0f) };
+				two[i] = { RandomPoint(2.0f), RandomPoint(2.0f), BB::Random(0.1f, 1.0f) };
+				boxesOne[i] = { RandomPoint(1.5f), Vec3f(0.5f), RandomRotation() };
+				boxesTwo[i] = { RandomPoint(1.5f), Vec3f(0.5f), RandomRotation() };
+			}
+
+			BB::Collision::ContactArray contacts(count);
+			unsigned long long start = __rdtsc();
+			BB::Collision::CapsuleCapsule(one.data(), two.data(), count, contacts);
+			unsigned long long packets = __rdtsc() - start;
+			start = __rdtsc();
+			BB::Collision::ObbObb(boxesOne.data(), boxesTwo.data(), count, contacts);
+			unsigned long long boxPackets = __rdtsc() - start;
+
+			// The same capsule query one pair at a time with Vec3f and branches
+			std::vector<float> depths(count);
+			start = __rdtsc();
+			for (size_t i = 0; i < count; i++)
+			{
+				const Vec3f directionOne = one[i].end - one[i].start;
+				const Vec3f directionTwo = two[i].end - two[i].start;
+				const Vec3f startDelta = one[i].start - two[i].start;
+				const float a = directionOne.Dot(directionOne), e = directionTwo.Dot(directionTwo), f = directionTwo.Dot(startDelta);
+				const float c = directionOne.Dot(startDelta), b = directionOne.Dot(directionTwo);
+				const float denominator = a * e - b * b;
+				float s = denominator != 0.0f ? std::clamp((b * f - c * e) / denominator, 0.0f, 1.0f) : 0.0f;
+				float t = (b * s + f) / e;
+				if (t < 0.0f)
+				{
+					t = 0.0f;
+					s = std::clamp(-c / a, 0.0f, 1.0f);
+				}
+				else if (t > 1.0f)
+				{
+					t = 1.0f;
+					s = std::clamp((b - c) / a, 0.0f, 1.0f);
+				}
+				Vec3f delta = (two[i].start + directionTwo * t) - (one[i].start + directionOne * s);
+				depths[i] = one[i].radius + two[i].radius - delta.Length();
+			}
+			unsigned long long scalar = __rdtsc() - start;
+
+			for (size_t i = 0; i < count; i += 97)
+			{
+				BB::Collision::CapsuleCapsule(&one[i], &two[i], 1, contacts);
+				Assert::AreEqual(depths[i], contacts.GetDepth(0), 1e-4f, L"The scalar reference should agree");
+			}
+
+			char message[256];
+			snprintf(message, sizeof(message), "Collision %zu pairs, cycles per pair: capsule-capsule packets %.2f, scalar %.2f, OBB-OBB packets %.2f\n",
+				count, double(packets) / count, double(scalar) / count, double(boxPackets) / count);
+			Logger::WriteMessage(message);
+		}
+	};
+
+	TEST_CLASS(ConvexQueries)
+	{
+		// Distance between two segments in double precision, Real-Time Collision Detection 5.1.9
+		static double SegmentDistanceReference(const Vec3f& aStartOne, const Vec3f& aEndOne, const Vec3f& aStartTwo, const Vec3f& aEndTwo)
+		{
+			const double directionOne[3] = { double(aEndOne.x) - aStartOne.x, double(aEndOne.y) - aStartOne.y, double(aEndOne.z) - aStartOne.z };
+			const double directionTwo[3] = { double(aEndTwo.x) - aStartTwo.x, double(aEndTwo.y) - aStartTwo.y, double(aEndTwo.z) - aStartTwo.z };
+			const double offset[3] = { double(aStartOne.x) - aStartTwo.x, double(aStartOne.y) - aStartTwo.y, double(aStartOne.z) - aStartTwo.z };
+			const auto dot = [](const double aOne[3], const double aTwo[3]) { return aOne[0] * aTwo[0] + aOne[1] * aTwo[1] + aOne[2] * aTwo[2]; };
+			const double a = dot(directionOne, directionOne);
+			const double b = dot(directionOne, directionTwo);
+			const double c = dot(directionOne, offset);
+			const double e = dot(directionTwo, directionTwo);
+			const double f = dot(directionTwo, offset);
+			const double denominator = a * e - b * b;
+			double s = denominator > 0.0 ? std::clamp((b * f - c * e) / denominator, 0.0, 1.0) : 0.0;
+			double t = (b * s + f) / e;
+			if (t < 0.0)
+			{
+				t = 0.0;
+				s = std::clamp(-c / a, 0.0, 1.0);
+			}
+			else if (t > 1.0)
+			{
+				t = 1.0;
+				s = std::clamp((b - c) / a, 0.0, 1.0);
+			}
+			double distanceSquared = 0.0;
+			for (int axis = 0; axis < 3; axis++)
+			{
+				const double difference = offset[axis] + directionOne[axis] * s - directionTwo[axis] * t;
+				distanceSquared += difference * difference;
+			}
+			return std::sqrt(distanceSquared);
+		}
+
+		static void BoxCorners(const Vec3f& aHalfExtents, Vec3f aOutCorners[8])
+		{
+			for (int corner = 0; corner < 8; corner++)
+			{
+				aOutCorners[corner] = Vec3f(corner & 1 ? aHalfExtents.x : -aHalfExtents.x, corner & 2 ? aHalfExtents.y : -aHalfExtents.y, corner & 4 ? aHalfExtents.z : -aHalfExtents.z);
+			}
+		}
+
+	public:
+		TEST_METHOD(Support_Index_Scan)
+		{
+			std::vector<Vec3f> vertices(77);
+			for (Vec3f& vertex : vertices)
+			{
+				vertex = RandomPoint(5.0f);
+			}
+			for (size_t count : { size_t(1), size_t(7), size_t(8), size_t(13), size_t(77) })
+			{
+				for (int query = 0; query < 50; query++)
+				{
+					const Vec3f direction = RandomPoint(1.0f);
+					size_t expected = 0;
+					for (size_t i = 1; i < count; i++)
+					{
+						if (vertices[i].Dot(direction) > vertices[expected].Dot(direction))
+						{
+							expected = i;
+						}
+					}
+					Assert::AreEqual(expected, BB::Collision::SupportIndex(vertices.data(), count, direction), L"SIMD scan picked the wrong vertex");
+				}
+			}
+		}
+
+		TEST_METHOD(Spheres_And_Capsules)
+		{
+			for (int pair = 0; pair < 2000; pair++)
+			{
+				const BB::Collision::Sphere one = { RandomPoint(2.0f), BB::Random(0.1f, 1.0f) };
+				const BB::Collision::Sphere two = { RandomPoint(2.0f), BB::Random(0.1f, 1.0f) };
+				Vec3f delta = two.center - one.center;
+				const float gap = delta.Length() - one.radius - two.radius;
+
+				const BB::Collision::GjkResult result = BB::Collision::GjkDistance(one, two);
+				Assert::IsTrue(result.converged, L"Sphere distance did not converge");
+				BB::Collision::PenetrationResult penetration;
+				if (gap > 1e-4f)
+				{
+					Assert::IsFalse(result.intersecting, L"Separated spheres reported as intersecting");
+					Assert::IsFalse(BB::Collision::GjkIntersect(one, two), L"Early out intersection differs");
+					Assert::AreEqual(gap, result.distance, 1e-4f, L"Wrong sphere distance");
+					Assert::IsTrue((result.pointOne - (one.center + delta.GetNormalized() * one.radius)).Length() < 1e-4f, L"Wrong closest point");
+					Assert::IsFalse(BB::Collision::Penetration(one, two, penetration));
+				}
+				else if (gap < -1e-4f)
+				{
+					Assert::IsTrue(result.intersecting, L"Overlapping spheres reported as separated");
+					Assert::IsTrue(BB::Collision::GjkIntersect(one, two), L"Early out intersection differs");
+					Assert::IsTrue(BB::Collision::Penetration(one, two, penetration));
+					Assert::AreEqual(-gap, penetration.depth, 1e-4f, L"Wrong sphere depth");
+					Assert::IsTrue(penetration.normal.Dot(delta.GetNormalized()) > 0.9999f, L"The normal points from one to two");
+				}
+			}
+
+			const size_t count = 5000;
+			std::vector<BB::Collision::Capsule> ones(count), twos(count);
+			for (size_t pair = 0; pair < count; pair++)
+			{
+				ones[pair] = { RandomPoint(2.0f), RandomPoint(2.0f), BB::Random(0.1f, 0.6f) };
+				twos[pair] = { RandomPoint(2.0f), RandomPoint(2.0f), BB::Random(0.1f, 0.6f) };
+			}
+			BB::Collision::ContactArray contacts;
+			BB::Collision::CapsuleCapsule(ones.data(), twos.data(), count, contacts);
+			size_t separated = 0;
+			size_t overlapping = 0;
+			for (size_t pair = 0; pair < count; pair++)
+			{
+				const BB::Collision::Capsule& one = ones[pair];
+				const BB::Collision::Capsule& two = twos[pair];
+				const double gap = SegmentDistanceReference(one.start, one.end, two.start, two.end) - one.radius - two.radius;
+
+				const BB::Collision::GjkResult result = BB::Collision::GjkDistance(one, two);
+				Assert::IsTrue(result.converged, L"Capsule distance did not converge");
+				BB::Collision::PenetrationResult penetration;
+				if (gap > 1e-4)
+				{
+					Assert::IsFalse(result.intersecting, L"Separated capsules reported as intersecting");
+					Assert::IsFalse(BB::Collision::GjkIntersect(one, two), L"Early out intersection differs");
+					Assert::IsFalse(BB::Collision::Penetration(one, two, penetration), L"Separated capsules have no penetration");
+					Assert::AreEqual(float(gap), result.distance, 1e-4f, L"GJK distance differs from the segment reference");
+					Assert::AreEqual(result.distance, (result.pointTwo - result.pointOne).Length(), 1e-4f, L"The closest points are distance apart");
+					Assert::AreEqual(-contacts.GetDepth(pair), result.distance, 1e-3f, L"GJK and the packet capsule query disagree");
+					separated++;
+				}
+				else if (gap < -1e-4)
+				{
+					Assert::IsTrue(result.intersecting, L"Overlapping capsules reported as separated");
+					Assert::IsTrue(BB::Collision::GjkIntersect(one, two), L"Early out intersection differs");
+					Assert::IsTrue(BB::Collision::Penetration(one, two, penetration), L"Overlapping capsules have a penetration");
+					// Crossing segments go through EPA on the rounded shapes, which stops at a tolerance
+					const float tolerance = gap + one.radius + two.radius > 1e-3 ? 1e-4f : 1e-2f;
+					Assert::AreEqual(float(-gap), penetration.depth, tolerance, L"Penetration depth differs from the segment reference");
+					overlapping++;
+				}
+			}
+			Assert::IsTrue(separated > count / 4 && overlapping > count / 4, L"The random capsules should cover both cases");
+		}
+
+		TEST_METHOD(Hulls_Match_Separating_Axes)
+		{
+			const size_t count = 200;
+			std::vector<BB::Collision::Obb> ones(count), twos(count);
+			for (size_t pair = 0; pair < count; pair++)
+			{
+				ones[pair] = { RandomPoint(1.5f), Vec3f(BB::Random(0.2f, 1.0f), BB::Random(0.2f, 1.0f), BB::Random(0.2f, 1.0f)), RandomRotation() };
+				twos[pair] = { RandomPoint(1.5f), Vec3f(BB::Random(0.2f, 1.0f), BB::Random(0.2f, 1.0f), BB::Random(0.2f, 1.0f)), RandomRotation() };
+			}
+			BB::Collision::ContactArray contacts;
+			BB::Collision::ObbObb(ones.data(), twos.data(), count, contacts);
+
+			size_t penetrating = 0;
+			for (size_t pair = 0; pair < count; pair++)
+			{
+				// The same boxes as eight vertex hulls
+				Vec3f cornersOne[8], cornersTwo[8];
+				BoxCorners(ones[pair].halfExtents, cornersOne);
+				BoxCorners(twos[pair].halfExtents, cornersTwo);
+				const BB::Collision::ConvexHull hullOne = { cornersOne, 8, ones[pair].center, ones[pair].orientation };
+				const BB::Collision::ConvexHull hullTwo = { cornersTwo, 8, twos[pair].center, twos[pair].orientation };
+
+				const float depth = contacts.GetDepth(pair);
+				if (depth > 1e-3f)
+				{
+					BB::Collision::PenetrationResult hullResult, boxResult;
+					Assert::IsTrue(BB::Collision::Penetration(hullOne, hullTwo, hullResult), L"Overlapping hulls");
+					Assert::IsTrue(BB::Collision::Penetration(ones[pair], twos[pair], boxResult), L"Overlapping boxes");
+					Assert::AreEqual(depth, hullResult.depth, 1e-3f, L"EPA depth differs from the separating axis depth");
+					Assert::AreEqual(depth, boxResult.depth, 1e-3f, L"EPA depth differs from the separating axis depth");
+					Assert::AreEqual(1.0f, hullResult.normal.Dot(contacts.GetNormal(pair)), 1e-2f, L"EPA normal differs from the separating axis");
+					penetrating++;
+				}
+				else if (depth < -1e-3f)
+				{
+					Assert::IsFalse(BB::Collision::GjkIntersect(hullOne, hullTwo), L"Separated hulls");
+					const BB::Collision::GjkResult result = BB::Collision::GjkDistance(hullOne, hullTwo);
+					Assert::IsFalse(result.intersecting);
+					Vec3f gap = result.pointTwo - result.pointOne;
+					Assert::AreEqual(result.distance, gap.Length(), 1e-4f, L"The closest points are distance apart");
+					// The separating axis depth is a lower bound of the separation
+					Assert::IsTrue(result.distance >= -depth - 1e-4f, L"GJK distance below the separating axis bound");
+				}
+			}
+			Assert::IsTrue(penetrating > 10, L"The random boxes should overlap often enough");
+		}
+
+		TEST_METHOD(Warm_Start_Cycles)
+		{
+			std::vector<Vec3f> vertices(64);
+			for (Vec3f& vertex : vertices)
+			{
+				vertex = RandomPoint(1.0f);
+			}
+			BB::Collision::ConvexHull one = { vertices.data(), vertices.size(), Vec3f(0.0f), Quatf() };
+			BB::Collision::ConvexHull two = { vertices.data(), vertices.size(), Vec3f(3.0f, 0.0f, 0.0f), Quatf() };
+
+			BB::Collision::GjkCache cache;
+			int coldIterations = 0;
+			int warmIterations = 0;
+			unsigned long long cold = 0;
+			unsigned long long warm = 0;
+			const int frames = 200;
+			for (int frame = 0; frame < frames; frame++)
+			{
+				// Slowly approaching, spinning hulls
+				two.position = Vec3f(3.0f - frame * 0.005f, 0.1f * std::sin(frame * 0.05f), 0.0f);
+				two.orientation = Quatf::FromAxisAngle(Vec3f(0.0f, 1.0f, 0.0f), frame * 0.01f);
+
+				unsigned long long start = __rdtsc();
+				const BB::Collision::GjkResult coldResult = BB::Collision::GjkDistance(one, two);
+				cold += __rdtsc() - start;
+				start = __rdtsc();
+				const BB::Collision::GjkResult warmResult = BB::Collision::GjkDistance(one, two, &cache);
+				warm += __rdtsc() - start;
+
+				coldIterations += coldResult.iterations;
+				warmIterations += warmResult.iterations;
+				Assert::AreEqual(coldResult.intersecting, warmResult.intersecting, L"Warm starting changes the answer");
+				Assert::AreEqual(coldResult.distance, warmResult.distance, 1e-4f, L"Warm starting changes the distance");
+			}
+			Assert::IsTrue(warmIterations < coldIterations, L"Cached simplices should save iterations");
+
+			char message[256];
+			snprintf(message, sizeof(message), "GJK 64 vertex hulls over %d frames: iterations cold %d, warm %d, cycles per query cold %.0f, warm %.0f\n",
+				frames, coldIterations, warmIterations, double(cold) / frames, double(warm) / frames);
+			Logger::WriteMessage(message);
+		}
+	};
+
+	TEST_CLASS(Broadphase)
+	{
+		static void RandomBox(float aWorldSize, float aMinSize, float aMaxSize, Vec3f& aOutMin, Vec3f& aOutMax)
+		{
+			const Vec3f center(BB::Random(0.0f, aWorldSize), BB::Random(-aWorldSize, aWorldSize), BB::Random(-aWorldSize, 0.0f));
+			const Vec3f halfSize(BB::Random(aMinSize, aMaxSize), BB::Random(aMinSize, aMaxSize), BB::Random(aMinSize, aMaxSize));
+			aOutMin = center - halfSize * 0.5f;
+			aOutMax = center + halfSize * 0.5f;
+		}
+
+		static std::vector<uint64_t> SortedPairs(const std::vector<BB::BroadphasePair>& aPairs)
+		{
+			std::vector<uint64_t> keys;
+			for (const BB::BroadphasePair& pair : aPairs)
+			{
+				Assert::IsTrue(pair.one < pair.two, L"Pairs are ordered one < two");
+				keys.push_back((uint64_t(pair.one) << 32) | pair.two);
+			}
+			std::sort(keys.begin(), keys.end());
+			return keys;
+		}
+
+		static std::vector<uint64_t> BruteForcePairs(const std::vector<Vec3f>& aMin, const std::vector<Vec3f>& aMax, const std::vector<bool>& aAlive)
+		{
+			std::vector<uint64_t> keys;
+			for (size_t one = 0; one < aMin.size(); one++)
+			{
+				for (size_t two = one + 1; two < aMin.size(); two++)
+				{
+					if (aAlive[one] && aAlive[two] && aMin[one].x <= aMax[two].x && aMin[two].x <= aMax[one].x && aMin[one].y <= aMax[two].y && aMin[two].y <= aMax[one].y && aMin[one].z <= aMax[two].z && aMin[two].z <= aMax[one].z)
+					{
+						keys.push_back((uint64_t(one) << 32) | two);
+					}
+				}
+			}
+			return keys;
+		}
+
+		template<class TBroadphase>
+		static void CheckAgainstBruteForce(TBroadphase& aBroadphase, float aMinSize, float aMaxSize)
+		{
+			BB::ThreadPoolSettings poolSettings;
+			poolSettings.workerCount = 3;
+			BB::ThreadPool pool(poolSettings);
+
+			const size_t count = 3000;
+			const float worldSize = 20.0f;
+			std::vector<Vec3f> mins(count), maxs(count);
+			std::vector<bool> alive(count, true);
+			for (size_t i = 0; i < count; i++)
+			{
+				RandomBox(worldSize, aMinSize, aMaxSize, mins[i], maxs[i]);
+				Assert::AreEqual(BB::BroadphaseId(i), aBroadphase.Insert(mins[i], maxs[i]), L"Ids are handed out in order");
+			}
+
+			std::vector<BB::BroadphasePair> pairs, parallelPairs;
+			for (int frame = 0; frame < 3; frame++)
+			{
+				aBroadphase.FindPairs(pairs);
+				aBroadphase.FindPairs(pool, parallelPairs);
+				const std::vector<uint64_t> expected = BruteForcePairs(mins, maxs, alive);
+				Assert::IsTrue(expected.size() > count / 4, L"The scene should have a fair number of pairs");
+				Assert::IsTrue(SortedPairs(pairs) == expected, L"Pairs differ from the brute force ones");
+				Assert::IsTrue(SortedPairs(parallelPairs) == expected, L"Parallel pairs differ from the brute force ones");
+
+				// Move a third of the objects, remove some and reuse their ids
+				for (size_t i = 0; i < count; i += 3)
+				{
+					if (alive[i])
+					{
+						RandomBox(worldSize, aMinSize, aMaxSize, mins[i], maxs[i]);
+						aBroadphase.Update(BB::BroadphaseId(i), mins[i], maxs[i]);
+					}
+				}
+				for (size_t i = frame; i < count; i += 10)
+				{
+					if (alive[i])
+					{
+						aBroadphase.Remove(BB::BroadphaseId(i));
+						alive[i] = false;
+					}
+				}
+				for (size_t i = frame; i < count; i += 20)
+				{
+					Vec3f boxMin, boxMax;
+					RandomBox(worldSize, aMinSize, aMaxSize, boxMin, boxMax);
+					const BB::BroadphaseId id = aBroadphase.Insert(boxMin, boxMax);
+					Assert::IsTrue(id < count && !alive[id], L"Insert reuses removed ids");
+					mins[id] = boxMin;
+					maxs[id] = boxMax;
+					alive[id] = true;
+				}
+			}
+		}
+
+	public:
+		TEST_METHOD(Sweep_And_Prune_Pairs)
+		{
+			BB::SweepAndPrune broadphase;
+			CheckAgainstBruteForce(broadphase, 0.1f, 4.0f);
+		}
+
+		TEST_METHOD(Sweep_And_Prune_Infinite_Box)
+		{
+			const float infinity = std::numeric_limits<float>::infinity();
+			BB::SweepAndPrune broadphase;
+			std::vector<Vec3f> mins, maxs;
+			std::vector<BB::BroadphasePair> pairs;
+			// Counts around a multiple of eight, the sweep of the plane ends in a partial Float8
+			for (size_t count = 1; count < 20; count++)
+			{
+				const Vec3f boxMin = count == 1 ? Vec3f(-infinity, -1.0f, -1.0f) : Vec3f(BB::Random(-5.0f, 5.0f), BB::Random(-2.0f, 2.0f), BB::Random(-2.0f, 2.0f));
+				const Vec3f boxMax = count == 1 ? Vec3f(infinity, 1.0f, 1.0f) : boxMin + Vec3f(0.5f, 0.5f, 0.5f);
+				broadphase.Insert(boxMin, boxMax);
+				mins.push_back(boxMin);
+				maxs.push_back(boxMax);
+
+				broadphase.FindPairs(pairs);
+				Assert::IsTrue(SortedPairs(pairs) == BruteForcePairs(mins, maxs, std::vector<bool>(count, true)), L"Pairs with an infinite box differ from the brute force ones");
+			}
+		}
+
+		TEST_METHOD(Hash_Grid_Pairs)
+		{
+			BB::HashGrid broadphase(1.5f);
+			CheckAgainstBruteForce(broadphase, 1.0f, 1.5f);
+			Assert::IsTrue(broadphase.GetCellCount() > 0 && broadphase.GetCellCount() <= broadphase.GetCount());
+		}
+
+		TEST_METHOD(Pairs_Cycles_200k)
+		{
+			BB::ThreadPoolSettings poolSettings;
+			poolSettings.workerCount = 3;
+			BB::ThreadPool pool(poolSettings);
+
+			const size_t count = 200000;
+			const float worldSize = 50.0f;
+			BB::SweepAndPrune sweep;
+			BB::HashGrid grid(1.0f);
+			std::vector<Vec3f> mins(count), maxs(count);
+			for (size_t i = 0; i < count; i++)
+			{
+				RandomBox(worldSize, 0.5f, 1.0f, mins[i], maxs[i]);
+				sweep.Insert(mins[i], maxs[i]);
+				grid.Insert(mins[i], maxs[i]);
+			}
+
+			std::vector<BB::BroadphasePair> pairs;
+			unsigned long long start = __rdtsc();
+			sweep.FindPairs(pairs);
+			unsigned long long sweepSerial = __rdtsc() - start;
+			const size_t pairCount = pairs.size();
+			start = __rdtsc();
+			sweep.FindPairs(pool, pairs);
+			unsigned long long sweepParallel = __rdtsc() - start;
+			Assert::AreEqual(pairCount, pairs.size());
+
+			start = __rdtsc();
+			grid.FindPairs(pairs);
+			unsigned long long gridSerial = __rdtsc() - start;
+			Assert::AreEqual(pairCount, pairs.size(), L"Both broadphases find the same pairs");
+			start = __rdtsc();
+			grid.FindPairs(pool, pairs);
+			unsigned long long gridParallel = __rdtsc() - start;
+
+			// A small move of every object, the part of a tick spent in Update
+			start = __rdtsc();
+			for (size_t i = 0; i < count; i++)
+			{
+				const Vec3f step(0.05f, 0.0f, -0.05f);
+				grid.Update(BB::BroadphaseId(i), mins[i] + step, maxs[i] + step);
+			}
+			unsigned long long gridUpdate = __rdtsc() - start;
+
+			char message[320];
+			snprintf(message, sizeof(message), "Broadphase %zu boxes, %zu pairs, cycles per box: sweep-and-prune %.1f, on 4 threads %.1f, hash grid %.1f, on 4 threads %.1f, grid update %.1f\n",
+				count, pairCount, double(sweepSerial) / count, double(sweepParallel) / count, double(gridSerial) / count, double(gridParallel) / count, double(gridUpdate) / count);
+			Logger::WriteMessage(message);
+		}
+	};
+}
+
+namespace Quaternion
+{
+	TEST_CLASS(Quatf_Rotation)
+	{
+		static Vec3f TransformRow(const Mat4x4f& aMatrix, const Vec3f& aVector)
+		{
+			const float* m = aMatrix.data;
+			return Vec3f(aVector.x * m[0] + aVector.y * m[4] + aVector.z * m[8], aVector.x * m[1] + aVector.y * m[5] + aVector.z * m[9], aVector.x * m[2] + aVector.y * m[6] + aVector.z * m[10]);
+		}
+
+	public:
+		TEST_METHOD(AxisAngle_Rotate)
+		{
+			const Quatf quarter = Quatf::FromAxisAngle(Vec3f(0.0f, 0.0f, 1.0f), BB::PI_HALF_F);
+			Assert::IsTrue((quarter.Rotate(Vec3f(1.0f, 0.0f, 0.0f)) - Vec3f(0.0f, 1.0f, 0.0f)).Length() < 1e-6f, L"90 degrees around z should take x to y");
+			Assert::IsTrue(BB::QUATF_IDENTITY.Rotate(Vec3f(1.0f, 2.0f, 3.0f)) == Vec3f(1.0f, 2.0f, 3.0f), L"The identity should not rotate");
+			Assert::AreEqual(1.0f, quarter.Length(), 1e-6f);
+		}
+
+		TEST_METHOD(Product_Conjugate_Matrix)
+		{
+			for (int i = 0; i < 100; i++)
+			{
+				const Quatf one = RandomRotation();
+				const Quatf two = RandomRotation();
+				const Vec3f vector(BB::Random(-5.0f, 5.0f), BB::Random(-5.0f, 5.0f), BB::Random(-5.0f, 5.0f));
+
+				Assert::IsTrue(((one * two).Rotate(vector) - one.Rotate(two.Rotate(vector))).Length() < 1e-4f, L"one * two should apply two first");
+				Assert::IsTrue((one.GetConjugate().Rotate(one.Rotate(vector)) - vector).Length() < 1e-4f, L"The conjugate should undo the rotation");
+				Assert::IsTrue((TransformRow(one.ToMat4x4f(), vector) - one.Rotate(vector)).Length() < 1e-4f, L"ToMat4x4f should match Rotate");
+
+				const Quatf scaled(one.x * 3.0f, one.y * 3.0f, one.z * 3.0f, one.w * 3.0f);
+				Assert::AreEqual(1.0f, scaled.GetNormalized().Length(), 1e-6f, L"GetNormalized failed");
+			}
+		}
+	};
+}
@@ -0,0 +1,199 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "../MathLib/Scene/TransformHierarchy.h"
+#include "../MathLib/Matrix/Matrix4x4f/Matrix4x4f.h"
+#include "../MathLib/Parallel/ThreadPool.h"
+#include "../MathLib/Util/Random.h"
+
+#include <intrin.h>
+#include <vector>
+#include <cstdio>
+#include <cfloat>
+#include <cmath>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+struct Vec4Ref { float v[4]; };
+
+namespace Scene
+{
+	// Row vector times matrix, written out in scalar so it can be used as a reference
+	static Vec4Ref TransformReference(const Mat4x4f& aMatrix, float aX, float aY, float aZ, float aW)
+	{
+		Vec4Ref result;
+		for (int column = 0; column < 4; column++)
+		{
+			result.v[column] = aX * aMatrix.data[column] + aY * aMatrix.data[4 + column] + aZ * aMatrix.data[8 + column] + aW * aMatrix.data[12 + column];
+		}
+		return result;
+	}
+
+	TEST_CLASS(Hierarchy)
+	{
+		static Mat4x4f RandomLocal()
+		{
+			// Rotation around y followed by x, with a translation
+			const float yaw = BB::Random(-3.0f, 3.0f);
+			const float pitch = BB::Random(-3.0f, 3.0f);
+			const Mat4x4f rotationY(cosf(yaw), 0.0f, -sinf(yaw), 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, sinf(yaw), 0.0f, cosf(yaw), 0.0f, 0.0f, 0.0f, 0.0f, 1.0f);
+			const Mat4x4f rotationX(1.0f, 0.0f, 0.0f, 0.0f, 0.0f, cosf(pitch), sinf(pitch), 0.0f, 0.0f, -sinf(pitch), cosf(pitch), 0.0f, 0.0f, 0.0f, 0.0f, 1.0f);
+			Mat4x4f local = rotationY * rotationX;
+			local.SetTranslation(BB::Random(-5.0f, 5.0f), BB::Random(-5.0f, 5.0f), BB::Random(-5.0f, 5.0f));
+			return local;
+		}
+
+		// Builds a random tree, parents are always picked among the nodes added before
+		static std::vector<BB::TransformNodeId> BuildRandom(BB::TransformHierarchy& aHierarchy, size_t aCount)
+		{
+			std::vector<BB::TransformNodeId> nodes;
+			for (size_t i = 0; i < aCount; i++)
+			{
+				const BB::TransformNodeId parent = (i == 0 || BB::Random(0, 20) == 0) ? BB::INVALID_TRANSFORM_NODE : nodes[BB::Random(int(i * 3 / 4), int(i - 1))];
+				nodes.push_back(aHierarchy.AddNode(parent, RandomLocal(), Vec3f(-1.0f, -2.0f, -0.5f), Vec3f(1.0f, 0.5f, 2.0f)));
+			}
+			return nodes;
+		}
+
+		static Mat4x4f WorldReference(const BB::TransformHierarchy& aHierarchy, BB::TransformNodeId aNode)
+		{
+			const BB::TransformNodeId parent = aHierarchy.GetParent(aNode);
+			if (parent == BB::INVALID_TRANSFORM_NODE)
+			{
+				return aHierarchy.GetLocal(aNode);
+			}
+			return aHierarchy.GetLocal(aNode) * WorldReference(aHierarchy, parent);
+		}
+
+		static void AssertWorld(const BB::TransformHierarchy& aHierarchy, const std::vector<BB::TransformNodeId>& aNodes)
+		{
+			for (BB::TransformNodeId node : aNodes)
+			{
+				const Mat4x4f expected = WorldReference(aHierarchy, node);
+				const Mat4x4f& world = aHierarchy.GetWorld(node);
+				for (int i = 0; i < 16; i++)
+				{
+					Assert::AreEqual(expected.data[i], world.data[i], 0.001f, L"World matrix does not match the recursive reference");
+				}
+			}
+		}
+
+	public:
+		TEST_METHOD(World_Matches_Reference)
+		{
+			BB::TransformHierarchy hierarchy;
+			std::vector<BB::TransformNodeId> nodes = BuildRandom(hierarchy, 2000);
+
+			Assert::AreEqual(nodes.size(), hierarchy.Update(), L"The first Update should compute every node");
+			AssertWorld(hierarchy, nodes);
+			Assert::AreEqual(size_t(0), hierarchy.Update(), L"Nothing changed, nothing should be recomputed");
+
+			// Breadth-first: every parent is stored before its children
+			for (BB::TransformNodeId node : nodes)
+			{
+				const BB::TransformNodeId parent = hierarchy.GetParent(node);
+				Assert::IsTrue(parent == BB::INVALID_TRANSFORM_NODE || hierarchy.GetIndex(parent) < hierarchy.GetIndex(node), L"Parent stored after its child");
+			}
+
+			// Adding nodes after an update reorders the arrays but keeps the handles
+			std::vector<BB::TransformNodeId> more = BuildRandom(hierarchy, 10);
+			hierarchy.AddNode(nodes[5], RandomLocal());
+			hierarchy.Update();
+			AssertWorld(hierarchy, nodes);
+		}
+
+		TEST_METHOD(Only_Dirty_Subtrees)
+		{
+			BB::TransformHierarchy hierarchy;
+			// root -> a -> b, root -> c, and a second root d
+			const BB::TransformNodeId root = hierarchy.AddNode(BB::INVALID_TRANSFORM_NODE, RandomLocal());
+			const BB::TransformNodeId a = hierarchy.AddNode(root, RandomLocal());
+			const BB::TransformNodeId c = hierarchy.AddNode(root, RandomLocal());
+			const BB::TransformNodeId b = hierarchy.AddNode(a, RandomLocal());
+			const BB::TransformNodeId d = hierarchy.AddNode(BB::INVALID_TRANSFORM_NODE, RandomLocal());
+			hierarchy.Update();
+
+			hierarchy.SetLocal(a, RandomLocal());
+			Assert::AreEqual(size_t(2), hierarchy.Update(), L"Moving a should update a and b");
+			hierarchy.SetLocal(d, RandomLocal());
+			hierarchy.SetLocal(b, RandomLocal());
+			Assert::AreEqual(size_t(2), hierarchy.Update(), L"Moving d and b should update only them");
+			hierarchy.SetLocal(root, RandomLocal());
+			Assert::AreEqual(size_t(4), hierarchy.Update(), L"Moving the root should update its whole tree");
+			AssertWorld(hierarchy, { root, a, b, c, d });
+		}
+
+		TEST_METHOD(World_Bounds)
+		{
+			BB::TransformHierarchy hierarchy;
+			std::vector<BB::TransformNodeId> nodes = BuildRandom(hierarchy, 200);
+			hierarchy.Update();
+
+			for (BB::TransformNodeId node : nodes)
+			{
+				Vec3f boundsMin, boundsMax;
+				hierarchy.GetWorldBounds(node, boundsMin, boundsMax);
+				const Mat4x4f& world = hierarchy.GetWorld(node);
+
+				Vec3f cornersMin(FLT_MAX), cornersMax(-FLT_MAX);
+				for (int corner = 0; corner < 8; corner++)
+				{
+					const Vec4Ref point = TransformReference(world, corner & 1 ? 1.0f : -1.0f, corner & 2 ? 0.5f : -2.0f, corner & 4 ? 2.0f : -0.5f, 1.0f);
+					cornersMin = Min(cornersMin, Vec3f(point.v[0], point.v[1], point.v[2]));
+					cornersMax = Max(cornersMax, Vec3f(point.v[0], point.v[1], point.v[2]));
+				}
+				Assert::IsTrue((boundsMin - cornersMin).Length() < 0.001f && (boundsMax - cornersMax).Length() < 0.001f, L"World bounds should enclose the corners tightly");
+			}
+		}
+
+		TEST_METHOD(Parallel_And_Cycles)
+		{
+			BB::ThreadPoolSettings settings;
+			settings.workerCount = 3;
+			BB::ThreadPool pool(settings);
+
+			const size_t count = 200000;
+			BB::TransformHierarchy serial;
+			BB::TransformHierarchy parallel;
+			BB::GlobalRandomEngine.seed(7);
+			std::vector<BB::TransformNodeId> nodes = BuildRandom(serial, count);
+			BB::GlobalRandomEngine.seed(7);
+			BuildRandom(parallel, count);
+
+			unsigned long long start = __rdtsc();
+			serial.Update();
+			unsigned long long full = __rdtsc() - start;
+			parallel.Update(pool);
+
+			// Move 5% of the nodes
+			unsigned long long dirty = 0;
+			unsigned long long dirtyParallel = 0;
+			size_t updated = 0;
+			for (int frame = 0; frame < 4; frame++)
+			{
+				for (size_t i = 0; i < count / 20; i++)
+				{
+					const BB::TransformNodeId node = nodes[BB::Random(0, int(count - 1))];
+					const Mat4x4f local = RandomLocal();
+					serial.SetLocal(node, local);
+					parallel.SetLocal(node, local);
+				}
+				start = __rdtsc();
+				updated = serial.Update();
+				dirty += __rdtsc() - start;
+				start = __rdtsc();
+				Assert::AreEqual(updated, parallel.Update(pool), L"Parallel Update should recompute the same nodes");
+				dirtyParallel += __rdtsc() - start;
+			}
+
+			for (size_t i = 0; i < count; i += 97)
+			{
+				Assert::IsTrue(serial.GetWorld(nodes[i]) == parallel.GetWorld(nodes[i]), L"Parallel Update should match the serial one");
+			}
+
+			char message[256];
+			snprintf(message, sizeof(message), "TransformHierarchy %zu nodes, %zu levels, cycles per node: full %.2f, 5%% moved %.2f (%zu updated), 5%% moved on 4 threads %.2f\n",
+				count, serial.GetLevelCount(), double(full) / count, double(dirty) / 4 / count, updated, double(dirtyParallel) / 4 / count);
+			Logger::WriteMessage(message);
+		}
+	};
+}
@@ -0,0 +1,207 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "../MathLib/Spatial/KdTree.h"
+#include "../MathLib/Parallel/ThreadPool.h"
+#include "../MathLib/Util/Random.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace Spatial
+{
+	TEST_CLASS(KdTree)
+	{
+		static std::vector<Vec3f> RandomCloud(size_t aCount)
+		{
+			std::vector<Vec3f> points(aCount);
+			for (size_t i = 0; i < aCount; i++)
+			{
+				// Half uniform, half in tight clusters with duplicates, as in scans of flat surfaces
+				if (i % 2 == 0 || i < 16)
+				{
+					points[i] = Vec3f(BB::Random(-50.0f, 50.0f), BB::Random(-50.0f, 50.0f), BB::Random(-5.0f, 5.0f));
+				}
+				else
+				{
+					const Vec3f center = points[(i / 16) * 16];
+					points[i] = i % 7 == 0 ? center : center + Vec3f(BB::Random(-0.1f, 0.1f), BB::Random(-0.1f, 0.1f), 0.0f);
+				}
+			}
+			return points;
+		}
+
+		static float DistanceSquared(const Vec3f& aOne, const Vec3f& aTwo)
+		{
+			Vec3f difference = aOne - aTwo;
+			return difference.Dot(difference);
+		}
+
+		// The aK smallest distances by brute force, same arithmetic order as the tree
+		static std::vector<float> NearestReference(const std::vector<Vec3f>& aPoints, const Vec3f& aQuery, size_t aK)
+		{
+			std::vector<float> distances(aPoints.size());
+			for (size_t i = 0; i < aPoints.size(); i++)
+			{
+				distances[i] = DistanceSquared(aPoints[i], aQuery);
+			}
+			std::sort(distances.begin(), distances.end());
+			distances.resize(std::min(aK, distances.size()));
+			return distances;
+		}
+
+		static void CheckNearest(const std::vector<Vec3f>& aPoints, const Vec3f& aQuery, size_t aK, size_t aFound, const uint32_t* aIndices, const float* aDistances)
+		{
+			const std::vector<float> expected = NearestReference(aPoints, aQuery, aK);
+			Assert::AreEqual(expected.size(), aFound);
+			for (size_t i = 0; i < aFound; i++)
+			{
+				Assert::AreEqual(expected[i], aDistances[i], 1e-3f * (1.0f + expected[i]), L"k-th distance does not match brute force");
+				Assert::AreEqual(aDistances[i], DistanceSquared(aPoints[aIndices[i]], aQuery), 1e-3f * (1.0f + aDistances[i]), L"Index does not match its distance");
+			}
+		}
+
+	public:
+		TEST_METHOD(Nearest_And_Radius_Match_Brute_Force)
+		{
+			const size_t counts[] = { 0, 1, 5, 16, 17, 100, 4321 };
+			for (size_t count : counts)
+			{
+				const std::vector<Vec3f> points = RandomCloud(count);
+				BB::KdTree tree;
+				tree.Build(points.data(), count);
+				Assert::AreEqual(count, tree.GetCount());
+
+				for (int query = 0; query < 50; query++)
+				{
+					const Vec3f point = query % 3 == 0 && count > 0 ? points[rand() % count] : Vec3f(BB::Random(-60.0f, 60.0f), BB::Random(-60.0f, 60.0f), BB::Random(-8.0f, 8.0f));
+					const size_t ks[] = { 1, 4, 20 };
+					for (size_t k : ks)
+					{
+						uint32_t indices[20];
+						float distances[20];
+						const size_t found = tree.FindNearest(point, k, indices, distances);
+						CheckNearest(points, point, k, found, indices, distances);
+					}
+
+					const float radius = BB::Random(0.05f, 8.0f);
+					std::vector<uint32_t> inRadius;
+					tree.FindInRadius(point, radius, inRadius);
+					std::sort(inRadius.begin(), inRadius.end());
+					std::vector<uint32_t> expected;
+					for (size_t i = 0; i < count; i++)
+					{
+						if (DistanceSquared(points[i], point) <= radius * radius)
+						{
+							expected.push_back(uint32_t(i));
+						}
+					}
+					Assert::IsTrue(expected == inRadius, L"Radius query does not match brute force");
+				}
+			}
+		}
+
+		TEST_METHOD(Parallel_Build_And_Batches)
+		{
+			BB::ThreadPoolSettings settings;
+			settings.workerCount = 3;
+			BB::ThreadPool pool(settings);
+
+			const size_t count = 100003;
+			const std::vector<Vec3f> points = RandomCloud(count);
+			BB::KdTree serial;
+			BB::KdTree parallel;
+			serial.Build(points.data(), count);
+			parallel.Build(pool, points.data(), count);
+			Assert::AreEqual(serial.GetDepth(), parallel.GetDepth());
+
+			const size_t queryCount = 2000;
+			const size_t k = 8;
+			std::vector<Vec3f> queries(queryCount);
+			for (Vec3f& query : queries)
+			{
+				query = Vec3f(BB::Random(-50.0f, 50.0f), BB::Random(-50.0f, 50.0f), BB::Random(-5.0f, 5.0f));
+			}
+			std::vector<uint32_t> indices(queryCount * k);
+			std::vector<float> distances(queryCount * k);
+			parallel.FindNearest(pool, queries.data(), queryCount, k, indices.data(), distances.data());
+			for (size_t query = 0; query < queryCount; query++)
+			{
+				uint32_t serialIndices[k];
+				float serialDistances[k];
+				const size_t found = serial.FindNearest(queries[query], k, serialIndices, serialDistances);
+				Assert::AreEqual(k, found);
+				for (size_t i = 0; i < k; i++)
+				{
+					Assert::AreEqual(serialDistances[i], distances[query * k + i], L"Parallel build or batch differs from the serial tree");
+				}
+			}
+			CheckNearest(points, queries[0], k, k, indices.data(), distances.data());
+
+			// More neighbors than points leaves invalid entries
+			BB::KdTree small;
+			small.Build(pool, points.data(), 3);
+			small.FindNearest(pool, queries.data(), 2, k, indices.data(), distances.data());
+			Assert::AreEqual(BB::KD_INVALID_INDEX, indices[3]);
+			Assert::IsTrue(std::isinf(distances[k - 1]));
+
+			std::vector<uint32_t> offsets;
+			std::vector<uint32_t> found;
+			parallel.FindInRadius(pool, queries.data(), queryCount, 1.5f, offsets, found);
+			Assert::AreEqual(queryCount + 1, offsets.size());
+			Assert::AreEqual(size_t(offsets.back()), found.size());
+			std::vector<uint32_t> single;
+			for (size_t query = 0; query < queryCount; query += 97)
+			{
+				serial.FindInRadius(queries[query], 1.5f, single);
+				std::vector<uint32_t> batch(found.begin() + offsets[query], found.begin() + offsets[query + 1]);
+				std::sort(single.begin(), single.end());
+				std::sort(batch.begin(), batch.end());
+				Assert::IsTrue(single == batch, L"Batched radius query differs from the single query");
+			}
+		}
+
+		TEST_METHOD(Build_And_Query_1M)
+		{
+			BB::ThreadPool pool;
+			const size_t count = 1000000;
+			const std::vector<Vec3f> points = RandomCloud(count);
+			BB::KdTree tree;
+
+			auto start = std::chrono::steady_clock::now();
+			tree.Build(points.data(), count);
+			const double serialBuild = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+			start = std::chrono::steady_clock::now();
+			tree.Build(pool, points.data(), count);
+			const double parallelBuild = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+			const size_t queryCount = 100000;
+			const size_t k = 8;
+			std::vector<Vec3f> queries(queryCount);
+			for (Vec3f& query : queries)
+			{
+				query = points[rand() % count] + Vec3f(0.01f, -0.02f, 0.01f);
+			}
+			std::vector<uint32_t> indices(queryCount * k);
+			std::vector<float> distances(queryCount * k);
+			start = std::chrono::steady_clock::now();
+			for (size_t query = 0; query < queryCount; query++)
+			{
+				tree.FindNearest(queries[query], k, indices.data() + query * k, distances.data() + query * k);
+			}
+			const double nearest = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / queryCount;
+			start = std::chrono::steady_clock::now();
+			tree.FindNearest(pool, queries.data(), queryCount, k, indices.data(), distances.data());
+			const double nearestBatch = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / queryCount;
+
+			char message[256];
+			snprintf(message, sizeof(message), "KdTree %zu points: build %.1f ms, on %zu threads %.1f ms, 8 nearest %.0f ns per query, batched %.0f ns\n",
+				count, serialBuild, pool.GetThreadCount(), parallelBuild, nearest, nearestBatch);
+			Logger::WriteMessage(message);
+		}
+	};
+}
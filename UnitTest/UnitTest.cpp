@@ -3,9 +3,17 @@
 #include "..\MathLib\Vector\Vector3f\Vector3f.h"
 #include "..\MathLib\Util\Random.h"
 #include "..\MathLib\Util\CommonMath.h"
+#include "..\MathLib\Expression\LazyExpression.h"
+#include "..\MathLib\Vector\Vector3i\Vector3i.h"
+#include "..\MathLib\Vector\Vector4i\Vector4i.h"
+#include "..\MathLib\Bulk\Morton.h"
 
 #include <chrono>
 #include <iostream>
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <cstdint>
 using namespace std::chrono;
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
@@ -474,4 +482,514 @@ namespace Vector3f
 
 	};
 	
+
+	TEST_CLASS(FusedArithmetic)
+	{
+		TEST_METHOD(MulAdd_MulSub_NegMulAdd)
+		{
+			int runs = 100;
+			const float size = 100.0f;
+			for (int i = 0; i < runs; i++)
+			{
+				Vec3f a(BB::Random(-size, size), BB::Random(-size, size), BB::Random(-size, size));
+				Vec3f b(BB::Random(-size, size), BB::Random(-size, size), BB::Random(-size, size));
+				Vec3f c(BB::Random(-size, size), BB::Random(-size, size), BB::Random(-size, size));
+				float scalar = BB::Random(-size, size);
+
+				Vec3f mulAdd = MulAdd(a, b, c);
+				Vec3f mulSub = MulSub(a, b, c);
+				Vec3f negMulAdd = NegMulAdd(a, b, c);
+				Vec3f scalarMulAdd = MulAdd(a, scalar, c);
+
+				Assert::IsTrue(BB::AlmostEqual(mulAdd.x, a.x * b.x + c.x, 0.01f) && BB::AlmostEqual(mulAdd.z, a.z * b.z + c.z, 0.01f), L"MulAdd is not done correctly");
+				Assert::IsTrue(BB::AlmostEqual(mulSub.y, a.y * b.y - c.y, 0.01f) && BB::AlmostEqual(mulSub.z, a.z * b.z - c.z, 0.01f), L"MulSub is not done correctly");
+				Assert::IsTrue(BB::AlmostEqual(negMulAdd.x, c.x - a.x * b.x, 0.01f) && BB::AlmostEqual(negMulAdd.y, c.y - a.y * b.y, 0.01f), L"NegMulAdd is not done correctly");
+				Assert::IsTrue(BB::AlmostEqual(scalarMulAdd.y, a.y * scalar + c.y, 0.01f), L"MulAdd with scalar is not done correctly");
+				Assert::AreEqual(0.0f, _mm_cvtss_f32(_mm_shuffle_ps(mulAdd.data, mulAdd.data, _MM_SHUFFLE(3, 3, 3, 3))), L"MulAdd should keep the unused component at zero");
+			}
+		}
+
+		TEST_METHOD(Lerp_Endpoints)
+		{
+			Vec3f from(0.0f, 10.0f, -10.0f);
+			Vec3f to(10.0f, 20.0f, 10.0f);
+
+			Assert::IsTrue(Lerp(from, to, 0.0f) == from, L"Lerp with t = 0 should return the start");
+			Assert::IsTrue(Lerp(from, to, 1.0f) == to, L"Lerp with t = 1 should return the end");
+			Assert::IsTrue(Lerp(from, to, 0.5f) == Vec3f(5.0f, 15.0f, 0.0f), L"Lerp with t = 0.5 should return the middle");
+		}
+
+		TEST_METHOD(Rotate_AnyAngle)
+		{
+			int runs = 100;
+			const float size = 100.0f;
+			for (int i = 0; i < runs; i++)
+			{
+				const float angle = BB::Random(-BB::PI_F, BB::PI_F);
+				const float cosA = std::cos(angle);
+				const float sinA = std::sin(angle);
+				Vec3f v(BB::Random(-size, size), BB::Random(-size, size), BB::Random(-size, size));
+
+				Vec3f rotatedX = v;
+				rotatedX.RotateX(angle);
+				Assert::IsTrue(BB::AlmostEqual(rotatedX.y, v.y * cosA - v.z * sinA, 0.001f), L"RotateX did not produce expected result.");
+				Assert::IsTrue(BB::AlmostEqual(rotatedX.z, v.y * sinA + v.z * cosA, 0.001f), L"RotateX did not produce expected result.");
+
+				Vec3f rotatedY = v;
+				rotatedY.RotateY(angle);
+				Assert::IsTrue(BB::AlmostEqual(rotatedY.x, v.z * sinA + v.x * cosA, 0.001f), L"RotateY did not produce expected result.");
+				Assert::IsTrue(BB::AlmostEqual(rotatedY.z, v.z * cosA - v.x * sinA, 0.001f), L"RotateY did not produce expected result.");
+
+				Vec3f rotatedZ = v;
+				rotatedZ.RotateZ(angle);
+				Assert::IsTrue(BB::AlmostEqual(rotatedZ.x, v.x * cosA - v.y * sinA, 0.001f), L"RotateZ did not produce expected result.");
+				Assert::IsTrue(BB::AlmostEqual(rotatedZ.y, v.x * sinA + v.y * cosA, 0.001f), L"RotateZ did not produce expected result.");
+
+				// Rotating around a main axis has to give the same result as the specialised rotations
+				Vec3f aroundX = v.GetRotatedAroundAxis({ 1.0f, 0.0f, 0.0f }, angle);
+				Assert::IsTrue(BB::AlmostEqual(aroundX.y, rotatedX.y, 0.001f) && BB::AlmostEqual(aroundX.z, rotatedX.z, 0.001f), L"GetRotatedAroundAxis does not match RotateX");
+			}
+		}
+	};
+
+	TEST_CLASS(LazyExpression)
+	{
+		TEST_METHOD(Single)
+		{
+			int runs = 100;
+			const float size = 100.0f;
+			for (int i = 0; i < runs; i++)
+			{
+				Vec3f a(BB::Random(-size, size), BB::Random(-size, size), BB::Random(-size, size));
+				Vec3f b(BB::Random(-size, size), BB::Random(-size, size), BB::Random(-size, size));
+				Vec3f c(BB::Random(-size, size), BB::Random(-size, size), BB::Random(-size, size));
+				Vec3f d(BB::Random(1.0f, size), BB::Random(1.0f, size), BB::Random(1.0f, size));
+
+				Vec3f lazy = BB::Lazy(a) + BB::Lazy(b) * c - d;
+				Vec3f eager = a + b * c - d;
+				Assert::IsTrue(BB::AlmostEqual(lazy.x, eager.x, 0.01f) && BB::AlmostEqual(lazy.y, eager.y, 0.01f) && BB::AlmostEqual(lazy.z, eager.z, 0.01f), L"Lazy expression does not match the operators");
+
+				// A product next to a sum has to be contracted exactly like MulAdd
+				Vec3f fused = BB::Lazy(b) * c + a;
+				Assert::IsTrue(fused == MulAdd(b, c, a), L"Lazy product and sum is not contracted to MulAdd");
+				Vec3f negFused = BB::Lazy(a) - BB::Lazy(b) * c;
+				Assert::IsTrue(negFused == NegMulAdd(b, c, a), L"Lazy difference of a product is not contracted to NegMulAdd");
+
+				Vec3f divided = (BB::Lazy(a) - b) / d * 2.0f;
+				Vec3f eagerDivided = (a - b) / d * 2.0f;
+				Assert::IsTrue(divided == eagerDivided, L"Lazy division does not match the operators");
+				Assert::AreEqual(0.0f, _mm_cvtss_f32(_mm_shuffle_ps(divided.data, divided.data, _MM_SHUFFLE(3, 3, 3, 3))), L"Lazy division should keep the unused component at zero");
+
+				Vec3f negated = -BB::Lazy(a) * 0.5f;
+				Assert::IsTrue(negated == -a * 0.5f, L"Lazy negation does not match the operators");
+			}
+		}
+
+		TEST_METHOD(Array)
+		{
+			const int count = 257;
+			std::vector<Vec3f> positions(count);
+			std::vector<Vec3f> velocities(count);
+			std::vector<Vec3f> output(count);
+			const float size = 100.0f;
+			for (int i = 0; i < count; i++)
+			{
+				positions[i] = Vec3f(BB::Random(-size, size), BB::Random(-size, size), BB::Random(-size, size));
+				velocities[i] = Vec3f(BB::Random(-size, size), BB::Random(-size, size), BB::Random(-size, size));
+			}
+
+			const float deltaTime = 0.016f;
+			Vec3f gravity(0.0f, -9.82f, 0.0f);
+			BB::Evaluate(output.data(), count, BB::Lazy(positions.data()) + (BB::Lazy(velocities.data()) + gravity * deltaTime) * deltaTime);
+
+			for (int i = 0; i < count; i++)
+			{
+				Vec3f expected = MulAdd(velocities[i] + gravity * deltaTime, deltaTime, positions[i]);
+				Assert::IsTrue(output[i] == expected, L"Lazy array expression does not match per element evaluation");
+			}
+
+			// Writing back into one of the inputs
+			BB::Evaluate(positions.data(), count, BB::Lazy(positions.data()) - BB::Lazy(positions.data()));
+			for (int i = 0; i < count; i++)
+			{
+				Assert::IsTrue(positions[i] == Vec3f(0.0f), L"Lazy expression in place is not done correctly");
+			}
+		}
+	};
+
+	TEST_CLASS(ConstantEvaluation)
+	{
+		TEST_METHOD(Static_Asserts)
+		{
+			constexpr Vec3f a(1.0f, 2.0f, 3.0f);
+			constexpr Vec3f b(4.0f, 5.0f, 6.0f);
+
+			static_assert(a + b == Vec3f(5.0f, 7.0f, 9.0f), "Constexpr add is not done correctly");
+			static_assert(b - a == Vec3f(3.0f), "Constexpr subtract is not done correctly");
+			static_assert(-a * 2.0f == Vec3f(-2.0f, -4.0f, -6.0f), "Constexpr negate or scale is not done correctly");
+			static_assert(b / a == Vec3f(4.0f, 2.5f, 2.0f), "Constexpr divide is not done correctly");
+			static_assert(a.Dot(b) == 32.0f, "Constexpr dot is not done correctly");
+			static_assert(a.LengthSqr() == 14.0f, "Constexpr squared length is not done correctly");
+			static_assert(BB::VEC3F_UNIT_X.Cross(BB::VEC3F_UNIT_Y) == BB::VEC3F_UNIT_Z, "Constexpr cross is not done correctly");
+			static_assert(Vec3f() == BB::VEC3F_ZERO && Vec3f() != BB::VEC3F_ONE, "Constexpr compare is not done correctly");
+		}
+
+		TEST_METHOD(Matches_Runtime)
+		{
+			constexpr Vec3f baked = Vec3f(1.0f, 2.0f, 3.0f).Cross(Vec3f(-4.0f, 0.5f, 2.0f)) * 0.25f + BB::VEC3F_ONE;
+
+			Vec3f runtimeA(1.0f, 2.0f, 3.0f);
+			Vec3f runtimeB(-4.0f, 0.5f, 2.0f);
+			Vec3f runtime = runtimeA.Cross(runtimeB) * 0.25f + Vec3f(1.0f);
+
+			Assert::IsTrue(baked == runtime, L"Constant evaluated result differs from the SIMD path");
+			Assert::AreEqual(0.0f, _mm_cvtss_f32(_mm_shuffle_ps(baked.data, baked.data, _MM_SHUFFLE(3, 3, 3, 3))), L"Constexpr constructor should keep the unused component at zero");
+		}
+
+		TEST_METHOD(Lookup_Table)
+		{
+			// Corners of the unit cube, built entirely at compile time
+			constexpr std::array<Vec3f, 8> corners = []()
+			{
+				std::array<Vec3f, 8> result;
+				for (int i = 0; i < 8; i++)
+				{
+					result[i] = Vec3f(float(i & 1), float((i >> 1) & 1), float((i >> 2) & 1)) * 2.0f - BB::VEC3F_ONE;
+				}
+				return result;
+			}();
+			static_assert(corners[7] == BB::VEC3F_ONE, "Lookup table is not built correctly");
+
+			for (int i = 0; i < 8; i++)
+			{
+				Assert::AreEqual(3.0f, corners[i].LengthSqr(), 0.0001f, L"Every corner should be a squared distance of 3 from the origin");
+			}
+		}
+	};
+
+	TEST_CLASS(LoadStore)
+	{
+		TEST_METHOD(Unaligned_Exact)
+		{
+			// Offset by one float so the vector is not 16-byte aligned, the sentinels must stay untouched
+			alignas(16) float buffer[8] = { -1.0f, 1.0f, 2.0f, 3.0f, -1.0f, -1.0f, -1.0f, -1.0f };
+
+			Vec3f loaded = Vec3f::LoadUnaligned(buffer + 1);
+			Assert::IsTrue(loaded == Vec3f(1.0f, 2.0f, 3.0f), L"LoadUnaligned did not read x, y, z");
+
+			Vec3f(4.0f, 5.0f, 6.0f).StoreUnaligned(buffer + 1);
+			Assert::AreEqual(-1.0f, buffer[0], L"StoreUnaligned wrote before the vector");
+			Assert::AreEqual(4.0f, buffer[1]); Assert::AreEqual(5.0f, buffer[2]); Assert::AreEqual(6.0f, buffer[3]);
+			Assert::AreEqual(-1.0f, buffer[4], L"StoreUnaligned wrote past z");
+		}
+
+		TEST_METHOD(Aligned_Stream)
+		{
+			alignas(16) float buffer[8] = { 1.0f, 2.0f, 3.0f, 99.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+
+			Vec3f loaded = Vec3f::LoadAligned(buffer);
+			Assert::IsTrue(loaded == Vec3f(1.0f, 2.0f, 3.0f), L"LoadAligned should clear the unused component");
+
+			loaded.StoreAligned(buffer + 4);
+			Assert::IsTrue(Vec3f::LoadAligned(buffer + 4) == loaded && buffer[7] == 0.0f, L"StoreAligned did not write the vector");
+
+			Vec3f(7.0f, 8.0f, 9.0f).StoreStream(buffer);
+			BB::Simd::StreamFence();
+			Assert::IsTrue(Vec3f::LoadUnaligned(buffer) == Vec3f(7.0f, 8.0f, 9.0f), L"StoreStream did not write the vector");
+		}
+	};
+
+	TEST_CLASS(ComponentWise)
+	{
+	public:
+		TEST_METHOD(MinMaxAbsClamp)
+		{
+			Vec3f a(1.0f, -2.0f, 3.0f);
+			Vec3f b(0.5f, 4.0f, -3.0f);
+
+			Assert::IsTrue(Min(a, b) == Vec3f(0.5f, -2.0f, -3.0f), L"Min failed");
+			Assert::IsTrue(Max(a, b) == Vec3f(1.0f, 4.0f, 3.0f), L"Max failed");
+			Assert::IsTrue(Abs(Vec3f(-1.0f, 2.0f, -0.0f)) == Vec3f(1.0f, 2.0f, 0.0f), L"Abs failed");
+			Assert::IsTrue(Clamp(Vec3f(-5.0f, 0.25f, 5.0f), 0.0f, 1.0f) == Vec3f(0.0f, 0.25f, 1.0f), L"Scalar Clamp failed");
+			Assert::IsTrue(Clamp(a, Vec3f(0.0f, -1.0f, 0.0f), Vec3f(0.5f, 1.0f, 2.0f)) == Vec3f(0.5f, -1.0f, 2.0f), L"Vector Clamp failed");
+			Assert::AreEqual(0.0f, Clamp(Vec3f(2.0f), 1.0f, 3.0f).lanes.value[3], L"Clamp should keep the unused component at zero");
+		}
+
+		TEST_METHOD(Rounding_Sign)
+		{
+			Vec3f a(1.5f, -1.5f, -0.0f);
+
+			Assert::IsTrue(Floor(a) == Vec3f(1.0f, -2.0f, 0.0f), L"Floor failed");
+			Assert::IsTrue(Ceil(a) == Vec3f(2.0f, -1.0f, 0.0f), L"Ceil failed");
+			Assert::IsTrue(Sign(a) == Vec3f(1.0f, -1.0f, 0.0f), L"Sign failed");
+			Assert::IsTrue(Sign(Vec3f(NAN, 0.0f, -7.0f)) == Vec3f(0.0f, 0.0f, -1.0f), L"Sign of NaN and zero should be 0");
+		}
+
+		TEST_METHOD(Lerp_Select)
+		{
+			Vec3f from(0.0f, 10.0f, -4.0f);
+			Vec3f to(1.0f, 20.0f, 4.0f);
+
+			Assert::IsTrue(Lerp(from, to, Vec3f(0.5f, 0.0f, 1.0f)) == Vec3f(0.5f, 10.0f, 4.0f), L"Per component Lerp failed");
+
+			Vec3f mask = LessMask(from, Vec3f(5.0f));
+			Assert::IsTrue(Select(mask, from, to) == Vec3f(0.0f, 20.0f, -4.0f), L"Select should take from where from < 5");
+			Assert::IsTrue(Select(GreaterEqualMask(from, Vec3f(0.0f)), from, to) == Vec3f(0.0f, 10.0f, 4.0f), L"GreaterEqualMask failed");
+			Assert::IsTrue(Select(EqualMask(from, Vec3f(10.0f)), from, to) == Vec3f(1.0f, 10.0f, 4.0f), L"EqualMask failed");
+		}
+	};
+
+	TEST_CLASS(FastMath)
+	{
+	public:
+		TEST_METHOD(NormalizeFast_Error)
+		{
+			float maxError[3] = { 0.0f, 0.0f, 0.0f };
+			for (int i = 0; i < 1000; i++)
+			{
+				Vec3f vector(BB::Random(-100.0f, 100.0f), BB::Random(-100.0f, 100.0f), BB::Random(-100.0f, 100.0f));
+				Vec3f exact = vector.GetNormalized();
+
+				Vec3f fast[3] = { vector.GetNormalizedFast<0>(), vector.GetNormalizedFast<1>(), vector.GetNormalizedFast<2>() };
+				for (int steps = 0; steps < 3; steps++)
+				{
+					maxError[steps] = std::max(maxError[steps], (fast[steps] - exact).Length());
+					Assert::AreEqual(0.0f, fast[steps].lanes.value[3], L"The unused component should stay zero");
+				}
+			}
+
+			Assert::IsTrue(maxError[0] < 4e-4f, L"The estimate should be within 4e-4");
+			Assert::IsTrue(maxError[1] < 1e-6f, L"One refinement should be within 1e-6");
+			Assert::IsTrue(maxError[2] < 1e-6f, L"Two refinements should be within 1e-6");
+
+			Vec3f inPlace(3.0f, 0.0f, 4.0f);
+			inPlace.NormalizeFast();
+			Assert::AreEqual(1.0f, inPlace.Length(), 1e-6f, L"NormalizeFast did not normalize in place");
+		}
+
+		TEST_METHOD(LengthFast_DivideFast)
+		{
+			Assert::AreEqual(5.0f, Vec3f(3.0f, 4.0f, 0.0f).LengthFast(), 5.0f * 1e-6f, L"LengthFast failed");
+			Assert::AreEqual(5.0f, Vec3f(3.0f, 4.0f, 0.0f).LengthFast<0>(), 5.0f * 4e-4f, L"LengthFast<0> failed");
+			Assert::AreEqual(0.0f, Vec3f(0.0f).LengthFast(), L"A zero vector should have length 0");
+
+			Vec3f quotient = DivideFast(Vec3f(1.0f, -6.0f, 9.0f), Vec3f(4.0f, 3.0f, -3.0f));
+			Assert::AreEqual(0.25f, quotient.x, 1e-6f); Assert::AreEqual(-2.0f, quotient.y, 1e-6f); Assert::AreEqual(-3.0f, quotient.z, 1e-6f);
+			Assert::AreEqual(0.0f, quotient.lanes.value[3], L"DivideFast should clear the unused component");
+
+			Vec3f scaled = DivideFast<2>(Vec3f(1.0f, 2.0f, 3.0f), 3.0f);
+			Assert::AreEqual(1.0f, scaled.z, 1e-6f, L"Scalar DivideFast failed");
+		}
+	};
+
+	TEST_CLASS(Validity)
+	{
+	public:
+		static inline int ourFailures = 0;
+
+		static void CountFailure(const char*, const char*, int)
+		{
+			ourFailures++;
+		}
+
+		TEST_METHOD(SafeNormalize)
+		{
+			const Vec3f up(0.0f, 1.0f, 0.0f);
+
+			Assert::IsTrue(Vec3f(0.0f).GetSafeNormalized(up) == up, L"A zero vector should give the fallback");
+			Assert::IsTrue(Vec3f(NAN, 1.0f, 0.0f).GetSafeNormalized(up) == up, L"A NaN vector should give the fallback");
+			Assert::IsTrue(Vec3f(INFINITY, 1.0f, 0.0f).GetSafeNormalized(up) == up, L"An infinite vector should give the fallback");
+			Assert::IsTrue(Vec3f(3.0f, 0.0f, 4.0f).GetSafeNormalized(up) == Vec3f(3.0f, 0.0f, 4.0f).GetNormalized(), L"Valid vectors should match GetNormalized");
+
+			Vec3f inPlace(0.0f);
+			inPlace.SafeNormalize(up);
+			Assert::IsTrue(inPlace == up, L"SafeNormalize should set the fallback");
+		}
+
+		TEST_METHOD(FiniteQueries)
+		{
+			Vec3f mixed(1.0f, NAN, -INFINITY);
+
+			Assert::IsFalse(IsFinite(mixed), L"NaN and infinity are not finite");
+			Assert::IsTrue(IsFinite(Vec3f(FLT_MAX, -FLT_MAX, 1e-40f)), L"Large and denormal values are finite");
+			Assert::IsTrue(Select(FiniteMask(mixed), Vec3f(1.0f), Vec3f(0.0f)) == Vec3f(1.0f, 0.0f, 0.0f), L"FiniteMask should only set x");
+			Assert::IsTrue(Sanitize(mixed, Vec3f(7.0f, 8.0f, 9.0f)) == Vec3f(1.0f, 8.0f, 9.0f), L"Sanitize should replace y and z");
+		}
+
+		TEST_METHOD(ValidationHook)
+		{
+			ourFailures = 0;
+			BB::ValidationHandler previous = BB::SetValidationHandler(&CountFailure);
+
+			Vec3f zero(0.0f);
+			Vec3f normalized = zero.GetNormalized();
+			Vec3f divided = Vec3f(1.0f) / 0.0f;
+			Vec3f dividedByVector = Vec3f(1.0f) / Vec3f(1.0f, 0.0f, 1.0f);
+			Vec3f valid = Vec3f(1.0f, 2.0f, 3.0f).GetNormalized() / 2.0f;
+
+			BB::SetValidationHandler(previous);
+#ifdef BB_USE_VALIDATION
+			Assert::AreEqual(3, ourFailures, L"Each invalid call should be reported once");
+#else
+			Assert::AreEqual(0, ourFailures, L"Validation is compiled out");
+#endif
+			Assert::IsFalse(IsFinite(normalized) || IsFinite(divided) || IsFinite(dividedByVector), L"The results themselves are unchanged");
+			Assert::IsTrue(IsFinite(valid));
+		}
+	};
+}
+
+namespace Vector3i
+{
+	TEST_CLASS(Integer)
+	{
+	public:
+		TEST_METHOD(Arithmetic)
+		{
+			Vec3i a(1, -2, 3);
+			Vec3i b(4, 5, -6);
+
+			Assert::IsTrue(a + b == Vec3i(5, 3, -3), L"Addition failed");
+			Assert::IsTrue(a - b == Vec3i(-3, -7, 9), L"Subtraction failed");
+			Assert::IsTrue(a * b == Vec3i(4, -10, -18), L"Multiplication failed");
+			Assert::IsTrue(a * 3 == Vec3i(3, -6, 9) && 3 * a == a * 3, L"Scalar multiplication failed");
+			Assert::IsTrue(-a == Vec3i(-1, 2, -3), L"Negation failed");
+			Assert::IsTrue((Vec3i(6, 5, 12) & Vec3i(3)) == Vec3i(2, 1, 0), L"And failed");
+			Assert::IsTrue((Vec3i(4, 1, 0) | Vec3i(1)) == Vec3i(5, 1, 1), L"Or failed");
+			Assert::IsTrue((Vec3i(1, 2, 3) ^ Vec3i(1)) == Vec3i(0, 3, 2), L"Xor failed");
+
+			Vec3i c = a;
+			c += b; c -= b; c *= 2;
+			Assert::IsTrue(c == Vec3i(2, -4, 6), L"Compound assignment failed");
+		}
+
+		TEST_METHOD(Shifts)
+		{
+			Assert::IsTrue((Vec3i(1, 2, -3) << 4) == Vec3i(16, 32, -48), L"Left shift failed");
+			// Arithmetic shift floors, -17 >> 4 is the cell -2
+			Assert::IsTrue((Vec3i(17, 16, -17) >> 4) == Vec3i(1, 1, -2), L"Right shift should keep the sign");
+
+			Vec3i d(3, 5, 7);
+			d <<= 1; d >>= 2;
+			Assert::IsTrue(d == Vec3i(1, 2, 3), L"Shift assignment failed");
+		}
+
+		TEST_METHOD(MinMaxCompare)
+		{
+			Vec3i a(1, 5, -3);
+			Vec3i b(2, 5, -4);
+
+			Assert::IsTrue(Min(a, b) == Vec3i(1, 5, -4), L"Min failed");
+			Assert::IsTrue(Max(a, b) == Vec3i(2, 5, -3), L"Max failed");
+			Assert::AreEqual(0x2, CompareEqual(a, b), L"CompareEqual should only set y");
+			Assert::AreEqual(0x1, CompareLess(a, b), L"CompareLess should only set x");
+			Assert::AreEqual(0x4, CompareGreater(a, b), L"CompareGreater should only set z");
+			Assert::AreEqual(0x7, CompareEqual(a, a), L"Equal vectors should set all three bits");
+		}
+
+		TEST_METHOD(Conversion)
+		{
+			Vec3f position(1.5f, -1.5f, -0.25f);
+
+			Assert::IsTrue(Vec3i::Floor(position) == Vec3i(1, -2, -1), L"Floor failed");
+			Assert::IsTrue(Vec3i::Truncate(position) == Vec3i(1, -1, 0), L"Truncate failed");
+			Assert::IsTrue(Vec3i::Round(Vec3f(2.5f, -2.5f, 2.6f)) == Vec3i(2, -2, 3), L"Round should go to the even integer");
+			Assert::IsTrue(Vec3i(3, -4, 5).ToVec3f() == Vec3f(3.0f, -4.0f, 5.0f), L"ToVec3f failed");
+
+			Vec4f vector(1.5f, -1.5f, -0.25f, 7.75f);
+			Assert::IsTrue(Vec4i::Floor(vector) == Vec4i(1, -2, -1, 7), L"Vec4i Floor failed");
+			Assert::IsTrue(Vec4i::Truncate(vector) == Vec4i(1, -1, 0, 7), L"Vec4i Truncate failed");
+			Assert::IsTrue(Vec4i::Round(vector) == Vec4i(2, -2, 0, 8), L"Vec4i Round failed");
+			Assert::IsTrue(Vec4i(1, 2, 3, 4).ToVec4f() == Vec4f(1.0f, 2.0f, 3.0f, 4.0f), L"ToVec4f failed");
+		}
+
+		TEST_METHOD(Vec4i_Operators)
+		{
+			Vec4i a(1, -2, 3, -4);
+			Vec4i b(2, 2, 2, 2);
+
+			Assert::IsTrue(a + b == Vec4i(3, 0, 5, -2) && a - b == Vec4i(-1, -4, 1, -6), L"Addition or subtraction failed");
+			Assert::IsTrue(a * b == Vec4i(2, -4, 6, -8), L"Multiplication failed");
+			Assert::IsTrue((a >> 1) == Vec4i(0, -1, 1, -2), L"Right shift failed");
+			Assert::AreEqual(0xA, CompareLess(a, Vec4i(0)), L"CompareLess should set y and w");
+			Assert::IsTrue(Min(a, b) == Vec4i(1, -2, 2, -4) && Max(a, b) == Vec4i(2, 2, 3, 2), L"Min or max failed");
+
+			int32_t values[6] = { -1, 9, 8, 7, 6, -1 };
+			Vec4i loaded = Vec4i::LoadUnaligned(values + 1);
+			Assert::IsTrue(loaded == Vec4i(9, 8, 7, 6), L"LoadUnaligned failed");
+			Vec4i(1, 2, 3, 4).StoreUnaligned(values + 1);
+			Assert::IsTrue(values[0] == -1 && values[4] == 4 && values[5] == -1, L"StoreUnaligned wrote the wrong range");
+		}
+
+		TEST_METHOD(LoadStore_Exact)
+		{
+			int32_t values[5] = { -1, 4, 5, 6, -1 };
+
+			Assert::IsTrue(Vec3i::LoadUnaligned(values + 1) == Vec3i(4, 5, 6), L"LoadUnaligned did not read x, y, z");
+			Vec3i(7, 8, 9).StoreUnaligned(values + 1);
+			Assert::IsTrue(values[0] == -1 && values[1] == 7 && values[3] == 9 && values[4] == -1, L"StoreUnaligned wrote outside x, y, z");
+		}
+
+		TEST_METHOD(ConstantEvaluation)
+		{
+			constexpr Vec3i cell = (Vec3i(3, -5, 7) * 2 + BB::VEC3I_ONE) >> 1;
+			static_assert(cell == Vec3i(3, -5, 7), "Vec3i should evaluate at compile time");
+			Assert::IsTrue(cell == Vec3i(3, -5, 7));
+		}
+	};
+
+	TEST_CLASS(Morton)
+	{
+	public:
+		static uint64_t ReferenceMorton(uint32_t aX, uint32_t aY, uint32_t aZ)
+		{
+			uint64_t code = 0;
+			for (int bit = 0; bit < BB::Bulk::MORTON_BITS_PER_AXIS; bit++)
+			{
+				code |= uint64_t((aX >> bit) & 1) << (3 * bit);
+				code |= uint64_t((aY >> bit) & 1) << (3 * bit + 1);
+				code |= uint64_t((aZ >> bit) & 1) << (3 * bit + 2);
+			}
+			return code;
+		}
+
+		TEST_METHOD(MatchesReference_RoundTrip)
+		{
+			std::vector<Vec3i> cells = { Vec3i(0, 0, 0), Vec3i(1, 0, 0), Vec3i(0, 1, 0), Vec3i(0, 0, 1), Vec3i(0x1fffff, 0x1fffff, 0x1fffff), Vec3i(12345, 678901, 2000000) };
+			for (int i = 0; i < 100; i++)
+			{
+				cells.push_back(Vec3i(rand() & 0x1fffff, (rand() * 31) & 0x1fffff, (rand() * 7919) & 0x1fffff));
+			}
+
+			std::vector<uint64_t> codes(cells.size());
+			BB::Bulk::EncodeMorton(cells.data(), codes.data(), cells.size());
+			for (size_t i = 0; i < cells.size(); i++)
+			{
+				Assert::AreEqual(ReferenceMorton(cells[i].x, cells[i].y, cells[i].z), codes[i], L"Code does not match the bit by bit reference");
+			}
+			Assert::AreEqual(uint64_t(0x7fffffffffffffff), codes[4], L"The largest cell should use all 63 bits");
+
+			std::vector<Vec3i> decoded(cells.size());
+			BB::Bulk::DecodeMorton(codes.data(), decoded.data(), codes.size());
+			for (size_t i = 0; i < cells.size(); i++)
+			{
+				Assert::IsTrue(decoded[i] == cells[i], L"Decode did not return the original cell");
+			}
+		}
+
+		TEST_METHOD(FromPositions)
+		{
+			Vec3f origin(-10.0f, -10.0f, -10.0f);
+			std::vector<Vec3f> points = { Vec3f(-10.0f, -10.0f, -10.0f), Vec3f(-9.5f, -8.0f, -7.9f), Vec3f(-100.0f, 0.0f, 1e30f), Vec3f(0.0f, 5.0f, 20.0f) };
+
+			std::vector<uint64_t> codes(points.size());
+			BB::Bulk::EncodeMorton(points.data(), origin, 0.5f, codes.data(), points.size());
+
+			const uint32_t last = (1u << BB::Bulk::MORTON_BITS_PER_AXIS) - 1;
+			Assert::AreEqual(uint64_t(0), codes[0], L"The origin should be cell 0");
+			Assert::AreEqual(ReferenceMorton(1, 4, 4), codes[1], L"Cell should be floor((p - origin) / size)");
+			Assert::AreEqual(ReferenceMorton(0, 20, last), codes[2], L"Cells outside the grid should be clamped");
+			Assert::AreEqual(ReferenceMorton(20, 30, 60), codes[3]);
+		}
+	};
 }
@@ -1,6 +1,23 @@
 #include "pch.h"
 #include "CppUnitTest.h"
 #include "..\MathLib\Util\Random.h"
+#include "..\MathLib\Util\RandomStream.h"
+#include "..\MathLib\Memory\AlignedAllocator.h"
+#include "..\MathLib\Memory\FrameArena.h"
+#include "..\MathLib\Matrix\Matrix4x4f\Matrix4x4f.h"
+#include "..\MathLib\Vector\Vector4f\Vector4f.h"
+#include "..\MathLib\Vector\Vector3f\Vector3f.h"
+#include "..\MathLib\Util\Denormals.h"
+#include "..\MathLib\Parallel\ThreadPool.h"
+#include "..\MathLib\Bulk\RadixSort.h"
+#include <algorithm>
+#include <atomic>
+#include <cfloat>
+#include <chrono>
+#include <cstdio>
+#include <limits>
+#include <thread>
+#include <vector>
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 
@@ -81,4 +98,508 @@ namespace Random
 			Assert::IsTrue(random == 17.171822538369071, L"Seeded random is not seeded corectly");
 		}
 	};
-}
\ No newline at end of file
+
+	TEST_CLASS(RandomStreamFill)
+	{
+	public:
+		TEST_METHOD(Range_Mean_Determinism)
+		{
+			BB::RandomStream stream(42);
+			std::vector<float> values(100003);
+			stream.Fill(values.data(), values.size(), -2.0f, 6.0f);
+
+			double sum = 0.0;
+			for (float value : values)
+			{
+				Assert::IsTrue(value >= -2.0f && value <= 6.0f, L"Fill wrote a value outside the range");
+				sum += value;
+			}
+			Assert::AreEqual(2.0, sum / values.size(), 0.05, L"The values should be uniform around the middle of the range");
+
+			BB::RandomStream same(42);
+			BB::RandomStream other(43);
+			std::vector<float> repeated(values.size());
+			std::vector<float> different(values.size());
+			same.Fill(repeated.data(), repeated.size(), -2.0f, 6.0f);
+			other.Fill(different.data(), different.size(), -2.0f, 6.0f);
+			Assert::IsTrue(values == repeated, L"The same seed should give the same values");
+			Assert::IsFalse(values == different, L"Different seeds should give different values");
+		}
+	};
+}
+
+namespace Memory
+{
+	TEST_CLASS(AlignedAllocation)
+	{
+		TEST_METHOD(AlignedVector_Alignment)
+		{
+			BB::AlignedVector<Vec3f> vectors(3);
+			BB::AlignedVector<Mat4x4f, 32> matrices(5);
+			BB::AlignedVector<float, 64> floats(7);
+
+			Assert::IsTrue(BB::IsAligned(vectors.data(), 16), L"AlignedVector<Vec3f> is not 16-byte aligned");
+			Assert::IsTrue(BB::IsAligned(matrices.data(), 32), L"AlignedVector<Mat4x4f, 32> is not 32-byte aligned");
+			Assert::IsTrue(BB::IsAligned(floats.data(), 64), L"AlignedVector<float, 64> is not 64-byte aligned");
+
+			// Growing reallocates, the new storage has to be aligned as well
+			for (int i = 0; i < 1000; i++)
+			{
+				floats.push_back(float(i));
+				Assert::IsTrue(BB::IsAligned(floats.data(), 64), L"AlignedVector lost its alignment after growing");
+			}
+			Assert::AreEqual(999.0f, floats.back(), L"AlignedVector does not keep its values");
+			Assert::IsTrue(matrices[4] == Mat4x4f(), L"AlignedVector does not construct its elements");
+		}
+
+		TEST_METHOD(AlignedAlloc_Free)
+		{
+			const size_t alignments[] = { 16, 32, 64, 128 };
+			for (size_t alignment : alignments)
+			{
+				void* memory = BB::AlignedAlloc(100, alignment);
+				Assert::IsTrue(BB::IsAligned(memory, alignment), L"AlignedAlloc returned unaligned memory");
+				BB::AlignedFree(memory, alignment);
+			}
+		}
+	};
+
+	TEST_CLASS(FrameArenaAllocation)
+	{
+		TEST_METHOD(Allocate_Aligned)
+		{
+			BB::FrameArena arena(4096);
+
+			char* bytes = static_cast<char*>(arena.AllocateBytes(3, 1));
+			Vec3f* vectors = arena.Allocate<Vec3f>(10);
+			Mat4x4f* matrices = arena.Allocate<Mat4x4f>(4);
+			void* cacheLine = arena.AllocateBytes(8, 64);
+
+			Assert::IsTrue(bytes != nullptr, L"FrameArena failed a small allocation");
+			Assert::IsTrue(BB::IsAligned(vectors, 16) && BB::IsAligned(matrices, 16), L"FrameArena returned unaligned SIMD memory");
+			Assert::IsTrue(BB::IsAligned(cacheLine, 64), L"FrameArena ignored the requested alignment");
+			Assert::IsTrue(reinterpret_cast<char*>(vectors) >= bytes + 3, L"FrameArena allocations overlap");
+			Assert::IsTrue(reinterpret_cast<char*>(matrices) >= reinterpret_cast<char*>(vectors + 10), L"FrameArena allocations overlap");
+			Assert::IsTrue(vectors[9] == Vec3f() && matrices[3] == Mat4x4f(), L"FrameArena::Allocate does not construct its elements");
+		}
+
+		TEST_METHOD(Reset_Rewind)
+		{
+			BB::FrameArena arena(1024);
+
+			Vec3f* first = arena.AllocateUninitialized<Vec3f>(16);
+			Assert::AreEqual(size_t(256), arena.GetUsed(), L"FrameArena does not track the used size");
+
+			size_t marker = arena.GetMarker();
+			Vec4f* scratch = arena.AllocateUninitialized<Vec4f>(8);
+			arena.Rewind(marker);
+			Assert::IsTrue(arena.AllocateUninitialized<Vec4f>(8) == scratch, L"Rewind should release the allocations after the marker");
+
+			arena.Reset();
+			Assert::AreEqual(size_t(0), arena.GetUsed(), L"Reset should release every allocation");
+			Assert::IsTrue(arena.AllocateUninitialized<Vec3f>(16) == first, L"Reset should start over at the beginning of the block");
+
+			// The whole capacity can be used
+			arena.Reset();
+			Assert::IsTrue(arena.AllocateBytes(arena.GetCapacity()) != nullptr, L"FrameArena should be able to hand out its full capacity");
+		}
+	};
+}
+
+namespace Denormals
+{
+	TEST_CLASS(FlushDenormals)
+	{
+	public:
+		TEST_METHOD(Scoped_Restore)
+		{
+			const unsigned int before = _mm_getcsr();
+			BB::SetFlushDenormals(false);
+			{
+				BB::ScopedFlushDenormals flush;
+				Assert::IsTrue(BB::AreDenormalsFlushed(), L"The guard should set FTZ and DAZ");
+				{
+					BB::ScopedFlushDenormals keep(false);
+					Assert::IsFalse(BB::AreDenormalsFlushed(), L"A disabling guard should clear FTZ and DAZ");
+				}
+				Assert::IsTrue(BB::AreDenormalsFlushed(), L"The inner guard should restore the outer mode");
+
+				volatile float tiny = 1e-39f;
+				Vec3f product = Vec3f(tiny) * 0.5f;
+				Assert::AreEqual(0.0f, product.x, L"Denormal results should be flushed to zero");
+			}
+			Assert::IsFalse(BB::AreDenormalsFlushed(), L"The guard should restore the previous mode");
+			_mm_setcsr(before);
+		}
+
+		TEST_METHOD(WorkerThread)
+		{
+			bool workerFlushed = false;
+			bool workerDefault = true;
+
+			std::thread plain([&] { workerDefault = BB::AreDenormalsFlushed(); });
+			plain.join();
+			std::thread flushed(BB::WithFlushedDenormals([&] { workerFlushed = BB::AreDenormalsFlushed(); }));
+			flushed.join();
+
+			Assert::IsFalse(workerDefault, L"New threads should start without FTZ and DAZ");
+			Assert::IsTrue(workerFlushed, L"WithFlushedDenormals should set the mode on the worker");
+			Assert::AreEqual(6, BB::WithFlushedDenormals([](int aValue) { return aValue * 2; })(3), L"Arguments and result should be forwarded");
+		}
+
+		static unsigned long long DampingCycles(std::vector<Vec3f>& aVelocities, int aIterations)
+		{
+			unsigned long long start = __rdtsc();
+			for (int iteration = 0; iteration < aIterations; iteration++)
+			{
+				for (Vec3f& velocity : aVelocities)
+				{
+					velocity = velocity * 0.999f + velocity * 0.0005f;
+				}
+			}
+			return __rdtsc() - start;
+		}
+
+		TEST_METHOD(Damping_Cycles)
+		{
+			// Damping of values that are already denormal, the case the guard is for
+			const size_t count = 4096;
+			const int iterations = 16;
+			const float denormal = 1e-39f;
+			std::vector<Vec3f> velocities(count);
+
+			std::fill(velocities.begin(), velocities.end(), Vec3f(1.0f));
+			unsigned long long normal = DampingCycles(velocities, iterations);
+
+			std::fill(velocities.begin(), velocities.end(), Vec3f(denormal));
+			unsigned long long slow = DampingCycles(velocities, iterations);
+
+			std::fill(velocities.begin(), velocities.end(), Vec3f(denormal));
+			unsigned long long flushedCycles = 0;
+			{
+				BB::ScopedFlushDenormals flush;
+				flushedCycles = DampingCycles(velocities, iterations);
+			}
+			Assert::IsTrue(velocities[0] == Vec3f(0.0f), L"Flushed damping should reach zero");
+
+			const double operations = double(count) * iterations;
+			char message[256];
+			snprintf(message, sizeof(message), "Vec3f damping, cycles per vector: normal %.2f, denormal %.2f, denormal with ScopedFlushDenormals %.2f\n",
+				normal / operations, slow / operations, flushedCycles / operations);
+			Logger::WriteMessage(message);
+		}
+	};
+}
+
+namespace Parallel
+{
+	TEST_CLASS(ThreadPoolParallelFor)
+	{
+	public:
+		TEST_METHOD(Covers_Range_Once)
+		{
+			BB::ThreadPoolSettings settings;
+			settings.workerCount = 3;
+			BB::ThreadPool pool(settings);
+			Assert::AreEqual(size_t(4), pool.GetThreadCount());
+
+			const size_t counts[] = { 1, 7, 64, 1000, 100003 };
+			const size_t grains[] = { 0, 1, 5, 256 };
+			for (size_t count : counts)
+			{
+				for (size_t grain : grains)
+				{
+					std::vector<std::atomic<int>> visits(count + 10);
+					pool.ParallelFor(10, count + 10, grain, [&](size_t aBegin, size_t aEnd)
+					{
+						Assert::IsTrue(aEnd - aBegin <= std::max<size_t>(grain, 1), L"A chunk is larger than the grain");
+						for (size_t i = aBegin; i < aEnd; i++)
+						{
+							visits[i]++;
+						}
+					});
+					for (size_t i = 0; i < visits.size(); i++)
+					{
+						Assert::AreEqual(i < 10 ? 0 : 1, visits[i].load(), L"Every index in the range should be visited once");
+					}
+				}
+			}
+		}
+
+		TEST_METHOD(Synchronous_Fallback)
+		{
+			BB::ThreadPoolSettings settings;
+			settings.workerCount = 0;
+			BB::ThreadPool single(settings);
+
+			const std::thread::id caller = std::this_thread::get_id();
+			int calls = 0;
+			single.ParallelFor(0, 1000, 10, [&](size_t aBegin, size_t aEnd)
+			{
+				Assert::IsTrue(std::this_thread::get_id() == caller && aBegin == 0 && aEnd == 1000, L"A pool without workers should run the whole range inline");
+				calls++;
+			});
+
+			settings.workerCount = 2;
+			BB::ThreadPool pool(settings);
+			pool.ParallelFor(0, 100, 100, [&](size_t, size_t)
+			{
+				Assert::IsTrue(std::this_thread::get_id() == caller, L"A single chunk should run on the calling thread");
+				calls++;
+			});
+			Assert::AreEqual(2, calls);
+		}
+
+		TEST_METHOD(Nested_And_Array_Grain)
+		{
+			BB::ThreadPoolSettings settings;
+			settings.workerCount = 3;
+			settings.flushDenormals = true;
+			BB::ThreadPool pool(settings);
+
+			std::atomic<size_t> total = 0;
+			std::atomic<int> unalignedChunks = 0;
+			pool.ParallelForArray<Vec3f>(1001, 10, [&](size_t aBegin, size_t aEnd)
+			{
+				// 12 elements is the grain of 10 rounded up to whole cache lines of Vec3f
+				unalignedChunks += (aBegin % 4 != 0) || (aEnd != 1001 && aEnd - aBegin != 12);
+				pool.ParallelFor(aBegin, aEnd, 1, [&](size_t aInnerBegin, size_t aInnerEnd)
+				{
+					total += aInnerEnd - aInnerBegin;
+				});
+			});
+			Assert::AreEqual(size_t(1001), total.load(), L"Nested ParallelFor should run inline");
+			Assert::AreEqual(0, unalignedChunks.load(), L"ParallelForArray chunks should start on cache lines");
+
+			std::atomic<int> flushedChunks = 0;
+			std::atomic<int> workerChunks = 0;
+			const std::thread::id caller = std::this_thread::get_id();
+			pool.ParallelFor(0, 64, 1, [&](size_t, size_t)
+			{
+				if (std::this_thread::get_id() != caller)
+				{
+					workerChunks++;
+					flushedChunks += BB::AreDenormalsFlushed();
+				}
+				std::this_thread::sleep_for(std::chrono::microseconds(100));
+			});
+			Assert::AreEqual(workerChunks.load(), flushedChunks.load(), L"Workers should run with FTZ/DAZ set");
+		}
+	};
+}
+
+namespace Sorting
+{
+	TEST_CLASS(RadixSort)
+	{
+		static uint32_t RandomKey()
+		{
+			return (uint32_t(rand()) << 17) ^ (uint32_t(rand()) << 8) ^ uint32_t(rand());
+		}
+
+		// Sorts the keys with std::stable_sort on the radix order and returns the payload order
+		template<class TKey>
+		static std::vector<uint32_t> ReferenceOrder(const std::vector<TKey>& aKeys)
+		{
+			std::vector<uint32_t> order(aKeys.size());
+			for (size_t i = 0; i < order.size(); i++)
+			{
+				order[i] = uint32_t(i);
+			}
+			std::stable_sort(order.begin(), order.end(), [&](uint32_t aOne, uint32_t aTwo)
+			{
+				if constexpr (std::is_same_v<TKey, float>)
+				{
+					return BB::Bulk::FloatToRadixKey(aKeys[aOne]) < BB::Bulk::FloatToRadixKey(aKeys[aTwo]);
+				}
+				else
+				{
+					return aKeys[aOne] < aKeys[aTwo];
+				}
+			});
+			return order;
+		}
+
+		template<class TKey>
+		static void CheckSorted(const std::vector<TKey>& aOriginal, const std::vector<TKey>& aKeys, const std::vector<uint32_t>& aValues)
+		{
+			const std::vector<uint32_t> order = ReferenceOrder(aOriginal);
+			for (size_t i = 0; i < order.size(); i++)
+			{
+				Assert::AreEqual(order[i], aValues[i], L"Payloads should follow a stable sort of the keys");
+				Assert::IsTrue(std::bit_cast<uint32_t>(aOriginal[order[i]]) == std::bit_cast<uint32_t>(aKeys[i]), L"Key does not match its payload");
+			}
+		}
+
+	public:
+		TEST_METHOD(Keys_And_Values_Stable)
+		{
+			const size_t counts[] = { 0, 1, 3, 4, 5, 17, 1000, 100003 };
+			for (size_t count : counts)
+			{
+				std::vector<uint32_t> original(count);
+				for (uint32_t& key : original)
+				{
+					key = RandomKey();
+				}
+				// Many duplicates, to see stability
+				for (size_t i = 0; i < count; i += 3)
+				{
+					original[i] &= 0xFF00FF00u;
+				}
+
+				std::vector<uint32_t> keys = original;
+				std::vector<uint32_t> values(count), scratchKeys(count), scratchValues(count);
+				for (size_t i = 0; i < count; i++)
+				{
+					values[i] = uint32_t(i);
+				}
+				BB::Bulk::RadixSort(keys.data(), values.data(), scratchKeys.data(), scratchValues.data(), count);
+				CheckSorted(original, keys, values);
+
+				std::vector<uint32_t> keysOnly = original;
+				BB::Bulk::RadixSort(keysOnly.data(), scratchKeys.data(), count);
+				Assert::IsTrue(keysOnly == keys, L"Key only sort should give the same keys");
+			}
+
+			// Only the lowest byte differs, a single pass leaves the result in the scratch arrays
+			std::vector<uint32_t> original(1000);
+			for (uint32_t& key : original)
+			{
+				key = 0x12345600u | (RandomKey() & 0xFF);
+			}
+			std::vector<uint32_t> keys = original;
+			std::vector<uint32_t> values(keys.size()), scratchKeys(keys.size()), scratchValues(keys.size());
+			for (size_t i = 0; i < values.size(); i++)
+			{
+				values[i] = uint32_t(i);
+			}
+			BB::Bulk::RadixSort(keys.data(), values.data(), scratchKeys.data(), scratchValues.data(), keys.size());
+			CheckSorted(original, keys, values);
+		}
+
+		TEST_METHOD(Float_Order)
+		{
+			const float specials[] = { 0.0f, -0.0f, 1.0f, -1.0f, FLT_MAX, -FLT_MAX, FLT_MIN, -FLT_MIN, 1e-40f, -1e-40f,
+				std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(), 0.5f, -0.5f, 3.0f };
+			std::vector<float> original(specials, specials + std::size(specials));
+			for (int i = 0; i < 5000; i++)
+			{
+				original.push_back(BB::Random(-1000.0f, 1000.0f));
+				original.push_back(float(rand() % 7) - 3.0f);
+			}
+
+			std::vector<float> keys = original;
+			std::vector<float> scratchKeys(keys.size());
+			std::vector<uint32_t> values(keys.size()), scratchValues(keys.size());
+			for (size_t i = 0; i < values.size(); i++)
+			{
+				values[i] = uint32_t(i);
+			}
+			BB::Bulk::RadixSort(keys.data(), values.data(), scratchKeys.data(), scratchValues.data(), keys.size());
+			CheckSorted(original, keys, values);
+
+			std::vector<float> expected = original;
+			std::sort(expected.begin(), expected.end());
+			for (size_t i = 0; i < keys.size(); i++)
+			{
+				Assert::IsTrue(keys[i] == expected[i], L"Float keys should be in ascending order");
+			}
+			Assert::IsTrue(std::signbit(keys[std::find(keys.begin(), keys.end(), 0.0f) - keys.begin()]), L"-0.0 should sort before +0.0");
+
+			for (float value : specials)
+			{
+				Assert::IsTrue(std::bit_cast<uint32_t>(value) == std::bit_cast<uint32_t>(BB::Bulk::RadixKeyToFloat(BB::Bulk::FloatToRadixKey(value))));
+			}
+			const float nan = std::numeric_limits<float>::quiet_NaN();
+			Assert::IsTrue(BB::Bulk::FloatToRadixKey(nan) > BB::Bulk::FloatToRadixKey(std::numeric_limits<float>::infinity()));
+			Assert::IsTrue(BB::Bulk::FloatToRadixKey(-nan) < BB::Bulk::FloatToRadixKey(-std::numeric_limits<float>::infinity()));
+		}
+
+		TEST_METHOD(Parallel_Matches_Serial)
+		{
+			BB::ThreadPoolSettings settings;
+			settings.workerCount = 3;
+			BB::ThreadPool pool(settings);
+
+			const size_t counts[] = { 1000, BB::Bulk::RADIX_PARALLEL_MIN_COUNT, 1000003 };
+			for (size_t count : counts)
+			{
+				std::vector<float> original(count);
+				for (size_t i = 0; i < count; i++)
+				{
+					original[i] = i % 5 == 0 ? float(i % 100) : BB::Random(-1e6f, 1e6f);
+				}
+				std::vector<float> keys = original;
+				std::vector<float> scratchKeys(count);
+				std::vector<uint32_t> values(count), scratchValues(count);
+				for (size_t i = 0; i < count; i++)
+				{
+					values[i] = uint32_t(i);
+				}
+				BB::Bulk::RadixSort(pool, keys.data(), values.data(), scratchKeys.data(), scratchValues.data(), count);
+				CheckSorted(original, keys, values);
+
+				std::vector<uint32_t> integers(count), scratchIntegers(count);
+				for (uint32_t& key : integers)
+				{
+					key = RandomKey() & 0xFFFF0FFFu;
+				}
+				std::vector<uint32_t> expected = integers;
+				std::sort(expected.begin(), expected.end());
+				BB::Bulk::RadixSort(pool, integers.data(), scratchIntegers.data(), count);
+				Assert::IsTrue(integers == expected, L"Parallel key only sort does not match std::sort");
+			}
+		}
+
+		TEST_METHOD(Against_StdSort_1K_To_100M)
+		{
+			BB::ThreadPool pool;
+			size_t count = 1000;
+			// 100M takes about 2 GB and a few seconds, define BB_BENCHMARK_100M to include it
+#ifdef BB_BENCHMARK_100M
+			const size_t largest = 100000000;
+#else
+			const size_t largest = 10000000;
+#endif
+			for (; count <= largest; count *= 10)
+			{
+				const int repeats = int(std::max<size_t>(1, 1000000 / count));
+				std::vector<float> original(count);
+				for (float& key : original)
+				{
+					key = BB::Random(-1000.0f, 1000.0f);
+				}
+				std::vector<float> keys(count), scratchKeys(count);
+				std::vector<uint32_t> values(count), scratchValues(count);
+
+				auto measure = [&](auto aSort)
+				{
+					double milliseconds = 0.0;
+					for (int run = 0; run < repeats; run++)
+					{
+						keys = original;
+						for (size_t i = 0; i < count; i++)
+						{
+							values[i] = uint32_t(i);
+						}
+						const auto start = std::chrono::steady_clock::now();
+						aSort();
+						milliseconds += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+					}
+					return milliseconds / repeats;
+				};
+
+				const double stdSort = measure([&] { std::sort(keys.begin(), keys.end()); });
+				const double radix = measure([&] { BB::Bulk::RadixSort(keys.data(), scratchKeys.data(), count); });
+				const double radixValues = measure([&] { BB::Bulk::RadixSort(keys.data(), values.data(), scratchKeys.data(), scratchValues.data(), count); });
+				const double radixParallel = measure([&] { BB::Bulk::RadixSort(pool, keys.data(), values.data(), scratchKeys.data(), scratchValues.data(), count); });
+
+				char message[256];
+				snprintf(message, sizeof(message), "Sort %zu floats, ms: std::sort %.3f, radix %.3f (%.1fx), radix key-value %.3f, on %zu threads %.3f\n",
+					count, stdSort, radix, stdSort / radix, radixValues, pool.GetThreadCount(), radixParallel);
+				Logger::WriteMessage(message);
+			}
+		}
+	};
+}
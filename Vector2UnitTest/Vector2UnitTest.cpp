@@ -317,4 +317,85 @@ namespace Vector2f_Scalar
 			Assert::IsTrue(BB::AlmostEqual(result.y, expected.y), L"GetRotatedZ did not return expected vector.");
 		}
 	};
+
+	TEST_CLASS(FusedArithmetic)
+	{
+		TEST_METHOD(MulAdd_MulSub_NegMulAdd)
+		{
+			Vec2f a(2.0f, -3.0f);
+			Vec2f b(4.0f, 5.0f);
+			Vec2f c(1.0f, 10.0f);
+
+			Assert::IsTrue(MulAdd(a, b, c) == Vec2f(9.0f, -5.0f), L"MulAdd is not done correctly");
+			Assert::IsTrue(MulAdd(a, 2.0f, c) == Vec2f(5.0f, 4.0f), L"MulAdd with scalar is not done correctly");
+			Assert::IsTrue(MulSub(a, b, c) == Vec2f(7.0f, -25.0f), L"MulSub is not done correctly");
+			Assert::IsTrue(NegMulAdd(a, b, c) == Vec2f(-7.0f, 25.0f), L"NegMulAdd is not done correctly");
+		}
+
+		TEST_METHOD(Lerp_Endpoints)
+		{
+			Vec2f from(0.0f, 10.0f);
+			Vec2f to(10.0f, 20.0f);
+
+			Assert::IsTrue(Lerp(from, to, 0.0f) == from, L"Lerp with t = 0 should return the start");
+			Assert::IsTrue(Lerp(from, to, 1.0f) == to, L"Lerp with t = 1 should return the end");
+			Assert::IsTrue(Lerp(from, to, 0.25f) == Vec2f(2.5f, 12.5f), L"Lerp with t = 0.25 is not done correctly");
+		}
+	};
+
+	TEST_CLASS(ConstantEvaluation)
+	{
+		TEST_METHOD(Static_Asserts)
+		{
+			constexpr Vec2f a(1.0f, 2.0f);
+			constexpr Vec2f b(3.0f, 4.0f);
+
+			static_assert(a + b == Vec2f(4.0f, 6.0f), "Constexpr add is not done correctly");
+			static_assert(b - a == Vec2f(2.0f), "Constexpr subtract is not done correctly");
+			static_assert(a * 2.0f == Vec2f(2.0f, 4.0f) && b / 2.0f == Vec2f(1.5f, 2.0f), "Constexpr scale is not done correctly");
+			static_assert(a.Dot(b) == 11.0f && b.LengthSqr() == 25.0f, "Constexpr dot is not done correctly");
+			static_assert(a.DistanceTo(b) == Vec2f(2.0f), "Constexpr distance is not done correctly");
+		}
+	};
+
+	TEST_CLASS(LoadStore)
+	{
+		TEST_METHOD(Load_Store)
+		{
+			float buffer[4] = { 1.0f, 2.0f, -1.0f, -1.0f };
+
+			Vec2f loaded = Vec2f::LoadUnaligned(buffer);
+			Assert::IsTrue(loaded == Vec2f(1.0f, 2.0f) && Vec2f::LoadAligned(buffer) == loaded, L"Load did not read the vector");
+
+			Vec2f(3.0f, 4.0f).StoreUnaligned(buffer + 1);
+			Assert::IsTrue(buffer[0] == 1.0f && buffer[1] == 3.0f && buffer[2] == 4.0f && buffer[3] == -1.0f, L"StoreUnaligned did not write exactly two floats");
+
+			Vec2f(5.0f, 6.0f).StoreStream(buffer + 2);
+			Assert::IsTrue(Vec2f::LoadUnaligned(buffer + 2) == Vec2f(5.0f, 6.0f), L"StoreStream did not write the vector");
+		}
+	};
+
+
+	TEST_CLASS(ComponentWise)
+	{
+	public:
+		TEST_METHOD(AllFunctions)
+		{
+			Vec2f a(1.5f, -1.5f);
+			Vec2f b(2.0f, -2.0f);
+
+			Assert::IsTrue(Min(a, b) == Vec2f(1.5f, -2.0f), L"Min failed");
+			Assert::IsTrue(Max(a, b) == Vec2f(2.0f, -1.5f), L"Max failed");
+			Assert::IsTrue(Abs(a) == Vec2f(1.5f, 1.5f), L"Abs failed");
+			Assert::IsTrue(Clamp(a, 0.0f, 1.0f) == Vec2f(1.0f, 0.0f), L"Clamp failed");
+			Assert::IsTrue(Clamp(a, Vec2f(2.0f, -3.0f), Vec2f(3.0f, -2.0f)) == Vec2f(2.0f, -2.0f), L"Vector Clamp failed");
+			Assert::IsTrue(Floor(a) == Vec2f(1.0f, -2.0f) && Ceil(a) == Vec2f(2.0f, -1.0f), L"Floor or Ceil failed");
+			Assert::IsTrue(Sign(a) == Vec2f(1.0f, -1.0f) && Sign(Vec2f(0.0f, NAN)) == Vec2f(0.0f, 0.0f), L"Sign failed");
+			Assert::IsTrue(Lerp(a, b, Vec2f(1.0f, 0.5f)) == Vec2f(2.0f, -1.75f), L"Lerp failed");
+			Assert::IsTrue(Select(GreaterMask(a, b), a, b) == Max(a, b), L"Select with GreaterMask should match Max");
+			Assert::IsTrue(Select(LessMask(a, b), a, b) == Vec2f(1.5f, -2.0f), L"Select with LessMask failed");
+			Assert::IsTrue(Select(EqualMask(a, a), a, b) == a && Select(LessEqualMask(b, a), a, b) == Vec2f(2.0f, -1.5f), L"EqualMask or LessEqualMask failed");
+			Assert::IsTrue(Select(GreaterEqualMask(a, Vec2f(0.0f)), a, b) == Vec2f(1.5f, -2.0f), L"GreaterEqualMask failed");
+		}
+	};
 }
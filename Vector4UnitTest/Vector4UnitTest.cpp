@@ -3,6 +3,13 @@
 #include "..\MathLib\Vector\Vector4f\Vector4f.h"
 #include "..\MathLib\Util\Random.h"
 #include "..\MathLib\Util\CommonMath.h"
+#include "..\MathLib\Expression\LazyExpression.h"
+#include "..\MathLib\Bulk\Codec.h"
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <intrin.h>
+#include <vector>
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 
@@ -303,4 +310,450 @@ namespace Vector4f
 		}
 
 	};
+
+	TEST_CLASS(FusedArithmetic)
+	{
+		TEST_METHOD(MulAdd_MulSub_NegMulAdd)
+		{
+			int runs = 100;
+			const float size = 100.0f;
+			for (int i = 0; i < runs; i++)
+			{
+				Vec4f a(BB::Random(-size, size), BB::Random(-size, size), BB::Random(-size, size), BB::Random(-size, size));
+				Vec4f b(BB::Random(-size, size), BB::Random(-size, size), BB::Random(-size, size), BB::Random(-size, size));
+				Vec4f c(BB::Random(-size, size), BB::Random(-size, size), BB::Random(-size, size), BB::Random(-size, size));
+				float scalar = BB::Random(-size, size);
+
+				Vec4f mulAdd = MulAdd(a, b, c);
+				Vec4f mulSub = MulSub(a, scalar, c);
+				Vec4f negMulAdd = NegMulAdd(a, b, c);
+
+				Assert::IsTrue(BB::AlmostEqual(mulAdd.x, a.x * b.x + c.x, 0.01f) && BB::AlmostEqual(mulAdd.w, a.w * b.w + c.w, 0.01f), L"MulAdd is not done correctly");
+				Assert::IsTrue(BB::AlmostEqual(mulSub.y, a.y * scalar - c.y, 0.01f) && BB::AlmostEqual(mulSub.w, a.w * scalar - c.w, 0.01f), L"MulSub is not done correctly");
+				Assert::IsTrue(BB::AlmostEqual(negMulAdd.z, c.z - a.z * b.z, 0.01f) && BB::AlmostEqual(negMulAdd.w, c.w - a.w * b.w, 0.01f), L"NegMulAdd is not done correctly");
+			}
+		}
+
+		TEST_METHOD(Lerp_Endpoints)
+		{
+			Vec4f from(0.0f, 10.0f, -10.0f, 1.0f);
+			Vec4f to(10.0f, 20.0f, 10.0f, 3.0f);
+
+			Assert::IsTrue(Lerp(from, to, 0.0f) == from, L"Lerp with t = 0 should return the start");
+			Assert::IsTrue(Lerp(from, to, 1.0f) == to, L"Lerp with t = 1 should return the end");
+			Assert::IsTrue(Lerp(from, to, 0.5f) == Vec4f(5.0f, 15.0f, 0.0f, 2.0f), L"Lerp with t = 0.5 should return the middle");
+		}
+	};
+
+	TEST_CLASS(LazyExpression)
+	{
+		TEST_METHOD(Single)
+		{
+			Vec4f a(1.0f, 2.0f, 3.0f, 4.0f);
+			Vec4f b(2.0f, 2.0f, 2.0f, 2.0f);
+			Vec4f c(0.5f, 1.0f, 1.5f, 2.0f);
+
+			Vec4f result = BB::Lazy(a) * b + c;
+			Assert::IsTrue(result == Vec4f(2.5f, 5.0f, 7.5f, 10.0f), L"Lazy expression is not evaluated correctly");
+
+			result = (BB::Lazy(a) - c) / b;
+			Assert::IsTrue(result == Vec4f(0.25f, 0.5f, 0.75f, 1.0f), L"Lazy division is not evaluated correctly");
+		}
+
+		TEST_METHOD(Array)
+		{
+			const int count = 64;
+			Vec4f from[count];
+			Vec4f to[count];
+			Vec4f output[count];
+			for (int i = 0; i < count; i++)
+			{
+				from[i] = Vec4f(float(i));
+				to[i] = Vec4f(float(i) * 3.0f);
+			}
+
+			// Lerp written as an expression over two arrays
+			BB::Evaluate(output, count, BB::Lazy(from) + (BB::Lazy(to) - BB::Lazy(from)) * 0.5f);
+			for (int i = 0; i < count; i++)
+			{
+				Assert::IsTrue(output[i] == Vec4f(float(i) * 2.0f), L"Lazy array expression is not evaluated correctly");
+			}
+		}
+	};
+
+	TEST_CLASS(ConstantEvaluation)
+	{
+		TEST_METHOD(Static_Asserts)
+		{
+			constexpr Vec4f a(1.0f, 2.0f, 3.0f, 4.0f);
+			constexpr Vec4f b(2.0f, 4.0f, 6.0f, 8.0f);
+
+			static_assert(a + a == b, "Constexpr add is not done correctly");
+			static_assert(b - a == a, "Constexpr subtract is not done correctly");
+			static_assert(2.0f * a == b && b / 2.0f == a, "Constexpr scale is not done correctly");
+			static_assert(b / a == Vec4f(2.0f), "Constexpr divide is not done correctly");
+			static_assert(-a != a, "Constexpr negate is not done correctly");
+			static_assert(a.Dot(b) == 60.0f && a.LengthSqr() == 30.0f, "Constexpr dot is not done correctly");
+			static_assert(BB::VEC4F_UNIT_X + BB::VEC4F_UNIT_Y + BB::VEC4F_UNIT_Z + BB::VEC4F_UNIT_W == BB::VEC4F_ONE, "Constexpr constants are not set correctly");
+		}
+
+		TEST_METHOD(Matches_Runtime)
+		{
+			constexpr Vec4f baked = (Vec4f(1.0f, -2.0f, 3.0f, -4.0f) * Vec4f(0.5f) - BB::VEC4F_UNIT_W) / 4.0f;
+
+			Vec4f runtime = (Vec4f(1.0f, -2.0f, 3.0f, -4.0f) * Vec4f(0.5f) - Vec4f(0.0f, 0.0f, 0.0f, 1.0f)) / 4.0f;
+
+			Assert::IsTrue(baked == runtime, L"Constant evaluated result differs from the SIMD path");
+			Assert::AreEqual(-0.75f, baked.w, L"Constexpr result is not readable at runtime");
+		}
+	};
+
+	TEST_CLASS(LoadStore)
+	{
+		TEST_METHOD(Load_Store)
+		{
+			alignas(16) float buffer[12] = { 0.0f, 1.0f, 2.0f, 3.0f, 4.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f };
+
+			Assert::IsTrue(Vec4f::LoadUnaligned(buffer + 1) == Vec4f(1.0f, 2.0f, 3.0f, 4.0f), L"LoadUnaligned did not read the vector");
+			Assert::IsTrue(Vec4f::LoadAligned(buffer) == Vec4f(0.0f, 1.0f, 2.0f, 3.0f), L"LoadAligned did not read the vector");
+
+			Vec4f value(5.0f, 6.0f, 7.0f, 8.0f);
+			value.StoreUnaligned(buffer + 5);
+			Assert::IsTrue(Vec4f::LoadUnaligned(buffer + 5) == value && buffer[9] == -1.0f, L"StoreUnaligned did not write exactly four floats");
+
+			value.StoreAligned(buffer + 4);
+			Assert::IsTrue(Vec4f::LoadAligned(buffer + 4) == value, L"StoreAligned did not write the vector");
+
+			(-value).StoreStream(buffer + 8);
+			BB::Simd::StreamFence();
+			Assert::IsTrue(Vec4f::LoadAligned(buffer + 8) == -value, L"StoreStream did not write the vector");
+		}
+	};
+
+	TEST_CLASS(Codec)
+	{
+	public:
+
+		TEST_METHOD(Half_KnownValues)
+		{
+			const Vec4f values[2] = { Vec4f(1.0f, -2.0f, 65504.0f, 65520.0f), Vec4f(0.1f, 1e-7f, -0.0f, 1e-9f) };
+			const uint16_t expected[8] = { 0x3c00, 0xc000, 0x7bff, 0x7c00, 0x2e66, 0x0002, 0x8000, 0x0000 };
+			uint16_t halves[8];
+			BB::Bulk::EncodeHalf(values, halves, 2);
+			for (int i = 0; i < 8; i++)
+			{
+				Assert::AreEqual(expected[i], halves[i], L"EncodeHalf gives the wrong bits");
+			}
+
+			Vec4f decoded[2];
+			BB::Bulk::DecodeHalf(halves, decoded, 2);
+			Assert::IsTrue(decoded[0] == Vec4f(1.0f, -2.0f, 65504.0f, INFINITY), L"DecodeHalf gives the wrong value");
+			Assert::AreEqual(0.0999755859375f, decoded[1].x, L"DecodeHalf gives the wrong value");
+			Assert::AreEqual(ldexpf(1.0f, -23), decoded[1].y, L"DecodeHalf does not handle subnormals");
+		}
+
+		TEST_METHOD(Half_AllValues)
+		{
+			// Every half that is not NaN survives a round trip through float
+			std::vector<uint16_t> halves;
+			for (uint32_t bits = 0; bits < 0x10000; bits++)
+			{
+				if ((bits & 0x7c00) != 0x7c00 || (bits & 0x3ff) == 0)
+				{
+					halves.push_back(uint16_t(bits));
+				}
+			}
+			halves.resize(halves.size() & ~size_t(3));
+			std::vector<Vec4f> decoded(halves.size() / 4);
+			std::vector<uint16_t> encoded(halves.size());
+			BB::Bulk::DecodeHalf(halves.data(), decoded.data(), decoded.size());
+			BB::Bulk::EncodeHalf(decoded.data(), encoded.data(), decoded.size());
+			Assert::IsTrue(halves == encoded, L"A half did not survive the round trip");
+
+			// Random floats round to the nearest half
+			for (int i = 0; i < 10000; i++)
+			{
+				const Vec4f value(BB::Random(-70000.0f, 70000.0f), BB::Random(-1.0f, 1.0f), BB::Random(-0.001f, 0.001f), BB::Random(-1e-6f, 1e-6f));
+				uint16_t half[4];
+				Vec4f rounded;
+				BB::Bulk::EncodeHalf(&value, half, 1);
+				BB::Bulk::DecodeHalf(half, &rounded, 1);
+				for (int c = 0; c < 4; c++)
+				{
+					const float original = value.lanes.value[c];
+					const float result = rounded.lanes.value[c];
+					if (std::abs(original) > 65520.0f)
+					{
+						Assert::IsTrue(std::isinf(result), L"EncodeHalf should overflow to infinity");
+						continue;
+					}
+					uint16_t neighbour = uint16_t(half[c] + (std::abs(result) < std::abs(original) ? 1 : -1));
+					if ((half[c] & 0x7fff) == 0)
+					{
+						neighbour = uint16_t((original < 0.0f ? 0x8000 : 0) | 1);
+					}
+					Vec4f other;
+					const uint16_t others[4] = { neighbour, 0, 0, 0 };
+					BB::Bulk::DecodeHalf(others, &other, 1);
+					Assert::IsTrue(std::abs(result - original) <= std::abs(other.x - original), L"EncodeHalf did not round to nearest");
+				}
+			}
+		}
+
+		TEST_METHOD(Vec3f_Tail)
+		{
+			// Three component elements are written with wider stores, the last one must not spill
+			for (size_t count = 1; count < 6; count++)
+			{
+				std::vector<Vec3f> vectors(count);
+				for (Vec3f& vector : vectors)
+				{
+					vector = Vec3f(BB::Random(0.0f, 1.0f), BB::Random(0.0f, 1.0f), BB::Random(0.0f, 1.0f));
+				}
+				std::vector<uint16_t> halves(count * 3 + 1, 0xabcd);
+				std::vector<int16_t> snorms(count * 3 + 1, 0x1234);
+				std::vector<uint8_t> bytes(count * 3 + 1, 0x42);
+				BB::Bulk::EncodeHalf(vectors.data(), halves.data(), count);
+				BB::Bulk::EncodeSnorm16(vectors.data(), snorms.data(), count);
+				BB::Bulk::EncodeUnorm8(vectors.data(), bytes.data(), count);
+				Assert::AreEqual(uint16_t(0xabcd), halves.back(), L"EncodeHalf wrote past the end");
+				Assert::AreEqual(int16_t(0x1234), snorms.back(), L"EncodeSnorm16 wrote past the end");
+				Assert::AreEqual(uint8_t(0x42), bytes.back(), L"EncodeUnorm8 wrote past the end");
+
+				std::vector<Vec3f> fromHalf(count), fromSnorm(count), fromUnorm(count);
+				BB::Bulk::DecodeHalf(halves.data(), fromHalf.data(), count);
+				BB::Bulk::DecodeSnorm16(snorms.data(), fromSnorm.data(), count);
+				BB::Bulk::DecodeUnorm8(bytes.data(), fromUnorm.data(), count);
+				for (size_t i = 0; i < count; i++)
+				{
+					for (int c = 0; c < 3; c++)
+					{
+						Assert::AreEqual(vectors[i].lanes.value[c], fromHalf[i].lanes.value[c], 0.0005f, L"Half round trip is off");
+						Assert::AreEqual(vectors[i].lanes.value[c], fromSnorm[i].lanes.value[c], 0.00002f, L"Snorm16 round trip is off");
+						Assert::AreEqual(vectors[i].lanes.value[c], fromUnorm[i].lanes.value[c], 0.002f, L"Unorm8 round trip is off");
+					}
+					Assert::AreEqual(0.0f, fromHalf[i].lanes.value[3], L"Decoded Vec3f should have w = 0");
+					Assert::AreEqual(0.0f, fromSnorm[i].lanes.value[3], L"Decoded Vec3f should have w = 0");
+					Assert::AreEqual(0.0f, fromUnorm[i].lanes.value[3], L"Decoded Vec3f should have w = 0");
+				}
+			}
+		}
+
+		TEST_METHOD(Normalized_ClampAndRound)
+		{
+			const Vec4f values[2] = { Vec4f(1.0f, -1.0f, 2.0f, 0.5f), Vec4f(NAN, -2.0f, 0.0f, 0.25f) };
+			int16_t snorms[8];
+			BB::Bulk::EncodeSnorm16(values, snorms, 2);
+			const int16_t expectedSnorms[8] = { 32767, -32767, 32767, 16384, -32767, -32767, 0, 8192 };
+			for (int i = 0; i < 8; i++)
+			{
+				Assert::AreEqual(expectedSnorms[i], snorms[i], L"EncodeSnorm16 gives the wrong value");
+			}
+
+			uint8_t bytes[8];
+			BB::Bulk::EncodeUnorm8(values, bytes, 2);
+			const uint8_t expectedBytes[8] = { 255, 0, 255, 128, 0, 0, 0, 64 };
+			for (int i = 0; i < 8; i++)
+			{
+				Assert::AreEqual(expectedBytes[i], bytes[i], L"EncodeUnorm8 gives the wrong value");
+			}
+
+			const int16_t extremes[4] = { -32768, -32767, 32767, 0 };
+			Vec4f decoded;
+			BB::Bulk::DecodeSnorm16(extremes, &decoded, 1);
+			Assert::IsTrue(decoded == Vec4f(-1.0f, -1.0f, 1.0f, 0.0f), L"DecodeSnorm16 should map the extremes to -1 and 1");
+
+			const uint8_t colors[4] = { 0, 255, 51, 128 };
+			BB::Bulk::DecodeUnorm8(colors, &decoded, 1);
+			Assert::IsTrue(decoded.x == 0.0f && decoded.y == 1.0f, L"DecodeUnorm8 should map the extremes to 0 and 1");
+			Assert::AreEqual(0.2f, decoded.z, 0.0000001f, L"DecodeUnorm8 gives the wrong value");
+			Assert::AreEqual(128.0f / 255.0f, decoded.w, 0.0000001f, L"DecodeUnorm8 gives the wrong value");
+		}
+
+		TEST_METHOD(Octahedral)
+		{
+			std::vector<Vec3f> normals = { Vec3f(1.0f, 0.0f, 0.0f), Vec3f(0.0f, -1.0f, 0.0f), Vec3f(0.0f, 0.0f, 1.0f), Vec3f(0.0f, 0.0f, -1.0f), Vec3f(0.0f, 0.0f, 0.0f) };
+			for (int i = 0; i < 10002; i++)
+			{
+				Vec3f normal(BB::Random(-1.0f, 1.0f), BB::Random(-1.0f, 1.0f), BB::Random(-1.0f, 1.0f));
+				normals.push_back(normal * BB::Random(0.1f, 10.0f) / normal.Length());
+			}
+
+			std::vector<uint32_t> packed(normals.size());
+			std::vector<Vec3f> decoded(normals.size());
+			BB::Bulk::EncodeOctahedral(normals.data(), packed.data(), normals.size());
+			BB::Bulk::DecodeOctahedral(packed.data(), decoded.data(), normals.size());
+
+			Assert::IsTrue(decoded[4] == Vec3f(0.0f, 0.0f, 1.0f), L"A zero vector should decode as +z");
+			for (size_t i = 0; i < normals.size(); i++)
+			{
+				Assert::AreEqual(1.0f, decoded[i].Length(), 0.000001f, L"Decoded normals should have unit length");
+				Assert::AreEqual(0.0f, decoded[i].lanes.value[3], L"Decoded Vec3f should have w = 0");
+				if (i != 4)
+				{
+					// The chord between unit vectors is the angle for small angles, and more precise than acos
+					const float angle = (decoded[i] - normals[i] / normals[i].Length()).Length();
+					Assert::IsTrue(angle < 0.0001f, L"Octahedral round trip error is too large");
+				}
+			}
+		}
+
+		TEST_METHOD(Packed1010102)
+		{
+			const Vec4f colors[3] = { Vec4f(1.0f, 0.0f, 0.5f, 1.0f), Vec4f(-1.0f, 2.0f, 0.25f, 0.4f), Vec4f(0.1f, 0.2f, 0.3f, 0.0f) };
+			uint32_t unorm[3];
+			BB::Bulk::EncodeUnorm1010102(colors, unorm, 3);
+			Assert::AreEqual(1023u | 512u << 20 | 3u << 30, unorm[0], L"EncodeUnorm1010102 gives the wrong bits");
+			Assert::AreEqual(1023u << 10 | 256u << 20 | 1u << 30, unorm[1], L"EncodeUnorm1010102 gives the wrong bits");
+
+			Vec4f decoded[3];
+			BB::Bulk::DecodeUnorm1010102(unorm, decoded, 3);
+			Assert::IsTrue(decoded[0].x == 1.0f && decoded[0].y == 0.0f && decoded[0].w == 1.0f, L"DecodeUnorm1010102 gives the wrong value");
+			Assert::AreEqual(1.0f / 3.0f, decoded[1].w, L"DecodeUnorm1010102 gives the wrong value");
+			for (int c = 0; c < 3; c++)
+			{
+				Assert::AreEqual(colors[2].lanes.value[c], decoded[2].lanes.value[c], 0.5f / 1023.0f, L"Unorm1010102 round trip is off");
+			}
+
+			const Vec4f tangents[2] = { Vec4f(-1.0f, 1.0f, 0.0f, -1.0f), Vec4f(0.5f, -0.25f, -2.0f, 1.0f) };
+			uint32_t snorm[2];
+			BB::Bulk::EncodeSnorm1010102(tangents, snorm, 2);
+			Assert::AreEqual(0x201u | 511u << 10 | 3u << 30, snorm[0], L"EncodeSnorm1010102 gives the wrong bits");
+
+			BB::Bulk::DecodeSnorm1010102(snorm, decoded, 2);
+			Assert::IsTrue(decoded[0] == tangents[0], L"DecodeSnorm1010102 gives the wrong value");
+			Assert::AreEqual(-1.0f, decoded[1].z, L"EncodeSnorm1010102 should clamp");
+			Assert::AreEqual(1.0f, decoded[1].w, L"DecodeSnorm1010102 gives the wrong value");
+			Assert::AreEqual(0.5f, decoded[1].x, 0.5f / 511.0f, L"Snorm1010102 round trip is off");
+			Assert::AreEqual(-0.25f, decoded[1].y, 0.5f / 511.0f, L"Snorm1010102 round trip is off");
+		}
+
+		TEST_METHOD(DecodeHalf_Cycles)
+		{
+			const size_t count = 1 << 16;
+			std::vector<uint16_t> halves(count * 4);
+			for (size_t i = 0; i < halves.size(); i++)
+			{
+				halves[i] = uint16_t(0x3c00 + (i & 0x3ff));
+			}
+			std::vector<Vec4f> vectors(count);
+
+			unsigned long long start = __rdtsc();
+			BB::Bulk::DecodeHalf(halves.data(), vectors.data(), count);
+			unsigned long long bulk = __rdtsc() - start;
+
+			start = __rdtsc();
+			for (size_t i = 0; i < count; i++)
+			{
+				float components[4];
+				for (int c = 0; c < 4; c++)
+				{
+					// Scalar decode of normal halves, what the loops this replaces did
+					const uint16_t half = halves[i * 4 + c];
+					components[c] = ldexpf(1.0f + (half & 0x3ff) / 1024.0f, ((half >> 10) & 0x1f) - 15);
+				}
+				vectors[i] = Vec4f(components[0], components[1], components[2], components[3]);
+			}
+			unsigned long long scalar = __rdtsc() - start;
+
+			char message[256];
+			snprintf(message, sizeof(message), "DecodeHalf, cycles per Vec4f: %.2f, scalar loop %.2f\n", double(bulk) / count, double(scalar) / count);
+			Logger::WriteMessage(message);
+		}
+	};
+
+
+	TEST_CLASS(ComponentWise)
+	{
+	public:
+		TEST_METHOD(AllFunctions)
+		{
+			Vec4f a(1.5f, -1.5f, 3.0f, -0.25f);
+			Vec4f b(2.0f, -2.0f, 3.0f, 0.0f);
+
+			Assert::IsTrue(Min(a, b) == Vec4f(1.5f, -2.0f, 3.0f, -0.25f), L"Min failed");
+			Assert::IsTrue(Max(a, b) == Vec4f(2.0f, -1.5f, 3.0f, 0.0f), L"Max failed");
+			Assert::IsTrue(Abs(a) == Vec4f(1.5f, 1.5f, 3.0f, 0.25f), L"Abs failed");
+			Assert::IsTrue(Clamp(a, 0.0f, 2.0f) == Vec4f(1.5f, 0.0f, 2.0f, 0.0f), L"Clamp failed");
+			Assert::IsTrue(Floor(a) == Vec4f(1.0f, -2.0f, 3.0f, -1.0f), L"Floor failed");
+			Assert::IsTrue(Ceil(a) == Vec4f(2.0f, -1.0f, 3.0f, -0.0f), L"Ceil failed");
+			Assert::IsTrue(Sign(a) == Vec4f(1.0f, -1.0f, 1.0f, -1.0f), L"Sign failed");
+			Assert::IsTrue(Lerp(a, b, Vec4f(0.0f, 1.0f, 0.5f, 1.0f)) == Vec4f(1.5f, -2.0f, 3.0f, 0.0f), L"Lerp failed");
+			Assert::IsTrue(Select(GreaterMask(a, b), a, b) == Max(a, b), L"Select with GreaterMask should match Max");
+			Assert::IsTrue(Select(LessEqualMask(a, b), a, b) == Min(a, b), L"Select with LessEqualMask should match Min");
+		}
+	};
+
+
+	TEST_CLASS(FastMath)
+	{
+	public:
+		TEST_METHOD(Error_And_Cycles)
+		{
+			const size_t count = 4096;
+			std::vector<Vec4f> vectors(count);
+			for (size_t i = 0; i < count; i++)
+			{
+				vectors[i] = Vec4f(BB::Random(-10.0f, 10.0f), BB::Random(-10.0f, 10.0f), BB::Random(-10.0f, 10.0f), BB::Random(0.5f, 10.0f));
+			}
+
+			for (size_t i = 0; i < count; i++)
+			{
+				Vec4f exact = vectors[i].GetNormalized();
+				Assert::IsTrue((vectors[i].GetNormalizedFast<0>() - exact).Length() < 4e-4f, L"The estimate should be within 4e-4");
+				Assert::IsTrue((vectors[i].GetNormalizedFast() - exact).Length() < 1e-6f, L"One refinement should be within 1e-6");
+				Assert::AreEqual(vectors[i].Length(), vectors[i].LengthFast(), vectors[i].Length() * 1e-6f, L"LengthFast failed");
+
+				Vec4f quotient = DivideFast(exact, vectors[i]);
+				Vec4f reference = exact / vectors[i];
+				Assert::IsTrue((quotient - reference).Length() <= reference.Length() * 1e-6f, L"DivideFast failed");
+			}
+
+			std::vector<Vec4f> output(count);
+			unsigned long long start = __rdtsc();
+			for (size_t i = 0; i < count; i++)
+			{
+				output[i] = vectors[i].GetNormalized();
+			}
+			unsigned long long exactCycles = __rdtsc() - start;
+
+			start = __rdtsc();
+			for (size_t i = 0; i < count; i++)
+			{
+				output[i] = vectors[i].GetNormalizedFast<0>();
+			}
+			unsigned long long estimateCycles = __rdtsc() - start;
+
+			start = __rdtsc();
+			for (size_t i = 0; i < count; i++)
+			{
+				output[i] = vectors[i].GetNormalizedFast<1>();
+			}
+			unsigned long long refinedCycles = __rdtsc() - start;
+
+			char message[256];
+			snprintf(message, sizeof(message), "GetNormalized, cycles per Vec4f: exact %.2f, estimate %.2f, one refinement %.2f\n",
+				double(exactCycles) / count, double(estimateCycles) / count, double(refinedCycles) / count);
+			Logger::WriteMessage(message);
+		}
+	};
+
+
+	TEST_CLASS(Validity)
+	{
+	public:
+		TEST_METHOD(SafeNormalize_Sanitize)
+		{
+			const Vec4f fallback(0.0f, 0.0f, 0.0f, 1.0f);
+
+			Assert::IsTrue(Vec4f(0.0f).GetSafeNormalized(fallback) == fallback, L"A zero vector should give the fallback");
+			Assert::IsTrue(Vec4f(1.0f, NAN, 0.0f, 0.0f).GetSafeNormalized(fallback) == fallback, L"A NaN vector should give the fallback");
+			Assert::IsTrue(Vec4f(2.0f, 0.0f, 0.0f, 0.0f).GetSafeNormalized(fallback) == Vec4f(1.0f, 0.0f, 0.0f, 0.0f), L"Valid vectors should be normalized");
+
+			Vec4f mixed(INFINITY, 1.0f, NAN, -2.0f);
+			Assert::IsFalse(IsFinite(mixed));
+			Assert::IsTrue(Sanitize(mixed, Vec4f(0.0f)) == Vec4f(0.0f, 1.0f, 0.0f, -2.0f), L"Sanitize should replace x and z");
+			Assert::IsTrue(IsFinite(Sanitize(mixed, Vec4f(0.0f))));
+		}
+	};
 }